@@ -0,0 +1,590 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "pubnub_internal.h"
+
+#include "core/pubnub_ccore_pubsub.h"
+#include "core/pubnub_ccore.h"
+#include "core/pubnub_json_parse.h"
+#include "core/pubnub_version.h"
+#include "core/pubnub_alloc.h"
+#include "core/pubnub_pubsubapi.h"
+#include "lib/base64/pbbase64.h"
+#if PUBNUB_RECEIVE_GZIP_RESPONSE
+#include "core/pbgzip_decompress.h"
+#endif
+#if PUBNUB_CRYPTO_API
+#include "core/pubnub_crypto.h"
+#endif
+
+#include "pubnub_microbench_corpus.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include "posix/monotonic_clock_get_time.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/** @file pubnub_microbench.c
+
+    Micro-benchmarks of the pure-CPU "hot paths" of the C-core:
+    parsing of the replies, JSON lookup, URL encoding of the message
+    to publish, Base64, gzip decompression and (if built with the
+    crypto API) encryption/decryption.
+
+    Each benchmark runs a fixed number of iterations (derived only
+    from the size of its input from the corpus, so it's the same on
+    every run and every machine), a few times over, and the fastest
+    run is reported, as it is the least disturbed by the rest of the
+    system. Results are printed as JSON to the standard output, so
+    they can be stored and compared across releases.
+
+    Benchmarks that parse in-place (like the real thing does) include
+    the copying of the reply to the reply buffer, as it would be done
+    on receiving it. The throughput of the gzip decompression is given
+    for the decompressed (output) data.
+ */
+
+
+/** How many bytes should one run of a benchmark process. The number
+    of iterations is derived from this and the size of the input.
+ */
+#define PBMB_BYTES_PER_RUN (8 * 1024 * 1024)
+
+/** How many runs of each benchmark to make (the fastest is reported) */
+#define PBMB_DEFAULT_REPETITIONS 5
+
+/** Cipher key to use for the encrypt/decrypt benchmarks */
+#define PBMB_CIPHER_KEY "enigma"
+
+
+/** Keeps the results of the benchmarked functions "alive" so that
+    the compiler can't optimize the calls away.
+ */
+static volatile size_t m_sink;
+
+/** The context for the "core" parsing benchmarks */
+static struct pbcc_context m_cc;
+
+/** The messages of (a parsed copy of) pbmb_subscribe_large, for the
+    per-message JSON lookup benchmark.
+ */
+static struct pbjson_elem* m_msgs;
+
+/** The message array content of pbmb_history_page */
+static char const* m_history_array;
+static size_t      m_history_array_len;
+
+/** Scratch buffer, for the benchmarks that work in-place */
+static char* m_scratch;
+
+/** Base64 benchmarks data */
+static pubnub_bymebl_t m_b64_data;
+static char*           m_b64_encoded;
+static size_t          m_b64_encoded_len;
+static char*           m_b64_decoded;
+
+#if PUBNUB_RECEIVE_GZIP_RESPONSE
+/** The context for the gzip decompression benchmark, as
+    pbgzip_decompress() works on a context */
+static pubnub_t* m_pb;
+#endif
+
+#if PUBNUB_CRYPTO_API
+static char*                   m_encrypted;
+static size_t                  m_encrypted_size;
+static char*                   m_decrypted;
+static char*                   m_decode_scratch;
+static uint8_t*                m_aes_buffer;
+static pubnub_crypto_handle_t* m_crypto;
+#endif
+
+
+/** Returns the current time of a monotonic clock, in nanoseconds. */
+static uint64_t now_nsec(void)
+{
+#if defined(_WIN32)
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER        count;
+    if (0 == freq.QuadPart) {
+        QueryPerformanceFrequency(&freq);
+    }
+    QueryPerformanceCounter(&count);
+    return (uint64_t)(count.QuadPart / freq.QuadPart) * 1000000000
+           + (uint64_t)(count.QuadPart % freq.QuadPart) * 1000000000 / freq.QuadPart;
+#else
+    struct timespec ts;
+    monotonic_clock_get_time(&ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+
+/** Copies the @p reply of @p length to the reply buffer of the
+    context @p p, like it's done when receiving it.
+ */
+static void receive_reply(struct pbcc_context* p, char const* reply, size_t length)
+{
+#if PUBNUB_DYNAMIC_REPLY_BUFFER
+    if (0 != pbcc_realloc_reply_buffer(p, (unsigned)length)) {
+        fputs("Failed to allocate the reply buffer\n", stderr);
+        exit(EXIT_FAILURE);
+    }
+#else
+    if (length > PUBNUB_REPLY_MAXLEN) {
+        fputs("Corpus reply doesn't fit in the reply buffer\n", stderr);
+        exit(EXIT_FAILURE);
+    }
+#endif
+    memcpy(p->http_reply, reply, length);
+    p->http_reply[length] = '\0';
+    p->http_buf_len       = (unsigned)length;
+}
+
+
+static void check(bool ok, char const* what)
+{
+    if (!ok) {
+        fprintf(stderr, "Benchmark self-check failed: %s\n", what);
+        exit(EXIT_FAILURE);
+    }
+}
+
+
+static void bm_parse_subscribe_small(void)
+{
+    receive_reply(&m_cc, pbmb_subscribe_small, pbmb_subscribe_small_len);
+    m_sink += pbcc_parse_subscribe_response(&m_cc);
+}
+
+
+static void bm_parse_subscribe_large(void)
+{
+    receive_reply(&m_cc, pbmb_subscribe_large, pbmb_subscribe_large_len);
+    m_sink += pbcc_parse_subscribe_response(&m_cc);
+}
+
+
+static void bm_parse_history(void)
+{
+    receive_reply(&m_cc, pbmb_history_page, pbmb_history_page_len);
+    m_sink += pbcc_parse_history_response(&m_cc);
+}
+
+
+static void bm_split_array_history(void)
+{
+    memcpy(m_scratch, m_history_array, m_history_array_len);
+    m_scratch[m_history_array_len] = '\0';
+    m_sink += pbcc_split_array(m_scratch);
+}
+
+
+static void bm_json_lookup_message(void)
+{
+    unsigned i;
+    for (i = 0; i < pbmb_subscribe_large_count; ++i) {
+        struct pbjson_elem found;
+        m_sink += pbjson_get_object_value(&m_msgs[i], "text", &found);
+    }
+}
+
+
+static void bm_json_lookup_presence(void)
+{
+    struct pbjson_elem el;
+    struct pbjson_elem found;
+    el.start = pbmb_presence_dump;
+    el.end   = pbmb_presence_dump + pbmb_presence_dump_len;
+    m_sink += pbjson_get_object_value(&el, "service", &found);
+}
+
+
+static void bm_publish_prep(void)
+{
+    m_sink += pbcc_publish_prep(
+        &m_cc, "chat", pbmb_publish_message, true, false, NULL);
+}
+
+
+static void bm_base64_encode(void)
+{
+    size_t n = pbbase64_char_array_size_for_encoding(m_b64_data.size);
+    m_sink += pbbase64_encode_std(m_b64_data, m_b64_encoded, &n);
+}
+
+
+static void bm_base64_decode(void)
+{
+    struct pbbase64_options const options = PBBASE64_RFC3548_OPTIONS;
+    pubnub_bymebl_t data;
+    data.ptr  = (uint8_t*)m_b64_decoded;
+    data.size = m_b64_data.size;
+    m_sink += pbbase64_decode(m_b64_encoded, m_b64_encoded_len, &data, &options);
+}
+
+
+#if PUBNUB_RECEIVE_GZIP_RESPONSE
+static void bm_gzip_decompress(void)
+{
+    receive_reply(&m_pb->core,
+                  (char const*)pbmb_history_page_gzip,
+                  pbmb_history_page_gzip_size);
+    m_sink += pbgzip_decompress(m_pb);
+}
+#endif
+
+
+#if PUBNUB_CRYPTO_API
+static void bm_encrypt(void)
+{
+    pubnub_bymebl_t msg;
+    size_t          n = m_encrypted_size;
+    msg.ptr  = (uint8_t*)pbmb_publish_message;
+    msg.size = pbmb_publish_message_len;
+    m_sink += pubnub_encrypt(PBMB_CIPHER_KEY, msg, m_encrypted, &n);
+}
+
+
+static void bm_decrypt(void)
+{
+    pubnub_bymebl_t data;
+    data.ptr  = (uint8_t*)m_decrypted;
+    data.size = pbmb_publish_message_len + 33;
+    m_sink += pubnub_decrypt(PBMB_CIPHER_KEY, m_encrypted, &data);
+}
+
+
+static void bm_encrypt_handle(void)
+{
+    pubnub_bymebl_t msg;
+    pubnub_bymebl_t buffer;
+    size_t          n = m_encrypted_size;
+    msg.ptr     = (uint8_t*)pbmb_publish_message;
+    msg.size    = pbmb_publish_message_len;
+    buffer.ptr  = m_aes_buffer;
+    buffer.size = pbmb_publish_message_len + 33;
+    m_sink += pubnub_crypto_handle_encrypt(m_crypto, msg, m_encrypted, &n, buffer);
+}
+
+
+static void bm_decrypt_handle(void)
+{
+    pubnub_bymebl_t data;
+    data.ptr  = (uint8_t*)m_decrypted;
+    data.size = pbmb_publish_message_len + 33;
+    /* Decoding is done in place, so (re)start from a copy */
+    strcpy(m_decode_scratch, m_encrypted);
+    m_sink += pubnub_crypto_handle_decrypt(m_crypto, m_decode_scratch, &data);
+}
+#endif
+
+
+/** Description of a benchmark */
+struct pbmb_benchmark {
+    /** Name, as reported in the results */
+    char const* name;
+    /** The function doing one iteration */
+    void (*run)(void);
+    /** How many bytes of input (output, for decompression) are
+        processed in one iteration */
+    size_t bytes;
+    /** How many messages are processed in one iteration */
+    unsigned messages;
+};
+
+
+static void prepare(void)
+{
+    struct pbjson_elem el;
+    char*              s;
+    char const*        end;
+    unsigned           i;
+
+    memset(&m_cc, 0, sizeof m_cc);
+    pbcc_init(&m_cc, "demo", "demo");
+
+    /* Verify the parsers accept the corpus, or the numbers would be
+       meaningless. */
+    receive_reply(&m_cc, pbmb_subscribe_small, pbmb_subscribe_small_len);
+    check(PNR_OK == pbcc_parse_subscribe_response(&m_cc), "small subscribe");
+    receive_reply(&m_cc, pbmb_subscribe_large, pbmb_subscribe_large_len);
+    check(PNR_OK == pbcc_parse_subscribe_response(&m_cc), "large subscribe");
+    receive_reply(&m_cc, pbmb_history_page, pbmb_history_page_len);
+    check(PNR_OK == pbcc_parse_history_response(&m_cc), "history");
+    receive_reply(&m_cc, pbmb_presence_dump, pbmb_presence_dump_len);
+    check(PNR_OK == pbcc_parse_presence_response(&m_cc), "presence");
+    check(PNR_STARTED
+              == pbcc_publish_prep(
+                     &m_cc, "chat", pbmb_publish_message, true, false, NULL),
+          "publish");
+
+    /* The message array of the history page is between the "[[" and
+       the last "],". */
+    m_history_array = pbmb_history_page + 2;
+    end             = pbmb_history_page + pbmb_history_page_len;
+    while ((end > m_history_array) && !((end[0] == ']') && (end[1] == ','))) {
+        --end;
+    }
+    m_history_array_len = end - m_history_array;
+    m_scratch           = (char*)malloc(pbmb_subscribe_large_len + 1);
+    check(NULL != m_scratch, "allocating scratch");
+
+    /* Split the messages of the large batch, to be looked up in */
+    receive_reply(&m_cc, pbmb_subscribe_large, pbmb_subscribe_large_len);
+    check(PNR_OK == pbcc_parse_subscribe_response(&m_cc), "large subscribe");
+    s = (char*)malloc(m_cc.http_buf_len + 1);
+    m_msgs = (struct pbjson_elem*)malloc(pbmb_subscribe_large_count * sizeof *m_msgs);
+    check((NULL != s) && (NULL != m_msgs), "allocating messages");
+    memcpy(s, m_cc.http_reply, m_cc.http_buf_len + 1);
+    s += m_cc.msg_ofs;
+    for (i = 0; i < pbmb_subscribe_large_count; ++i) {
+        m_msgs[i].start = s;
+        m_msgs[i].end   = s + strlen(s);
+        s += strlen(s) + 1;
+    }
+    check(jonmpOK == pbjson_get_object_value(&m_msgs[0], "text", &el),
+          "message lookup");
+
+    m_b64_data.ptr    = (uint8_t*)pbmb_history_page_gzip;
+    m_b64_data.size   = pbmb_history_page_gzip_size;
+    m_b64_encoded_len = pbbase64_char_array_size_for_encoding(m_b64_data.size);
+    m_b64_encoded     = (char*)malloc(m_b64_encoded_len);
+    m_b64_decoded     = (char*)malloc(m_b64_data.size);
+    check((NULL != m_b64_encoded) && (NULL != m_b64_decoded), "allocating Base64");
+    check(0 == pbbase64_encode_std(m_b64_data, m_b64_encoded, &m_b64_encoded_len),
+          "Base64 encode");
+
+#if PUBNUB_RECEIVE_GZIP_RESPONSE
+    m_pb = pubnub_alloc();
+    check(NULL != m_pb, "allocating context");
+    pubnub_init(m_pb, "demo", "demo");
+    receive_reply(&m_pb->core,
+                  (char const*)pbmb_history_page_gzip,
+                  pbmb_history_page_gzip_size);
+    check(PNR_OK == pbgzip_decompress(m_pb), "gzip decompress");
+    check((m_pb->core.http_buf_len == pbmb_history_page_len)
+              && (0 == memcmp(m_pb->core.http_reply,
+                              pbmb_history_page,
+                              pbmb_history_page_len)),
+          "gzip decompressed contents");
+#endif
+
+#if PUBNUB_CRYPTO_API
+    m_encrypted_size = pbbase64_char_array_size_for_encoding(
+        pbmb_publish_message_len + 33);
+    m_encrypted = (char*)malloc(m_encrypted_size);
+    m_decrypted = (char*)malloc(pbmb_publish_message_len + 33);
+    m_decode_scratch = (char*)malloc(m_encrypted_size);
+    m_aes_buffer = (uint8_t*)malloc(pbmb_publish_message_len + 33);
+    m_crypto = pubnub_crypto_handle_alloc(PBMB_CIPHER_KEY);
+    check((NULL != m_encrypted) && (NULL != m_decrypted)
+              && (NULL != m_decode_scratch) && (NULL != m_aes_buffer)
+              && (NULL != m_crypto),
+          "allocating crypto");
+    bm_encrypt_handle();
+    {
+        pubnub_bymebl_t data;
+        data.ptr  = (uint8_t*)m_decrypted;
+        data.size = pbmb_publish_message_len + 33;
+        check(0 == pubnub_decrypt(PBMB_CIPHER_KEY, m_encrypted, &data)
+                  && (data.size == pbmb_publish_message_len),
+              "encrypt with a crypto handle");
+    }
+    bm_encrypt();
+    {
+        pubnub_bymebl_t data;
+        data.ptr  = (uint8_t*)m_decrypted;
+        data.size = pbmb_publish_message_len + 33;
+        check(0 == pubnub_decrypt(PBMB_CIPHER_KEY, m_encrypted, &data)
+                  && (data.size == pbmb_publish_message_len)
+                  && (0 == memcmp(data.ptr,
+                                  pbmb_publish_message,
+                                  pbmb_publish_message_len)),
+              "decrypt");
+        data.size = pbmb_publish_message_len + 33;
+        strcpy(m_decode_scratch, m_encrypted);
+        check(0 == pubnub_crypto_handle_decrypt(m_crypto, m_decode_scratch, &data)
+                  && (data.size == pbmb_publish_message_len)
+                  && (0 == memcmp(data.ptr,
+                                  pbmb_publish_message,
+                                  pbmb_publish_message_len)),
+              "decrypt with a crypto handle");
+    }
+#endif
+}
+
+
+/** Runs the benchmark @p bm @p repetitions times, @p iterations
+    each and returns the duration of the fastest repetition, in
+    nanoseconds.
+ */
+static uint64_t run_benchmark(struct pbmb_benchmark const* bm,
+                              unsigned                     iterations,
+                              unsigned                     repetitions)
+{
+    uint64_t best = UINT64_MAX;
+    unsigned r;
+    unsigned i;
+
+    /* Warm up the caches and the branch predictors */
+    for (i = 0; i < iterations / 10 + 1; ++i) {
+        bm->run();
+    }
+    for (r = 0; r < repetitions; ++r) {
+        uint64_t const start = now_nsec();
+        uint64_t       elapsed;
+        for (i = 0; i < iterations; ++i) {
+            bm->run();
+        }
+        elapsed = now_nsec() - start;
+        if (elapsed < best) {
+            best = elapsed;
+        }
+    }
+
+    return best;
+}
+
+
+/** Runs the @p count @p benchmarks (those that match the @p filter,
+    if it's not NULL) and prints the results, as JSON.
+ */
+static void report(struct pbmb_benchmark const* benchmarks,
+                   size_t                       count,
+                   unsigned                     repetitions,
+                   unsigned                     scale,
+                   char const*                  filter)
+{
+    bool   first = true;
+    size_t i;
+
+    printf("{\n  \"sdk\": \"%s\",\n  \"version\": \"%s\",\n",
+           pubnub_sdk_name(),
+           pubnub_version());
+    printf("  \"repetitions\": %u,\n  \"benchmarks\": [", repetitions);
+    for (i = 0; i < count; ++i) {
+        struct pbmb_benchmark const* bm = benchmarks + i;
+        unsigned                     iterations;
+        double                       ns_per_op;
+
+        if ((filter != NULL) && (NULL == strstr(bm->name, filter))) {
+            continue;
+        }
+        iterations = (unsigned)(PBMB_BYTES_PER_RUN / bm->bytes + 1) * scale;
+        ns_per_op  = (double)run_benchmark(bm, iterations, repetitions) / iterations;
+
+        printf("%s\n    {\"name\": \"%s\", \"iterations\": %u, "
+               "\"bytes_per_op\": %lu, \"messages_per_op\": %u, "
+               "\"ns_per_op\": %.1f, \"ns_per_message\": %.1f, "
+               "\"mb_per_s\": %.2f}",
+               first ? "" : ",",
+               bm->name,
+               iterations,
+               (unsigned long)bm->bytes,
+               bm->messages,
+               ns_per_op,
+               ns_per_op / bm->messages,
+               bm->bytes * 1000.0 / ns_per_op);
+        first = false;
+    }
+    puts("\n  ]\n}");
+}
+
+
+static int usage(char const* prog)
+{
+    printf("Usage: %s [-r repetitions] [-x scale] [-f filter]\n"
+           "  -r  How many times to run each benchmark, the fastest run "
+           "is reported (default: %d)\n"
+           "  -x  Multiply the number of iterations by this "
+           "(default: 1)\n"
+           "  -f  Run only the benchmarks whose name contains this\n",
+           prog,
+           PBMB_DEFAULT_REPETITIONS);
+    return EXIT_FAILURE;
+}
+
+
+int main(int argc, char* argv[])
+{
+    unsigned    repetitions = PBMB_DEFAULT_REPETITIONS;
+    unsigned    scale       = 1;
+    char const* filter      = NULL;
+    int         i;
+
+    for (i = 1; i < argc; ++i) {
+        if ((0 == strcmp(argv[i], "-r")) && (i + 1 < argc)) {
+            repetitions = (unsigned)atoi(argv[++i]);
+        }
+        else if ((0 == strcmp(argv[i], "-x")) && (i + 1 < argc)) {
+            scale = (unsigned)atoi(argv[++i]);
+        }
+        else if ((0 == strcmp(argv[i], "-f")) && (i + 1 < argc)) {
+            filter = argv[++i];
+        }
+        else {
+            return usage(argv[0]);
+        }
+    }
+    if ((0 == repetitions) || (0 == scale)) {
+        return usage(argv[0]);
+    }
+
+    prepare();
+    {
+        struct pbmb_benchmark const benchmarks[] = {
+            { "parse_subscribe_small",
+              bm_parse_subscribe_small,
+              pbmb_subscribe_small_len,
+              pbmb_subscribe_small_count },
+            { "parse_subscribe_large",
+              bm_parse_subscribe_large,
+              pbmb_subscribe_large_len,
+              pbmb_subscribe_large_count },
+            { "parse_history",
+              bm_parse_history,
+              pbmb_history_page_len,
+              pbmb_history_page_count },
+            { "split_array_history",
+              bm_split_array_history,
+              m_history_array_len,
+              pbmb_history_page_count },
+            { "json_lookup_message",
+              bm_json_lookup_message,
+              pbmb_subscribe_large_len,
+              pbmb_subscribe_large_count },
+            { "json_lookup_presence",
+              bm_json_lookup_presence,
+              pbmb_presence_dump_len,
+              pbmb_presence_dump_count },
+            { "publish_prep", bm_publish_prep, pbmb_publish_message_len, 1 },
+            { "base64_encode", bm_base64_encode, m_b64_data.size, 1 },
+            { "base64_decode", bm_base64_decode, m_b64_data.size, 1 },
+#if PUBNUB_RECEIVE_GZIP_RESPONSE
+            { "gzip_decompress_history",
+              bm_gzip_decompress,
+              pbmb_history_page_len,
+              pbmb_history_page_count },
+#endif
+#if PUBNUB_CRYPTO_API
+            { "encrypt", bm_encrypt, pbmb_publish_message_len, 1 },
+            { "decrypt", bm_decrypt, strlen(m_encrypted), 1 },
+            { "encrypt_handle", bm_encrypt_handle, pbmb_publish_message_len, 1 },
+            { "decrypt_handle", bm_decrypt_handle, strlen(m_encrypted), 1 },
+#endif
+        };
+        report(benchmarks, sizeof benchmarks / sizeof benchmarks[0], repetitions, scale, filter);
+    }
+
+
+#if PUBNUB_RECEIVE_GZIP_RESPONSE
+    pubnub_free(m_pb);
+#endif
+    pbcc_deinit(&m_cc);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,1043 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "pubnub_microbench_corpus.h"
+
+
+/* Replies in the exact shape the Pubnub network sends them, with
+   typical chat/IoT message contents. Don't change them, the results
+   are comparable across releases only if the corpus stays the same.
+ */
+
+char const pbmb_subscribe_small[] =
+    "[["
+    "{\"id\":\"b308f6c2\",\"sender\":\"user-414\",\"text\":\"dog price the price humidity humidity over message realtime fox ok realtime brown channel brown stream latency fox brown \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000000000,\"seq\":0,\"tags\":[\"latency\",\"the\",\"jumps\"],\"geo\":{\"lat\":-42.476604,\"lng\":122.250857}},"
+    "{\"id\":\"a75625dd\",\"sender\":\"user-337\",\"text\":\"alert brown brown latency realtime\",\"ts\":14937916000000137,\"seq\":1},"
+    "{\"id\":\"bf690666\",\"sender\":\"user-114\",\"text\":\"pubnub update temperature price reading fox over reading order alert message temperature dog alert reading reading brown fox ok the jumps stream\",\"ts\":14937916000000274,\"seq\":2}"
+    "],\"14937916123456789\",\"chat,alerts,chat\"]";
+
+size_t const pbmb_subscribe_small_len = sizeof pbmb_subscribe_small - 1;
+unsigned const pbmb_subscribe_small_count = 3;
+
+
+char const pbmb_publish_message[] =
+    "{\"id\":\"b308f6c2\",\"sender\":\"user-414\",\"text\":\"dog price the price humidity humidity over message realtime fox ok realtime brown channel brown stream latency fox brown \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000000000,\"seq\":0,\"tags\":[\"latency\",\"the\",\"jumps\"],\"geo\":{\"lat\":-42.476604,\"lng\":122.250857}}";
+
+size_t const pbmb_publish_message_len = sizeof pbmb_publish_message - 1;
+
+
+char const pbmb_subscribe_large[] =
+    "[["
+    "{\"id\":\"c7aa23e7\",\"sender\":\"user-126\",\"text\":\"ok alert jumps update stream brown \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000000000,\"seq\":0,\"tags\":[\"jumps\",\"humidity\",\"price\"],\"geo\":{\"lat\":-67.859233,\"lng\":-151.043877}},"
+    "{\"id\":\"4b23f1c6\",\"sender\":\"user-489\",\"text\":\"message ok sensor quick\",\"ts\":14937916000000137,\"seq\":1},"
+    "{\"id\":\"126fb94c\",\"sender\":\"user-190\",\"text\":\"order jumps quick latency ok ok reading ok brown\",\"ts\":14937916000000274,\"seq\":2},"
+    "{\"id\":\"3ea47bca\",\"sender\":\"user-342\",\"text\":\"the ok ok temperature realtime dog message sensor latency the reading temperature lazy brown channel message jumps jumps realtime reading channel lazy the stream\",\"ts\":14937916000000411,\"seq\":3,\"tags\":[\"temperature\",\"reading\",\"latency\"]},"
+    "{\"id\":\"2b2be291\",\"sender\":\"user-435\",\"text\":\"lazy fox fox brown message alert brown update stream fox brown the fox update dog brown alert fox quick\",\"ts\":14937916000000548,\"seq\":4},"
+    "{\"id\":\"fa768de1\",\"sender\":\"user-117\",\"text\":\"latency over over stream\",\"ts\":14937916000000685,\"seq\":5,\"geo\":{\"lat\":70.954614,\"lng\":147.474264}},"
+    "{\"id\":\"0c4d0fcf\",\"sender\":\"user-101\",\"text\":\"sensor ok update jumps fox brown quick stream price lazy realtime brown message order channel jumps realtime temperature channel\",\"ts\":14937916000000822,\"seq\":6,\"tags\":[\"temperature\",\"price\",\"the\"]},"
+    "{\"id\":\"b11da43f\",\"sender\":\"user-340\",\"text\":\"dog humidity humidity brown jumps reading the stream ok dog brown pubnub channel dog latency lazy brown message brown channel message dog \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000000959,\"seq\":7},"
+    "{\"id\":\"54f12df5\",\"sender\":\"user-328\",\"text\":\"lazy realtime sensor reading update the alert temperature brown pubnub lazy order alert channel the over channel\",\"ts\":14937916000001096,\"seq\":8},"
+    "{\"id\":\"6863c97d\",\"sender\":\"user-222\",\"text\":\"latency alert order quick dog\",\"ts\":14937916000001233,\"seq\":9,\"tags\":[\"the\",\"lazy\",\"temperature\"]},"
+    "{\"id\":\"e53e15b9\",\"sender\":\"user-141\",\"text\":\"alert latency alert quick realtime reading price update message fox price ok humidity brown dog stream quick the temperature\",\"ts\":14937916000001370,\"seq\":10,\"geo\":{\"lat\":-0.910867,\"lng\":-162.701231}},"
+    "{\"id\":\"d0b95465\",\"sender\":\"user-356\",\"text\":\"sensor update lazy pubnub brown pubnub alert jumps latency\",\"ts\":14937916000001507,\"seq\":11},"
+    "{\"id\":\"1dfa8719\",\"sender\":\"user-233\",\"text\":\"reading humidity message price over humidity stream channel\",\"ts\":14937916000001644,\"seq\":12,\"tags\":[\"order\",\"brown\",\"dog\"]},"
+    "{\"id\":\"0bca8de3\",\"sender\":\"user-187\",\"text\":\"reading sensor channel reading stream the order channel temperature channel alert humidity message sensor message fox quick price jumps humidity fox reading\",\"ts\":14937916000001781,\"seq\":13},"
+    "{\"id\":\"9661f8ec\",\"sender\":\"user-441\",\"text\":\"ok ok ok jumps over lazy \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000001918,\"seq\":14},"
+    "{\"id\":\"642ed824\",\"sender\":\"user-52\",\"text\":\"latency over order the quick channel channel sensor\",\"ts\":14937916000002055,\"seq\":15,\"tags\":[\"temperature\",\"brown\",\"update\"],\"geo\":{\"lat\":22.681153,\"lng\":-61.559909}},"
+    "{\"id\":\"0cfe411d\",\"sender\":\"user-394\",\"text\":\"dog the latency lazy the message realtime temperature price jumps the jumps fox lazy jumps latency pubnub order brown\",\"ts\":14937916000002192,\"seq\":16},"
+    "{\"id\":\"9dd16542\",\"sender\":\"user-232\",\"text\":\"update stream over ok humidity dog message order message ok fox update latency fox update channel sensor latency channel alert stream dog alert humidity\",\"ts\":14937916000002329,\"seq\":17},"
+    "{\"id\":\"41727f68\",\"sender\":\"user-357\",\"text\":\"pubnub humidity channel dog\",\"ts\":14937916000002466,\"seq\":18,\"tags\":[\"reading\",\"order\",\"realtime\"]},"
+    "{\"id\":\"117ad4e9\",\"sender\":\"user-88\",\"text\":\"dog channel temperature channel update brown message\",\"ts\":14937916000002603,\"seq\":19},"
+    "{\"id\":\"d714927f\",\"sender\":\"user-58\",\"text\":\"price order stream brown brown fox channel brown humidity dog over order order temperature realtime latency brown quick fox\",\"ts\":14937916000002740,\"seq\":20,\"geo\":{\"lat\":87.275553,\"lng\":13.009223}},"
+    "{\"id\":\"c8869f42\",\"sender\":\"user-258\",\"text\":\"pubnub temperature channel the sensor lazy quick reading quick channel realtime latency dog fox jumps order humidity \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000002877,\"seq\":21,\"tags\":[\"dog\",\"sensor\",\"brown\"]},"
+    "{\"id\":\"6683a183\",\"sender\":\"user-426\",\"text\":\"channel pubnub latency update humidity update channel reading update\",\"ts\":14937916000003014,\"seq\":22},"
+    "{\"id\":\"b55a6972\",\"sender\":\"user-185\",\"text\":\"quick sensor sensor quick price the latency order humidity lazy lazy humidity alert over ok over stream\",\"ts\":14937916000003151,\"seq\":23},"
+    "{\"id\":\"27d1b8c3\",\"sender\":\"user-313\",\"text\":\"brown ok sensor temperature sensor alert jumps update humidity realtime brown jumps brown\",\"ts\":14937916000003288,\"seq\":24,\"tags\":[\"fox\",\"humidity\",\"channel\"]},"
+    "{\"id\":\"e6e0e506\",\"sender\":\"user-292\",\"text\":\"reading lazy temperature lazy pubnub over dog message humidity realtime ok reading fox fox stream lazy\",\"ts\":14937916000003425,\"seq\":25,\"geo\":{\"lat\":22.022494,\"lng\":-151.837886}},"
+    "{\"id\":\"ea69da09\",\"sender\":\"user-173\",\"text\":\"price sensor message realtime sensor realtime humidity price humidity temperature dog fox reading alert sensor jumps realtime\",\"ts\":14937916000003562,\"seq\":26},"
+    "{\"id\":\"162dcd29\",\"sender\":\"user-467\",\"text\":\"humidity stream stream quick\",\"ts\":14937916000003699,\"seq\":27,\"tags\":[\"brown\",\"stream\",\"over\"]},"
+    "{\"id\":\"a3012b0c\",\"sender\":\"user-456\",\"text\":\"humidity update quick dog humidity order quick ok order fox channel the humidity lazy \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000003836,\"seq\":28},"
+    "{\"id\":\"5a72561f\",\"sender\":\"user-362\",\"text\":\"realtime reading brown channel humidity over stream reading reading temperature realtime the order the temperature dog stream sensor humidity\",\"ts\":14937916000003973,\"seq\":29},"
+    "{\"id\":\"061c622a\",\"sender\":\"user-77\",\"text\":\"channel pubnub jumps jumps over\",\"ts\":14937916000004110,\"seq\":30,\"tags\":[\"the\",\"price\",\"latency\"],\"geo\":{\"lat\":-24.263093,\"lng\":-56.135856}},"
+    "{\"id\":\"288fed92\",\"sender\":\"user-149\",\"text\":\"lazy quick quick humidity realtime the reading brown temperature update quick latency fox jumps sensor temperature pubnub alert order pubnub jumps jumps\",\"ts\":14937916000004247,\"seq\":31},"
+    "{\"id\":\"e9f8d2e8\",\"sender\":\"user-268\",\"text\":\"ok the price order pubnub order update order\",\"ts\":14937916000004384,\"seq\":32},"
+    "{\"id\":\"4f7475fb\",\"sender\":\"user-226\",\"text\":\"temperature channel pubnub update pubnub dog alert ok temperature order sensor the price alert temperature reading latency fox humidity temperature\",\"ts\":14937916000004521,\"seq\":33,\"tags\":[\"alert\",\"ok\",\"order\"]},"
+    "{\"id\":\"cfe5d735\",\"sender\":\"user-23\",\"text\":\"fox lazy lazy over temperature the realtime lazy stream\",\"ts\":14937916000004658,\"seq\":34},"
+    "{\"id\":\"ecd6b067\",\"sender\":\"user-219\",\"text\":\"sensor quick alert fox reading humidity humidity update brown \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000004795,\"seq\":35,\"geo\":{\"lat\":-89.931642,\"lng\":-142.112563}},"
+    "{\"id\":\"80d867db\",\"sender\":\"user-102\",\"text\":\"the dog latency update realtime fox dog order update lazy temperature ok dog channel alert message reading humidity sensor reading quick dog\",\"ts\":14937916000004932,\"seq\":36,\"tags\":[\"lazy\",\"ok\",\"message\"]},"
+    "{\"id\":\"42df9eb1\",\"sender\":\"user-150\",\"text\":\"pubnub temperature channel quick channel brown fox lazy order stream latency reading over channel humidity update stream reading sensor brown pubnub price\",\"ts\":14937916000005069,\"seq\":37},"
+    "{\"id\":\"ba29c6cf\",\"sender\":\"user-110\",\"text\":\"sensor lazy price realtime update order quick latency dog stream temperature price update latency\",\"ts\":14937916000005206,\"seq\":38},"
+    "{\"id\":\"e785c5bd\",\"sender\":\"user-459\",\"text\":\"humidity sensor latency temperature humidity alert over sensor message over stream\",\"ts\":14937916000005343,\"seq\":39,\"tags\":[\"update\",\"channel\",\"latency\"]},"
+    "{\"id\":\"f513c4b5\",\"sender\":\"user-202\",\"text\":\"reading order order channel sensor the ok\",\"ts\":14937916000005480,\"seq\":40,\"geo\":{\"lat\":37.281507,\"lng\":-134.705136}},"
+    "{\"id\":\"5962ef11\",\"sender\":\"user-160\",\"text\":\"temperature stream price temperature dog update humidity update\",\"ts\":14937916000005617,\"seq\":41},"
+    "{\"id\":\"f51cf0d5\",\"sender\":\"user-84\",\"text\":\"reading sensor alert quick sensor jumps over quick stream dog latency quick channel jumps order brown temperature pubnub alert stream channel stream temperature \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000005754,\"seq\":42,\"tags\":[\"jumps\",\"the\",\"quick\"]},"
+    "{\"id\":\"15295536\",\"sender\":\"user-62\",\"text\":\"quick the realtime over message order sensor lazy alert jumps sensor over ok\",\"ts\":14937916000005891,\"seq\":43},"
+    "{\"id\":\"1cd7ede8\",\"sender\":\"user-220\",\"text\":\"realtime order alert jumps\",\"ts\":14937916000006028,\"seq\":44},"
+    "{\"id\":\"77ed7446\",\"sender\":\"user-23\",\"text\":\"lazy stream temperature ok pubnub humidity stream sensor reading ok\",\"ts\":14937916000006165,\"seq\":45,\"tags\":[\"pubnub\",\"lazy\",\"price\"],\"geo\":{\"lat\":46.269308,\"lng\":124.105773}},"
+    "{\"id\":\"5712efe9\",\"sender\":\"user-406\",\"text\":\"quick over brown realtime channel update realtime lazy the stream lazy message\",\"ts\":14937916000006302,\"seq\":46},"
+    "{\"id\":\"0d098c3f\",\"sender\":\"user-312\",\"text\":\"temperature pubnub jumps brown reading reading ok alert\",\"ts\":14937916000006439,\"seq\":47},"
+    "{\"id\":\"81038352\",\"sender\":\"user-101\",\"text\":\"update dog message lazy humidity the dog update quick order order stream price message stream latency over price brown channel update price fox brown\",\"ts\":14937916000006576,\"seq\":48,\"tags\":[\"latency\",\"jumps\",\"brown\"]},"
+    "{\"id\":\"ab5b7377\",\"sender\":\"user-433\",\"text\":\"quick quick the ok dog latency alert jumps lazy sensor dog reading reading humidity temperature temperature quick jumps the sensor alert over temperature quick \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000006713,\"seq\":49},"
+    "{\"id\":\"045527cc\",\"sender\":\"user-102\",\"text\":\"brown channel ok pubnub pubnub fox ok message ok fox sensor ok reading price reading\",\"ts\":14937916000006850,\"seq\":50,\"geo\":{\"lat\":6.131863,\"lng\":-152.71227}},"
+    "{\"id\":\"50f4ad2b\",\"sender\":\"user-237\",\"text\":\"humidity brown message jumps sensor ok fox jumps channel humidity the alert alert realtime realtime update alert sensor channel\",\"ts\":14937916000006987,\"seq\":51,\"tags\":[\"order\",\"sensor\",\"fox\"]},"
+    "{\"id\":\"df6acfd3\",\"sender\":\"user-361\",\"text\":\"update alert order alert pubnub sensor sensor the reading temperature brown fox fox order alert ok\",\"ts\":14937916000007124,\"seq\":52},"
+    "{\"id\":\"9a66aba0\",\"sender\":\"user-373\",\"text\":\"update pubnub fox pubnub realtime realtime reading price order sensor ok humidity reading the reading\",\"ts\":14937916000007261,\"seq\":53},"
+    "{\"id\":\"e2070f0c\",\"sender\":\"user-226\",\"text\":\"update latency reading alert dog pubnub price alert stream humidity latency jumps reading lazy\",\"ts\":14937916000007398,\"seq\":54,\"tags\":[\"message\",\"temperature\",\"latency\"]},"
+    "{\"id\":\"f28c11b3\",\"sender\":\"user-96\",\"text\":\"message humidity alert lazy ok reading latency reading over temperature jumps realtime the brown order update fox ok lazy realtime the message\",\"ts\":14937916000007535,\"seq\":55,\"geo\":{\"lat\":85.058328,\"lng\":72.471331}},"
+    "{\"id\":\"a22c3179\",\"sender\":\"user-154\",\"text\":\"brown dog price latency order quick channel temperature dog dog price fox humidity alert order over order sensor stream fox channel latency \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000007672,\"seq\":56},"
+    "{\"id\":\"6190cd74\",\"sender\":\"user-61\",\"text\":\"temperature message the latency brown ok brown reading latency pubnub pubnub fox message lazy over update dog over brown sensor price message pubnub\",\"ts\":14937916000007809,\"seq\":57,\"tags\":[\"dog\",\"lazy\",\"channel\"]},"
+    "{\"id\":\"3edcaf2b\",\"sender\":\"user-294\",\"text\":\"temperature brown realtime brown fox lazy fox over quick price\",\"ts\":14937916000007946,\"seq\":58},"
+    "{\"id\":\"689ff708\",\"sender\":\"user-126\",\"text\":\"ok quick price lazy price quick message reading lazy order temperature fox stream alert price\",\"ts\":14937916000008083,\"seq\":59},"
+    "{\"id\":\"e1787dac\",\"sender\":\"user-202\",\"text\":\"sensor update ok update stream ok quick fox\",\"ts\":14937916000008220,\"seq\":60,\"tags\":[\"the\",\"stream\",\"message\"],\"geo\":{\"lat\":-81.02097,\"lng\":127.146851}},"
+    "{\"id\":\"3b4a208b\",\"sender\":\"user-454\",\"text\":\"dog temperature the realtime brown order message latency latency the pubnub message\",\"ts\":14937916000008357,\"seq\":61},"
+    "{\"id\":\"968b7e33\",\"sender\":\"user-56\",\"text\":\"order humidity reading alert latency reading sensor\",\"ts\":14937916000008494,\"seq\":62},"
+    "{\"id\":\"0390a558\",\"sender\":\"user-418\",\"text\":\"latency temperature lazy over jumps humidity message brown realtime fox alert \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000008631,\"seq\":63,\"tags\":[\"lazy\",\"over\",\"stream\"]},"
+    "{\"id\":\"5b8b9b2f\",\"sender\":\"user-476\",\"text\":\"order ok temperature brown price the order quick channel update the update sensor temperature channel lazy lazy order over over temperature latency\",\"ts\":14937916000008768,\"seq\":64},"
+    "{\"id\":\"0f2ece9c\",\"sender\":\"user-472\",\"text\":\"lazy order realtime realtime latency update stream stream ok price reading order the the lazy pubnub lazy jumps sensor humidity dog order jumps\",\"ts\":14937916000008905,\"seq\":65,\"geo\":{\"lat\":-41.160209,\"lng\":107.579652}},"
+    "{\"id\":\"5ab012d3\",\"sender\":\"user-291\",\"text\":\"lazy stream channel update sensor ok over over over brown jumps update dog stream over quick jumps message fox\",\"ts\":14937916000009042,\"seq\":66,\"tags\":[\"channel\",\"stream\",\"update\"]},"
+    "{\"id\":\"54c59414\",\"sender\":\"user-81\",\"text\":\"realtime order sensor humidity over lazy quick\",\"ts\":14937916000009179,\"seq\":67},"
+    "{\"id\":\"3a39df93\",\"sender\":\"user-332\",\"text\":\"reading sensor message lazy sensor the ok\",\"ts\":14937916000009316,\"seq\":68},"
+    "{\"id\":\"8bb1a3dc\",\"sender\":\"user-277\",\"text\":\"ok ok pubnub jumps\",\"ts\":14937916000009453,\"seq\":69,\"tags\":[\"temperature\",\"sensor\",\"pubnub\"]},"
+    "{\"id\":\"a47588e1\",\"sender\":\"user-276\",\"text\":\"pubnub channel message realtime brown update alert pubnub update jumps stream update quick ok quick over update alert update brown reading pubnub \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000009590,\"seq\":70,\"geo\":{\"lat\":9.797342,\"lng\":177.952709}},"
+    "{\"id\":\"c7e5e1fe\",\"sender\":\"user-92\",\"text\":\"fox reading message update quick alert sensor message order\",\"ts\":14937916000009727,\"seq\":71},"
+    "{\"id\":\"a93f0380\",\"sender\":\"user-311\",\"text\":\"price dog fox dog fox jumps stream stream quick quick over ok humidity the channel ok alert dog pubnub channel order lazy order\",\"ts\":14937916000009864,\"seq\":72,\"tags\":[\"brown\",\"lazy\",\"price\"]},"
+    "{\"id\":\"3e6e4a50\",\"sender\":\"user-316\",\"text\":\"the latency over over lazy the pubnub over price realtime reading fox brown pubnub humidity stream humidity reading jumps fox over\",\"ts\":14937916000010001,\"seq\":73},"
+    "{\"id\":\"a9fbd2bf\",\"sender\":\"user-123\",\"text\":\"temperature realtime humidity ok price brown humidity ok pubnub jumps\",\"ts\":14937916000010138,\"seq\":74},"
+    "{\"id\":\"fbb21573\",\"sender\":\"user-369\",\"text\":\"order brown latency channel lazy price update fox realtime humidity\",\"ts\":14937916000010275,\"seq\":75,\"tags\":[\"stream\",\"jumps\",\"order\"],\"geo\":{\"lat\":-68.351162,\"lng\":-172.334637}},"
+    "{\"id\":\"4be33d3f\",\"sender\":\"user-105\",\"text\":\"dog sensor over dog stream jumps order stream\",\"ts\":14937916000010412,\"seq\":76},"
+    "{\"id\":\"6654888a\",\"sender\":\"user-499\",\"text\":\"the over sensor fox lazy quick stream message order realtime quick \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000010549,\"seq\":77},"
+    "{\"id\":\"eade4572\",\"sender\":\"user-318\",\"text\":\"brown brown quick pubnub jumps reading the sensor channel ok jumps alert sensor realtime over latency quick pubnub humidity pubnub quick sensor fox\",\"ts\":14937916000010686,\"seq\":78,\"tags\":[\"quick\",\"jumps\",\"realtime\"]},"
+    "{\"id\":\"d9be0712\",\"sender\":\"user-231\",\"text\":\"jumps quick pubnub the realtime brown latency ok\",\"ts\":14937916000010823,\"seq\":79},"
+    "{\"id\":\"608f5e7a\",\"sender\":\"user-425\",\"text\":\"dog stream stream stream pubnub reading channel pubnub latency order stream order alert reading lazy\",\"ts\":14937916000010960,\"seq\":80,\"geo\":{\"lat\":88.61024,\"lng\":27.666606}},"
+    "{\"id\":\"79d67cb8\",\"sender\":\"user-349\",\"text\":\"pubnub jumps stream brown update quick lazy price fox over order lazy lazy channel stream stream lazy channel channel humidity temperature\",\"ts\":14937916000011097,\"seq\":81,\"tags\":[\"lazy\",\"brown\",\"message\"]},"
+    "{\"id\":\"1e50fd08\",\"sender\":\"user-171\",\"text\":\"over humidity humidity lazy dog ok order message the lazy brown over latency sensor realtime reading brown latency channel jumps price sensor\",\"ts\":14937916000011234,\"seq\":82},"
+    "{\"id\":\"829c43cb\",\"sender\":\"user-247\",\"text\":\"ok realtime dog over dog stream quick lazy alert price humidity\",\"ts\":14937916000011371,\"seq\":83},"
+    "{\"id\":\"621ef9dc\",\"sender\":\"user-245\",\"text\":\"humidity dog channel the realtime the pubnub stream pubnub latency sensor dog realtime sensor latency pubnub stream stream temperature message fox jumps quick temperature \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000011508,\"seq\":84,\"tags\":[\"reading\",\"lazy\",\"dog\"]},"
+    "{\"id\":\"8b7520d6\",\"sender\":\"user-67\",\"text\":\"temperature quick quick lazy message jumps fox alert pubnub stream quick pubnub\",\"ts\":14937916000011645,\"seq\":85,\"geo\":{\"lat\":28.420225,\"lng\":-68.579712}},"
+    "{\"id\":\"1dd8e058\",\"sender\":\"user-51\",\"text\":\"stream over stream sensor sensor update order latency stream fox message humidity sensor stream over brown ok temperature latency quick over\",\"ts\":14937916000011782,\"seq\":86},"
+    "{\"id\":\"a43249d7\",\"sender\":\"user-29\",\"text\":\"order brown lazy the stream update lazy humidity ok stream humidity alert fox ok sensor\",\"ts\":14937916000011919,\"seq\":87,\"tags\":[\"jumps\",\"order\",\"alert\"]},"
+    "{\"id\":\"ee2325bc\",\"sender\":\"user-95\",\"text\":\"reading dog price price temperature humidity channel update\",\"ts\":14937916000012056,\"seq\":88},"
+    "{\"id\":\"1bbd2481\",\"sender\":\"user-286\",\"text\":\"realtime temperature dog lazy message jumps update jumps dog temperature fox alert stream stream realtime pubnub humidity brown update reading ok over realtime dog\",\"ts\":14937916000012193,\"seq\":89},"
+    "{\"id\":\"807aa6ee\",\"sender\":\"user-475\",\"text\":\"temperature stream sensor dog order reading message jumps pubnub stream brown\",\"ts\":14937916000012330,\"seq\":90,\"tags\":[\"ok\",\"humidity\",\"dog\"],\"geo\":{\"lat\":-45.607935,\"lng\":-165.788519}},"
+    "{\"id\":\"82b9df5e\",\"sender\":\"user-274\",\"text\":\"fox humidity pubnub message over brown realtime message dog fox order message order fox reading order over price \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000012467,\"seq\":91},"
+    "{\"id\":\"5bcf455a\",\"sender\":\"user-50\",\"text\":\"quick brown lazy message the ok quick lazy fox fox\",\"ts\":14937916000012604,\"seq\":92},"
+    "{\"id\":\"10483dda\",\"sender\":\"user-199\",\"text\":\"over jumps message brown message alert humidity order over pubnub channel dog ok the update alert alert over brown temperature brown realtime\",\"ts\":14937916000012741,\"seq\":93,\"tags\":[\"pubnub\",\"update\",\"reading\"]},"
+    "{\"id\":\"819e4a17\",\"sender\":\"user-244\",\"text\":\"fox temperature dog alert fox the latency alert sensor stream jumps fox alert dog pubnub dog dog\",\"ts\":14937916000012878,\"seq\":94},"
+    "{\"id\":\"27c373b6\",\"sender\":\"user-162\",\"text\":\"order update jumps dog lazy temperature reading pubnub pubnub alert ok humidity reading stream humidity jumps\",\"ts\":14937916000013015,\"seq\":95,\"geo\":{\"lat\":58.41778,\"lng\":-101.379103}},"
+    "{\"id\":\"f21526b5\",\"sender\":\"user-69\",\"text\":\"jumps jumps order latency order\",\"ts\":14937916000013152,\"seq\":96,\"tags\":[\"stream\",\"temperature\",\"pubnub\"]},"
+    "{\"id\":\"180c3e09\",\"sender\":\"user-391\",\"text\":\"dog message alert stream\",\"ts\":14937916000013289,\"seq\":97},"
+    "{\"id\":\"65cb9d15\",\"sender\":\"user-366\",\"text\":\"the fox realtime latency stream pubnub alert realtime channel \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000013426,\"seq\":98},"
+    "{\"id\":\"0f1112b9\",\"sender\":\"user-488\",\"text\":\"humidity brown humidity sensor alert dog over alert over price latency the\",\"ts\":14937916000013563,\"seq\":99,\"tags\":[\"alert\",\"stream\",\"realtime\"]},"
+    "{\"id\":\"3bb818b4\",\"sender\":\"user-340\",\"text\":\"order order brown update reading jumps over temperature humidity update realtime\",\"ts\":14937916000013700,\"seq\":100,\"geo\":{\"lat\":47.486371,\"lng\":56.37133}},"
+    "{\"id\":\"37d06b33\",\"sender\":\"user-400\",\"text\":\"message alert temperature channel channel dog message alert jumps the brown the realtime lazy\",\"ts\":14937916000013837,\"seq\":101},"
+    "{\"id\":\"2ddafa6f\",\"sender\":\"user-344\",\"text\":\"channel over reading stream realtime dog stream the message pubnub sensor pubnub over brown temperature pubnub dog temperature reading update pubnub message brown brown\",\"ts\":14937916000013974,\"seq\":102,\"tags\":[\"dog\",\"stream\",\"the\"]},"
+    "{\"id\":\"2242a75b\",\"sender\":\"user-115\",\"text\":\"price message message message price the humidity update humidity channel\",\"ts\":14937916000014111,\"seq\":103},"
+    "{\"id\":\"d5044e01\",\"sender\":\"user-336\",\"text\":\"the humidity reading jumps price brown order update over stream update alert order quick stream pubnub realtime channel realtime over quick\",\"ts\":14937916000014248,\"seq\":104},"
+    "{\"id\":\"0442bc18\",\"sender\":\"user-39\",\"text\":\"channel channel over stream lazy ok humidity humidity over update channel quick latency \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000014385,\"seq\":105,\"tags\":[\"pubnub\",\"over\",\"brown\"],\"geo\":{\"lat\":27.949113,\"lng\":-86.394323}},"
+    "{\"id\":\"177fc071\",\"sender\":\"user-353\",\"text\":\"message lazy message order update reading stream lazy over reading quick humidity temperature pubnub brown the the dog\",\"ts\":14937916000014522,\"seq\":106},"
+    "{\"id\":\"841f6a9f\",\"sender\":\"user-475\",\"text\":\"message fox latency ok lazy realtime update price realtime temperature lazy price dog latency alert order\",\"ts\":14937916000014659,\"seq\":107},"
+    "{\"id\":\"4a559699\",\"sender\":\"user-155\",\"text\":\"humidity fox channel temperature price jumps latency reading price pubnub jumps latency sensor dog\",\"ts\":14937916000014796,\"seq\":108,\"tags\":[\"order\",\"ok\",\"jumps\"]},"
+    "{\"id\":\"7f151246\",\"sender\":\"user-476\",\"text\":\"realtime realtime the pubnub update humidity realtime channel sensor message reading update price fox humidity dog reading brown temperature quick pubnub\",\"ts\":14937916000014933,\"seq\":109},"
+    "{\"id\":\"741e678a\",\"sender\":\"user-110\",\"text\":\"price fox sensor update jumps fox channel sensor dog brown brown lazy alert message brown realtime\",\"ts\":14937916000015070,\"seq\":110,\"geo\":{\"lat\":79.49386,\"lng\":-151.182783}},"
+    "{\"id\":\"8482c642\",\"sender\":\"user-323\",\"text\":\"humidity ok latency order sensor quick dog\",\"ts\":14937916000015207,\"seq\":111,\"tags\":[\"dog\",\"humidity\",\"order\"]},"
+    "{\"id\":\"17ecf972\",\"sender\":\"user-37\",\"text\":\"ok price humidity brown fox lazy fox \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000015344,\"seq\":112},"
+    "{\"id\":\"37d81564\",\"sender\":\"user-283\",\"text\":\"humidity update fox fox ok sensor price sensor sensor ok update fox over pubnub fox lazy fox realtime over\",\"ts\":14937916000015481,\"seq\":113},"
+    "{\"id\":\"ffff1e28\",\"sender\":\"user-496\",\"text\":\"jumps jumps order the price humidity over stream update realtime humidity message reading channel lazy fox dog over quick order the ok channel lazy\",\"ts\":14937916000015618,\"seq\":114,\"tags\":[\"over\",\"dog\",\"the\"]},"
+    "{\"id\":\"90602a23\",\"sender\":\"user-21\",\"text\":\"humidity realtime message stream latency lazy sensor fox fox order pubnub message pubnub channel quick order humidity sensor quick lazy jumps realtime price\",\"ts\":14937916000015755,\"seq\":115,\"geo\":{\"lat\":12.359656,\"lng\":156.432678}},"
+    "{\"id\":\"184dacce\",\"sender\":\"user-480\",\"text\":\"the order message jumps over ok brown reading lazy message pubnub temperature dog realtime price humidity order ok channel temperature stream quick\",\"ts\":14937916000015892,\"seq\":116},"
+    "{\"id\":\"8d57fbd9\",\"sender\":\"user-102\",\"text\":\"reading latency sensor over humidity sensor sensor lazy humidity alert alert sensor order order humidity order\",\"ts\":14937916000016029,\"seq\":117,\"tags\":[\"reading\",\"over\",\"temperature\"]},"
+    "{\"id\":\"cd8dcdf0\",\"sender\":\"user-279\",\"text\":\"temperature over fox dog reading\",\"ts\":14937916000016166,\"seq\":118},"
+    "{\"id\":\"4aa293e6\",\"sender\":\"user-173\",\"text\":\"brown brown channel latency over temperature reading order message pubnub update ok channel latency pubnub humidity price latency ok fox pubnub realtime order \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000016303,\"seq\":119},"
+    "{\"id\":\"a734f710\",\"sender\":\"user-444\",\"text\":\"dog stream ok channel update dog sensor fox alert message temperature stream price quick brown lazy dog update realtime temperature quick lazy\",\"ts\":14937916000016440,\"seq\":120,\"tags\":[\"quick\",\"reading\",\"sensor\"],\"geo\":{\"lat\":21.274179,\"lng\":-63.468322}},"
+    "{\"id\":\"06aa19a1\",\"sender\":\"user-66\",\"text\":\"update order message brown temperature stream over over ok message lazy latency lazy update message fox fox realtime\",\"ts\":14937916000016577,\"seq\":121},"
+    "{\"id\":\"6e0eee2c\",\"sender\":\"user-117\",\"text\":\"quick dog update update jumps\",\"ts\":14937916000016714,\"seq\":122},"
+    "{\"id\":\"6dc6c036\",\"sender\":\"user-344\",\"text\":\"realtime lazy update quick message realtime\",\"ts\":14937916000016851,\"seq\":123,\"tags\":[\"quick\",\"update\",\"pubnub\"]},"
+    "{\"id\":\"3f1e889d\",\"sender\":\"user-382\",\"text\":\"sensor latency update pubnub lazy the dog order latency fox order stream alert stream temperature\",\"ts\":14937916000016988,\"seq\":124},"
+    "{\"id\":\"5dd61f27\",\"sender\":\"user-115\",\"text\":\"the lazy reading dog order fox sensor dog reading latency fox sensor temperature sensor pubnub alert humidity channel price brown dog message over alert\",\"ts\":14937916000017125,\"seq\":125,\"geo\":{\"lat\":-59.832598,\"lng\":-55.926418}},"
+    "{\"id\":\"8d8f88b2\",\"sender\":\"user-2\",\"text\":\"order message price reading temperature order temperature lazy \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000017262,\"seq\":126,\"tags\":[\"brown\",\"lazy\",\"order\"]},"
+    "{\"id\":\"3cbaafcf\",\"sender\":\"user-88\",\"text\":\"humidity channel humidity update channel pubnub order latency stream update temperature jumps\",\"ts\":14937916000017399,\"seq\":127},"
+    "{\"id\":\"dd690082\",\"sender\":\"user-188\",\"text\":\"update ok jumps temperature\",\"ts\":14937916000017536,\"seq\":128},"
+    "{\"id\":\"d684fe4c\",\"sender\":\"user-472\",\"text\":\"latency lazy jumps stream price sensor order message order the ok fox lazy update lazy fox update fox channel reading channel channel stream\",\"ts\":14937916000017673,\"seq\":129,\"tags\":[\"update\",\"realtime\",\"temperature\"]},"
+    "{\"id\":\"17c0ab50\",\"sender\":\"user-391\",\"text\":\"lazy humidity order reading pubnub the\",\"ts\":14937916000017810,\"seq\":130,\"geo\":{\"lat\":66.358318,\"lng\":-99.662062}},"
+    "{\"id\":\"366c7227\",\"sender\":\"user-330\",\"text\":\"alert dog the the quick dog temperature latency order pubnub the the the order sensor message price\",\"ts\":14937916000017947,\"seq\":131},"
+    "{\"id\":\"6447e5ae\",\"sender\":\"user-454\",\"text\":\"the quick alert pubnub the alert latency reading the lazy the sensor lazy quick pubnub price message channel pubnub realtime fox alert\",\"ts\":14937916000018084,\"seq\":132,\"tags\":[\"latency\",\"ok\",\"update\"]},"
+    "{\"id\":\"98480e45\",\"sender\":\"user-1\",\"text\":\"over over over latency the update over the alert reading ok realtime pubnub sensor \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000018221,\"seq\":133},"
+    "{\"id\":\"6dd04d91\",\"sender\":\"user-31\",\"text\":\"ok reading dog price sensor humidity the message price temperature the price\",\"ts\":14937916000018358,\"seq\":134},"
+    "{\"id\":\"b34aa4a4\",\"sender\":\"user-247\",\"text\":\"alert channel price latency stream humidity temperature humidity latency lazy humidity fox order brown fox pubnub\",\"ts\":14937916000018495,\"seq\":135,\"tags\":[\"the\",\"quick\",\"channel\"],\"geo\":{\"lat\":17.378519,\"lng\":-99.963994}},"
+    "{\"id\":\"11fd80b1\",\"sender\":\"user-116\",\"text\":\"update pubnub humidity update update\",\"ts\":14937916000018632,\"seq\":136},"
+    "{\"id\":\"78837ec8\",\"sender\":\"user-1\",\"text\":\"order fox message ok order latency temperature dog reading the latency alert temperature jumps jumps latency\",\"ts\":14937916000018769,\"seq\":137},"
+    "{\"id\":\"6d33badc\",\"sender\":\"user-158\",\"text\":\"ok pubnub latency lazy pubnub\",\"ts\":14937916000018906,\"seq\":138,\"tags\":[\"dog\",\"quick\",\"lazy\"]},"
+    "{\"id\":\"f0482bb3\",\"sender\":\"user-30\",\"text\":\"humidity humidity realtime temperature ok message the\",\"ts\":14937916000019043,\"seq\":139},"
+    "{\"id\":\"e7a31c84\",\"sender\":\"user-463\",\"text\":\"channel sensor humidity sensor message humidity sensor pubnub fox message alert channel reading ok the pubnub jumps \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000019180,\"seq\":140,\"geo\":{\"lat\":20.759046,\"lng\":-97.661641}},"
+    "{\"id\":\"c031c96a\",\"sender\":\"user-181\",\"text\":\"temperature latency temperature humidity stream message brown price latency quick latency pubnub price message over pubnub\",\"ts\":14937916000019317,\"seq\":141,\"tags\":[\"quick\",\"order\",\"price\"]},"
+    "{\"id\":\"67c29330\",\"sender\":\"user-370\",\"text\":\"humidity ok dog update latency dog alert update the latency update lazy over dog\",\"ts\":14937916000019454,\"seq\":142},"
+    "{\"id\":\"d74825b9\",\"sender\":\"user-323\",\"text\":\"lazy update dog reading pubnub realtime price message reading dog\",\"ts\":14937916000019591,\"seq\":143},"
+    "{\"id\":\"4c37633e\",\"sender\":\"user-147\",\"text\":\"alert realtime brown over message dog dog jumps lazy channel\",\"ts\":14937916000019728,\"seq\":144,\"tags\":[\"temperature\",\"lazy\",\"the\"]},"
+    "{\"id\":\"181846da\",\"sender\":\"user-362\",\"text\":\"jumps quick reading quick stream order humidity\",\"ts\":14937916000019865,\"seq\":145,\"geo\":{\"lat\":14.083099,\"lng\":-7.572972}},"
+    "{\"id\":\"d4da1886\",\"sender\":\"user-105\",\"text\":\"channel lazy over latency ok over latency\",\"ts\":14937916000020002,\"seq\":146},"
+    "{\"id\":\"5026915b\",\"sender\":\"user-236\",\"text\":\"jumps fox alert update reading realtime \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000020139,\"seq\":147,\"tags\":[\"the\",\"order\",\"stream\"]},"
+    "{\"id\":\"e904c191\",\"sender\":\"user-278\",\"text\":\"quick brown temperature realtime lazy lazy stream lazy lazy latency quick\",\"ts\":14937916000020276,\"seq\":148},"
+    "{\"id\":\"c4ae8b20\",\"sender\":\"user-224\",\"text\":\"channel dog ok realtime temperature order the sensor quick over humidity update humidity temperature over update temperature pubnub jumps stream ok\",\"ts\":14937916000020413,\"seq\":149},"
+    "{\"id\":\"abbdc368\",\"sender\":\"user-359\",\"text\":\"pubnub dog pubnub realtime over alert alert reading jumps alert temperature latency stream price pubnub dog sensor alert latency latency the jumps over fox\",\"ts\":14937916000020550,\"seq\":150,\"tags\":[\"brown\",\"the\",\"alert\"],\"geo\":{\"lat\":8.804478,\"lng\":-42.332908}},"
+    "{\"id\":\"09976687\",\"sender\":\"user-362\",\"text\":\"brown brown dog brown message message\",\"ts\":14937916000020687,\"seq\":151},"
+    "{\"id\":\"cd9610a4\",\"sender\":\"user-355\",\"text\":\"temperature fox update stream\",\"ts\":14937916000020824,\"seq\":152},"
+    "{\"id\":\"244071b8\",\"sender\":\"user-68\",\"text\":\"message reading realtime price price the sensor over alert quick brown temperature order order sensor lazy pubnub humidity humidity sensor channel dog ok ok\",\"ts\":14937916000020961,\"seq\":153,\"tags\":[\"jumps\",\"the\",\"brown\"]},"
+    "{\"id\":\"3b45e6db\",\"sender\":\"user-209\",\"text\":\"jumps lazy reading quick quick dog price realtime reading over pubnub temperature sensor stream humidity brown dog ok dog alert stream \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000021098,\"seq\":154},"
+    "{\"id\":\"95741e50\",\"sender\":\"user-467\",\"text\":\"over sensor ok pubnub dog lazy quick fox latency humidity lazy ok channel over pubnub channel realtime reading latency realtime the\",\"ts\":14937916000021235,\"seq\":155,\"geo\":{\"lat\":-31.285628,\"lng\":134.535727}},"
+    "{\"id\":\"3b41407a\",\"sender\":\"user-482\",\"text\":\"ok pubnub latency stream alert realtime reading sensor latency channel fox the stream alert reading\",\"ts\":14937916000021372,\"seq\":156,\"tags\":[\"realtime\",\"humidity\",\"latency\"]},"
+    "{\"id\":\"37fe6903\",\"sender\":\"user-381\",\"text\":\"price the jumps brown latency order fox\",\"ts\":14937916000021509,\"seq\":157},"
+    "{\"id\":\"ffd7f84d\",\"sender\":\"user-325\",\"text\":\"fox alert realtime dog reading quick temperature lazy humidity dog humidity humidity latency quick ok dog jumps sensor brown quick temperature latency stream pubnub\",\"ts\":14937916000021646,\"seq\":158},"
+    "{\"id\":\"5067bdcd\",\"sender\":\"user-352\",\"text\":\"channel sensor jumps fox reading quick realtime fox quick the dog humidity jumps update update pubnub the fox brown order temperature\",\"ts\":14937916000021783,\"seq\":159,\"tags\":[\"alert\",\"sensor\",\"fox\"]},"
+    "{\"id\":\"b477e14d\",\"sender\":\"user-52\",\"text\":\"order jumps reading channel pubnub ok humidity stream the stream reading order humidity lazy realtime message\",\"ts\":14937916000021920,\"seq\":160,\"geo\":{\"lat\":-69.309051,\"lng\":0.636212}},"
+    "{\"id\":\"94a2e903\",\"sender\":\"user-196\",\"text\":\"sensor realtime temperature reading lazy message channel over pubnub alert \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000022057,\"seq\":161},"
+    "{\"id\":\"0c79c3e1\",\"sender\":\"user-207\",\"text\":\"reading stream reading sensor lazy sensor reading message order latency jumps message fox sensor message alert sensor sensor jumps price message brown update\",\"ts\":14937916000022194,\"seq\":162,\"tags\":[\"ok\",\"latency\",\"sensor\"]},"
+    "{\"id\":\"904601e5\",\"sender\":\"user-323\",\"text\":\"price fox realtime fox latency quick dog pubnub dog realtime temperature sensor fox update message\",\"ts\":14937916000022331,\"seq\":163},"
+    "{\"id\":\"bc666f2b\",\"sender\":\"user-424\",\"text\":\"the realtime fox humidity\",\"ts\":14937916000022468,\"seq\":164},"
+    "{\"id\":\"004380b9\",\"sender\":\"user-465\",\"text\":\"alert update latency stream sensor latency update brown over temperature jumps order brown reading jumps jumps realtime pubnub quick the\",\"ts\":14937916000022605,\"seq\":165,\"tags\":[\"dog\",\"alert\",\"realtime\"],\"geo\":{\"lat\":54.020176,\"lng\":163.801919}},"
+    "{\"id\":\"b6bb40a9\",\"sender\":\"user-394\",\"text\":\"alert humidity the quick stream pubnub brown stream dog pubnub over over update realtime sensor stream jumps\",\"ts\":14937916000022742,\"seq\":166},"
+    "{\"id\":\"589bb215\",\"sender\":\"user-283\",\"text\":\"reading price temperature sensor reading fox channel the stream latency stream message update order\",\"ts\":14937916000022879,\"seq\":167},"
+    "{\"id\":\"c1231c0d\",\"sender\":\"user-142\",\"text\":\"brown temperature ok jumps \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000023016,\"seq\":168,\"tags\":[\"update\",\"jumps\",\"pubnub\"]},"
+    "{\"id\":\"c5abf7fe\",\"sender\":\"user-294\",\"text\":\"latency channel sensor pubnub realtime channel ok realtime realtime update sensor message realtime latency realtime stream price pubnub lazy pubnub pubnub latency stream\",\"ts\":14937916000023153,\"seq\":169},"
+    "{\"id\":\"fe9fc5bc\",\"sender\":\"user-65\",\"text\":\"latency humidity the temperature humidity stream order brown latency jumps lazy dog ok temperature lazy message jumps order temperature stream ok dog\",\"ts\":14937916000023290,\"seq\":170,\"geo\":{\"lat\":15.609761,\"lng\":86.137943}},"
+    "{\"id\":\"cdbf1853\",\"sender\":\"user-138\",\"text\":\"alert channel pubnub pubnub latency reading\",\"ts\":14937916000023427,\"seq\":171,\"tags\":[\"price\",\"temperature\",\"channel\"]},"
+    "{\"id\":\"12ac16ae\",\"sender\":\"user-219\",\"text\":\"sensor dog over brown ok price price sensor ok price dog order brown over dog jumps the jumps reading\",\"ts\":14937916000023564,\"seq\":172},"
+    "{\"id\":\"f9610ef2\",\"sender\":\"user-338\",\"text\":\"the stream brown fox humidity over latency pubnub dog lazy dog stream latency\",\"ts\":14937916000023701,\"seq\":173},"
+    "{\"id\":\"e087d4ae\",\"sender\":\"user-329\",\"text\":\"latency brown price fox quick order stream order\",\"ts\":14937916000023838,\"seq\":174,\"tags\":[\"order\",\"update\",\"latency\"]},"
+    "{\"id\":\"a64dffd2\",\"sender\":\"user-157\",\"text\":\"realtime channel dog pubnub update quick dog sensor ok latency latency stream the sensor fox brown fox over channel reading \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000023975,\"seq\":175,\"geo\":{\"lat\":39.612033,\"lng\":174.002522}},"
+    "{\"id\":\"f0448a03\",\"sender\":\"user-212\",\"text\":\"quick alert update the realtime sensor alert sensor realtime jumps over price quick fox price ok message order humidity alert temperature\",\"ts\":14937916000024112,\"seq\":176},"
+    "{\"id\":\"69703c82\",\"sender\":\"user-135\",\"text\":\"stream dog update the channel quick brown jumps ok temperature price ok sensor latency jumps jumps update channel latency dog alert\",\"ts\":14937916000024249,\"seq\":177,\"tags\":[\"update\",\"price\",\"reading\"]},"
+    "{\"id\":\"1f8ed133\",\"sender\":\"user-289\",\"text\":\"over latency over update channel order price alert quick sensor message sensor humidity price\",\"ts\":14937916000024386,\"seq\":178},"
+    "{\"id\":\"10683c45\",\"sender\":\"user-312\",\"text\":\"update lazy dog latency brown jumps ok pubnub sensor the brown channel stream temperature sensor price humidity\",\"ts\":14937916000024523,\"seq\":179},"
+    "{\"id\":\"d98a36fc\",\"sender\":\"user-13\",\"text\":\"order latency ok reading ok order realtime alert brown message update order pubnub brown sensor order stream jumps latency jumps message quick brown the\",\"ts\":14937916000024660,\"seq\":180,\"tags\":[\"ok\",\"humidity\",\"pubnub\"],\"geo\":{\"lat\":65.334513,\"lng\":-117.201165}},"
+    "{\"id\":\"f94cc2c7\",\"sender\":\"user-301\",\"text\":\"sensor realtime alert update over jumps brown latency the message channel quick reading quick the quick humidity dog lazy order channel temperature\",\"ts\":14937916000024797,\"seq\":181},"
+    "{\"id\":\"9ff93874\",\"sender\":\"user-159\",\"text\":\"humidity latency dog latency \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000024934,\"seq\":182},"
+    "{\"id\":\"0ee8b96c\",\"sender\":\"user-482\",\"text\":\"over stream jumps order realtime quick\",\"ts\":14937916000025071,\"seq\":183,\"tags\":[\"brown\",\"ok\",\"realtime\"]},"
+    "{\"id\":\"bf03f4e1\",\"sender\":\"user-47\",\"text\":\"fox channel fox quick price price over dog price lazy fox jumps over over update sensor fox brown pubnub reading stream price\",\"ts\":14937916000025208,\"seq\":184},"
+    "{\"id\":\"c492cb1e\",\"sender\":\"user-399\",\"text\":\"update jumps brown quick alert channel temperature temperature temperature brown latency brown brown pubnub update temperature lazy channel over\",\"ts\":14937916000025345,\"seq\":185,\"geo\":{\"lat\":46.529736,\"lng\":150.337383}},"
+    "{\"id\":\"8da787ab\",\"sender\":\"user-206\",\"text\":\"dog latency lazy brown dog pubnub fox\",\"ts\":14937916000025482,\"seq\":186,\"tags\":[\"dog\",\"humidity\",\"channel\"]},"
+    "{\"id\":\"56b4253f\",\"sender\":\"user-68\",\"text\":\"realtime humidity ok humidity message temperature the jumps stream channel order price brown\",\"ts\":14937916000025619,\"seq\":187},"
+    "{\"id\":\"582e38f3\",\"sender\":\"user-167\",\"text\":\"humidity message pubnub reading over realtime sensor over reading sensor the reading pubnub price update ok the stream update order temperature\",\"ts\":14937916000025756,\"seq\":188},"
+    "{\"id\":\"8302abb1\",\"sender\":\"user-307\",\"text\":\"sensor fox realtime stream over quick update sensor brown channel temperature alert fox message quick \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000025893,\"seq\":189,\"tags\":[\"realtime\",\"update\",\"ok\"]},"
+    "{\"id\":\"41874dca\",\"sender\":\"user-498\",\"text\":\"channel message humidity lazy the\",\"ts\":14937916000026030,\"seq\":190,\"geo\":{\"lat\":-33.318845,\"lng\":12.44302}},"
+    "{\"id\":\"12fde8e0\",\"sender\":\"user-125\",\"text\":\"brown update realtime stream price over ok brown channel humidity price order sensor fox brown update the alert message\",\"ts\":14937916000026167,\"seq\":191},"
+    "{\"id\":\"eee83834\",\"sender\":\"user-63\",\"text\":\"realtime message update humidity sensor humidity\",\"ts\":14937916000026304,\"seq\":192,\"tags\":[\"over\",\"pubnub\",\"fox\"]},"
+    "{\"id\":\"dc72be8f\",\"sender\":\"user-368\",\"text\":\"latency price over brown latency pubnub fox pubnub pubnub latency update lazy update jumps jumps order pubnub temperature the\",\"ts\":14937916000026441,\"seq\":193},"
+    "{\"id\":\"9b5ed510\",\"sender\":\"user-273\",\"text\":\"realtime price price update the order\",\"ts\":14937916000026578,\"seq\":194},"
+    "{\"id\":\"19db3f03\",\"sender\":\"user-276\",\"text\":\"channel fox dog humidity humidity lazy order price over humidity pubnub dog latency fox reading ok price update\",\"ts\":14937916000026715,\"seq\":195,\"tags\":[\"sensor\",\"humidity\",\"alert\"],\"geo\":{\"lat\":41.281946,\"lng\":87.498221}},"
+    "{\"id\":\"cebbf4c1\",\"sender\":\"user-27\",\"text\":\"pubnub over lazy quick temperature temperature order brown reading \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000026852,\"seq\":196},"
+    "{\"id\":\"ef16da78\",\"sender\":\"user-434\",\"text\":\"reading brown fox quick reading latency quick update channel fox\",\"ts\":14937916000026989,\"seq\":197},"
+    "{\"id\":\"61fe0ccf\",\"sender\":\"user-18\",\"text\":\"sensor over sensor pubnub over fox fox price the channel fox channel quick the dog stream reading temperature stream pubnub reading humidity the\",\"ts\":14937916000027126,\"seq\":198,\"tags\":[\"order\",\"jumps\",\"brown\"]},"
+    "{\"id\":\"bb765e59\",\"sender\":\"user-382\",\"text\":\"realtime channel sensor pubnub\",\"ts\":14937916000027263,\"seq\":199}"
+    "],\"14937916123456789\",\"chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors,chat,alerts,prices,sensors\"]";
+
+size_t const pbmb_subscribe_large_len = sizeof pbmb_subscribe_large - 1;
+unsigned const pbmb_subscribe_large_count = 200;
+
+
+char const pbmb_history_page[] =
+    "[["
+    "{\"id\":\"e53bb5ac\",\"sender\":\"user-31\",\"text\":\"realtime humidity price realtime channel humidity the price message sensor latency temperature realtime order ok update lazy\",\"ts\":14937916000137000,\"seq\":1000,\"geo\":{\"lat\":70.611596,\"lng\":-131.068771}},"
+    "{\"id\":\"d07c87e1\",\"sender\":\"user-438\",\"text\":\"message alert pubnub order order jumps order update sensor \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000137137,\"seq\":1001},"
+    "{\"id\":\"4776d3cf\",\"sender\":\"user-185\",\"text\":\"stream ok brown fox update pubnub pubnub\",\"ts\":14937916000137274,\"seq\":1002,\"tags\":[\"dog\",\"alert\",\"message\"]},"
+    "{\"id\":\"3a6d4042\",\"sender\":\"user-416\",\"text\":\"update the pubnub fox over message quick realtime over ok latency quick pubnub ok alert channel order temperature reading sensor message update message pubnub\",\"ts\":14937916000137411,\"seq\":1003},"
+    "{\"id\":\"2434bd37\",\"sender\":\"user-143\",\"text\":\"dog fox price quick update ok alert sensor alert order stream price price temperature temperature temperature lazy realtime jumps message\",\"ts\":14937916000137548,\"seq\":1004},"
+    "{\"id\":\"26bd6203\",\"sender\":\"user-272\",\"text\":\"quick channel order humidity jumps quick order sensor fox jumps lazy jumps over alert over temperature dog\",\"ts\":14937916000137685,\"seq\":1005,\"tags\":[\"fox\",\"update\",\"dog\"],\"geo\":{\"lat\":40.867582,\"lng\":175.485205}},"
+    "{\"id\":\"71ec6718\",\"sender\":\"user-345\",\"text\":\"fox humidity brown dog temperature quick stream sensor stream sensor ok humidity\",\"ts\":14937916000137822,\"seq\":1006},"
+    "{\"id\":\"1acd5c53\",\"sender\":\"user-17\",\"text\":\"alert message temperature stream lazy brown update realtime ok channel dog latency latency reading fox stream\",\"ts\":14937916000137959,\"seq\":1007},"
+    "{\"id\":\"bbb8e44d\",\"sender\":\"user-397\",\"text\":\"the reading temperature lazy jumps lazy fox temperature the channel the stream update pubnub \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000138096,\"seq\":1008,\"tags\":[\"temperature\",\"realtime\",\"price\"]},"
+    "{\"id\":\"275e3df4\",\"sender\":\"user-53\",\"text\":\"reading lazy order price channel reading dog fox realtime fox humidity reading temperature sensor lazy over message dog channel price channel\",\"ts\":14937916000138233,\"seq\":1009},"
+    "{\"id\":\"73dc927c\",\"sender\":\"user-393\",\"text\":\"alert pubnub over order temperature order stream channel reading jumps channel temperature update alert jumps message\",\"ts\":14937916000138370,\"seq\":1010,\"geo\":{\"lat\":67.501826,\"lng\":128.403496}},"
+    "{\"id\":\"0807ed4c\",\"sender\":\"user-180\",\"text\":\"humidity ok reading temperature pubnub latency sensor alert quick fox sensor update lazy brown dog stream brown update ok sensor humidity ok fox\",\"ts\":14937916000138507,\"seq\":1011,\"tags\":[\"jumps\",\"order\",\"reading\"]},"
+    "{\"id\":\"f4258559\",\"sender\":\"user-105\",\"text\":\"humidity over channel alert fox alert reading quick message ok humidity pubnub stream\",\"ts\":14937916000138644,\"seq\":1012},"
+    "{\"id\":\"af7e189c\",\"sender\":\"user-389\",\"text\":\"message quick alert latency fox realtime channel sensor realtime quick dog quick over ok\",\"ts\":14937916000138781,\"seq\":1013},"
+    "{\"id\":\"dc3467b4\",\"sender\":\"user-417\",\"text\":\"realtime dog pubnub realtime reading channel update quick sensor alert\",\"ts\":14937916000138918,\"seq\":1014,\"tags\":[\"reading\",\"order\",\"realtime\"]},"
+    "{\"id\":\"6c958683\",\"sender\":\"user-275\",\"text\":\"message price jumps pubnub latency brown order temperature pubnub order price channel order price temperature fox brown price dog \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000139055,\"seq\":1015,\"geo\":{\"lat\":-43.046723,\"lng\":-7.453187}},"
+    "{\"id\":\"39b63cf4\",\"sender\":\"user-91\",\"text\":\"reading sensor update realtime alert the sensor reading channel quick lazy brown\",\"ts\":14937916000139192,\"seq\":1016},"
+    "{\"id\":\"151659d4\",\"sender\":\"user-420\",\"text\":\"price stream stream over jumps the lazy update sensor ok quick realtime humidity lazy fox fox pubnub update lazy jumps pubnub pubnub\",\"ts\":14937916000139329,\"seq\":1017,\"tags\":[\"alert\",\"quick\",\"temperature\"]},"
+    "{\"id\":\"2af3299d\",\"sender\":\"user-321\",\"text\":\"temperature fox ok humidity ok brown quick channel sensor latency humidity stream sensor quick quick reading reading over over brown fox ok\",\"ts\":14937916000139466,\"seq\":1018},"
+    "{\"id\":\"c2b40419\",\"sender\":\"user-199\",\"text\":\"channel humidity alert over latency pubnub humidity\",\"ts\":14937916000139603,\"seq\":1019},"
+    "{\"id\":\"4d2d9b3c\",\"sender\":\"user-70\",\"text\":\"channel ok update brown\",\"ts\":14937916000139740,\"seq\":1020,\"tags\":[\"realtime\",\"pubnub\",\"quick\"],\"geo\":{\"lat\":-81.044872,\"lng\":-152.105573}},"
+    "{\"id\":\"49e6f33a\",\"sender\":\"user-266\",\"text\":\"latency pubnub order the jumps over reading update the over jumps dog ok sensor update dog the latency realtime stream\",\"ts\":14937916000139877,\"seq\":1021},"
+    "{\"id\":\"e79385a4\",\"sender\":\"user-249\",\"text\":\"pubnub price update brown temperature price message dog jumps fox reading stream price message \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000140014,\"seq\":1022},"
+    "{\"id\":\"1eef5dfb\",\"sender\":\"user-420\",\"text\":\"jumps latency message dog dog reading the realtime jumps dog quick quick stream update brown pubnub\",\"ts\":14937916000140151,\"seq\":1023,\"tags\":[\"humidity\",\"quick\",\"lazy\"]},"
+    "{\"id\":\"1071432f\",\"sender\":\"user-89\",\"text\":\"alert sensor brown pubnub pubnub lazy\",\"ts\":14937916000140288,\"seq\":1024},"
+    "{\"id\":\"442a9d54\",\"sender\":\"user-387\",\"text\":\"dog fox brown fox\",\"ts\":14937916000140425,\"seq\":1025,\"geo\":{\"lat\":-17.037284,\"lng\":162.471147}},"
+    "{\"id\":\"374ff3ec\",\"sender\":\"user-341\",\"text\":\"jumps price quick quick\",\"ts\":14937916000140562,\"seq\":1026,\"tags\":[\"temperature\",\"realtime\",\"humidity\"]},"
+    "{\"id\":\"982f6d28\",\"sender\":\"user-35\",\"text\":\"jumps dog brown brown\",\"ts\":14937916000140699,\"seq\":1027},"
+    "{\"id\":\"d1e3969c\",\"sender\":\"user-110\",\"text\":\"latency latency dog quick temperature latency order lazy quick update brown ok pubnub lazy order humidity latency brown alert humidity brown channel latency\",\"ts\":14937916000140836,\"seq\":1028},"
+    "{\"id\":\"fe258ec2\",\"sender\":\"user-162\",\"text\":\"price the alert order sensor quick jumps ok reading pubnub lazy order quick \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000140973,\"seq\":1029,\"tags\":[\"price\",\"update\",\"reading\"]},"
+    "{\"id\":\"a631610a\",\"sender\":\"user-406\",\"text\":\"pubnub order order humidity dog ok channel alert alert lazy sensor message realtime the temperature latency realtime pubnub temperature temperature\",\"ts\":14937916000141110,\"seq\":1030,\"geo\":{\"lat\":-67.534016,\"lng\":106.567217}},"
+    "{\"id\":\"9b4c7714\",\"sender\":\"user-264\",\"text\":\"price humidity pubnub ok stream temperature channel humidity message ok pubnub temperature price realtime humidity update brown quick over update ok message order\",\"ts\":14937916000141247,\"seq\":1031},"
+    "{\"id\":\"4d21617a\",\"sender\":\"user-86\",\"text\":\"reading order brown latency realtime price lazy update latency message\",\"ts\":14937916000141384,\"seq\":1032,\"tags\":[\"quick\",\"stream\",\"dog\"]},"
+    "{\"id\":\"f83d2748\",\"sender\":\"user-45\",\"text\":\"jumps quick fox temperature brown sensor temperature price stream price message price sensor humidity lazy price order the pubnub ok\",\"ts\":14937916000141521,\"seq\":1033},"
+    "{\"id\":\"3610c1c5\",\"sender\":\"user-354\",\"text\":\"the order fox pubnub message brown the sensor jumps quick channel the lazy temperature quick pubnub dog humidity stream quick alert\",\"ts\":14937916000141658,\"seq\":1034},"
+    "{\"id\":\"6c270168\",\"sender\":\"user-268\",\"text\":\"update pubnub stream reading channel humidity temperature channel the message alert sensor sensor realtime realtime dog\",\"ts\":14937916000141795,\"seq\":1035,\"tags\":[\"update\",\"price\",\"quick\"],\"geo\":{\"lat\":22.154677,\"lng\":11.682655}},"
+    "{\"id\":\"eb4df1a7\",\"sender\":\"user-98\",\"text\":\"reading stream dog reading alert sensor price lazy latency stream humidity over reading \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000141932,\"seq\":1036},"
+    "{\"id\":\"1defa0b3\",\"sender\":\"user-164\",\"text\":\"dog the lazy ok over reading stream channel channel fox brown lazy message sensor temperature channel order fox\",\"ts\":14937916000142069,\"seq\":1037},"
+    "{\"id\":\"5047b6c2\",\"sender\":\"user-301\",\"text\":\"humidity channel temperature sensor the alert alert update lazy jumps latency lazy\",\"ts\":14937916000142206,\"seq\":1038,\"tags\":[\"update\",\"brown\",\"reading\"]},"
+    "{\"id\":\"fed32633\",\"sender\":\"user-98\",\"text\":\"pubnub order channel price dog quick the message\",\"ts\":14937916000142343,\"seq\":1039},"
+    "{\"id\":\"eef67a11\",\"sender\":\"user-73\",\"text\":\"jumps dog price dog sensor quick humidity alert realtime the over over alert sensor\",\"ts\":14937916000142480,\"seq\":1040,\"geo\":{\"lat\":-3.967183,\"lng\":-134.341642}},"
+    "{\"id\":\"adf9946f\",\"sender\":\"user-38\",\"text\":\"pubnub lazy stream latency stream fox alert alert price the order jumps over pubnub stream fox quick update price quick realtime\",\"ts\":14937916000142617,\"seq\":1041,\"tags\":[\"message\",\"realtime\",\"jumps\"]},"
+    "{\"id\":\"384c7335\",\"sender\":\"user-386\",\"text\":\"price over update update latency update fox alert dog channel latency quick lazy\",\"ts\":14937916000142754,\"seq\":1042},"
+    "{\"id\":\"f304ff5e\",\"sender\":\"user-176\",\"text\":\"the message fox jumps sensor stream over pubnub stream alert \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000142891,\"seq\":1043},"
+    "{\"id\":\"c0c0248e\",\"sender\":\"user-6\",\"text\":\"realtime realtime lazy latency jumps temperature temperature update price order the ok sensor message jumps\",\"ts\":14937916000143028,\"seq\":1044,\"tags\":[\"channel\",\"pubnub\",\"update\"]},"
+    "{\"id\":\"f61f7990\",\"sender\":\"user-35\",\"text\":\"message alert channel channel sensor temperature fox over alert humidity pubnub\",\"ts\":14937916000143165,\"seq\":1045,\"geo\":{\"lat\":16.796251,\"lng\":46.246345}},"
+    "{\"id\":\"68e7df36\",\"sender\":\"user-263\",\"text\":\"stream brown alert alert order dog fox ok\",\"ts\":14937916000143302,\"seq\":1046},"
+    "{\"id\":\"6b51d1b0\",\"sender\":\"user-189\",\"text\":\"realtime message ok stream humidity jumps quick fox fox realtime pubnub over reading price humidity humidity\",\"ts\":14937916000143439,\"seq\":1047,\"tags\":[\"the\",\"over\",\"temperature\"]},"
+    "{\"id\":\"01ae6af1\",\"sender\":\"user-41\",\"text\":\"channel message sensor temperature lazy reading sensor dog brown message price sensor pubnub quick update stream brown the\",\"ts\":14937916000143576,\"seq\":1048},"
+    "{\"id\":\"44fe2dc6\",\"sender\":\"user-1\",\"text\":\"latency channel lazy channel the price pubnub jumps temperature update quick reading realtime price update price humidity ok humidity\",\"ts\":14937916000143713,\"seq\":1049},"
+    "{\"id\":\"474f3447\",\"sender\":\"user-220\",\"text\":\"reading dog message jumps fox message jumps fox dog over brown jumps \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000143850,\"seq\":1050,\"tags\":[\"stream\",\"channel\",\"jumps\"],\"geo\":{\"lat\":-71.102647,\"lng\":4.97369}},"
+    "{\"id\":\"134e0dac\",\"sender\":\"user-455\",\"text\":\"the pubnub channel realtime fox the fox order reading alert\",\"ts\":14937916000143987,\"seq\":1051},"
+    "{\"id\":\"f582677a\",\"sender\":\"user-321\",\"text\":\"message realtime dog reading\",\"ts\":14937916000144124,\"seq\":1052},"
+    "{\"id\":\"863e0237\",\"sender\":\"user-77\",\"text\":\"message quick sensor humidity order over temperature lazy jumps order quick channel fox quick update\",\"ts\":14937916000144261,\"seq\":1053,\"tags\":[\"brown\",\"lazy\",\"latency\"]},"
+    "{\"id\":\"e5c6263e\",\"sender\":\"user-125\",\"text\":\"quick lazy channel order realtime ok pubnub fox price temperature\",\"ts\":14937916000144398,\"seq\":1054},"
+    "{\"id\":\"cf50cddb\",\"sender\":\"user-155\",\"text\":\"sensor the ok pubnub\",\"ts\":14937916000144535,\"seq\":1055,\"geo\":{\"lat\":-74.61165,\"lng\":40.536057}},"
+    "{\"id\":\"ee0b9e23\",\"sender\":\"user-298\",\"text\":\"latency jumps over brown fox ok update realtime sensor alert over realtime message realtime latency pubnub order update pubnub message price update\",\"ts\":14937916000144672,\"seq\":1056,\"tags\":[\"price\",\"temperature\",\"update\"]},"
+    "{\"id\":\"b7368f98\",\"sender\":\"user-364\",\"text\":\"quick order pubnub channel \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000144809,\"seq\":1057},"
+    "{\"id\":\"e77afbf9\",\"sender\":\"user-88\",\"text\":\"brown order temperature quick stream order dog\",\"ts\":14937916000144946,\"seq\":1058},"
+    "{\"id\":\"6372bc9e\",\"sender\":\"user-481\",\"text\":\"temperature humidity temperature alert over jumps order price update message temperature reading\",\"ts\":14937916000145083,\"seq\":1059,\"tags\":[\"ok\",\"reading\",\"humidity\"]},"
+    "{\"id\":\"70472e53\",\"sender\":\"user-203\",\"text\":\"alert ok message stream stream sensor jumps temperature over realtime price alert reading ok realtime price update over brown latency\",\"ts\":14937916000145220,\"seq\":1060,\"geo\":{\"lat\":-83.350358,\"lng\":-173.191167}},"
+    "{\"id\":\"2e474000\",\"sender\":\"user-44\",\"text\":\"message brown lazy over dog ok update stream stream message the over humidity reading message fox reading fox sensor alert price\",\"ts\":14937916000145357,\"seq\":1061},"
+    "{\"id\":\"8665ff7d\",\"sender\":\"user-140\",\"text\":\"pubnub temperature latency latency ok fox lazy channel alert ok quick sensor update stream sensor latency order sensor reading over latency realtime dog sensor\",\"ts\":14937916000145494,\"seq\":1062,\"tags\":[\"message\",\"update\",\"reading\"]},"
+    "{\"id\":\"f0cec0a6\",\"sender\":\"user-391\",\"text\":\"latency order alert alert order dog\",\"ts\":14937916000145631,\"seq\":1063},"
+    "{\"id\":\"1a4062a2\",\"sender\":\"user-261\",\"text\":\"message dog alert reading alert jumps jumps temperature \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000145768,\"seq\":1064},"
+    "{\"id\":\"b41b44b9\",\"sender\":\"user-154\",\"text\":\"price sensor brown reading temperature the stream fox ok the over over dog stream stream price sensor realtime over price order\",\"ts\":14937916000145905,\"seq\":1065,\"tags\":[\"ok\",\"the\",\"pubnub\"],\"geo\":{\"lat\":-11.906006,\"lng\":18.317396}},"
+    "{\"id\":\"99f46521\",\"sender\":\"user-393\",\"text\":\"dog sensor ok jumps the message jumps pubnub price price humidity the\",\"ts\":14937916000146042,\"seq\":1066},"
+    "{\"id\":\"d1f1bed4\",\"sender\":\"user-364\",\"text\":\"pubnub reading pubnub reading latency ok price lazy price order lazy dog stream order sensor over latency over price the humidity quick reading\",\"ts\":14937916000146179,\"seq\":1067},"
+    "{\"id\":\"8cf20429\",\"sender\":\"user-403\",\"text\":\"alert price quick reading jumps jumps brown fox jumps the temperature latency latency message temperature brown jumps ok update sensor\",\"ts\":14937916000146316,\"seq\":1068,\"tags\":[\"lazy\",\"channel\",\"reading\"]},"
+    "{\"id\":\"2a8fd44d\",\"sender\":\"user-256\",\"text\":\"stream price stream dog sensor stream temperature fox\",\"ts\":14937916000146453,\"seq\":1069},"
+    "{\"id\":\"15d7c04d\",\"sender\":\"user-293\",\"text\":\"sensor reading latency temperature over brown brown channel over pubnub price dog update ok brown jumps ok over latency dog\",\"ts\":14937916000146590,\"seq\":1070,\"geo\":{\"lat\":48.754465,\"lng\":130.797467}},"
+    "{\"id\":\"bce846ab\",\"sender\":\"user-133\",\"text\":\"quick channel quick humidity humidity price realtime stream alert jumps channel brown quick quick sensor channel realtime \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000146727,\"seq\":1071,\"tags\":[\"message\",\"pubnub\",\"alert\"]},"
+    "{\"id\":\"28c53b7d\",\"sender\":\"user-41\",\"text\":\"channel stream update jumps update ok quick dog quick order latency over channel sensor sensor dog lazy brown pubnub sensor channel quick stream\",\"ts\":14937916000146864,\"seq\":1072},"
+    "{\"id\":\"505cb4a4\",\"sender\":\"user-217\",\"text\":\"reading quick message message message reading reading stream reading quick over temperature price update ok ok pubnub sensor reading message pubnub fox temperature\",\"ts\":14937916000147001,\"seq\":1073},"
+    "{\"id\":\"e6d75d85\",\"sender\":\"user-250\",\"text\":\"reading realtime humidity latency sensor jumps update fox\",\"ts\":14937916000147138,\"seq\":1074,\"tags\":[\"ok\",\"pubnub\",\"jumps\"]},"
+    "{\"id\":\"9dca0c49\",\"sender\":\"user-376\",\"text\":\"realtime humidity sensor the update quick message brown realtime alert lazy dog ok message jumps stream message\",\"ts\":14937916000147275,\"seq\":1075,\"geo\":{\"lat\":15.758524,\"lng\":60.75445}},"
+    "{\"id\":\"4c08503b\",\"sender\":\"user-448\",\"text\":\"stream sensor order ok sensor jumps over realtime update temperature\",\"ts\":14937916000147412,\"seq\":1076},"
+    "{\"id\":\"60a36cc2\",\"sender\":\"user-120\",\"text\":\"pubnub over realtime order pubnub alert\",\"ts\":14937916000147549,\"seq\":1077,\"tags\":[\"ok\",\"dog\",\"stream\"]},"
+    "{\"id\":\"034f1624\",\"sender\":\"user-193\",\"text\":\"update update lazy lazy quick sensor channel sensor quick temperature channel over fox realtime brown latency the \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000147686,\"seq\":1078},"
+    "{\"id\":\"cff84ec4\",\"sender\":\"user-451\",\"text\":\"over price order brown update temperature brown dog pubnub the price sensor pubnub price over humidity\",\"ts\":14937916000147823,\"seq\":1079},"
+    "{\"id\":\"c9dbd1d2\",\"sender\":\"user-81\",\"text\":\"reading realtime alert fox pubnub fox brown pubnub dog stream dog fox stream humidity pubnub quick stream\",\"ts\":14937916000147960,\"seq\":1080,\"tags\":[\"lazy\",\"alert\",\"realtime\"],\"geo\":{\"lat\":34.268292,\"lng\":71.781558}},"
+    "{\"id\":\"caa767cd\",\"sender\":\"user-452\",\"text\":\"fox message temperature quick sensor fox humidity latency fox humidity humidity over pubnub realtime fox the temperature order price message dog pubnub\",\"ts\":14937916000148097,\"seq\":1081},"
+    "{\"id\":\"72eda0f8\",\"sender\":\"user-159\",\"text\":\"humidity order over stream ok lazy pubnub quick over\",\"ts\":14937916000148234,\"seq\":1082},"
+    "{\"id\":\"4d9e4abb\",\"sender\":\"user-113\",\"text\":\"dog quick brown the order update pubnub dog quick reading fox quick sensor channel quick the jumps sensor ok\",\"ts\":14937916000148371,\"seq\":1083,\"tags\":[\"stream\",\"jumps\",\"alert\"]},"
+    "{\"id\":\"63b2710f\",\"sender\":\"user-271\",\"text\":\"channel dog jumps stream stream sensor alert dog temperature jumps channel humidity price order jumps order\",\"ts\":14937916000148508,\"seq\":1084},"
+    "{\"id\":\"eae5c94f\",\"sender\":\"user-399\",\"text\":\"channel channel alert sensor fox lazy humidity latency channel latency brown pubnub temperature temperature latency ok fox over reading order \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000148645,\"seq\":1085,\"geo\":{\"lat\":-5.876688,\"lng\":-178.54856}},"
+    "{\"id\":\"8d9a93bc\",\"sender\":\"user-272\",\"text\":\"over alert lazy humidity quick update humidity reading ok dog quick channel over price ok price alert sensor quick over channel order humidity channel\",\"ts\":14937916000148782,\"seq\":1086,\"tags\":[\"update\",\"order\",\"realtime\"]},"
+    "{\"id\":\"23bb9ffa\",\"sender\":\"user-260\",\"text\":\"latency latency lazy latency realtime alert latency fox lazy quick over price realtime update channel dog update brown the latency over dog latency dog\",\"ts\":14937916000148919,\"seq\":1087},"
+    "{\"id\":\"fe54ccbb\",\"sender\":\"user-24\",\"text\":\"order price over realtime channel\",\"ts\":14937916000149056,\"seq\":1088},"
+    "{\"id\":\"705416de\",\"sender\":\"user-345\",\"text\":\"brown fox pubnub jumps fox quick ok sensor update message realtime pubnub realtime temperature fox over\",\"ts\":14937916000149193,\"seq\":1089,\"tags\":[\"message\",\"order\",\"latency\"]},"
+    "{\"id\":\"e2371312\",\"sender\":\"user-85\",\"text\":\"reading stream dog jumps fox price stream message temperature pubnub alert sensor over order ok order alert reading\",\"ts\":14937916000149330,\"seq\":1090,\"geo\":{\"lat\":-37.107952,\"lng\":23.40537}},"
+    "{\"id\":\"43d3db60\",\"sender\":\"user-362\",\"text\":\"temperature quick sensor realtime realtime channel temperature price lazy lazy price alert the the stream update order\",\"ts\":14937916000149467,\"seq\":1091},"
+    "{\"id\":\"9ca7f7c0\",\"sender\":\"user-167\",\"text\":\"update order quick ok message latency \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000149604,\"seq\":1092,\"tags\":[\"stream\",\"channel\",\"dog\"]},"
+    "{\"id\":\"bd3569ed\",\"sender\":\"user-379\",\"text\":\"jumps pubnub alert sensor message temperature channel update price quick stream over\",\"ts\":14937916000149741,\"seq\":1093},"
+    "{\"id\":\"a2a8de90\",\"sender\":\"user-25\",\"text\":\"temperature brown realtime dog ok price ok channel quick jumps temperature order fox temperature humidity\",\"ts\":14937916000149878,\"seq\":1094},"
+    "{\"id\":\"4938288b\",\"sender\":\"user-106\",\"text\":\"realtime temperature reading update quick stream lazy the humidity\",\"ts\":14937916000150015,\"seq\":1095,\"tags\":[\"humidity\",\"channel\",\"brown\"],\"geo\":{\"lat\":-49.627677,\"lng\":86.293809}},"
+    "{\"id\":\"fb323953\",\"sender\":\"user-96\",\"text\":\"temperature quick update reading realtime brown jumps\",\"ts\":14937916000150152,\"seq\":1096},"
+    "{\"id\":\"f5e0fbec\",\"sender\":\"user-113\",\"text\":\"channel update jumps pubnub order alert stream the price price over the order stream humidity alert temperature\",\"ts\":14937916000150289,\"seq\":1097},"
+    "{\"id\":\"3e550823\",\"sender\":\"user-196\",\"text\":\"jumps stream temperature stream stream the pubnub stream humidity realtime\",\"ts\":14937916000150426,\"seq\":1098,\"tags\":[\"the\",\"realtime\",\"brown\"]},"
+    "{\"id\":\"d8e331a2\",\"sender\":\"user-199\",\"text\":\"pubnub latency sensor fox over over over fox update stream order order alert brown the humidity \\u00e9t\\u00e9 \\\\\\\"quoted\\\\\\\"\",\"ts\":14937916000150563,\"seq\":1099}"
+    "],14937916000000000,14937916000013563]";
+
+size_t const pbmb_history_page_len = sizeof pbmb_history_page - 1;
+unsigned const pbmb_history_page_count = 100;
+
+
+char const pbmb_presence_dump[] =
+    "{\"status\":200,\"message\":\"OK\",\"occupancy\":300,\"uuids\":["
+    "{\"uuid\":\"d74697e9-a331-4d60-a098-44e215ce166c\",\"state\":{\"status\":\"online\",\"typing\":true}},"
+    "{\"uuid\":\"5d5c31d7-a957-4836-a0c9-ba45fefd11af\"},"
+    "{\"uuid\":\"757753fe-ee83-4829-a6f6-c9bde4a54688\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"24ea52e7-56b6-463e-adf0-b83b5752a99d\"},"
+    "{\"uuid\":\"c540bc9a-ec45-47e7-aef7-e7ac2f15b188\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"7ce5eff5-fbff-4b43-a127-8e8df2e08abb\"},"
+    "{\"uuid\":\"8904f343-9c5c-4d7f-ab53-e33c28d03378\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"be412c5e-13b0-442b-ac99-2fcb64f4a167\"},"
+    "{\"uuid\":\"f3cc34e1-1a1f-45e0-aa62-019cc06f499e\",\"state\":{\"status\":\"online\",\"typing\":true}},"
+    "{\"uuid\":\"2f2029b6-7d20-4106-a58a-2638398b837d\"},"
+    "{\"uuid\":\"26779a73-4ddc-4d4c-a8b3-e17e08b703fe\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"6847cf0a-9da3-459d-af4d-cc302c3ce8ef\"},"
+    "{\"uuid\":\"5b18664f-473a-4ad9-a388-94e2b0a381aa\",\"state\":{\"status\":\"away\",\"typing\":true}},"
+    "{\"uuid\":\"44e64a0d-9703-4fe2-ac41-4d328db0651d\"},"
+    "{\"uuid\":\"8ac28db1-d4d9-48fd-aa1b-e8e4d4a16620\",\"state\":{\"status\":\"online\",\"typing\":true}},"
+    "{\"uuid\":\"76f6a268-c365-4249-a804-ba5af49ff780\"},"
+    "{\"uuid\":\"cd9a0d75-cbca-492f-ade7-04207ae4f657\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"dbb6e90f-8368-4cdd-abda-a21e5ed4e224\"},"
+    "{\"uuid\":\"b2e28de3-aa4a-4fc0-a919-3251b55119a6\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"574f7b0e-945e-4607-a7d6-65bc1936ed7f\"},"
+    "{\"uuid\":\"4dcd03e4-6c0e-4100-ab59-b699edfd42cd\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"9eb28127-dd18-44ac-a1ad-7036c920b993\"},"
+    "{\"uuid\":\"f3f72780-cd07-4f2d-a34f-d0df0e52a65b\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"a8f9d851-a4fb-4b58-ac75-66bca2f8b360\"},"
+    "{\"uuid\":\"30cd08fa-40f6-44ef-af63-bfe2e5545980\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"b21e62d5-f17d-4078-a356-99513a2a36fc\"},"
+    "{\"uuid\":\"84302216-a421-4aa7-a7bc-bf1f33f14615\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"141fa971-7fe3-48bb-ab7c-666f354ea6ed\"},"
+    "{\"uuid\":\"fbae59c3-8346-42a9-a615-e6d1fb37d61e\",\"state\":{\"status\":\"away\",\"typing\":true}},"
+    "{\"uuid\":\"e296e9c0-2b9e-42ad-afc5-8163f8c73046\"},"
+    "{\"uuid\":\"df15b844-cd5d-427a-a015-b3b26fbba699\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"e9361176-9de3-4210-ab14-8ba177286e22\"},"
+    "{\"uuid\":\"577a12b0-a1f6-42ac-a4af-1b71fd8ccfd1\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"b0a26417-70fb-4b2e-a404-d19a360cbf91\"},"
+    "{\"uuid\":\"07b47bc7-999a-4af4-af6b-125c7aaaac0d\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"8b65f978-de59-4ab2-a5a6-02253835c33b\"},"
+    "{\"uuid\":\"93251382-d2cb-465d-a87a-a9b2776ec2d7\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"8edf97b3-3a1e-498f-ad0e-d772f200ad4a\"},"
+    "{\"uuid\":\"c207e106-e0eb-4602-a0d6-d6af83f8de3d\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"c2b7445b-0608-418d-a294-447c28361a96\"},"
+    "{\"uuid\":\"f2340805-d5cc-4997-a1aa-68d1e6eeba08\",\"state\":{\"status\":\"online\",\"typing\":true}},"
+    "{\"uuid\":\"e6a0cb29-12cd-4571-a788-05c19b22fdf1\"},"
+    "{\"uuid\":\"f9351063-f113-4d42-a952-a0af3a3b29ba\",\"state\":{\"status\":\"online\",\"typing\":true}},"
+    "{\"uuid\":\"ed90aa42-7909-4b44-a979-0d6a23d5bb74\"},"
+    "{\"uuid\":\"1cba8bf4-264f-49e4-a5a4-395f5f8ae0c7\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"aed9b88e-cb0c-42aa-af8a-35a56a2cd491\"},"
+    "{\"uuid\":\"155182b2-8fd8-41c0-af5e-c0d38ff4fb09\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"fbd49271-edbf-4b79-a454-64cba1c06a4b\"},"
+    "{\"uuid\":\"98c37bea-7838-48c5-ada0-826d4cce323a\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"19b6c586-c7f3-49a1-af76-01f227d42c00\"},"
+    "{\"uuid\":\"b24ae357-7538-4aa5-a8aa-2336f5a32f6a\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"7aa643da-7ddf-4cdb-af8b-d942b65a41fe\"},"
+    "{\"uuid\":\"865eb141-d6df-4ed2-a079-93cedf87bf57\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"7a2f3430-d035-4e32-ab7b-486797fd3479\"},"
+    "{\"uuid\":\"b6cd6625-0d0b-424b-a2e4-6b8ea5dfa9d5\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"d98c0177-34d7-436e-acf9-3fe7f506b9da\"},"
+    "{\"uuid\":\"8197ea2d-6b28-4945-ab39-f70ee834b017\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"7f94ffd8-c17b-4092-a651-e38224eda583\"},"
+    "{\"uuid\":\"1c5d2a90-d480-433d-a8f6-f65379f4069a\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"3c8b733d-5817-414c-a45b-a405b467e706\"},"
+    "{\"uuid\":\"014b4719-3a28-4e09-ae3c-97fee4aca1f4\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"4e72d204-230c-4ce1-aee4-2646baa52f8e\"},"
+    "{\"uuid\":\"f67189e8-1b30-47f4-a77e-fdee197a0965\",\"state\":{\"status\":\"online\",\"typing\":true}},"
+    "{\"uuid\":\"8751cf7f-79cc-4cc4-a4c0-bb6152db2240\"},"
+    "{\"uuid\":\"2b9a0be4-fc38-4344-afa9-7bc8f1e3fa60\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"e940a19f-f91e-4483-abfc-c76d04dd7e11\"},"
+    "{\"uuid\":\"a9666ce9-d12d-4549-a2b1-1b1df8516ea0\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"d2ba03c7-f68d-4a68-ad7d-b682b3c2164a\"},"
+    "{\"uuid\":\"9135368f-d808-4a2f-a6bc-881881b1ef5f\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"44cf2d25-a705-4df8-ab6f-9a4b059580c0\"},"
+    "{\"uuid\":\"5b19cb8a-c02a-43cf-a000-0315ec9afe9a\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"8b6a9ca1-9683-4dba-ab6d-84c10a7ee152\"},"
+    "{\"uuid\":\"1f0fb9e7-dd75-412c-a6a7-27fc01d3f99d\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"27a97ebf-0d37-4eef-a303-bc7cfc65f7cb\"},"
+    "{\"uuid\":\"2139e532-fd22-417b-ac1d-c1a2c0f29489\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"e3c843f9-cf12-4a7e-aaf0-d33c103daa42\"},"
+    "{\"uuid\":\"09337a9d-ffb9-4659-a733-111bda0e9cf7\",\"state\":{\"status\":\"away\",\"typing\":true}},"
+    "{\"uuid\":\"ef6f06ab-dce9-47c0-a437-89e0b486abec\"},"
+    "{\"uuid\":\"580fd155-48f9-470a-a537-7a479f24f718\",\"state\":{\"status\":\"online\",\"typing\":true}},"
+    "{\"uuid\":\"0fc6337f-2260-4bde-aab4-a8949048bdcd\"},"
+    "{\"uuid\":\"32eaa3f6-b382-4f14-a7bf-01b99d62b6f5\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"e155d5f0-c161-491d-aaa2-ccaa5a56a6e0\"},"
+    "{\"uuid\":\"fe5d8311-b19d-430b-a43d-bb426c9e7fad\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"03ce3d92-ea8b-48d9-a985-3be2b000a913\"},"
+    "{\"uuid\":\"fd7b2a93-4988-454e-a245-1495d9ccca46\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"d3d9b95e-25db-49c5-a52b-15bac9a24f3c\"},"
+    "{\"uuid\":\"2b250692-efe7-471c-a27e-67778c9e46f9\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"37857db4-0a0e-4ee7-a1c2-dae888ebe041\"},"
+    "{\"uuid\":\"7c3853fb-71e1-4983-ac1c-3295d2542212\",\"state\":{\"status\":\"away\",\"typing\":true}},"
+    "{\"uuid\":\"c0df0aa9-5f1f-43e5-a1ec-9310f929a2a8\"},"
+    "{\"uuid\":\"7b80eefb-4fd2-4e3a-abff-5632749b49d7\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"b882e175-e6a1-4afe-af75-1321f5ab7ac9\"},"
+    "{\"uuid\":\"854d1175-6808-4061-adb4-2f63a94316e0\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"c9778505-cc17-41fe-a71d-b2032fffc9ad\"},"
+    "{\"uuid\":\"d973af19-3f92-4043-a486-218c065fc535\",\"state\":{\"status\":\"online\",\"typing\":true}},"
+    "{\"uuid\":\"be159db8-8623-4a3d-a67b-d22ddde27172\"},"
+    "{\"uuid\":\"ec2f0fca-c87a-4677-ac82-116ef2e24445\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"0fd0921b-0c97-4d18-a341-ed7ddb5795ce\"},"
+    "{\"uuid\":\"a95e4825-6fc1-41a9-a1c3-bbe78b30ba52\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"ce7f645b-f61e-4d76-a112-97db7c0aa05d\"},"
+    "{\"uuid\":\"b9dccfb7-7610-4e89-a981-bccefb432f34\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"d3fb5982-d72a-4e0e-ada0-f1d1dbe9fa0d\"},"
+    "{\"uuid\":\"9bd597d6-d6c9-4c0f-a907-8487b3a4cb7e\",\"state\":{\"status\":\"away\",\"typing\":true}},"
+    "{\"uuid\":\"5dacfaf4-b02e-4696-a02b-30dd95945810\"},"
+    "{\"uuid\":\"1488e49a-36b2-4c9e-ad18-21ea67d2dacd\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"327a6b70-8106-4e93-a38d-7b9724733c10\"},"
+    "{\"uuid\":\"d0906167-b063-49cd-a99b-dd43b8d285d7\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"50bb6254-7744-408c-ad0e-7ae5dfd76c1e\"},"
+    "{\"uuid\":\"2100a683-0250-497f-a8b3-84d894c26e1d\",\"state\":{\"status\":\"online\",\"typing\":true}},"
+    "{\"uuid\":\"6d4e31c3-9f53-48a5-ac9a-eb1764bfc92f\"},"
+    "{\"uuid\":\"e2fd8c63-2490-4c32-ab4d-04423559045a\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"4c7c0011-c1c1-49ad-a84f-da97372ac153\"},"
+    "{\"uuid\":\"9cf4fc11-2a96-406e-a144-00c4336e463a\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"8d23a79f-5a45-4574-ab1e-da4a0cc92967\"},"
+    "{\"uuid\":\"a15270bb-09a6-4a35-a372-3f37c355de05\",\"state\":{\"status\":\"online\",\"typing\":true}},"
+    "{\"uuid\":\"d621a86c-3ebb-4c6c-a2e9-c4696b7fd74c\"},"
+    "{\"uuid\":\"aa588eb5-11fe-41d1-a72a-c189a33f16d4\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"17ecf779-c67e-4e65-a50f-25915c0e7556\"},"
+    "{\"uuid\":\"106ecb61-4fb6-4414-a61d-9dcdd14ff0c8\",\"state\":{\"status\":\"online\",\"typing\":true}},"
+    "{\"uuid\":\"87be336b-8bb5-4f39-a192-ecbaa4d3f70e\"},"
+    "{\"uuid\":\"87eec8e9-0c8c-4704-a4f2-dbb9b3aeb6ba\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"35780bbc-bcb1-46c6-a954-6ea07b5a6db9\"},"
+    "{\"uuid\":\"bb4ce189-505c-4e82-a76c-dd3ebee8d419\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"c9ad7ad5-3779-4a03-aeb8-505ded3b730b\"},"
+    "{\"uuid\":\"14749479-5318-465f-a8e5-108446185356\",\"state\":{\"status\":\"online\",\"typing\":true}},"
+    "{\"uuid\":\"c8ae12e2-677d-47fa-a368-76eb5dc6dfad\"},"
+    "{\"uuid\":\"34d113f0-f5e3-4dbf-aec6-4c33cb5b7e4d\",\"state\":{\"status\":\"online\",\"typing\":true}},"
+    "{\"uuid\":\"4297511c-c6ba-4fe8-a851-77bd3a4f65c2\"},"
+    "{\"uuid\":\"89e16abd-b081-4cf7-a512-dfd312f5dd50\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"bfef481e-6929-411b-a652-99f7ab874611\"},"
+    "{\"uuid\":\"2fb4958e-e656-41ac-a483-3e92823a9893\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"15f43d00-6217-43d9-aba6-155c6ccb8c6f\"},"
+    "{\"uuid\":\"894f6926-7b55-473f-a1b3-8f7a6a1679a3\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"6b642484-cd1a-4d4e-aa48-79cb51899101\"},"
+    "{\"uuid\":\"eacd83ab-c98f-4cc8-a5a5-e26ca7ec5b17\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"d33c6f79-3718-49b1-a0fb-92bd8f791895\"},"
+    "{\"uuid\":\"ad203b43-b374-4a7d-ad96-115fed2b027b\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"623dd067-9427-4f73-ab92-721fc76a741f\"},"
+    "{\"uuid\":\"d61deff1-9c0c-4ddd-a628-bab5e2a70004\",\"state\":{\"status\":\"away\",\"typing\":true}},"
+    "{\"uuid\":\"df41c2d4-1a34-4c4a-a8cd-2121e7da88de\"},"
+    "{\"uuid\":\"4a021bcc-1540-475a-ad04-4342a91d711b\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"69975813-0722-4928-a753-7e7b4ca5290c\"},"
+    "{\"uuid\":\"eb5dcc68-e9da-44a5-aa81-24910e01304d\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"92d31a43-bd5a-408f-aba1-d6b935baab25\"},"
+    "{\"uuid\":\"b5f3f801-16b4-4b19-a0aa-431aa7515ee4\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"d39f2c62-12a3-46dc-ac09-3a3df5752819\"},"
+    "{\"uuid\":\"5cda44c6-42fa-46c5-a624-af6b418bbbed\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"318227a1-e620-45f2-ac6b-f7bd7d4e9609\"},"
+    "{\"uuid\":\"33166cb4-391b-4b4f-a541-7c351442646a\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"26f8803c-4e0d-47e5-a3c5-017c81bf1046\"},"
+    "{\"uuid\":\"10568bdf-2011-434b-a7ff-668dc861ae0f\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"d8fa5232-830a-4f2d-a461-db240c08b54f\"},"
+    "{\"uuid\":\"fb3f76ea-b3f8-47ab-adf7-f70b06f30e79\",\"state\":{\"status\":\"away\",\"typing\":true}},"
+    "{\"uuid\":\"1475531b-ad50-458e-a4fe-b2f5751ee8f3\"},"
+    "{\"uuid\":\"96e2b6af-0df8-451d-ab10-d95b905b9732\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"b37f78d4-5b81-4a4a-ad78-b31d595758c8\"},"
+    "{\"uuid\":\"e85135d5-542f-4aef-aefc-cc17fc4d51d6\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"e7e1fada-3b60-4080-a61f-68c2b6a66492\"},"
+    "{\"uuid\":\"8abd4f7a-3f2c-488b-a7d5-cd88292bd9e4\",\"state\":{\"status\":\"online\",\"typing\":true}},"
+    "{\"uuid\":\"12418bda-38e5-41a3-ad51-a4fc5ce88890\"},"
+    "{\"uuid\":\"01d25eac-63db-4e33-a757-6739b66fe07a\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"ef4cf724-3856-4c0f-a7c1-6793ba609ae3\"},"
+    "{\"uuid\":\"fbfb588c-4935-49ea-a734-7e8d540b232f\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"8b5b4455-bac6-4777-ad78-15fefcb511b7\"},"
+    "{\"uuid\":\"5a4a543e-eaa3-4625-ac94-2781f5f1b5a9\",\"state\":{\"status\":\"away\",\"typing\":true}},"
+    "{\"uuid\":\"59bc8b4a-ab00-43e7-aa2f-b8ffe34b8a80\"},"
+    "{\"uuid\":\"2c5c9923-f5b6-48ad-a562-9af2352cd37f\",\"state\":{\"status\":\"away\",\"typing\":true}},"
+    "{\"uuid\":\"94821c14-76d5-41e0-a0d8-92654443b969\"},"
+    "{\"uuid\":\"24ca9377-b326-4ebb-a9bc-ace267ae0453\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"4b8cce9b-d6b3-4039-a9d9-04bbe6fe97b0\"},"
+    "{\"uuid\":\"40afb056-b632-4677-a07e-04e1ff4ebfd1\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"057eabd3-eef2-45d0-adf3-67bdfa657e3e\"},"
+    "{\"uuid\":\"c474a4c3-5500-4b1e-a0ac-410a59935cf2\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"50490658-8325-4afe-a866-14c8df9d2b68\"},"
+    "{\"uuid\":\"458194f6-c964-4e93-a4be-4e9e453a134d\",\"state\":{\"status\":\"online\",\"typing\":true}},"
+    "{\"uuid\":\"50e3b94a-f910-46b3-a4b0-1281b60f0647\"},"
+    "{\"uuid\":\"92f45ef4-6f7d-4e81-a6a4-7dfe396f25f0\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"6428b457-af22-4ebc-a9ad-b53a14e4bdea\"},"
+    "{\"uuid\":\"8c5ca763-bf42-4111-ae84-0b23a2af1050\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"cf25a404-e25d-4a5a-ad88-794c1e239e03\"},"
+    "{\"uuid\":\"e717ba62-9519-4e43-a5e5-468cfdbb0f6f\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"7e6d0612-8e2d-4606-a923-aea9f00253fa\"},"
+    "{\"uuid\":\"3bfb15bb-a657-4312-a4d1-8175b6f72a8a\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"1234e8b4-2edc-4c80-acb7-c67e4c5c01ad\"},"
+    "{\"uuid\":\"755e821f-b2ed-4d27-a8c7-418e87c9bdb2\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"8268b724-1ea2-411b-a6a7-b5b9d8983b5d\"},"
+    "{\"uuid\":\"24cee13c-0fdc-43e5-aa10-3f650028eaa5\",\"state\":{\"status\":\"away\",\"typing\":true}},"
+    "{\"uuid\":\"7b001f71-179f-4bec-acf8-eb255de3f0a8\"},"
+    "{\"uuid\":\"3934fa64-db5d-49eb-adc2-264222edfbb1\",\"state\":{\"status\":\"away\",\"typing\":true}},"
+    "{\"uuid\":\"36f687ff-1cbe-4179-a220-e8e99174a761\"},"
+    "{\"uuid\":\"dddbaf4b-40e5-4e5e-a0d9-c3ac7c8ea35c\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"af956f70-9bfc-442b-a10b-54495a3c9b15\"},"
+    "{\"uuid\":\"ac16c2ac-110e-4697-a377-07b98880fb31\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"7c43f369-df9f-43c2-a584-f29451bc35fd\"},"
+    "{\"uuid\":\"b5a753e6-6711-44bc-adcc-7eb546c81cfb\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"9b97e425-0b8a-4fba-ad0c-54e03e6224f1\"},"
+    "{\"uuid\":\"d34eeb0b-a157-46bc-a790-2b05e3bc748f\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"57da1b98-e39a-4d3a-adfc-627cbd9dfb78\"},"
+    "{\"uuid\":\"72802c56-ec5c-4f4e-a7bd-b4391d066400\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"43119c20-77c2-44c3-ac85-887633a8a70e\"},"
+    "{\"uuid\":\"7739e3eb-6af0-4acd-a444-735dd0977c22\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"79e91b84-20fe-48b1-a18f-da8da4a2e0cf\"},"
+    "{\"uuid\":\"c4f6bc35-d176-4ef6-a470-b921ef290cd2\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"84d249dd-6fe7-405b-a308-4212a1f36518\"},"
+    "{\"uuid\":\"5ab42033-f2cb-4ebe-aba5-9ca4eb13be38\",\"state\":{\"status\":\"away\",\"typing\":true}},"
+    "{\"uuid\":\"e294a454-5269-4fd1-a80f-52f3aac2e95c\"},"
+    "{\"uuid\":\"88fc34a7-4f6e-452d-aaae-e9275fb14834\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"db4e77c9-2fbb-4248-a5b3-fdb9eec4eea5\"},"
+    "{\"uuid\":\"a26890dc-72e1-493f-a724-855b8fb85d5a\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"3a601cc1-7c9d-4a9b-afbb-8f82ba6197d3\"},"
+    "{\"uuid\":\"f2de8c4d-f9f5-4163-a836-b2ee059f4d52\",\"state\":{\"status\":\"online\",\"typing\":true}},"
+    "{\"uuid\":\"4b7f66db-5982-40cb-a68c-43fd949fb1f5\"},"
+    "{\"uuid\":\"9a2fd717-0681-49cb-ae00-6c85824d331a\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"6b0729fb-e45f-4056-a2f8-1764b5508272\"},"
+    "{\"uuid\":\"08361478-4da8-4f4d-a0e2-a9d089a6b5fb\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"28688803-8f91-4105-ad1d-d1e9bc858a37\"},"
+    "{\"uuid\":\"a4429429-cf99-4146-a60a-db235ff1862b\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"b0b3e667-6f22-44b9-af62-088b3796f4e9\"},"
+    "{\"uuid\":\"8aafa595-0402-478c-af93-b88455ca6a53\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"08af7dc9-a638-448c-a368-49ebd3e7e24d\"},"
+    "{\"uuid\":\"3867fdd9-7c51-4bf4-a580-6736b0b9fd78\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"3f68be46-38aa-4dbb-a8ec-166f7c18a8a0\"},"
+    "{\"uuid\":\"6f04420f-8b60-4adf-ae19-4ce325742bd2\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"6c6aada0-8a1d-416f-ab0f-eaa0ec6ad892\"},"
+    "{\"uuid\":\"d243e9cf-f723-49fb-a762-85f6bcf5e972\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"93cbe1d7-f54c-46b9-afca-152276d1a903\"},"
+    "{\"uuid\":\"28f64f05-3002-493b-abdd-a9dc18be8f31\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"4ccd438e-efaf-4dd2-ac09-94d103d69746\"},"
+    "{\"uuid\":\"71089dd3-bca3-4450-acb7-c1386a2784ff\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"bdb4f073-068c-4f0d-a0a2-ace1d3f5940e\"},"
+    "{\"uuid\":\"1443f4d7-c6c0-4cd4-ae5d-de2b2a4fc8fc\",\"state\":{\"status\":\"away\",\"typing\":true}},"
+    "{\"uuid\":\"ae558c6c-4947-40e1-a330-cf3376e08e87\"},"
+    "{\"uuid\":\"36f9f7c3-17a0-44d8-a15d-c7ac3eb6f5e3\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"c92f5290-f080-4af0-a871-10417d04481a\"},"
+    "{\"uuid\":\"94859283-5bad-4305-aec4-1b16b57f5f3b\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"ed621dfb-5d5c-4e97-aa74-d6e8fbc383cd\"},"
+    "{\"uuid\":\"26f9bc1f-a600-400e-a53e-8f8ffa220231\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"5b0a8f10-e423-4ad8-a60b-5bfa28957e32\"},"
+    "{\"uuid\":\"045decaf-1e54-47f3-adb0-65a414b778d3\",\"state\":{\"status\":\"away\",\"typing\":true}},"
+    "{\"uuid\":\"a90e37f1-caa4-4917-a394-aea7d820d210\"},"
+    "{\"uuid\":\"38ad20eb-7738-45e6-a0cf-7d09534629fc\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"9731c149-d770-4458-a318-0c1c19869f2c\"},"
+    "{\"uuid\":\"3f131f78-e2fb-4743-a8d1-4cd346dacc6d\",\"state\":{\"status\":\"online\",\"typing\":true}},"
+    "{\"uuid\":\"5710d189-894c-4075-a7af-9da2bd3e9ca2\"},"
+    "{\"uuid\":\"20ac049e-cee3-465c-a930-fa1216dac083\",\"state\":{\"status\":\"away\",\"typing\":true}},"
+    "{\"uuid\":\"63b529d4-b4c1-4566-a339-4406db70fe3e\"},"
+    "{\"uuid\":\"b03ad779-1813-4030-ac78-5cd0b02b7f95\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"c5872492-2fbd-423a-a8e1-e78cab38ee4e\"},"
+    "{\"uuid\":\"05441a30-e014-4866-a78f-02660f7e6cf6\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"977e5778-24eb-47d2-a811-ca7fad3eac39\"},"
+    "{\"uuid\":\"2e700e9b-6bf4-41a8-a4d0-b89250aa4ba3\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"65668bb1-e708-4ebf-abc6-6f3e943bbd5d\"},"
+    "{\"uuid\":\"12e0422e-03a7-4617-a5b0-fac3530022ca\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"1507be86-8b5f-4ad6-a450-614e2986af1a\"},"
+    "{\"uuid\":\"b76facda-2977-4aa0-a8d1-1964775d5364\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"2a087865-7f93-4d26-a009-c2f5c4d74388\"},"
+    "{\"uuid\":\"9da3b6f0-152a-40d6-afa7-483a0f2eca2b\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"69cf1306-0aeb-4ded-a4b3-ad299bce363c\"},"
+    "{\"uuid\":\"f9e8f16b-4d13-447d-aeb0-8f9e783ecd97\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"fdd40b28-486e-4d90-ae58-8dac0bb2d7ec\"},"
+    "{\"uuid\":\"151fa835-c720-4fb9-add3-95683598dc14\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"e6f86494-6e49-4036-a9e0-dadf1e7fbef1\"},"
+    "{\"uuid\":\"2ad43acc-4ade-428c-a789-aa52dcc6d987\",\"state\":{\"status\":\"away\",\"typing\":true}},"
+    "{\"uuid\":\"6e06cd06-5193-4cda-a6aa-1901cb0e92c1\"},"
+    "{\"uuid\":\"b4ad25ed-2fad-486a-a074-f2bfd7a0aef0\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"210e309e-9852-4482-a8ef-efa8abffcd9e\"},"
+    "{\"uuid\":\"bd146a3c-b8d7-462b-abf5-4d58b92f0d56\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"05c44683-2312-4714-a755-fb93a35663d5\"},"
+    "{\"uuid\":\"ac774f21-d727-4fb5-a5d1-c6b79379a750\",\"state\":{\"status\":\"online\",\"typing\":true}},"
+    "{\"uuid\":\"fc748122-cc91-4d6b-a7b2-b501964fea4f\"},"
+    "{\"uuid\":\"32d2827c-dba6-4ceb-a4b3-77e15e4eaa64\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"4210b391-edc1-4a53-a580-e162d8017ac9\"},"
+    "{\"uuid\":\"f1d7b47a-e3f7-4a41-a0ed-f2de1bb9a17b\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"c1492dc6-38dc-41c2-a86f-a0e55e1487c4\"},"
+    "{\"uuid\":\"4dc9e4d6-aeb5-4a25-ac9e-3c3292d44f28\",\"state\":{\"status\":\"busy\",\"typing\":false}},"
+    "{\"uuid\":\"8a371f72-6073-4288-a342-de1ccc2ad6e4\"},"
+    "{\"uuid\":\"2333ff8b-5b16-4d01-ab1a-d6bc30badbd0\",\"state\":{\"status\":\"away\",\"typing\":true}},"
+    "{\"uuid\":\"654c06d9-ff98-4015-a847-9c4aebaceecb\"},"
+    "{\"uuid\":\"1c1bd1ee-6ae4-498d-a658-ea7bd216af0e\",\"state\":{\"status\":\"online\",\"typing\":true}},"
+    "{\"uuid\":\"60b4290b-05a8-443a-aa69-e3b881bf4ffd\"},"
+    "{\"uuid\":\"2483fa03-6a40-4957-ae69-37dbbb00eab4\",\"state\":{\"status\":\"away\",\"typing\":true}},"
+    "{\"uuid\":\"37c66c74-7358-45a7-a8da-10aec8c331d9\"},"
+    "{\"uuid\":\"b7dfffab-080a-422c-a166-0aa8a3e894eb\",\"state\":{\"status\":\"online\",\"typing\":true}},"
+    "{\"uuid\":\"9d000ef2-073f-4908-a39d-7d506dd11031\"},"
+    "{\"uuid\":\"d90cf2be-dc47-4933-a96c-71dd86cd211c\",\"state\":{\"status\":\"online\",\"typing\":true}},"
+    "{\"uuid\":\"b3ff8fe9-a82f-4fe7-a163-ffe2415b0367\"},"
+    "{\"uuid\":\"39d50d16-15e2-47ba-a642-70685f2758b2\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"43e10f57-a3a0-4ce5-acc9-82048ebfb517\"},"
+    "{\"uuid\":\"fad7528b-c274-4150-a517-85cefeb0e142\",\"state\":{\"status\":\"busy\",\"typing\":true}},"
+    "{\"uuid\":\"66ad871a-eceb-4342-a463-971b4ca80128\"},"
+    "{\"uuid\":\"3ed70a9f-ea30-45ee-a517-25fde7e77f8b\",\"state\":{\"status\":\"away\",\"typing\":false}},"
+    "{\"uuid\":\"c8ca4f13-7e58-4c32-ab67-206eba2f833d\"},"
+    "{\"uuid\":\"f60d8bc2-a120-436a-a54a-62cbb083a61d\",\"state\":{\"status\":\"away\",\"typing\":true}},"
+    "{\"uuid\":\"7a17479d-60cd-44ab-a91b-cf7085dcb4bd\"},"
+    "{\"uuid\":\"9b110f35-d91c-4cf0-a8a4-0456d8e37421\",\"state\":{\"status\":\"away\",\"typing\":true}},"
+    "{\"uuid\":\"a25e06db-504a-4fc1-a6fd-43bdce75f041\"},"
+    "{\"uuid\":\"41717447-9513-4c94-a6bd-5a3aaa60089e\",\"state\":{\"status\":\"away\",\"typing\":true}},"
+    "{\"uuid\":\"41939b89-da78-444b-a945-7dfc6efc2e9a\"},"
+    "{\"uuid\":\"e78da4cb-bbe6-4314-af07-89582952a0e1\",\"state\":{\"status\":\"online\",\"typing\":false}},"
+    "{\"uuid\":\"9f56eb96-d36a-439f-af51-21c7731c06b1\"}"
+    "],\"service\":\"Presence\"}";
+
+size_t const pbmb_presence_dump_len = sizeof pbmb_presence_dump - 1;
+unsigned const pbmb_presence_dump_count = 300;
+
+
+/* The history page above, as it was sent with
+   "Content-Encoding: gzip". */
+unsigned char const pbmb_history_page_gzip[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x5c,
+    0xe9, 0x92, 0x1b, 0x37, 0x0e, 0x7e, 0x95, 0xa9, 0xf9, 0x9d, 0x74, 0xf1,
+    0x3e, 0xfc, 0x2a, 0x49, 0x7e, 0xf4, 0x69, 0x7b, 0x7d, 0x8c, 0x33, 0x9e,
+    0xf1, 0x26, 0xd9, 0xca, 0xbb, 0x2f, 0xbb, 0x79, 0x00, 0x20, 0x21, 0xb9,
+    0x66, 0x2b, 0x3b, 0x92, 0xa5, 0x96, 0x1a, 0x20, 0x71, 0x7c, 0xf8, 0x00,
+    0xea, 0xb7, 0xdf, 0xfe, 0xf7, 0xf8, 0x71, 0x7b, 0x7c, 0xf7, 0xb8, 0x5b,
+    0xbd, 0x2c, 0x76, 0x5e, 0x1f, 0x7f, 0x79, 0xfc, 0xbe, 0x7f, 0xdd, 0xf6,
+    0xe7, 0xf4, 0xda, 0xeb, 0xf7, 0xfd, 0xf9, 0x57, 0x2d, 0xd3, 0x4b, 0x2f,
+    0xfb, 0x5f, 0x2f, 0xe9, 0x85, 0xe7, 0x7d, 0xfe, 0xfc, 0xf2, 0xf1, 0xcb,
+    0xfe, 0xf0, 0xe1, 0xf5, 0xcb, 0xc7, 0xed, 0xe3, 0xcb, 0xdf, 0x0f, 0xdf,
+    0x9e, 0x3f, 0xae, 0xfb, 0x43, 0x7b, 0x7d, 0xfd, 0x30, 0x7f, 0xfd, 0xba,
+    0x7f, 0x86, 0xf7, 0x5f, 0x3e, 0xec, 0xe5, 0x9a, 0x2f, 0xfb, 0xf7, 0xef,
+    0xf3, 0xfb, 0xfd, 0x21, 0x7d, 0xfb, 0xf7, 0xa7, 0xe7, 0x87, 0xcf, 0xf3,
+    0xcb, 0xfe, 0x75, 0x4d, 0x17, 0xec, 0x5f, 0xbe, 0xed, 0xcf, 0xf3, 0xcb,
+    0xeb, 0x33, 0xfa, 0x9a, 0xa7, 0xe7, 0x24, 0xc0, 0xc3, 0xd3, 0xa7, 0x87,
+    0xd7, 0x6f, 0x5b, 0xba, 0x2e, 0x5d, 0xfc, 0xcf, 0xdf, 0xa7, 0x14, 0xdf,
+    0x1f, 0xdf, 0x49, 0x13, 0xb5, 0x8f, 0xd2, 0x09, 0x21, 0xa4, 0xf6, 0xe9,
+    0xef, 0x29, 0xef, 0x9f, 0xe9, 0xf5, 0xeb, 0xe9, 0xfb, 0xfd, 0xe9, 0xf1,
+    0xdd, 0xff, 0x1e, 0xd3, 0x97, 0x3f, 0xbe, 0xf3, 0x62, 0x72, 0x52, 0xda,
+    0xe8, 0x7e, 0x79, 0xfc, 0xfc, 0xf5, 0xfd, 0xe3, 0xbb, 0x5f, 0xa5, 0x96,
+    0x93, 0x70, 0xc1, 0x7b, 0xf9, 0xef, 0xbf, 0xbf, 0x14, 0xb5, 0x37, 0xe1,
+    0xd7, 0xe0, 0x77, 0x39, 0xa8, 0x6d, 0x74, 0x00, 0xbd, 0xab, 0xec, 0xf3,
+    0xe7, 0xfd, 0xf9, 0xe5, 0xe1, 0xdb, 0xeb, 0xf2, 0xf5, 0x75, 0xa9, 0x42,
+    0x5e, 0x7f, 0xff, 0xf3, 0xfa, 0xe5, 0xdb, 0xf7, 0xf2, 0xbc, 0xc8, 0x5c,
+    0xf4, 0xfc, 0xfd, 0x55, 0x88, 0x3d, 0xbe, 0xe4, 0x87, 0x87, 0xdf, 0x7f,
+    0xff, 0xfd, 0xf1, 0xcf, 0xd7, 0xa7, 0x97, 0x7d, 0x3b, 0x9f, 0xb1, 0x2a,
+    0xa5, 0xff, 0x40, 0x25, 0xd9, 0x04, 0x35, 0xde, 0xbb, 0x4d, 0xaf, 0xc7,
+    0x20, 0xa8, 0x0c, 0x16, 0x04, 0xfd, 0xfe, 0x92, 0xd6, 0xf0, 0xcb, 0xb9,
+    0x72, 0xcb, 0xf3, 0xd3, 0x7f, 0xbf, 0x3e, 0x1c, 0x4f, 0x7f, 0x55, 0x79,
+    0x8a, 0xd4, 0xf9, 0x81, 0xbd, 0xb3, 0xf2, 0x06, 0xee, 0xac, 0xd2, 0x15,
+    0xf3, 0xfb, 0x74, 0xcd, 0x6f, 0x8f, 0xdb, 0xd3, 0xfb, 0x74, 0xfd, 0xa5,
+    0x7b, 0x7a, 0x2c, 0x6b, 0xf1, 0xf8, 0x47, 0x13, 0x4d, 0xcf, 0x6e, 0x33,
+    0xc2, 0xa8, 0x71, 0x0d, 0xa5, 0x03, 0xd1, 0x8a, 0x18, 0x97, 0x41, 0x64,
+    0x51, 0x4e, 0xe1, 0x9e, 0x7e, 0xa4, 0x15, 0xab, 0xcb, 0xfb, 0xe7, 0xeb,
+    0xc7, 0xf5, 0x13, 0xb2, 0x82, 0x1f, 0xd9, 0x08, 0xaa, 0xa9, 0xe4, 0xb7,
+    0xeb, 0xea, 0x7f, 0x2a, 0xbb, 0x51, 0x4d, 0x2e, 0x2f, 0x7e, 0x67, 0x4e,
+    0xdb, 0xc7, 0xaf, 0xef, 0xeb, 0x4e, 0xd4, 0xbb, 0x14, 0x41, 0xea, 0x3f,
+    0xef, 0x2c, 0x88, 0x91, 0x12, 0x16, 0x44, 0x37, 0x7d, 0x95, 0xd1, 0x66,
+    0xd9, 0xb4, 0x1f, 0xb7, 0xc2, 0x68, 0xd0, 0x37, 0xad, 0xda, 0xa5, 0x61,
+    0xb6, 0xfe, 0x2c, 0x7b, 0xb9, 0x75, 0x93, 0xbd, 0x48, 0x96, 0xff, 0x91,
+    0x15, 0x28, 0x3b, 0x98, 0x3f, 0x95, 0xff, 0x62, 0x9d, 0x6e, 0x3d, 0x3f,
+    0x3d, 0x04, 0x56, 0x2e, 0x9b, 0x63, 0xdd, 0x29, 0x4e, 0x35, 0x6b, 0x02,
+    0xa8, 0x66, 0x40, 0x35, 0xb7, 0x6c, 0x4e, 0x09, 0x3d, 0xa8, 0xa6, 0xbc,
+    0x02, 0xd5, 0xb2, 0x32, 0x74, 0xe1, 0x9b, 0xc7, 0xe7, 0x7b, 0xe7, 0x4b,
+    0x8a, 0x4a, 0x59, 0xcb, 0x73, 0x31, 0xf2, 0x9b, 0x97, 0xb0, 0xc5, 0x65,
+    0xce, 0x3d, 0x2e, 0xfa, 0xff, 0xe8, 0xf6, 0x2f, 0xdb, 0xdd, 0x28, 0xbb,
+    0x0b, 0x16, 0x64, 0xb7, 0x60, 0xa7, 0xe9, 0x06, 0xe9, 0xfa, 0xbc, 0xc6,
+    0xe9, 0xc9, 0xf9, 0xf1, 0x3f, 0x68, 0x48, 0x30, 0x62, 0x0a, 0xce, 0xdb,
+    0xa0, 0x4a, 0x48, 0x90, 0xde, 0x4e, 0x26, 0x58, 0x25, 0x2c, 0x44, 0x04,
+    0x2f, 0xf7, 0xd5, 0x79, 0x19, 0xc6, 0x40, 0x68, 0x90, 0xa3, 0x9d, 0xca,
+    0x34, 0x95, 0xb3, 0xaf, 0x9d, 0x1b, 0x8e, 0xc5, 0xcf, 0x4b, 0x50, 0xf6,
+    0xb3, 0xac, 0x01, 0xfd, 0x57, 0xb2, 0x83, 0xfa, 0x1d, 0xac, 0xa2, 0x41,
+    0x29, 0x50, 0xd4, 0x35, 0x09, 0xe5, 0xbc, 0x6e, 0x76, 0xb5, 0xe3, 0x26,
+    0x49, 0x0f, 0x02, 0xe6, 0x35, 0xad, 0x46, 0x8e, 0xe5, 0x2a, 0x32, 0x5c,
+    0x9b, 0x90, 0x25, 0x2f, 0x66, 0x09, 0x8e, 0x07, 0x9b, 0x7b, 0x2a, 0x55,
+    0xfd, 0xaf, 0x3e, 0x56, 0xbf, 0x3a, 0xd7, 0x20, 0x7f, 0x19, 0x2b, 0x7d,
+    0xb4, 0x11, 0xa4, 0xf7, 0x4d, 0xfa, 0x65, 0x59, 0xc2, 0x6e, 0xcc, 0x36,
+    0xae, 0x6f, 0x44, 0xe2, 0x9f, 0x61, 0xa2, 0xde, 0x67, 0xb0, 0x73, 0x64,
+    0x45, 0xa7, 0x0c, 0xc4, 0x27, 0x3e, 0x40, 0x12, 0x3a, 0x9f, 0x17, 0x65,
+    0x69, 0x0c, 0x7c, 0x6b, 0x4c, 0x0e, 0xe2, 0x4c, 0x22, 0x55, 0x95, 0x00,
+    0x16, 0x87, 0xee, 0x9c, 0x3e, 0x57, 0xd7, 0x2f, 0x3d, 0xbd, 0x1c, 0x17,
+    0x85, 0x48, 0xe5, 0xed, 0xae, 0xb7, 0xc3, 0x0c, 0x4a, 0x5b, 0x4d, 0xb2,
+    0xeb, 0xa5, 0xef, 0xa5, 0x58, 0x76, 0x9d, 0x1c, 0x00, 0xaa, 0x42, 0xf5,
+    0x82, 0x1a, 0x5a, 0xda, 0x86, 0x11, 0x6b, 0xe4, 0x96, 0xad, 0x25, 0xdd,
+    0xf3, 0x9b, 0x71, 0xc8, 0x3d, 0xbf, 0xaa, 0x7e, 0x3d, 0xb9, 0x19, 0xbb,
+    0x0e, 0x4a, 0x6b, 0x58, 0x87, 0x08, 0x2e, 0xa3, 0xb7, 0x35, 0x2a, 0xcf,
+    0x60, 0x87, 0xa8, 0x7b, 0x8b, 0xac, 0xe1, 0xfb, 0x47, 0xcb, 0x9d, 0x58,
+    0x4e, 0x12, 0x03, 0x7b, 0xb5, 0xf3, 0xb6, 0xb7, 0xdd, 0x45, 0x1f, 0x2b,
+    0xdb, 0x9b, 0xef, 0xf0, 0xd3, 0xe0, 0x17, 0x12, 0x6e, 0x68, 0x6a, 0xc8,
+    0x0e, 0x35, 0x38, 0x3f, 0x59, 0x21, 0x83, 0xaa, 0xa8, 0x41, 0xaa, 0x30,
+    0x19, 0xa1, 0x4d, 0x74, 0x10, 0x22, 0x44, 0x10, 0x7e, 0xdf, 0xcc, 0xca,
+    0xe4, 0x62, 0x01, 0xfa, 0xb6, 0x0d, 0x79, 0xfa, 0xc4, 0xee, 0x49, 0x59,
+    0x89, 0xea, 0x55, 0x24, 0x17, 0xe4, 0xd8, 0x71, 0x39, 0x58, 0x7e, 0x19,
+    0x01, 0x21, 0x14, 0x6e, 0xca, 0x42, 0x11, 0x2f, 0x4e, 0x77, 0x2b, 0x9f,
+    0xc1, 0x02, 0xe4, 0xd8, 0x38, 0x2e, 0x85, 0x15, 0x80, 0x36, 0xce, 0x6c,
+    0x57, 0x2d, 0xfb, 0x5a, 0xc4, 0xf4, 0x89, 0x6b, 0x43, 0xb2, 0x6d, 0x9f,
+    0x0a, 0x20, 0x93, 0x3e, 0x8c, 0xb2, 0xc1, 0xda, 0x38, 0x2e, 0x82, 0xb0,
+    0xdc, 0x22, 0x9c, 0x1b, 0x5e, 0xf7, 0x2e, 0x2b, 0x79, 0xaa, 0x97, 0x9f,
+    0xd5, 0xe5, 0xc9, 0x6a, 0x57, 0xdb, 0x44, 0xe1, 0xb1, 0x2e, 0xd6, 0xed,
+    0x70, 0x13, 0x9c, 0x01, 0xf4, 0x22, 0x55, 0x13, 0x73, 0x3e, 0x12, 0xba,
+    0x0b, 0x91, 0xb1, 0xcd, 0x10, 0x47, 0x80, 0x97, 0x05, 0xc8, 0x42, 0xd5,
+    0x8d, 0x21, 0x9e, 0x56, 0x35, 0x28, 0x4b, 0xdc, 0x5e, 0xcf, 0x1f, 0x3c,
+    0xf7, 0xa4, 0x64, 0xbe, 0x8c, 0x5d, 0x58, 0x49, 0x7d, 0x00, 0x58, 0x21,
+    0x01, 0x56, 0x6c, 0xab, 0x36, 0xce, 0x2f, 0x86, 0x81, 0x51, 0x9e, 0x81,
+    0xe0, 0xe7, 0xbd, 0xca, 0xaa, 0xb4, 0xd7, 0xea, 0x3a, 0x56, 0x29, 0x8b,
+    0x49, 0x94, 0x4c, 0x84, 0x0c, 0x8c, 0x95, 0x2b, 0x4a, 0xc0, 0x04, 0xd2,
+    0x80, 0x2d, 0xd4, 0xbd, 0x27, 0xd6, 0x90, 0x23, 0x1d, 0x98, 0x83, 0x5b,
+    0xa3, 0x0d, 0x2e, 0x70, 0xc8, 0xc1, 0x8e, 0xeb, 0x9c, 0x43, 0x4d, 0xf6,
+    0xd4, 0xce, 0x0f, 0xb2, 0x31, 0x8f, 0xa1, 0x81, 0xa0, 0x6e, 0x1a, 0x17,
+    0xf1, 0x6b, 0xf8, 0x23, 0xe7, 0xce, 0xe5, 0xaf, 0xcb, 0xef, 0x9d, 0x4b,
+    0xf6, 0xd6, 0xd8, 0x1f, 0x85, 0x05, 0xb4, 0x21, 0x2d, 0x0d, 0x16, 0xa9,
+    0x4a, 0x98, 0x44, 0xda, 0x34, 0xa5, 0x6b, 0x8d, 0xe1, 0x27, 0x63, 0xb5,
+    0x0c, 0x1e, 0x82, 0x85, 0x8e, 0x8b, 0x4b, 0xb8, 0x7d, 0xdc, 0xd6, 0x28,
+    0xc7, 0xd0, 0x4f, 0xbd, 0xbd, 0xed, 0x6b, 0x36, 0xc8, 0x2b, 0x9f, 0x35,
+    0xbb, 0x23, 0x1b, 0x9d, 0x77, 0x18, 0xa2, 0x03, 0xab, 0x89, 0x8c, 0x00,
+    0x27, 0x24, 0x82, 0x13, 0x56, 0x3a, 0x1b, 0x37, 0xc6, 0xee, 0x14, 0x8a,
+    0x66, 0x79, 0x05, 0x2b, 0x7e, 0x29, 0x65, 0xc6, 0x8f, 0x56, 0xfa, 0x9c,
+    0xb2, 0x5d, 0xb7, 0xa7, 0xd5, 0x4f, 0x72, 0xe1, 0x0e, 0xd4, 0x37, 0x8f,
+    0x6e, 0xe9, 0xfb, 0x02, 0xc9, 0x79, 0x73, 0x71, 0x94, 0x23, 0xc6, 0x71,
+    0x1b, 0xa4, 0x47, 0xad, 0x00, 0x66, 0x48, 0x0f, 0x56, 0x5b, 0xed, 0xfc,
+    0xba, 0xff, 0xa5, 0x07, 0xe4, 0x6a, 0x94, 0x98, 0xe7, 0x23, 0x7d, 0x41,
+    0x64, 0xd0, 0x88, 0x42, 0xdb, 0xd3, 0x1b, 0x15, 0x8e, 0x4c, 0xad, 0xd6,
+    0xa2, 0xa8, 0xb8, 0x2b, 0x73, 0xdb, 0xe5, 0x14, 0x01, 0xe6, 0xcf, 0xb4,
+    0x25, 0xba, 0xf6, 0xb4, 0x3e, 0xe6, 0x10, 0x72, 0xfe, 0x81, 0x5a, 0x8e,
+    0x8f, 0x28, 0xd1, 0x38, 0xc0, 0x27, 0x32, 0x34, 0xe5, 0x56, 0xb5, 0xa4,
+    0xba, 0x4c, 0x32, 0x21, 0x3a, 0xa2, 0xd8, 0x37, 0xd4, 0xec, 0x08, 0x8e,
+    0x57, 0xf1, 0xcb, 0x36, 0xdc, 0x43, 0xab, 0xd1, 0x09, 0x00, 0x07, 0x12,
+    0xc0, 0x81, 0xd9, 0xd4, 0x16, 0x17, 0x3d, 0x06, 0x60, 0x2f, 0x46, 0x19,
+    0xa0, 0xe4, 0xbf, 0x6d, 0xc6, 0xde, 0x40, 0xf6, 0x56, 0x82, 0x84, 0xa9,
+    0x06, 0xbf, 0xaa, 0xb9, 0xe4, 0xcd, 0xef, 0xaa, 0x80, 0x5f, 0x83, 0x4c,
+    0x5e, 0x6b, 0x82, 0x57, 0x8d, 0x19, 0xb0, 0x6a, 0x4a, 0x69, 0xcb, 0x7a,
+    0x0d, 0x7e, 0x6b, 0xe2, 0xee, 0x0e, 0xad, 0xe7, 0x31, 0xa0, 0x39, 0x54,
+    0xd5, 0x76, 0x0b, 0x54, 0xc2, 0xd6, 0x87, 0x1d, 0x97, 0x37, 0x75, 0x43,
+    0x51, 0x05, 0x8c, 0x3c, 0xe7, 0x0c, 0x4a, 0x90, 0xb3, 0xcb, 0x35, 0x57,
+    0x2d, 0x71, 0xb9, 0x54, 0x83, 0xdc, 0xd9, 0x7d, 0x6e, 0x27, 0xc0, 0x18,
+    0x3c, 0xa4, 0x72, 0x05, 0xc4, 0xc1, 0xee, 0x63, 0x4a, 0xf3, 0xf3, 0xe8,
+    0xde, 0xca, 0x20, 0x23, 0xa8, 0x7e, 0x76, 0x79, 0x39, 0xde, 0x02, 0x1a,
+    0x83, 0x09, 0x93, 0x73, 0x0a, 0x99, 0x75, 0x28, 0x29, 0x32, 0x87, 0x30,
+    0x5c, 0xc0, 0xd6, 0x4b, 0xdf, 0x18, 0x75, 0x8d, 0xb8, 0x12, 0x50, 0x55,
+    0x06, 0xb2, 0xb9, 0xdc, 0xf7, 0xc3, 0x6e, 0xc7, 0x72, 0x3f, 0x56, 0xd5,
+    0xfa, 0x20, 0xaf, 0x1d, 0x16, 0xf7, 0xfc, 0x7f, 0xc3, 0x62, 0x1f, 0xf6,
+    0xbe, 0x62, 0x86, 0xfc, 0x4d, 0x8a, 0x37, 0xb2, 0x1e, 0x37, 0x43, 0x91,
+    0x49, 0xe9, 0x01, 0x12, 0xfb, 0x99, 0x12, 0xaa, 0x65, 0x22, 0xb7, 0xa9,
+    0xd1, 0xe8, 0x62, 0xb4, 0x20, 0x0c, 0x49, 0xe1, 0xa5, 0xd1, 0x6a, 0x64,
+    0x77, 0x30, 0x48, 0x21, 0x9c, 0x01, 0x16, 0x06, 0x52, 0x28, 0x4b, 0x93,
+    0x19, 0xa1, 0x02, 0x64, 0x76, 0x05, 0xd5, 0xbe, 0x31, 0x6a, 0x8e, 0x9b,
+    0x35, 0x0c, 0x36, 0xf2, 0x23, 0x91, 0xd1, 0xa2, 0x10, 0x7b, 0x8b, 0x84,
+    0x06, 0xe1, 0x16, 0x7d, 0x9a, 0x94, 0x7e, 0x12, 0xda, 0xab, 0x60, 0x2a,
+    0xa8, 0x76, 0x6a, 0x32, 0x5e, 0x4a, 0x83, 0xf3, 0xa4, 0x37, 0xc7, 0xa1,
+    0x77, 0x06, 0xa8, 0x19, 0xd9, 0x6f, 0x2d, 0xe6, 0x54, 0x5a, 0x7c, 0x1f,
+    0x44, 0xb2, 0x0e, 0xf2, 0xdd, 0x89, 0xe7, 0x7f, 0x5a, 0xb5, 0xb5, 0x7d,
+    0x82, 0x8d, 0x89, 0x41, 0x1d, 0x6e, 0x53, 0x0c, 0x1b, 0x60, 0x7b, 0xa1,
+    0xce, 0x75, 0xca, 0x6b, 0x74, 0x2b, 0x76, 0x19, 0xe1, 0x22, 0x24, 0x2b,
+    0x05, 0x35, 0xf1, 0x26, 0xf7, 0x14, 0x3f, 0x19, 0x90, 0x2a, 0xa5, 0x18,
+    0x63, 0x4d, 0x7d, 0x04, 0x6b, 0xa5, 0x15, 0x72, 0x7e, 0x37, 0x87, 0xa2,
+    0x2b, 0x95, 0x12, 0xf2, 0xa9, 0xe0, 0xab, 0x4f, 0xd8, 0x68, 0x7a, 0x0e,
+    0x87, 0x62, 0xb1, 0x6c, 0x77, 0x1d, 0xdb, 0x51, 0x23, 0x76, 0xb9, 0x94,
+    0xd5, 0x36, 0x68, 0x48, 0x4b, 0x0a, 0xd2, 0xd2, 0xb1, 0xa7, 0xca, 0x61,
+    0x5f, 0x47, 0xbe, 0x30, 0x99, 0x45, 0x0f, 0x38, 0x4e, 0x27, 0x25, 0xf4,
+    0x18, 0xce, 0x9b, 0x25, 0xc6, 0x42, 0xea, 0x1c, 0x55, 0xca, 0x17, 0xbe,
+    0x39, 0xfc, 0x44, 0x0f, 0xb9, 0xec, 0xc4, 0x17, 0xd5, 0x74, 0x72, 0x5d,
+    0x8f, 0x48, 0xa6, 0xb1, 0x2e, 0x9a, 0x9d, 0x96, 0x4e, 0x8a, 0x31, 0x6f,
+    0xa4, 0xdd, 0x1f, 0xe2, 0x2d, 0xe6, 0x90, 0xdb, 0x02, 0x97, 0x8c, 0x40,
+    0x8b, 0xa5, 0x5a, 0x93, 0xfc, 0xf3, 0x77, 0xcf, 0x67, 0xb6, 0x18, 0x76,
+    0xae, 0x15, 0x67, 0x09, 0xed, 0x82, 0x72, 0xd3, 0x1b, 0x1c, 0x22, 0xb7,
+    0x10, 0x52, 0x4a, 0x48, 0xb6, 0xba, 0x2b, 0x95, 0x7f, 0x3d, 0x6b, 0x65,
+    0x9d, 0xc2, 0x5e, 0xab, 0x95, 0x85, 0x9b, 0x6c, 0x42, 0xc3, 0x12, 0xb9,
+    0x75, 0x5c, 0xcc, 0xea, 0x53, 0x70, 0x63, 0xd2, 0xa8, 0xe9, 0x37, 0xbb,
+    0xaf, 0xf6, 0x9e, 0x5a, 0x04, 0xc6, 0x22, 0x0f, 0x78, 0x05, 0xd5, 0x8b,
+    0x8c, 0x86, 0x5d, 0x87, 0xa2, 0x7d, 0x8a, 0xb8, 0x03, 0x2a, 0xda, 0xa0,
+    0x8c, 0x6e, 0xdf, 0x5b, 0xaa, 0x9e, 0x71, 0x75, 0x94, 0x81, 0x94, 0xab,
+    0x25, 0x86, 0x3c, 0xc9, 0x04, 0xfc, 0x68, 0x02, 0xc1, 0x8d, 0x90, 0x3f,
+    0x6f, 0x7e, 0x16, 0x63, 0xdc, 0xb1, 0x4b, 0x78, 0x0c, 0xac, 0xbb, 0xac,
+    0xc6, 0x8a, 0xa5, 0x03, 0x24, 0x4f, 0x8d, 0x88, 0xfc, 0x1a, 0x2a, 0x1b,
+    0x88, 0xb8, 0x28, 0x52, 0xf0, 0xcb, 0xa0, 0x37, 0xe5, 0xcd, 0x18, 0xeb,
+    0xcc, 0x10, 0xeb, 0x80, 0x9f, 0xc0, 0x4b, 0x9d, 0x95, 0x28, 0xe6, 0x39,
+    0xee, 0x01, 0x8b, 0x0c, 0xca, 0x5b, 0x1d, 0x63, 0x71, 0x69, 0x9c, 0xdf,
+    0x02, 0x48, 0xd5, 0xac, 0x82, 0x55, 0xda, 0x2a, 0x48, 0xbe, 0x1a, 0xaa,
+    0x6a, 0x9d, 0x7c, 0x71, 0x95, 0xab, 0x65, 0x02, 0xb8, 0xa1, 0x74, 0x63,
+    0xbe, 0x11, 0xaa, 0x46, 0xaa, 0x88, 0x05, 0x07, 0x41, 0xf5, 0x85, 0xd7,
+    0x00, 0x93, 0x8d, 0x97, 0xd4, 0x23, 0x05, 0x5c, 0xbe, 0xee, 0x74, 0xeb,
+    0xbe, 0x0c, 0x40, 0x7c, 0x03, 0xab, 0x94, 0xb3, 0x90, 0xb8, 0xb5, 0x41,
+    0xc5, 0xb6, 0xf2, 0xc9, 0xed, 0x02, 0xe3, 0x54, 0x61, 0xe8, 0xb8, 0x10,
+    0xea, 0x64, 0xa8, 0x1c, 0xa1, 0x53, 0xc7, 0xb8, 0xd8, 0xa9, 0x14, 0xed,
+    0x7d, 0x55, 0x1e, 0xbb, 0xa3, 0x3f, 0x30, 0x2b, 0xc1, 0x2a, 0xe2, 0x23,
+    0xc0, 0x03, 0x8d, 0x38, 0xfb, 0x16, 0x48, 0x6b, 0x64, 0x65, 0x11, 0xbb,
+    0x4a, 0xf0, 0xdc, 0xa6, 0x3a, 0xdb, 0xd7, 0x40, 0x23, 0x27, 0x17, 0x94,
+    0xb3, 0x88, 0xb6, 0xdf, 0x17, 0xb3, 0x1d, 0x72, 0x1e, 0x9b, 0x32, 0x31,
+    0x30, 0x65, 0x76, 0x5e, 0x0b, 0x8c, 0x06, 0x89, 0x7a, 0xc8, 0xed, 0x1a,
+    0x3d, 0x97, 0x3f, 0x42, 0xf9, 0xac, 0xfa, 0xe1, 0xb7, 0xe6, 0x17, 0x19,
+    0x35, 0x40, 0x13, 0x8d, 0x4a, 0xf1, 0x6d, 0x3f, 0x66, 0xb1, 0x30, 0xcc,
+    0x3e, 0x0e, 0x96, 0x50, 0x1c, 0xfc, 0x73, 0x95, 0x9f, 0x44, 0x94, 0x8e,
+    0x3b, 0xad, 0x8f, 0x00, 0xe0, 0xae, 0x4f, 0x75, 0xcd, 0x58, 0x6e, 0xef,
+    0x9b, 0x3b, 0x70, 0x0a, 0xa8, 0x84, 0x64, 0x40, 0x01, 0x00, 0x32, 0x56,
+    0x18, 0xbf, 0x38, 0x26, 0xb5, 0x6b, 0x21, 0x19, 0x52, 0x90, 0xe3, 0x72,
+    0xab, 0x48, 0x2d, 0xf1, 0xe7, 0xbf, 0x23, 0x35, 0x00, 0x70, 0x88, 0x47,
+    0xbd, 0x2a, 0x09, 0x09, 0x32, 0x06, 0xc6, 0xe6, 0x2a, 0x4e, 0x63, 0xc8,
+    0xcd, 0x7d, 0xd3, 0xca, 0x69, 0x7d, 0xd7, 0x9a, 0x48, 0x0e, 0xa7, 0x24,
+    0x3a, 0x82, 0x66, 0xe0, 0x42, 0xac, 0x90, 0xda, 0x00, 0xd2, 0xd0, 0x50,
+    0x35, 0xa7, 0x3a, 0xc7, 0xf9, 0x59, 0x8e, 0x7d, 0x69, 0xaf, 0x39, 0xdc,
+    0x09, 0x77, 0x25, 0x00, 0xa9, 0x2b, 0xe9, 0x09, 0x52, 0x00, 0x7a, 0x01,
+    0x9b, 0x3e, 0x2b, 0xa3, 0x09, 0x00, 0x02, 0x4c, 0x0f, 0x02, 0xf4, 0x14,
+    0xcf, 0x76, 0x99, 0x86, 0x2e, 0xbb, 0x99, 0x12, 0x64, 0x77, 0x46, 0x81,
+    0x73, 0xce, 0xdb, 0x11, 0xa3, 0x71, 0x07, 0x53, 0x68, 0x0c, 0xcb, 0x99,
+    0x21, 0x4e, 0xed, 0x51, 0x11, 0xe7, 0x03, 0xc2, 0xb8, 0xf4, 0x12, 0x1a,
+    0x44, 0x24, 0x5d, 0xf8, 0x53, 0x27, 0x1a, 0xf4, 0xce, 0x0f, 0x12, 0x10,
+    0x8c, 0x0b, 0x08, 0x54, 0x00, 0x8c, 0xaa, 0x3b, 0x09, 0x19, 0xde, 0x20,
+    0x7e, 0x1c, 0xb6, 0x14, 0x7d, 0x3c, 0x93, 0xe6, 0xa8, 0x31, 0x1e, 0x12,
+    0xf6, 0xd1, 0x9a, 0xc9, 0x3d, 0x18, 0x08, 0x94, 0x34, 0x87, 0xb0, 0x47,
+    0x97, 0xea, 0xcb, 0x3f, 0x41, 0x7b, 0xdc, 0xb4, 0xa1, 0xcd, 0xf1, 0x9b,
+    0xbe, 0xe0, 0x2d, 0x40, 0x02, 0x03, 0xf5, 0xf4, 0xa1, 0x45, 0xaa, 0xba,
+    0xec, 0xce, 0xb4, 0x12, 0x1d, 0xcd, 0x8e, 0x35, 0x62, 0x40, 0x17, 0x97,
+    0xb6, 0x34, 0x99, 0x55, 0xcf, 0xc2, 0xbe, 0x35, 0x36, 0xaa, 0x10, 0x21,
+    0x91, 0x1b, 0x48, 0xe4, 0xab, 0x58, 0x53, 0xed, 0x1a, 0x46, 0x51, 0x1d,
+    0x43, 0x8e, 0xb7, 0x27, 0x24, 0x86, 0x17, 0xaa, 0xf2, 0x46, 0x0b, 0x9d,
+    0x98, 0x06, 0xa0, 0x0e, 0xe0, 0x66, 0xea, 0x12, 0xd4, 0xde, 0xc8, 0x20,
+    0xba, 0x4e, 0x55, 0x0e, 0x88, 0x8e, 0x18, 0x74, 0xe8, 0xa9, 0x35, 0xf6,
+    0xa0, 0x04, 0x21, 0x14, 0x72, 0x9c, 0x3c, 0x7c, 0x8c, 0xe2, 0x6e, 0xa5,
+    0x49, 0x93, 0x71, 0x1f, 0xe4, 0x99, 0x68, 0xde, 0x66, 0x2c, 0xba, 0x22,
+    0xee, 0x36, 0x8b, 0x91, 0xaa, 0x17, 0x48, 0xd5, 0xa6, 0xab, 0xe4, 0xa5,
+    0x9b, 0x7c, 0x74, 0xea, 0xe4, 0x39, 0x2e, 0x6f, 0x37, 0x6e, 0x52, 0xc6,
+    0x69, 0x83, 0x12, 0xb1, 0x0b, 0xbb, 0xdf, 0x0e, 0xed, 0x18, 0x6c, 0xa2,
+    0x87, 0x41, 0x15, 0x5c, 0x60, 0xe2, 0x32, 0xaf, 0x72, 0x0e, 0x3c, 0xd6,
+    0xd3, 0x5a, 0x40, 0xfa, 0x34, 0x90, 0x3e, 0xdd, 0x62, 0xe5, 0x26, 0x17,
+    0xc1, 0xf4, 0xe5, 0x22, 0x63, 0x24, 0xa8, 0x6e, 0xe8, 0xb3, 0x7b, 0x8f,
+    0x72, 0x49, 0x0f, 0x08, 0xb7, 0x30, 0x5b, 0xe5, 0x49, 0x0b, 0x98, 0x3b,
+    0x44, 0xa9, 0x49, 0x11, 0x1f, 0x72, 0xa7, 0x41, 0x8c, 0x75, 0xb2, 0xb6,
+    0xb3, 0xc7, 0xf2, 0x23, 0x17, 0x1b, 0x2c, 0x5d, 0x2d, 0xe4, 0xbc, 0xbb,
+    0xf9, 0x60, 0xc6, 0x95, 0xe4, 0x48, 0xa6, 0xde, 0x49, 0xf2, 0x75, 0x5c,
+    0x04, 0x37, 0x1d, 0x80, 0xbf, 0x60, 0xb1, 0x79, 0xd1, 0x9a, 0x84, 0x51,
+    0xb2, 0x8b, 0x59, 0xfc, 0x51, 0x5d, 0xeb, 0x21, 0x0d, 0x9b, 0x80, 0xc8,
+    0xa7, 0x63, 0x57, 0xdb, 0x3a, 0xda, 0x89, 0x1c, 0x19, 0x0f, 0x08, 0x76,
+    0xff, 0xfc, 0x4d, 0xc0, 0x69, 0x19, 0x93, 0xc9, 0xa2, 0x8d, 0xee, 0x4d,
+    0xfa, 0x5f, 0x88, 0x5f, 0xc7, 0xc5, 0x15, 0x71, 0x7b, 0xcc, 0xea, 0xdf,
+    0xdd, 0x43, 0x2f, 0x21, 0x6d, 0x1b, 0x44, 0x76, 0x7b, 0x73, 0x68, 0x63,
+    0x46, 0x14, 0xaa, 0x30, 0x3f, 0x89, 0xfb, 0xf8, 0x24, 0xa8, 0x5c, 0x76,
+    0x36, 0xbe, 0x72, 0x11, 0x02, 0xd0, 0x08, 0xc8, 0x6f, 0xbc, 0x35, 0xae,
+    0x9e, 0xbd, 0xde, 0x26, 0xb2, 0x45, 0xbc, 0x79, 0xab, 0x06, 0x21, 0x4a,
+    0x95, 0x44, 0xd6, 0x65, 0x7a, 0x2f, 0xa7, 0x93, 0x48, 0x33, 0x15, 0x85,
+    0x9b, 0x29, 0x7a, 0xed, 0x22, 0xb8, 0x7e, 0x4a, 0xfd, 0xbb, 0xd8, 0x98,
+    0x19, 0x42, 0x63, 0x2d, 0xcd, 0x26, 0x65, 0xc7, 0x50, 0x87, 0x1f, 0x06,
+    0x19, 0xce, 0xf7, 0x2f, 0xdf, 0xbf, 0x22, 0x01, 0xc1, 0xe7, 0xac, 0x5e,
+    0x31, 0x40, 0x8a, 0xb6, 0x50, 0x84, 0x1f, 0x36, 0x55, 0x08, 0x9e, 0x29,
+    0xc2, 0x49, 0x67, 0x67, 0x20, 0x51, 0x50, 0x4d, 0xc0, 0xdd, 0xed, 0xac,
+    0xf9, 0xe1, 0x6e, 0x90, 0x48, 0x83, 0xd3, 0xbb, 0x50, 0xcc, 0x4c, 0x98,
+    0xf7, 0xb7, 0xba, 0xcc, 0x43, 0x97, 0x3e, 0x73, 0x41, 0xfd, 0x14, 0x14,
+    0x1e, 0x96, 0x42, 0x94, 0x16, 0x06, 0xf6, 0xd8, 0x27, 0x59, 0xa1, 0x13,
+    0x8c, 0x01, 0xa1, 0x11, 0x31, 0x5d, 0x01, 0x70, 0x81, 0x0d, 0x95, 0xcb,
+    0x83, 0x78, 0xb3, 0xdb, 0xd5, 0xa5, 0xb8, 0xcd, 0xe0, 0x03, 0x65, 0xfb,
+    0x79, 0x30, 0xe2, 0x9c, 0x6d, 0xf3, 0xda, 0x44, 0x11, 0x1a, 0xfa, 0x1b,
+    0x3a, 0xb5, 0xac, 0xd0, 0x69, 0x63, 0x41, 0x68, 0xa8, 0x7d, 0xd7, 0xc3,
+    0x8a, 0x75, 0xdb, 0xc6, 0x16, 0x80, 0xc4, 0x46, 0x86, 0xaa, 0x88, 0x76,
+    0x6f, 0xf6, 0x2e, 0x56, 0x43, 0xb6, 0xb3, 0x3d, 0x6f, 0xed, 0xcd, 0x39,
+    0x42, 0x7a, 0xe6, 0xc3, 0x6c, 0xf0, 0x62, 0xb2, 0xda, 0x09, 0x8b, 0xe8,
+    0xad, 0x7d, 0x17, 0x4b, 0xdc, 0x15, 0xd3, 0xf6, 0xc6, 0x95, 0x02, 0x05,
+    0x20, 0x43, 0x4f, 0x6f, 0xe8, 0xf7, 0xd2, 0xb9, 0xc0, 0x1f, 0x78, 0x25,
+    0x07, 0x83, 0x65, 0x3b, 0x50, 0xb4, 0xf4, 0xa7, 0xf1, 0xfc, 0x8e, 0x9d,
+    0x38, 0x0f, 0x79, 0xd5, 0xba, 0x91, 0xf6, 0xa4, 0x5b, 0x36, 0x40, 0x98,
+    0x25, 0x85, 0x83, 0x70, 0x44, 0x86, 0x2c, 0xc7, 0xe5, 0x2b, 0x1e, 0x0d,
+    0xec, 0xe2, 0xc0, 0x5b, 0x63, 0x5a, 0x2a, 0x4c, 0x20, 0x95, 0x5a, 0x8f,
+    0x7a, 0x5e, 0x7e, 0x3e, 0x96, 0x63, 0x6c, 0x7c, 0x06, 0xb4, 0x29, 0xb7,
+    0x06, 0x0d, 0x48, 0xeb, 0xa7, 0xc1, 0x11, 0xf6, 0xf6, 0xa9, 0xa6, 0x81,
+    0xdb, 0x43, 0x6a, 0x73, 0xda, 0xab, 0x65, 0x8d, 0xa3, 0xd7, 0x98, 0x70,
+    0xa3, 0xa9, 0xcc, 0xb2, 0x30, 0x68, 0xfb, 0xb1, 0xff, 0x93, 0xb4, 0xc5,
+    0x0d, 0xf8, 0xdd, 0x09, 0x5f, 0x56, 0x04, 0xc8, 0x5b, 0x16, 0x11, 0xdb,
+    0x17, 0xd0, 0x82, 0x0f, 0x32, 0x9d, 0x10, 0x9f, 0xb0, 0x8a, 0xda, 0x99,
+    0xa9, 0xc3, 0x3c, 0x2e, 0x4a, 0x7a, 0x54, 0x88, 0x3c, 0xa5, 0x13, 0x03,
+    0x84, 0x40, 0x23, 0x83, 0x5f, 0xc4, 0xc8, 0xb3, 0x8a, 0x74, 0x36, 0xe8,
+    0xe9, 0xd3, 0x8d, 0xcc, 0x8d, 0xdc, 0xe9, 0x4e, 0x33, 0xc2, 0x2a, 0x05,
+    0xe9, 0xcf, 0xf5, 0x45, 0x6c, 0xd0, 0x93, 0xb6, 0x42, 0x9f, 0x6c, 0x5b,
+    0xa9, 0x62, 0xbd, 0x9e, 0x64, 0x4c, 0xbe, 0x8f, 0x7c, 0x5d, 0xed, 0x29,
+    0xbd, 0xa7, 0x2f, 0x1b, 0xb7, 0xd5, 0x8c, 0x31, 0x1e, 0x91, 0x2d, 0x97,
+    0x80, 0x85, 0xd4, 0xa7, 0xc0, 0xa9, 0x3c, 0xb4, 0x4d, 0xac, 0x65, 0xf9,
+    0x30, 0xcb, 0x87, 0xab, 0x2f, 0x32, 0x7e, 0x89, 0x03, 0x45, 0xf3, 0xd2,
+    0x41, 0xf7, 0x84, 0xc1, 0x40, 0x77, 0x89, 0x92, 0x96, 0xb3, 0xc7, 0xe1,
+    0x37, 0x66, 0x90, 0x59, 0x0c, 0x75, 0x39, 0xd7, 0x59, 0x68, 0xbd, 0xa6,
+    0x8c, 0x92, 0x49, 0x06, 0x68, 0x96, 0x40, 0xb2, 0x5d, 0xa7, 0x3f, 0x1d,
+    0x92, 0x20, 0x2d, 0x1e, 0x32, 0x06, 0x31, 0x10, 0xe3, 0x40, 0x75, 0xb0,
+    0x0a, 0x27, 0xcf, 0x04, 0x85, 0x15, 0x57, 0xb6, 0xdf, 0xe9, 0xe0, 0x1c,
+    0x62, 0xdd, 0x57, 0x31, 0x3b, 0x66, 0x9c, 0x91, 0xc1, 0xa6, 0x59, 0x68,
+    0xb6, 0x84, 0x61, 0x45, 0x73, 0x1a, 0x72, 0xb1, 0xd3, 0x68, 0xa8, 0xd7,
+    0x24, 0x49, 0x67, 0xc5, 0x94, 0x4d, 0x0c, 0x5c, 0x39, 0xd5, 0xa7, 0xee,
+    0x81, 0x67, 0x1f, 0x47, 0xf7, 0x7a, 0x6b, 0x60, 0x4d, 0x98, 0x1d, 0x92,
+    0xaf, 0x83, 0xe4, 0xbb, 0x18, 0xb9, 0x18, 0xb3, 0x30, 0x13, 0x25, 0x76,
+    0xe8, 0xe6, 0x90, 0x46, 0x35, 0x37, 0x00, 0x89, 0xe6, 0x73, 0x4b, 0x1e,
+    0xa4, 0xbc, 0x14, 0x9a, 0x70, 0x24, 0xad, 0x83, 0x9e, 0x7c, 0xce, 0xd4,
+    0x03, 0x94, 0xed, 0xac, 0x42, 0x51, 0x40, 0x9e, 0x77, 0xb6, 0x0b, 0x7c,
+    0xb9, 0x74, 0x29, 0x28, 0xa1, 0x87, 0xbd, 0x52, 0x4e, 0x31, 0x45, 0x0c,
+    0xd1, 0xba, 0x5c, 0x61, 0xd2, 0x29, 0x3c, 0xe0, 0x81, 0xd0, 0x18, 0x0f,
+    0xe3, 0xac, 0x92, 0xf7, 0x07, 0x60, 0x11, 0x3d, 0xf7, 0xf4, 0x09, 0xcd,
+    0x4d, 0x51, 0xc0, 0x4f, 0x26, 0x31, 0xba, 0xaa, 0xe4, 0x46, 0x89, 0xe5,
+    0x84, 0x81, 0xbc, 0xed, 0x1c, 0x6a, 0x2b, 0x1f, 0x72, 0xd9, 0x99, 0xc9,
+    0x2e, 0x92, 0x8f, 0x61, 0x88, 0x10, 0xf7, 0x50, 0x61, 0x18, 0xb9, 0xb9,
+    0x38, 0x62, 0xc5, 0x31, 0x49, 0x72, 0xbd, 0x80, 0xf6, 0x8a, 0x78, 0x31,
+    0xf1, 0x5e, 0xb4, 0x51, 0xa7, 0xde, 0x4d, 0x2d, 0x52, 0x9f, 0xb1, 0x0a,
+    0x4a, 0x0f, 0x79, 0xde, 0x41, 0x9e, 0x0f, 0xeb, 0xa1, 0x92, 0xee, 0x91,
+    0xe9, 0xb5, 0x8e, 0x83, 0xc7, 0x94, 0xf2, 0x43, 0x13, 0xc5, 0xf9, 0x2f,
+    0x00, 0x32, 0xd8, 0x99, 0x7b, 0x31, 0x8f, 0xcb, 0xbc, 0xb8, 0x3e, 0x43,
+    0xc1, 0xfe, 0x66, 0x9c, 0x3a, 0x5b, 0xc5, 0xa0, 0x17, 0xa2, 0xa8, 0x0b,
+    0x20, 0x87, 0x8a, 0x6c, 0x8c, 0x52, 0x6a, 0x0e, 0xc7, 0xc6, 0xcd, 0xd1,
+    0x2b, 0xeb, 0x06, 0x9e, 0x85, 0x34, 0xe0, 0x90, 0x1d, 0x32, 0xed, 0xd5,
+    0x1b, 0x8c, 0xbf, 0x33, 0x16, 0x90, 0x83, 0x8b, 0x68, 0x7a, 0x70, 0xf3,
+    0xab, 0xe0, 0xc4, 0xc0, 0xa6, 0xdf, 0xc5, 0x74, 0xee, 0xf0, 0x17, 0x4a,
+    0xe3, 0x74, 0xc2, 0x00, 0x33, 0x8b, 0xc0, 0x73, 0x43, 0x9b, 0xb6, 0x5b,
+    0x74, 0x62, 0x71, 0x37, 0x82, 0xb0, 0x4b, 0xe1, 0xa0, 0x29, 0xe3, 0x3b,
+    0x30, 0x60, 0xc2, 0xe4, 0x6d, 0xc2, 0xc2, 0x15, 0xf5, 0x4b, 0x2d, 0x26,
+    0x1f, 0xbd, 0xc1, 0x50, 0x60, 0x59, 0xf7, 0x60, 0xdc, 0xcc, 0x14, 0x21,
+    0x5a, 0xdf, 0x3a, 0x27, 0xd3, 0x51, 0xf2, 0xb7, 0x8e, 0xd0, 0x11, 0xf2,
+    0x94, 0x8e, 0xbc, 0xe3, 0x5e, 0x35, 0xc9, 0xaa, 0x43, 0x1d, 0xfd, 0xd6,
+    0x78, 0x9f, 0x80, 0x3f, 0x20, 0x04, 0xcf, 0xf2, 0xdc, 0xad, 0x86, 0xca,
+    0x95, 0x38, 0x32, 0xc4, 0xb0, 0x5a, 0xbd, 0x30, 0x28, 0x82, 0xe3, 0xa4,
+    0xe8, 0x44, 0x55, 0x56, 0x0f, 0xb6, 0x72, 0x98, 0xa2, 0x2e, 0x01, 0x06,
+    0x85, 0x8f, 0x8e, 0xeb, 0x44, 0xdc, 0x15, 0x9a, 0x8d, 0xaf, 0x3c, 0x34,
+    0x5d, 0x1d, 0x0c, 0xec, 0xd9, 0x45, 0x08, 0x0e, 0x50, 0x83, 0x57, 0xa8,
+    0xa9, 0x65, 0xd7, 0xc5, 0x70, 0x13, 0x74, 0xdd, 0x60, 0x36, 0x33, 0xc3,
+    0xde, 0x3f, 0xf6, 0x43, 0x9e, 0x5d, 0x57, 0x16, 0xcd, 0x21, 0x8c, 0xfd,
+    0x73, 0x58, 0x27, 0x28, 0xa7, 0x3b, 0xc7, 0xa2, 0x87, 0xda, 0xfa, 0x06,
+    0x3d, 0xa7, 0xb4, 0x4f, 0x7f, 0x40, 0x69, 0xc0, 0x23, 0xbb, 0xdb, 0xbc,
+    0xdd, 0x82, 0x65, 0xc2, 0x0b, 0xc3, 0x64, 0x71, 0xe3, 0xbd, 0xe4, 0x58,
+    0x03, 0xd9, 0xe9, 0x1b, 0x21, 0xc6, 0x4b, 0x0d, 0xa0, 0xc3, 0x9b, 0x2e,
+    0x47, 0x37, 0xfb, 0xeb, 0xbb, 0x2c, 0x71, 0x5b, 0x67, 0xb1, 0x9a, 0x31,
+    0x09, 0x68, 0xef, 0xee, 0x1d, 0x5d, 0x45, 0x14, 0x01, 0xe1, 0x09, 0x29,
+    0x82, 0xef, 0x66, 0xb0, 0x5b, 0xb2, 0x43, 0x25, 0x4e, 0x69, 0x87, 0x10,
+    0x2c, 0xcf, 0xea, 0xa7, 0x3c, 0x60, 0x10, 0xdf, 0x33, 0xeb, 0x36, 0x45,
+    0x9d, 0x60, 0x55, 0x1d, 0x91, 0x73, 0xe2, 0x8a, 0x42, 0x88, 0x58, 0x37,
+    0xab, 0x08, 0xa9, 0x46, 0x61, 0x66, 0x1f, 0x4d, 0x18, 0x02, 0x7e, 0x4d,
+    0xbf, 0xf5, 0x20, 0x2d, 0xd9, 0x06, 0x5a, 0x6c, 0xd5, 0xb1, 0xd4, 0x9f,
+    0xd8, 0x89, 0x91, 0x80, 0x31, 0x3c, 0xe2, 0xdc, 0xc5, 0xac, 0xdd, 0xca,
+    0x0d, 0x73, 0xa9, 0xb1, 0x86, 0xa0, 0x37, 0x26, 0x14, 0xc0, 0x4d, 0x7e,
+    0x2f, 0xad, 0x02, 0xe4, 0x7e, 0xef, 0x3b, 0xab, 0xc8, 0x01, 0xbe, 0xf8,
+    0x34, 0xe2, 0xc9, 0xb5, 0x39, 0xa4, 0x53, 0x86, 0x99, 0x7c, 0xd6, 0xc3,
+    0x80, 0x04, 0x6e, 0x2d, 0xa3, 0x79, 0xb9, 0x2e, 0x7a, 0x90, 0xc6, 0x2a,
+    0xdb, 0x30, 0xff, 0x51, 0xc6, 0x47, 0x9a, 0x82, 0x74, 0xa8, 0xe7, 0x34,
+    0xb4, 0xb7, 0xc6, 0xe5, 0x04, 0xc3, 0x01, 0x20, 0x78, 0x34, 0xd9, 0x7d,
+    0x1c, 0xc1, 0xec, 0x2b, 0x33, 0xb3, 0x6f, 0x51, 0xd0, 0xed, 0x81, 0x31,
+    0x3d, 0x28, 0x34, 0x02, 0x17, 0x74, 0xa4, 0x04, 0xc8, 0x75, 0x4a, 0xff,
+    0xa3, 0x66, 0xe5, 0x3d, 0x7e, 0xdc, 0x07, 0x05, 0x68, 0xc1, 0x03, 0x5a,
+    0x58, 0xe3, 0xb6, 0x6c, 0x72, 0x1b, 0xad, 0x25, 0xc8, 0x3b, 0x41, 0x05,
+    0x8e, 0x0b, 0xa1, 0xb8, 0x46, 0x22, 0x3d, 0x82, 0x9f, 0xb5, 0x75, 0xd4,
+    0xb7, 0x74, 0x48, 0xff, 0xe2, 0x76, 0x12, 0xf0, 0xd1, 0x01, 0x34, 0x08,
+    0x62, 0x80, 0x64, 0xd5, 0x4e, 0xe1, 0x08, 0x0c, 0xf5, 0x63, 0x6d, 0x26,
+    0xe5, 0x82, 0x8a, 0x75, 0xb6, 0xdc, 0xcb, 0xc9, 0x07, 0x69, 0x6d, 0x00,
+    0x47, 0x5e, 0xe7, 0xd9, 0x3b, 0xbf, 0x32, 0x09, 0xd3, 0x2a, 0x7a, 0xc2,
+    0x94, 0xc3, 0x98, 0xc4, 0x38, 0xc9, 0xc1, 0x3f, 0x7c, 0x60, 0x69, 0x84,
+    0x19, 0x18, 0x46, 0x0d, 0x7c, 0xfb, 0x78, 0x06, 0x6f, 0x1c, 0xf5, 0xbe,
+    0x4d, 0xa2, 0x06, 0x11, 0x01, 0x3d, 0x04, 0xe0, 0x17, 0xbc, 0xda, 0xb7,
+    0x59, 0x1c, 0x81, 0xa9, 0x16, 0x23, 0x77, 0x44, 0x0c, 0x08, 0x70, 0x38,
+    0xc7, 0x9e, 0xcb, 0x0d, 0xbc, 0x77, 0xb5, 0x41, 0x36, 0x48, 0xa1, 0x34,
+    0xa4, 0xef, 0xa0, 0xd0, 0x34, 0x5e, 0xdc, 0xcd, 0xbc, 0x30, 0x58, 0x4d,
+    0x76, 0xc5, 0x59, 0xfe, 0x7e, 0x18, 0xf7, 0xe2, 0xb8, 0x54, 0xb8, 0x0e,
+    0xf3, 0x30, 0x6c, 0xc4, 0x80, 0x01, 0x10, 0xd2, 0x30, 0xe7, 0x7b, 0x9a,
+    0x41, 0x7b, 0xc8, 0xc3, 0x41, 0x33, 0xed, 0x99, 0xda, 0x76, 0xee, 0xf1,
+    0x97, 0xd3, 0x8b, 0xf2, 0x52, 0x1c, 0xcc, 0xc9, 0x2b, 0x06, 0x80, 0xc1,
+    0xd0, 0x3e, 0xcb, 0xcc, 0xc1, 0x80, 0x01, 0x36, 0x09, 0x0a, 0x43, 0x3b,
+    0xe4, 0x3a, 0xfc, 0x02, 0x02, 0xab, 0x9e, 0x15, 0x90, 0xdb, 0x03, 0x10,
+    0x0a, 0xfb, 0xbc, 0xdb, 0x35, 0x1a, 0x66, 0x32, 0x84, 0x3b, 0xa2, 0x42,
+    0xb9, 0x25, 0xe4, 0x03, 0x97, 0x95, 0x0c, 0x8e, 0xd0, 0xcf, 0x48, 0x90,
+    0x90, 0x71, 0xfb, 0x24, 0x3d, 0xe1, 0xb4, 0x48, 0x97, 0x37, 0xab, 0xfa,
+    0xd6, 0x20, 0x9e, 0x60, 0x25, 0xe4, 0xfd, 0xd0, 0xf7, 0x18, 0xec, 0x14,
+    0xbc, 0x73, 0x01, 0x31, 0x8f, 0x61, 0xb2, 0x69, 0xbd, 0x10, 0xbd, 0x10,
+    0xb6, 0x38, 0x47, 0xbd, 0xac, 0xf7, 0x4f, 0xe5, 0xa3, 0x36, 0x3f, 0x5d,
+    0x0e, 0xd2, 0xb2, 0x1d, 0xa8, 0xc5, 0x27, 0x0c, 0xb8, 0x69, 0xcd, 0x95,
+    0xb7, 0xf7, 0x13, 0xa1, 0x63, 0x49, 0x1a, 0x24, 0x88, 0xbc, 0x9b, 0x62,
+    0xbe, 0x7d, 0x8e, 0xd8, 0x04, 0x1f, 0x00, 0x4b, 0x04, 0xc7, 0x4c, 0x66,
+    0xdd, 0x39, 0x68, 0xa8, 0xf4, 0xb2, 0xc4, 0xe3, 0xe0, 0xce, 0xe5, 0xdc,
+    0x99, 0x95, 0x27, 0x73, 0x20, 0x03, 0xa6, 0x83, 0xb8, 0x89, 0xf2, 0x3f,
+    0x5a, 0x83, 0x1e, 0x2b, 0x61, 0x67, 0xa2, 0x87, 0x65, 0xd0, 0x99, 0x9d,
+    0xc6, 0x61, 0xfd, 0xa4, 0x18, 0x0d, 0x51, 0x02, 0xc0, 0x09, 0x1e, 0xcd,
+    0xa0, 0x59, 0xb3, 0xae, 0x4c, 0xdc, 0x52, 0x88, 0xbc, 0xc1, 0xc1, 0x9a,
+    0xa2, 0xab, 0x3b, 0xeb, 0x1f, 0xaf, 0xe6, 0x4e, 0xbd, 0x63, 0x40, 0x14,
+    0xbf, 0x35, 0xd2, 0x6d, 0xfb, 0xfd, 0x9f, 0x3e, 0x00, 0xa2, 0x84, 0xf4,
+    0xdd, 0x21, 0x0c, 0x0e, 0xa7, 0x99, 0x86, 0x9e, 0x55, 0x9f, 0x86, 0xb8,
+    0x89, 0x15, 0x56, 0xf0, 0x04, 0xdf, 0x40, 0xf0, 0xc8, 0x95, 0xa9, 0xd5,
+    0x72, 0x98, 0x5e, 0xa6, 0x3a, 0xbb, 0xf6, 0x92, 0xc1, 0x1e, 0xf6, 0xee,
+    0x84, 0x28, 0xa8, 0x47, 0x58, 0x14, 0x2e, 0x37, 0x63, 0x2c, 0x4b, 0x18,
+    0xb0, 0x86, 0xc3, 0x31, 0x5b, 0x7c, 0x87, 0xf0, 0x8a, 0x5a, 0x03, 0x0a,
+    0x89, 0xc3, 0xc8, 0x9d, 0x9f, 0x4e, 0x54, 0x65, 0x2b, 0xc6, 0x50, 0x7a,
+    0x32, 0xc2, 0x6a, 0xc4, 0x4f, 0x18, 0xbd, 0xe9, 0x6d, 0x71, 0xcc, 0x30,
+    0x11, 0x3e, 0x62, 0x71, 0x13, 0x56, 0x8c, 0x73, 0x54, 0xdc, 0xa4, 0x26,
+    0x99, 0x92, 0x6d, 0xa4, 0x20, 0x9c, 0x55, 0x1d, 0x7f, 0x7f, 0xe1, 0x66,
+    0x7a, 0x88, 0xc6, 0x01, 0x82, 0x88, 0x80, 0x20, 0xe2, 0x3a, 0xfb, 0xc3,
+    0xaf, 0xcc, 0x44, 0x8f, 0xf3, 0x03, 0x8e, 0xc7, 0xed, 0x71, 0x54, 0x9e,
+    0x55, 0xf7, 0x7b, 0x6b, 0xd8, 0x4e, 0x40, 0x10, 0xf0, 0x44, 0x54, 0x77,
+    0x07, 0x26, 0xe8, 0x20, 0xfd, 0xb2, 0x69, 0xeb, 0xe2, 0xce, 0x1c, 0x2a,
+    0xf5, 0x71, 0x38, 0xca, 0xc4, 0x98, 0x0c, 0x67, 0x5a, 0xdd, 0x91, 0x6e,
+    0xcc, 0x66, 0xa2, 0x09, 0x3c, 0x56, 0x0f, 0x6f, 0x00, 0x59, 0x44, 0xa8,
+    0xf0, 0x67, 0x35, 0x87, 0x6d, 0x67, 0x06, 0xce, 0x70, 0x6b, 0x7f, 0x2c,
+    0x12, 0x48, 0x0b, 0xa6, 0x25, 0x87, 0xa7, 0x9e, 0xe7, 0x62, 0x5a, 0x7c,
+    0x6d, 0xbe, 0x9e, 0xeb, 0x7c, 0xb2, 0x92, 0xa7, 0x44, 0x01, 0x92, 0xa3,
+    0x73, 0x6b, 0x51, 0x07, 0x15, 0x02, 0x83, 0xe8, 0x04, 0x57, 0xf1, 0x73,
+    0xbf, 0x09, 0x44, 0x4f, 0xc6, 0xa3, 0x5f, 0x44, 0xc1, 0xc4, 0x34, 0x23,
+    0x93, 0x15, 0xd7, 0x21, 0xf0, 0x2a, 0x93, 0x65, 0x0f, 0xf9, 0x81, 0x5d,
+    0xe4, 0x01, 0x8b, 0xbe, 0xa3, 0x60, 0xe2, 0xe4, 0x94, 0x87, 0x71, 0xf6,
+    0xe0, 0x26, 0x15, 0xcf, 0x5f, 0x19, 0x01, 0x07, 0x3e, 0x16, 0xad, 0x74,
+    0x64, 0xba, 0xad, 0xd1, 0xdd, 0xf3, 0x5f, 0x18, 0x24, 0xa0, 0x15, 0x14,
+    0xe2, 0x48, 0x59, 0xa5, 0xa4, 0x85, 0x84, 0x1c, 0x1d, 0x9a, 0xa1, 0xd9,
+    0xc5, 0xb1, 0xec, 0xeb, 0x7d, 0xe8, 0xdc, 0x99, 0x26, 0xb1, 0x6b, 0x1c,
+    0xef, 0x2a, 0xd9, 0x0c, 0x73, 0x5b, 0x90, 0xb6, 0x00, 0x6e, 0xf7, 0x75,
+    0x5b, 0x89, 0x27, 0x77, 0xd9, 0x09, 0x2b, 0x54, 0x80, 0x1c, 0x1a, 0x21,
+    0x87, 0xea, 0xdd, 0x26, 0xe0, 0xc9, 0x8c, 0x67, 0x48, 0xbc, 0x8e, 0x04,
+    0x0f, 0x33, 0x3f, 0x95, 0x83, 0x05, 0x27, 0x13, 0xae, 0x18, 0x4c, 0xdd,
+    0x9a, 0x21, 0xb6, 0xc2, 0x28, 0xc8, 0xb6, 0x31, 0xf4, 0xf3, 0x7e, 0xe8,
+    0xa3, 0xc5, 0x5a, 0xa0, 0x7f, 0x13, 0x76, 0xad, 0x25, 0xd3, 0x13, 0x24,
+    0xe7, 0xb7, 0xf9, 0xdf, 0x11, 0x69, 0xd8, 0x15, 0xfe, 0xa0, 0x1f, 0x03,
+    0x23, 0xad, 0x1a, 0xbc, 0x47, 0x00, 0x63, 0x9a, 0x6e, 0x6f, 0x8c, 0x9b,
+    0x36, 0x81, 0x0b, 0x48, 0xd2, 0x31, 0xfe, 0xfb, 0xc7, 0x2f, 0xe8, 0xed,
+    0xfc, 0x3f, 0xf2, 0x8a, 0x4c, 0xc1, 0x52, 0xff, 0xf1, 0x7f, 0xd1, 0x3d,
+    0x61, 0x23, 0x89, 0x4e, 0x00, 0x00,
+};
+unsigned const pbmb_history_page_gzip_size = sizeof pbmb_history_page_gzip;
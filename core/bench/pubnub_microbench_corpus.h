@@ -0,0 +1,46 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PUBNUB_MICROBENCH_CORPUS
+#define INC_PUBNUB_MICROBENCH_CORPUS
+
+
+#include <stddef.h>
+
+
+/** @file pubnub_microbench_corpus.h
+
+    The corpus of Pubnub replies that the micro-benchmarks work on.
+    Each reply is the body of a HTTP response, as the C-core gets it
+    in the reply buffer, and comes with the number of messages (or
+    presence UUIDs) in it.
+ */
+
+/** Subscribe reply with a few messages on two channels */
+extern char const     pbmb_subscribe_small[];
+extern size_t const   pbmb_subscribe_small_len;
+extern unsigned const pbmb_subscribe_small_count;
+
+/** A message to publish, the first one from pbmb_subscribe_small */
+extern char const   pbmb_publish_message[];
+extern size_t const pbmb_publish_message_len;
+
+/** Subscribe reply with a large batch of messages on four channels */
+extern char const     pbmb_subscribe_large[];
+extern size_t const   pbmb_subscribe_large_len;
+extern unsigned const pbmb_subscribe_large_count;
+
+/** A page of (v2) history */
+extern char const     pbmb_history_page[];
+extern size_t const   pbmb_history_page_len;
+extern unsigned const pbmb_history_page_count;
+
+/** A (v2) here-now reply for a busy channel, with UUIDs and state */
+extern char const     pbmb_presence_dump[];
+extern size_t const   pbmb_presence_dump_len;
+extern unsigned const pbmb_presence_dump_count;
+
+/** pbmb_history_page, gzipped */
+extern unsigned char const pbmb_history_page_gzip[];
+extern unsigned const      pbmb_history_page_gzip_size;
+
+
+#endif /* !defined INC_PUBNUB_MICROBENCH_CORPUS */
@@ -0,0 +1,223 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "cgreen/cgreen.h"
+#include "cgreen/mocks.h"
+
+#include "pbaes256.h"
+
+#include <pthread.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+
+
+/* A less chatty cgreen :) */
+
+#define attest assert_that
+#define equals is_equal_to
+#define streqs is_equal_to_string
+#define differs is_not_equal_to
+#define strdifs is_not_equal_to_string
+#define ptreqs(val) is_equal_to_contents_of(&(val), sizeof(val))
+#define ptrdifs(val) is_not_equal_to_contents_of(&(val), sizeof(val))
+#define sets(par, val) will_set_contents_of_parameter(par, &(val), sizeof(val))
+#define sets_ex will_set_contents_of_parameter
+#define returns will_return
+
+
+static uint8_t const m_key[33] = "67a4f45f0d1d9bc606486fc42dc49416";
+
+static uint8_t const m_iv[] = "0123456789012345";
+
+static uint8_t const m_other_iv[] = "5432109876543210";
+
+static char const* const m_msg[] = {
+    "",
+    "\"Hello world!\"",
+    "0123456789abcde",
+    "0123456789abcdef",
+    "0123456789abcdef0",
+    "{\"text\":\"a somewhat longer message, that spans a few AES blocks\"}",
+};
+
+#define MSGS (sizeof m_msg / sizeof m_msg[0])
+
+static struct pbaes256_cache* m_cache;
+
+
+static pubnub_bymebl_t as_mebl(char const* s)
+{
+    pubnub_bymebl_t result;
+    result.ptr  = (uint8_t*)s;
+    result.size = strlen(s);
+    return result;
+}
+
+
+/** Encrypts @p msg with the cache and without it, checking that
+    the outcome is the same. Returns the encrypted length. */
+static size_t encrypt_both_ways(char const* msg, uint8_t const* iv, uint8_t* out)
+{
+    uint8_t         uncached[256];
+    pubnub_bymebl_t enc_cached   = { out, 256 };
+    pubnub_bymebl_t enc_uncached = { uncached, sizeof uncached };
+
+    attest(pbaes256_encrypt_cached(m_cache, as_mebl(msg), iv, &enc_cached), equals(0));
+    attest(pbaes256_encrypt(as_mebl(msg), m_key, iv, &enc_uncached), equals(0));
+    attest(enc_cached.size, equals(enc_uncached.size));
+    attest(memcmp(out, uncached, enc_cached.size), equals(0));
+
+    return enc_cached.size;
+}
+
+
+/** Decrypts @p data with the cache and without it, checking that the
+    outcome is the same and that it is @p msg */
+static void decrypt_both_ways(pubnub_bymebl_t data, uint8_t const* iv, char const* msg)
+{
+    uint8_t         cached[256];
+    uint8_t         uncached[256];
+    pubnub_bymebl_t dec_cached   = { cached, sizeof cached };
+    pubnub_bymebl_t dec_uncached = { uncached, sizeof uncached };
+
+    attest(pbaes256_decrypt_cached(m_cache, data, iv, &dec_cached), equals(0));
+    attest(pbaes256_decrypt(data, m_key, iv, &dec_uncached), equals(0));
+    attest(dec_cached.size, equals(strlen(msg)));
+    attest(dec_uncached.size, equals(strlen(msg)));
+    attest(memcmp(cached, msg, dec_cached.size), equals(0));
+    attest(memcmp(uncached, msg, dec_uncached.size), equals(0));
+}
+
+
+Describe(pbaes256);
+
+
+BeforeEach(pbaes256) {
+    m_cache = pbaes256_cache_alloc(m_key);
+    attest(m_cache, differs(NULL));
+}
+
+
+AfterEach(pbaes256) {
+    pbaes256_cache_free(m_cache);
+}
+
+
+Ensure(pbaes256, cached_encryption_matches_uncached) {
+    uint8_t enc[256];
+    size_t  i;
+
+    for (i = 0; i < MSGS; ++i) {
+        size_t len = encrypt_both_ways(m_msg[i], m_iv, enc);
+        attest(len, equals((strlen(m_msg[i]) / 16 + 1) * 16));
+    }
+}
+
+
+Ensure(pbaes256, cached_decryption_matches_uncached) {
+    size_t i;
+
+    for (i = 0; i < MSGS; ++i) {
+        uint8_t         enc[256];
+        pubnub_bymebl_t data;
+        data.ptr  = enc;
+        data.size = encrypt_both_ways(m_msg[i], m_iv, enc);
+        decrypt_both_ways(data, m_iv, m_msg[i]);
+    }
+}
+
+
+Ensure(pbaes256, cache_is_reset_between_messages) {
+    uint8_t         first[256];
+    uint8_t         again[256];
+    pubnub_bymebl_t data;
+    size_t          len;
+
+    /* The same message, after other messages, with another IV in
+       between, is encrypted the same */
+    len = encrypt_both_ways(m_msg[5], m_iv, first);
+    encrypt_both_ways(m_msg[1], m_other_iv, again);
+    encrypt_both_ways(m_msg[4], m_iv, again);
+    attest(encrypt_both_ways(m_msg[5], m_iv, again), equals(len));
+    attest(memcmp(first, again, len), equals(0));
+
+    /* Switching to decryption and back */
+    data.ptr  = first;
+    data.size = len;
+    decrypt_both_ways(data, m_iv, m_msg[5]);
+    encrypt_both_ways(m_msg[5], m_iv, again);
+    attest(memcmp(first, again, len), equals(0));
+    decrypt_both_ways(data, m_iv, m_msg[5]);
+}
+
+
+Ensure(pbaes256, cache_recovers_from_failed_decryption) {
+    uint8_t         enc[256];
+    uint8_t         garbage[32];
+    uint8_t         dec[256];
+    pubnub_bymebl_t data;
+    pubnub_bymebl_t bad = { garbage, sizeof garbage };
+    pubnub_bymebl_t out = { dec, sizeof dec };
+
+    data.ptr  = enc;
+    data.size = encrypt_both_ways(m_msg[5], m_iv, enc);
+    decrypt_both_ways(data, m_iv, m_msg[5]);
+
+    /* Bad padding makes the decryption fail at the very end */
+    memset(garbage, 0xA5, sizeof garbage);
+    attest(pbaes256_decrypt_cached(m_cache, bad, m_iv, &out), equals(-1));
+
+    decrypt_both_ways(data, m_iv, m_msg[5]);
+}
+
+
+Ensure(pbaes256, checks_room) {
+    uint8_t         buf[32];
+    pubnub_bymebl_t small = { buf, 16 };
+
+    attest(pbaes256_encrypt_cached(m_cache, as_mebl(m_msg[1]), m_iv, &small), equals(-1));
+    small.size = 16;
+    attest(pbaes256_decrypt_cached(m_cache, as_mebl("0123456789abcdef"), m_iv, &small), equals(-1));
+}
+
+
+static void* encrypt_many(void* arg)
+{
+    int  i;
+    int* failed = (int*)arg;
+
+    for (i = 0; i < 200; ++i) {
+        char const*     msg = m_msg[i % MSGS];
+        uint8_t         enc[256];
+        uint8_t         dec[256];
+        uint8_t         expected[256];
+        pubnub_bymebl_t e   = { enc, sizeof enc };
+        pubnub_bymebl_t x   = { expected, sizeof expected };
+        pubnub_bymebl_t d   = { dec, sizeof dec };
+
+        if ((pbaes256_encrypt_cached(m_cache, as_mebl(msg), m_iv, &e) != 0)
+            || (pbaes256_encrypt(as_mebl(msg), m_key, m_iv, &x) != 0)
+            || (e.size != x.size) || (memcmp(enc, expected, e.size) != 0)
+            || (pbaes256_decrypt_cached(m_cache, e, m_iv, &d) != 0)
+            || (d.size != strlen(msg)) || (memcmp(dec, msg, d.size) != 0)) {
+            ++*failed;
+        }
+    }
+    return NULL;
+}
+
+
+Ensure(pbaes256, more_threads_than_cached_contexts) {
+    pthread_t thread[2 * PBAES256_CACHED_CONTEXTS];
+    int       failed[2 * PBAES256_CACHED_CONTEXTS] = { 0 };
+    int       i;
+
+    for (i = 0; i < 2 * PBAES256_CACHED_CONTEXTS; ++i) {
+        attest(pthread_create(&thread[i], NULL, encrypt_many, &failed[i]), equals(0));
+    }
+    for (i = 0; i < 2 * PBAES256_CACHED_CONTEXTS; ++i) {
+        attest(pthread_join(thread[i], NULL), equals(0));
+        attest(failed[i], equals(0));
+    }
+}
@@ -118,6 +118,7 @@ enum pubnub_res pbgzip_decompress(pubnub_t *pb)
     const uint8_t* data = (uint8_t*)pb->core.http_reply; 
     size_t size = (size_t)pb->core.http_buf_len;
     uint32_t unpacked_size;
+    enum pubnub_res result;
 
     if((size < (FIRST_TEN_RESERVED_BYTES + LAST_EIGHT_RESERVED_BYTES)) ||
        (data[0] != 0x1f) ||
@@ -144,12 +145,15 @@ enum pubnub_res pbgzip_decompress(pubnub_t *pb)
     unpacked_size |= (uint32_t)data[size - 3] << 8;
     unpacked_size |= (uint32_t)data[size - 2] << 16;
     unpacked_size |= (uint32_t)data[size - 1] << 24;
-//  Should be erased at some point
-    printf("Length before:%lu and after decompresion:%lu\n",
-           (long unsigned)size,
-           (long unsigned)unpacked_size);
-//
+    PUBNUB_LOG_TRACE("Length before:%lu and after decompresion:%lu\n",
+                     (long unsigned)size,
+                     (long unsigned)unpacked_size);
     size -= (FIRST_TEN_RESERVED_BYTES + LAST_EIGHT_RESERVED_BYTES);
-    return inflate_total(pb, data + FIRST_TEN_RESERVED_BYTES, size, (size_t)unpacked_size);
+    result = inflate_total(pb, data + FIRST_TEN_RESERVED_BYTES, size, (size_t)unpacked_size);
+    if (PNR_OK == result) {
+        PBMETRICS_ADD(pbmcGzipCompressedBytes, size + FIRST_TEN_RESERVED_BYTES + LAST_EIGHT_RESERVED_BYTES);
+        PBMETRICS_ADD(pbmcGzipDecompressedBytes, unpacked_size);
+    }
+    return result;
 }
 
@@ -45,10 +45,13 @@ static char const* get_next_key_value(char const* s, pubnub_chamebl_t *key, pubn
         for (esc = strstr(end, "\\\""); esc != NULL; esc = strstr(end, "\\\"")) {
             end = esc + 2;
         }
-        val->size = end - s + strcspn(end, "\"") + 1;
-        if (*s != '"') {
+        end += strcspn(end, "\"");
+        if (*end != '"') {
+            PUBNUB_LOG_ERROR("Unterminated quoted value in HTTP digest header: %s\n", s);
+            val->size = 0;
             return NULL;
         }
+        val->size = end - s + 1;
         s += val->size;
     }
     else {
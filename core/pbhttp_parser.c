@@ -0,0 +1,420 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "pbhttp_parser.h"
+
+#include "pubnub_assert.h"
+#include "pubnub_log.h"
+
+#include <string.h>
+#include <stdlib.h>
+
+
+/** Canonical names of the recognized headers, indexed by `enum
+    pbhttp_header_id`
+*/
+static char const* const m_header_name[] = {
+    "",
+    "Content-Length",
+    "Transfer-Encoding",
+    "Connection",
+    "Content-Encoding",
+    "Proxy-Authenticate"
+};
+
+/** Size of the perfect hash table for the recognized header names */
+#define HEADER_HASH_SIZE 5
+
+/** The perfect hash table of the recognized header names. The hash
+    is: (length + 3 * first_character) % HEADER_HASH_SIZE, on
+    lower-case name. If you add a header, make sure there are no
+    collisions (change the hash function if there are).
+*/
+static enum pbhttp_header_id const m_header_hash[HEADER_HASH_SIZE] = {
+    pbhttpHdrTransferEncoding,
+    pbhttpHdrContentLength,
+    pbhttpHdrConnection,
+    pbhttpHdrContentEncoding,
+    pbhttpHdrProxyAuthenticate
+};
+
+
+static char to_lower(char c)
+{
+    return ((c >= 'A') && (c <= 'Z')) ? (char)(c - 'A' + 'a') : c;
+}
+
+
+static int hex_digit(char c)
+{
+    if ((c >= '0') && (c <= '9')) {
+        return c - '0';
+    }
+    c = to_lower(c);
+    if ((c >= 'a') && (c <= 'f')) {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+
+/** Returns the ID of the header whose (lower-case) name was parsed */
+static enum pbhttp_header_id recognize_header(struct pbhttp_parser const* p)
+{
+    enum pbhttp_header_id id;
+    char const*           name;
+    unsigned              i;
+
+    if (p->pos >= sizeof p->name) {
+        return pbhttpHdrUnknown;
+    }
+    id   = m_header_hash[(p->pos + 3 * (unsigned char)p->name_first) % HEADER_HASH_SIZE];
+    name = m_header_name[id];
+    for (i = 0; i < p->pos; ++i) {
+        if (to_lower(name[i]) != p->name[i]) {
+            return pbhttpHdrUnknown;
+        }
+    }
+    return (name[i] == '\0') ? id : pbhttpHdrUnknown;
+}
+
+
+/** Returns whether (comma-separated) header @p value has the @p token
+    (in lower case), comparing case-insensitively.
+*/
+static int has_token(char const* value, char const* token)
+{
+    size_t const len = strlen(token);
+
+    for (; *value != '\0'; ++value) {
+        size_t i;
+        for (i = 0; (i < len) && (to_lower(value[i]) == token[i]); ++i) {
+            continue;
+        }
+        if (i == len) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+static void line_append(struct pbhttp_parser* p, char c)
+{
+    if (p->line_len < PBHTTP_MAX_HEADER_LINE) {
+        p->line[p->line_len++] = c;
+    }
+    else {
+        PUBNUB_LOG_ERROR("pbhttp_parse(p=%p): header line longer than %d\n",
+                         p,
+                         PBHTTP_MAX_HEADER_LINE);
+        p->line_too_long = 1;
+        p->state         = pbhttpError;
+    }
+}
+
+
+static void start_header_line(struct pbhttp_parser* p, char const* prefix)
+{
+    size_t len = strlen(prefix);
+    PUBNUB_ASSERT_OPT(len < PBHTTP_MAX_HEADER_LINE);
+    memcpy(p->line, prefix, len);
+    p->line_len  = len;
+    p->value_ofs = len;
+}
+
+
+static void header_line_done(struct pbhttp_parser* p)
+{
+    char const* value;
+
+    while ((p->line_len > p->value_ofs)
+           && ((p->line[p->line_len - 1] == ' ') || (p->line[p->line_len - 1] == '\t'))) {
+        --p->line_len;
+    }
+    p->line[p->line_len] = '\0';
+    value                = p->line + p->value_ofs;
+
+    switch (p->header) {
+    case pbhttpHdrContentLength:
+        p->content_length = strtoul(value, NULL, 10);
+        break;
+    case pbhttpHdrTransferEncoding:
+        p->chunked = has_token(value, "chunked");
+        break;
+    case pbhttpHdrConnection:
+        p->connection_close = has_token(value, "close");
+        break;
+    case pbhttpHdrContentEncoding:
+        p->gzip = has_token(value, "gzip");
+        break;
+    case pbhttpHdrProxyAuthenticate:
+        p->event = pbhttpEvHeader;
+        break;
+    default:
+        break;
+    }
+    p->state = pbhttpHeaderStart;
+}
+
+
+static void headers_end(struct pbhttp_parser* p)
+{
+    if (p->chunked) {
+        p->chunk_length = 0;
+        p->pos          = 0;
+        p->state        = pbhttpChunkLength;
+    }
+    else {
+        p->remaining = p->content_length;
+        p->state     = pbhttpBody;
+    }
+    p->event = pbhttpEvHeadersEnd;
+}
+
+
+static void chunk_length_done(struct pbhttp_parser* p)
+{
+    if (0 == p->pos) {
+        PUBNUB_LOG_ERROR("pbhttp_parse(p=%p): missing chunk length\n", p);
+        p->state = pbhttpError;
+    }
+    else if (0 == p->chunk_length) {
+        p->state = pbhttpDone;
+    }
+    else {
+        p->remaining = p->chunk_length;
+        p->state     = pbhttpChunkData;
+        p->event     = pbhttpEvChunk;
+    }
+}
+
+
+/** Parses one character of the status line, headers or chunk framing */
+static void parse_char(struct pbhttp_parser* p, char c)
+{
+    static char const http_ver[] = "HTTP/1.";
+
+    switch (p->state) {
+    case pbhttpStatusVersion:
+        if (p->pos < sizeof http_ver - 1) {
+            if (c != http_ver[p->pos]) {
+                p->state = pbhttpError;
+                break;
+            }
+        }
+        else if ((p->pos == sizeof http_ver - 1) ? ((c < '0') || (c > '9')) : (c != ' ')) {
+            p->state = pbhttpError;
+            break;
+        }
+        if (++p->pos > sizeof http_ver) {
+            p->pos   = 0;
+            p->state = pbhttpStatusCode;
+        }
+        break;
+    case pbhttpStatusCode:
+        if ((c < '0') || (c > '9')) {
+            p->state = pbhttpError;
+            break;
+        }
+        p->http_code = p->http_code * 10 + (c - '0');
+        if (++p->pos == 3) {
+            p->state = pbhttpStatusRest;
+        }
+        break;
+    case pbhttpStatusRest:
+    case pbhttpHeaderSkip:
+        if ('\n' == c) {
+            p->state = pbhttpHeaderStart;
+        }
+        break;
+    case pbhttpHeaderStart:
+        switch (c) {
+        case '\r':
+            p->state = pbhttpHeadersEndLF;
+            break;
+        case '\n':
+            headers_end(p);
+            break;
+        case ' ':
+        case '\t':
+            /* Continuation of the previous header line. We only need
+               it for the headers we give to the user. */
+            if (pbhttpHdrProxyAuthenticate == p->last_header) {
+                p->header = p->last_header;
+                start_header_line(p, " ");
+                p->state = pbhttpHeaderValueStart;
+            }
+            else {
+                p->state = pbhttpHeaderSkip;
+            }
+            break;
+        default:
+            p->name_first = p->name[0] = to_lower(c);
+            p->pos                     = 1;
+            p->state                   = pbhttpHeaderName;
+            break;
+        }
+        break;
+    case pbhttpHeaderName:
+        if (':' == c) {
+            p->header = p->last_header = recognize_header(p);
+            if (pbhttpHdrUnknown == p->header) {
+                p->state = pbhttpHeaderSkip;
+            }
+            else {
+                start_header_line(p, m_header_name[p->header]);
+                line_append(p, ':');
+                line_append(p, ' ');
+                p->value_ofs = p->line_len;
+                p->state     = pbhttpHeaderValueStart;
+            }
+        }
+        else if ('\n' == c) {
+            /* Not a header line, ignore it */
+            p->last_header = pbhttpHdrUnknown;
+            p->state       = pbhttpHeaderStart;
+        }
+        else {
+            if (p->pos < sizeof p->name) {
+                p->name[p->pos] = to_lower(c);
+            }
+            ++p->pos;
+        }
+        break;
+    case pbhttpHeaderValueStart:
+        if ((' ' == c) || ('\t' == c)) {
+            break;
+        }
+        p->state = pbhttpHeaderValue;
+        /* FALLTHRU */
+    case pbhttpHeaderValue:
+        if ('\n' == c) {
+            header_line_done(p);
+        }
+        else if (c != '\r') {
+            line_append(p, c);
+        }
+        break;
+    case pbhttpHeadersEndLF:
+        if ('\n' == c) {
+            headers_end(p);
+        }
+        else {
+            p->state = pbhttpError;
+        }
+        break;
+    case pbhttpChunkLength: {
+        int d = hex_digit(c);
+        if (d >= 0) {
+            if (p->chunk_length > (~0u >> 4)) {
+                PUBNUB_LOG_ERROR("pbhttp_parse(p=%p): chunk length too big\n", p);
+                p->state = pbhttpError;
+                break;
+            }
+            p->chunk_length = p->chunk_length * 16 + d;
+            ++p->pos;
+        }
+        else if ('\n' == c) {
+            chunk_length_done(p);
+        }
+        else if ((0 == p->pos) && ((' ' == c) || ('\t' == c))) {
+            /* Be lenient, skip whitespace before the length */
+        }
+        else if ((';' == c) || (' ' == c) || ('\t' == c) || ('\r' == c)) {
+            p->state = pbhttpChunkExtension;
+        }
+        else {
+            p->state = pbhttpError;
+        }
+        break;
+    }
+    case pbhttpChunkExtension:
+        if ('\n' == c) {
+            chunk_length_done(p);
+        }
+        break;
+    case pbhttpChunkDataEnd:
+        if ('\n' == c) {
+            p->chunk_length = 0;
+            p->pos          = 0;
+            p->state        = pbhttpChunkLength;
+        }
+        break;
+    default:
+        PUBNUB_ASSERT_OPT(0);
+        break;
+    }
+}
+
+
+void pbhttp_parser_init(struct pbhttp_parser* p)
+{
+    p->state            = pbhttpStatusVersion;
+    p->event            = pbhttpEvNone;
+    p->http_code        = 0;
+    p->content_length   = 0;
+    p->chunk_length     = 0;
+    p->remaining        = 0;
+    p->data             = NULL;
+    p->data_len         = 0;
+    p->chunked          = 0;
+    p->connection_close = 0;
+    p->gzip             = 0;
+    p->line_too_long    = 0;
+    p->header           = pbhttpHdrUnknown;
+    p->last_header      = pbhttpHdrUnknown;
+    p->pos              = 0;
+    p->line_len         = 0;
+    p->value_ofs        = 0;
+}
+
+
+size_t pbhttp_parse(struct pbhttp_parser* p, char const* data, size_t len)
+{
+    size_t i = 0;
+
+    PUBNUB_ASSERT_OPT(p != NULL);
+    PUBNUB_ASSERT_OPT((data != NULL) || (0 == len));
+
+    p->event = pbhttpEvNone;
+    while (pbhttpEvNone == p->event) {
+        switch (p->state) {
+        case pbhttpBody:
+        case pbhttpChunkData:
+            if (0 == p->remaining) {
+                if (pbhttpBody == p->state) {
+                    p->state = pbhttpDone;
+                }
+                else {
+                    p->state = pbhttpChunkDataEnd;
+                }
+                break;
+            }
+            if (i == len) {
+                return i;
+            }
+            p->data     = data + i;
+            p->data_len = len - i;
+            if (p->data_len > p->remaining) {
+                p->data_len = p->remaining;
+            }
+            p->remaining -= p->data_len;
+            i += p->data_len;
+            p->event = pbhttpEvBody;
+            break;
+        case pbhttpDone:
+            p->event = pbhttpEvDone;
+            break;
+        case pbhttpError:
+            p->event = pbhttpEvError;
+            break;
+        default:
+            if (i == len) {
+                return i;
+            }
+            parse_char(p, data[i++]);
+            break;
+        }
+    }
+
+    return i;
+}
@@ -0,0 +1,175 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PBHTTP_PARSER
+#define INC_PBHTTP_PARSER
+
+#include <stddef.h>
+
+
+/** @file pbhttp_parser.h
+
+    An incremental (resumable) parser of HTTP/1.1 responses. It is fed
+    the data as it is received and parses the status line, headers and
+    body (with chunk framing, if any) in one pass, without needing the
+    data it has consumed to be kept around. Thus a header line, or a
+    chunk length line, may be split among any number of receives.
+
+    Parsing stops at each "event" that the user (our HTTP FSM) has to
+    handle (end of headers, some data of the body, etc). After the
+    event is handled, parsing should be resumed on the rest of the
+    data.
+
+    Header names are recognized case-insensitively, by a perfect hash
+    of the (few) headers that are of interest to us. Other headers are
+    skipped, regardless of their length.
+*/
+
+
+/** Maximum length of a recognized header line that the parser keeps,
+    (only) for the user to process. A longer line is an error (and
+    `line_too_long` is set), as a truncated one could be taken for a
+    valid, but different, header.
+*/
+#if !defined PBHTTP_MAX_HEADER_LINE
+#define PBHTTP_MAX_HEADER_LINE 1024
+#endif
+
+
+/** The headers recognized by the parser */
+enum pbhttp_header_id {
+    pbhttpHdrUnknown,
+    pbhttpHdrContentLength,
+    pbhttpHdrTransferEncoding,
+    pbhttpHdrConnection,
+    pbhttpHdrContentEncoding,
+    pbhttpHdrProxyAuthenticate
+};
+
+
+/** Events that the parser stops at */
+enum pbhttp_event {
+    /** No event, all data was consumed, need more */
+    pbhttpEvNone,
+    /** Got a header that the user has to process itself (at this
+        time, that's only `Proxy-Authenticate`, with its continuation
+        lines). It's available in `line`. */
+    pbhttpEvHeader,
+    /** End of the headers. All information gathered from the status
+        line and the headers is available. */
+    pbhttpEvHeadersEnd,
+    /** Start of a chunk of `chunk_length` octets (chunked body only) */
+    pbhttpEvChunk,
+    /** Some (`data_len` octets) of the body, at `data` */
+    pbhttpEvBody,
+    /** Whole body received */
+    pbhttpEvDone,
+    /** Invalid (or unsupported) response */
+    pbhttpEvError
+};
+
+
+/** State of the parser */
+enum pbhttp_parser_state {
+    pbhttpStatusVersion,
+    pbhttpStatusCode,
+    pbhttpStatusRest,
+    pbhttpHeaderStart,
+    pbhttpHeaderName,
+    pbhttpHeaderValueStart,
+    pbhttpHeaderValue,
+    pbhttpHeaderSkip,
+    pbhttpHeadersEndLF,
+    pbhttpBody,
+    pbhttpChunkLength,
+    pbhttpChunkExtension,
+    pbhttpChunkData,
+    pbhttpChunkDataEnd,
+    pbhttpDone,
+    pbhttpError
+};
+
+
+/** The HTTP response parser.
+
+    @note Like in the Pubnub context, don't declare any members as
+    `bool`.
+*/
+struct pbhttp_parser {
+    enum pbhttp_parser_state state;
+
+    /** The last event */
+    enum pbhttp_event event;
+
+    /** HTTP status code */
+    unsigned http_code;
+
+    /** Value of the `Content-Length` header (0 if none) */
+    unsigned content_length;
+
+    /** Length of the chunk (on pbhttpEvChunk) */
+    unsigned chunk_length;
+
+    /** Octets of body (or chunk) still to receive */
+    unsigned remaining;
+
+    /** Body data (on pbhttpEvBody), points into the data given to
+        pbhttp_parse(), so valid only until that data is changed.
+    */
+    char const* data;
+
+    /** Length of body data at `data` */
+    size_t data_len;
+
+    /** Response has `Transfer-Encoding: chunked` */
+    unsigned chunked : 1;
+    /** Response has `Connection: close` */
+    unsigned connection_close : 1;
+    /** Response has `Content-Encoding: gzip` */
+    unsigned gzip : 1;
+    /** A recognized header line was longer than
+        #PBHTTP_MAX_HEADER_LINE (on pbhttpEvError) */
+    unsigned line_too_long : 1;
+
+    /** Header being parsed */
+    enum pbhttp_header_id header;
+    /** The last recognized header, for continuation lines */
+    enum pbhttp_header_id last_header;
+
+    /** Position in the status line or length of header name so far */
+    unsigned pos;
+    /** The first character of the header name (lower-case) */
+    char name_first;
+    /** The header name so far (lower-case), if short enough to be
+        one of the recognized ones */
+    char name[20];
+
+    /** Recognized header line, in canonical form, like
+        `Content-Length: 42`, or ` continuation`. NUL-terminated
+        when a header line is done. */
+    char line[PBHTTP_MAX_HEADER_LINE + 1];
+    /** Length of `line` */
+    unsigned line_len;
+    /** Offset of the value in `line` */
+    unsigned value_ofs;
+};
+
+
+/** Prepares the parser @p p for parsing a new response */
+void pbhttp_parser_init(struct pbhttp_parser* p);
+
+/** Parses (at most) @p len octets of response data at @p data,
+    stopping at the first event reached, which is then in `p->event`
+    (pbhttpEvNone if all data was consumed without reaching one).
+    Some events (like pbhttpEvDone) may be reached with no data at
+    all (@p len == 0).
+
+    @return Number of octets consumed. The rest of the data should be
+    parsed after the event is handled.
+ */
+size_t pbhttp_parse(struct pbhttp_parser* p, char const* data, size_t len);
+
+/** Returns whether the parser @p p has parsed any of the response */
+#define pbhttp_parser_started(p)                                           \
+    (((p)->state != pbhttpStatusVersion) || ((p)->pos > 0))
+
+
+#endif /* !defined INC_PBHTTP_PARSER */
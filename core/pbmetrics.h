@@ -0,0 +1,42 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PBMETRICS
+#define INC_PBMETRICS
+
+
+/** @file pbmetrics.h
+
+    Updating of the metrics, for the "Metrics" API
+    (pubnub_metrics.h). The hot paths of the Pubnub C-core update the
+    metrics via the PBMETRICS_ADD(), PBMETRICS_GAUGE_SET() and
+    PBMETRICS_OBSERVE() macros, which don't do anything if
+    PUBNUB_METRICS is 0.
+ */
+
+
+#if PUBNUB_METRICS
+
+#include "core/pubnub_metrics.h"
+
+/** Adds @p n to the @p counter */
+void pbmetrics_add(enum pubnub_metrics_counter counter, uint64_t n);
+
+/** Sets the @p gauge to @p value */
+void pbmetrics_gauge_set(enum pubnub_metrics_gauge gauge, int64_t value);
+
+/** Observes the @p value in the @p histogram */
+void pbmetrics_observe(enum pubnub_metrics_histogram histogram, uint64_t value);
+
+#define PBMETRICS_ADD(counter, n) pbmetrics_add((counter), (n))
+#define PBMETRICS_GAUGE_SET(gauge, value) pbmetrics_gauge_set((gauge), (value))
+#define PBMETRICS_OBSERVE(histogram, value) pbmetrics_observe((histogram), (value))
+
+#else
+
+#define PBMETRICS_ADD(counter, n)
+#define PBMETRICS_GAUGE_SET(gauge, value)
+#define PBMETRICS_OBSERVE(histogram, value)
+
+#endif /* PUBNUB_METRICS */
+
+
+#endif /* !defined INC_PBMETRICS */
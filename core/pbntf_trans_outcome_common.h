@@ -24,5 +24,6 @@
         default:                                                                   \
             break;                                                                 \
         }                                                                          \
+        PBTIMINGS_MARK(M_pb_, pbtpOutcome);                                        \
         M_pb_->state = state;                                                      \
     } while (0)
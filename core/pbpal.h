@@ -100,77 +100,39 @@ int pbpal_send_str(pubnub_t *pb, char const *s);
 */
 int pbpal_send_status(pubnub_t *pb);
 
-/** Starts reading a line from the TCP connection. In other words,
-    reading until it finds a newline character. In general, it's used
-    to read HTTP response header lines.
+/** Starts reading the HTTP response from the TCP connection. The
+    response is parsed (status line, headers and chunk framing) as it
+    is received, in one pass over the received data, by the
+    incremental HTTP parser (`pb->http_parser`).
 
-    @precondition Previous read (or write) on the context was finished
-
-    @param pb The Pubnub context of the connection
-
-    @return 0: newline read, else: not yet, try again later
-*/
-int pbpal_start_read_line(pubnub_t *pb);
-
-/** Returns the status of reading a line. Line reading was
-    started with pbpal_start_read_line().
-
-    @param pb The Pubnub context to get line reading status for
-
-    @retval PNR_IN_PROGRESS reading a line not over/done yet
-
-    @retval PNR_TX_BUFFER_TOO_SMALL Well, it's not the _TX_ buffer,
-    but, it's the same buffer and we don't want to add a new `PNR`
-    just for internal purposes. Client may examine the contents of the
-    buffer for some further processing and can continue reading (with
-    the current buffer contents dropped) by calling
-    pbpal_start_read_line().
-
-    @retval PNR_OK Reading a line done (newline char found)
-
-    @retval otherwise The error that happened during the reading
-*/
-enum pubnub_res pbpal_line_read_status(pubnub_t *pb);
-
-/** Returns the length of the data in the receive buffer
-    at this time.
-*/
-int pbpal_read_len(pubnub_t *pb);
-
-/** Starts reading a given number of octets (bytes) from an
-    established TCP connection. Only one reading can take place at any
-    given time.
-
-    To check if reading is complete, call pbpal_read_status().
+    To get the next parsing event, call pbpal_read_response_status().
 
     @precondition Previous read (or write) on the context was finished
 
     @param pb The Pubnub context of an established TCP connection
-    @param n Number of octets (bytes) to read
     @return 0: OK (started), -1: error (reading already started)
 */
-int pbpal_start_read(pubnub_t *pb, size_t n);
+int pbpal_start_read_response(pubnub_t *pb);
 
-/** Returns the status of reading a chunk of data. In general, it's
-    used to receive the body (or chunk of it) of the HTTP response.
+/** Returns the status of reading the HTTP response, started with
+    pbpal_start_read_response(). Parses the data that was already
+    received (but not yet parsed) and, if that doesn't yield a
+    parsing event, receives more data and parses it.
 
-    @param pb The Pubnub context for which to get the current read
-    (chunk) status
+    @param pb The Pubnub context for which to get the response reading
+    status
 
-    @retval PNR_IN_PROGRESS reading a chunk not over/done yet (AKA
-    "call me later")
+    @retval PNR_IN_PROGRESS no parsing event yet (AKA "call me later")
+
+    @retval PNR_OK A parsing event was reached, it is available in
+    `pb->http_parser.event` (along with the information it pertains
+    to). Client needs to handle it (copy body data, for example)
+    before calling this function again. On `pbhttpEvDone` and
+    `pbhttpEvError`, reading the response is over.
 
-    @retval PNR_OK Reading a chunk done - it _doesn't_ mean that
-    all of the `n` octets from the pbpal_start_read() were read.
-    It just means that we have read _some_ data and "client" needs
-    to use it somehow (copy, probably). The amout of octets 
-    actually read client can get by calling pbpal_read_len(). 
-    If not all data was read, client should call pbpal_start_read()
-    with `n = old n - pbpal_read_len()`.
-    
     @retval otherwise The error that happened during the reading
 */
-enum pubnub_res pbpal_read_status(pubnub_t *pb);
+enum pubnub_res pbpal_read_response_status(pubnub_t *pb);
 
 /** Returns whether for the given Pubnub context the TCP
     connection has closed.
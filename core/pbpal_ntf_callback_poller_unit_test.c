@@ -0,0 +1,224 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "cgreen/cgreen.h"
+#include "cgreen/mocks.h"
+
+#include "pubnub_internal.h"
+
+#include "core/pbpal_ntf_callback_poller.h"
+#include "core/pubnub_assert.h"
+#include "pubnub_get_native_socket.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+
+
+/* This test is built for each of the pollers (poll(), io_uring...),
+   to check that they behave the same.
+*/
+
+
+/* A less chatty cgreen :) */
+
+#define attest assert_that
+#define equals is_equal_to
+#define streqs is_equal_to_string
+#define differs is_not_equal_to
+#define strdifs is_not_equal_to_string
+#define ptreqs(val) is_equal_to_contents_of(&(val), sizeof(val))
+#define ptrdifs(val) is_not_equal_to_contents_of(&(val), sizeof(val))
+#define sets(par, val) will_set_contents_of_parameter(par, &(val), sizeof(val))
+#define sets_ex will_set_contents_of_parameter
+#define returns will_return
+
+
+enum { CONTEXTS = 3 };
+
+/** The poller only needs the contexts' addresses, it gets their
+    sockets via pubnub_get_native_socket() */
+static char m_ctx[CONTEXTS];
+
+/** The socket of each context, and its peer, where we write to make
+    the socket readable */
+static int m_socket[CONTEXTS];
+static int m_peer[CONTEXTS];
+
+/** How many times each context was queued for processing */
+static int m_requeued[CONTEXTS];
+
+static struct pbpal_poll_data* m_poller;
+
+
+static pubnub_t* ctx(int i)
+{
+    return (pubnub_t*)(m_ctx + i);
+}
+
+
+static int ctx_index(pubnub_t* pb)
+{
+    int i = (int)((char*)pb - m_ctx);
+    PUBNUB_ASSERT_OPT((i >= 0) && (i < CONTEXTS));
+    return i;
+}
+
+
+pbpal_native_socket_t pubnub_get_native_socket(pubnub_t* pb)
+{
+    return m_socket[ctx_index(pb)];
+}
+
+
+int pbntf_requeue_for_processing(pubnub_t* pb)
+{
+    ++m_requeued[ctx_index(pb)];
+    return 0;
+}
+
+
+static void make_readable(int i)
+{
+    attest(write(m_peer[i], "x", 1), equals(1));
+}
+
+
+static void swap(int* a, int* b)
+{
+    int t = *a;
+    *a    = *b;
+    *b    = t;
+}
+
+
+static void drain(int i)
+{
+    char c;
+    attest(read(m_socket[i], &c, 1), equals(1));
+}
+
+
+Describe(pbpal_ntf_callback_poller);
+
+
+BeforeEach(pbpal_ntf_callback_poller) {
+    int i;
+    for (i = 0; i < CONTEXTS; ++i) {
+        int sv[2];
+        attest(socketpair(AF_UNIX, SOCK_STREAM, 0, sv), equals(0));
+        m_socket[i]   = sv[0];
+        m_peer[i]     = sv[1];
+        m_requeued[i] = 0;
+    }
+    m_poller = pbpal_ntf_callback_poller_init();
+    attest(m_poller, differs(NULL));
+}
+
+
+AfterEach(pbpal_ntf_callback_poller) {
+    int i;
+    if (m_poller != NULL) {
+        pbpal_ntf_callback_poller_deinit(&m_poller);
+    }
+    for (i = 0; i < CONTEXTS; ++i) {
+        close(m_socket[i]);
+        close(m_peer[i]);
+    }
+}
+
+
+Ensure(pbpal_ntf_callback_poller, nothing_to_do_without_sockets) {
+    attest(pbpal_ntf_poll_away(m_poller, 10), equals(0));
+}
+
+
+Ensure(pbpal_ntf_callback_poller, saved_socket_is_watched_for_out) {
+    pbpal_ntf_callback_save_socket(m_poller, ctx(0));
+    attest(pbpal_ntf_poll_away(m_poller, 100), equals(1));
+    attest(m_requeued[0], equals(1));
+}
+
+
+Ensure(pbpal_ntf_callback_poller, in_events_reported_only_when_readable) {
+    pbpal_ntf_callback_save_socket(m_poller, ctx(0));
+    pbpal_ntf_callback_save_socket(m_poller, ctx(1));
+    attest(pbpal_ntf_watch_in_events(m_poller, ctx(0)), equals(0));
+    attest(pbpal_ntf_watch_in_events(m_poller, ctx(1)), equals(0));
+
+    attest(pbpal_ntf_poll_away(m_poller, 10), equals(0));
+
+    make_readable(1);
+    attest(pbpal_ntf_poll_away(m_poller, 100), equals(1));
+    attest(m_requeued[0], equals(0));
+    attest(m_requeued[1], equals(1));
+
+    /* Reported again while there is something to read */
+    attest(pbpal_ntf_poll_away(m_poller, 100), equals(1));
+    attest(m_requeued[1], equals(2));
+
+    drain(1);
+    attest(pbpal_ntf_poll_away(m_poller, 10), equals(0));
+    attest(m_requeued[1], equals(2));
+}
+
+
+Ensure(pbpal_ntf_callback_poller, switches_between_in_and_out) {
+    pbpal_ntf_callback_save_socket(m_poller, ctx(0));
+    attest(pbpal_ntf_watch_in_events(m_poller, ctx(0)), equals(0));
+    attest(pbpal_ntf_poll_away(m_poller, 10), equals(0));
+
+    attest(pbpal_ntf_watch_out_events(m_poller, ctx(0)), equals(0));
+    attest(pbpal_ntf_poll_away(m_poller, 100), equals(1));
+    attest(m_requeued[0], equals(1));
+}
+
+
+Ensure(pbpal_ntf_callback_poller, removed_socket_is_not_watched) {
+    pbpal_ntf_callback_save_socket(m_poller, ctx(0));
+    pbpal_ntf_callback_save_socket(m_poller, ctx(1));
+    attest(pbpal_ntf_watch_in_events(m_poller, ctx(0)), equals(0));
+    attest(pbpal_ntf_watch_in_events(m_poller, ctx(1)), equals(0));
+    attest(pbpal_ntf_poll_away(m_poller, 10), equals(0));
+
+    pbpal_ntf_callback_remove_socket(m_poller, ctx(0));
+    make_readable(0);
+    make_readable(1);
+    attest(pbpal_ntf_poll_away(m_poller, 100), equals(1));
+    attest(m_requeued[0], equals(0));
+    attest(m_requeued[1], equals(1));
+
+    attest(pbpal_ntf_watch_in_events(m_poller, ctx(0)), equals(-1));
+}
+
+
+Ensure(pbpal_ntf_callback_poller, follows_updated_socket) {
+    pbpal_ntf_callback_save_socket(m_poller, ctx(0));
+    attest(pbpal_ntf_watch_in_events(m_poller, ctx(0)), equals(0));
+    attest(pbpal_ntf_poll_away(m_poller, 10), equals(0));
+
+    /* As if the context re-connected, on the socket of context 2 */
+    swap(m_socket + 0, m_socket + 2);
+    swap(m_peer + 0, m_peer + 2);
+    pbpal_ntf_callback_update_socket(m_poller, ctx(0));
+
+    make_readable(2);
+    attest(pbpal_ntf_poll_away(m_poller, 10), equals(0));
+    make_readable(0);
+    attest(pbpal_ntf_poll_away(m_poller, 100), equals(1));
+    attest(m_requeued[0], equals(1));
+}
+
+
+Ensure(pbpal_ntf_callback_poller, reports_hang_up) {
+    pbpal_ntf_callback_save_socket(m_poller, ctx(0));
+    attest(pbpal_ntf_watch_in_events(m_poller, ctx(0)), equals(0));
+    attest(pbpal_ntf_poll_away(m_poller, 10), equals(0));
+
+    close(m_peer[0]);
+    m_peer[0] = socket(AF_UNIX, SOCK_STREAM, 0);
+    attest(pbpal_ntf_poll_away(m_poller, 100), equals(1));
+    attest(m_requeued[0], equals(1));
+}
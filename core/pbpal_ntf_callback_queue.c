@@ -6,6 +6,11 @@
 #include "pubnub_assert.h"
 
 
+/** Number of contexts in the @p queue */
+#define QUEUE_DEPTH(queue)                                                 \
+    (((queue)->head + (queue)->size - (queue)->tail) % (queue)->size)
+
+
 void pbpal_ntf_callback_queue_init(struct pbpal_ntf_callback_queue* queue)
 {
     pubnub_mutex_init(queue->monitor);
@@ -39,6 +44,7 @@ int pbpal_ntf_callback_enqueue_for_processing(struct pbpal_ntf_callback_queue* q
         queue->apb[queue->head] = pb;
         queue->head             = next_head;
         result                  = +1;
+        PBMETRICS_GAUGE_SET(pbmgCallbackQueueDepth, QUEUE_DEPTH(queue));
     }
     else {
         result = -1;
@@ -91,6 +97,20 @@ void pbpal_ntf_callback_remove_from_queue(struct pbpal_ntf_callback_queue* queue
 }
 
 
+bool pbpal_ntf_callback_queue_empty(struct pbpal_ntf_callback_queue* queue)
+{
+    bool rslt;
+
+    PUBNUB_ASSERT_OPT(queue != NULL);
+
+    pubnub_mutex_lock(queue->monitor);
+    rslt = (queue->head == queue->tail);
+    pubnub_mutex_unlock(queue->monitor);
+
+    return rslt;
+}
+
+
 void pbpal_ntf_callback_process_queue(struct pbpal_ntf_callback_queue* queue)
 {
     pubnub_mutex_lock(queue->monitor);
@@ -99,6 +119,7 @@ void pbpal_ntf_callback_process_queue(struct pbpal_ntf_callback_queue* queue)
         if (queue->tail == queue->size) {
             queue->tail = 0;
         }
+        PBMETRICS_GAUGE_SET(pbmgCallbackQueueDepth, QUEUE_DEPTH(queue));
         if (pbp != NULL) {
             pubnub_mutex_unlock(queue->monitor);
             pubnub_mutex_lock(pbp->monitor);
@@ -4,6 +4,8 @@
 
 #include "pubnub_mutex.h"
 
+#include <stdbool.h>
+
 
 /** @file pbpal_ntf_callback_queue.h
 
@@ -59,6 +61,11 @@ void pbpal_ntf_callback_remove_from_queue(struct pbpal_ntf_callback_queue* queue
                                           pubnub_t*                        pb);
 
 
+/** Returns whether the @p queue is empty (has no contexts to
+    process). */
+bool pbpal_ntf_callback_queue_empty(struct pbpal_ntf_callback_queue* queue);
+
+
 /** Process all the context in the @p queue. */
 void pbpal_ntf_callback_process_queue(struct pbpal_ntf_callback_queue* queue);
 
@@ -0,0 +1,57 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PBPAL_SPOOL
+#define INC_PBPAL_SPOOL
+
+
+#include <stdbool.h>
+#include <stddef.h>
+
+
+/** @file pbpal_spool.h
+    The "PAL" of the publish spool - mapping of the spool file and a
+    few helpers for the drainer. Each platform that supports the
+    spool has to implement these.
+*/
+
+
+/** A mapped spool file */
+struct pbpal_spool_file {
+    /** Start of the mapped file */
+    char* addr;
+    /** Size of the mapped file, in bytes */
+    size_t size;
+    /** Platform-specific handle of the (open) file */
+    long handle;
+};
+
+
+/** Opens (creating, if needed) the file at @p path, locks it for
+    exclusive use of this process and maps it in memory. If the file
+    is empty, it is first resized to @p size bytes.
+
+    @param path The path of the file
+    @param size The size of the file to create
+    @param file The mapped file, set on success
+    @param created Set to true if the file was created (resized)
+    @return 0: OK, -1: error
+ */
+int pbpal_spool_map(char const*              path,
+                    size_t                   size,
+                    struct pbpal_spool_file* file,
+                    bool*                    created);
+
+/** Unmaps and closes the (mapped) @p file */
+void pbpal_spool_unmap(struct pbpal_spool_file* file);
+
+/** Writes the mapped @p file out to disk. If @p wait, waits for the
+    write to finish. @return 0: OK, -1: error */
+int pbpal_spool_sync(struct pbpal_spool_file const* file, bool wait);
+
+/** Returns the value of a monotonic clock, in milliseconds */
+unsigned long pbpal_spool_clock_ms(void);
+
+/** Sleeps for @p ms milliseconds */
+void pbpal_spool_sleep_ms(unsigned long ms);
+
+
+#endif /* !defined INC_PBPAL_SPOOL */
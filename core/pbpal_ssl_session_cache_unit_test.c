@@ -0,0 +1,158 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "cgreen/cgreen.h"
+#include "cgreen/mocks.h"
+
+#include "pbpal_ssl_session_cache.h"
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+
+
+/* A less chatty cgreen :) */
+
+#define attest assert_that
+#define equals is_equal_to
+#define streqs is_equal_to_string
+#define differs is_not_equal_to
+#define strdifs is_not_equal_to_string
+#define ptreqs(val) is_equal_to_contents_of(&(val), sizeof(val))
+#define ptrdifs(val) is_not_equal_to_contents_of(&(val), sizeof(val))
+#define sets(par, val) will_set_contents_of_parameter(par, &(val), sizeof(val))
+#define sets_ex will_set_contents_of_parameter
+#define returns will_return
+
+
+static SSL_CTX* m_ctx;
+
+
+/** Returns a new SSL with a new (empty) session, as if it completed
+    a handshake. */
+static SSL* negotiated_ssl(void)
+{
+    SSL*         ssl     = SSL_new(m_ctx);
+    SSL_SESSION* session = SSL_SESSION_new();
+    SSL_set_session(ssl, session);
+    SSL_SESSION_free(session);
+    return ssl;
+}
+
+
+/** Returns the session that the cache set to be resumed for @p origin
+    on a new SSL, NULL if none. */
+static SSL_SESSION* resumed(char const* origin)
+{
+    SSL*         ssl = SSL_new(m_ctx);
+    SSL_SESSION* rslt;
+    pbpal_ssl_session_cache_resume(ssl, origin);
+    rslt = SSL_get_session(ssl);
+    SSL_free(ssl);
+    return rslt;
+}
+
+
+static char const* origin_no(int i)
+{
+    static char origin[32];
+    snprintf(origin, sizeof origin, "ps%d.pndsn.com", i);
+    return origin;
+}
+
+
+Describe(pbpal_ssl_session_cache);
+
+
+BeforeEach(pbpal_ssl_session_cache) {
+    m_ctx = SSL_CTX_new(SSLv23_client_method());
+}
+
+
+AfterEach(pbpal_ssl_session_cache) {
+    int i;
+    pbpal_ssl_session_cache_drop("ps.pndsn.com");
+    for (i = 0; i <= PUBNUB_SSL_SESSION_CACHE_SIZE; ++i) {
+        pbpal_ssl_session_cache_drop(origin_no(i));
+    }
+    SSL_CTX_free(m_ctx);
+}
+
+
+Ensure(pbpal_ssl_session_cache, nothing_to_resume_for_unknown_origin) {
+    attest(resumed("ps.pndsn.com"), equals(NULL));
+}
+
+
+Ensure(pbpal_ssl_session_cache, resumes_stored_session) {
+    SSL* ssl = negotiated_ssl();
+
+    pbpal_ssl_session_cache_store(ssl, "ps.pndsn.com");
+    attest(resumed("ps.pndsn.com"), equals(SSL_get_session(ssl)));
+    attest(resumed("ps1.pndsn.com"), equals(NULL));
+
+    /* The cache keeps its own reference */
+    SSL_free(ssl);
+    attest(resumed("ps.pndsn.com"), differs(NULL));
+}
+
+
+Ensure(pbpal_ssl_session_cache, store_replaces_session_of_same_origin) {
+    SSL* first  = negotiated_ssl();
+    SSL* second = negotiated_ssl();
+
+    pbpal_ssl_session_cache_store(first, "ps.pndsn.com");
+    pbpal_ssl_session_cache_store(second, "ps.pndsn.com");
+    attest(resumed("ps.pndsn.com"), equals(SSL_get_session(second)));
+
+    SSL_free(first);
+    SSL_free(second);
+}
+
+
+Ensure(pbpal_ssl_session_cache, drop_invalidates_after_failure) {
+    SSL* ssl = negotiated_ssl();
+
+    pbpal_ssl_session_cache_store(ssl, "ps.pndsn.com");
+    pbpal_ssl_session_cache_drop("ps.pndsn.com");
+    attest(resumed("ps.pndsn.com"), equals(NULL));
+
+    /* Dropping again, or an unknown origin, is harmless */
+    pbpal_ssl_session_cache_drop("ps.pndsn.com");
+    pbpal_ssl_session_cache_drop("ps1.pndsn.com");
+
+    /* and the next successful handshake is shared again */
+    pbpal_ssl_session_cache_store(ssl, "ps.pndsn.com");
+    attest(resumed("ps.pndsn.com"), equals(SSL_get_session(ssl)));
+
+    SSL_free(ssl);
+}
+
+
+Ensure(pbpal_ssl_session_cache, replaces_oldest_origin_when_full) {
+    SSL* ssl = negotiated_ssl();
+    int  i;
+
+    for (i = 0; i <= PUBNUB_SSL_SESSION_CACHE_SIZE; ++i) {
+        pbpal_ssl_session_cache_store(ssl, origin_no(i));
+    }
+    attest(resumed(origin_no(0)), equals(NULL));
+    for (i = 1; i <= PUBNUB_SSL_SESSION_CACHE_SIZE; ++i) {
+        attest(resumed(origin_no(i)), equals(SSL_get_session(ssl)));
+    }
+
+    SSL_free(ssl);
+}
+
+
+Ensure(pbpal_ssl_session_cache, does_not_cache_too_long_origin) {
+    SSL* ssl = negotiated_ssl();
+    char origin[PBPAL_SSL_SESSION_ORIGIN_MAXLEN + 2];
+
+    memset(origin, 'a', sizeof origin - 1);
+    origin[sizeof origin - 1] = '\0';
+    pbpal_ssl_session_cache_store(ssl, origin);
+    attest(resumed(origin), equals(NULL));
+
+    SSL_free(ssl);
+}
@@ -0,0 +1,78 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PBTIMINGS
+#define INC_PBTIMINGS
+
+
+#include <stdint.h>
+
+
+/** @file pbtimings.h
+
+    Recording of the timings of the phases of a transaction, for the
+    "Transaction timings" API (pubnub_transaction_timings.h). The
+    net-core FSM and the PAL mark the boundaries of the phases via
+    the PBTIMINGS_MARK() and PBTIMINGS_MARK_ONCE() macros, which
+    don't do anything if PUBNUB_TRANSACTION_TIMINGS is 0.
+ */
+
+
+/** The points in a transaction at which (monotonic) time is
+    recorded. They are in the order in which they happen in a
+    transaction.
+ */
+enum pbtimings_point {
+    pbtpStart,
+    pbtpDnsStart,
+    pbtpDnsEnd,
+    pbtpConnect,
+    pbtpTlsHandshake,
+    pbtpRequestSent,
+    pbtpFirstByte,
+    pbtpBodyReceived,
+    pbtpParsed,
+    pbtpOutcome,
+    /** Not a point, the number of points */
+    pbtpCount
+};
+
+
+/** Times at which points in a transaction were reached, in
+    microseconds of a monotonic clock, 0 if not reached.
+ */
+struct pbtimings {
+    uint64_t at[pbtpCount];
+};
+
+
+#if PUBNUB_TRANSACTION_TIMINGS
+
+/** Marks the start of a transaction in @p t - forgets all the
+    previously recorded points.
+ */
+void pbtimings_start(struct pbtimings* t);
+
+/** Marks the @p point as reached "now" in @p t. As points are
+    reached in order, this forgets all the points after @p point
+    (they are from a previous attempt, like on a retry).
+ */
+void pbtimings_mark(struct pbtimings* t, enum pbtimings_point point);
+
+/** Marks the @p point as reached "now" in @p t, unless it was
+    already marked (after the points before it were marked).
+ */
+void pbtimings_mark_once(struct pbtimings* t, enum pbtimings_point point);
+
+#define PBTIMINGS_START(pb) pbtimings_start(&(pb)->timings)
+#define PBTIMINGS_MARK(pb, point) pbtimings_mark(&(pb)->timings, (point))
+#define PBTIMINGS_MARK_ONCE(pb, point) pbtimings_mark_once(&(pb)->timings, (point))
+
+#else
+
+#define PBTIMINGS_START(pb)
+#define PBTIMINGS_MARK(pb, point)
+#define PBTIMINGS_MARK_ONCE(pb, point)
+
+#endif /* PUBNUB_TRANSACTION_TIMINGS */
+
+
+#endif /* !defined INC_PBTIMINGS */
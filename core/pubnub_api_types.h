@@ -140,6 +140,9 @@ enum pubnub_trans {
     /** Inform Pubnub that we're still working on @p channel and/or @p
         channel_group operation/transaction */
     PBTT_HEARTBEAT,
+    /** Connect to the origin (resolve, connect and TLS handshake)
+        in advance, without sending a request (pubnub_preconnect()) */
+    PBTT_PRECONNECT,
     /** Count the number of transaction types */
     PBTT_MAX
 };
@@ -172,7 +172,7 @@ enum pubnub_res pbcc_history_prep(struct pbcc_context *pb, const char *channel,
     APPEND_URL_PARAM_TRIBOOL_M(pb, "stringtoken", string_token, '&');
     APPEND_URL_PARAM_TRIBOOL_M(pb, "reverse", reverse, '&');
     APPEND_URL_PARAM_M(pb, "start", start, '&');
-    APPEND_URL_PARAM_M(pb, "start", end, '&');
+    APPEND_URL_PARAM_M(pb, "end", end, '&');
 
     return PNR_STARTED;
 }
@@ -292,6 +292,119 @@ enum pubnub_res pbcc_parse_subscribe_response(struct pbcc_context* p)
 }
 
 
+#if PUBNUB_STREAMING_SUBSCRIBE
+void pbcc_stream_subscribe_start(struct pbcc_context* p)
+{
+    p->stream.scan_ofs      = 0;
+    p->stream.msg_ofs       = 0;
+    p->stream.array_ofs     = 0;
+    p->stream.bracket_level = 0;
+    p->stream.in_string     = 0;
+    p->stream.escaped       = 0;
+    p->stream.done          = 0;
+}
+
+
+static void stream_deliver(struct pbcc_context* p,
+                           unsigned             end,
+                           pbcc_stream_msg_T    cb,
+                           void*                arg)
+{
+    char* reply = p->http_reply;
+    char  c     = reply[end];
+
+    reply[end] = '\0';
+    cb(reply + p->stream.msg_ofs, end - p->stream.msg_ofs, arg);
+    reply[end] = c;
+}
+
+
+unsigned pbcc_stream_subscribe_advance(struct pbcc_context* p,
+                                       pbcc_stream_msg_T    cb,
+                                       void*                arg)
+{
+    struct pbcc_subscribe_stream* s     = &p->stream;
+    char*                         reply = p->http_reply;
+    unsigned                      i;
+    unsigned                      dropped;
+
+    for (i = s->scan_ofs; (i < p->http_buf_len) && (0 == s->done); ++i) {
+        char const c = reply[i];
+        if (s->escaped) {
+            s->escaped = 0;
+        }
+        else if (s->in_string) {
+            if ('"' == c) {
+                s->in_string = 0;
+            }
+            else {
+                s->escaped = ('\\' == c);
+            }
+        }
+        else if ((2 == s->bracket_level) && (i == s->msg_ofs)
+                 && ((' ' == c) || ('\t' == c) || ('\r' == c) || ('\n' == c))) {
+            ++s->msg_ofs;
+        }
+        else {
+            switch (c) {
+            case '"':
+                s->in_string = 1;
+                break;
+            case '[':
+            case '{':
+                if ((0 == s->bracket_level) && (c != '[')) {
+                    /* Not a subscribe response, leave it to the "regular"
+                       parser to report the error */
+                    s->done = -1;
+                }
+                else if ((1 == s->bracket_level) && (0 == s->array_ofs)) {
+                    if (c != '[') {
+                        s->done = -1;
+                        break;
+                    }
+                    s->array_ofs = s->msg_ofs = i + 1;
+                }
+                ++s->bracket_level;
+                break;
+            case ']':
+            case '}':
+                if (2 == s->bracket_level) {
+                    if (i > s->msg_ofs) {
+                        stream_deliver(p, i, cb, arg);
+                    }
+                    s->msg_ofs = i;
+                    s->done    = 1;
+                }
+                --s->bracket_level;
+                break;
+            case ',':
+                if (2 == s->bracket_level) {
+                    stream_deliver(p, i, cb, arg);
+                    s->msg_ofs = i + 1;
+                }
+                break;
+            default:
+                break;
+            }
+        }
+    }
+    s->scan_ofs = i;
+
+    /* Recycle the space taken by the delivered messages */
+    if ((s->array_ofs == 0) || (s->msg_ofs <= s->array_ofs)) {
+        return 0;
+    }
+    dropped = s->msg_ofs - s->array_ofs;
+    memmove(reply + s->array_ofs, reply + s->msg_ofs, p->http_buf_len - s->msg_ofs);
+    p->http_buf_len -= dropped;
+    s->scan_ofs -= dropped;
+    s->msg_ofs = s->array_ofs;
+
+    return dropped;
+}
+#endif /* PUBNUB_STREAMING_SUBSCRIBE */
+
+
 enum pubnub_res pbcc_append_url_param(struct pbcc_context* pb,
                                       char const*          param_name,
                                       size_t               param_name_len,
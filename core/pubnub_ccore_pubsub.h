@@ -16,6 +16,33 @@
 */
 
 
+#if PUBNUB_STREAMING_SUBSCRIBE
+/** State of the incremental ("streaming") parsing of the message
+    array of a subscribe response, done while the response is
+    still being received.
+ */
+struct pbcc_subscribe_stream {
+    /** Offset of the first character not yet scanned */
+    unsigned scan_ofs;
+    /** Offset of the start of the message being scanned */
+    unsigned msg_ofs;
+    /** Offset of the first message, that is, just after the `[[` */
+    unsigned array_ofs;
+    /** JSON bracket nesting level at @c scan_ofs */
+    int bracket_level;
+    /** Is @c scan_ofs inside of a JSON string */
+    int in_string;
+    /** Was the last character scanned an escape in a JSON string */
+    int escaped;
+    /** Scanning outcome: 0 - still scanning, 1 - whole message
+        array was scanned (and all messages delivered), -1 -
+        response is not in the expected format, gave up
+    */
+    int done;
+};
+#endif
+
+
 /** The Pubnub "(C) core" context, contains context data
     that is shared among all Pubnub C clients.
  */
@@ -80,6 +107,11 @@ struct pbcc_context {
     */
     unsigned chan_ofs, chan_end;
 
+#if PUBNUB_STREAMING_SUBSCRIBE
+    /** State of the incremental parsing of the subscribe response */
+    struct pbcc_subscribe_stream stream;
+#endif
+
 #if PUBNUB_CRYPTO_API
     /** Secret key to use for encryption/decryption */
     char const* secret_key;
@@ -179,6 +211,38 @@ typedef enum pubnub_res (*PFpbcc_parse_response_T)(struct pbcc_context*);
 */
 enum pubnub_res pbcc_parse_subscribe_response(struct pbcc_context* p);
 
+#if PUBNUB_STREAMING_SUBSCRIBE
+/** Function to call for each message found by
+    pbcc_stream_subscribe_advance(). The message @p msg is
+    NUL-terminated and @p len characters long. It is valid only
+    during the call.
+*/
+typedef void (*pbcc_stream_msg_T)(char const* msg, size_t len, void* arg);
+
+/** Prepares for incremental parsing of a subscribe response, to be
+    called just before the response body starts to arrive.
+*/
+void pbcc_stream_subscribe_start(struct pbcc_context* p);
+
+/** Scans the part of the subscribe response in the reply buffer that
+    was received since the last call, calling @p cb for every message
+    of the message array that was fully received. Delivered messages
+    are then removed from the reply buffer (which is compacted), so
+    that, at the end, the reply looks like one with an empty message
+    array (`[[],"timetoken"...]`) and can be parsed by
+    pbcc_parse_subscribe_response() as usual.
+
+    @param p The Pubnub C core context, with `http_reply` holding
+    `http_buf_len` characters of the response (so far)
+    @param cb Function to call for each message
+    @param arg Argument to pass to @p cb
+    @return Number of characters removed from the reply buffer
+*/
+unsigned pbcc_stream_subscribe_advance(struct pbcc_context* p,
+                                       pbcc_stream_msg_T    cb,
+                                       void*                arg);
+#endif
+
 /** Parses the string received as a response for a publish operation
     (transaction). This checks if the response is valid, and, if it
     is, enables getting it as the gotten message (like for
@@ -0,0 +1,548 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "pubnub_internal.h"
+
+#include "pubnub_channel_set.h"
+
+#include "pubnub_pubsubapi.h"
+#include "pubnub_assert.h"
+#include "pubnub_log.h"
+
+#if !defined PUBNUB_CALLBACK_API
+#include "pubnub_ntf_sync.h"
+#include "pubnub_timers.h"
+#include "pubnub_helper.h"
+#endif
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/** Same as the timetoken of the context */
+#define TT_SIZE sizeof ((struct pbcc_context*)0)->timetoken
+
+
+/** A channel of the set */
+struct cs_channel {
+    /** The channel name */
+    char* name;
+    /** The URL-encoded channel name */
+    char* encoded;
+    /** Length of @c encoded */
+    size_t encoded_len;
+    /** Index of the shard the channel is in */
+    size_t shard;
+};
+
+
+/** A shard of the set */
+struct cs_shard {
+    /** Number of channels in the shard */
+    size_t count;
+    /** Length of the comma-separated list of channels */
+    size_t len;
+    /** The comma-separated list of channels, NULL if it has to be
+        (re)made */
+    char* list;
+    /** Incremented on each change of the shard */
+    unsigned gen;
+    /** The @c gen of the shard that was last subscribed to */
+    unsigned subscribed_gen;
+    /** Whether a subscribe on the shard is in flight */
+    bool busy;
+    /** Timetoken of the last subscribe on the shard */
+    char timetoken[TT_SIZE];
+};
+
+
+struct pubnub_channel_set {
+    struct pubnub_channel_set_options opt;
+    /** Channels, sorted by name */
+    struct cs_channel* channel;
+    /** Number of @c channel */
+    size_t n;
+    /** Number of @c channel allocated */
+    size_t cap;
+    /** Shards */
+    struct cs_shard* shard;
+    /** Number of @c shard */
+    size_t nshards;
+    /** The merged timetoken */
+    char timetoken[TT_SIZE];
+    /** Shard to fetch messages from first */
+    size_t next;
+    /** Contexts with a subscribe in flight, for pubnub_await_any() */
+    pubnub_t** busy;
+    /** Number of @c busy allocated */
+    size_t busy_cap;
+};
+
+
+/** Compares timetokens @p a and @p b, like strcmp() */
+static int tt_cmp(char const* a, char const* b)
+{
+    size_t la = strlen(a);
+    size_t lb = strlen(b);
+
+    if (la != lb) {
+        return (la < lb) ? -1 : 1;
+    }
+    return strcmp(a, b);
+}
+
+
+static char* encode(char const* s, size_t* len)
+{
+    static char const ok[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                             "0123456789-_.~=:;@[]";
+    char const* p;
+    char*       rslt;
+    char*       q;
+
+    *len = 0;
+    for (p = s; *p != '\0'; ++p) {
+        *len += (strchr(ok, *p) != NULL) ? 1 : 3;
+    }
+    rslt = (char*)malloc(*len + 1);
+    if (NULL == rslt) {
+        return NULL;
+    }
+    for (p = s, q = rslt; *p != '\0'; ++p) {
+        if (strchr(ok, *p) != NULL) {
+            *q++ = *p;
+        }
+        else {
+            *q++ = '%';
+            *q++ = "0123456789ABCDEF"[(unsigned char)*p / 16];
+            *q++ = "0123456789ABCDEF"[(unsigned char)*p % 16];
+        }
+    }
+    *q = '\0';
+
+    return rslt;
+}
+
+
+/** Finds the @p name in the set @p cs.
+    @return Whether it was found. In any case, @p idx is set to where
+    it is (or should be inserted)
+ */
+static bool find(pubnub_channel_set_t const* cs, char const* name, size_t* idx)
+{
+    size_t lo = 0;
+    size_t hi = cs->n;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int    cmp = strcmp(name, cs->channel[mid].name);
+        if (0 == cmp) {
+            *idx = mid;
+            return true;
+        }
+        if (cmp < 0) {
+            hi = mid;
+        }
+        else {
+            lo = mid + 1;
+        }
+    }
+    *idx = lo;
+
+    return false;
+}
+
+
+static void shard_changed(struct cs_shard* shard)
+{
+    free(shard->list);
+    shard->list = NULL;
+    ++shard->gen;
+}
+
+
+/** Finds a shard with room for a channel @p len long, or makes a new
+    one. @return The index of the shard, or @c nshards on failure to
+    allocate
+ */
+static size_t get_shard(pubnub_channel_set_t* cs, size_t len)
+{
+    struct cs_shard* shard;
+    size_t           i;
+
+    for (i = 0; i < cs->nshards; ++i) {
+        shard = &cs->shard[i];
+        if (((0 == shard->count) ? len : shard->len + 1 + len) <= cs->opt.max_shard_len) {
+            return i;
+        }
+    }
+    shard = (struct cs_shard*)realloc(cs->shard, (i + 1) * sizeof *shard);
+    if (NULL == shard) {
+        return i;
+    }
+    cs->shard = shard;
+    shard     = &cs->shard[i];
+    memset(shard, 0, sizeof *shard);
+    /* A new shard starts from where the rest of the set is */
+    strcpy(shard->timetoken, pubnub_channel_set_timetoken(cs));
+    ++cs->nshards;
+
+    return i;
+}
+
+
+struct pubnub_channel_set_options pubnub_channel_set_defopts(void)
+{
+    struct pubnub_channel_set_options rslt;
+
+    rslt.max_shard_len = PUBNUB_BUF_MAXLEN / 2;
+
+    return rslt;
+}
+
+
+pubnub_channel_set_t* pubnub_channel_set_create(struct pubnub_channel_set_options opt)
+{
+    pubnub_channel_set_t* cs = (pubnub_channel_set_t*)calloc(1, sizeof *cs);
+
+    if (NULL == cs) {
+        return NULL;
+    }
+    cs->opt = opt;
+    strcpy(cs->timetoken, "0");
+
+    return cs;
+}
+
+
+void pubnub_channel_set_destroy(pubnub_channel_set_t* cs)
+{
+    size_t i;
+
+    PUBNUB_ASSERT_OPT(NULL != cs);
+
+    for (i = 0; i < cs->n; ++i) {
+        free(cs->channel[i].name);
+        free(cs->channel[i].encoded);
+    }
+    for (i = 0; i < cs->nshards; ++i) {
+        free(cs->shard[i].list);
+    }
+    free(cs->channel);
+    free(cs->shard);
+    free(cs->busy);
+    free(cs);
+}
+
+
+enum pubnub_res pubnub_channel_set_add(pubnub_channel_set_t* cs, char const* channel)
+{
+    struct cs_channel ch;
+    struct cs_shard*  shard;
+    size_t            idx;
+
+    PUBNUB_ASSERT_OPT(NULL != cs);
+    PUBNUB_ASSERT_OPT(NULL != channel);
+
+    if (('\0' == *channel) || (strchr(channel, ',') != NULL)) {
+        return PNR_INVALID_CHANNEL;
+    }
+    if (find(cs, channel, &idx)) {
+        return PNR_OK;
+    }
+    ch.encoded = encode(channel, &ch.encoded_len);
+    if (NULL == ch.encoded) {
+        return PNR_REPLY_TOO_BIG;
+    }
+    if (ch.encoded_len > cs->opt.max_shard_len) {
+        free(ch.encoded);
+        return PNR_TX_BUFF_TOO_SMALL;
+    }
+    ch.name = (char*)malloc(strlen(channel) + 1);
+    if (NULL == ch.name) {
+        free(ch.encoded);
+        return PNR_REPLY_TOO_BIG;
+    }
+    strcpy(ch.name, channel);
+    if (cs->n == cs->cap) {
+        size_t             cap = (cs->cap > 0) ? 2 * cs->cap : 16;
+        struct cs_channel* c   = (struct cs_channel*)realloc(cs->channel, cap * sizeof *c);
+        if (NULL == c) {
+            free(ch.name);
+            free(ch.encoded);
+            return PNR_REPLY_TOO_BIG;
+        }
+        cs->channel = c;
+        cs->cap     = cap;
+    }
+    ch.shard = get_shard(cs, ch.encoded_len);
+    if (ch.shard == cs->nshards) {
+        free(ch.name);
+        free(ch.encoded);
+        return PNR_REPLY_TOO_BIG;
+    }
+    memmove(cs->channel + idx + 1, cs->channel + idx, (cs->n - idx) * sizeof ch);
+    cs->channel[idx] = ch;
+    ++cs->n;
+
+    shard = &cs->shard[ch.shard];
+    shard->len += (shard->count > 0) ? 1 + ch.encoded_len : ch.encoded_len;
+    ++shard->count;
+    shard_changed(shard);
+
+    return PNR_OK;
+}
+
+
+enum pubnub_res pubnub_channel_set_remove(pubnub_channel_set_t* cs, char const* channel)
+{
+    struct cs_shard* shard;
+    size_t           idx;
+
+    PUBNUB_ASSERT_OPT(NULL != cs);
+    PUBNUB_ASSERT_OPT(NULL != channel);
+
+    if (!find(cs, channel, &idx)) {
+        return PNR_INVALID_CHANNEL;
+    }
+    shard = &cs->shard[cs->channel[idx].shard];
+    --shard->count;
+    shard->len -= (shard->count > 0) ? 1 + cs->channel[idx].encoded_len : shard->len;
+    shard_changed(shard);
+
+    free(cs->channel[idx].name);
+    free(cs->channel[idx].encoded);
+    --cs->n;
+    memmove(cs->channel + idx, cs->channel + idx + 1, (cs->n - idx) * sizeof *cs->channel);
+
+    return PNR_OK;
+}
+
+
+size_t pubnub_channel_set_count(pubnub_channel_set_t const* cs)
+{
+    PUBNUB_ASSERT_OPT(NULL != cs);
+
+    return cs->n;
+}
+
+
+size_t pubnub_channel_set_shards(pubnub_channel_set_t const* cs)
+{
+    PUBNUB_ASSERT_OPT(NULL != cs);
+
+    return cs->nshards;
+}
+
+
+char const* pubnub_channel_set_shard(pubnub_channel_set_t* cs, size_t i)
+{
+    struct cs_shard* shard;
+    char*            s;
+    size_t           j;
+
+    PUBNUB_ASSERT_OPT(NULL != cs);
+
+    if (i >= cs->nshards) {
+        return NULL;
+    }
+    shard = &cs->shard[i];
+    if (shard->list != NULL) {
+        return shard->list;
+    }
+    shard->list = (char*)malloc(shard->len + 1);
+    if (NULL == shard->list) {
+        PUBNUB_LOG_ERROR("Failed to allocate %lu bytes for the channels of "
+                         "shard %lu\n",
+                         (unsigned long)(shard->len + 1),
+                         (unsigned long)i);
+        return NULL;
+    }
+    s = shard->list;
+    for (j = 0; j < cs->n; ++j) {
+        struct cs_channel const* ch = &cs->channel[j];
+        if (ch->shard == i) {
+            if (s != shard->list) {
+                *s++ = ',';
+            }
+            memcpy(s, ch->encoded, ch->encoded_len);
+            s += ch->encoded_len;
+        }
+    }
+    *s = '\0';
+    PUBNUB_ASSERT_OPT((size_t)(s - shard->list) == shard->len);
+
+    return shard->list;
+}
+
+
+char const* pubnub_channel_set_timetoken(pubnub_channel_set_t* cs)
+{
+    char const* oldest = NULL;
+    size_t      i;
+
+    PUBNUB_ASSERT_OPT(NULL != cs);
+
+    for (i = 0; i < cs->nshards; ++i) {
+        struct cs_shard const* shard = &cs->shard[i];
+        if ((shard->count > 0) && (0 != strcmp(shard->timetoken, "0"))
+            && ((NULL == oldest) || (tt_cmp(shard->timetoken, oldest) < 0))) {
+            oldest = shard->timetoken;
+        }
+    }
+    if (oldest != NULL) {
+        strcpy(cs->timetoken, oldest);
+    }
+
+    return cs->timetoken;
+}
+
+
+#if !defined PUBNUB_CALLBACK_API
+/** Gets the next message already received on shard @p i */
+static char const* get_message(pubnub_channel_set_t* cs,
+                               pubnub_t*             pb,
+                               size_t                i,
+                               char const**          channel)
+{
+    struct cs_shard const* shard = &cs->shard[i];
+    char const*            msg   = pubnub_get(pb);
+
+    if ((msg != NULL) && (channel != NULL)) {
+        *channel = pubnub_get_channel(pb);
+        /* With just one channel subscribed, the reply doesn't have it */
+        if ((NULL == *channel) && (1 == shard->count)
+            && (shard->gen == shard->subscribed_gen)) {
+            size_t j;
+            for (j = 0; j < cs->n; ++j) {
+                if (cs->channel[j].shard == i) {
+                    *channel = cs->channel[j].name;
+                    break;
+                }
+            }
+        }
+    }
+
+    return msg;
+}
+
+
+static enum pubnub_res start_subscribe(pubnub_channel_set_t* cs, pubnub_t* pb, size_t i)
+{
+    struct cs_shard* shard = &cs->shard[i];
+    char const*      list  = pubnub_channel_set_shard(cs, i);
+    enum pubnub_res  rslt;
+
+    if (NULL == list) {
+        return PNR_REPLY_TOO_BIG;
+    }
+    pubnub_mutex_lock(pb->monitor);
+    strcpy(pb->core.timetoken, shard->timetoken);
+    pubnub_mutex_unlock(pb->monitor);
+
+    rslt = pubnub_subscribe(pb, list, NULL);
+    if ((PNR_STARTED == rslt) || (PNR_OK == rslt)) {
+        /* If it's done already, pubnub_await_any() returns it right away */
+        shard->subscribed_gen = shard->gen;
+        shard->busy           = true;
+        rslt                  = PNR_STARTED;
+    }
+
+    return rslt;
+}
+
+
+enum pubnub_res pubnub_channel_set_fetch(pubnub_channel_set_t* cs,
+                                         pubnub_t**            pbs,
+                                         size_t                n,
+                                         char const**          message,
+                                         char const**          channel)
+{
+    struct cs_shard* shard;
+    enum pubnub_res  rslt;
+    bool             any = false;
+    size_t           i;
+    int              idx;
+
+    PUBNUB_ASSERT_OPT(NULL != cs);
+    PUBNUB_ASSERT_OPT(NULL != pbs);
+    PUBNUB_ASSERT_OPT(NULL != message);
+
+    *message = NULL;
+    if (channel != NULL) {
+        *channel = NULL;
+    }
+    if (cs->nshards > n) {
+        return PNR_TX_BUFF_TOO_SMALL;
+    }
+
+    for (i = 0; i < cs->nshards; ++i) {
+        size_t k = (cs->next + i) % cs->nshards;
+        if (!cs->shard[k].busy) {
+            *message = get_message(cs, pbs[k], k, channel);
+            if (*message != NULL) {
+                cs->next = k;
+                return PNR_OK;
+            }
+        }
+    }
+
+    if (cs->busy_cap < n) {
+        /* Allocated for all the contexts, as shards may be added */
+        pubnub_t** busy = (pubnub_t**)realloc(cs->busy, n * sizeof *busy);
+        if (NULL == busy) {
+            return PNR_REPLY_TOO_BIG;
+        }
+        cs->busy     = busy;
+        cs->busy_cap = n;
+    }
+    for (i = 0; i < cs->nshards; ++i) {
+        shard = &cs->shard[i];
+        if (shard->busy) {
+            if (shard->subscribed_gen != shard->gen) {
+                pubnub_cancel(pbs[i]);
+            }
+        }
+        else if (shard->count > 0) {
+            rslt = start_subscribe(cs, pbs[i], i);
+            if (rslt != PNR_STARTED) {
+                PUBNUB_LOG_ERROR("Failed to subscribe to shard %lu: %d('%s')\n",
+                                 (unsigned long)i,
+                                 rslt,
+                                 pubnub_res_2_string(rslt));
+                return rslt;
+            }
+        }
+        cs->busy[i] = shard->busy ? pbs[i] : NULL;
+        any         = any || shard->busy;
+    }
+    if (!any) {
+        return PNR_INVALID_CHANNEL;
+    }
+
+    idx = pubnub_await_any(cs->busy, cs->nshards, pubnub_transaction_timeout_get(pbs[0]));
+    if (idx < 0) {
+        for (i = 0; i < cs->nshards; ++i) {
+            if (cs->shard[i].busy) {
+                pubnub_cancel(pbs[i]);
+                cs->shard[i].busy = false;
+            }
+        }
+        pubnub_await_all(cs->busy, cs->nshards, pubnub_transaction_timeout_get(pbs[0]));
+        return PNR_TIMEOUT;
+    }
+    shard       = &cs->shard[idx];
+    shard->busy = false;
+    rslt        = pubnub_last_result(pbs[idx]);
+    if (PNR_OK == rslt) {
+        strcpy(shard->timetoken, pubnub_last_time_token(pbs[idx]));
+        *message = get_message(cs, pbs[idx], idx, channel);
+        cs->next = idx;
+    }
+    else if ((PNR_CANCELLED == rslt) && (shard->subscribed_gen != shard->gen)) {
+        /* Cancelled to subscribe to the changed shard */
+        rslt = PNR_OK;
+    }
+
+    return rslt;
+}
+#endif /* !defined PUBNUB_CALLBACK_API */
@@ -0,0 +1,154 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PUBNUB_CHANNEL_SET
+#define INC_PUBNUB_CHANNEL_SET
+
+
+#include "pubnub_api_types.h"
+
+#include <stddef.h>
+
+
+/** @file pubnub_channel_set.h
+    This is the "Channel set" API. A channel set keeps a (large) set
+    of channels to subscribe to, which can be changed incrementally,
+    by adding and removing channels.
+
+    Channel names are URL-encoded once, when added, and the set is
+    split in "shards", each a comma-separated list of (encoded)
+    channels that fits in a subscribe URL. Each shard is subscribed to
+    with its own context, so the size of the set is not limited by
+    #PUBNUB_BUF_MAXLEN. When a channel is added, it goes to the first
+    shard that has room for it, and removing a channel doesn't move
+    others, so a change of the set re-subscribes just one shard.
+
+    With the "sync" interface, pubnub_channel_set_fetch() runs the
+    subscribes of all the shards. Each shard keeps its own timetoken,
+    but they are merged, by pubnub_channel_set_timetoken(), to the
+    one from which the whole set is received, and new shards start
+    from it.
+
+    A channel set is not thread-safe, use it (change it and fetch)
+    from one thread, or guard it with your own mutex.
+*/
+
+
+/** Options for a channel set */
+struct pubnub_channel_set_options {
+    /** The maximum length of a shard (the comma-separated list of
+        encoded channels). Keep in mind that the rest of the
+        subscribe URL (keys, UUID, auth, filter expression...) has to
+        fit in #PUBNUB_BUF_MAXLEN, too. Default is half of
+        #PUBNUB_BUF_MAXLEN.
+     */
+    size_t max_shard_len;
+};
+
+
+/** A channel set. It's an opaque type, use functions to work with
+    it.
+ */
+typedef struct pubnub_channel_set pubnub_channel_set_t;
+
+
+/** This returns the default options for a channel set. It's best to
+    always call it to initialize the #pubnub_channel_set_options.
+ */
+struct pubnub_channel_set_options pubnub_channel_set_defopts(void);
+
+/** Creates an (empty) channel set with the options @p opt.
+    @return The channel set, or NULL on failure to allocate
+ */
+pubnub_channel_set_t* pubnub_channel_set_create(struct pubnub_channel_set_options opt);
+
+/** Destroys the channel set @p cs. It doesn't cancel subscribes
+    started by pubnub_channel_set_fetch(), you might want to
+    pubnub_cancel() them first.
+ */
+void pubnub_channel_set_destroy(pubnub_channel_set_t* cs);
+
+/** Adds the @p channel to the channel set @p cs.
+
+    @param cs The channel set
+    @param channel The channel to add. Can't be NULL, nor a
+    comma-separated list of channels
+    @retval PNR_OK The channel was added, or was in the set already
+    @retval PNR_INVALID_CHANNEL @p channel is empty or has a comma
+    @retval PNR_TX_BUFF_TOO_SMALL The (encoded) @p channel is longer
+    than the maximum length of a shard
+    @retval PNR_REPLY_TOO_BIG Failed to allocate memory
+ */
+enum pubnub_res pubnub_channel_set_add(pubnub_channel_set_t* cs, char const* channel);
+
+/** Removes the @p channel from the channel set @p cs.
+    @retval PNR_OK The channel was removed
+    @retval PNR_INVALID_CHANNEL The channel is not in the set
+ */
+enum pubnub_res pubnub_channel_set_remove(pubnub_channel_set_t* cs, char const* channel);
+
+/** Returns the number of channels in the channel set @p cs */
+size_t pubnub_channel_set_count(pubnub_channel_set_t const* cs);
+
+/** Returns the number of shards of the channel set @p cs. Shards are
+    never removed, so a shard can be empty, after its channels were
+    removed.
+ */
+size_t pubnub_channel_set_shards(pubnub_channel_set_t const* cs);
+
+/** Returns the comma-separated list of (URL-encoded) channels of the
+    shard @p i of the channel set @p cs, ready to be passed to
+    pubnub_subscribe() (or pubnub_subscribe_ex()).
+
+    The string returned is valid until the next change of the set.
+
+    @return The list, empty if the shard is empty, or NULL if @p i is
+    not a shard of the set, or on failure to allocate
+ */
+char const* pubnub_channel_set_shard(pubnub_channel_set_t* cs, size_t i);
+
+/** Returns the merged timetoken of the channel set @p cs: the oldest
+    of the timetokens of its (non-empty) shards - that is, the one
+    from which messages on all the channels of the set are received.
+    "0" if no shard was subscribed to yet.
+ */
+char const* pubnub_channel_set_timetoken(pubnub_channel_set_t* cs);
+
+
+#if !defined PUBNUB_CALLBACK_API
+/** Designed to be called once in every iteration of a subscribe loop
+    on the channel set @p cs, like pubnub_subloop_fetch(). Fetches the
+    next message, subscribing to the shards, with the contexts @p pbs
+    (shard @c i with context @c pbs[i]), if there are no messages
+    left. Subscribes of all the shards are in flight at the same time,
+    awaited by pubnub_await_any().
+
+    If a shard is changed while it is being subscribed to, the
+    subscribe is cancelled and started again, with the new channels.
+    The change may take effect only after the next subscribe of some
+    shard finishes.
+
+    Always pass the same contexts, in the same order, and don't use
+    them for anything else while you use the channel set.
+
+    @param cs The channel set
+    @param pbs The contexts to use. Can't be NULL.
+    @param n Number of contexts in @p pbs. Has to be at least the
+    number of shards of the set.
+    @param[out] message The message that was fetched, or NULL if no
+    message fetched
+    @param[out] channel The channel of the message, if not NULL
+    @retval PNR_OK Success
+    @retval PNR_INVALID_CHANNEL The set is empty
+    @retval PNR_TX_BUFF_TOO_SMALL There are more shards than @p n
+    @retval PNR_TIMEOUT None of the subscribes finished within the
+    transaction timeout of the first context (they are cancelled)
+    @retval other The result of the subscribe that failed
+ */
+enum pubnub_res pubnub_channel_set_fetch(pubnub_channel_set_t* cs,
+                                         pubnub_t**            pbs,
+                                         size_t                n,
+                                         char const**          message,
+                                         char const**          channel);
+#endif /* !defined PUBNUB_CALLBACK_API */
+
+
+#endif /* !defined INC_PUBNUB_CHANNEL_SET */
@@ -0,0 +1,482 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "cgreen/cgreen.h"
+#include "cgreen/mocks.h"
+
+#include "pubnub_internal.h"
+
+#include "core/pubnub_channel_set.h"
+#include "core/pubnub_pubsubapi.h"
+#include "core/pubnub_ntf_sync.h"
+#include "core/pubnub_timers.h"
+#include "core/pubnub_helper.h"
+#include "core/pubnub_assert.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+
+
+/* A less chatty cgreen :) */
+
+#define attest assert_that
+#define equals is_equal_to
+#define streqs is_equal_to_string
+#define differs is_not_equal_to
+#define strdifs is_not_equal_to_string
+#define ptreqs(val) is_equal_to_contents_of(&(val), sizeof(val))
+#define ptrdifs(val) is_not_equal_to_contents_of(&(val), sizeof(val))
+#define sets(par, val) will_set_contents_of_parameter(par, &(val), sizeof(val))
+#define sets_ex will_set_contents_of_parameter
+#define returns will_return
+
+
+enum { CONTEXTS = 3, MAX_MESSAGES = 4 };
+
+static pubnub_t m_ctx[CONTEXTS];
+
+static pubnub_t* m_pbs[CONTEXTS] = { m_ctx + 0, m_ctx + 1, m_ctx + 2 };
+
+static pubnub_channel_set_t* m_cs;
+
+/** The (fake) subscribe server. The test prepares a reply for a
+    context and the index of the context pubnub_await_any() returns
+    (-1 for a timeout). The reply is delivered only then, as it would
+    be on a real context.
+ */
+static struct reply {
+    enum pubnub_res result;
+    char            timetoken[32];
+    char const*     message[MAX_MESSAGES];
+    char const*     channel[MAX_MESSAGES];
+    int             len;
+} m_pending[CONTEXTS], m_received[CONTEXTS];
+static int m_get[CONTEXTS];
+static int m_ready;
+
+/** The subscribes started on each context */
+static int  m_subscribes[CONTEXTS];
+static char m_subscribed_channels[CONTEXTS][64];
+static char m_subscribed_timetoken[CONTEXTS][32];
+static bool m_busy[CONTEXTS];
+
+static int m_cancels[CONTEXTS];
+
+
+static int ctx_index(pubnub_t const* pb)
+{
+    int i = (int)(pb - m_ctx);
+    PUBNUB_ASSERT_OPT((i >= 0) && (i < CONTEXTS));
+    return i;
+}
+
+
+enum pubnub_res pubnub_subscribe(pubnub_t* p, const char* channel, const char* channel_group)
+{
+    int i = ctx_index(p);
+
+    attest(channel_group, equals(NULL));
+    attest(m_busy[i], equals(false));
+    snprintf(m_subscribed_channels[i], sizeof m_subscribed_channels[i], "%s", channel);
+    snprintf(m_subscribed_timetoken[i],
+             sizeof m_subscribed_timetoken[i],
+             "%s",
+             p->core.timetoken);
+    ++m_subscribes[i];
+    m_busy[i] = true;
+
+    return PNR_STARTED;
+}
+
+
+int pubnub_await_any(pubnub_t** pbs, size_t n, int timeout_ms)
+{
+    PUBNUB_UNUSED(timeout_ms);
+    if (m_ready < 0) {
+        return -1;
+    }
+    attest(m_ready, is_less_than(n));
+    attest(pbs[m_ready], equals(m_ctx + m_ready));
+    attest(m_busy[m_ready], equals(true));
+    m_busy[m_ready]     = false;
+    m_received[m_ready] = m_pending[m_ready];
+    m_get[m_ready]      = 0;
+    memset(&m_pending[m_ready], 0, sizeof m_pending[m_ready]);
+
+    return m_ready;
+}
+
+
+enum pubnub_res pubnub_await_all(pubnub_t** pbs, size_t n, int timeout_ms)
+{
+    size_t i;
+
+    PUBNUB_UNUSED(timeout_ms);
+    for (i = 0; i < n; ++i) {
+        if (pbs[i] != NULL) {
+            m_busy[ctx_index(pbs[i])] = false;
+        }
+    }
+
+    return PNR_OK;
+}
+
+
+void pubnub_cancel(pubnub_t* p)
+{
+    int i = ctx_index(p);
+
+    ++m_cancels[i];
+    m_pending[i].result = PNR_CANCELLED;
+}
+
+
+enum pubnub_res pubnub_last_result(pubnub_t* p)
+{
+    return m_received[ctx_index(p)].result;
+}
+
+
+char const* pubnub_last_time_token(pubnub_t* p)
+{
+    return m_received[ctx_index(p)].timetoken;
+}
+
+
+char const* pubnub_get(pubnub_t* p)
+{
+    int i = ctx_index(p);
+    return (m_get[i] < m_received[i].len) ? m_received[i].message[m_get[i]++] : NULL;
+}
+
+
+char const* pubnub_get_channel(pubnub_t* p)
+{
+    int i = ctx_index(p);
+    return (m_get[i] > 0) ? m_received[i].channel[m_get[i] - 1] : NULL;
+}
+
+
+int pubnub_transaction_timeout_get(pubnub_t* p)
+{
+    PUBNUB_UNUSED(p);
+    return 1000;
+}
+
+
+char const* pubnub_res_2_string(enum pubnub_res e)
+{
+    PUBNUB_UNUSED(e);
+    return "";
+}
+
+
+static void create(size_t max_shard_len)
+{
+    struct pubnub_channel_set_options opt = pubnub_channel_set_defopts();
+    if (max_shard_len > 0) {
+        opt.max_shard_len = max_shard_len;
+    }
+    m_cs = pubnub_channel_set_create(opt);
+    attest(m_cs, differs(NULL));
+}
+
+
+static void add(char const* channel)
+{
+    attest(pubnub_channel_set_add(m_cs, channel), equals(PNR_OK));
+}
+
+
+/** Prepares the reply of context @p i, which will be the one that
+    finishes on the next pubnub_channel_set_fetch() */
+static void reply(int i, char const* timetoken)
+{
+    m_pending[i].result = PNR_OK;
+    snprintf(m_pending[i].timetoken, sizeof m_pending[i].timetoken, "%s", timetoken);
+    m_ready = i;
+}
+
+
+static void reply_message(int i, char const* message, char const* channel)
+{
+    PUBNUB_ASSERT_OPT(m_pending[i].len < MAX_MESSAGES);
+    m_pending[i].message[m_pending[i].len] = message;
+    m_pending[i].channel[m_pending[i].len] = channel;
+    ++m_pending[i].len;
+}
+
+
+static enum pubnub_res fetch(char const** message, char const** channel)
+{
+    return pubnub_channel_set_fetch(m_cs, m_pbs, CONTEXTS, message, channel);
+}
+
+
+static void fetch_nothing(void)
+{
+    char const* message;
+    char const* channel;
+
+    attest(fetch(&message, &channel), equals(PNR_OK));
+    attest(message, equals(NULL));
+    attest(channel, equals(NULL));
+}
+
+
+Describe(pubnub_channel_set);
+
+
+BeforeEach(pubnub_channel_set) {
+    memset(m_ctx, 0, sizeof m_ctx);
+    memset(m_pending, 0, sizeof m_pending);
+    memset(m_received, 0, sizeof m_received);
+    memset(m_get, 0, sizeof m_get);
+    memset(m_subscribes, 0, sizeof m_subscribes);
+    memset(m_subscribed_channels, 0, sizeof m_subscribed_channels);
+    memset(m_subscribed_timetoken, 0, sizeof m_subscribed_timetoken);
+    memset(m_busy, 0, sizeof m_busy);
+    memset(m_cancels, 0, sizeof m_cancels);
+    m_ready = -1;
+    m_cs    = NULL;
+}
+
+
+AfterEach(pubnub_channel_set) {
+    if (m_cs != NULL) {
+        pubnub_channel_set_destroy(m_cs);
+    }
+}
+
+
+Ensure(pubnub_channel_set, adds_and_removes_channels) {
+    create(0);
+    attest(pubnub_channel_set_count(m_cs), equals(0));
+    attest(pubnub_channel_set_shards(m_cs), equals(0));
+
+    add("b");
+    add("a");
+    attest(pubnub_channel_set_count(m_cs), equals(2));
+    /* Adding a channel again is not an error, but doesn't add it */
+    add("a");
+    attest(pubnub_channel_set_count(m_cs), equals(2));
+
+    attest(pubnub_channel_set_remove(m_cs, "a"), equals(PNR_OK));
+    attest(pubnub_channel_set_count(m_cs), equals(1));
+    attest(pubnub_channel_set_remove(m_cs, "a"), equals(PNR_INVALID_CHANNEL));
+    attest(pubnub_channel_set_remove(m_cs, "c"), equals(PNR_INVALID_CHANNEL));
+    attest(pubnub_channel_set_count(m_cs), equals(1));
+    attest(pubnub_channel_set_shard(m_cs, 0), streqs("b"));
+}
+
+
+Ensure(pubnub_channel_set, rejects_invalid_channels) {
+    create(8);
+    attest(pubnub_channel_set_add(m_cs, ""), equals(PNR_INVALID_CHANNEL));
+    attest(pubnub_channel_set_add(m_cs, "a,b"), equals(PNR_INVALID_CHANNEL));
+    attest(pubnub_channel_set_add(m_cs, "123456789"), equals(PNR_TX_BUFF_TOO_SMALL));
+    /* It's the URL-encoded length that has to fit in a shard */
+    attest(pubnub_channel_set_add(m_cs, "a b c"), equals(PNR_TX_BUFF_TOO_SMALL));
+    attest(pubnub_channel_set_count(m_cs), equals(0));
+    attest(pubnub_channel_set_shards(m_cs), equals(0));
+
+    add("12345678");
+    attest(pubnub_channel_set_shard(m_cs, 0), streqs("12345678"));
+}
+
+
+Ensure(pubnub_channel_set, shard_lists_channels_sorted_and_encoded) {
+    create(0);
+    add("c");
+    add("a b");
+    add("b/x");
+    add("[x]:y@z");
+    attest(pubnub_channel_set_shards(m_cs), equals(1));
+    attest(pubnub_channel_set_shard(m_cs, 0), streqs("[x]:y@z,a%20b,b%2Fx,c"));
+    attest(pubnub_channel_set_shard(m_cs, 1), equals(NULL));
+
+    attest(pubnub_channel_set_remove(m_cs, "b/x"), equals(PNR_OK));
+    attest(pubnub_channel_set_shard(m_cs, 0), streqs("[x]:y@z,a%20b,c"));
+}
+
+
+Ensure(pubnub_channel_set, full_shard_makes_a_new_one) {
+    create(8);
+    add("aaaa");
+    add("bbbb");
+    add("cc");
+    add("dd");
+    add("e");
+    attest(pubnub_channel_set_shards(m_cs), equals(3));
+    attest(pubnub_channel_set_shard(m_cs, 0), streqs("aaaa,cc"));
+    attest(pubnub_channel_set_shard(m_cs, 1), streqs("bbbb,dd"));
+    attest(pubnub_channel_set_shard(m_cs, 2), streqs("e"));
+    attest(pubnub_channel_set_shard(m_cs, 3), equals(NULL));
+
+    /* Removing doesn't move the other channels, and the room it
+       makes is taken by the next channel added */
+    attest(pubnub_channel_set_remove(m_cs, "aaaa"), equals(PNR_OK));
+    attest(pubnub_channel_set_shard(m_cs, 0), streqs("cc"));
+    attest(pubnub_channel_set_shard(m_cs, 1), streqs("bbbb,dd"));
+    add("f");
+    attest(pubnub_channel_set_shard(m_cs, 0), streqs("cc,f"));
+    attest(pubnub_channel_set_shard(m_cs, 2), streqs("e"));
+
+    attest(pubnub_channel_set_remove(m_cs, "e"), equals(PNR_OK));
+    attest(pubnub_channel_set_shards(m_cs), equals(3));
+    attest(pubnub_channel_set_shard(m_cs, 2), streqs(""));
+}
+
+
+Ensure(pubnub_channel_set, timetoken_is_zero_until_subscribed) {
+    create(8);
+    attest(pubnub_channel_set_timetoken(m_cs), streqs("0"));
+    add("aaaa");
+    add("bbbb");
+    attest(pubnub_channel_set_timetoken(m_cs), streqs("0"));
+}
+
+
+Ensure(pubnub_channel_set, timetoken_is_the_oldest_of_the_shards) {
+    create(8);
+    add("aaaa");
+    add("bbbb");
+
+    reply(0, "1000");
+    fetch_nothing();
+    attest(m_subscribes[0], equals(1));
+    attest(m_subscribes[1], equals(1));
+    attest(m_subscribed_channels[0], streqs("aaaa"));
+    attest(m_subscribed_channels[1], streqs("bbbb"));
+    attest(m_subscribed_timetoken[0], streqs("0"));
+    attest(m_subscribed_timetoken[1], streqs("0"));
+    /* A shard not subscribed to yet doesn't count */
+    attest(pubnub_channel_set_timetoken(m_cs), streqs("1000"));
+
+    /* Timetokens are compared as numbers, not strings */
+    reply(1, "999");
+    fetch_nothing();
+    attest(m_subscribes[0], equals(2));
+    attest(m_subscribed_timetoken[0], streqs("1000"));
+    attest(m_subscribes[1], equals(1));
+    attest(pubnub_channel_set_timetoken(m_cs), streqs("999"));
+
+    reply(0, "1001");
+    fetch_nothing();
+    attest(m_subscribed_timetoken[1], streqs("999"));
+    attest(pubnub_channel_set_timetoken(m_cs), streqs("999"));
+
+    /* Nor does a shard without channels */
+    attest(pubnub_channel_set_remove(m_cs, "bbbb"), equals(PNR_OK));
+    attest(pubnub_channel_set_timetoken(m_cs), streqs("1001"));
+}
+
+
+Ensure(pubnub_channel_set, new_shard_starts_from_the_set_timetoken) {
+    create(8);
+    add("aaaa");
+    reply(0, "500");
+    fetch_nothing();
+    attest(pubnub_channel_set_timetoken(m_cs), streqs("500"));
+
+    add("bbbb");
+    attest(pubnub_channel_set_shards(m_cs), equals(2));
+    attest(pubnub_channel_set_timetoken(m_cs), streqs("500"));
+    reply(1, "600");
+    fetch_nothing();
+    attest(m_subscribed_timetoken[0], streqs("500"));
+    attest(m_subscribed_timetoken[1], streqs("500"));
+    attest(pubnub_channel_set_timetoken(m_cs), streqs("500"));
+}
+
+
+Ensure(pubnub_channel_set, fetches_messages_with_their_channel) {
+    char const* message;
+    char const* channel;
+
+    create(8);
+    add("aaaa");
+    add("bbbb");
+    add("cc");
+
+    reply(1, "10");
+    reply_message(1, "\"m1\"", NULL);
+    reply_message(1, "\"m2\"", NULL);
+    attest(fetch(&message, &channel), equals(PNR_OK));
+    attest(message, streqs("\"m1\""));
+    /* The only channel of the shard, as the reply doesn't have it */
+    attest(channel, streqs("bbbb"));
+    attest(fetch(&message, &channel), equals(PNR_OK));
+    attest(message, streqs("\"m2\""));
+    attest(channel, streqs("bbbb"));
+    attest(m_subscribes[1], equals(1));
+
+    reply(0, "11");
+    reply_message(0, "\"m3\"", "cc");
+    attest(fetch(&message, &channel), equals(PNR_OK));
+    attest(message, streqs("\"m3\""));
+    attest(channel, streqs("cc"));
+    attest(pubnub_channel_set_timetoken(m_cs), streqs("10"));
+}
+
+
+Ensure(pubnub_channel_set, changed_shard_is_subscribed_again) {
+    char const* message;
+
+    create(8);
+    add("aaaa");
+    add("bbbb");
+    reply(1, "10");
+    fetch_nothing();
+
+    /* Shard 0 is busy, so it is cancelled to subscribe to "aaaa,c" */
+    add("c");
+    attest(pubnub_channel_set_shard(m_cs, 0), streqs("aaaa,c"));
+    m_ready = 0;
+    attest(fetch(&message, NULL), equals(PNR_OK));
+    attest(message, equals(NULL));
+    attest(m_cancels[0], equals(1));
+    attest(pubnub_channel_set_timetoken(m_cs), streqs("10"));
+
+    reply(1, "11");
+    fetch_nothing();
+    attest(m_subscribes[0], equals(2));
+    attest(m_subscribed_channels[0], streqs("aaaa,c"));
+    attest(m_subscribed_timetoken[0], streqs("0"));
+}
+
+
+Ensure(pubnub_channel_set, timeout_cancels_all_subscribes) {
+    char const* message;
+
+    create(8);
+    add("aaaa");
+    add("bbbb");
+    reply(0, "10");
+    fetch_nothing();
+
+    m_ready = -1;
+    attest(fetch(&message, NULL), equals(PNR_TIMEOUT));
+    attest(m_cancels[0], equals(1));
+    attest(m_cancels[1], equals(1));
+    attest(pubnub_channel_set_timetoken(m_cs), streqs("10"));
+
+    /* Subscribed again from where they were */
+    reply(1, "20");
+    fetch_nothing();
+    attest(m_subscribed_timetoken[0], streqs("10"));
+    attest(m_subscribed_timetoken[1], streqs("0"));
+    attest(pubnub_channel_set_timetoken(m_cs), streqs("10"));
+}
+
+
+Ensure(pubnub_channel_set, fetch_needs_a_context_per_shard) {
+    char const* message;
+
+    create(8);
+    attest(fetch(&message, NULL), equals(PNR_INVALID_CHANNEL));
+    add("aaaa");
+    add("bbbb");
+    attest(pubnub_channel_set_fetch(m_cs, m_pbs, 1, &message, NULL),
+           equals(PNR_TX_BUFF_TOO_SMALL));
+}
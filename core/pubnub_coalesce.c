@@ -0,0 +1,470 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "pubnub_internal.h"
+
+#include "pubnub_coalesce.h"
+
+#include "pubnub_pubsubapi.h"
+#include "pubnub_json_parse.h"
+#include "pubnub_helper.h"
+#include "pubnub_mutex.h"
+#include "pubnub_assert.h"
+#include "pubnub_log.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include "posix/monotonic_clock_get_time.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+
+/** Start of a batch envelope */
+#define ENVELOPE_PREFIX "{\"pn_batch\":["
+
+/** End of a batch envelope */
+#define ENVELOPE_SUFFIX "]}"
+
+#define ENVELOPE_PREFIX_LEN (sizeof ENVELOPE_PREFIX - 1)
+
+#define ENVELOPE_SUFFIX_LEN (sizeof ENVELOPE_SUFFIX - 1)
+
+
+/** Messages for a channel, waiting to be published */
+struct coalesce_batch {
+    /** The channel, NULL if the batch was never used */
+    char* channel;
+    /** The envelope, without the suffix, NUL-terminated */
+    char* buf;
+    /** Length of the envelope in @c buf */
+    size_t len;
+    /** Size of @c buf */
+    size_t size;
+    /** Number of messages in the envelope */
+    unsigned count;
+    /** Whether a message was rejected because the batch is full */
+    bool full;
+    /** When was the first message added */
+    unsigned long first_ms;
+};
+
+
+struct pubnub_coalescer {
+    struct pubnub_coalesce_options opt;
+    /** Batches, one per channel */
+    struct coalesce_batch* batch;
+    /** Number of @c batch */
+    size_t n;
+    pubnub_mutex_t monitor;
+};
+
+
+static unsigned long now_ms(void)
+{
+#if defined(_WIN32)
+    return GetTickCount();
+#else
+    struct timespec ts;
+    monotonic_clock_get_time(&ts);
+    return (unsigned long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+#endif
+}
+
+
+static bool is_due(pubnub_coalescer_t const*    c,
+                   struct coalesce_batch const* batch,
+                   unsigned long                now)
+{
+    return (batch->count > 0)
+           && (batch->full || (batch->len + ENVELOPE_SUFFIX_LEN >= c->opt.max_bytes)
+               || (now - batch->first_ms >= c->opt.max_delay_ms));
+}
+
+
+static bool reserve(struct coalesce_batch* batch, size_t len)
+{
+    if (batch->len + len + 1 > batch->size) {
+        size_t size = (batch->size > 0) ? batch->size : 256;
+        char*  buf;
+        while (batch->len + len + 1 > size) {
+            size *= 2;
+        }
+        buf = (char*)realloc(batch->buf, size);
+        if (NULL == buf) {
+            return false;
+        }
+        batch->buf  = buf;
+        batch->size = size;
+    }
+    return true;
+}
+
+
+static void append(struct coalesce_batch* batch, char const* s, size_t len)
+{
+    memcpy(batch->buf + batch->len, s, len);
+    batch->len += len;
+    batch->buf[batch->len] = '\0';
+}
+
+
+/** Finds the batch for the @p channel, or an unused one, or makes a
+    new one. @return The batch, NULL on failure to allocate */
+static struct coalesce_batch* get_batch(pubnub_coalescer_t* c, char const* channel)
+{
+    struct coalesce_batch* unused = NULL;
+    struct coalesce_batch* batch;
+    size_t                 i;
+
+    for (i = 0; i < c->n; ++i) {
+        batch = &c->batch[i];
+        if ((batch->channel != NULL) && (0 == strcmp(batch->channel, channel))) {
+            return batch;
+        }
+        if ((NULL == unused) && (0 == batch->count)) {
+            unused = batch;
+        }
+    }
+    if (NULL == unused) {
+        batch = (struct coalesce_batch*)realloc(c->batch, (c->n + 1) * sizeof *batch);
+        if (NULL == batch) {
+            return NULL;
+        }
+        c->batch = batch;
+        unused   = &c->batch[c->n++];
+        memset(unused, 0, sizeof *unused);
+    }
+    batch = unused;
+    free(batch->channel);
+    batch->channel = (char*)malloc(strlen(channel) + 1);
+    if (NULL == batch->channel) {
+        return NULL;
+    }
+    strcpy(batch->channel, channel);
+
+    return batch;
+}
+
+
+struct pubnub_coalesce_options pubnub_coalesce_defopts(void)
+{
+    struct pubnub_coalesce_options rslt;
+
+    rslt.max_delay_ms = 50;
+    rslt.max_bytes    = 4096;
+
+    return rslt;
+}
+
+
+pubnub_coalescer_t* pubnub_coalescer_create(struct pubnub_coalesce_options opt)
+{
+    pubnub_coalescer_t* c = (pubnub_coalescer_t*)malloc(sizeof *c);
+
+    if (NULL == c) {
+        return NULL;
+    }
+    c->opt   = opt;
+    c->batch = NULL;
+    c->n     = 0;
+    pubnub_mutex_init(c->monitor);
+
+    return c;
+}
+
+
+void pubnub_coalescer_destroy(pubnub_coalescer_t* c)
+{
+    size_t i;
+
+    PUBNUB_ASSERT_OPT(NULL != c);
+
+    for (i = 0; i < c->n; ++i) {
+        if (c->batch[i].count > 0) {
+            PUBNUB_LOG_WARNING("Dropping %u unpublished messages for channel '%s'\n",
+                               c->batch[i].count,
+                               c->batch[i].channel);
+        }
+        free(c->batch[i].channel);
+        free(c->batch[i].buf);
+    }
+    free(c->batch);
+    pubnub_mutex_destroy(c->monitor);
+    free(c);
+}
+
+
+enum pubnub_res pubnub_coalesce_add(pubnub_coalescer_t* c,
+                                    char const*         channel,
+                                    char const*         message)
+{
+    struct coalesce_batch* batch;
+    size_t                 len;
+
+    PUBNUB_ASSERT_OPT(NULL != c);
+    PUBNUB_ASSERT_OPT(NULL != channel);
+    PUBNUB_ASSERT_OPT(NULL != message);
+
+    if ('\0' == *channel) {
+        return PNR_INVALID_CHANNEL;
+    }
+    len = strlen(message);
+    if (len > c->opt.max_bytes) {
+        return PNR_TX_BUFF_TOO_SMALL;
+    }
+
+    pubnub_mutex_lock(c->monitor);
+    batch = get_batch(c, channel);
+    if (NULL == batch) {
+        pubnub_mutex_unlock(c->monitor);
+        return PNR_REPLY_TOO_BIG;
+    }
+    if ((batch->count > 0)
+        && (batch->len + 1 + len + ENVELOPE_SUFFIX_LEN > c->opt.max_bytes)) {
+        batch->full = true;
+        pubnub_mutex_unlock(c->monitor);
+        return PNR_TX_BUFF_TOO_SMALL;
+    }
+    if (!reserve(batch, ENVELOPE_PREFIX_LEN + 1 + len + ENVELOPE_SUFFIX_LEN)) {
+        pubnub_mutex_unlock(c->monitor);
+        return PNR_REPLY_TOO_BIG;
+    }
+    if (0 == batch->count) {
+        batch->len      = 0;
+        batch->first_ms = now_ms();
+        append(batch, ENVELOPE_PREFIX, ENVELOPE_PREFIX_LEN);
+    }
+    else {
+        append(batch, ",", 1);
+    }
+    append(batch, message, len);
+    ++batch->count;
+    pubnub_mutex_unlock(c->monitor);
+
+    return PNR_OK;
+}
+
+
+/** Returns the batch with the oldest message, of those that are due
+    (or of all, if @p force), NULL if none */
+static struct coalesce_batch* oldest_due(pubnub_coalescer_t* c,
+                                         bool                force,
+                                         unsigned long       now)
+{
+    struct coalesce_batch* batch = NULL;
+    size_t                 i;
+
+    for (i = 0; i < c->n; ++i) {
+        struct coalesce_batch* b = &c->batch[i];
+        if ((force ? (b->count > 0) : is_due(c, b, now))
+            && ((NULL == batch) || ((long)(b->first_ms - batch->first_ms) < 0))) {
+            batch = b;
+        }
+    }
+
+    return batch;
+}
+
+
+static void clear(struct coalesce_batch* batch)
+{
+    batch->count = 0;
+    batch->full  = false;
+    batch->len   = 0;
+}
+
+
+static enum pubnub_res publish_batch(struct coalesce_batch* batch, pubnub_t* pb)
+{
+    enum pubnub_res rslt;
+
+    if (1 == batch->count) {
+        rslt = pubnub_publish(pb, batch->channel, batch->buf + ENVELOPE_PREFIX_LEN);
+    }
+    else {
+        size_t len = batch->len;
+        /* There's always room for the suffix */
+        append(batch, ENVELOPE_SUFFIX, ENVELOPE_SUFFIX_LEN);
+        rslt       = pubnub_publish(pb, batch->channel, batch->buf);
+        batch->len = len;
+        batch->buf[len] = '\0';
+    }
+    if ((PNR_STARTED == rslt) || (PNR_OK == rslt)) {
+        PUBNUB_LOG_TRACE("Publishing a batch of %u messages on channel '%s'\n",
+                         batch->count,
+                         batch->channel);
+        clear(batch);
+        /* The publish may have finished already, which is still a start */
+        rslt = PNR_STARTED;
+    }
+
+    return rslt;
+}
+
+
+enum pubnub_res pubnub_coalesce_publish_due(pubnub_coalescer_t* c,
+                                            pubnub_t*           pb,
+                                            bool                force)
+{
+    unsigned long   now     = now_ms();
+    enum pubnub_res dropped = PNR_OK;
+    enum pubnub_res rslt;
+
+    PUBNUB_ASSERT_OPT(NULL != c);
+    PUBNUB_ASSERT_OPT(NULL != pb);
+
+    pubnub_mutex_lock(c->monitor);
+    for (;;) {
+        struct coalesce_batch* batch = oldest_due(c, force, now);
+        if (NULL == batch) {
+            rslt = dropped;
+            break;
+        }
+        rslt = publish_batch(batch, pb);
+        if ((PNR_STARTED == rslt) || (PNR_IN_PROGRESS == rslt)) {
+            /* If the context is busy, the batch will be published
+               when it is not */
+            break;
+        }
+        /* Otherwise, it would fail again (and again), holding up the
+           batches after it */
+        PUBNUB_LOG_ERROR("Failed to start publishing a batch of %u messages "
+                         "on channel '%s': %d('%s'), dropping it\n",
+                         batch->count,
+                         batch->channel,
+                         rslt,
+                         pubnub_res_2_string(rslt));
+        clear(batch);
+        dropped = rslt;
+    }
+    pubnub_mutex_unlock(c->monitor);
+
+    return rslt;
+}
+
+
+int pubnub_coalesce_next_due_ms(pubnub_coalescer_t* c)
+{
+    unsigned long now  = now_ms();
+    int           rslt = -1;
+    size_t        i;
+
+    PUBNUB_ASSERT_OPT(NULL != c);
+
+    pubnub_mutex_lock(c->monitor);
+    for (i = 0; i < c->n; ++i) {
+        struct coalesce_batch const* b = &c->batch[i];
+        int                          due_ms;
+        if (0 == b->count) {
+            continue;
+        }
+        if (is_due(c, b, now)) {
+            rslt = 0;
+            break;
+        }
+        due_ms = (int)(c->opt.max_delay_ms - (now - b->first_ms));
+        if ((rslt < 0) || (due_ms < rslt)) {
+            rslt = due_ms;
+        }
+    }
+    pubnub_mutex_unlock(c->monitor);
+
+    return rslt;
+}
+
+
+void pubnub_unbatcher_init(struct pubnub_unbatcher* u)
+{
+    PUBNUB_ASSERT_OPT(NULL != u);
+
+    u->envelope = NULL;
+    u->size     = 0;
+    u->next     = NULL;
+    u->end      = NULL;
+}
+
+
+void pubnub_unbatcher_deinit(struct pubnub_unbatcher* u)
+{
+    PUBNUB_ASSERT_OPT(NULL != u);
+
+    free(u->envelope);
+    pubnub_unbatcher_init(u);
+}
+
+
+bool pubnub_unbatcher_in_batch(struct pubnub_unbatcher const* u)
+{
+    PUBNUB_ASSERT_OPT(NULL != u);
+
+    return u->next < u->end;
+}
+
+
+/** If @p msg is a batch envelope, copies its messages to @p u.
+    @return Whether it is a batch envelope
+ */
+static bool take_envelope(struct pubnub_unbatcher* u, char const* msg)
+{
+    struct pbjson_elem el;
+    struct pbjson_elem batch;
+    char const*        start;
+    size_t             len;
+
+    el.start = pbjson_skip_whitespace(msg, msg + strlen(msg));
+    el.end   = msg + strlen(msg);
+    if ((el.start == el.end) || (*el.start != '{')
+        || (pbjson_get_object_value(&el, "pn_batch", &batch) != jonmpOK)
+        || (*batch.start != '[') || (batch.end[-1] != ']')) {
+        return false;
+    }
+    start = pbjson_skip_whitespace(batch.start + 1, batch.end - 1);
+    len   = batch.end - 1 - start;
+    if (len + 1 > u->size) {
+        char* envelope = (char*)realloc(u->envelope, len + 1);
+        if (NULL == envelope) {
+            PUBNUB_LOG_ERROR("Failed to allocate %lu bytes to unbatch messages\n",
+                             (unsigned long)(len + 1));
+            return false;
+        }
+        u->envelope = envelope;
+        u->size     = len + 1;
+    }
+    memcpy(u->envelope, start, len);
+    u->envelope[len] = '\0';
+    u->next          = u->envelope;
+    u->end           = u->envelope + len;
+
+    return true;
+}
+
+
+char const* pubnub_get_unbatched(pubnub_t* pb, struct pubnub_unbatcher* u)
+{
+    PUBNUB_ASSERT_OPT(NULL != u);
+
+    while (u->next >= u->end) {
+        char const* msg = pubnub_get(pb);
+        if (NULL == msg) {
+            return NULL;
+        }
+        if (!take_envelope(u, msg)) {
+            return msg;
+        }
+    }
+    {
+        char*       rslt  = (char*)u->next;
+        char*       after = (char*)pbjson_find_end_element(rslt, u->end) + 1;
+        char const* next  = pbjson_skip_whitespace(after, u->end);
+        if ((next < u->end) && (',' == *next)) {
+            next = pbjson_skip_whitespace(next + 1, u->end);
+        }
+        if (after < u->end) {
+            *after = '\0';
+        }
+        u->next = next;
+
+        return rslt;
+    }
+}
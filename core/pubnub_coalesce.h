@@ -0,0 +1,165 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PUBNUB_COALESCE
+#define INC_PUBNUB_COALESCE
+
+
+#include "pubnub_api_types.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+
+/** @file pubnub_coalesce.h
+    This is the "Publish coalescing" API. A coalescer keeps (small)
+    messages to publish, per channel, for a while, and then publishes
+    all the messages it has for a channel in a single publish
+    transaction. The payload of that publish is a "batch envelope":
+
+        {"pn_batch":[<message 1>,<message 2>,...]}
+
+    A batch of a single message is published as that message, without
+    the envelope.
+
+    On the subscribe side, use pubnub_get_unbatched() instead of
+    pubnub_get(), to get the messages from the envelopes, one by one.
+
+    The coalescer is thread-safe (if the C-core is built with
+    PUBNUB_THREADSAFE) and works with both the "sync" and the
+    "callback" interface, as it only starts the publish transactions.
+*/
+
+
+/** Options for a coalescer */
+struct pubnub_coalesce_options {
+    /** The maximum time, in milliseconds, to keep a message before
+        publishing it (in a batch). Default is 50.
+     */
+    unsigned max_delay_ms;
+    /** The maximum size of a batch (of its JSON), in bytes. When a
+        batch reaches it, it is due for publishing. Keep in mind that
+        the batch is URL-encoded in the publish request, which can
+        make it (up to) three times as long. Default is 4096.
+     */
+    size_t max_bytes;
+};
+
+
+/** A coalescer. It's an opaque type, use functions to work with it.
+ */
+typedef struct pubnub_coalescer pubnub_coalescer_t;
+
+
+/** This returns the default options for a coalescer. It's best to
+    always call it to initialize the #pubnub_coalesce_options.
+ */
+struct pubnub_coalesce_options pubnub_coalesce_defopts(void);
+
+/** Creates a coalescer with the options @p opt.
+    @return The coalescer, or NULL on failure to allocate
+ */
+pubnub_coalescer_t* pubnub_coalescer_create(struct pubnub_coalesce_options opt);
+
+/** Destroys the coalescer @p c. Messages that were not published are
+    dropped, so you might want to publish them first, with
+    pubnub_coalesce_publish_due() with @c force set.
+ */
+void pubnub_coalescer_destroy(pubnub_coalescer_t* c);
+
+/** Adds a @p message to publish on the @p channel to the coalescer
+    @p c. It will be published (in a batch) by one of the following
+    calls of pubnub_coalesce_publish_due().
+
+    @param c The coalescer
+    @param channel The channel to publish on. Can't be NULL
+    @param message The message to publish, JSON encoded. Can't be NULL
+    @retval PNR_OK The message was added
+    @retval PNR_INVALID_CHANNEL @p channel is empty
+    @retval PNR_TX_BUFF_TOO_SMALL The batch for the @p channel is
+    full, publish it (with pubnub_coalesce_publish_due()) and try
+    again - or, if @p message is longer than the max bytes of the
+    coalescer, it never fits in a batch
+    @retval PNR_REPLY_TOO_BIG Failed to allocate memory
+ */
+enum pubnub_res pubnub_coalesce_add(pubnub_coalescer_t* c,
+                                    char const*         channel,
+                                    char const*         message);
+
+/** Starts publishing, using the context @p pb, the batch (of the
+    coalescer @p c) that is due for publishing - that is, it is full,
+    or its oldest message is older than the max delay. If there is
+    more than one, the one with the oldest message is published.
+    If @p force, the batch with the oldest message is published, even
+    if it is not due.
+
+    Call it regularly (when @p pb is idle), like when a previous
+    publish finishes, or after pubnub_coalesce_next_due_ms().
+
+    If the publish of a batch fails to start because @p pb is busy
+    (PNR_IN_PROGRESS), the batch is kept, to be published later.
+    Otherwise, since it would fail again, it is logged and dropped, so
+    it doesn't hold up other batches, and the next due batch is
+    published instead.
+
+    @retval PNR_STARTED A publish of a batch is started, await its
+    outcome as usual (it may have finished already, in which case
+    awaiting will return its outcome right away)
+    @retval PNR_OK There is no batch to publish
+    @retval PNR_IN_PROGRESS @p pb is busy, the batch is kept
+    @retval other Failed to start the publish of the (last) batch that
+    was dropped, and there is no other batch to publish
+ */
+enum pubnub_res pubnub_coalesce_publish_due(pubnub_coalescer_t* c,
+                                            pubnub_t*           pb,
+                                            bool                force);
+
+/** Returns the time, in milliseconds, until the next batch of the
+    coalescer @p c is due. 0 if it already is, -1 if there are no
+    messages in the coalescer.
+ */
+int pubnub_coalesce_next_due_ms(pubnub_coalescer_t* c);
+
+
+/** Keeps the (split) batch envelope whose messages are being read
+    by pubnub_get_unbatched(). Initialize with
+    pubnub_unbatcher_init(), release with pubnub_unbatcher_deinit().
+ */
+struct pubnub_unbatcher {
+    /** Copy of the envelope, split in messages */
+    char* envelope;
+    /** Size of @c envelope */
+    size_t size;
+    /** Next message of the envelope to return */
+    char const* next;
+    /** End of the messages in @c envelope */
+    char const* end;
+};
+
+/** Initializes the unbatcher @p u */
+void pubnub_unbatcher_init(struct pubnub_unbatcher* u);
+
+/** Releases the resources of the unbatcher @p u */
+void pubnub_unbatcher_deinit(struct pubnub_unbatcher* u);
+
+/** Like pubnub_get(), but if the message is a batch envelope (made
+    by a coalescer), returns its messages, one by one, instead.
+    Messages that are not batch envelopes are returned as is.
+
+    The message returned is valid until the next call, or the
+    next transaction on @p pb. All messages from an envelope were
+    published on the same channel, so call pubnub_get_channel() only
+    when the first of them is returned - that is, when
+    pubnub_unbatcher_in_batch() is false before the call.
+
+    @param pb The Pubnub context
+    @param u The unbatcher to use, keeps the envelope being read
+    @return The next message, or NULL if there are no more
+ */
+char const* pubnub_get_unbatched(pubnub_t* pb, struct pubnub_unbatcher* u);
+
+/** Returns whether there are messages left in the envelope being
+    read by the unbatcher @p u.
+ */
+bool pubnub_unbatcher_in_batch(struct pubnub_unbatcher const* u);
+
+
+#endif /* !defined INC_PUBNUB_COALESCE */
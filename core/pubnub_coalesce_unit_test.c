@@ -0,0 +1,303 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "cgreen/cgreen.h"
+#include "cgreen/mocks.h"
+
+#include "pubnub_internal.h"
+
+#include "core/pubnub_coalesce.h"
+#include "core/pubnub_pubsubapi.h"
+#include "core/pubnub_helper.h"
+#include "core/pubnub_assert.h"
+
+#include <unistd.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+
+
+/* A less chatty cgreen :) */
+
+#define attest assert_that
+#define equals is_equal_to
+#define streqs is_equal_to_string
+#define differs is_not_equal_to
+#define strdifs is_not_equal_to_string
+#define ptreqs(val) is_equal_to_contents_of(&(val), sizeof(val))
+#define ptrdifs(val) is_not_equal_to_contents_of(&(val), sizeof(val))
+#define sets(par, val) will_set_contents_of_parameter(par, &(val), sizeof(val))
+#define sets_ex will_set_contents_of_parameter
+#define returns will_return
+
+
+enum { MAX_PUBLISHED = 10, MAX_RECEIVED = 10 };
+
+static pubnub_t m_ctx;
+
+static pubnub_coalescer_t* m_coalescer;
+
+/** The publishes started (or tried to). Publishing on channel "bad"
+    fails to start (as if it was too long), and on any channel while
+    `m_busy`, too (as if a transaction was in progress).
+ */
+static struct published {
+    char channel[16];
+    char message[256];
+} m_published[MAX_PUBLISHED];
+static int  m_publishes;
+static bool m_busy;
+
+/** The messages pubnub_get() returns, as if they were received */
+static char const* m_received[MAX_RECEIVED];
+static int         m_received_len;
+static int         m_get;
+
+
+enum pubnub_res pubnub_publish(pubnub_t* pb, const char* channel, const char* message)
+{
+    attest(pb, equals(&m_ctx));
+    if (m_busy) {
+        return PNR_IN_PROGRESS;
+    }
+    attest(m_publishes, is_less_than(MAX_PUBLISHED));
+    attest(strlen(message), is_less_than(sizeof m_published[0].message));
+    snprintf(m_published[m_publishes].channel,
+             sizeof m_published[0].channel,
+             "%s",
+             channel);
+    snprintf(m_published[m_publishes].message,
+             sizeof m_published[0].message,
+             "%s",
+             message);
+    ++m_publishes;
+
+    return (0 == strcmp(channel, "bad")) ? PNR_TX_BUFF_TOO_SMALL : PNR_STARTED;
+}
+
+
+char const* pubnub_get(pubnub_t* pb)
+{
+    attest(pb, equals(&m_ctx));
+    return (m_get < m_received_len) ? m_received[m_get++] : NULL;
+}
+
+
+char const* pubnub_res_2_string(enum pubnub_res e)
+{
+    PUBNUB_UNUSED(e);
+    return "";
+}
+
+
+static void create(unsigned max_delay_ms, size_t max_bytes)
+{
+    struct pubnub_coalesce_options opt = pubnub_coalesce_defopts();
+    opt.max_delay_ms                   = max_delay_ms;
+    opt.max_bytes                      = max_bytes;
+    m_coalescer                        = pubnub_coalescer_create(opt);
+    attest(m_coalescer, differs(NULL));
+}
+
+
+static void receive(char const* message)
+{
+    PUBNUB_ASSERT_OPT(m_received_len < MAX_RECEIVED);
+    m_received[m_received_len++] = message;
+}
+
+
+Describe(pubnub_coalesce);
+
+
+BeforeEach(pubnub_coalesce) {
+    m_coalescer    = NULL;
+    m_publishes    = 0;
+    m_busy         = false;
+    m_received_len = 0;
+    m_get          = 0;
+}
+
+
+AfterEach(pubnub_coalesce) {
+    if (m_coalescer != NULL) {
+        pubnub_coalescer_destroy(m_coalescer);
+    }
+}
+
+
+Ensure(pubnub_coalesce, single_message_is_published_without_envelope) {
+    create(1000, 4096);
+    attest(pubnub_coalesce_next_due_ms(m_coalescer), equals(-1));
+    attest(pubnub_coalesce_add(m_coalescer, "ch", "{\"a\":1}"), equals(PNR_OK));
+    attest(pubnub_coalesce_publish_due(m_coalescer, &m_ctx, true), equals(PNR_STARTED));
+    attest(m_publishes, equals(1));
+    attest(m_published[0].channel, streqs("ch"));
+    attest(m_published[0].message, streqs("{\"a\":1}"));
+
+    attest(pubnub_coalesce_publish_due(m_coalescer, &m_ctx, true), equals(PNR_OK));
+    attest(pubnub_coalesce_next_due_ms(m_coalescer), equals(-1));
+}
+
+
+Ensure(pubnub_coalesce, messages_of_a_channel_are_published_in_an_envelope) {
+    create(1000, 4096);
+    attest(pubnub_coalesce_add(m_coalescer, "ch", "1"), equals(PNR_OK));
+    attest(pubnub_coalesce_add(m_coalescer, "other", "\"x\""), equals(PNR_OK));
+    attest(pubnub_coalesce_add(m_coalescer, "ch", "{\"a\":\"b,c\"}"), equals(PNR_OK));
+    attest(pubnub_coalesce_add(m_coalescer, "ch", "\"x]\""), equals(PNR_OK));
+
+    /* The batch with the oldest message goes first */
+    attest(pubnub_coalesce_publish_due(m_coalescer, &m_ctx, true), equals(PNR_STARTED));
+    attest(pubnub_coalesce_publish_due(m_coalescer, &m_ctx, true), equals(PNR_STARTED));
+    attest(pubnub_coalesce_publish_due(m_coalescer, &m_ctx, true), equals(PNR_OK));
+    attest(m_publishes, equals(2));
+    attest(m_published[0].channel, streqs("ch"));
+    attest(m_published[0].message,
+           streqs("{\"pn_batch\":[1,{\"a\":\"b,c\"},\"x]\"]}"));
+    attest(m_published[1].channel, streqs("other"));
+    attest(m_published[1].message, streqs("\"x\""));
+}
+
+
+Ensure(pubnub_coalesce, envelope_round_trips_through_unbatcher) {
+    static char const* const messages[] = {
+        "{\"a\":[1,2],\"b\":\"x,y\"}", "\"str, with ]\"", "42", "[1,[2,{}]]"
+    };
+    struct pubnub_unbatcher u;
+    size_t                  i;
+
+    create(1000, 4096);
+    for (i = 0; i < sizeof messages / sizeof messages[0]; ++i) {
+        attest(pubnub_coalesce_add(m_coalescer, "ch", messages[i]), equals(PNR_OK));
+    }
+    attest(pubnub_coalesce_publish_due(m_coalescer, &m_ctx, true), equals(PNR_STARTED));
+
+    receive("\"plain\"");
+    receive(m_published[0].message);
+    receive("{\"pn_batch\":[]}");
+    receive(" { \"pn_batch\" : [ true , null ] } ");
+    receive("{\"pn_other\":[1,2]}");
+
+    pubnub_unbatcher_init(&u);
+    attest(pubnub_get_unbatched(&m_ctx, &u), streqs("\"plain\""));
+    attest(pubnub_unbatcher_in_batch(&u), equals(false));
+    for (i = 0; i < sizeof messages / sizeof messages[0]; ++i) {
+        attest(pubnub_get_unbatched(&m_ctx, &u), streqs(messages[i]));
+        attest(pubnub_unbatcher_in_batch(&u), equals(i + 1 < sizeof messages / sizeof messages[0]));
+    }
+    /* An empty envelope has no messages */
+    attest(pubnub_get_unbatched(&m_ctx, &u), streqs("true"));
+    attest(pubnub_unbatcher_in_batch(&u), equals(true));
+    attest(pubnub_get_unbatched(&m_ctx, &u), streqs("null"));
+    attest(pubnub_get_unbatched(&m_ctx, &u), streqs("{\"pn_other\":[1,2]}"));
+    attest(pubnub_get_unbatched(&m_ctx, &u), equals(NULL));
+    pubnub_unbatcher_deinit(&u);
+}
+
+
+Ensure(pubnub_coalesce, full_batch_is_due) {
+    /* {"pn_batch":[ is 13 characters, ]} is 2 */
+    create(100000, 13 + 2 + 11);
+    attest(pubnub_coalesce_add(m_coalescer, "ch", "12345"), equals(PNR_OK));
+    attest(pubnub_coalesce_next_due_ms(m_coalescer), is_greater_than(0));
+    attest(pubnub_coalesce_publish_due(m_coalescer, &m_ctx, false), equals(PNR_OK));
+    attest(m_publishes, equals(0));
+
+    attest(pubnub_coalesce_add(m_coalescer, "ch", "123456"), equals(PNR_TX_BUFF_TOO_SMALL));
+    attest(pubnub_coalesce_add(m_coalescer, "ch", "12345"), equals(PNR_OK));
+    attest(pubnub_coalesce_next_due_ms(m_coalescer), equals(0));
+    attest(pubnub_coalesce_publish_due(m_coalescer, &m_ctx, false), equals(PNR_STARTED));
+    attest(m_published[0].message, streqs("{\"pn_batch\":[12345,12345]}"));
+
+    attest(pubnub_coalesce_add(m_coalescer, "ch", "123456"), equals(PNR_OK));
+    attest(pubnub_coalesce_next_due_ms(m_coalescer), is_greater_than(0));
+}
+
+
+Ensure(pubnub_coalesce, batch_that_had_no_room_is_due) {
+    create(100000, 13 + 2 + 11);
+    attest(pubnub_coalesce_add(m_coalescer, "ch", "1"), equals(PNR_OK));
+    attest(pubnub_coalesce_add(m_coalescer, "ch", "123456789012"), equals(PNR_TX_BUFF_TOO_SMALL));
+    attest(pubnub_coalesce_next_due_ms(m_coalescer), equals(0));
+    attest(pubnub_coalesce_publish_due(m_coalescer, &m_ctx, false), equals(PNR_STARTED));
+    attest(m_published[0].message, streqs("1"));
+}
+
+
+Ensure(pubnub_coalesce, message_longer_than_max_bytes_is_rejected) {
+    create(1000, 16);
+    attest(pubnub_coalesce_add(m_coalescer, "ch", "\"123456789012345\""), equals(PNR_TX_BUFF_TOO_SMALL));
+    attest(pubnub_coalesce_next_due_ms(m_coalescer), equals(-1));
+    attest(pubnub_coalesce_add(m_coalescer, "ch", "\"1234567890123\""), equals(PNR_OK));
+    attest(pubnub_coalesce_publish_due(m_coalescer, &m_ctx, true), equals(PNR_STARTED));
+    attest(m_published[0].message, streqs("\"1234567890123\""));
+}
+
+
+Ensure(pubnub_coalesce, batch_is_due_after_max_delay) {
+    int due_ms;
+
+    create(30, 4096);
+    attest(pubnub_coalesce_add(m_coalescer, "ch", "1"), equals(PNR_OK));
+    due_ms = pubnub_coalesce_next_due_ms(m_coalescer);
+    attest(due_ms, is_greater_than(0));
+    attest(due_ms, is_less_than(31));
+    attest(pubnub_coalesce_publish_due(m_coalescer, &m_ctx, false), equals(PNR_OK));
+    attest(m_publishes, equals(0));
+
+    usleep(40000);
+    attest(pubnub_coalesce_add(m_coalescer, "ch", "2"), equals(PNR_OK));
+    attest(pubnub_coalesce_next_due_ms(m_coalescer), equals(0));
+    attest(pubnub_coalesce_publish_due(m_coalescer, &m_ctx, false), equals(PNR_STARTED));
+    attest(m_published[0].message, streqs("{\"pn_batch\":[1,2]}"));
+}
+
+
+Ensure(pubnub_coalesce, batch_failing_to_start_is_dropped_and_next_one_published) {
+    create(1000, 4096);
+    attest(pubnub_coalesce_add(m_coalescer, "bad", "1"), equals(PNR_OK));
+    attest(pubnub_coalesce_add(m_coalescer, "bad", "2"), equals(PNR_OK));
+    attest(pubnub_coalesce_add(m_coalescer, "good", "3"), equals(PNR_OK));
+
+    attest(pubnub_coalesce_publish_due(m_coalescer, &m_ctx, true), equals(PNR_STARTED));
+    attest(m_publishes, equals(2));
+    attest(m_published[0].channel, streqs("bad"));
+    attest(m_published[1].channel, streqs("good"));
+    attest(m_published[1].message, streqs("3"));
+
+    /* The failed batch is not tried again */
+    attest(pubnub_coalesce_publish_due(m_coalescer, &m_ctx, true), equals(PNR_OK));
+    attest(m_publishes, equals(2));
+    attest(pubnub_coalesce_next_due_ms(m_coalescer), equals(-1));
+
+    /* and the channel can be used again */
+    attest(pubnub_coalesce_add(m_coalescer, "bad", "4"), equals(PNR_OK));
+    attest(pubnub_coalesce_publish_due(m_coalescer, &m_ctx, true), equals(PNR_TX_BUFF_TOO_SMALL));
+    attest(m_published[2].message, streqs("4"));
+    attest(pubnub_coalesce_publish_due(m_coalescer, &m_ctx, true), equals(PNR_OK));
+}
+
+
+Ensure(pubnub_coalesce, batch_is_kept_while_context_is_busy) {
+    create(1000, 4096);
+    attest(pubnub_coalesce_add(m_coalescer, "ch", "1"), equals(PNR_OK));
+    attest(pubnub_coalesce_add(m_coalescer, "ch", "2"), equals(PNR_OK));
+
+    m_busy = true;
+    attest(pubnub_coalesce_publish_due(m_coalescer, &m_ctx, true), equals(PNR_IN_PROGRESS));
+    attest(pubnub_coalesce_next_due_ms(m_coalescer), differs(-1));
+
+    m_busy = false;
+    attest(pubnub_coalesce_add(m_coalescer, "ch", "3"), equals(PNR_OK));
+    attest(pubnub_coalesce_publish_due(m_coalescer, &m_ctx, true), equals(PNR_STARTED));
+    attest(m_publishes, equals(1));
+    attest(m_published[0].message, streqs("{\"pn_batch\":[1,2,3]}"));
+}
+
+
+Ensure(pubnub_coalesce, empty_channel_is_invalid) {
+    create(1000, 4096);
+    attest(pubnub_coalesce_add(m_coalescer, "", "1"), equals(PNR_INVALID_CHANNEL));
+    attest(pubnub_coalesce_next_due_ms(m_coalescer), equals(-1));
+}
@@ -191,34 +191,16 @@ int pbpal_send_status(pubnub_t* pb)
     return (bool)mock(pb);
 }
 
-int pbpal_start_read_line(pubnub_t* pb)
+int pbpal_start_read_response(pubnub_t* pb)
 {
-    unsigned distance;
-
     PUBNUB_ASSERT_INT_OPT(pb->sock_state, ==, STATE_NONE);
 
-    if (pb->unreadlen > 0) {
-        PUBNUB_ASSERT_OPT((char*)(pb->ptr + pb->unreadlen)
-                          <= (char*)(pb->core.http_buf + PUBNUB_BUF_MAXLEN));
-        memmove(pb->core.http_buf, pb->ptr, pb->unreadlen);
-    }
-    distance = pb->ptr - (uint8_t*)pb->core.http_buf;
-    PUBNUB_ASSERT_UINT((distance + pb->left + pb->unreadlen),
-                       ==,
-                       (sizeof pb->core.http_buf / sizeof pb->core.http_buf[0]));
-    pb->ptr -= distance;
-    pb->left += distance;
-
-    pb->sock_state = STATE_READ_LINE;
+    pbhttp_parser_init(&pb->http_parser);
+    pb->sock_state = STATE_READ_RESPONSE;
 
     return +1;
 }
 
-int pbpal_read_len(pubnub_t* pb)
-{
-    return (char*)pb->ptr - pb->core.http_buf;
-}
-
 
 static int my_recv(void* p, size_t n)
 {
@@ -297,17 +279,35 @@ static int my_recv(void* p, size_t n)
     return to_read;
 }
 
-enum pubnub_res pbpal_line_read_status(pubnub_t* pb)
+static bool parse_unread(pubnub_t* pb)
 {
-    uint8_t c;
+    size_t parsed =
+        pbhttp_parse(&pb->http_parser, (char const*)pb->ptr, pb->unreadlen);
+
+    pb->ptr += parsed;
+    pb->unreadlen -= parsed;
+    switch (pb->http_parser.event) {
+    case pbhttpEvNone:
+        return false;
+    case pbhttpEvDone:
+    case pbhttpEvError:
+        pb->sock_state = STATE_NONE;
+        break;
+    default:
+        break;
+    }
+    return true;
+}
 
-    PUBNUB_ASSERT_OPT(STATE_READ_LINE == pb->sock_state);
+enum pubnub_res pbpal_read_response_status(pubnub_t* pb)
+{
+    PUBNUB_ASSERT_OPT(STATE_READ_RESPONSE == pb->sock_state);
 
-    if (pb->unreadlen == 0) {
+    while (!parse_unread(pb)) {
         int recvres;
-        PUBNUB_ASSERT_OPT((char*)(pb->ptr + pb->left)
-                          == (char*)(pb->core.http_buf + PUBNUB_BUF_MAXLEN));
-        recvres = my_recv((char*)pb->ptr, pb->left);
+        pb->ptr  = (uint8_t*)pb->core.http_buf;
+        pb->left = sizeof pb->core.http_buf / sizeof pb->core.http_buf[0];
+        recvres  = my_recv((char*)pb->ptr, pb->left);
         if (recvres < 0) {
             return PNR_IN_PROGRESS;
         }
@@ -322,95 +322,7 @@ enum pubnub_res pbpal_line_read_status(pubnub_t* pb)
         pb->left -= recvres;
     }
 
-    while (pb->unreadlen > 0) {
-        --pb->unreadlen;
-
-        c = *pb->ptr++;
-        if (c == '\n') {
-            PUBNUB_LOG_TRACE("pb=%p, newline found, line length: %d, ",
-                             pb,
-                             pbpal_read_len(pb));
-            WATCH_USHORT(pb->unreadlen);
-            pb->sock_state = STATE_NONE;
-            return PNR_OK;
-        }
-    }
-
-    if (pb->left == 0) {
-        PUBNUB_LOG_ERROR(
-            "pbpal_line_read_status(pb=%p): buffer full but newline not found", pb);
-        pb->sock_state = STATE_NONE;
-        return PNR_TX_BUFF_TOO_SMALL;
-    }
-
-    return PNR_IN_PROGRESS;
-}
-
-int pbpal_start_read(pubnub_t* pb, size_t n)
-{
-    unsigned distance;
-
-    PUBNUB_ASSERT_UINT_OPT(n, >, 0);
-    PUBNUB_ASSERT_INT_OPT(pb->sock_state, ==, STATE_NONE);
-
-    WATCH_USHORT(pb->unreadlen);
-    WATCH_USHORT(pb->left);
-    if (pb->unreadlen > 0) {
-        PUBNUB_ASSERT_OPT((char*)(pb->ptr + pb->unreadlen)
-                          <= (char*)(pb->core.http_buf + PUBNUB_BUF_MAXLEN));
-        memmove(pb->core.http_buf, pb->ptr, pb->unreadlen);
-    }
-    distance = pb->ptr - (uint8_t*)pb->core.http_buf;
-    WATCH_UINT(distance);
-    PUBNUB_ASSERT_UINT(distance + pb->unreadlen + pb->left,
-                       ==,
-                       sizeof pb->core.http_buf / sizeof pb->core.http_buf[0]);
-    pb->ptr -= distance;
-    pb->left += distance;
-
-    pb->sock_state = STATE_READ;
-    pb->len        = n;
-
-    return +1;
-}
-
-enum pubnub_res pbpal_read_status(pubnub_t* pb)
-{
-    int have_read;
-
-    PUBNUB_ASSERT_OPT(STATE_READ == pb->sock_state);
-
-    if (0 == pb->unreadlen) {
-        unsigned to_recv = pb->len;
-        if (to_recv > pb->left) {
-            to_recv = pb->left;
-        }
-        PUBNUB_ASSERT_OPT(to_recv > 0);
-        have_read = my_recv((char*)pb->ptr, to_recv);
-        if (have_read < 0) {
-            return PNR_IN_PROGRESS;
-        }
-        else if (0 == have_read) {
-            pb->sock_state = STATE_NONE;
-            return PNR_TIMEOUT;
-        }
-        PUBNUB_ASSERT_OPT(pb->left >= have_read);
-        pb->left -= have_read;
-    }
-    else {
-        have_read = (pb->unreadlen >= pb->len) ? pb->len : pb->unreadlen;
-        pb->unreadlen -= have_read;
-    }
-
-    pb->len -= have_read;
-    pb->ptr += have_read;
-
-    if ((0 == pb->len) || (0 == pb->left)) {
-        pb->sock_state = STATE_NONE;
-        return PNR_OK;
-    }
-
-    return PNR_IN_PROGRESS;
+    return PNR_OK;
 }
 
 
@@ -812,6 +724,29 @@ static inline void expect_outgoing_with_url(char const* url)
 }
 
 
+/* Like expect_outgoing_with_url(), but without asking for a
+ * compressed response (as in "streaming" subscribe)
+ */
+static inline void expect_outgoing_with_url_no_gzip(char const* url)
+{
+    expect(pbpal_send, when(data, streqs("GET ")), returns(0));
+    expect(pbpal_send_status, returns(0));
+    expect(pbpal_send_str, when(s, streqs(url)), returns(0));
+    expect(pbpal_send_status, returns(0));
+    expect(pbpal_send, when(data, streqs(" HTTP/1.1\r\nHost: ")), returns(0));
+    expect(pbpal_send_status, returns(0));
+    expect(pbpal_send_str, when(s, streqs(PUBNUB_ORIGIN)), returns(0));
+    expect(pbpal_send_status, returns(0));
+    expect(pbpal_send,
+           when(data,
+                streqs("\r\nUser-Agent: PubNub-C-core/" PUBNUB_SDK_VERSION
+                       "\r\n\r\n")),
+           returns(0));
+    expect(pbpal_send_status, returns(0));
+    expect(pbntf_watch_in_events, when(pb, equals(pbp)), returns(0));
+}
+
+
 static inline void incoming(char const* str, struct uint8_block* p_data)
 {
     if (str != NULL) {
@@ -1195,6 +1130,100 @@ Ensure(single_context_pubnub, publish)
     attest(pubnub_free(pbp), equals(-1));
 }
 
+Ensure(single_context_pubnub, publish_transaction_timings)
+{
+    struct pubnub_transaction_timings t;
+
+    pubnub_init(pbp, "publkey", "subkey");
+
+    expect_have_dns_for_pubnub_origin();
+    expect_outgoing_with_url(
+        "/publish/publkey/subkey/0/jarak/0/%22zec%22?pnsdk=unit-test-0.1");
+    incoming("HTTP/1.1 200\r\nContent-Length: "
+             "30\r\n\r\n[1,\"Sent\",\"14178940800777403\"]",
+             NULL);
+    expect(pbntf_lost_socket, when(pb, equals(pbp)));
+    expect(pbntf_trans_outcome, when(pb, equals(pbp)));
+    attest(pubnub_publish(pbp, "jarak", "\"zec\""), equals(PNR_OK));
+
+    attest(pubnub_last_transaction_timings(pbp, &t), equals(PNR_OK));
+    attest(t.dns_start >= 0);
+    attest(t.dns_end >= t.dns_start);
+    attest(t.connect >= t.dns_end);
+    attest(t.tls_handshake, equals(-1));
+    attest(t.request_sent >= t.connect);
+    attest(t.first_byte >= t.request_sent);
+    attest(t.body_received >= t.first_byte);
+    attest(t.parsed >= t.body_received);
+
+    /* On a kept-alive connection, there is no DNS nor connect */
+    expect(pbntf_enqueue_for_processing, when(pb, equals(pbp)), returns(0));
+    expect(pbntf_got_socket, when(pb, equals(pbp)), returns(0));
+    expect_outgoing_with_url(
+        "/publish/publkey/subkey/0/jarak/0/%22zec%22?pnsdk=unit-test-0.1");
+    incoming("HTTP/1.1 200\r\nContent-Length: "
+             "30\r\n\r\n[1,\"Sent\",\"14178940800777404\"]",
+             NULL);
+    expect(pbntf_lost_socket, when(pb, equals(pbp)));
+    expect(pbntf_trans_outcome, when(pb, equals(pbp)));
+    attest(pubnub_publish(pbp, "jarak", "\"zec\""), equals(PNR_OK));
+
+    attest(pubnub_last_transaction_timings(pbp, &t), equals(PNR_OK));
+    attest(t.dns_start, equals(-1));
+    attest(t.dns_end, equals(-1));
+    attest(t.connect, equals(-1));
+    attest(t.request_sent >= 0);
+    attest(t.first_byte >= t.request_sent);
+    attest(t.parsed >= t.first_byte);
+    attest(pubnub_free(pbp), equals(-1));
+}
+
+Ensure(single_context_pubnub, publish_metrics)
+{
+    struct pubnub_metrics_snapshot before;
+    struct pubnub_metrics_snapshot after;
+    char                           text[4096];
+
+    pubnub_init(pbp, "publkey", "subkey");
+    pubnub_metrics_snapshot(&before);
+
+    expect_have_dns_for_pubnub_origin();
+    expect_outgoing_with_url(
+        "/publish/publkey/subkey/0/jarak/0/%22zec%22?pnsdk=unit-test-0.1");
+    incoming("HTTP/1.1 200\r\nContent-Length: "
+             "30\r\n\r\n[1,\"Sent\",\"14178940800777403\"]",
+             NULL);
+    expect(pbntf_lost_socket, when(pb, equals(pbp)));
+    expect(pbntf_trans_outcome, when(pb, equals(pbp)));
+    attest(pubnub_publish(pbp, "jarak", "\"zec\""), equals(PNR_OK));
+
+    expect(pbntf_enqueue_for_processing, when(pb, equals(pbp)), returns(0));
+    expect(pbntf_got_socket, when(pb, equals(pbp)), returns(0));
+    expect_outgoing_with_url(
+        "/publish/publkey/subkey/0/jarak/0/%22zec%22?pnsdk=unit-test-0.1");
+    incoming("HTTP/1.1 200\r\nContent-Length: "
+             "30\r\n\r\n[1,\"Sent\",\"14178940800777404\"]",
+             NULL);
+    expect(pbntf_lost_socket, when(pb, equals(pbp)));
+    expect(pbntf_trans_outcome, when(pb, equals(pbp)));
+    attest(pubnub_publish(pbp, "jarak", "\"zec\""), equals(PNR_OK));
+
+    pubnub_metrics_snapshot(&after);
+    attest(after.counter[pbmcTransactions] - before.counter[pbmcTransactions],
+           equals(2));
+    attest(after.counter[pbmcConnections] - before.counter[pbmcConnections],
+           equals(1));
+    attest(after.counter[pbmcKeepAliveReuses]
+               - before.counter[pbmcKeepAliveReuses],
+           equals(1));
+
+    attest(pubnub_metrics_format_text(&after, text, sizeof text) > 0);
+    attest(strstr(text, "# TYPE pubnub_transactions_total counter\n") != NULL);
+    attest(strstr(text, "pubnub_poll_loop_lag_ms_bucket{le=\"+Inf\"}") != NULL);
+    attest(pubnub_metrics_format_text(&after, text, 10), equals(-1));
+    attest(pubnub_free(pbp), equals(-1));
+}
+
 Ensure(single_context_pubnub, publish_change_origin)
 {
     pubnub_init(pbp, "publkey", "subkey");
@@ -1232,6 +1261,164 @@ Ensure(single_context_pubnub, publish_change_origin)
     attest(pubnub_free(pbp), equals(-1));
 }
 
+Ensure(single_context_pubnub, publish_change_origin_closes_keep_alive_connection)
+{
+    pubnub_init(pbp, "publkey", "subkey");
+    expect_have_dns_for_pubnub_origin();
+    expect_outgoing_with_url(
+        "/publish/publkey/subkey/0/jarak/0/%22zec%22?pnsdk=unit-test-0.1");
+    incoming("HTTP/1.1 200\r\nContent-Length: "
+             "30\r\n\r\n[1,\"Sent\",\"14178940800777403\"]",
+             NULL);
+    expect(pbntf_lost_socket, when(pb, equals(pbp)));
+    expect(pbntf_trans_outcome, when(pb, equals(pbp)));
+    attest(pubnub_publish(pbp, "jarak", "\"zec\""), equals(PNR_OK));
+
+    attest(pubnub_origin_set(pbp, "new_origin_server"), equals(0));
+
+    /* Kept alive connection is to the previous origin, so it is
+       closed and a new one is made */
+    expect(pbntf_enqueue_for_processing, when(pb, equals(pbp)), returns(0));
+    expect(pbntf_got_socket, when(pb, equals(pbp)), returns(0));
+    expect(pbpal_close, when(pb, equals(pbp)), returns(0));
+    expect(pbpal_forget, when(pb, equals(pbp)));
+    expect(pbpal_resolv_and_connect,
+           when(pb, equals(pbp)),
+           returns(pbpal_connect_success));
+    expect(pbntf_got_socket, when(pb, equals(pbp)), returns(0));
+    expect(pbpal_send, when(data, streqs("GET ")), returns(0));
+    expect(pbpal_send_status, returns(0));
+    expect(pbpal_send_str,
+           when(s, streqs("/publish/publkey/subkey/0/jarak/0/%22zec%22?pnsdk=unit-test-0.1")),
+           returns(0));
+    expect(pbpal_send_status, returns(0));
+    expect(pbpal_send, when(data, streqs(" HTTP/1.1\r\nHost: ")), returns(0));
+    expect(pbpal_send_status, returns(0));
+    expect(pbpal_send_str, when(s, streqs("new_origin_server")), returns(0));
+    expect(pbpal_send_status, returns(0));
+    expect(pbpal_send,
+           when(data,
+                streqs("\r\nUser-Agent: PubNub-C-core/" PUBNUB_SDK_VERSION
+                       "\r\n" ACCEPT_ENCODING "\r\n")),
+           returns(0));
+    expect(pbpal_send_status, returns(0));
+    expect(pbntf_watch_in_events, when(pb, equals(pbp)), returns(0));
+    incoming("HTTP/1.1 200\r\nContent-Length: "
+             "30\r\n\r\n[1,\"Sent\",\"14178940800777404\"]",
+             NULL);
+    expect(pbntf_lost_socket, when(pb, equals(pbp)));
+    expect(pbntf_trans_outcome, when(pb, equals(pbp)));
+    attest(pubnub_publish(pbp, "jarak", "\"zec\""), equals(PNR_OK));
+    attest(pubnub_last_publish_result(pbp), streqs("\"Sent\""));
+    attest(pubnub_free(pbp), equals(-1));
+}
+
+Ensure(single_context_pubnub, preconnect_parks_connection_for_publish)
+{
+    pubnub_init(pbp, "publkey", "subkey");
+    expect_have_dns_for_pubnub_origin();
+    expect(pbntf_lost_socket, when(pb, equals(pbp)));
+    expect(pbntf_trans_outcome, when(pb, equals(pbp)));
+    attest(pubnub_preconnect(pbp), equals(PNR_OK));
+    attest(pbp->state, equals(PBS_KEEP_ALIVE_IDLE));
+
+    /* Already connected */
+    expect(pbntf_enqueue_for_processing, when(pb, equals(pbp)), returns(0));
+    expect(pbntf_got_socket, when(pb, equals(pbp)), returns(0));
+    expect(pbntf_lost_socket, when(pb, equals(pbp)));
+    expect(pbntf_trans_outcome, when(pb, equals(pbp)));
+    attest(pubnub_preconnect(pbp), equals(PNR_OK));
+    attest(pbp->state, equals(PBS_KEEP_ALIVE_IDLE));
+
+    expect(pbntf_enqueue_for_processing, when(pb, equals(pbp)), returns(0));
+    expect(pbntf_got_socket, when(pb, equals(pbp)), returns(0));
+    expect_outgoing_with_url(
+        "/publish/publkey/subkey/0/jarak/0/%22zec%22?pnsdk=unit-test-0.1");
+    incoming("HTTP/1.1 200\r\nContent-Length: "
+             "30\r\n\r\n[1,\"Sent\",\"14178940800777403\"]",
+             NULL);
+    expect(pbntf_lost_socket, when(pb, equals(pbp)));
+    expect(pbntf_trans_outcome, when(pb, equals(pbp)));
+    attest(pubnub_publish(pbp, "jarak", "\"zec\""), equals(PNR_OK));
+    attest(pubnub_last_publish_result(pbp), streqs("\"Sent\""));
+    attest(pubnub_free(pbp), equals(-1));
+}
+
+Ensure(single_context_pubnub, keep_alive_rewarm_reconnects_when_limits_reached)
+{
+    pubnub_init(pbp, "publkey", "subkey");
+    pubnub_set_keep_alive_param(pbp, 50, 1);
+    pubnub_set_keep_alive_rewarm(pbp, true);
+
+    /* The outcome is reported before reconnecting */
+    expect_have_dns_for_pubnub_origin();
+    expect_outgoing_with_url(
+        "/publish/publkey/subkey/0/jarak/0/%22zec%22?pnsdk=unit-test-0.1");
+    incoming("HTTP/1.1 200\r\nContent-Length: "
+             "30\r\n\r\n[1,\"Sent\",\"14178940800777403\"]",
+             NULL);
+    expect(pbntf_lost_socket, when(pb, equals(pbp)));
+    expect(pbntf_trans_outcome, when(pb, equals(pbp)));
+    expect(pbntf_requeue_for_processing, when(pb, equals(pbp)), returns(0));
+    attest(pubnub_publish(pbp, "jarak", "\"zec\""), equals(PNR_OK));
+    attest(pbp->state, equals(PBS_KEEP_ALIVE_IDLE));
+    attest(pubnub_last_publish_result(pbp), streqs("\"Sent\""));
+
+    /* Then, on the next tick, the connection is made again */
+    expect(pbntf_enqueue_for_processing, when(pb, equals(pbp)), returns(0));
+    expect(pbntf_got_socket, when(pb, equals(pbp)), returns(0));
+    expect(pbpal_close, when(pb, equals(pbp)), returns(0));
+    expect(pbpal_forget, when(pb, equals(pbp)));
+    expect(pbpal_resolv_and_connect,
+           when(pb, equals(pbp)),
+           returns(pbpal_connect_success));
+    expect(pbntf_got_socket, when(pb, equals(pbp)), returns(0));
+    expect(pbntf_lost_socket, when(pb, equals(pbp)));
+    expect(pbntf_trans_outcome, when(pb, equals(pbp)));
+    attest(pbnc_fsm(pbp), equals(0));
+    attest(pbp->trans, equals(PBTT_PRECONNECT));
+    attest(pbp->core.last_result, equals(PNR_OK));
+    attest(pbp->state, equals(PBS_KEEP_ALIVE_IDLE));
+
+    /* A stale tick doesn't start anything */
+    attest(pbnc_fsm(pbp), equals(0));
+    attest(pbp->state, equals(PBS_KEEP_ALIVE_IDLE));
+
+    /* Next one goes over the new connection */
+    expect(pbntf_enqueue_for_processing, when(pb, equals(pbp)), returns(0));
+    expect(pbntf_got_socket, when(pb, equals(pbp)), returns(0));
+    expect_outgoing_with_url(
+        "/publish/publkey/subkey/0/jarak/0/%22zec%22?pnsdk=unit-test-0.1");
+    incoming("HTTP/1.1 200\r\nContent-Length: "
+             "30\r\n\r\n[1,\"Sent\",\"14178940800777404\"]",
+             NULL);
+    expect(pbntf_lost_socket, when(pb, equals(pbp)));
+    expect(pbntf_trans_outcome, when(pb, equals(pbp)));
+    expect(pbntf_requeue_for_processing, when(pb, equals(pbp)), returns(0));
+    attest(pubnub_publish(pbp, "jarak", "\"zec\""), equals(PNR_OK));
+
+    /* A transaction started before the tick reconnects by itself */
+    expect(pbntf_enqueue_for_processing, when(pb, equals(pbp)), returns(0));
+    expect(pbntf_got_socket, when(pb, equals(pbp)), returns(0));
+    expect(pbpal_close, when(pb, equals(pbp)), returns(0));
+    expect(pbpal_forget, when(pb, equals(pbp)));
+    expect(pbpal_resolv_and_connect,
+           when(pb, equals(pbp)),
+           returns(pbpal_connect_success));
+    expect(pbntf_got_socket, when(pb, equals(pbp)), returns(0));
+    expect_outgoing_with_url(
+        "/publish/publkey/subkey/0/jarak/0/%22zec%22?pnsdk=unit-test-0.1");
+    incoming("HTTP/1.1 200\r\nContent-Length: "
+             "30\r\n\r\n[1,\"Sent\",\"14178940800777405\"]",
+             NULL);
+    expect(pbntf_lost_socket, when(pb, equals(pbp)));
+    expect(pbntf_trans_outcome, when(pb, equals(pbp)));
+    expect(pbntf_requeue_for_processing, when(pb, equals(pbp)), returns(0));
+    attest(pubnub_publish(pbp, "jarak", "\"zec\""), equals(PNR_OK));
+    attest(pubnub_last_publish_result(pbp), streqs("\"Sent\""));
+    attest(pubnub_free(pbp), equals(-1));
+}
+
 Ensure(single_context_pubnub, publish_http_chunked)
 {
     pubnub_init(pbp, "publkey", "subkey");
@@ -1860,7 +2047,6 @@ Ensure(single_context_pubnub, state_get_in_progress_interrupted_and_accomplished
 
     /* rolling rock */
     attest(pbnc_fsm(pbp), equals(0));
-    attest(pbnc_fsm(pbp), equals(0));
     attest(pbp->core.last_result, equals(PNR_OK));
 
     attest(pubnub_get(pbp), streqs("{\"status\":200,\"message\":\"OK\",\"service\":\"Presence\",\"payload\":{free_state_of_jones}}"));
@@ -1955,8 +2141,7 @@ Ensure(single_context_pubnub, here_now_channelgroups)
              NULL);
     expect(pbntf_lost_socket, when(pb, equals(pbp)));
     expect(pbntf_trans_outcome, when(pb, equals(pbp)));
-    attest(pubnub_here_now(pbp, NULL, "[gr2,gr1]"), equals(PNR_STARTED));
-    attest(pbnc_fsm(pbp), equals(0));
+    attest(pubnub_here_now(pbp, NULL, "[gr2,gr1]"), equals(PNR_OK));
     attest(pbp->core.last_result, equals(PNR_OK));
 
     attest(pubnub_get(pbp),
@@ -1992,8 +2177,7 @@ Ensure(single_context_pubnub, here_now_channel_and_channelgroups)
              NULL);
     expect(pbntf_lost_socket, when(pb, equals(pbp)));
     expect(pbntf_trans_outcome, when(pb, equals(pbp)));
-    attest(pubnub_here_now(pbp, "[ch1,ch2]", "[gr3,gr4]"), equals(PNR_STARTED));
-    attest(pbnc_fsm(pbp), equals(0));
+    attest(pubnub_here_now(pbp, "[ch1,ch2]", "[gr3,gr4]"), equals(PNR_OK));
     attest(pbp->core.last_result, equals(PNR_OK));
 
     attest(pubnub_get(pbp),
@@ -2040,8 +2224,7 @@ Ensure(single_context_pubnub, here_now_channel_and_channelgroups_chunked)
              NULL);
     expect(pbntf_lost_socket, when(pb, equals(pbp)));
     expect(pbntf_trans_outcome, when(pb, equals(pbp)));
-    attest(pubnub_here_now(pbp, "[ch1,ch2]", "[gr3,gr4]"), equals(PNR_STARTED));
-    attest(pbnc_fsm(pbp), equals(0));
+    attest(pubnub_here_now(pbp, "[ch1,ch2]", "[gr3,gr4]"), equals(PNR_OK));
     attest(pbp->core.last_result, equals(PNR_OK));
 
     attest(pubnub_get(pbp),
@@ -2071,6 +2254,8 @@ Ensure(single_context_pubnub, here_now_in_progress_interrupted_and_accomplished)
     incoming("HTTP/1.1 200\r\nTransfer-Encoding: "
              "chunked\r\n\r\n122\r\n{\"status\":200,\"mes",
              NULL);
+    /* Keeps fsm in progress */
+    incoming("", NULL);
 
     attest(pubnub_here_now(pbp, "[ch5,ch7]", "[gr1,gr2]"), equals(PNR_STARTED));
     attest(pubnub_here_now(pbp, "ch", NULL), equals(PNR_IN_PROGRESS));
@@ -2120,10 +2305,7 @@ Ensure(single_context_pubnub, global_here_now)
              NULL);
     expect(pbntf_lost_socket, when(pb, equals(pbp)));
     expect(pbntf_trans_outcome, when(pb, equals(pbp)));
-    attest(pubnub_global_here_now(pbp), equals(PNR_STARTED));
-    attest(pubnub_global_here_now(pbp), equals(PNR_IN_PROGRESS));
-
-    attest(pbnc_fsm(pbp), equals(0));
+    attest(pubnub_global_here_now(pbp), equals(PNR_OK));
     attest(pbp->core.last_result, equals(PNR_OK));
 
     attest(pubnub_get(pbp),
@@ -2164,9 +2346,7 @@ Ensure(single_context_pubnub, global_here_now_chunked)
              NULL);
     expect(pbntf_lost_socket, when(pb, equals(pbp)));
     expect(pbntf_trans_outcome, when(pb, equals(pbp)));
-    attest(pubnub_global_here_now(pbp), equals(PNR_STARTED));
-
-    attest(pbnc_fsm(pbp), equals(0));
+    attest(pubnub_global_here_now(pbp), equals(PNR_OK));
     attest(pbp->core.last_result, equals(PNR_OK));
 
     attest(pubnub_get(pbp),
@@ -2208,7 +2388,6 @@ Ensure(single_context_pubnub, global_here_now_in_progress_interrupted_and_acompl
 
     /* roll the rock */
     attest(pbnc_fsm(pbp), equals(0));
-    attest(pbnc_fsm(pbp), equals(0));
     attest(pbp->core.last_result, equals(PNR_OK));
 
     attest(pubnub_get(pbp),
@@ -2325,7 +2504,6 @@ Ensure(single_context_pubnub, where_now_in_progress_interrupted_and_accomplished
              NULL);
 
     /* Push until finished */
-    attest(pbnc_fsm(pbp), equals(0));
     expect(pbntf_lost_socket, when(pb, equals(pbp)));
     expect(pbntf_trans_outcome, when(pb, equals(pbp)));
     attest(pbnc_fsm(pbp), equals(0));
@@ -2447,7 +2625,6 @@ Ensure(single_context_pubnub,
              "\"Presence\"}",
              NULL);
     /* Push until finished */
-    attest(pbnc_fsm(pbp), equals(0));
     expect(pbntf_lost_socket, when(pb, equals(pbp)));
     expect(pbntf_trans_outcome, when(pb, equals(pbp)));
     attest(pbnc_fsm(pbp), equals(0));
@@ -2508,7 +2685,6 @@ Ensure(single_context_pubnub, add_channel_to_group_interrupted_and_accomplished)
              "\"OK\"}",
              NULL);
     /* keep 'turning' it until finished */
-    attest(pbnc_fsm(pbp), equals(0));
     expect(pbntf_lost_socket, when(pb, equals(pbp)));
     expect(pbntf_trans_outcome, when(pb, equals(pbp)));
     attest(pbnc_fsm(pbp), equals(0));
@@ -2568,7 +2744,6 @@ Ensure(single_context_pubnub, remove_channel_from_group_interrupted_and_accompli
              "\"error\":false,\"message\":\"OK\"}",
              NULL);
     /* keep 'turning' it until finished */
-    attest(pbnc_fsm(pbp), equals(0));
     expect(pbntf_lost_socket, when(pb, equals(pbp)));
     expect(pbntf_trans_outcome, when(pb, equals(pbp)));
     attest(pbnc_fsm(pbp), equals(0));
@@ -2625,7 +2800,6 @@ Ensure(single_context_pubnub, remove_channel_group_interrupted_and_accomplished)
              "200,\"error\" : false ,\"message\":\"OK\"}",
              NULL);
     /* keep 'turning' it until finished */
-    attest(pbnc_fsm(pbp), equals(0));
     expect(pbntf_lost_socket, when(pb, equals(pbp)));
     expect(pbntf_trans_outcome, when(pb, equals(pbp)));
     attest(pbnc_fsm(pbp), equals(0));
@@ -2688,7 +2862,6 @@ Ensure(single_context_pubnub, list_channel_group_interrupted_and_accomplished)
              "\"xg37\",...}}}",
              NULL);
     /* keep 'turning' it until finished */
-    attest(pbnc_fsm(pbp), equals(0));
     expect(pbntf_lost_socket, when(pb, equals(pbp)));
     expect(pbntf_trans_outcome, when(pb, equals(pbp)));
     attest(pbnc_fsm(pbp), equals(0));
@@ -2750,6 +2923,75 @@ Ensure(single_context_pubnub, subscribe)
     attest(pubnub_free(pbp), equals(-1));
 }
 
+/* Messages delivered by "streaming" subscribe and the index of the
+ * simulated incoming data being read when each of them was delivered
+ */
+static char m_streamed_msgs[10][40];
+static int  m_streamed_at[10];
+static int  m_streamed_count;
+
+static void stream_msg_cb(pubnub_t* pb, char const* msg, size_t len, void* user_data)
+{
+    attest(pb, equals(pbp));
+    attest(user_data, equals(&m_streamed_count));
+    attest(strlen(msg), equals(len));
+    assert(m_streamed_count < 10);
+    assert(len < sizeof m_streamed_msgs[0]);
+    strcpy(m_streamed_msgs[m_streamed_count], msg);
+    m_streamed_at[m_streamed_count++] = m_i;
+}
+
+Ensure(single_context_pubnub, subscribe_streaming)
+{
+    m_streamed_count = 0;
+    pubnub_init(pbp, "publ-stream", "sub-stream");
+    attest(pubnub_set_streaming_subscribe(pbp, stream_msg_cb, &m_streamed_count),
+           equals(PNR_OK));
+
+    expect_have_dns_for_pubnub_origin();
+    expect_outgoing_with_url_no_gzip(
+        "/subscribe/sub-stream/river/0/0?pnsdk=unit-test-0.1");
+    incoming("HTTP/1.1 200\r\nTransfer-Encoding: chunked\r\n\r\n"
+             "15\r\n[[{\"a\":\"b,c\"},\"x\\\"]\",\r\n",
+             NULL);
+    incoming("21\r\n[1,2],\"end\"],\"15167149789251234\"]\r\n0\r\n", NULL);
+    expect(pbntf_lost_socket, when(pb, equals(pbp)));
+    expect(pbntf_trans_outcome, when(pb, equals(pbp)));
+    attest(pubnub_subscribe(pbp, "river", NULL), equals(PNR_OK));
+
+    attest(m_streamed_count, equals(4));
+    attest(m_streamed_msgs[0], streqs("{\"a\":\"b,c\"}"));
+    attest(m_streamed_msgs[1], streqs("\"x\\\"]\""));
+    attest(m_streamed_msgs[2], streqs("[1,2]"));
+    attest(m_streamed_msgs[3], streqs("\"end\""));
+    /* The first two were delivered before the second chunk arrived */
+    attest(m_streamed_at[0], equals(1));
+    attest(m_streamed_at[1], equals(1));
+    attest(m_streamed_at[2], equals(2));
+    attest(pubnub_get(pbp), equals(NULL));
+    attest(pubnub_last_time_token(pbp), streqs("15167149789251234"));
+    attest(pubnub_last_http_code(pbp), equals(200));
+
+    m_streamed_count = 0;
+    expect(pbntf_enqueue_for_processing, when(pb, equals(pbp)), returns(0));
+    expect(pbntf_got_socket, when(pb, equals(pbp)), returns(0));
+    expect_outgoing_with_url_no_gzip("/subscribe/sub-stream/river/0/"
+                                     "15167149789251234?pnsdk=unit-test-0.1");
+    incoming("HTTP/1.1 200\r\nContent-Length: "
+             "40\r\n\r\n[[\"halo\",{\"x\":[3]}],\"15167149789251299\"]",
+             NULL);
+    expect(pbntf_lost_socket, when(pb, equals(pbp)));
+    expect(pbntf_trans_outcome, when(pb, equals(pbp)));
+    attest(pubnub_subscribe(pbp, "river", NULL), equals(PNR_OK));
+
+    attest(m_streamed_count, equals(2));
+    attest(m_streamed_msgs[0], streqs("\"halo\""));
+    attest(m_streamed_msgs[1], streqs("{\"x\":[3]}"));
+    attest(pubnub_get(pbp), equals(NULL));
+    attest(pubnub_last_time_token(pbp), streqs("15167149789251299"));
+    attest(pubnub_free(pbp), equals(-1));
+}
+
 Ensure(single_context_pubnub, subscribe_channel_groups)
 {
     pubnub_init(pbp, "publ-bulletin", "sub-bulletin");
@@ -2930,8 +3172,11 @@ Ensure(single_context_pubnub,
              "\"Kingston\":\"+22\"},{\"Manila\":\"+38\"},{\"bouy76\":\"+5\"},{"
              "\"Pr. Astrid "
              "Coast\":\"Unable_to_fetch_temperature\"}],"
-             "\"1516149789251234583\"\r\n97\r\n,\"air-temperature,air-"
-             "temperature,air-temperature,air-temperature,air-temperature,air-"
+             "\"1516149789251234583\"\r\n95\r\n,\"air-temperature,air-",
+             NULL);
+    /* Keeps fsm in progress */
+    incoming("", NULL);
+    incoming("temperature,air-temperature,air-temperature,air-temperature,air-"
              "temperature\",\"ch-atmp,ch-atmp,ch-atmp,ch-atmp,ch-atmp,ch-"
              "atmp\"]\r\n0\r\n",
              NULL);
@@ -2976,8 +3221,11 @@ Ensure(single_context_pubnub,
              "Philippines\":{\"dir\":nne,\"speed\":\"4mph\",\"blows\":\"4mph\"}"
              "},{\"Sri Jayawardenepura Kotte, Sri "
              "Lanka\":{\"dir\":ne,\"speed\":\"7mph\",\"blows\":\"7mph\"}}],"
-             "\"151614\r\n93\r\n9789251234597\",\"wind-speed-and-direction,"
-             "wind-speed-and-direction,wind-speed-and-direction,wind-speed-and-"
+             "\"151614\r\n93\r\n9789251234597\",\"wind-speed-and-direction,",
+             NULL);
+    /* Keeps fsm in progress */
+    incoming("", NULL);
+    incoming("wind-speed-and-direction,wind-speed-and-direction,wind-speed-and-"
              "direction\",\"ch-ws1,ch-ws2,ch-ws3,ch-ws1\"]\r\n0\r\n",
              NULL);
     attest(pubnub_subscribe(
@@ -3566,7 +3814,10 @@ Ensure(single_context_pubnub, subscribe_gzip_response)
              "\r\n"
              "29\r\n",
              &chunk_block0);
+    /* Keeps fsm in progress */
+    incoming("", NULL);
     incoming("\r\n84\r\n", &chunk_block1);
+    incoming("", NULL);
     incoming("\r\n0\r\n", NULL);
     expect(pbntf_lost_socket, when(pb, equals(pbp)));
     expect(pbntf_trans_outcome, when(pb, equals(pbp)));
@@ -4111,8 +4362,12 @@ Ensure(single_context_pubnub, global_here_now_gzip_response)
              "\r\n"
              "c0d\r\n",
              &chunk_block1);
+    /* Keeps fsm in progress */
+    incoming("", NULL);
     incoming("\r\n5cc\r\n", &chunk_block2);
+    incoming("", NULL);
     incoming("\r\n3b\r\n", &chunk_block3);
+    incoming("", NULL);
     incoming("\r\n0\r\n", NULL);
     expect(pbntf_lost_socket, when(pb, equals(pbp)));
     expect(pbntf_trans_outcome, when(pb, equals(pbp)));
@@ -4488,6 +4743,8 @@ Ensure(single_context_pubnub, gzip_bad_compression_format)
              "Content-Encoding: gzip\r\n"
              "\r\n",
              &body_block);
+    /* Keeps fsm in progress */
+    incoming("", NULL);
     incoming(NULL, &extra_byte_block);
     expect(pbntf_lost_socket, when(pb, equals(pbp)));
     expect(pbntf_trans_outcome, when(pb, equals(pbp)));
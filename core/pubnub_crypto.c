@@ -57,21 +57,88 @@ int pbcrypto_signature(struct pbcc_context *pbcc, char const *channel, char cons
 
 static int cipher_hash(char const* cipher_key, uint8_t hash[33])
 {
+    static char const hex[] = "0123456789abcdef";
     uint8_t digest[32];
-    pbsha256_digest_str(cipher_key, digest);
+    int i;
 
-    snprintf((char*)hash, 33, 
-             "%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x%02x",
-             digest[0], digest[1], digest[2], digest[3],
-             digest[4], digest[5], digest[6], digest[7],
-             digest[8], digest[9], digest[10], digest[11],
-             digest[12], digest[13], digest[14], digest[15]
-        );
+    pbsha256_digest_str(cipher_key, digest);
+    for (i = 0; i < 16; ++i) {
+        hash[2*i] = hex[digest[i] >> 4];
+        hash[2*i + 1] = hex[digest[i] & 0x0F];
+    }
+    hash[32] = '\0';
 
     return 0;
 }
 
 
+/** The AES-256 contexts, set up with the key derived from the
+    cipher key.
+ */
+struct pubnub_crypto_handle {
+    struct pbaes256_cache* aes256;
+};
+
+
+pubnub_crypto_handle_t* pubnub_crypto_handle_alloc(char const* cipher_key)
+{
+    pubnub_crypto_handle_t* result;
+    uint8_t key[33];
+
+    PUBNUB_ASSERT_OPT(cipher_key != NULL);
+
+    result = (pubnub_crypto_handle_t*)malloc(sizeof *result);
+    if (NULL == result) {
+        return NULL;
+    }
+    cipher_hash(cipher_key, key);
+    result->aes256 = pbaes256_cache_alloc(key);
+    memset(key, 0, sizeof key);
+    if (NULL == result->aes256) {
+        free(result);
+        return NULL;
+    }
+
+    return result;
+}
+
+
+void pubnub_crypto_handle_free(pubnub_crypto_handle_t* handle)
+{
+    if (handle != NULL) {
+        pbaes256_cache_free(handle->aes256);
+        free(handle);
+    }
+}
+
+
+int pubnub_crypto_handle_encrypt(pubnub_crypto_handle_t const* handle, pubnub_bymebl_t msg, char *base64_str, size_t *n, pubnub_bymebl_t buffer)
+{
+    uint8_t const iv[] = "0123456789012345";
+
+    PUBNUB_ASSERT_OPT(handle != NULL);
+
+    if (0 != pbaes256_encrypt_cached(handle->aes256, msg, iv, &buffer)) {
+        return -1;
+    }
+    return pbbase64_encode_std(buffer, base64_str, n);
+}
+
+
+int pubnub_crypto_handle_decrypt(pubnub_crypto_handle_t const* handle, char *base64_str, pubnub_bymebl_t *data)
+{
+    uint8_t const iv[] = "0123456789012345";
+    pubnub_bymebl_t decoded;
+
+    PUBNUB_ASSERT_OPT(handle != NULL);
+
+    if (0 != pbbase64_decode_inplace_std_str(base64_str, &decoded)) {
+        return -1;
+    }
+    return pbaes256_decrypt_cached(handle->aes256, decoded, iv, data);
+}
+
+
 int pubnub_encrypt(char const *cipher_key, pubnub_bymebl_t msg, char *base64_str, size_t *n)
 {
     pubnub_bymebl_t encrypted;
@@ -208,9 +275,10 @@ enum pubnub_res pubnub_get_decrypted(pubnub_t *pb, char const* cipher_key, char
 {
     char *msg;
     size_t msg_len;
-    uint8_t decoded_msg[PUBNUB_BUF_MAXLEN];
     pubnub_bymebl_t data = { (uint8_t*)s, *n };
-    pubnub_bymebl_t buffer = { decoded_msg, PUBNUB_BUF_MAXLEN };
+    pubnub_bymebl_t decoded;
+    uint8_t const iv[] = "0123456789012345";
+    uint8_t key[33];
 
     PUBNUB_ASSERT(pb_valid_ctx_ptr(pb));
     PUBNUB_ASSERT_OPT(cipher_key != NULL);
@@ -230,7 +298,13 @@ enum pubnub_res pubnub_get_decrypted(pubnub_t *pb, char const* cipher_key, char
 
     pubnub_json_string_unescape_slash(msg);
 
-    if (0 != pubnub_decrypt_buffered(cipher_key, msg, &data, &buffer)) {
+    /* The message is ours to change, so decode it in place,
+       rather than copying it to a (large) buffer */
+    if (0 != pbbase64_decode_inplace_std_str(msg, &decoded)) {
+        return PNR_INTERNAL_ERROR;
+    }
+    cipher_hash(cipher_key, key);
+    if (0 != pbaes256_decrypt(decoded, key, iv, &data)) {
         return PNR_INTERNAL_ERROR;
     }
     *n = data.size;
@@ -244,7 +318,10 @@ pubnub_bymebl_t pubnub_get_decrypted_alloc(pubnub_t *pb, char const* cipher_key)
 {
     char *msg;
     size_t msg_len;
+    pubnub_bymebl_t decoded;
     pubnub_bymebl_t result = { NULL, 0 };
+    uint8_t const iv[] = "0123456789012345";
+    uint8_t key[33];
 
     PUBNUB_ASSERT(pb_valid_ctx_ptr(pb));
     PUBNUB_ASSERT_OPT(cipher_key != NULL);
@@ -262,7 +339,11 @@ pubnub_bymebl_t pubnub_get_decrypted_alloc(pubnub_t *pb, char const* cipher_key)
 
     pubnub_json_string_unescape_slash(msg);
 
-    result = pubnub_decrypt_alloc(cipher_key, msg);
+    if (0 != pbbase64_decode_inplace_std_str(msg, &decoded)) {
+        return result;
+    }
+    cipher_hash(cipher_key, key);
+    result = pbaes256_decrypt_alloc(decoded, key, iv);
     if (NULL != result.ptr) {
         result.ptr[result.size] = '\0';
     }
@@ -271,6 +352,182 @@ pubnub_bymebl_t pubnub_get_decrypted_alloc(pubnub_t *pb, char const* cipher_key)
 }
 
 
+enum pubnub_res pubnub_crypto_handle_get_decrypted(pubnub_t *pb, pubnub_crypto_handle_t const* handle, char *s, size_t *n)
+{
+    char *msg;
+    size_t msg_len;
+    pubnub_bymebl_t data = { (uint8_t*)s, *n };
+
+    PUBNUB_ASSERT(pb_valid_ctx_ptr(pb));
+    PUBNUB_ASSERT_OPT(handle != NULL);
+    PUBNUB_ASSERT_OPT(s != NULL);
+
+    msg = (char*)pubnub_get(pb);
+    if (NULL == msg) {
+        return PNR_INTERNAL_ERROR;
+    }
+    msg_len = strlen(msg);
+    if ((msg[0] != '"') || (msg[msg_len-1] != '"')) {
+        return PNR_FORMAT_ERROR;
+    }
+    msg[msg_len - 1] = '\0';
+    ++msg;
+
+    pubnub_json_string_unescape_slash(msg);
+
+    if (0 != pubnub_crypto_handle_decrypt(handle, msg, &data)) {
+        return PNR_INTERNAL_ERROR;
+    }
+    *n = data.size;
+    data.ptr[data.size] = '\0';
+
+    return PNR_OK;
+}
+
+
+/** The work of decrypting a batch of messages, shared by all the
+    threads that do it. Until a message is decrypted, its outcome
+    holds the pointer to the (encrypted) message, in the reply, and
+    the offset of its part of the arena.
+ */
+struct decrypt_batch {
+    pubnub_crypto_handle_t const* handle;
+    struct pubnub_decrypted_msg*  msgs;
+    pubnub_bymebl_t               arena;
+};
+
+
+/** How much of the arena is needed to decrypt a message of length
+    @p msg_len: the decoded length, an AES block of padding and the
+    `NUL`.
+ */
+static size_t decrypt_room(size_t msg_len)
+{
+    return pbbase64_decoded_length(msg_len) + 17;
+}
+
+
+size_t pubnub_get_all_decrypted_arena_size(pubnub_t* pb)
+{
+    size_t   size = 0;
+    unsigned ofs;
+
+    PUBNUB_ASSERT(pb_valid_ctx_ptr(pb));
+
+    pubnub_mutex_lock(pb->monitor);
+    for (ofs = pb->core.msg_ofs; ofs < pb->core.msg_end;) {
+        size_t const msg_len = strlen(pb->core.http_reply + ofs);
+        size += decrypt_room(msg_len);
+        ofs += msg_len + 1;
+    }
+    pubnub_mutex_unlock(pb->monitor);
+
+    return size;
+}
+
+
+static void decrypt_one(void* arg, size_t i)
+{
+    struct decrypt_batch*        batch = (struct decrypt_batch*)arg;
+    struct pubnub_decrypted_msg* out   = batch->msgs + i;
+    char*                        msg   = (char*)out->ptr;
+    size_t                       msg_len;
+    pubnub_bymebl_t              data;
+
+    out->ptr = NULL;
+    if (PNR_STARTED != out->result) {
+        out->size = 0;
+        return;
+    }
+    msg_len  = strlen(msg);
+    data.ptr  = batch->arena.ptr + out->size;
+    data.size = decrypt_room(msg_len);
+    out->size = 0;
+    if ((msg_len < 2) || (msg[0] != '"') || (msg[msg_len - 1] != '"')) {
+        out->result = PNR_FORMAT_ERROR;
+        return;
+    }
+    msg[msg_len - 1] = '\0';
+    ++msg;
+
+    pubnub_json_string_unescape_slash(msg);
+
+    if (0 != pubnub_crypto_handle_decrypt(batch->handle, msg, &data)) {
+        out->result = PNR_INTERNAL_ERROR;
+        return;
+    }
+    data.ptr[data.size] = '\0';
+    out->ptr    = (char const*)data.ptr;
+    out->size   = data.size;
+    out->result = PNR_OK;
+}
+
+
+size_t pubnub_get_all_decrypted(pubnub_t*                     pb,
+                                pubnub_crypto_handle_t const* handle,
+                                struct pubnub_decrypted_msg*  msgs,
+                                size_t                        max,
+                                pubnub_bymebl_t               arena,
+                                pubnub_parallel_for_t         parallel_for,
+                                void*                         pool)
+{
+    struct decrypt_batch batch;
+    size_t               count      = 0;
+    size_t               arena_used = 0;
+
+    PUBNUB_ASSERT(pb_valid_ctx_ptr(pb));
+    PUBNUB_ASSERT_OPT(handle != NULL);
+    PUBNUB_ASSERT_OPT(msgs != NULL);
+
+    /* Take the messages (that fit), splitting up the arena among
+       them, so that they can be decrypted independently */
+    pubnub_mutex_lock(pb->monitor);
+    while (count < max) {
+        struct pbcc_context* core = &pb->core;
+        char*                msg;
+        size_t               msg_len;
+        size_t               need;
+
+        if (core->msg_ofs >= core->msg_end) {
+            break;
+        }
+        msg     = core->http_reply + core->msg_ofs;
+        msg_len = strlen(msg);
+        need    = decrypt_room(msg_len);
+        if (arena_used + need > arena.size) {
+            if (count > 0) {
+                break;
+            }
+            /* It would never fit, so take it, to not get stuck on it */
+            msgs[count].result = PNR_REPLY_TOO_BIG;
+        }
+        else {
+            msgs[count].result = PNR_STARTED;
+            msgs[count].size   = arena_used;
+            arena_used += need;
+        }
+        msgs[count++].ptr = msg;
+        core->msg_ofs += msg_len + 1;
+    }
+    pubnub_mutex_unlock(pb->monitor);
+
+    batch.handle = handle;
+    batch.msgs   = msgs;
+    batch.arena  = arena;
+    if ((NULL == parallel_for) || (count < 2)) {
+        size_t i;
+        for (i = 0; i < count; ++i) {
+            decrypt_one(&batch, i);
+        }
+    }
+    else {
+        parallel_for(pool, decrypt_one, &batch, count);
+    }
+
+    return count;
+}
+
+
 enum pubnub_res pubnub_publish_encrypted(pubnub_t *p, char const* channel, char const* message, char const* cipher_key)
 {
     struct pubnub_publish_options opts =  pubnub_publish_defopts();
@@ -131,6 +131,118 @@ enum pubnub_res pubnub_get_decrypted(pubnub_t *pb, char const* cipher_key, char
 */
 pubnub_bymebl_t pubnub_get_decrypted_alloc(pubnub_t *pb, char const* cipher_key);
 
+/** A "crypto handle" holds the key derived from a cipher key, so
+    that it's not derived (by SHA-256 hashing) for every message.
+    Also, it keeps a few AES-256 contexts, set up with the key, which
+    are reused for the messages encrypted/decrypted with the handle.
+    So, if you have many messages to encrypt/decrypt with the same
+    cipher key, using a handle leaves mostly the AES-256 work itself
+    to be done for each message.
+
+    A handle can be used from many threads at the same time, each
+    thread using a context of its own. If there are not enough of
+    them, a context is allocated just for the message. The contexts
+    are freed with the handle.
+ */
+typedef struct pubnub_crypto_handle pubnub_crypto_handle_t;
+
+/** Creates a crypto handle for the @p cipher_key.
+    @return The handle, NULL on failure (to allocate)
+ */
+pubnub_crypto_handle_t* pubnub_crypto_handle_alloc(char const* cipher_key);
+
+/** Frees the crypto @p handle. NULL is OK (and does nothing). */
+void pubnub_crypto_handle_free(pubnub_crypto_handle_t* handle);
+
+/** Similar to pubnub_encrypt_buffered(), but uses the key of the
+    crypto @p handle. The @p buffer has to be able to hold the
+    encrypted message, that is, @p msg with up to 16 bytes of padding.
+
+    @return 0: OK, -1: error
+*/
+int pubnub_crypto_handle_encrypt(pubnub_crypto_handle_t const* handle, pubnub_bymebl_t msg, char *base64_str, size_t *n, pubnub_bymebl_t buffer);
+
+/** Similar to pubnub_decrypt(), but uses the key of the crypto
+    @p handle and never allocates memory, as it Base64 decodes
+    @p base64_str in place, that is, changes it (it is not a string
+    afterwards).
+
+    @return 0: OK, -1: error
+*/
+int pubnub_crypto_handle_decrypt(pubnub_crypto_handle_t const* handle, char *base64_str, pubnub_bymebl_t *data);
+
+/** Similar to pubnub_get_decrypted(), but uses the key of the crypto
+    @p handle.
+*/
+enum pubnub_res pubnub_crypto_handle_get_decrypted(pubnub_t *pb, pubnub_crypto_handle_t const* handle, char *s, size_t *n);
+
+/** The outcome of decrypting one message in a batch, by
+    pubnub_get_all_decrypted().
+ */
+struct pubnub_decrypted_msg {
+    /** PNR_OK: decrypted, PNR_FORMAT_ERROR: the message is not a JSON
+        string, PNR_INTERNAL_ERROR: Base64 decoding or decrypting
+        failed, PNR_REPLY_TOO_BIG: the message can't fit in the
+        (whole) arena
+    */
+    enum pubnub_res result;
+    /** The decrypted message (in the arena), `NUL` terminated. Only
+        valid if `result == PNR_OK`. */
+    char const* ptr;
+    /** Length of the decrypted message (without the `NUL`) */
+    size_t size;
+};
+
+/** A function that calls @p fn(@p arg, i) for each `i` in
+    [0, @p count), possibly at the same time on many threads (of the
+    thread pool @p pool), returning only when all calls are done.
+    This is how pubnub_get_all_decrypted() fans out the work to a
+    thread pool of your choice.
+ */
+typedef void (*pubnub_parallel_for_t)(void*  pool,
+                                      void   (*fn)(void* arg, size_t i),
+                                      void*  arg,
+                                      size_t count);
+
+/** Decrypts, with the crypto @p handle, the next (up to) @p max
+    messages in the context @p pb, as a batch, to user-allocated
+    "arena" @p arena. The outcome for each message is put in
+    @p msgs, in the same order as the messages are in the reply.
+
+    If the arena can't hold all the messages, only those that fit
+    are taken, the rest are left for the next call, which should be
+    made with a "fresh" arena, after you're done with the previous
+    results. To be sure of the fit, give an arena of the size that
+    pubnub_get_all_decrypted_arena_size() returns.
+
+    The messages are unescaped and Base64 decoded in place, in the
+    reply, that is, once decrypted, you can't get them (encrypted)
+    with pubnub_get().
+
+    If @p parallel_for is not NULL, it is used to decrypt the
+    messages in parallel, on the threads of @p pool, otherwise they
+    are decrypted on the calling thread.
+
+    @return The number of messages taken (and put in @p msgs),
+    0 if there are no more messages
+ */
+size_t pubnub_get_all_decrypted(pubnub_t*                     pb,
+                                pubnub_crypto_handle_t const* handle,
+                                struct pubnub_decrypted_msg*  msgs,
+                                size_t                        max,
+                                pubnub_bymebl_t               arena,
+                                pubnub_parallel_for_t         parallel_for,
+                                void*                         pool);
+
+/** Returns the size of the arena that pubnub_get_all_decrypted()
+    needs to decrypt all the remaining messages in the context @p pb,
+    that is, for each message, its Base64 decoded length, an AES
+    block of padding and the `NUL`. It is never more than the size of
+    the reply and 17 bytes for each message.
+ */
+size_t pubnub_get_all_decrypted_arena_size(pubnub_t* pb);
+
+
 /** Publishes the @p message on @p channel in the context @p p
     encrypted with the key @p cipher_key
 
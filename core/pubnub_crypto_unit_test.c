@@ -0,0 +1,199 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "cgreen/cgreen.h"
+#include "cgreen/mocks.h"
+
+#include "pubnub_internal.h"
+
+#include "core/pubnub_crypto.h"
+#include "core/pubnub_coreapi_ex.h"
+#include "core/pubnub_assert.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+
+
+/* A less chatty cgreen :) */
+
+#define attest assert_that
+#define equals is_equal_to
+#define streqs is_equal_to_string
+#define differs is_not_equal_to
+#define strdifs is_not_equal_to_string
+#define ptreqs(val) is_equal_to_contents_of(&(val), sizeof(val))
+#define ptrdifs(val) is_not_equal_to_contents_of(&(val), sizeof(val))
+#define sets(par, val) will_set_contents_of_parameter(par, &(val), sizeof(val))
+#define sets_ex will_set_contents_of_parameter
+#define returns will_return
+
+
+enum { MAX_MSGS = 8 };
+
+static pubnub_t m_pb;
+
+static pubnub_crypto_handle_t* m_handle;
+
+/** The (plain) messages in the reply */
+static char* m_msg[MAX_MSGS];
+static size_t m_count;
+
+
+/* The crypto module only uses the reply (messages) of the context */
+
+bool pb_valid_ctx_ptr(pubnub_t const* pb)
+{
+    return pb == &m_pb;
+}
+
+
+char const* pubnub_get(pubnub_t* pb)
+{
+    PUBNUB_UNUSED(pb);
+    return NULL;
+}
+
+
+struct pubnub_publish_options pubnub_publish_defopts(void)
+{
+    struct pubnub_publish_options opts;
+    memset(&opts, 0, sizeof opts);
+    return opts;
+}
+
+
+enum pubnub_res pubnub_publish_ex(pubnub_t* p, const char* channel, const char* message, struct pubnub_publish_options opts)
+{
+    PUBNUB_UNUSED(p);
+    PUBNUB_UNUSED(channel);
+    PUBNUB_UNUSED(message);
+    PUBNUB_UNUSED(opts);
+    return PNR_INTERNAL_ERROR;
+}
+
+
+/** Adds a message of @p len characters to the reply, encrypted, as
+    a JSON string, like it is in a subscribe reply. */
+static void add_msg(size_t len)
+{
+    size_t const    room = len + 16;
+    char*           b64  = (char*)malloc(room * 4 / 3 + 8);
+    size_t          n    = room * 4 / 3 + 8;
+    pubnub_bymebl_t plain;
+    pubnub_bymebl_t buffer;
+    size_t          i;
+
+    attest(m_count < MAX_MSGS);
+    m_msg[m_count] = (char*)malloc(len + 1);
+    for (i = 0; i < len; ++i) {
+        m_msg[m_count][i] = 'a' + (m_count + i) % 26;
+    }
+    m_msg[m_count][len] = '\0';
+    plain.ptr   = (uint8_t*)m_msg[m_count];
+    plain.size  = len;
+    buffer.ptr  = (uint8_t*)malloc(room);
+    buffer.size = room;
+    attest(pubnub_crypto_handle_encrypt(m_handle, plain, b64, &n, buffer), equals(0));
+    free(buffer.ptr);
+
+    m_pb.core.http_reply = (char*)realloc(m_pb.core.http_reply, m_pb.core.msg_end + n + 3);
+    sprintf(m_pb.core.http_reply + m_pb.core.msg_end, "\"%.*s\"", (int)n, b64);
+    m_pb.core.msg_end += n + 3;
+    free(b64);
+    ++m_count;
+}
+
+
+Describe(pubnub_crypto);
+
+
+BeforeEach(pubnub_crypto) {
+    memset(&m_pb, 0, sizeof m_pb);
+    m_count  = 0;
+    m_handle = pubnub_crypto_handle_alloc("enigma");
+    attest(m_handle, differs(NULL));
+}
+
+
+AfterEach(pubnub_crypto) {
+    size_t i;
+    for (i = 0; i < m_count; ++i) {
+        free(m_msg[i]);
+    }
+    free(m_pb.core.http_reply);
+    pubnub_crypto_handle_free(m_handle);
+}
+
+
+Ensure(pubnub_crypto, no_arena_needed_without_messages) {
+    attest(pubnub_get_all_decrypted_arena_size(&m_pb), equals(0));
+}
+
+
+Ensure(pubnub_crypto, decrypts_all_in_arena_of_reported_size) {
+    struct pubnub_decrypted_msg msgs[MAX_MSGS];
+    pubnub_bymebl_t             arena;
+    size_t                      i;
+
+    add_msg(0);
+    add_msg(15);
+    add_msg(100);
+    arena.size = pubnub_get_all_decrypted_arena_size(&m_pb);
+    attest(arena.size <= m_pb.core.msg_end + 17 * m_count);
+    arena.ptr = (uint8_t*)malloc(arena.size);
+
+    attest(pubnub_get_all_decrypted(&m_pb, m_handle, msgs, MAX_MSGS, arena, NULL, NULL), equals(m_count));
+    for (i = 0; i < m_count; ++i) {
+        attest(msgs[i].result, equals(PNR_OK));
+        attest(msgs[i].ptr, streqs(m_msg[i]));
+    }
+    attest(pubnub_get_all_decrypted_arena_size(&m_pb), equals(0));
+    attest(pubnub_get_all_decrypted(&m_pb, m_handle, msgs, MAX_MSGS, arena, NULL, NULL), equals(0));
+
+    free(arena.ptr);
+}
+
+
+Ensure(pubnub_crypto, decrypts_reply_larger_than_64KB) {
+    struct pubnub_decrypted_msg msgs[MAX_MSGS];
+    pubnub_bymebl_t             arena;
+    size_t                      i;
+
+    add_msg(10);
+    add_msg(70000);
+    add_msg(40000);
+    add_msg(20);
+    attest(m_pb.core.msg_end > 64 * 1024);
+
+    /* More than the 64 KB arena the C++ wrapper used to have */
+    arena.size = pubnub_get_all_decrypted_arena_size(&m_pb);
+    attest(arena.size > 110000);
+    arena.ptr = (uint8_t*)malloc(arena.size);
+    attest(pubnub_get_all_decrypted(&m_pb, m_handle, msgs, MAX_MSGS, arena, NULL, NULL), equals(m_count));
+    for (i = 0; i < m_count; ++i) {
+        attest(msgs[i].result, equals(PNR_OK));
+        attest(msgs[i].size, equals(strlen(m_msg[i])));
+        attest(msgs[i].ptr, streqs(m_msg[i]));
+    }
+
+    free(arena.ptr);
+}
+
+
+Ensure(pubnub_crypto, too_small_arena_leaves_the_rest_for_the_next_call) {
+    struct pubnub_decrypted_msg msgs[MAX_MSGS];
+    pubnub_bymebl_t             arena;
+
+    add_msg(100);
+    add_msg(70000);
+    arena.size = 64 * 1024;
+    arena.ptr  = (uint8_t*)malloc(arena.size);
+
+    attest(pubnub_get_all_decrypted(&m_pb, m_handle, msgs, MAX_MSGS, arena, NULL, NULL), equals(1));
+    attest(msgs[0].result, equals(PNR_OK));
+    attest(msgs[0].ptr, streqs(m_msg[0]));
+    attest(pubnub_get_all_decrypted(&m_pb, m_handle, msgs, MAX_MSGS, arena, NULL, NULL), equals(1));
+    attest(msgs[0].result, equals(PNR_REPLY_TOO_BIG));
+
+    free(arena.ptr);
+}
@@ -6,6 +6,7 @@
 #include "core/pubnub_ccore_pubsub.h"
 #include "core/pubnub_netcore.h"
 #include "core/pubnub_mutex.h"
+#include "core/pbhttp_parser.h"
 
 #if defined(PUBNUB_CALLBACK_API)
 #include "core/pubnub_ntf_callback.h"
@@ -24,6 +25,27 @@
 #include "core/pbgzip_decompress.h"
 #endif
 
+#if !defined PUBNUB_STREAMING_SUBSCRIBE
+#define PUBNUB_STREAMING_SUBSCRIBE 0
+#elif PUBNUB_STREAMING_SUBSCRIBE
+#include "core/pubnub_streaming_subscribe.h"
+#endif
+
+#if !defined PUBNUB_TRANSACTION_TIMINGS
+#define PUBNUB_TRANSACTION_TIMINGS 0
+#elif PUBNUB_TRANSACTION_TIMINGS
+#include "core/pubnub_transaction_timings.h"
+#endif
+#include "core/pbtimings.h"
+
+#if !defined PUBNUB_METRICS
+#define PUBNUB_METRICS 0
+#endif
+#if !defined PUBNUB_METRICS_THREADS
+#define PUBNUB_METRICS_THREADS 8
+#endif
+#include "core/pbmetrics.h"
+
 #include <stdint.h>
 #if PUBNUB_ADVANCED_KEEP_ALIVE
 #include <time.h>
@@ -51,7 +73,12 @@ enum PBSocketState {
     /** Reading a line */
     STATE_READ_LINE = 7,
     /** Sending data */
-    STATE_SENDING_DATA = 8
+    STATE_SENDING_DATA = 8,
+    /** Reading (and parsing) the HTTP response */
+    STATE_READ_RESPONSE = 9,
+    /** The peer closed (or reset) the connection. PALs may report
+        this as a timeout, so this is how one can tell it apart. */
+    STATE_CLOSED_BY_PEER = 10
 };
 
 
@@ -158,8 +185,13 @@ struct pubnub_ {
     /** Last received HTTP (result) code */
     uint16_t http_code;
 
+    /** The (incremental) parser of the HTTP response being received */
+    struct pbhttp_parser http_parser;
+
 #if defined PUBNUB_ORIGIN_SETTABLE
     char const* origin;
+    /** The origin that the (kept alive) connection was made to */
+    char const* connected_origin;
 #endif
 
 #if 0
@@ -218,6 +250,12 @@ struct pubnub_ {
         unsigned max;
         unsigned count;
         bool     should_close;
+        /** Whether to re-establish the connection closed because of
+            reaching the limits above (after reporting the outcome) */
+        bool rewarm;
+        /** Whether the kept alive connection reached the limits and
+            is to be re-established */
+        bool rewarming;
     } keep_alive;
 #endif
 
@@ -255,6 +293,18 @@ struct pubnub_ {
     void*             user_data;
 #endif
 
+#if PUBNUB_STREAMING_SUBSCRIBE
+    /** Function to call for each message received by subscribe (as
+        soon as it is received). If NULL, not in "streaming" mode. */
+    pubnub_subscribe_message_callback_t stream_cb;
+    void*                               stream_user_data;
+#endif
+
+#if PUBNUB_TRANSACTION_TIMINGS
+    /** Timings of the phases of the current (or last) transaction */
+    struct pbtimings timings;
+#endif
+
 #if PUBNUB_PROXY_API
 
     /** The type (protocol) of the proxy to use */
@@ -273,6 +323,12 @@ struct pubnub_ {
     */
     int proxy_tunnel_established;
 
+    /** Indicates that the tunnel (to the origin server, via `CONNECT`
+        proxy) of the current transaction is a kept alive one, not
+        yet proven to be alive, as no response was received on it.
+     */
+    int proxy_tunnel_reused;
+
     /** The saved path part of the URL for the Pubnub transaction.
      */
     char proxy_saved_path[PUBNUB_BUF_MAXLEN];
@@ -9,3 +9,9 @@ void pubnub_set_keep_alive_param(pubnub_t* pb, unsigned timeout, unsigned max)
     pb->keep_alive.timeout = timeout;
     pb->keep_alive.max     = max;
 }
+
+
+void pubnub_set_keep_alive_rewarm(pubnub_t* pb, bool rewarm)
+{
+    pb->keep_alive.rewarm = rewarm;
+}
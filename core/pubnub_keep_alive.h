@@ -5,6 +5,8 @@
 
 #include "pubnub_api_types.h"
 
+#include <stdbool.h>
+
 
 /** @file pubnub_keep_alive.h
 
@@ -29,5 +31,22 @@
  */
 void pubnub_set_keep_alive_param(pubnub_t* pb, unsigned timeout, unsigned max);
 
+/** Set whether to "re-warm" the connection of the context @p pb
+    closed because of reaching the Keep-Alive limits (set by
+    pubnub_set_keep_alive_param()).
+
+    If @p rewarm is true, the outcome of the transaction that reaches
+    the limits is reported as usual, and then its connection is closed
+    and a new one made, as pubnub_preconnect() would, on the next tick
+    of the callback interface. That is reported as the outcome of a
+    #PBTT_PRECONNECT transaction, and while it lasts, starting a
+    transaction yields #PNR_IN_PROGRESS. A transaction started before
+    the tick (say, from the callback) reconnects by itself. The sync
+    interface has no ticks, so there the next transaction reconnects.
+
+    Default is false - the connection is just closed.
+ */
+void pubnub_set_keep_alive_rewarm(pubnub_t* pb, bool rewarm);
+
 
 #endif /* !defined INC_PUBNUB_KEEP_ALIVE */
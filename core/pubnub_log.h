@@ -35,6 +35,18 @@ enum pubnub_log_level {
 #define PUBNUB_LOG_LEVEL PUBNUB_LOG_LEVEL_INFO
 #endif
 
+#if defined PUBNUB_LOG_ASYNC && PUBNUB_LOG_ASYNC
+#include "pubnub_log_async.h"
+#include <stdio.h>
+
+/** Generic logging macro, records a message for the given @a LVL
+    using a printf-like interface, to be formatted and printed later,
+    by the "asynchronous log" backend (pubnub_log_async.h)
+*/
+#define PUBNUB_LOG(LVL, ...) do { if ((LVL <= PUBNUB_LOG_LEVEL) && (LVL <= pubnub_log_runtime_level)) pubnub_log_async_record(LVL, __VA_ARGS__); } while(0)
+
+#else
+
 #if !defined PUBNUB_LOG_PRINTF
 #include <stdio.h>
 /** User should define a printf-like function that will do the actual
@@ -48,6 +60,8 @@ enum pubnub_log_level {
 */
 #define PUBNUB_LOG(LVL, ...) do { if (LVL <= PUBNUB_LOG_LEVEL) PUBNUB_LOG_PRINTF(__VA_ARGS__); } while(0)
 
+#endif /* PUBNUB_LOG_ASYNC */
+
 /** Helper macro to log an error message */
 #define PUBNUB_LOG_ERROR(...) PUBNUB_LOG(PUBNUB_LOG_LEVEL_ERROR, __VA_ARGS__)
 
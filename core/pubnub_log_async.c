@@ -0,0 +1,721 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "pubnub_log_async.h"
+
+#include "pubnub_assert.h"
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#if (PUBNUB_LOG_ASYNC_RING_SIZE & (PUBNUB_LOG_ASYNC_RING_SIZE - 1)) != 0
+#error PUBNUB_LOG_ASYNC_RING_SIZE has to be a power of two
+#endif
+
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#define THREAD_LOCAL __declspec(thread)
+#define LOAD_ACQUIRE(p) ((uint32_t)InterlockedCompareExchange((LONG volatile*)(p), 0, 0))
+#define STORE_RELEASE(p, v) InterlockedExchange((LONG volatile*)(p), (LONG)(v))
+#define LOAD_PTR_ACQUIRE(p) InterlockedCompareExchangePointer((PVOID volatile*)(p), NULL, NULL)
+#define STORE_PTR_RELEASE(p, v) InterlockedExchangePointer((PVOID volatile*)(p), (v))
+#define FETCH_INC(p) ((unsigned)InterlockedIncrement((LONG volatile*)(p)) - 1)
+#define EXCHANGE_ZERO(p) ((unsigned)InterlockedExchange((LONG volatile*)(p), 0))
+#define CLAIM(p) (0 == InterlockedCompareExchange((LONG volatile*)(p), 1, 0))
+#else
+#include <pthread.h>
+#define THREAD_LOCAL __thread
+#define LOAD_ACQUIRE(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define STORE_RELEASE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define LOAD_PTR_ACQUIRE(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define STORE_PTR_RELEASE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define FETCH_INC(p) __atomic_fetch_add((p), 1, __ATOMIC_RELAXED)
+#define EXCHANGE_ZERO(p) __atomic_exchange_n((p), 0, __ATOMIC_RELAXED)
+#define CLAIM(p) pblog_claim(p)
+static bool pblog_claim(unsigned* p)
+{
+    unsigned expected = 0;
+    return __atomic_compare_exchange_n(p, &expected, 1, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+#endif
+
+
+/** Rounds @p n up to a multiple of 8, the alignment of (all the
+    parts of) the records */
+#define ALIGN8(n) (((n) + 7) & ~(size_t)7)
+
+/** Maximum length of a formatted message */
+#define MAX_TEXT 1024
+
+
+/** Header of a (binary) log record. It is followed by the values of
+    the arguments, each in 8 bytes, except strings, which are 8 bytes
+    of length followed by the characters and a NUL, padded to 8.
+
+    A record with `size` 0 is a marker that the rest of the ring
+    buffer (up to its end) is unused.
+ */
+struct pblog_head {
+    uint32_t    size;
+    uint32_t    level;
+    char const* fmt;
+};
+
+#define HEAD_SIZE ALIGN8(sizeof(struct pblog_head))
+
+
+/** A single-producer (the thread that logs), single-consumer (the
+    thread that drains) ring buffer of records. Indices are "free
+    running" - they are taken modulo the size of the buffer.
+ */
+struct pblog_ring {
+    uint32_t head;
+    /** To keep the producer and consumer indices in different cache
+        lines */
+    char     pad[60];
+    uint32_t tail;
+    char     pad2[60];
+    uint8_t  data[PUBNUB_LOG_ASYNC_RING_SIZE];
+};
+
+
+/** A parsed printf conversion specification */
+struct pblog_spec {
+    char flags[8];
+    int  width;
+    bool width_star;
+    int  prec;
+    bool prec_star;
+    /** One of: 0 (none), 'H' (hh), 'h', 'l', 'q' (ll), 'j', 'z',
+        't', 'L' */
+    char length;
+    /** The conversion, 0 if not supported (nothing after it can be
+        recorded or formatted) */
+    char conv;
+};
+
+
+int volatile pubnub_log_runtime_level = PUBNUB_LOG_LEVEL;
+
+static struct pblog_ring* m_ring[PUBNUB_LOG_ASYNC_THREADS];
+
+/** Is the ring of the same index owned by a (living) thread */
+static unsigned m_ring_owned[PUBNUB_LOG_ASYNC_THREADS];
+
+static unsigned m_dropped;
+
+static pubnub_log_writer_t m_writer;
+
+static THREAD_LOCAL struct pblog_ring* m_my_ring;
+
+
+void pubnub_log_set_level(enum pubnub_log_level level)
+{
+    pubnub_log_runtime_level = level;
+}
+
+
+enum pubnub_log_level pubnub_log_get_level(void)
+{
+    return (enum pubnub_log_level)pubnub_log_runtime_level;
+}
+
+
+void pubnub_log_async_set_writer(pubnub_log_writer_t writer)
+{
+    m_writer = writer;
+}
+
+
+/** Called on the exit of a thread that owns a ring, with the pointer
+    to its `m_ring_owned` flag. The ring is left as it is, so the
+    records in it are still drained, and its next owner continues
+    where this thread stopped. */
+static void release_ring(void* owned)
+{
+    STORE_RELEASE((unsigned*)owned, 0);
+}
+
+
+#if defined(_MSC_VER)
+
+static DWORD m_fls_index = FLS_OUT_OF_INDEXES;
+
+static VOID WINAPI on_thread_exit(PVOID owned)
+{
+    if (owned != NULL) {
+        release_ring(owned);
+    }
+}
+
+static BOOL CALLBACK fls_alloc(PINIT_ONCE once, PVOID param, PVOID* ctx)
+{
+    PUBNUB_UNUSED(once);
+    PUBNUB_UNUSED(param);
+    PUBNUB_UNUSED(ctx);
+    m_fls_index = FlsAlloc(on_thread_exit);
+    return TRUE;
+}
+
+/** Arranges for @p owned to be released on the exit of this thread.
+    If that fails, the ring is just never released. */
+static void release_on_exit(unsigned* owned)
+{
+    static INIT_ONCE once = INIT_ONCE_STATIC_INIT;
+    InitOnceExecuteOnce(&once, fls_alloc, NULL, NULL);
+    if (m_fls_index != FLS_OUT_OF_INDEXES) {
+        FlsSetValue(m_fls_index, owned);
+    }
+}
+
+#else
+
+static pthread_key_t m_key;
+
+static bool m_key_created;
+
+static void key_create(void)
+{
+    m_key_created = (0 == pthread_key_create(&m_key, release_ring));
+}
+
+/** Arranges for @p owned to be released on the exit of this thread.
+    If that fails, the ring is just never released. */
+static void release_on_exit(unsigned* owned)
+{
+    static pthread_once_t once = PTHREAD_ONCE_INIT;
+    pthread_once(&once, key_create);
+    if (m_key_created) {
+        pthread_setspecific(m_key, owned);
+    }
+}
+
+#endif
+
+
+/** Returns the ring of this thread, claiming one that is not owned
+    by any thread on the first call. If all are owned, returns NULL,
+    and we try again on the next call, as some thread may have
+    exited in the meantime. */
+static struct pblog_ring* my_ring(void)
+{
+    unsigned i;
+
+    if (m_my_ring != NULL) {
+        return m_my_ring;
+    }
+    for (i = 0; i < PUBNUB_LOG_ASYNC_THREADS; ++i) {
+        struct pblog_ring* ring;
+
+        if ((LOAD_ACQUIRE(&m_ring_owned[i]) != 0) || !CLAIM(&m_ring_owned[i])) {
+            continue;
+        }
+        ring = (struct pblog_ring*)LOAD_PTR_ACQUIRE(&m_ring[i]);
+        if (NULL == ring) {
+            ring = (struct pblog_ring*)malloc(sizeof *ring);
+            if (NULL == ring) {
+                STORE_RELEASE(&m_ring_owned[i], 0);
+                return NULL;
+            }
+            ring->head = ring->tail = 0;
+            STORE_PTR_RELEASE(&m_ring[i], ring);
+        }
+        release_on_exit(&m_ring_owned[i]);
+        m_my_ring = ring;
+        return ring;
+    }
+    return NULL;
+}
+
+
+static char const* parse_spec(char const* s, struct pblog_spec* spec)
+{
+    size_t nflags = 0;
+
+    while ((strchr("-+ #0", *s) != NULL) && (*s != '\0')) {
+        if (nflags < sizeof spec->flags - 1) {
+            spec->flags[nflags++] = *s;
+        }
+        ++s;
+    }
+    spec->flags[nflags] = '\0';
+
+    spec->width      = -1;
+    spec->width_star = false;
+    if ('*' == *s) {
+        spec->width_star = true;
+        ++s;
+    }
+    else if ((*s >= '0') && (*s <= '9')) {
+        spec->width = 0;
+        while ((*s >= '0') && (*s <= '9')) {
+            spec->width = spec->width * 10 + (*s++ - '0');
+        }
+    }
+
+    spec->prec      = -1;
+    spec->prec_star = false;
+    if ('.' == *s) {
+        ++s;
+        if ('*' == *s) {
+            spec->prec_star = true;
+            ++s;
+        }
+        else {
+            spec->prec = 0;
+            while ((*s >= '0') && (*s <= '9')) {
+                spec->prec = spec->prec * 10 + (*s++ - '0');
+            }
+        }
+    }
+
+    spec->length = 0;
+    switch (*s) {
+    case 'h':
+        spec->length = 'h';
+        if ('h' == *++s) {
+            spec->length = 'H';
+            ++s;
+        }
+        break;
+    case 'l':
+        spec->length = 'l';
+        if ('l' == *++s) {
+            spec->length = 'q';
+            ++s;
+        }
+        break;
+    case 'j':
+    case 'z':
+    case 't':
+    case 'L':
+        spec->length = *s++;
+        break;
+    default:
+        break;
+    }
+
+    spec->conv = (strchr("diouxXcpsfFeEgGaAn%", *s) != NULL) ? *s : 0;
+
+    return s;
+}
+
+
+/** A record being built */
+struct pblog_builder {
+    uint8_t* buf;
+    size_t   len;
+    size_t   size;
+};
+
+
+static bool put_u64(struct pblog_builder* b, uint64_t v)
+{
+    if (b->len + sizeof v > b->size) {
+        return false;
+    }
+    memcpy(b->buf + b->len, &v, sizeof v);
+    b->len += sizeof v;
+    return true;
+}
+
+
+static bool put_double(struct pblog_builder* b, double v)
+{
+    if (b->len + sizeof v > b->size) {
+        return false;
+    }
+    memcpy(b->buf + b->len, &v, sizeof v);
+    b->len += sizeof v;
+    return true;
+}
+
+
+static bool put_str(struct pblog_builder* b, char const* s, int prec)
+{
+    size_t n = 0;
+    size_t room;
+
+    if (NULL == s) {
+        s = "(null)";
+    }
+    if (b->len + sizeof(uint64_t) + 8 > b->size) {
+        return false;
+    }
+    room = b->size - b->len - sizeof(uint64_t) - 1;
+    while ((n < room) && ((prec < 0) || (n < (size_t)prec)) && (s[n] != '\0')) {
+        ++n;
+    }
+    put_u64(b, n);
+    memcpy(b->buf + b->len, s, n);
+    b->buf[b->len + n] = '\0';
+    b->len += ALIGN8(n + 1);
+
+    return true;
+}
+
+
+static bool record_arg(struct pblog_builder* b, struct pblog_spec const* spec, int prec, va_list* args)
+{
+    switch (spec->conv) {
+    case 'd':
+    case 'i':
+        switch (spec->length) {
+        case 'l':
+            return put_u64(b, (uint64_t)(long long)va_arg(*args, long));
+        case 'q':
+            return put_u64(b, (uint64_t)va_arg(*args, long long));
+        case 'j':
+            return put_u64(b, (uint64_t)(long long)va_arg(*args, intmax_t));
+        case 'z':
+            return put_u64(b, (uint64_t)(long long)va_arg(*args, size_t));
+        case 't':
+            return put_u64(b, (uint64_t)(long long)va_arg(*args, ptrdiff_t));
+        case 'h':
+            return put_u64(b, (uint64_t)(long long)(short)va_arg(*args, int));
+        case 'H':
+            return put_u64(b, (uint64_t)(long long)(signed char)va_arg(*args, int));
+        default:
+            return put_u64(b, (uint64_t)(long long)va_arg(*args, int));
+        }
+    case 'o':
+    case 'u':
+    case 'x':
+    case 'X':
+        switch (spec->length) {
+        case 'l':
+            return put_u64(b, va_arg(*args, unsigned long));
+        case 'q':
+            return put_u64(b, va_arg(*args, unsigned long long));
+        case 'j':
+            return put_u64(b, va_arg(*args, uintmax_t));
+        case 'z':
+            return put_u64(b, va_arg(*args, size_t));
+        case 't':
+            return put_u64(b, (uint64_t)va_arg(*args, ptrdiff_t));
+        case 'h':
+            return put_u64(b, (unsigned short)va_arg(*args, unsigned));
+        case 'H':
+            return put_u64(b, (unsigned char)va_arg(*args, unsigned));
+        default:
+            return put_u64(b, va_arg(*args, unsigned));
+        }
+    case 'c':
+        return put_u64(b, (uint64_t)(long long)va_arg(*args, int));
+    case 'p':
+        return put_u64(b, (uint64_t)(uintptr_t)va_arg(*args, void*));
+    case 's':
+        return put_str(b, va_arg(*args, char const*), prec);
+    case 'n':
+        (void)va_arg(*args, void*);
+        return true;
+    case '%':
+        return true;
+    default:
+        if ('L' == spec->length) {
+            return put_double(b, (double)va_arg(*args, long double));
+        }
+        return put_double(b, va_arg(*args, double));
+    }
+}
+
+
+static bool ring_put(struct pblog_ring* ring, void const* rec, uint32_t n)
+{
+    uint32_t const head   = ring->head;
+    uint32_t const tail   = LOAD_ACQUIRE(&ring->tail);
+    uint32_t       pos    = head & (PUBNUB_LOG_ASYNC_RING_SIZE - 1);
+    uint32_t const to_end = PUBNUB_LOG_ASYNC_RING_SIZE - pos;
+    uint32_t const need   = (n <= to_end) ? n : to_end + n;
+    uint32_t       new_head;
+
+    if (PUBNUB_LOG_ASYNC_RING_SIZE - (head - tail) < need) {
+        return false;
+    }
+    new_head = head;
+    if (n > to_end) {
+        uint32_t const wrap = 0;
+        memcpy(ring->data + pos, &wrap, sizeof wrap);
+        new_head += to_end;
+        pos = 0;
+    }
+    memcpy(ring->data + pos, rec, n);
+    STORE_RELEASE(&ring->head, new_head + n);
+
+    return true;
+}
+
+
+void pubnub_log_async_record(enum pubnub_log_level level, char const* fmt, ...)
+{
+    uint64_t             buf[PUBNUB_LOG_ASYNC_MAX_RECORD / sizeof(uint64_t)];
+    struct pblog_builder b;
+    struct pblog_head    head;
+    struct pblog_ring*   ring = my_ring();
+    char const*          s;
+    va_list              args;
+
+    PUBNUB_ASSERT_OPT(fmt != NULL);
+
+    if (NULL == ring) {
+        FETCH_INC(&m_dropped);
+        return;
+    }
+    b.buf  = (uint8_t*)buf;
+    b.len  = HEAD_SIZE;
+    b.size = sizeof buf;
+
+    va_start(args, fmt);
+    for (s = fmt; *s != '\0'; ++s) {
+        struct pblog_spec spec;
+        int               prec;
+
+        if (*s != '%') {
+            continue;
+        }
+        s = parse_spec(s + 1, &spec);
+        if (spec.width_star && !put_u64(&b, (uint64_t)(long long)va_arg(args, int))) {
+            break;
+        }
+        prec = spec.prec;
+        if (spec.prec_star) {
+            prec = va_arg(args, int);
+            if (!put_u64(&b, (uint64_t)(long long)prec)) {
+                break;
+            }
+        }
+        if ((0 == spec.conv) || !record_arg(&b, &spec, prec, &args)) {
+            break;
+        }
+    }
+    va_end(args);
+
+    head.size  = (uint32_t)b.len;
+    head.level = level;
+    head.fmt   = fmt;
+    memcpy(b.buf, &head, sizeof head);
+    if (!ring_put(ring, b.buf, head.size)) {
+        FETCH_INC(&m_dropped);
+    }
+}
+
+
+/** A formatted message being built */
+struct pblog_text {
+    char   buf[MAX_TEXT];
+    size_t len;
+};
+
+
+static void text_add(struct pblog_text* t, int n)
+{
+    if (n > 0) {
+        t->len += n;
+        if (t->len >= sizeof t->buf) {
+            t->len = sizeof t->buf - 1;
+        }
+    }
+}
+
+
+static bool get_u64(uint8_t const** p, uint8_t const* end, uint64_t* v)
+{
+    if (*p + sizeof *v > end) {
+        return false;
+    }
+    memcpy(v, *p, sizeof *v);
+    *p += sizeof *v;
+    return true;
+}
+
+
+static bool format_arg(struct pblog_text*       t,
+                       char const*              conv_spec,
+                       struct pblog_spec const* spec,
+                       uint8_t const**          p,
+                       uint8_t const*           end)
+{
+    char* const  out  = t->buf + t->len;
+    size_t const room = sizeof t->buf - t->len;
+    uint64_t     v;
+
+    switch (spec->conv) {
+    case 'd':
+    case 'i':
+        if (!get_u64(p, end, &v)) {
+            return false;
+        }
+        text_add(t, snprintf(out, room, conv_spec, (long long)v));
+        return true;
+    case 'o':
+    case 'u':
+    case 'x':
+    case 'X':
+        if (!get_u64(p, end, &v)) {
+            return false;
+        }
+        text_add(t, snprintf(out, room, conv_spec, (unsigned long long)v));
+        return true;
+    case 'c':
+        if (!get_u64(p, end, &v)) {
+            return false;
+        }
+        text_add(t, snprintf(out, room, conv_spec, (int)v));
+        return true;
+    case 'p':
+        if (!get_u64(p, end, &v)) {
+            return false;
+        }
+        text_add(t, snprintf(out, room, conv_spec, (void*)(uintptr_t)v));
+        return true;
+    case 's':
+        if (!get_u64(p, end, &v) || (*p + ALIGN8(v + 1) > end)) {
+            return false;
+        }
+        text_add(t, snprintf(out, room, conv_spec, (char const*)*p));
+        *p += ALIGN8(v + 1);
+        return true;
+    case 'n':
+        return true;
+    case '%':
+        text_add(t, snprintf(out, room, "%%"));
+        return true;
+    default: {
+        double d;
+        if (*p + sizeof d > end) {
+            return false;
+        }
+        memcpy(&d, *p, sizeof d);
+        *p += sizeof d;
+        text_add(t, snprintf(out, room, conv_spec, d));
+        return true;
+    }
+    }
+}
+
+
+static void format_record(uint8_t const* rec, struct pblog_text* t)
+{
+    struct pblog_head head;
+    uint8_t const*    p;
+    uint8_t const*    end;
+    char const*       s;
+
+    memcpy(&head, rec, sizeof head);
+    p      = rec + HEAD_SIZE;
+    end    = rec + head.size;
+    t->len = 0;
+    for (s = head.fmt; (*s != '\0') && (t->len < sizeof t->buf - 1); ++s) {
+        struct pblog_spec spec;
+        char              conv_spec[32];
+        uint64_t          v;
+        int               n;
+
+        if (*s != '%') {
+            t->buf[t->len++] = *s;
+            continue;
+        }
+        s = parse_spec(s + 1, &spec);
+        if (0 == spec.conv) {
+            break;
+        }
+        n = snprintf(conv_spec, sizeof conv_spec, "%%%s", spec.flags);
+        if (spec.width_star) {
+            if (!get_u64(&p, end, &v)) {
+                break;
+            }
+            n += snprintf(conv_spec + n, sizeof conv_spec - n, "%d", (int)v);
+        }
+        else if (spec.width >= 0) {
+            n += snprintf(conv_spec + n, sizeof conv_spec - n, "%d", spec.width);
+        }
+        if (spec.prec_star) {
+            if (!get_u64(&p, end, &v)) {
+                break;
+            }
+            n += snprintf(conv_spec + n, sizeof conv_spec - n, ".%d", (int)v);
+        }
+        else if (spec.prec >= 0) {
+            n += snprintf(conv_spec + n, sizeof conv_spec - n, ".%d", spec.prec);
+        }
+        snprintf(conv_spec + n,
+                 sizeof conv_spec - n,
+                 "%s%c",
+                 (strchr("diouxX", spec.conv) != NULL) ? "ll" : "",
+                 spec.conv);
+        if (!format_arg(t, conv_spec, &spec, &p, end)) {
+            break;
+        }
+    }
+    t->buf[t->len] = '\0';
+}
+
+
+static void write_text(enum pubnub_log_level level, char const* text)
+{
+    if (NULL == m_writer) {
+        fputs(text, stdout);
+    }
+    else {
+        m_writer(level, text);
+    }
+}
+
+
+static size_t ring_drain(struct pblog_ring* ring, struct pblog_text* t)
+{
+    uint32_t       tail  = ring->tail;
+    uint32_t const head  = LOAD_ACQUIRE(&ring->head);
+    size_t         count = 0;
+
+    while (tail != head) {
+        uint32_t const pos = tail & (PUBNUB_LOG_ASYNC_RING_SIZE - 1);
+        uint32_t       size;
+
+        memcpy(&size, ring->data + pos, sizeof size);
+        if (0 == size) {
+            tail += PUBNUB_LOG_ASYNC_RING_SIZE - pos;
+        }
+        else {
+            struct pblog_head h;
+            memcpy(&h, ring->data + pos, sizeof h);
+            format_record(ring->data + pos, t);
+            write_text((enum pubnub_log_level)h.level, t->buf);
+            tail += size;
+            ++count;
+        }
+        STORE_RELEASE(&ring->tail, tail);
+    }
+
+    return count;
+}
+
+
+size_t pubnub_log_async_drain(void)
+{
+    static struct pblog_text t;
+    size_t                   count = 0;
+    unsigned                 dropped;
+    unsigned                 i;
+
+    for (i = 0; i < PUBNUB_LOG_ASYNC_THREADS; ++i) {
+        struct pblog_ring* ring = (struct pblog_ring*)LOAD_PTR_ACQUIRE(&m_ring[i]);
+        if (ring != NULL) {
+            count += ring_drain(ring, &t);
+        }
+    }
+    dropped = EXCHANGE_ZERO(&m_dropped);
+    if (dropped > 0) {
+        snprintf(t.buf, sizeof t.buf, "pubnub_log_async: %u log records dropped\n", dropped);
+        write_text(PUBNUB_LOG_LEVEL_WARNING, t.buf);
+    }
+    if ((count > 0) && (NULL == m_writer)) {
+        fflush(stdout);
+    }
+
+    return count;
+}
@@ -0,0 +1,122 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PUBNUB_LOG_ASYNC
+#define INC_PUBNUB_LOG_ASYNC
+
+
+#include "pubnub_log.h"
+
+#include <stddef.h>
+
+
+/** @file pubnub_log_async.h
+    This is the "Asynchronous log" backend of the "Log" API. Instead
+    of formatting and printing a log message in the thread that logs
+    it, it writes a compact binary record (pointer to the format
+    string and the raw values of the arguments) into a lock-free ring
+    buffer of the logging thread. The records are formatted and
+    written out later, by a background thread started with
+    pubnub_log_async_start() (or whoever calls
+    pubnub_log_async_drain()).
+
+    To use it, define PUBNUB_LOG_ASYNC to true (!=0) when compiling
+    the C-core (and your code that uses the PUBNUB_LOG_xxx macros).
+
+    The PUBNUB_LOG_LEVEL is still the highest level that is compiled
+    in, but what is actually recorded can be changed at runtime, with
+    pubnub_log_set_level(). So, one can compile with TRACE level, run
+    at WARNING and switch to TRACE for a few minutes when needed.
+
+    Records are dropped (and counted) if a ring buffer is full, or if
+    more than PUBNUB_LOG_ASYNC_THREADS threads that log are alive at
+    the same time. Strings given as
+    arguments are copied into the record, and truncated if they don't
+    fit in it.
+*/
+
+
+#if !defined PUBNUB_LOG_ASYNC_THREADS
+/** Maximum number of threads that can log at the same time, each
+    has its own ring buffer. A ring buffer is allocated on the first
+    log from a thread and, when the thread exits, it is released to be
+    used by the next thread that logs (it is never freed). */
+#define PUBNUB_LOG_ASYNC_THREADS 16
+#endif
+
+#if !defined PUBNUB_LOG_ASYNC_RING_SIZE
+/** Size of the ring buffer of a thread, in bytes. Has to be a power
+    of two. */
+#define PUBNUB_LOG_ASYNC_RING_SIZE 65536
+#endif
+
+#if !defined PUBNUB_LOG_ASYNC_MAX_RECORD
+/** Maximum size of a single (binary) record, in bytes */
+#define PUBNUB_LOG_ASYNC_MAX_RECORD 512
+#endif
+
+#if !defined PUBNUB_LOG_ASYNC_DRAIN_MS
+/** How long does the background thread sleep (in milliseconds)
+    when it finds no records to format */
+#define PUBNUB_LOG_ASYNC_DRAIN_MS 10
+#endif
+
+
+/** The runtime log level - only messages of this level (or more
+    important) are recorded. Don't change it directly, use
+    pubnub_log_set_level().
+ */
+extern int volatile pubnub_log_runtime_level;
+
+/** Sets the runtime log @p level. Messages less important than
+    it are not recorded. Can be called at any time, from any thread.
+    Has no effect on messages not compiled in (less important than
+    the PUBNUB_LOG_LEVEL).
+ */
+void pubnub_log_set_level(enum pubnub_log_level level);
+
+/** Returns the current runtime log level */
+enum pubnub_log_level pubnub_log_get_level(void);
+
+/** Records a log message of the @p level, with the printf-like
+    format @p fmt and the arguments that follow. This is what the
+    PUBNUB_LOG_xxx macros call when PUBNUB_LOG_ASYNC is true - you
+    don't need to call it yourself.
+
+    The @p fmt has to be a string with static storage duration
+    (string literal), as only the pointer to it is recorded.
+ */
+void pubnub_log_async_record(enum pubnub_log_level level, char const* fmt, ...);
+
+/** Type of function that writes out a formatted log @p text of the
+    given @p level. The @p text is NUL-terminated and usually
+    (but not necessarily) ends with a newline.
+ */
+typedef void (*pubnub_log_writer_t)(enum pubnub_log_level level, char const* text);
+
+/** Sets the function that writes out formatted log messages. The
+    default is to write them to the standard output. Pass NULL to
+    restore the default.
+ */
+void pubnub_log_async_set_writer(pubnub_log_writer_t writer);
+
+/** Formats all the records from all the ring buffers and writes
+    them out (using the writer). Is not to be called concurrently
+    (from more than one thread at a time).
+
+    @return Number of records formatted
+ */
+size_t pubnub_log_async_drain(void);
+
+/** Starts the background thread that drains the records.
+    @retval 0 started (or was already started)
+    @retval -1 failed to start
+ */
+int pubnub_log_async_start(void);
+
+/** Stops the background thread that drains the records, draining
+    the records that are left, if any. Should be called from the
+    same thread as pubnub_log_async_start().
+ */
+void pubnub_log_async_stop(void);
+
+
+#endif /* !defined INC_PUBNUB_LOG_ASYNC */
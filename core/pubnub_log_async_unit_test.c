@@ -0,0 +1,200 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "cgreen/cgreen.h"
+#include "cgreen/mocks.h"
+
+#include "pubnub_log_async.h"
+
+#include <pthread.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+
+
+/* A less chatty cgreen :) */
+
+#define attest assert_that
+#define equals is_equal_to
+#define streqs is_equal_to_string
+#define differs is_not_equal_to
+#define strdifs is_not_equal_to_string
+#define ptreqs(val) is_equal_to_contents_of(&(val), sizeof(val))
+#define ptrdifs(val) is_not_equal_to_contents_of(&(val), sizeof(val))
+#define sets(par, val) will_set_contents_of_parameter(par, &(val), sizeof(val))
+#define sets_ex will_set_contents_of_parameter
+#define returns will_return
+
+
+static char m_written[4096];
+
+static enum pubnub_log_level m_written_level;
+
+
+static void test_writer(enum pubnub_log_level level, char const* text)
+{
+    if (strlen(m_written) + strlen(text) >= sizeof m_written) {
+        m_written[0] = '\0';
+    }
+    strcat(m_written, text);
+    m_written_level = level;
+}
+
+
+static void* log_from_thread(void* arg)
+{
+    pubnub_log_async_record(PUBNUB_LOG_LEVEL_INFO, "t%d;", *(int*)arg);
+    return NULL;
+}
+
+
+static void* log_and_wait(void* arg)
+{
+    pthread_barrier_t* barrier = (pthread_barrier_t*)arg;
+    pubnub_log_async_record(PUBNUB_LOG_LEVEL_INFO, "w;");
+    pthread_barrier_wait(barrier);
+    pthread_barrier_wait(barrier);
+    return NULL;
+}
+
+
+Describe(pubnub_log_async);
+
+
+BeforeEach(pubnub_log_async) {
+    pubnub_log_async_set_writer(test_writer);
+    pubnub_log_async_drain();
+    m_written[0] = '\0';
+}
+
+
+AfterEach(pubnub_log_async) {
+    pubnub_log_async_set_writer(NULL);
+}
+
+
+Ensure(pubnub_log_async, formats_when_drained) {
+    pubnub_log_async_record(PUBNUB_LOG_LEVEL_DEBUG, "state=%d\n", 42);
+    attest(m_written, streqs(""));
+    attest(pubnub_log_async_drain(), equals(1));
+    attest(m_written, streqs("state=42\n"));
+    attest(m_written_level, equals(PUBNUB_LOG_LEVEL_DEBUG));
+    attest(pubnub_log_async_drain(), equals(0));
+}
+
+Ensure(pubnub_log_async, formats_all_kinds_of_arguments) {
+    pubnub_log_async_record(PUBNUB_LOG_LEVEL_TRACE,
+                            "%c|%5s|%-4u|%lx|%ld|%hu|%.2f|%%|%lu",
+                            'x',
+                            "ab",
+                            7u,
+                            255ul,
+                            -3l,
+                            (unsigned short)9,
+                            1.5,
+                            (unsigned long)4000000000ul);
+    attest(pubnub_log_async_drain(), equals(1));
+    attest(m_written, streqs("x|   ab|7   |ff|-3|9|1.50|%|4000000000"));
+}
+
+Ensure(pubnub_log_async, copies_strings) {
+    char buf[] = "original";
+    pubnub_log_async_record(PUBNUB_LOG_LEVEL_INFO, "%s/%.*s", buf, 3, buf + 4);
+    strcpy(buf, "changed");
+    attest(pubnub_log_async_drain(), equals(1));
+    attest(m_written, streqs("original/ina"));
+}
+
+Ensure(pubnub_log_async, keeps_order_within_thread) {
+    int i;
+    for (i = 0; i < 3; ++i) {
+        pubnub_log_async_record(PUBNUB_LOG_LEVEL_INFO, "%d;", i);
+    }
+    attest(pubnub_log_async_drain(), equals(3));
+    attest(m_written, streqs("0;1;2;"));
+}
+
+Ensure(pubnub_log_async, wraps_around_the_ring) {
+    int i;
+    for (i = 0; i < PUBNUB_LOG_ASYNC_RING_SIZE / 16; ++i) {
+        pubnub_log_async_record(PUBNUB_LOG_LEVEL_INFO, "%d", i);
+        attest(pubnub_log_async_drain(), equals(1));
+        m_written[0] = '\0';
+    }
+    pubnub_log_async_record(PUBNUB_LOG_LEVEL_INFO, "last %s", "one");
+    attest(pubnub_log_async_drain(), equals(1));
+    attest(m_written, streqs("last one"));
+}
+
+Ensure(pubnub_log_async, reports_dropped_records) {
+    int    i;
+    size_t drained;
+    char   expected[64];
+
+    for (i = 0; i < PUBNUB_LOG_ASYNC_RING_SIZE / 16; ++i) {
+        pubnub_log_async_record(PUBNUB_LOG_LEVEL_INFO, "%d", i);
+    }
+    drained = pubnub_log_async_drain();
+    attest(drained < PUBNUB_LOG_ASYNC_RING_SIZE / 16);
+    snprintf(expected,
+             sizeof expected,
+             "%u log records dropped\n",
+             (unsigned)(PUBNUB_LOG_ASYNC_RING_SIZE / 16 - drained));
+    attest(strstr(m_written, expected) != NULL);
+    attest(m_written_level, equals(PUBNUB_LOG_LEVEL_WARNING));
+}
+
+Ensure(pubnub_log_async, runtime_level) {
+    enum pubnub_log_level level = pubnub_log_get_level();
+    pubnub_log_set_level(PUBNUB_LOG_LEVEL_WARNING);
+    attest(pubnub_log_get_level(), equals(PUBNUB_LOG_LEVEL_WARNING));
+    attest(pubnub_log_runtime_level, equals(PUBNUB_LOG_LEVEL_WARNING));
+    pubnub_log_set_level(level);
+}
+
+Ensure(pubnub_log_async, reuses_rings_of_exited_threads) {
+    int i;
+    for (i = 0; i < 2 * PUBNUB_LOG_ASYNC_THREADS; ++i) {
+        pthread_t thread;
+        attest(pthread_create(&thread, NULL, log_from_thread, &i), equals(0));
+        attest(pthread_join(thread, NULL), equals(0));
+    }
+    attest(pubnub_log_async_drain(), equals(2 * PUBNUB_LOG_ASYNC_THREADS));
+    attest(strstr(m_written, "dropped"), equals(NULL));
+    attest(strstr(m_written, "t0;"), differs(NULL));
+    attest(strstr(m_written, "t31;"), differs(NULL));
+}
+
+Ensure(pubnub_log_async, drops_when_too_many_threads_alive) {
+    pthread_barrier_t barrier;
+    pthread_t         thread[PUBNUB_LOG_ASYNC_THREADS];
+    pthread_t         extra;
+    int               i;
+
+    /* This thread owns a ring too */
+    pubnub_log_async_record(PUBNUB_LOG_LEVEL_INFO, "main;");
+    attest(pthread_barrier_init(&barrier, NULL, PUBNUB_LOG_ASYNC_THREADS), equals(0));
+    for (i = 0; i < PUBNUB_LOG_ASYNC_THREADS - 1; ++i) {
+        attest(pthread_create(&thread[i], NULL, log_and_wait, &barrier), equals(0));
+    }
+    pthread_barrier_wait(&barrier);
+
+    i = 99;
+    attest(pthread_create(&extra, NULL, log_from_thread, &i), equals(0));
+    attest(pthread_join(extra, NULL), equals(0));
+    attest(pubnub_log_async_drain(), equals(PUBNUB_LOG_ASYNC_THREADS));
+    attest(strstr(m_written, "t99;"), equals(NULL));
+    attest(strstr(m_written, "1 log records dropped\n"), differs(NULL));
+
+    /* Once they are gone, new threads can log again */
+    pthread_barrier_wait(&barrier);
+    for (i = 0; i < PUBNUB_LOG_ASYNC_THREADS - 1; ++i) {
+        attest(pthread_join(thread[i], NULL), equals(0));
+    }
+    pthread_barrier_destroy(&barrier);
+    i = 99;
+    attest(pthread_create(&extra, NULL, log_from_thread, &i), equals(0));
+    attest(pthread_join(extra, NULL), equals(0));
+    attest(pubnub_log_async_drain(), equals(1));
+    attest(strstr(m_written, "t99;"), differs(NULL));
+}
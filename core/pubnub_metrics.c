@@ -0,0 +1,316 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "pubnub_metrics.h"
+
+#include "pubnub_internal.h"
+#if !PUBNUB_METRICS
+#error Must define PUBNUB_METRICS to true (!=0) before compiling this file
+#endif
+#include "pbmetrics.h"
+#include "pubnub_assert.h"
+
+#include <string.h>
+
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#define THREAD_LOCAL __declspec(thread)
+#define ATOMIC_LOAD(p) ((uint64_t)InterlockedCompareExchange64((LONG64 volatile*)(p), 0, 0))
+#define ATOMIC_STORE(p, v) InterlockedExchange64((LONG64 volatile*)(p), (LONG64)(v))
+#define ATOMIC_ADD(p, v) InterlockedExchangeAdd64((LONG64 volatile*)(p), (LONG64)(v))
+#define ATOMIC_FETCH_INC(p) ((unsigned)InterlockedIncrement((LONG volatile*)(p)) - 1)
+#else
+#define THREAD_LOCAL __thread
+#define ATOMIC_LOAD(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#define ATOMIC_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#define ATOMIC_ADD(p, v) __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+#define ATOMIC_FETCH_INC(p) __atomic_fetch_add((p), 1, __ATOMIC_RELAXED)
+#endif
+
+
+/** The metrics as updated by one thread (or, for the first one,
+    shared by all threads that don't have their own).
+ */
+struct pbmetrics_shard {
+    uint64_t counter[pbmcCount];
+    uint64_t bucket[pbmhCount][PUBNUB_METRICS_BUCKETS + 1];
+    uint64_t sum[pbmhCount];
+    /** To keep the shards of different threads in different cache
+        lines */
+    char pad[64];
+};
+
+/** Shard 0 is shared, all others are owned by one thread each */
+static struct pbmetrics_shard m_shard[PUBNUB_METRICS_THREADS];
+
+/** Number of shards given out so far (shard 0 is never given out
+    to a thread to own) */
+static unsigned m_shards_taken = 1;
+
+/** The shard of the current thread, NULL if it didn't get one yet */
+static THREAD_LOCAL struct pbmetrics_shard* m_my_shard;
+
+static int64_t m_gauge[pbmgCount];
+
+/** Upper bounds of the (finite) buckets of the histograms */
+static uint64_t const m_bound[PUBNUB_METRICS_BUCKETS] = {
+    1, 2, 5, 10, 25, 50, 100, 250, 500, 1000
+};
+
+static char const* const m_counter_name[pbmcCount] = {
+    "pubnub_transactions_total",
+    "pubnub_connections_total",
+    "pubnub_keep_alive_reuses_total",
+    "pubnub_reconnects_total",
+    "pubnub_bytes_sent_total",
+    "pubnub_bytes_received_total",
+    "pubnub_gzip_compressed_bytes_total",
+    "pubnub_gzip_decompressed_bytes_total"
+};
+
+static char const* const m_counter_help[pbmcCount] = {
+    "Transactions started",
+    "TCP connections established",
+    "Transactions done on a kept-alive connection",
+    "Connections re-established during a transaction",
+    "Bytes sent",
+    "Bytes received",
+    "Bytes of compressed responses",
+    "Bytes compressed responses were decompressed to"
+};
+
+static char const* const m_gauge_name[pbmgCount] = {
+    "pubnub_callback_queue_depth",
+    "pubnub_watched_sockets"
+};
+
+static char const* const m_gauge_help[pbmgCount] = {
+    "Contexts queued for processing",
+    "Sockets watched by the poller"
+};
+
+static char const* const m_histogram_name[pbmhCount] = {
+    "pubnub_poll_loop_lag_ms"
+};
+
+static char const* const m_histogram_help[pbmhCount] = {
+    "Duration of an iteration of the poll loop, in milliseconds"
+};
+
+
+static struct pbmetrics_shard* my_shard(void)
+{
+    if (NULL == m_my_shard) {
+        unsigned i = ATOMIC_FETCH_INC(&m_shards_taken);
+        m_my_shard = m_shard + ((i < PUBNUB_METRICS_THREADS) ? i : 0);
+    }
+    return m_my_shard;
+}
+
+
+static void shard_add(struct pbmetrics_shard* shard, uint64_t* p, uint64_t n)
+{
+    if (shard == m_shard) {
+        ATOMIC_ADD(p, n);
+    }
+    else {
+        /* Only this thread writes to its own shard, no need for an
+           atomic read-modify-write */
+        ATOMIC_STORE(p, ATOMIC_LOAD(p) + n);
+    }
+}
+
+
+void pbmetrics_add(enum pubnub_metrics_counter counter, uint64_t n)
+{
+    struct pbmetrics_shard* shard = my_shard();
+    PUBNUB_ASSERT_OPT(counter < pbmcCount);
+    shard_add(shard, &shard->counter[counter], n);
+}
+
+
+void pbmetrics_gauge_set(enum pubnub_metrics_gauge gauge, int64_t value)
+{
+    PUBNUB_ASSERT_OPT(gauge < pbmgCount);
+    ATOMIC_STORE(&m_gauge[gauge], value);
+}
+
+
+void pbmetrics_observe(enum pubnub_metrics_histogram histogram, uint64_t value)
+{
+    struct pbmetrics_shard* shard = my_shard();
+    unsigned                i;
+
+    PUBNUB_ASSERT_OPT(histogram < pbmhCount);
+    for (i = 0; (i < PUBNUB_METRICS_BUCKETS) && (value > m_bound[i]); ++i) {
+        continue;
+    }
+    shard_add(shard, &shard->bucket[histogram][i], 1);
+    shard_add(shard, &shard->sum[histogram], value);
+}
+
+
+uint64_t pubnub_metrics_bucket_bound(unsigned i)
+{
+    PUBNUB_ASSERT_OPT(i < PUBNUB_METRICS_BUCKETS);
+    return m_bound[i];
+}
+
+
+void pubnub_metrics_snapshot(struct pubnub_metrics_snapshot* snapshot)
+{
+    unsigned s;
+    unsigned i;
+    unsigned j;
+
+    PUBNUB_ASSERT_OPT(snapshot != NULL);
+
+    memset(snapshot, 0, sizeof *snapshot);
+    for (s = 0; s < PUBNUB_METRICS_THREADS; ++s) {
+        struct pbmetrics_shard* shard = m_shard + s;
+        for (i = 0; i < pbmcCount; ++i) {
+            snapshot->counter[i] += ATOMIC_LOAD(&shard->counter[i]);
+        }
+        for (i = 0; i < pbmhCount; ++i) {
+            struct pubnub_metrics_histogram_snapshot* h = snapshot->histogram + i;
+            for (j = 0; j <= PUBNUB_METRICS_BUCKETS; ++j) {
+                uint64_t n = ATOMIC_LOAD(&shard->bucket[i][j]);
+                h->bucket[j] += n;
+                h->count += n;
+            }
+            h->sum += ATOMIC_LOAD(&shard->sum[i]);
+        }
+    }
+    for (i = 0; i < pbmgCount; ++i) {
+        snapshot->gauge[i] = (int64_t)ATOMIC_LOAD(&m_gauge[i]);
+    }
+}
+
+
+/** The text being formatted */
+struct pbmetrics_text {
+    char*  buf;
+    size_t size;
+    size_t len;
+};
+
+
+static void put_str(struct pbmetrics_text* t, char const* s)
+{
+    size_t n = strlen(s);
+    if (t->len + n < t->size) {
+        memcpy(t->buf + t->len, s, n);
+    }
+    t->len += n;
+}
+
+
+static void put_u64(struct pbmetrics_text* t, uint64_t v)
+{
+    char  digits[21];
+    char* p = digits + sizeof digits - 1;
+
+    *p = '\0';
+    do {
+        *--p = (char)('0' + v % 10);
+        v /= 10;
+    } while (v != 0);
+    put_str(t, p);
+}
+
+
+static void put_i64(struct pbmetrics_text* t, int64_t v)
+{
+    if (v < 0) {
+        put_str(t, "-");
+        put_u64(t, -(uint64_t)v);
+    }
+    else {
+        put_u64(t, (uint64_t)v);
+    }
+}
+
+
+static void put_head(struct pbmetrics_text* t,
+                     char const*            name,
+                     char const*            help,
+                     char const*            type)
+{
+    put_str(t, "# HELP ");
+    put_str(t, name);
+    put_str(t, " ");
+    put_str(t, help);
+    put_str(t, "\n# TYPE ");
+    put_str(t, name);
+    put_str(t, " ");
+    put_str(t, type);
+    put_str(t, "\n");
+}
+
+
+int pubnub_metrics_format_text(struct pubnub_metrics_snapshot const* snapshot,
+                               char*                                 buf,
+                               size_t                                size)
+{
+    struct pbmetrics_text t;
+    unsigned              i;
+    unsigned              j;
+
+    PUBNUB_ASSERT_OPT(snapshot != NULL);
+    PUBNUB_ASSERT_OPT(buf != NULL);
+
+    t.buf  = buf;
+    t.size = size;
+    t.len  = 0;
+    for (i = 0; i < pbmcCount; ++i) {
+        put_head(&t, m_counter_name[i], m_counter_help[i], "counter");
+        put_str(&t, m_counter_name[i]);
+        put_str(&t, " ");
+        put_u64(&t, snapshot->counter[i]);
+        put_str(&t, "\n");
+    }
+    for (i = 0; i < pbmgCount; ++i) {
+        put_head(&t, m_gauge_name[i], m_gauge_help[i], "gauge");
+        put_str(&t, m_gauge_name[i]);
+        put_str(&t, " ");
+        put_i64(&t, snapshot->gauge[i]);
+        put_str(&t, "\n");
+    }
+    for (i = 0; i < pbmhCount; ++i) {
+        struct pubnub_metrics_histogram_snapshot const* h = snapshot->histogram + i;
+        uint64_t cumulative                               = 0;
+
+        put_head(&t, m_histogram_name[i], m_histogram_help[i], "histogram");
+        for (j = 0; j <= PUBNUB_METRICS_BUCKETS; ++j) {
+            cumulative += h->bucket[j];
+            put_str(&t, m_histogram_name[i]);
+            put_str(&t, "_bucket{le=\"");
+            if (j < PUBNUB_METRICS_BUCKETS) {
+                put_u64(&t, m_bound[j]);
+            }
+            else {
+                put_str(&t, "+Inf");
+            }
+            put_str(&t, "\"} ");
+            put_u64(&t, cumulative);
+            put_str(&t, "\n");
+        }
+        put_str(&t, m_histogram_name[i]);
+        put_str(&t, "_sum ");
+        put_u64(&t, h->sum);
+        put_str(&t, "\n");
+        put_str(&t, m_histogram_name[i]);
+        put_str(&t, "_count ");
+        put_u64(&t, h->count);
+        put_str(&t, "\n");
+    }
+
+    if (t.len >= size) {
+        if (size > 0) {
+            buf[0] = '\0';
+        }
+        return -1;
+    }
+    buf[t.len] = '\0';
+
+    return (int)t.len;
+}
@@ -0,0 +1,127 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PUBNUB_METRICS
+#define INC_PUBNUB_METRICS
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/** @file pubnub_metrics.h
+    This is the "Metrics" API of the Pubnub client library. It gives
+    the values of counters, gauges and histograms that describe the
+    health of the Pubnub C-core "engine" (for all contexts), like
+    the number of transactions, connections and bytes transferred,
+    the depth of the callback queue or the lag of the poll loop.
+
+    The metrics are updated without locking - each thread updates
+    its own copy of counters and histograms (first
+    PUBNUB_METRICS_THREADS - 1 threads to update them, the rest
+    share one copy), which are summed up when a snapshot is taken.
+    So, taking a snapshot (as often as you like) doesn't disturb the
+    threads doing the work.
+
+    If support for metrics is not compiled in (PUBNUB_METRICS is 0),
+    nothing is recorded, so there is no cost.
+*/
+
+
+/** The counters - they only ever go up */
+enum pubnub_metrics_counter {
+    /** Number of transactions started */
+    pbmcTransactions,
+    /** Number of (TCP) connections established */
+    pbmcConnections,
+    /** Number of transactions done on a kept-alive connection */
+    pbmcKeepAliveReuses,
+    /** Number of times a connection had to be re-established during
+        a transaction (kept-alive connection was broken, or proxy
+        wants us to retry on a new connection) */
+    pbmcReconnects,
+    /** Number of bytes sent */
+    pbmcBytesSent,
+    /** Number of bytes received */
+    pbmcBytesReceived,
+    /** Number of bytes of compressed (gzip) responses */
+    pbmcGzipCompressedBytes,
+    /** Number of bytes compressed (gzip) responses decompressed to.
+        Divided by the pbmcGzipCompressedBytes, gives the compression
+        ratio */
+    pbmcGzipDecompressedBytes,
+    /** Not a counter, the number of counters */
+    pbmcCount
+};
+
+/** The gauges - they can go up and down */
+enum pubnub_metrics_gauge {
+    /** Number of contexts in the queue for processing (callback
+        interface) */
+    pbmgCallbackQueueDepth,
+    /** Number of sockets watched (callback interface) */
+    pbmgWatchedSockets,
+    /** Not a gauge, the number of gauges */
+    pbmgCount
+};
+
+/** The histograms */
+enum pubnub_metrics_histogram {
+    /** Duration of an iteration of the poll loop (callback
+        interface), in milliseconds */
+    pbmhPollLoopLag,
+    /** Not a histogram, the number of histograms */
+    pbmhCount
+};
+
+
+/** Number of (finite) buckets of a histogram */
+#define PUBNUB_METRICS_BUCKETS 10
+
+
+/** Snapshot of a histogram */
+struct pubnub_metrics_histogram_snapshot {
+    /** Number of observations in each bucket - `bucket[i]` has the
+        observations greater than the upper bound of the bucket
+        `i-1` that are not greater than the upper bound of bucket `i`
+        (as given by pubnub_metrics_bucket_bound()). The last one has
+        all observations greater than the bound of the last finite
+        bucket. */
+    uint64_t bucket[PUBNUB_METRICS_BUCKETS + 1];
+    /** Sum of all observations */
+    uint64_t sum;
+    /** Number of observations */
+    uint64_t count;
+};
+
+
+/** Snapshot of all the metrics */
+struct pubnub_metrics_snapshot {
+    uint64_t                                 counter[pbmcCount];
+    int64_t                                  gauge[pbmgCount];
+    struct pubnub_metrics_histogram_snapshot histogram[pbmhCount];
+};
+
+
+/** Takes a snapshot of the metrics, putting it to @p snapshot.
+    It doesn't block the threads that update the metrics.
+ */
+void pubnub_metrics_snapshot(struct pubnub_metrics_snapshot* snapshot);
+
+
+/** Returns the (inclusive) upper bound of the bucket with the index
+    @p i of a histogram.
+ */
+uint64_t pubnub_metrics_bucket_bound(unsigned i);
+
+
+/** Formats the metrics @p snapshot in the Prometheus text exposition
+    format into the buffer @p buf of size @p size (NUL-terminated).
+
+    @return The length of the formatted text, -1 if @p size is too
+    small for it
+ */
+int pubnub_metrics_format_text(struct pubnub_metrics_snapshot const* snapshot,
+                               char*                                 buf,
+                               size_t                                size);
+
+
+#endif /* !defined INC_PUBNUB_METRICS */
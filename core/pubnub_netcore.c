@@ -14,13 +14,6 @@
 #include <string.h>
 
 
-/** Each HTTP chunk has a trailining CRLF ("\r\n" in C-speak).  That's
-    a little strange, but is in the "spirit" of HTTP.
-
-    We need to read it from the network interface, but, we discard it.
- */
-#define CHUNK_TRAIL_LENGTH 2
-
 #if PUBNUB_RECEIVE_GZIP_RESPONSE
 /* 'Accept-Encoding' header line */
 #define ACCEPT_ENCODING "Accept-Encoding: gzip\r\n"
@@ -57,6 +50,18 @@ static bool should_keep_alive(struct pubnub_* pb, enum pubnub_res rslt)
 }
 
 
+#if PUBNUB_ADVANCED_KEEP_ALIVE
+/** Whether to re-establish the connection, which is to be closed
+    because the keep-alive limits were reached, after reporting the
+    outcome @p rslt of the transaction */
+static bool should_rewarm(struct pubnub_ const* pb, enum pubnub_res rslt)
+{
+    return pb->keep_alive.rewarm && pb->options.use_http_keep_alive
+           && !pb->keep_alive.should_close && (PNR_OK == rslt);
+}
+#endif
+
+
 static void close_connection(struct pubnub_* pb)
 {
     if (pbpal_close(pb) <= 0) {
@@ -79,6 +84,7 @@ static void close_connection(struct pubnub_* pb)
 
 static enum pubnub_state close_kept_alive_connection(struct pubnub_* pb)
 {
+    PBMETRICS_ADD(pbmcReconnects, 1);
     if (pbpal_close(pb) <= 0) {
 #if PUBNUB_PROXY_API
         PUBNUB_LOG_TRACE(
@@ -97,8 +103,45 @@ static enum pubnub_state close_kept_alive_connection(struct pubnub_* pb)
 }
 
 
+/** Whether the origin was changed since the (kept alive) connection
+    was made, so the connection goes to the wrong server */
+static bool origin_changed(struct pubnub_ const* pb)
+{
+#if defined PUBNUB_ORIGIN_SETTABLE
+#if PUBNUB_PROXY_API
+    if (pb->proxy_type == pbproxyHTTP_GET) {
+        /* Connected to the proxy, which takes care of the origin */
+        return false;
+    }
+#endif
+    return PUBNUB_ORIGIN_SETTABLE && (pb->connected_origin != pb->origin);
+#else
+    return false;
+#endif
+}
+
+
 static void outcome_detected(struct pubnub_* pb, enum pubnub_res rslt)
 {
+#if PUBNUB_PROXY_API
+    if (pb->proxy_tunnel_reused && (STATE_CLOSED_BY_PEER == pb->sock_state)) {
+        /* The kept alive tunnel was closed (probably by the proxy,
+           while we were idle) before we got any response, so the
+           request was not handled - establish a new tunnel and send
+           it again. A timeout is not retried, as the request might
+           have been handled. */
+        PUBNUB_LOG_TRACE("outcome_detected(pb=%p): Kept alive tunnel is "
+                         "closed, establish a new one\n",
+                         pb);
+        pb->proxy_tunnel_reused = false;
+        pb->retry_after_close   = true;
+        close_connection(pb);
+        if (PBS_RETRY == pb->state) {
+            pbntf_requeue_for_processing(pb);
+        }
+        return;
+    }
+#endif
     pb->core.last_result = rslt;
     if (should_keep_alive(pb, rslt)) {
         /* We don't monitor the connection while in "keep-alive idle".
@@ -113,12 +156,51 @@ static void outcome_detected(struct pubnub_* pb, enum pubnub_res rslt)
         pb->retry_after_close = 0;
 #endif
     }
+#if PUBNUB_ADVANCED_KEEP_ALIVE
+    else if (should_rewarm(pb, rslt)) {
+        /* Report the outcome right away and keep the (spent)
+           connection until it is re-established, on the next tick,
+           unless a transaction is started before that.
+         */
+        PUBNUB_LOG_TRACE("outcome_detected(pb=%p): Keep-alive limits "
+                         "reached, will re-establish the connection\n",
+                         pb);
+        pb->keep_alive.rewarming = true;
+#if PUBNUB_PROXY_API
+        pb->retry_after_close = 0;
+#endif
+        pbntf_lost_socket(pb);
+        pbntf_trans_outcome(pb, PBS_KEEP_ALIVE_IDLE);
+        if (PBS_KEEP_ALIVE_IDLE == pb->state) {
+            pbntf_requeue_for_processing(pb);
+        }
+    }
+#endif
     else {
         close_connection(pb);
     }
 }
 
 
+/** Whether the transaction is done when connected, parking the
+    connection, without sending a request */
+static bool connect_only(struct pubnub_ const* pb)
+{
+    return PBTT_PRECONNECT == pb->trans;
+}
+
+
+/** Ends the (connect only) transaction, parking the connection in
+    the "keep-alive idle" state */
+static void park_connection(struct pubnub_* pb)
+{
+    PUBNUB_LOG_TRACE("pb=%p connected, parking the connection\n", pb);
+    pb->core.last_result = PNR_OK;
+    pbntf_lost_socket(pb);
+    pbntf_trans_outcome(pb, PBS_KEEP_ALIVE_IDLE);
+}
+
+
 static enum pubnub_res dont_parse(struct pbcc_context* p)
 {
     PUBNUB_UNUSED(p);
@@ -143,7 +225,8 @@ static PFpbcc_parse_response_T m_aParseResponse[] = { dont_parse,
                                                       dont_parse,
                                                       dont_parse,
                                                       dont_parse,
-                                                      dont_parse
+                                                      dont_parse,
+                                                      dont_parse /* PBTT_PRECONNECT */
 #else
     pbcc_parse_presence_response, /* PBTT_LEAVE */
     pbcc_parse_time_response,
@@ -157,7 +240,8 @@ static PFpbcc_parse_response_T m_aParseResponse[] = { dont_parse,
     pbcc_parse_channel_registry_response, /* PBTT_REMOVE_CHANNEL_FROM_GROUP */
     pbcc_parse_channel_registry_response, /* PBTT_ADD_CHANNEL_TO_GROUP */
     pbcc_parse_channel_registry_response, /* PBTT_LIST_CHANNEL_GROUP */
-    pbcc_parse_presence_response /* PBTT_HEARTBEAT */
+    pbcc_parse_presence_response, /* PBTT_HEARTBEAT */
+    dont_parse /* PBTT_PRECONNECT */
 #endif
 };
 
@@ -181,6 +265,70 @@ static enum pubnub_res parse_pubnub_result(struct pubnub_* pb)
 }
 
 
+#if PUBNUB_STREAMING_SUBSCRIBE
+static bool streaming_subscribe(struct pubnub_ const* pb)
+{
+    return (PBTT_SUBSCRIBE == pb->trans) && (pb->stream_cb != NULL);
+}
+
+
+static void deliver_streamed_msg(char const* msg, size_t len, void* arg)
+{
+    struct pubnub_* pb = (struct pubnub_*)arg;
+    pb->stream_cb(pb, msg, len, pb->stream_user_data);
+}
+
+
+/** Delivers the messages (fully) received so far, if "streaming"
+    the subscribe response.
+    @return Number of characters removed from the reply buffer
+*/
+static unsigned stream_subscribe_advance(struct pubnub_* pb)
+{
+    if (!streaming_subscribe(pb) || ((pb->http_code / 100) != 2)) {
+        return 0;
+    }
+#if PUBNUB_RECEIVE_GZIP_RESPONSE
+    if (pb->data_compressed != compressionNONE) {
+        return 0;
+    }
+#endif
+    return pbcc_stream_subscribe_advance(&pb->core, deliver_streamed_msg, pb);
+}
+
+
+/** Delivers the messages that could not be delivered while the
+    response was being received (like, if it was compressed).
+ */
+static void stream_subscribe_finish(struct pubnub_* pb)
+{
+    char const* msg;
+    if (!streaming_subscribe(pb) || (1 == pb->core.stream.done)) {
+        return;
+    }
+    while ((msg = pbcc_get_msg(&pb->core)) != NULL) {
+        deliver_streamed_msg(msg, strlen(msg), pb);
+    }
+}
+#endif /* PUBNUB_STREAMING_SUBSCRIBE */
+
+
+static int send_fin_head(struct pubnub_* pb)
+{
+#if PUBNUB_STREAMING_SUBSCRIBE
+    if (streaming_subscribe(pb)) {
+        /* Compressed response can't be parsed while it's being
+           received, so don't ask for it */
+        return pbpal_send_literal_str(
+            pb, "\r\nUser-Agent: PubNub-C-core/" PUBNUB_SDK_VERSION "\r\n\r\n");
+    }
+#endif
+    return pbpal_send_literal_str(pb,
+                                  "\r\nUser-Agent: PubNub-C-core/" PUBNUB_SDK_VERSION
+                                  "\r\n" ACCEPT_ENCODING "\r\n");
+}
+
+
 static void finish(struct pubnub_* pb)
 {
     enum pubnub_res pbres;
@@ -195,7 +343,9 @@ static void finish(struct pubnub_* pb)
         PUBNUB_LOG_TRACE("Proxy: retry in current connection\n");
         pb->retry_after_close = true;
 #if PUBNUB_ADVANCED_KEEP_ALIVE
-        if (pb->keep_alive.should_close) {
+        /* A tunnel that was just established is the connection we
+           need, even if we won't keep it alive after the request */
+        if (pb->keep_alive.should_close && !pb->proxy_tunnel_established) {
             close_connection(pb);
             return;
         }
@@ -221,9 +371,15 @@ static void finish(struct pubnub_* pb)
     PUBNUB_LOG_TRACE("finish(pb=%p, '%s')\n", pb, pb->core.http_reply);
 
     pbres = parse_pubnub_result(pb);
+    PBTIMINGS_MARK(pb, pbtpParsed);
     if ((PNR_OK == pbres) && ((pb->http_code / 100) != 2)) {
         pbres = PNR_HTTP_ERROR;
     }
+#if PUBNUB_STREAMING_SUBSCRIBE
+    if (PNR_OK == pbres) {
+        stream_subscribe_finish(pb);
+    }
+#endif
 
     outcome_detected(pb, pbres);
 }
@@ -266,24 +422,10 @@ static char const* pbnc_state2str(enum pubnub_state e)
         return "PBS_TX_ORIGIN";
     case PBS_TX_FIN_HEAD:
         return "PBS_TX_FIN_HEAD";
-    case PBS_RX_HTTP_VER:
-        return "PBS_RX_HTTP_VER";
     case PBS_RX_HEADERS:
         return "PBS_RX_HEADERS";
-    case PBS_RX_HEADER_LINE:
-        return "PBS_RX_HEADER_LINE";
     case PBS_RX_BODY:
         return "PBS_RX_BODY";
-    case PBS_RX_BODY_WAIT:
-        return "PBS_RX_BODY_WAIT";
-    case PBS_RX_CHUNK_LEN:
-        return "PBS_RX_CHUNK_LEN";
-    case PBS_RX_CHUNK_LEN_LINE:
-        return "PBS_RX_CHUNK_LEN_LINE";
-    case PBS_RX_BODY_CHUNK:
-        return "PBS_RX_BODY_CHUNK";
-    case PBS_RX_BODY_CHUNK_WAIT:
-        return "PBS_RX_BODY_CHUNK_WAIT";
     case PBS_WAIT_CLOSE:
         return "PBS_WAIT_CLOSE";
     case PBS_WAIT_CANCEL:
@@ -331,8 +473,11 @@ next_state:
 #if PUBNUB_PROXY_API
         pb->retry_after_close        = false;
         pb->proxy_tunnel_established = false;
+        pb->proxy_tunnel_reused      = false;
         pb->proxy_saved_path_len     = 0;
 #endif
+        PBTIMINGS_START(pb);
+        PBMETRICS_ADD(pbmcTransactions, 1);
         pb->state = PBS_READY;
         switch (pbntf_enqueue_for_processing(pb)) {
         case -1:
@@ -347,12 +492,27 @@ next_state:
         break;
 #if PUBNUB_PROXY_API
     case PBS_RETRY:
+        PBMETRICS_ADD(pbmcReconnects, 1);
         pb->retry_after_close = false;
         pb->state             = PBS_READY;
         goto next_state;
 #endif
     case PBS_READY: {
-        enum pbpal_resolv_n_connect_result rslv = pbpal_resolv_and_connect(pb);
+        enum pbpal_resolv_n_connect_result rslv;
+#if PUBNUB_PROXY_API
+        /* A tunnel doesn't outlive its connection */
+        pb->proxy_tunnel_established = false;
+        pb->proxy_tunnel_reused      = false;
+#endif
+#if defined PUBNUB_ORIGIN_SETTABLE
+        pb->connected_origin = pb->origin;
+#endif
+#if PUBNUB_ADVANCED_KEEP_ALIVE
+        /* A new connection is nothing to re-warm */
+        pb->keep_alive.rewarming = false;
+#endif
+        PBTIMINGS_MARK(pb, pbtpDnsStart);
+        rslv = pbpal_resolv_and_connect(pb);
         WATCH_ENUM(rslv);
         switch (rslv) {
         case pbpal_resolv_send_wouldblock:
@@ -366,10 +526,12 @@ next_state:
             pbntf_watch_in_events(pb);
             break;
         case pbpal_connect_wouldblock:
+            PBTIMINGS_MARK_ONCE(pb, pbtpDnsEnd);
             i         = pbntf_got_socket(pb);
             pb->state = PBS_WAIT_CONNECT;
             break;
         case pbpal_connect_success:
+            PBTIMINGS_MARK_ONCE(pb, pbtpDnsEnd);
             i         = pbntf_got_socket(pb);
             pb->state = PBS_CONNECTED;
             break;
@@ -399,10 +561,12 @@ next_state:
             pbntf_watch_in_events(pb);
             break;
         case pbpal_connect_wouldblock:
+            PBTIMINGS_MARK_ONCE(pb, pbtpDnsEnd);
             pbntf_update_socket(pb);
             pb->state = PBS_WAIT_CONNECT;
             break;
         case pbpal_connect_success:
+            PBTIMINGS_MARK_ONCE(pb, pbtpDnsEnd);
             pbntf_update_socket(pb);
             pb->state = PBS_CONNECTED;
             goto next_state;
@@ -425,11 +589,13 @@ next_state:
         case pbpal_resolv_rcv_wouldblock:
             break;
         case pbpal_connect_wouldblock:
+            PBTIMINGS_MARK_ONCE(pb, pbtpDnsEnd);
             pbntf_update_socket(pb);
             pb->state = PBS_WAIT_CONNECT;
             pbntf_watch_out_events(pb);
             break;
         case pbpal_connect_success:
+            PBTIMINGS_MARK_ONCE(pb, pbtpDnsEnd);
             pbntf_update_socket(pb);
             pb->state = PBS_CONNECTED;
             pbntf_watch_out_events(pb);
@@ -463,10 +629,20 @@ next_state:
         break;
     }
     case PBS_CONNECTED:
+#if PUBNUB_PROXY_API
+        /* If retrying (in this connection), we're on it */
+        pb->retry_after_close = false;
+#endif
+        PBTIMINGS_MARK_ONCE(pb, pbtpConnect);
+        PBMETRICS_ADD(pbmcConnections, 1);
 #if PUBNUB_ADVANCED_KEEP_ALIVE
         pb->keep_alive.t_connect = time(NULL);
         pb->keep_alive.count     = 0;
 #endif
+        if (connect_only(pb)) {
+            park_connection(pb);
+            break;
+        }
         i = send_init_GET_or_CONNECT(pb);
         if (i < 0) {
             outcome_detected(pb, PNR_IO_ERROR);
@@ -638,10 +814,7 @@ next_state:
                 }
             }
 #endif
-            if (0 > pbpal_send_literal_str(
-                        pb,
-                        "\r\nUser-Agent: PubNub-C-core/" PUBNUB_SDK_VERSION
-                        "\r\n" ACCEPT_ENCODING "\r\n")) {
+            if (0 > send_fin_head(pb)) {
                 outcome_detected(pb, PNR_IO_ERROR);
                 break;
             }
@@ -656,10 +829,7 @@ next_state:
             outcome_detected(pb, PNR_IO_ERROR);
         }
         else if (0 == i) {
-            if (0 > pbpal_send_literal_str(
-                        pb,
-                        "\r\nUser-Agent: PubNub-C-core/" PUBNUB_SDK_VERSION
-                        "\r\n" ACCEPT_ENCODING "\r\n")) {
+            if (0 > send_fin_head(pb)) {
                 outcome_detected(pb, PNR_IO_ERROR);
                 break;
             }
@@ -674,76 +844,56 @@ next_state:
             outcome_detected(pb, PNR_IO_ERROR);
         }
         else if (0 == i) {
-            pbpal_start_read_line(pb);
-            pb->state = PBS_RX_HTTP_VER;
+            PBTIMINGS_MARK(pb, pbtpRequestSent);
+            pbpal_start_read_response(pb);
+            pb->state = PBS_RX_HEADERS;
             pbntf_watch_in_events(pb);
             goto next_state;
         }
         break;
-    case PBS_RX_HTTP_VER:
-        pbrslt = pbpal_line_read_status(pb);
-        PUBNUB_LOG_TRACE("pb=%p PBS_RX_HTTP_VER: pbrslt=%d\n", pb, pbrslt);
-        switch (pbrslt) {
-        case PNR_IN_PROGRESS:
-            break;
-        case PNR_OK:
-            if (strncmp(pb->core.http_buf, "HTTP/1.", 7) != 0) {
-                PUBNUB_LOG_ERROR("pb=%p bad HTTP response version: %.*s\n",
-                                 pb,
-                                 pbpal_read_len(pb),
-                                 pb->core.http_buf);
-                outcome_detected(pb, PNR_IO_ERROR);
-                break;
-            }
-            pb->http_code = atoi(pb->core.http_buf + 9);
-            WATCH_USHORT(pb->http_code);
-            pb->core.http_content_len = 0;
-            pb->http_chunked          = false;
-#if PUBNUB_ADVANCED_KEEP_ALIVE
-            pb->keep_alive.should_close = !pb->options.use_http_keep_alive;
+    case PBS_RX_HEADERS:
+        pbrslt = pbpal_read_response_status(pb);
+        PUBNUB_LOG_TRACE("pb=%p PBS_RX_HEADERS: pbrslt=%d\n", pb, pbrslt);
+#if PUBNUB_TRANSACTION_TIMINGS
+        if (pbhttp_parser_started(&pb->http_parser)) {
+            PBTIMINGS_MARK_ONCE(pb, pbtpFirstByte);
+        }
 #endif
-            pb->state = PBS_RX_HEADERS;
-            goto next_state;
-        default:
-            PUBNUB_LOG_ERROR("pb=%p in PBS_RX_HTTP_VER: failure inducing "
-                             "pbpal_line_read_status %d\n",
-                             pb,
-                             pbrslt);
-            outcome_detected(pb, pbrslt);
-            break;
+#if PUBNUB_PROXY_API
+        if (pb->proxy_tunnel_reused && pbhttp_parser_started(&pb->http_parser)) {
+            pb->proxy_tunnel_reused = false;
         }
-        break;
-    case PBS_RX_HEADERS:
-        pbpal_start_read_line(pb);
-        pb->state = PBS_RX_HEADER_LINE;
-        goto next_state;
-    case PBS_RX_HEADER_LINE:
-        pbrslt = pbpal_line_read_status(pb);
-        PUBNUB_LOG_TRACE("pb=%p PBS_RX_HEADER_LINE: pbrslt=%d\n", pb, pbrslt);
+#endif
         switch (pbrslt) {
         case PNR_IN_PROGRESS:
             break;
         case PNR_OK: {
-            /* We know that Pubnub will always use keep-alive unless
-               we ask for `close`, so, we don't check for the
-               `Connection` header.
-            */
-            char h_chunked[] = "Transfer-Encoding: chunked";
-            char h_length[]  = "Content-Length: ";
+            struct pbhttp_parser const* parser = &pb->http_parser;
+            switch (parser->event) {
+            case pbhttpEvHeader:
+                PUBNUB_LOG_TRACE("pb=%p header line was read: '%s'\n", pb, parser->line);
+                pbproxy_handle_http_header(pb, parser->line);
+                goto next_state;
+            case pbhttpEvHeadersEnd:
+                pb->http_code = parser->http_code;
+                WATCH_USHORT(pb->http_code);
+                pb->http_chunked          = parser->chunked;
+                pb->core.http_content_len = parser->content_length;
+                pb->core.http_buf_len     = 0;
 #if PUBNUB_ADVANCED_KEEP_ALIVE
-            char h_close[] = "Connection: close";
+                pb->keep_alive.should_close =
+                    !pb->options.use_http_keep_alive || parser->connection_close;
 #endif
 #if PUBNUB_RECEIVE_GZIP_RESPONSE
-            char h_encoding[] = "Content-Encoding: gzip";
+                if (parser->gzip) {
+                    pb->data_compressed = compressionGZIP;
+                }
+#endif
+#if PUBNUB_STREAMING_SUBSCRIBE
+                if (streaming_subscribe(pb)) {
+                    pbcc_stream_subscribe_start(&pb->core);
+                }
 #endif
-            int read_len = pbpal_read_len(pb);
-            PUBNUB_LOG_TRACE("pb=%p header line was read: '%.*s'\n",
-                             pb,
-                             read_len,
-                             pb->core.http_buf);
-            WATCH_INT(read_len);
-            if (read_len <= 2) {
-                pb->core.http_buf_len = 0;
                 if (!pb->http_chunked) {
                     if (0 == pb->core.http_content_len) {
 #if PUBNUB_PROXY_API
@@ -751,130 +901,91 @@ next_state:
                         WATCH_INT(pb->proxy_tunnel_established);
                         if ((pb->proxy_type == pbproxyHTTP_CONNECT)
                             && !pb->proxy_tunnel_established) {
-                            finish(pb);
+                            /* No body, the parser gets to the end of
+                               response right away */
+                            pb->state = PBS_RX_BODY;
                             goto next_state;
                         }
 #endif
                         outcome_detected(pb, PNR_IO_ERROR);
                         break;
                     }
-                    pb->state = PBS_RX_BODY;
-                }
-                else {
-                    pb->state = PBS_RX_CHUNK_LEN;
+                    if (0
+                        != pbcc_realloc_reply_buffer(&pb->core,
+                                                     pb->core.http_content_len)) {
+                        outcome_detected(pb, PNR_REPLY_TOO_BIG);
+                        break;
+                    }
                 }
+                pb->state = PBS_RX_BODY;
                 goto next_state;
+            default:
+                PUBNUB_LOG_ERROR("pb=%p in PBS_RX_HEADERS: invalid HTTP "
+                                 "response, parser event %d\n",
+                                 pb,
+                                 parser->event);
+                outcome_detected(pb,
+                                 parser->line_too_long ? PNR_TX_BUFF_TOO_SMALL
+                                                       : PNR_IO_ERROR);
+                break;
             }
-            if (strncmp(pb->core.http_buf, h_chunked, sizeof h_chunked - 1) == 0) {
-                pb->http_chunked = true;
-            }
-            else if (strncmp(pb->core.http_buf, h_length, sizeof h_length - 1) == 0) {
-                size_t len = atoi(pb->core.http_buf + sizeof h_length - 1);
-                if (0 != pbcc_realloc_reply_buffer(&pb->core, len)) {
-                    outcome_detected(pb, PNR_REPLY_TOO_BIG);
-                    break;
-                }
-                pb->core.http_content_len = len;
-            }
-#if PUBNUB_ADVANCED_KEEP_ALIVE
-            else if (strncmp(pb->core.http_buf, h_close, sizeof h_close - 1) == 0) {
-                pb->keep_alive.should_close = true;
-            }
-#endif
-#if PUBNUB_RECEIVE_GZIP_RESPONSE
-            else if (strncmp(pb->core.http_buf, h_encoding, sizeof h_encoding - 1)
-                     == 0) {
-                pb->data_compressed = compressionGZIP;
-            }
-#endif
-            else {
-                pbproxy_handle_http_header(pb, pb->core.http_buf);
-            }
-            pb->state = PBS_RX_HEADERS;
-            goto next_state;
-        }
-        case PNR_TX_BUFF_TOO_SMALL:
-            /** We could copy the "line so far" to the reply buffer
-                and then process the line from the reply buffer when
-                it's finished. This would be much more complex, yet
-                most lines will not be that long and, if the reply
-                buffer is static, it, too, might not be large enough.
-            */
-            pb->state = PBS_RX_HEADERS;
-            goto next_state;
-        default:
-            outcome_detected(pb, pbrslt);
-            break;
-        }
-        break;
-    case PBS_RX_BODY:
-        if (pb->core.http_buf_len < pb->core.http_content_len) {
-            pbpal_start_read(pb, pb->core.http_content_len - pb->core.http_buf_len);
-            pb->state = PBS_RX_BODY_WAIT;
-            goto next_state;
-        }
-        else {
-            finish(pb);
-#if PUBNUB_PROXY_API
-            if (pb->retry_after_close) {
-                goto next_state;
-            }
-#endif
-        }
-        break;
-    case PBS_RX_BODY_WAIT:
-        pbrslt = pbpal_read_status(pb);
-        PUBNUB_LOG_TRACE("pb=%p PBS_RX_BODY_WAIT: pbrslt=%d\n", pb, pbrslt);
-        switch (pbrslt) {
-        case PNR_IN_PROGRESS:
             break;
-        case PNR_OK: {
-            unsigned len = pbpal_read_len(pb);
-            WATCH_UINT(len);
-            WATCH_UINT(pb->core.http_buf_len);
-            PUBNUB_ASSERT_OPT(pb->core.http_buf_len + len
-                              <= pb->core.http_content_len);
-            memcpy(pb->core.http_reply + pb->core.http_buf_len, pb->core.http_buf, len);
-            pb->core.http_buf_len += len;
-            pb->state = PBS_RX_BODY;
-            goto next_state;
         }
         default:
+            PUBNUB_LOG_ERROR("pb=%p in PBS_RX_HEADERS: failure inducing "
+                             "pbpal_read_response_status %d\n",
+                             pb,
+                             pbrslt);
             outcome_detected(pb, pbrslt);
             break;
         }
         break;
-    case PBS_RX_CHUNK_LEN:
-        pbpal_start_read_line(pb);
-        pb->state = PBS_RX_CHUNK_LEN_LINE;
-        goto next_state;
-    case PBS_RX_CHUNK_LEN_LINE:
-        pbrslt = pbpal_line_read_status(pb);
-        PUBNUB_LOG_TRACE("pb=%p PBS_RX_CHUNK_LEN_LINE: pbrslt=%d\n", pb, pbrslt);
+    case PBS_RX_BODY:
+        pbrslt = pbpal_read_response_status(pb);
+        PUBNUB_LOG_TRACE("pb=%p PBS_RX_BODY: pbrslt=%d\n", pb, pbrslt);
         switch (pbrslt) {
         case PNR_IN_PROGRESS:
             break;
         case PNR_OK: {
-            unsigned chunk_length = strtoul(pb->core.http_buf, NULL, 16);
-
-            PUBNUB_LOG_TRACE("About to read a chunk w/length: %u\n", chunk_length);
-            if (chunk_length == 0) {
+            struct pbhttp_parser const* parser = &pb->http_parser;
+            switch (parser->event) {
+            case pbhttpEvChunk:
+                PUBNUB_LOG_TRACE("About to read a chunk w/length: %u\n",
+                                 parser->chunk_length);
+                if (0
+                    != pbcc_realloc_reply_buffer(
+                           &pb->core, pb->core.http_buf_len + parser->chunk_length)) {
+                    outcome_detected(pb, PNR_REPLY_TOO_BIG);
+                    break;
+                }
+                goto next_state;
+            case pbhttpEvBody:
+                WATCH_SIZE_T(parser->data_len);
+                WATCH_UINT(pb->core.http_buf_len);
+                memcpy(pb->core.http_reply + pb->core.http_buf_len,
+                       parser->data,
+                       parser->data_len);
+                pb->core.http_buf_len += parser->data_len;
+#if PUBNUB_STREAMING_SUBSCRIBE
+                stream_subscribe_advance(pb);
+#endif
+                goto next_state;
+            case pbhttpEvDone:
+                PBTIMINGS_MARK(pb, pbtpBodyReceived);
                 finish(pb);
 #if PUBNUB_PROXY_API
                 if (pb->retry_after_close) {
                     goto next_state;
                 }
 #endif
-            }
-            else if (0
-                     != pbcc_realloc_reply_buffer(
-                            &pb->core, pb->core.http_buf_len + chunk_length)) {
-                outcome_detected(pb, PNR_REPLY_TOO_BIG);
-            }
-            else {
-                pb->core.http_content_len = chunk_length + CHUNK_TRAIL_LENGTH;
-                pb->state                 = PBS_RX_BODY_CHUNK;
-                goto next_state;
+                break;
+            default:
+                PUBNUB_LOG_ERROR("pb=%p in PBS_RX_BODY: invalid HTTP "
+                                 "response, parser event %d\n",
+                                 pb,
+                                 parser->event);
+                outcome_detected(pb, PNR_IO_ERROR);
+                break;
             }
             break;
         }
@@ -883,46 +994,6 @@ next_state:
             break;
         }
         break;
-    case PBS_RX_BODY_CHUNK:
-        if (pb->core.http_content_len > 0) {
-            pbpal_start_read(pb, pb->core.http_content_len);
-            pb->state = PBS_RX_BODY_CHUNK_WAIT;
-        }
-        else {
-            pb->state = PBS_RX_CHUNK_LEN;
-        }
-        goto next_state;
-    case PBS_RX_BODY_CHUNK_WAIT:
-        pbrslt = pbpal_read_status(pb);
-        PUBNUB_LOG_TRACE("pb=%p PBS_RX_BODY_CHUNK_WAIT: pbrslt=%d\n", pb, pbrslt);
-        switch (pbrslt) {
-        case PNR_IN_PROGRESS:
-            break;
-        case PNR_OK: {
-            unsigned len = pbpal_read_len(pb);
-
-            PUBNUB_ASSERT_OPT(pb->core.http_content_len >= len);
-            PUBNUB_ASSERT_OPT(len > 0);
-
-            if (pb->core.http_content_len > CHUNK_TRAIL_LENGTH) {
-                unsigned to_copy = pb->core.http_content_len - CHUNK_TRAIL_LENGTH;
-                if (len < to_copy) {
-                    to_copy = len;
-                }
-                memcpy(pb->core.http_reply + pb->core.http_buf_len,
-                       pb->core.http_buf,
-                       to_copy);
-                pb->core.http_buf_len += to_copy;
-            }
-            pb->core.http_content_len -= len;
-            pb->state = PBS_RX_BODY_CHUNK;
-            goto next_state;
-        }
-        default:
-            outcome_detected(pb, pbrslt);
-            break;
-        }
-        break;
     case PBS_WAIT_CLOSE:
         if (pbpal_closed(pb)) {
 #if PUBNUB_PROXY_API
@@ -955,9 +1026,22 @@ next_state:
         }
         break;
     case PBS_KEEP_ALIVE_IDLE:
+#if PUBNUB_ADVANCED_KEEP_ALIVE
+        if (PNR_STARTED != pb->core.last_result) {
+            /* Not started by the user, but queued to re-warm the
+               spent connection - do it as pubnub_preconnect() would */
+            if (!pb->keep_alive.rewarming) {
+                break;
+            }
+            pb->trans            = PBTT_PRECONNECT;
+            pb->core.last_result = PNR_STARTED;
+        }
+#endif
 #if PUBNUB_PROXY_API
         pb->proxy_saved_path_len = 0;
 #endif
+        PBTIMINGS_START(pb);
+        PBMETRICS_ADD(pbmcTransactions, 1);
         pb->state = PBS_KEEP_ALIVE_READY;
         switch (pbntf_enqueue_for_processing(pb)) {
         case -1:
@@ -977,11 +1061,37 @@ next_state:
             pbntf_trans_outcome(pb, PBS_IDLE);
             break;
         }
+        if (origin_changed(pb)) {
+            PUBNUB_LOG_TRACE("pb=%p origin changed, closing the kept alive "
+                             "connection\n",
+                             pb);
+            pb->state = close_kept_alive_connection(pb);
+            goto next_state;
+        }
+#if PUBNUB_ADVANCED_KEEP_ALIVE
+        if (pb->keep_alive.rewarming) {
+            PUBNUB_LOG_TRACE("pb=%p keep-alive limits reached, closing the "
+                             "kept alive connection\n",
+                             pb);
+            pb->state = close_kept_alive_connection(pb);
+            goto next_state;
+        }
+#endif
+        if (connect_only(pb)) {
+            /* Already connected */
+            park_connection(pb);
+            break;
+        }
         i = send_init_GET_or_CONNECT(pb);
         if (i < 0) {
             pb->state = close_kept_alive_connection(pb);
         }
         else {
+            PBMETRICS_ADD(pbmcKeepAliveReuses, 1);
+#if PUBNUB_PROXY_API
+            pb->proxy_tunnel_reused = (pb->proxy_type == pbproxyHTTP_CONNECT)
+                                      && pb->proxy_tunnel_established;
+#endif
             pb->state = PBS_TX_GET;
         }
         goto next_state;
@@ -52,24 +52,10 @@ enum pubnub_state {
     PBS_TX_ORIGIN,
     /** Sending the rest of the HTTP headers */
     PBS_TX_FIN_HEAD,
-    /** Waiting for HTTP version in response */
-    PBS_RX_HTTP_VER,
-    /** Reading the HTTP response headers */
+    /** Reading the HTTP response status line and headers */
     PBS_RX_HEADERS,
-    /** Reading one HTTP response header line */
-    PBS_RX_HEADER_LINE,
-    /** Reading the HTTP response body */
+    /** Reading the HTTP response body (chunked or not) */
     PBS_RX_BODY,
-    /** Waiting for new data in HTTP response body */
-    PBS_RX_BODY_WAIT,
-    /** Reading the length of the chunk in HTTP chunked response body */
-    PBS_RX_CHUNK_LEN,
-    /** Waiting to receive whole line of the chunk length*/
-    PBS_RX_CHUNK_LEN_LINE,
-    /** Reading the chunk in HTTP chunked response body */
-    PBS_RX_BODY_CHUNK,
-    /** Waiting for new data in HTTP chunked response body */
-    PBS_RX_BODY_CHUNK_WAIT,
     /** Waiting for the TCP connection to close */
     PBS_WAIT_CLOSE,
     /** Waiting to cancel (close before the end of transaction) the
@@ -0,0 +1,287 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "cgreen/cgreen.h"
+#include "cgreen/mocks.h"
+
+#include "pubnub_internal.h"
+
+#include "pubnub_ntf_external.h"
+#include "core/pbntf_trans_outcome_common.h"
+#include "core/pubnub_assert.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+
+
+/* A less chatty cgreen :) */
+
+#define attest assert_that
+#define equals is_equal_to
+#define streqs is_equal_to_string
+#define differs is_not_equal_to
+#define strdifs is_not_equal_to_string
+#define ptreqs(val) is_equal_to_contents_of(&(val), sizeof(val))
+#define ptrdifs(val) is_not_equal_to_contents_of(&(val), sizeof(val))
+#define sets(par, val) will_set_contents_of_parameter(par, &(val), sizeof(val))
+#define sets_ex will_set_contents_of_parameter
+#define returns will_return
+
+
+enum { CONTEXTS = 2 };
+
+static pubnub_t m_ctx[CONTEXTS];
+
+/** The socket of each context, and its peer, where we write to have
+    the (fake) FSM finish the transaction */
+static int m_socket[CONTEXTS];
+static int m_peer[CONTEXTS];
+
+/** How many times the FSM of each context was run */
+static int m_fsm_runs[CONTEXTS];
+
+/** How many times the watcher was called for each context */
+static int m_watcher_calls[CONTEXTS];
+
+/** Contexts freed at last (by the queue) */
+static int m_freed[CONTEXTS];
+
+
+static int ctx_index(pubnub_t const* pb)
+{
+    int i = (int)(pb - m_ctx);
+    PUBNUB_ASSERT_OPT((i >= 0) && (i < CONTEXTS));
+    return i;
+}
+
+
+bool pb_valid_ctx_ptr(pubnub_t const* pb)
+{
+    return (pb >= m_ctx) && (pb < m_ctx + CONTEXTS);
+}
+
+
+/** Finishes the transaction on @p pb with @p result, as the FSM
+    would */
+static void finish(pubnub_t* pb, enum pubnub_res result)
+{
+    pb->state            = PBS_IDLE;
+    pb->core.last_result = result;
+    pbntf_lost_socket(pb);
+}
+
+
+/** Reads the response from the socket, non-blocking, as the FSM
+    would in the "callback" interface */
+int pbnc_fsm(pubnub_t* pb)
+{
+    int  i = ctx_index(pb);
+    char c;
+
+    ++m_fsm_runs[i];
+    if (1 == recv(m_socket[i], &c, 1, MSG_DONTWAIT)) {
+        finish(pb, PNR_OK);
+    }
+    return 0;
+}
+
+
+void pbnc_stop(pubnub_t* pb, enum pubnub_res outcome_to_report)
+{
+    finish(pb, outcome_to_report);
+}
+
+
+void pballoc_free_at_last(pubnub_t* pb)
+{
+    ++m_freed[ctx_index(pb)];
+}
+
+
+static void watcher(pubnub_t* pb, void* user_data)
+{
+    attest(user_data, equals(m_ctx));
+    ++m_watcher_calls[ctx_index(pb)];
+}
+
+
+static void respond(int i)
+{
+    attest(write(m_peer[i], "x", 1), equals(1));
+}
+
+
+/** Starts a transaction on context @p i, that times out in
+    @p timeout_ms */
+static void start(int i, int timeout_ms)
+{
+    m_ctx[i].state                  = PBS_RX_HEADERS;
+    m_ctx[i].core.last_result       = PNR_STARTED;
+    m_ctx[i].transaction_timeout_ms = timeout_ms;
+    attest(pbntf_got_socket(m_ctx + i), equals(+1));
+}
+
+
+Describe(pubnub_ntf_external);
+
+
+BeforeEach(pubnub_ntf_external) {
+    static bool initialized;
+    int         i;
+
+    if (!initialized) {
+        attest(pbntf_init(), equals(0));
+        initialized = true;
+    }
+    pubnub_register_watcher(watcher, m_ctx);
+    for (i = 0; i < CONTEXTS; ++i) {
+        int sv[2];
+        attest(socketpair(AF_UNIX, SOCK_STREAM, 0, sv), equals(0));
+        m_socket[i] = sv[0];
+        m_peer[i]   = sv[1];
+        memset(m_ctx + i, 0, sizeof m_ctx[i]);
+        m_fsm_runs[i]      = 0;
+        m_watcher_calls[i] = 0;
+        m_freed[i]         = 0;
+    }
+}
+
+
+AfterEach(pubnub_ntf_external) {
+    int i;
+    for (i = 0; i < CONTEXTS; ++i) {
+        pbntf_lost_socket(m_ctx + i);
+        close(m_socket[i]);
+        close(m_peer[i]);
+    }
+    pubnub_register_watcher(NULL, NULL);
+}
+
+
+Ensure(pubnub_ntf_external, watcher_is_told_of_socket_changes) {
+    attest(pubnub_watched_events(m_ctx + 0), equals(pbwatchNONE));
+
+    start(0, 1000);
+    attest(m_watcher_calls[0], equals(1));
+    attest(pubnub_watched_events(m_ctx + 0), equals(pbwatchOUT));
+
+    attest(pbntf_watch_in_events(m_ctx + 0), equals(0));
+    attest(m_watcher_calls[0], equals(2));
+    attest(pubnub_watched_events(m_ctx + 0), equals(pbwatchIN));
+
+    /* Not watched, so nothing to tell */
+    attest(pbntf_watch_in_events(m_ctx + 1), equals(-1));
+    attest(m_watcher_calls[1], equals(0));
+}
+
+
+Ensure(pubnub_ntf_external, ready_socket_runs_the_fsm) {
+    start(0, 1000);
+    start(1, 1000);
+    pbntf_watch_in_events(m_ctx + 0);
+
+    pubnub_process_ready(m_ctx + 0, pbwatchIN);
+    attest(m_fsm_runs[0], equals(1));
+    attest(m_ctx[0].state, equals(PBS_RX_HEADERS));
+
+    respond(0);
+    pubnub_process_ready(m_ctx + 0, pbwatchIN);
+    attest(m_fsm_runs[0], equals(2));
+    attest(m_ctx[0].state, equals(PBS_IDLE));
+    attest(m_ctx[0].core.last_result, equals(PNR_OK));
+    attest(pubnub_watched_events(m_ctx + 0), equals(pbwatchNONE));
+
+    /* The other context is not affected */
+    attest(m_fsm_runs[1], equals(0));
+    attest(pubnub_watched_events(m_ctx + 1), equals(pbwatchOUT));
+}
+
+
+Ensure(pubnub_ntf_external, stale_event_is_ignored) {
+    start(0, 1000);
+    respond(0);
+    pubnub_process_ready(m_ctx + 0, pbwatchIN);
+    attest(m_fsm_runs[0], equals(1));
+    attest(m_ctx[0].state, equals(PBS_IDLE));
+
+    /* The loop may still have an event for the (closed) socket.
+       Running the FSM of an idle context would be harmful */
+    pubnub_process_ready(m_ctx + 0, pbwatchIN);
+    attest(m_fsm_runs[0], equals(1));
+
+    /* Nor is the FSM run for a context being freed */
+    start(1, 1000);
+    m_ctx[1].state = PBS_NULL;
+    pubnub_process_ready(m_ctx + 1, pbwatchIN);
+    attest(m_fsm_runs[1], equals(0));
+}
+
+
+Ensure(pubnub_ntf_external, next_timeout_is_of_the_earliest_deadline) {
+    int timeout;
+
+    attest(pubnub_next_timeout_ms(), equals(-1));
+
+    start(0, 1000);
+    start(1, 200);
+    timeout = pubnub_next_timeout_ms();
+    attest(timeout, is_greater_than(100));
+    attest(timeout, is_less_than(201));
+
+    /* Deadlines are absolute, waiting counts against them */
+    usleep(100000);
+    attest(pubnub_next_timeout_ms(), is_less_than(101));
+
+    respond(1);
+    pubnub_process_ready(m_ctx + 1, pbwatchIN);
+    attest(pubnub_next_timeout_ms(), is_greater_than(200));
+}
+
+
+Ensure(pubnub_ntf_external, pending_timeout_stops_the_transaction) {
+    start(0, 30);
+    start(1, 1000);
+
+    /* Not expired yet */
+    pubnub_process_pending();
+    attest(m_ctx[0].state, equals(PBS_RX_HEADERS));
+
+    usleep(50000);
+    attest(pubnub_next_timeout_ms(), equals(0));
+    pubnub_process_pending();
+    attest(m_ctx[0].state, equals(PBS_IDLE));
+    attest(m_ctx[0].core.last_result, equals(PNR_TIMEOUT));
+    attest(pubnub_watched_events(m_ctx + 0), equals(pbwatchNONE));
+    attest(m_ctx[1].state, equals(PBS_RX_HEADERS));
+    attest(pubnub_next_timeout_ms(), is_greater_than(900));
+
+    /* A response that comes after the timeout is a stale event */
+    respond(0);
+    pubnub_process_ready(m_ctx + 0, pbwatchIN);
+    attest(m_fsm_runs[0], equals(0));
+}
+
+
+Ensure(pubnub_ntf_external, queued_context_is_processed_when_pending) {
+    start(0, 1000);
+    attest(pbntf_requeue_for_processing(m_ctx + 0), equals(+1));
+    attest(m_watcher_calls[0], equals(2));
+    attest(pubnub_next_timeout_ms(), equals(0));
+
+    respond(0);
+    pubnub_process_pending();
+    attest(m_fsm_runs[0], equals(1));
+    attest(m_ctx[0].state, equals(PBS_IDLE));
+    attest(pubnub_next_timeout_ms(), equals(-1));
+
+    /* A context queued to be freed is freed */
+    m_ctx[1].state = PBS_NULL;
+    attest(pbntf_requeue_for_processing(m_ctx + 1), equals(+1));
+    pubnub_process_pending();
+    attest(m_freed[1], equals(1));
+    attest(m_fsm_runs[1], equals(0));
+    attest(pubnub_next_timeout_ms(), equals(-1));
+}
@@ -5,6 +5,8 @@
 
 #include "pubnub_api_types.h"
 
+#include <stddef.h>
+
 
 /** @file pubnub_ntf_sync.h 
     This is the "sync" notification interface.
@@ -36,4 +38,47 @@
 enum pubnub_res pubnub_await(pubnub_t *p);
 
 
+/** Waits for the current transaction of any of the @p n contexts in
+    the array @p pbs to finish, for at most @p timeout_ms milliseconds
+    (if negative, there is no limit).
+
+    Unlike pubnub_await(), which would need a thread per context to
+    run transactions at the same time, this drives all the contexts
+    from the calling thread, waiting for all their sockets at once
+    (with `poll()`).
+
+    A context that has no transaction in progress is "finished", so,
+    once you're done with a context, but want to keep awaiting the
+    rest, set its element in @p pbs to NULL - these are ignored.
+
+    While they are awaited, the contexts use non-blocking I/O. Before
+    this returns, the contexts that used blocking I/O are switched
+    back to it, so you can pubnub_await() them afterwards, or await
+    them again with this function.
+
+    This is available on platforms with BSD-like sockets (POSIX,
+    Windows).
+
+    @param pbs The contexts to await
+    @param n The number of contexts (elements) in @p pbs
+    @param timeout_ms The maximum time to wait, in milliseconds
+    @return The index (in @p pbs) of a context whose transaction is
+    finished (get the outcome with pubnub_last_result()), -1 if no
+    transaction finished in @p timeout_ms, or on error
+ */
+int pubnub_await_any(pubnub_t **pbs, size_t n, int timeout_ms);
+
+/** Waits for the current transactions of all the @p n contexts in
+    the array @p pbs to finish, for at most @p timeout_ms milliseconds
+    (if negative, there is no limit). Otherwise, it's the same as
+    pubnub_await_any().
+
+    @return PNR_OK: all the transactions finished (get their outcome
+    with pubnub_last_result()), PNR_TIMEOUT: some transactions did not
+    finish in @p timeout_ms (they are still in progress, you may
+    pubnub_cancel() them), or on error
+ */
+enum pubnub_res pubnub_await_all(pubnub_t **pbs, size_t n, int timeout_ms);
+
+
 #endif        /* defined INC_PUBNUB_NTF_CONTIKI */
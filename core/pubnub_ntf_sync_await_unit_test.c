@@ -0,0 +1,210 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "cgreen/cgreen.h"
+#include "cgreen/mocks.h"
+
+#include "pubnub_internal.h"
+
+#include "core/pubnub_ntf_sync.h"
+#include "core/pubnub_blocking_io.h"
+#include "core/pubnub_assert.h"
+#include "core/pbpal.h"
+#include "pubnub_get_native_socket.h"
+
+#include <sys/socket.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+
+
+/* A less chatty cgreen :) */
+
+#define attest assert_that
+#define equals is_equal_to
+#define streqs is_equal_to_string
+#define differs is_not_equal_to
+#define strdifs is_not_equal_to_string
+#define ptreqs(val) is_equal_to_contents_of(&(val), sizeof(val))
+#define ptrdifs(val) is_not_equal_to_contents_of(&(val), sizeof(val))
+#define sets(par, val) will_set_contents_of_parameter(par, &(val), sizeof(val))
+#define sets_ex will_set_contents_of_parameter
+#define returns will_return
+
+
+enum { CONTEXTS = 2 };
+
+static pubnub_t m_ctx[CONTEXTS];
+
+/** The socket of each context, and its peer, where we write to have
+    the (fake) FSM finish the transaction */
+static int m_socket[CONTEXTS];
+static int m_peer[CONTEXTS];
+
+/** Whether the socket of each context was (last) set to blocking I/O */
+static bool m_socket_blocking[CONTEXTS];
+
+/** How many times the FSM of each context was run */
+static int m_fsm_runs[CONTEXTS];
+
+
+static int ctx_index(pubnub_t const* pb)
+{
+    int i = (int)(pb - m_ctx);
+    PUBNUB_ASSERT_OPT((i >= 0) && (i < CONTEXTS));
+    return i;
+}
+
+
+bool pb_valid_ctx_ptr(pubnub_t const* pb)
+{
+    return (pb >= m_ctx) && (pb < m_ctx + CONTEXTS);
+}
+
+
+pbpal_native_socket_t pubnub_get_native_socket(pubnub_t* pb)
+{
+    return m_socket[ctx_index(pb)];
+}
+
+
+int pbpal_set_blocking_io(pubnub_t* pb)
+{
+    m_socket_blocking[ctx_index(pb)] = pb->options.use_blocking_io;
+    return 0;
+}
+
+
+bool pbnc_can_start_transaction(pubnub_t const* pb)
+{
+    return PBS_IDLE == pb->state;
+}
+
+
+/** Reads the response from the socket, as the FSM would - waiting
+    for it only if the socket is blocking. */
+int pbnc_fsm(pubnub_t* pb)
+{
+    int  i = ctx_index(pb);
+    char c;
+
+    ++m_fsm_runs[i];
+    if (1 == recv(m_socket[i], &c, 1, m_socket_blocking[i] ? 0 : MSG_DONTWAIT)) {
+        pb->state            = PBS_IDLE;
+        pb->core.last_result = PNR_OK;
+    }
+    return 0;
+}
+
+
+static void respond(int i)
+{
+    attest(write(m_peer[i], "x", 1), equals(1));
+}
+
+
+static void* respond_later(void* arg)
+{
+    int i = *(int*)arg;
+    usleep(50000);
+    respond(i);
+    return NULL;
+}
+
+
+static void assert_blocking(int i, bool blocking)
+{
+    attest(m_ctx[i].options.use_blocking_io, equals(blocking));
+    attest(m_socket_blocking[i], equals(blocking));
+}
+
+
+Describe(pubnub_ntf_sync_await);
+
+
+BeforeEach(pubnub_ntf_sync_await) {
+    int i;
+    for (i = 0; i < CONTEXTS; ++i) {
+        int sv[2];
+        attest(socketpair(AF_UNIX, SOCK_STREAM, 0, sv), equals(0));
+        m_socket[i] = sv[0];
+        m_peer[i]   = sv[1];
+        memset(m_ctx + i, 0, sizeof m_ctx[i]);
+        /* Waiting for the response, on a blocking socket */
+        m_ctx[i].state                   = PBS_RX_HEADERS;
+        m_ctx[i].core.last_result        = PNR_STARTED;
+        m_ctx[i].options.use_blocking_io = true;
+        m_socket_blocking[i]             = true;
+        m_fsm_runs[i]                    = 0;
+    }
+}
+
+
+AfterEach(pubnub_ntf_sync_await) {
+    int i;
+    for (i = 0; i < CONTEXTS; ++i) {
+        close(m_socket[i]);
+        close(m_peer[i]);
+    }
+}
+
+
+Ensure(pubnub_ntf_sync_await, await_after_await_any_does_not_spin) {
+    pubnub_t* pbs[] = { m_ctx + 0, m_ctx + 1 };
+    pthread_t thr;
+    int       ctx0 = 0;
+    int       runs;
+
+    respond(1);
+    attest(pubnub_await_any(pbs, CONTEXTS, 1000), equals(1));
+    assert_blocking(0, true);
+    assert_blocking(1, true);
+
+    runs = m_fsm_runs[0];
+    attest(pthread_create(&thr, NULL, respond_later, &ctx0), equals(0));
+    attest(pubnub_await(m_ctx + 0), equals(PNR_OK));
+    pthread_join(thr, NULL);
+    /* A blocking FSM waits for the response, rather than spinning */
+    attest(m_fsm_runs[0] - runs, equals(1));
+}
+
+
+Ensure(pubnub_ntf_sync_await, timeout_restores_blocking_io) {
+    pubnub_t* pbs[] = { m_ctx + 0, m_ctx + 1 };
+
+    attest(pubnub_await_any(pbs, CONTEXTS, 20), equals(-1));
+    assert_blocking(0, true);
+    assert_blocking(1, true);
+
+    respond(0);
+    attest(pubnub_await_all(pbs, CONTEXTS, 20), equals(PNR_TIMEOUT));
+    attest(m_ctx[0].state, equals(PBS_IDLE));
+    assert_blocking(0, true);
+    assert_blocking(1, true);
+}
+
+
+Ensure(pubnub_ntf_sync_await, await_all_restores_blocking_io) {
+    pubnub_t* pbs[] = { m_ctx + 0, m_ctx + 1 };
+
+    respond(0);
+    respond(1);
+    attest(pubnub_await_all(pbs, CONTEXTS, 1000), equals(PNR_OK));
+    attest(m_ctx[0].options.use_blocking_io, equals(true));
+    attest(m_ctx[1].options.use_blocking_io, equals(true));
+}
+
+
+Ensure(pubnub_ntf_sync_await, non_blocking_context_stays_non_blocking) {
+    pubnub_t* pbs[] = { m_ctx + 0, m_ctx + 1 };
+
+    pubnub_set_non_blocking_io(m_ctx + 0);
+    pbpal_set_blocking_io(m_ctx + 0);
+
+    respond(1);
+    attest(pubnub_await_any(pbs, CONTEXTS, 1000), equals(1));
+    assert_blocking(0, false);
+    assert_blocking(1, true);
+}
@@ -0,0 +1,411 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "pubnub_internal.h"
+
+#include "pubnub_origin_selector.h"
+
+#include "pubnub_pubsubapi.h"
+#include "pubnub_mutex.h"
+#include "pubnub_assert.h"
+#include "pubnub_log.h"
+
+#if !defined PUBNUB_CALLBACK_API
+#include "pubnub_coreapi.h"
+#include "pubnub_ntf_sync.h"
+#include "pubnub_helper.h"
+#endif
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include "posix/monotonic_clock_get_time.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+
+/** A candidate origin */
+struct os_candidate {
+    /** The origin */
+    char* origin;
+    /** Number of samples (probes/reports) taken */
+    unsigned long samples;
+    /** Moving average of the RTT, in milliseconds */
+    unsigned long rtt_ms;
+    /** Moving average of the failure rate, in percent */
+    unsigned fail_percent;
+};
+
+
+struct pubnub_origin_selector {
+    struct pubnub_origin_selector_options opt;
+    /** The candidates */
+    struct os_candidate* cand;
+    /** Number of @c cand */
+    size_t n;
+    /** Index of the selected candidate */
+    size_t best;
+    /** When the last probing round started, 0 if none did */
+    unsigned long last_probe_ms;
+    pubnub_mutex_t monitor;
+};
+
+
+static unsigned long now_ms(void)
+{
+#if defined(_WIN32)
+    return GetTickCount();
+#else
+    struct timespec ts;
+    monotonic_clock_get_time(&ts);
+    return (unsigned long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+#endif
+}
+
+
+static unsigned long score(pubnub_origin_selector_t const* sel,
+                           struct os_candidate const*      cand)
+{
+    return cand->rtt_ms
+           + (unsigned long)cand->fail_percent * sel->opt.failure_penalty_ms / 100;
+}
+
+
+/** Selects the best candidate, after a sample of the @p degraded
+    (selected) one failed, or with the switch margin otherwise. */
+static void reselect(pubnub_origin_selector_t* sel, bool degraded)
+{
+    struct os_candidate const* best = NULL;
+    size_t                     i;
+
+    for (i = 0; i < sel->n; ++i) {
+        struct os_candidate const* c = &sel->cand[i];
+        if ((c->samples > 0) && (!degraded || (i != sel->best))
+            && ((NULL == best) || (score(sel, c) < score(sel, best)))) {
+            best = c;
+        }
+    }
+    if ((NULL == best) || (best == &sel->cand[sel->best])) {
+        return;
+    }
+    if (degraded || (0 == sel->cand[sel->best].samples)
+        || (score(sel, best) * 100
+            < score(sel, &sel->cand[sel->best]) * (100 - sel->opt.switch_margin_percent))) {
+        PUBNUB_LOG_INFO("Origin selector: switching from '%s' (score %lu) to "
+                        "'%s' (score %lu)%s\n",
+                        sel->cand[sel->best].origin,
+                        score(sel, &sel->cand[sel->best]),
+                        best->origin,
+                        score(sel, best),
+                        degraded ? ", as it failed" : "");
+        sel->best = best - sel->cand;
+    }
+}
+
+
+static void update(pubnub_origin_selector_t* sel, size_t i, bool ok, unsigned rtt_ms)
+{
+    struct os_candidate* c = &sel->cand[i];
+    unsigned             w = sel->opt.ewma_weight_percent;
+
+    if (ok) {
+        if (0 == c->samples) {
+            c->rtt_ms = rtt_ms;
+        }
+        else if (rtt_ms > c->rtt_ms) {
+            c->rtt_ms += (rtt_ms - c->rtt_ms) * w / 100;
+        }
+        else {
+            c->rtt_ms -= (c->rtt_ms - rtt_ms) * w / 100;
+        }
+        c->fail_percent -= c->fail_percent * w / 100;
+    }
+    else {
+        if (0 == c->samples) {
+            c->rtt_ms = sel->opt.probe_timeout_ms;
+        }
+        c->fail_percent += (100 - c->fail_percent) * w / 100;
+    }
+    ++c->samples;
+    PUBNUB_LOG_TRACE("Origin selector: '%s' %s in %u ms, RTT=%lu ms, "
+                     "failure rate=%u%%\n",
+                     c->origin,
+                     ok ? "succeeded" : "failed",
+                     rtt_ms,
+                     c->rtt_ms,
+                     c->fail_percent);
+
+    reselect(sel, !ok && (i == sel->best));
+}
+
+
+struct pubnub_origin_selector_options pubnub_origin_selector_defopts(void)
+{
+    struct pubnub_origin_selector_options rslt;
+
+    rslt.probe_interval_ms     = 30000;
+    rslt.probe_timeout_ms      = 2000;
+    rslt.ewma_weight_percent   = 20;
+    rslt.failure_penalty_ms    = 1000;
+    rslt.switch_margin_percent = 20;
+
+    return rslt;
+}
+
+
+pubnub_origin_selector_t* pubnub_origin_selector_create(char const* const* origins,
+                                                        size_t             n,
+                                                        struct pubnub_origin_selector_options opt)
+{
+    pubnub_origin_selector_t* sel;
+    size_t                    i;
+
+    PUBNUB_ASSERT_OPT(NULL != origins);
+
+    if (0 == n) {
+        return NULL;
+    }
+    sel = (pubnub_origin_selector_t*)calloc(1, sizeof *sel);
+    if (NULL == sel) {
+        return NULL;
+    }
+    sel->cand = (struct os_candidate*)calloc(n, sizeof *sel->cand);
+    if (NULL == sel->cand) {
+        free(sel);
+        return NULL;
+    }
+    for (i = 0; i < n; ++i) {
+        PUBNUB_ASSERT_OPT(NULL != origins[i]);
+        sel->cand[i].origin = (char*)malloc(strlen(origins[i]) + 1);
+        if (NULL == sel->cand[i].origin) {
+            sel->n = i;
+            pubnub_origin_selector_destroy(sel);
+            return NULL;
+        }
+        strcpy(sel->cand[i].origin, origins[i]);
+    }
+    if ((0 == opt.ewma_weight_percent) || (opt.ewma_weight_percent > 100)) {
+        opt.ewma_weight_percent = 100;
+    }
+    if (opt.switch_margin_percent > 100) {
+        opt.switch_margin_percent = 100;
+    }
+    sel->opt = opt;
+    sel->n   = n;
+    pubnub_mutex_init(sel->monitor);
+
+    return sel;
+}
+
+
+void pubnub_origin_selector_destroy(pubnub_origin_selector_t* sel)
+{
+    size_t i;
+
+    PUBNUB_ASSERT_OPT(NULL != sel);
+
+    for (i = 0; i < sel->n; ++i) {
+        free(sel->cand[i].origin);
+    }
+    free(sel->cand);
+    pubnub_mutex_destroy(sel->monitor);
+    free(sel);
+}
+
+
+char const* pubnub_origin_selector_best(pubnub_origin_selector_t* sel)
+{
+    char const* rslt;
+
+    PUBNUB_ASSERT_OPT(NULL != sel);
+
+    pubnub_mutex_lock(sel->monitor);
+    rslt = sel->cand[sel->best].origin;
+    pubnub_mutex_unlock(sel->monitor);
+
+    return rslt;
+}
+
+
+int pubnub_origin_selector_apply(pubnub_origin_selector_t* sel, pubnub_t* pb)
+{
+    return pubnub_origin_set(pb, pubnub_origin_selector_best(sel));
+}
+
+
+void pubnub_origin_selector_report(pubnub_origin_selector_t* sel,
+                                   char const*               origin,
+                                   bool                      ok,
+                                   unsigned                  rtt_ms)
+{
+    size_t i;
+
+    PUBNUB_ASSERT_OPT(NULL != sel);
+    PUBNUB_ASSERT_OPT(NULL != origin);
+
+    pubnub_mutex_lock(sel->monitor);
+    for (i = 0; i < sel->n; ++i) {
+        if (0 == strcmp(sel->cand[i].origin, origin)) {
+            update(sel, i, ok, rtt_ms);
+            break;
+        }
+    }
+    pubnub_mutex_unlock(sel->monitor);
+}
+
+
+int pubnub_origin_selector_next_probe_ms(pubnub_origin_selector_t* sel)
+{
+    unsigned long elapsed;
+    int           rslt = 0;
+
+    PUBNUB_ASSERT_OPT(NULL != sel);
+
+    pubnub_mutex_lock(sel->monitor);
+    if (sel->last_probe_ms != 0) {
+        elapsed = now_ms() - sel->last_probe_ms;
+        if (elapsed < sel->opt.probe_interval_ms) {
+            rslt = (int)(sel->opt.probe_interval_ms - elapsed);
+        }
+    }
+    pubnub_mutex_unlock(sel->monitor);
+
+    return rslt;
+}
+
+
+#if !defined PUBNUB_CALLBACK_API
+/** A probe in flight */
+struct os_probe {
+    /** Index of the candidate probed */
+    size_t cand;
+    /** When the probe started */
+    unsigned long start_ms;
+};
+
+
+static void probe_done(pubnub_origin_selector_t* sel,
+                       struct os_probe const*    probe,
+                       bool                      ok,
+                       unsigned long             now)
+{
+    pubnub_mutex_lock(sel->monitor);
+    update(sel, probe->cand, ok, (unsigned)(now - probe->start_ms));
+    pubnub_mutex_unlock(sel->monitor);
+}
+
+
+enum pubnub_res pubnub_origin_selector_probe(pubnub_origin_selector_t* sel,
+                                             pubnub_t**                pbs,
+                                             size_t                    n,
+                                             bool                      force)
+{
+    struct os_probe* probe;
+    pubnub_t**       busy;
+    enum pubnub_res  rslt = PNR_OK;
+    size_t           next = 0;
+    size_t           i;
+
+    PUBNUB_ASSERT_OPT(NULL != sel);
+    PUBNUB_ASSERT_OPT(NULL != pbs);
+    PUBNUB_ASSERT_OPT(n > 0);
+
+    if (!force && (pubnub_origin_selector_next_probe_ms(sel) > 0)) {
+        return PNR_OK;
+    }
+    pubnub_mutex_lock(sel->monitor);
+    sel->last_probe_ms = now_ms();
+    if (0 == sel->last_probe_ms) {
+        sel->last_probe_ms = 1;
+    }
+    pubnub_mutex_unlock(sel->monitor);
+    if (n > sel->n) {
+        n = sel->n;
+    }
+    probe = (struct os_probe*)malloc(n * (sizeof *probe + sizeof *busy));
+    if (NULL == probe) {
+        return PNR_REPLY_TOO_BIG;
+    }
+    busy = (pubnub_t**)(probe + n);
+    for (i = 0; i < n; ++i) {
+        busy[i] = NULL;
+    }
+
+    for (;;) {
+        unsigned long now = now_ms();
+        unsigned long wait_ms = sel->opt.probe_timeout_ms;
+        bool          any     = false;
+        int           idx;
+
+        for (i = 0; i < n; ++i) {
+            if ((NULL == busy[i]) && (next < sel->n)) {
+                probe[i].cand     = next++;
+                probe[i].start_ms = now;
+                pubnub_origin_set(pbs[i], sel->cand[probe[i].cand].origin);
+                rslt = pubnub_time(pbs[i]);
+                if ((rslt != PNR_STARTED) && (rslt != PNR_OK)) {
+                    PUBNUB_LOG_ERROR("Failed to start probing '%s': %d('%s')\n",
+                                     sel->cand[probe[i].cand].origin,
+                                     rslt,
+                                     pubnub_res_2_string(rslt));
+                    goto cancel;
+                }
+                /* If it's done already, pubnub_await_any() returns it */
+                rslt    = PNR_OK;
+                busy[i] = pbs[i];
+            }
+            if (busy[i] != NULL) {
+                unsigned long elapsed = now - probe[i].start_ms;
+                unsigned long left    = (elapsed < sel->opt.probe_timeout_ms)
+                                         ? sel->opt.probe_timeout_ms - elapsed
+                                         : 0;
+                if (left < wait_ms) {
+                    wait_ms = left;
+                }
+                any = true;
+            }
+        }
+        if (!any) {
+            break;
+        }
+
+        idx = pubnub_await_any(busy, n, (int)wait_ms);
+        now = now_ms();
+        if (idx >= 0) {
+            bool ok = (PNR_OK == pubnub_last_result(pbs[idx]));
+            while (pubnub_get(pbs[idx]) != NULL) {
+                continue;
+            }
+            busy[idx] = NULL;
+            probe_done(sel, &probe[idx], ok, now);
+            continue;
+        }
+        /* Probes that took too long have failed */
+        for (i = 0; i < n; ++i) {
+            if ((busy[i] != NULL)
+                && (now - probe[i].start_ms >= sel->opt.probe_timeout_ms)) {
+                pubnub_cancel(pbs[i]);
+                if (pubnub_await(pbs[i]) == PNR_OK) {
+                    /* It did finish in the meantime */
+                    while (pubnub_get(pbs[i]) != NULL) {
+                        continue;
+                    }
+                }
+                busy[i] = NULL;
+                probe_done(sel, &probe[i], false, now);
+            }
+        }
+    }
+
+cancel:
+    for (i = 0; i < n; ++i) {
+        if (busy[i] != NULL) {
+            pubnub_cancel(pbs[i]);
+        }
+    }
+    pubnub_await_all(busy, n, sel->opt.probe_timeout_ms);
+    free(probe);
+
+    return rslt;
+}
+#endif /* !defined PUBNUB_CALLBACK_API */
@@ -0,0 +1,156 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PUBNUB_ORIGIN_SELECTOR
+#define INC_PUBNUB_ORIGIN_SELECTOR
+
+
+#include "pubnub_api_types.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+
+/** @file pubnub_origin_selector.h
+    This is the "Origin selector" API. An origin selector keeps a set
+    of candidate origins (host names, or IP addresses), measures how
+    fast each of them is from this host, and selects the best one,
+    for contexts to use (with pubnub_origin_set()).
+
+    The candidates are probed (with the "sync" interface) by cheap
+    `/time/0` requests (as in pubnub_time()). For each candidate, an
+    exponentially weighted moving average (EWMA) of the round-trip
+    time of probes and of their failure rate is kept. The score of a
+    candidate is its average RTT, plus the failure penalty weighted by
+    its failure rate - the lower, the better.
+
+    To avoid flapping, the selected origin is switched to a better one
+    only if its score is better by the switch margin. But, if a probe
+    of the selected origin fails (or times out, and the probe timeout
+    is much shorter than the transaction timeout), the selection is
+    switched to the best of the others right away.
+
+    You may also report the outcome of your own transactions, with
+    pubnub_origin_selector_report().
+
+    The selector is thread-safe (if the C-core is built with
+    PUBNUB_THREADSAFE).
+*/
+
+
+/** Options for an origin selector */
+struct pubnub_origin_selector_options {
+    /** Time between probing rounds, in milliseconds. Default is
+        30000 (30 seconds).
+     */
+    unsigned probe_interval_ms;
+    /** The maximum time to wait for a probe, in milliseconds. If the
+        probe doesn't finish in it, it fails. Default is 2000.
+     */
+    unsigned probe_timeout_ms;
+    /** The weight of the latest sample in the moving averages, in
+        percent (1 - 100). Default is 20.
+     */
+    unsigned ewma_weight_percent;
+    /** How much the failure rate adds to the score: a candidate that
+        always fails has this many milliseconds added to its RTT.
+        Default is 1000.
+     */
+    unsigned failure_penalty_ms;
+    /** The score of a candidate has to be this much (in percent)
+        lower than the score of the selected one, to be selected
+        instead. Default is 20.
+     */
+    unsigned switch_margin_percent;
+};
+
+
+/** An origin selector. It's an opaque type, use functions to work
+    with it.
+ */
+typedef struct pubnub_origin_selector pubnub_origin_selector_t;
+
+
+/** This returns the default options for an origin selector. It's
+    best to always call it to initialize the
+    #pubnub_origin_selector_options.
+ */
+struct pubnub_origin_selector_options pubnub_origin_selector_defopts(void);
+
+/** Creates an origin selector for the @p n candidate @p origins, with
+    the options @p opt. The origins are copied. Until probed, the
+    first one is selected.
+    @return The selector, or NULL on failure to allocate (or if @p n
+    is 0)
+ */
+pubnub_origin_selector_t* pubnub_origin_selector_create(char const* const* origins,
+                                                        size_t             n,
+                                                        struct pubnub_origin_selector_options opt);
+
+/** Destroys the origin selector @p sel. Contexts must not use the
+    origins from it after this (set them to some other origin before
+    destroying).
+ */
+void pubnub_origin_selector_destroy(pubnub_origin_selector_t* sel);
+
+/** Returns the origin selected by the origin selector @p sel. The
+    string is valid as long as @p sel is.
+ */
+char const* pubnub_origin_selector_best(pubnub_origin_selector_t* sel);
+
+/** Sets the origin of the context @p pb to the one selected by the
+    origin selector @p sel. Call it before starting a transaction,
+    for it to go to the best origin. If the selected origin is not
+    the one @p pb was (kept alive) connected to, the transaction will
+    make a new connection.
+    @return 0: success, -1: fail (as pubnub_origin_set())
+ */
+int pubnub_origin_selector_apply(pubnub_origin_selector_t* sel, pubnub_t* pb);
+
+/** Reports the outcome of a transaction (or a probe) to the
+    @p origin, to the origin selector @p sel.
+    @param sel The origin selector
+    @param origin The origin the transaction was sent to. If it's not
+    a candidate of @p sel, the report is ignored
+    @param ok Whether the transaction succeeded
+    @param rtt_ms The time the (successful) transaction took
+ */
+void pubnub_origin_selector_report(pubnub_origin_selector_t* sel,
+                                   char const*               origin,
+                                   bool                      ok,
+                                   unsigned                  rtt_ms);
+
+/** Returns the time, in milliseconds, until the next probing round
+    of the origin selector @p sel is due. 0 if it already is.
+ */
+int pubnub_origin_selector_next_probe_ms(pubnub_origin_selector_t* sel);
+
+
+#if !defined PUBNUB_CALLBACK_API
+/** Probes all the candidates of the origin selector @p sel, if a
+    probing round is due (or if @p force), with the contexts @p pbs.
+    Probes are done concurrently (awaited by pubnub_await_any()), at
+    most @p n at the time.
+
+    With a context per candidate, the connections are kept alive
+    between the probing rounds, so the probes measure the RTT of a
+    request. With fewer contexts, the probes include (some)
+    connecting to the candidates, too.
+
+    The contexts have to be initialized (keys, etc.) and must not be
+    in a transaction. Their origins are changed by this, don't use
+    them for anything else.
+
+    @param sel The origin selector
+    @param pbs The contexts to use. Can't be NULL.
+    @param n Number of contexts in @p pbs. Has to be at least 1.
+    @param force Whether to probe even if a probing round is not due
+    @retval PNR_OK The probing round was done, or was not due
+    @retval other Failed to start a probe
+ */
+enum pubnub_res pubnub_origin_selector_probe(pubnub_origin_selector_t* sel,
+                                             pubnub_t**                pbs,
+                                             size_t                    n,
+                                             bool                      force);
+#endif /* !defined PUBNUB_CALLBACK_API */
+
+
+#endif /* !defined INC_PUBNUB_ORIGIN_SELECTOR */
@@ -214,4 +214,19 @@ int pubnub_proxy_get_config(pubnub_t const*         pb,
                             unsigned                n);
 
 
+/** Clears the process-wide cache of proxy authentication state.
+
+    When a proxy accepts Basic or Digest credentials of a context,
+    the scheme (and, for Digest, the challenge) is remembered for the
+    proxy and username, and other contexts (and new connections)
+    send credentials for it on their first request, without waiting
+    for a 407 response. Digest nonce counts are shared, too. Cached
+    state that the proxy rejects is forgotten.
+
+    You don't need to call this, unless you want to start over, for
+    example, after changing proxy passwords.
+*/
+void pubnub_proxy_auth_cache_clear(void);
+
+
 #endif /* defined INC_PUBNUB_PROXY */
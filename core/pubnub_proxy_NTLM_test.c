@@ -212,31 +212,16 @@ int pbpal_send_status(pubnub_t *pb)
     return mock("pbpal_send_status", pb, "");
 }
 
-int pbpal_start_read_line(pubnub_t *pb)
+int pbpal_start_read_response(pubnub_t *pb)
 {
-    unsigned distance;
-
     PUBNUB_ASSERT_INT_OPT(pb->sock_state, ==, STATE_NONE);
 
-    if (pb->unreadlen > 0) {
-        PUBNUB_ASSERT_OPT((char*)(pb->ptr + pb->unreadlen) <= (char*)(pb->core.http_buf + PUBNUB_BUF_MAXLEN));
-        memmove(pb->core.http_buf, pb->ptr, pb->unreadlen);
-    }
-    distance = pb->ptr - (uint8_t*)pb->core.http_buf;
-    PUBNUB_ASSERT_UINT((distance + pb->left + pb->unreadlen), ==, (sizeof pb->core.http_buf / sizeof pb->core.http_buf[0]));
-    pb->ptr -= distance;
-    pb->left += distance;
-
-    pb->sock_state = STATE_READ_LINE;
+    pbhttp_parser_init(&pb->http_parser);
+    pb->sock_state = STATE_READ_RESPONSE;
 
     return +1;
 }
 
-int pbpal_read_len(pubnub_t *pb)
-{
-    return (char*)pb->ptr - pb->core.http_buf;
-}
-
 
 static int my_recv(void *p, size_t n)
 {
@@ -287,14 +272,35 @@ static int my_recv(void *p, size_t n)
     return to_read;
 }
 
-enum pubnub_res pbpal_line_read_status(pubnub_t *pb)
+static bool parse_unread(pubnub_t *pb)
 {
-    PUBNUB_ASSERT_OPT(STATE_READ_LINE == pb->sock_state);
+    size_t parsed =
+        pbhttp_parse(&pb->http_parser, (char const*)pb->ptr, pb->unreadlen);
+
+    pb->ptr += parsed;
+    pb->unreadlen -= parsed;
+    switch (pb->http_parser.event) {
+    case pbhttpEvNone:
+        return false;
+    case pbhttpEvDone:
+    case pbhttpEvError:
+        pb->sock_state = STATE_NONE;
+        break;
+    default:
+        break;
+    }
+    return true;
+}
 
-    if (pb->unreadlen == 0) {
+enum pubnub_res pbpal_read_response_status(pubnub_t *pb)
+{
+    PUBNUB_ASSERT_OPT(STATE_READ_RESPONSE == pb->sock_state);
+
+    while (!parse_unread(pb)) {
         int recvres;
-        PUBNUB_ASSERT_OPT((char*)(pb->ptr + pb->left) == (char*)(pb->core.http_buf + PUBNUB_BUF_MAXLEN));
-        recvres = my_recv((char*)pb->ptr, pb->left);
+        pb->ptr  = (uint8_t*)pb->core.http_buf;
+        pb->left = sizeof pb->core.http_buf / sizeof pb->core.http_buf[0];
+        recvres  = my_recv((char*)pb->ptr, pb->left);
         if (recvres < 0) {
             return PNR_IN_PROGRESS;
         }
@@ -303,93 +309,13 @@ enum pubnub_res pbpal_line_read_status(pubnub_t *pb)
             return PNR_TIMEOUT;
         }
         PUBNUB_ASSERT_OPT(recvres <= pb->left);
-        PUBNUB_LOG_TRACE("pb=%p have new data of length=%d: %.*s\n", pb, recvres, recvres, pb->ptr);
+        PUBNUB_LOG_TRACE(
+            "pb=%p have new data of length=%d: %.*s\n", pb, recvres, recvres, pb->ptr);
         pb->unreadlen = recvres;
         pb->left -= recvres;
     }
 
-    while (pb->unreadlen > 0) {
-        uint8_t c = *pb->ptr++;
-        --pb->unreadlen;
-
-        if (c == '\n') {
-            PUBNUB_LOG_TRACE("pb=%p, newline found, line length: %d, ", pb, pbpal_read_len(pb)); WATCH_USHORT(pb->unreadlen);
-            pb->sock_state = STATE_NONE;
-            return PNR_OK;
-        }
-    }
-
-    if (pb->left == 0) {
-        PUBNUB_LOG_ERROR("pbpal_line_read_status(pb=%p): buffer full but newline not found", pb);
-        pb->sock_state = STATE_NONE;
-        return PNR_TX_BUFF_TOO_SMALL;
-    }
-
-    return PNR_IN_PROGRESS;
-}
-
-int pbpal_start_read(pubnub_t *pb, size_t n)
-{
-    unsigned distance;
-
-    PUBNUB_ASSERT_UINT_OPT(n, >, 0);
-    PUBNUB_ASSERT_INT_OPT(pb->sock_state, ==, STATE_NONE);
-
-    WATCH_USHORT(pb->unreadlen);
-    WATCH_USHORT(pb->left);
-    if (pb->unreadlen > 0) {
-        PUBNUB_ASSERT_OPT((char*)(pb->ptr + pb->unreadlen) <= (char*)(pb->core.http_buf + PUBNUB_BUF_MAXLEN));
-        memmove(pb->core.http_buf, pb->ptr, pb->unreadlen);
-    }
-    distance = pb->ptr - (uint8_t*)pb->core.http_buf;
-    WATCH_UINT(distance);
-    PUBNUB_ASSERT_UINT(distance + pb->unreadlen + pb->left, ==, sizeof pb->core.http_buf / sizeof pb->core.http_buf[0]);
-    pb->ptr -= distance;
-    pb->left += distance;
-
-    pb->sock_state = STATE_READ;
-    pb->len = n;
-
-    return +1;
-}
-
-enum pubnub_res pbpal_read_status(pubnub_t *pb)
-{
-    int have_read;
-
-    PUBNUB_ASSERT_OPT(STATE_READ == pb->sock_state);
-
-    if (0 == pb->unreadlen) {
-        unsigned to_recv = pb->len;
-        if (to_recv > pb->left) {
-            to_recv = pb->left;
-        }
-        PUBNUB_ASSERT_OPT(to_recv > 0 );
-        have_read = my_recv((char*)pb->ptr, to_recv);
-        if (have_read < 0) {
-            return PNR_IN_PROGRESS;
-        } 
-        else if (0 == have_read) {
-            pb->sock_state = STATE_NONE;
-            return PNR_TIMEOUT;
-        }
-        PUBNUB_ASSERT_OPT(pb->left >= have_read);
-        pb->left -= have_read;
-    }
-    else {
-        have_read = (pb->unreadlen >= pb->len) ? pb->len : pb->unreadlen;
-        pb->unreadlen -= have_read;
-    }
-
-    pb->len -= have_read;
-    pb->ptr += have_read;
-
-    if ((0 == pb->len) || (0 == pb->left)) {
-        pb->sock_state = STATE_NONE;
-        return PNR_OK;
-    }
-
-    return PNR_IN_PROGRESS;
+    return PNR_OK;
 }
 
 
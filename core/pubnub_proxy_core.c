@@ -3,6 +3,7 @@
 
 #include "core/pubnub_assert.h"
 #include "core/pubnub_log.h"
+#include "core/pubnub_mutex.h"
 
 #include "lib/base64/pbbase64.h"
 #include "core/pbntlm_core.h"
@@ -11,6 +12,13 @@
 #include <string.h>
 
 
+#if !defined(PUBNUB_PROXY_AUTH_CACHE_SIZE)
+/** How many proxies (and usernames) to cache the authentication
+    state of, process-wide. 0 disables the cache. */
+#define PUBNUB_PROXY_AUTH_CACHE_SIZE 4
+#endif
+
+
 /** RFC 7235: The 407 (Proxy Authentication Required) status code is
    similar to 401 (Unauthorized), but it indicates that the client
    needs to authenticate itself in order to use a proxy.  The proxy
@@ -21,6 +29,201 @@
 #define HTTP_CODE_PROXY_AUTH_REQ 407
 
 
+#if PUBNUB_PROXY_AUTH_CACHE_SIZE > 0
+
+/** Maximum length of the proxy username that we cache the
+    authentication state for. State for longer usernames is not
+    cached.
+ */
+#define PROXY_AUTH_CACHE_MAX_USERNAME 63
+
+/** The authentication state of a proxy (for a username), shared by
+    all contexts, so that a new connection (of any context) can
+    authenticate on the first request, instead of waiting for a 407
+    (and a challenge) first.
+
+    NTLM authenticates a connection, not requests, so there is
+    nothing to cache for it.
+ */
+struct proxy_auth_cache_entry {
+    /** Proxy host name, empty if the entry is not used */
+    char hostname[PUBNUB_MAX_PROXY_HOSTNAME_LENGTH + 1];
+    /** Proxy port */
+    uint16_t port;
+    /** The username we authenticated with */
+    char username[PROXY_AUTH_CACHE_MAX_USERNAME + 1];
+    /** The scheme the proxy accepted (Basic or Digest) */
+    enum pubnub_http_authentication_scheme scheme;
+    /** The Digest challenge, with the nonce count to use next, if
+        the scheme is Digest */
+    struct pbhttp_digest_context digest;
+    /** When was the entry last used - to find the least recently
+        used one */
+    unsigned long last_used;
+};
+
+static struct proxy_auth_cache_entry m_auth_cache[PUBNUB_PROXY_AUTH_CACHE_SIZE] pubnub_guarded_by(m_auth_cache_lock);
+static unsigned long m_auth_cache_uses pubnub_guarded_by(m_auth_cache_lock);
+pubnub_mutex_static_decl_and_init(m_auth_cache_lock);
+
+
+static char const* auth_cache_username(pubnub_t const* p)
+{
+    return (NULL == p->proxy_auth_username) ? "" : p->proxy_auth_username;
+}
+
+
+/** Returns the cache entry for the proxy and username of context @p
+    p, NULL if there is none. Call with the cache locked.
+*/
+static struct proxy_auth_cache_entry* auth_cache_find(pubnub_t const* p)
+{
+    char const* username = auth_cache_username(p);
+    size_t      i;
+
+    for (i = 0; i < PUBNUB_PROXY_AUTH_CACHE_SIZE; ++i) {
+        struct proxy_auth_cache_entry* entry = &m_auth_cache[i];
+        if ((entry->port == p->proxy_port) && ('\0' != entry->hostname[0])
+            && (0 == strcmp(entry->hostname, p->proxy_hostname))
+            && (0 == strcmp(entry->username, username))) {
+            entry->last_used = ++m_auth_cache_uses;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+
+/** If there is cached authentication state for the proxy of context
+    @p p, and @p p has none, starts using it, so that credentials are
+    sent right away, without waiting for the proxy to ask for them.
+ */
+static void auth_cache_apply(pubnub_t* p)
+{
+    struct proxy_auth_cache_entry* entry;
+
+    if ((pbhtauNone != p->proxy_auth_scheme) || (pbproxyNONE == p->proxy_type)) {
+        return;
+    }
+    pubnub_mutex_init_static(m_auth_cache_lock);
+    pubnub_mutex_lock(m_auth_cache_lock);
+    entry = auth_cache_find(p);
+    if (entry != NULL) {
+        PUBNUB_LOG_TRACE("Proxy: using cached %s authentication for %s:%u\n",
+                         (pbhtauDigest == entry->scheme) ? "Digest" : "Basic",
+                         entry->hostname,
+                         entry->port);
+        p->proxy_auth_scheme = entry->scheme;
+        if (pbhtauDigest == entry->scheme) {
+            p->digest_context = entry->digest;
+        }
+        p->proxy_authorization_sent = false;
+    }
+    pubnub_mutex_unlock(m_auth_cache_lock);
+}
+
+
+/** If the Digest challenge of context @p p is the cached one, takes
+    the next nonce count from the cache, as nonce counts have to be
+    unique for a nonce, not just for one context.
+ */
+static void auth_cache_take_nonce_count(pubnub_t* p)
+{
+    struct proxy_auth_cache_entry* entry;
+
+    pubnub_mutex_init_static(m_auth_cache_lock);
+    pubnub_mutex_lock(m_auth_cache_lock);
+    entry = auth_cache_find(p);
+    if ((entry != NULL) && (pbhtauDigest == entry->scheme)
+        && (0 == strcmp(entry->digest.nonce, p->digest_context.nonce))) {
+        p->digest_context.nc = entry->digest.nc++;
+    }
+    pubnub_mutex_unlock(m_auth_cache_lock);
+}
+
+
+/** Remembers the authentication state of context @p p, which the
+    proxy just accepted.
+ */
+static void auth_cache_store(pubnub_t const* p)
+{
+    char const*                    username = auth_cache_username(p);
+    struct proxy_auth_cache_entry* entry;
+
+    if (strlen(username) > PROXY_AUTH_CACHE_MAX_USERNAME) {
+        return;
+    }
+    pubnub_mutex_init_static(m_auth_cache_lock);
+    pubnub_mutex_lock(m_auth_cache_lock);
+    entry = auth_cache_find(p);
+    if (NULL == entry) {
+        size_t i;
+        entry = &m_auth_cache[0];
+        for (i = 1; i < PUBNUB_PROXY_AUTH_CACHE_SIZE; ++i) {
+            if (m_auth_cache[i].last_used < entry->last_used) {
+                entry = &m_auth_cache[i];
+            }
+        }
+        strcpy(entry->hostname, p->proxy_hostname);
+        strcpy(entry->username, username);
+        entry->port      = p->proxy_port;
+        entry->scheme    = pbhtauNone;
+        entry->last_used = ++m_auth_cache_uses;
+    }
+    if (pbhtauDigest == p->proxy_auth_scheme) {
+        if ((entry->scheme != pbhtauDigest)
+            || (strcmp(entry->digest.nonce, p->digest_context.nonce) != 0)) {
+            entry->digest = p->digest_context;
+        }
+        else if (entry->digest.nc < p->digest_context.nc) {
+            entry->digest.nc = p->digest_context.nc;
+        }
+    }
+    entry->scheme = p->proxy_auth_scheme;
+    pubnub_mutex_unlock(m_auth_cache_lock);
+}
+
+
+/** Forgets the authentication state for the proxy of context @p p,
+    because the proxy didn't accept it.
+ */
+static void auth_cache_forget(pubnub_t const* p)
+{
+    struct proxy_auth_cache_entry* entry;
+
+    pubnub_mutex_init_static(m_auth_cache_lock);
+    pubnub_mutex_lock(m_auth_cache_lock);
+    entry = auth_cache_find(p);
+    if (entry != NULL) {
+        entry->hostname[0] = '\0';
+        entry->last_used   = 0;
+    }
+    pubnub_mutex_unlock(m_auth_cache_lock);
+}
+
+
+void pubnub_proxy_auth_cache_clear(void)
+{
+    pubnub_mutex_init_static(m_auth_cache_lock);
+    pubnub_mutex_lock(m_auth_cache_lock);
+    memset(m_auth_cache, 0, sizeof m_auth_cache);
+    pubnub_mutex_unlock(m_auth_cache_lock);
+}
+
+#else
+
+#define auth_cache_apply(p)
+#define auth_cache_take_nonce_count(p)
+#define auth_cache_store(p)
+#define auth_cache_forget(p)
+
+void pubnub_proxy_auth_cache_clear(void)
+{
+}
+
+#endif /* PUBNUB_PROXY_AUTH_CACHE_SIZE > 0 */
+
+
 void pbproxy_handle_http_header(pubnub_t* p, char const* header)
 {
     char        scheme_basic[]  = "Basic";
@@ -120,6 +323,8 @@ int pbproxy_http_header_to_send(pubnub_t* p, char* header, size_t n)
     PUBNUB_ASSERT_OPT(p != NULL);
     PUBNUB_ASSERT_OPT(header != NULL);
 
+    auth_cache_apply(p);
+
     switch (p->proxy_auth_scheme) {
     case pbhtauBasic: {
         int             i;
@@ -159,6 +364,7 @@ int pbproxy_http_header_to_send(pubnub_t* p, char* header, size_t n)
                                   n - (sizeof prefix - 1) };
 
         memcpy(header, prefix, sizeof prefix);
+        auth_cache_take_nonce_count(p);
 
         if (0
             == pbhttp_digest_prep_header_to_send(&p->digest_context,
@@ -221,6 +427,7 @@ int pbproxy_http_header_to_send(pubnub_t* p, char* header, size_t n)
 enum pbproxyFinInstruction pbproxy_handle_finish(pubnub_t* pb)
 {
     if (HTTP_CODE_PROXY_AUTH_REQ == pb->http_code) {
+        auth_cache_forget(pb);
         if (pb->proxy_authorization_sent || (pb->proxy_auth_scheme == pbhtauNone)) {
             return pbproxyFinError;
         }
@@ -228,6 +435,10 @@ enum pbproxyFinInstruction pbproxy_handle_finish(pubnub_t* pb)
             return pbproxyFinRetry;
         }
     }
+    if ((pbhtauBasic == pb->proxy_auth_scheme)
+        || (pbhtauDigest == pb->proxy_auth_scheme)) {
+        auth_cache_store(pb);
+    }
     if (pb->proxy_type == pbproxyHTTP_CONNECT) {
         if (!pb->proxy_tunnel_established && ((pb->http_code / 100) == 2)) {
             pb->proxy_tunnel_established = true;
@@ -0,0 +1,489 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "pubnub_internal.h"
+
+#include "pubnub_publish_spool.h"
+
+#include "pbpal_spool.h"
+#include "pubnub_mutex.h"
+#include "pubnub_assert.h"
+#include "pubnub_log.h"
+
+#if !defined PUBNUB_CALLBACK_API
+#include "pubnub_pubsubapi.h"
+#include "pubnub_ntf_sync.h"
+#include "pubnub_helper.h"
+#endif
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/** Identifies a spool file, and the version of its format */
+#define SPOOL_MAGIC "PNSPOOL1"
+
+/** Size of the spool file header. The ring starts after it. */
+#define SPOOL_HEADER_SIZE 64
+
+/** Size of the header of a record in the ring */
+#define RECORD_HEADER_SIZE 8
+
+/** Length of a "record" that marks the end of the ring, the next
+    record is at the start of the ring */
+#define RECORD_WRAP UINT32_MAX
+
+/** Records are aligned to this */
+#define RECORD_ALIGN 8
+
+
+/** The header of the spool file. Positions in the ring only grow,
+    the offset in the ring is the position modulo the size of the
+    ring.
+ */
+struct spool_header {
+    char magic[8];
+    /** Size of the ring, in bytes */
+    uint64_t ring_size;
+    /** Position where the next record will be put */
+    uint64_t head;
+    /** Position of the oldest record (not yet published) */
+    uint64_t tail;
+};
+
+
+/** The header of a record in the ring. It is followed by the
+    NUL-terminated channel and the NUL-terminated message.
+ */
+struct spool_record {
+    /** Length of the channel and message, with NULs, in bytes */
+    uint32_t len;
+    uint32_t reserved;
+};
+
+
+struct pubnub_spool {
+    struct pbpal_spool_file file;
+    struct spool_header*    hdr;
+    char*                   ring;
+    uint64_t                ring_size;
+    pubnub_mutex_t          monitor;
+};
+
+
+static uint64_t record_size(size_t len)
+{
+    return (RECORD_HEADER_SIZE + len + RECORD_ALIGN - 1) & ~(uint64_t)(RECORD_ALIGN - 1);
+}
+
+
+pubnub_spool_t* pubnub_spool_open(char const* path, size_t size)
+{
+    pubnub_spool_t* spool;
+    bool            created;
+
+    PUBNUB_ASSERT_OPT(NULL != path);
+
+    if (0 == size) {
+        size = PUBNUB_SPOOL_DEFAULT_SIZE;
+    }
+    if (size < SPOOL_HEADER_SIZE + 2 * RECORD_ALIGN) {
+        PUBNUB_LOG_ERROR("Spool size %lu is too small\n", (unsigned long)size);
+        return NULL;
+    }
+    spool = (pubnub_spool_t*)malloc(sizeof *spool);
+    if (NULL == spool) {
+        return NULL;
+    }
+    if (pbpal_spool_map(path, size, &spool->file, &created) != 0) {
+        free(spool);
+        return NULL;
+    }
+    spool->hdr  = (struct spool_header*)spool->file.addr;
+    spool->ring = spool->file.addr + SPOOL_HEADER_SIZE;
+    spool->ring_size =
+        (spool->file.size - SPOOL_HEADER_SIZE) & ~(uint64_t)(RECORD_ALIGN - 1);
+    if (created) {
+        memcpy(spool->hdr->magic, SPOOL_MAGIC, sizeof spool->hdr->magic);
+        spool->hdr->ring_size = spool->ring_size;
+        spool->hdr->head      = 0;
+        spool->hdr->tail      = 0;
+    }
+    else if ((memcmp(spool->hdr->magic, SPOOL_MAGIC, sizeof spool->hdr->magic) != 0)
+             || (spool->hdr->ring_size != spool->ring_size)
+             || (spool->hdr->tail > spool->hdr->head)
+             || (spool->hdr->head - spool->hdr->tail > spool->ring_size)) {
+        PUBNUB_LOG_ERROR("File '%s' is not a (valid) spool file\n", path);
+        pbpal_spool_unmap(&spool->file);
+        free(spool);
+        return NULL;
+    }
+    pubnub_mutex_init(spool->monitor);
+    PUBNUB_LOG_INFO("Opened spool '%s', %lu bytes used\n",
+                    path,
+                    (unsigned long)(spool->hdr->head - spool->hdr->tail));
+
+    return spool;
+}
+
+
+void pubnub_spool_close(pubnub_spool_t* spool)
+{
+    PUBNUB_ASSERT_OPT(NULL != spool);
+
+    pbpal_spool_sync(&spool->file, false);
+    pbpal_spool_unmap(&spool->file);
+    pubnub_mutex_destroy(spool->monitor);
+    free(spool);
+}
+
+
+enum pubnub_res pubnub_spool_publish(pubnub_spool_t* spool,
+                                     char const*     channel,
+                                     char const*     message)
+{
+    size_t               channel_len;
+    size_t               message_len;
+    uint64_t             size;
+    uint64_t             head;
+    uint64_t             room_to_end;
+    struct spool_record* rec;
+
+    PUBNUB_ASSERT_OPT(NULL != spool);
+    PUBNUB_ASSERT_OPT(NULL != channel);
+    PUBNUB_ASSERT_OPT(NULL != message);
+
+    channel_len = strlen(channel) + 1;
+    message_len = strlen(message) + 1;
+    if (1 == channel_len) {
+        return PNR_INVALID_CHANNEL;
+    }
+    size = record_size(channel_len + message_len);
+    if (size > spool->ring_size) {
+        return PNR_TX_BUFF_TOO_SMALL;
+    }
+
+    pubnub_mutex_lock(spool->monitor);
+    head        = spool->hdr->head;
+    room_to_end = spool->ring_size - head % spool->ring_size;
+    if (head - spool->hdr->tail + size + ((room_to_end < size) ? room_to_end : 0)
+        > spool->ring_size) {
+        pubnub_mutex_unlock(spool->monitor);
+        return PNR_TX_BUFF_TOO_SMALL;
+    }
+    if (room_to_end < size) {
+        rec      = (struct spool_record*)(spool->ring + head % spool->ring_size);
+        rec->len = RECORD_WRAP;
+        head += room_to_end;
+    }
+    rec           = (struct spool_record*)(spool->ring + head % spool->ring_size);
+    rec->len      = (uint32_t)(channel_len + message_len);
+    rec->reserved = 0;
+    memcpy(rec + 1, channel, channel_len);
+    memcpy((char*)(rec + 1) + channel_len, message, message_len);
+    /* Only now is the record in the spool */
+    spool->hdr->head = head + size;
+    pubnub_mutex_unlock(spool->monitor);
+
+    return PNR_OK;
+}
+
+
+size_t pubnub_spool_used(pubnub_spool_t* spool)
+{
+    size_t rslt;
+
+    PUBNUB_ASSERT_OPT(NULL != spool);
+
+    pubnub_mutex_lock(spool->monitor);
+    rslt = (size_t)(spool->hdr->head - spool->hdr->tail);
+    pubnub_mutex_unlock(spool->monitor);
+
+    return rslt;
+}
+
+
+int pubnub_spool_flush(pubnub_spool_t* spool)
+{
+    PUBNUB_ASSERT_OPT(NULL != spool);
+
+    return pbpal_spool_sync(&spool->file, true);
+}
+
+
+#if !defined PUBNUB_CALLBACK_API
+
+/** Gets the record at the position @p pos in the @p spool, skipping
+    the "wrap" record, if there is one.
+
+    @param pos Position of the record, updated to the position of the
+    (actual) record, if it was a "wrap" record
+    @param channel The channel of the record
+    @param message The message of the record
+    @return Position of the record after this one, or 0 if the record
+    is not valid
+ */
+static uint64_t get_record(pubnub_spool_t const* spool,
+                           uint64_t*             pos,
+                           char const**          channel,
+                           char const**          message)
+{
+    uint64_t                   offset = *pos % spool->ring_size;
+    struct spool_record const* rec;
+    char const*                end;
+
+    rec = (struct spool_record const*)(spool->ring + offset);
+    if (RECORD_WRAP == rec->len) {
+        *pos += spool->ring_size - offset;
+        offset = 0;
+        rec    = (struct spool_record const*)spool->ring;
+    }
+    if (record_size(rec->len) > spool->ring_size - offset) {
+        return 0;
+    }
+    *channel = (char const*)(rec + 1);
+    end      = *channel + rec->len;
+    *message = (char const*)memchr(*channel, '\0', rec->len);
+    if (NULL == *message) {
+        return 0;
+    }
+    ++*message;
+    if (NULL == memchr(*message, '\0', end - *message)) {
+        return 0;
+    }
+
+    return *pos + record_size(rec->len);
+}
+
+
+/** A context that drains the spool */
+struct spool_drainer {
+    /** Position of the record it publishes */
+    uint64_t pos;
+    /** Whether it has a record to publish */
+    bool has_record;
+    /** Whether it has a transaction in flight */
+    bool busy;
+    /** When to (re)try to publish the record, if not busy */
+    unsigned long retry_at;
+    /** How long it waited before the last retry of the record, 0 if
+        it was not retried (yet) */
+    unsigned long backoff;
+};
+
+
+/** Whether the drainer should retry to publish after @p pb failed with
+    @p res, or give up on the record */
+static bool should_retry(pubnub_t* pb, enum pubnub_res res)
+{
+    if ((PNR_HTTP_ERROR == res) || (PNR_PUBLISH_FAILED == res)) {
+        int http_code = pubnub_last_http_code(pb);
+        return (429 == http_code) || (http_code >= 500);
+    }
+    return pubnub_should_retry(res) != pbccFalse;
+}
+
+
+/** Returns whether @p a is before @p b on the (wrapping) clock */
+static bool before(unsigned long a, unsigned long b)
+{
+    return (long)(a - b) < 0;
+}
+
+
+/** Has the drainer @p d retry its record after a backoff, doubled
+    from the previous one (for the same record).
+    @return The backoff, in milliseconds
+ */
+static unsigned long back_off(struct spool_drainer* d, unsigned long now)
+{
+    d->backoff = (0 == d->backoff) ? PUBNUB_SPOOL_MIN_BACKOFF_MS : 2 * d->backoff;
+    if (d->backoff > PUBNUB_SPOOL_MAX_BACKOFF_MS) {
+        d->backoff = PUBNUB_SPOOL_MAX_BACKOFF_MS;
+    }
+    d->retry_at = now + d->backoff;
+
+    return d->backoff;
+}
+
+
+enum pubnub_res pubnub_spool_drain(pubnub_spool_t* spool,
+                                   pubnub_t**      pbs,
+                                   size_t          n,
+                                   int             timeout_ms)
+{
+    struct spool_drainer* drainers;
+    pubnub_t**            busy;
+    unsigned long         start = pbpal_spool_clock_ms();
+    uint64_t              cursor;
+    size_t                i;
+    enum pubnub_res       rslt = PNR_OK;
+
+    PUBNUB_ASSERT_OPT(NULL != spool);
+    PUBNUB_ASSERT_OPT(NULL != pbs);
+    PUBNUB_ASSERT_OPT(n > 0);
+
+    drainers = (struct spool_drainer*)calloc(n, sizeof *drainers + sizeof *busy);
+    if (NULL == drainers) {
+        PUBNUB_LOG_ERROR("Failed to allocate data to drain the spool with "
+                         "%lu contexts\n",
+                         (unsigned long)n);
+        return PNR_REPLY_TOO_BIG;
+    }
+    busy = (pubnub_t**)(drainers + n);
+
+    pubnub_mutex_lock(spool->monitor);
+    cursor = spool->hdr->tail;
+    pubnub_mutex_unlock(spool->monitor);
+
+    for (;;) {
+        unsigned long now = pbpal_spool_clock_ms();
+        unsigned long wake_at;
+        uint64_t      head;
+        uint64_t      tail;
+        bool          pending = false;
+        int           wait_ms;
+        int           idx;
+
+        /* Take new records, (re)start publishing those that are due */
+        pubnub_mutex_lock(spool->monitor);
+        head = spool->hdr->head;
+        pubnub_mutex_unlock(spool->monitor);
+        tail    = cursor;
+        wake_at = now + PUBNUB_SPOOL_MAX_BACKOFF_MS;
+        for (i = 0; i < n; ++i) {
+            struct spool_drainer* d = &drainers[i];
+            char const*           channel;
+            char const*           message;
+
+            if (!d->has_record && (cursor < head)) {
+                uint64_t next = get_record(spool, &cursor, &channel, &message);
+                if (0 == next) {
+                    PUBNUB_LOG_ERROR("Spool is corrupt at position %lu, "
+                                     "dropping %lu bytes\n",
+                                     (unsigned long)cursor,
+                                     (unsigned long)(head - cursor));
+                    cursor = head;
+                }
+                else {
+                    d->pos        = cursor;
+                    d->has_record = true;
+                    d->retry_at   = now;
+                    d->backoff    = 0;
+                    cursor        = next;
+                }
+            }
+            if (d->has_record && !d->busy && !before(now, d->retry_at)) {
+                enum pubnub_res res;
+                uint64_t        pos = d->pos;
+                get_record(spool, &pos, &channel, &message);
+                res = pubnub_publish(pbs[i], channel, message);
+                if (PNR_STARTED == res) {
+                    d->busy = true;
+                }
+                else if (should_retry(pbs[i], res)) {
+                    back_off(d, now);
+                }
+                else {
+                    PUBNUB_LOG_ERROR("Failed to start publishing spooled message "
+                                     "'%s' on channel '%s': %d('%s'), "
+                                     "dropping it\n",
+                                     message,
+                                     channel,
+                                     res,
+                                     pubnub_res_2_string(res));
+                    d->has_record = false;
+                    continue;
+                }
+            }
+            if (d->has_record) {
+                pending = true;
+                if (d->pos < tail) {
+                    tail = d->pos;
+                }
+                if (!d->busy && before(d->retry_at, wake_at)) {
+                    wake_at = d->retry_at;
+                }
+            }
+        }
+        if (!pending) {
+            tail = cursor;
+        }
+
+        /* Records before the oldest pending one are done */
+        pubnub_mutex_lock(spool->monitor);
+        if (tail > spool->hdr->tail) {
+            spool->hdr->tail = tail;
+        }
+        pubnub_mutex_unlock(spool->monitor);
+        if (!pending && (cursor >= head)) {
+            break;
+        }
+
+        if (timeout_ms >= 0) {
+            unsigned long deadline = start + (unsigned long)timeout_ms;
+            if (!before(now, deadline)) {
+                rslt = PNR_TIMEOUT;
+                break;
+            }
+            if (before(deadline, wake_at)) {
+                wake_at = deadline;
+            }
+        }
+        wait_ms = before(now, wake_at) ? (int)(wake_at - now) : 0;
+
+        for (i = 0; i < n; ++i) {
+            busy[i] = drainers[i].busy ? pbs[i] : NULL;
+        }
+        idx = pubnub_await_any(busy, n, wait_ms);
+        if (idx < 0) {
+            if (-1 == idx) {
+                /* Nothing in flight, or nothing finished in time */
+                for (i = 0; (i < n) && !drainers[i].busy; ++i) {
+                    continue;
+                }
+                if ((i == n) && (wait_ms > 0)) {
+                    pbpal_spool_sleep_ms(wait_ms);
+                }
+            }
+            continue;
+        }
+        drainers[idx].busy = false;
+        rslt               = pubnub_last_result(pbs[idx]);
+        if (PNR_OK == rslt) {
+            drainers[idx].has_record = false;
+        }
+        else if (should_retry(pbs[idx], rslt)) {
+            unsigned long backoff =
+                back_off(&drainers[idx], pbpal_spool_clock_ms());
+            PUBNUB_LOG_WARNING("Publishing spooled message failed: %d('%s'), "
+                               "retrying in %lu ms\n",
+                               rslt,
+                               pubnub_res_2_string(rslt),
+                               backoff);
+        }
+        else {
+            PUBNUB_LOG_ERROR("Publishing spooled message failed: %d('%s'), "
+                             "response: %s, dropping it\n",
+                             rslt,
+                             pubnub_res_2_string(rslt),
+                             pubnub_last_publish_result(pbs[idx]));
+            drainers[idx].has_record = false;
+        }
+        rslt = PNR_OK;
+    }
+
+    /* What is in flight will be published again on next drain */
+    for (i = 0; i < n; ++i) {
+        busy[i] = NULL;
+        if (drainers[i].busy) {
+            pubnub_cancel(pbs[i]);
+            busy[i] = pbs[i];
+        }
+    }
+    pubnub_await_all(busy, n, -1);
+    free(drainers);
+
+    return rslt;
+}
+
+#endif /* !defined PUBNUB_CALLBACK_API */
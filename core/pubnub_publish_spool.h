@@ -0,0 +1,138 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PUBNUB_PUBLISH_SPOOL
+#define INC_PUBNUB_PUBLISH_SPOOL
+
+
+#include "pubnub_api_types.h"
+
+#include <stddef.h>
+
+
+/** @file pubnub_publish_spool.h
+    This is the "Publish spool" API. A spool is a ring buffer in a
+    memory-mapped file. Publishing to it (pubnub_spool_publish()) just
+    copies the channel and message into the file, so it is fast and
+    doesn't depend on the network. The spooled messages are published
+    later, by a drainer (pubnub_spool_drain()), which retries them,
+    with backoff, until they are published or rejected by Pubnub.
+
+    Since the spool is a file, messages that were not published
+    survive a restart of the process: just open the same file again.
+    Messages are removed from the spool only after they are published,
+    so a crash during drain may cause some of them to be published
+    twice.
+
+    A spool is thread-safe (if the C-core is built with
+    PUBNUB_THREADSAFE), but can be used by only one process at a time.
+
+    To use it, the C-core has to be built with
+    `../core/pubnub_publish_spool.c` and the "PAL" for the mapping of
+    the file (for POSIX: `../posix/pubnub_publish_spool_posix.c`).
+*/
+
+
+#if !defined PUBNUB_SPOOL_DEFAULT_SIZE
+/** Size of the spool file to create, in bytes, if none is given */
+#define PUBNUB_SPOOL_DEFAULT_SIZE (1024 * 1024)
+#endif
+
+#if !defined PUBNUB_SPOOL_MIN_BACKOFF_MS
+/** The time (in milliseconds) the drainer waits before retrying to
+    publish a message the first time */
+#define PUBNUB_SPOOL_MIN_BACKOFF_MS 100
+#endif
+
+#if !defined PUBNUB_SPOOL_MAX_BACKOFF_MS
+/** The maximum time (in milliseconds) the drainer waits before
+    retrying to publish a message. The time is doubled after each
+    failure, up to this. */
+#define PUBNUB_SPOOL_MAX_BACKOFF_MS 30000
+#endif
+
+
+/** A publish spool. It's an opaque type, use functions to work with
+    it.
+ */
+typedef struct pubnub_spool pubnub_spool_t;
+
+
+/** Opens the spool in the file at @p path. If the file doesn't exist
+    (or is empty), it is created, with the size of @p size bytes (or
+    PUBNUB_SPOOL_DEFAULT_SIZE if 0). Otherwise, @p size is ignored and
+    the messages that are in the spool are kept.
+
+    @param path The path of the spool file
+    @param size The size of the spool file to create
+    @return The spool, or NULL on failure (can't create, map or lock
+    the file, or it is not a spool file)
+ */
+pubnub_spool_t* pubnub_spool_open(char const* path, size_t size);
+
+/** Closes the @p spool, which must not be used by any thread (or a
+    drainer) any more. Messages in the spool are kept in the file.
+ */
+void pubnub_spool_close(pubnub_spool_t* spool);
+
+/** Puts a @p message to publish on the @p channel into the @p spool.
+    It will be published by the drainer.
+
+    @param spool The spool to put the message into
+    @param channel The channel to publish to. Can't be NULL
+    @param message The message to publish, JSON encoded. Can't be NULL
+    @retval PNR_OK Message is in the spool
+    @retval PNR_INVALID_CHANNEL @p channel is empty
+    @retval PNR_TX_BUFF_TOO_SMALL There is no room in the spool for
+    the message (now - or ever, if it is larger than the spool)
+ */
+enum pubnub_res pubnub_spool_publish(pubnub_spool_t* spool,
+                                     char const*     channel,
+                                     char const*     message);
+
+/** Returns the number of bytes used in the @p spool, that is, taken
+    by messages that were not yet published. 0 means the spool is
+    empty.
+ */
+size_t pubnub_spool_used(pubnub_spool_t* spool);
+
+/** Writes (the changes to) the @p spool out to its file, so that they
+    would survive a crash of the system, not just the process.
+
+    @return 0: OK, -1: error
+ */
+int pubnub_spool_flush(pubnub_spool_t* spool);
+
+#if !defined PUBNUB_CALLBACK_API
+/** Drains the @p spool, publishing its messages with the (sync)
+    contexts @p pbs, concurrently. The contexts have to be initialized
+    and must not be in a transaction. They are not used for anything
+    else until this returns, when they are left idle.
+
+    Messages are taken from the spool in the order they were put
+    there, but, since there are @p n contexts publishing them, they
+    may be published out of that order.
+
+    Messages that fail to be published because of the network (or a
+    HTTP 429 or 5xx from Pubnub) are retried after a backoff, which is
+    doubled on each failure of the same message (from
+    PUBNUB_SPOOL_MIN_BACKOFF_MS to PUBNUB_SPOOL_MAX_BACKOFF_MS), so
+    other messages being published doesn't make it retry sooner.
+    Messages that are rejected by Pubnub are logged and dropped.
+
+    @param spool The spool to drain
+    @param pbs The contexts to publish with. Can't be NULL
+    @param n Number of contexts in @p pbs. Has to be at least 1
+    @param timeout_ms The maximum time to drain, in milliseconds. If
+    negative, waits until the spool is empty
+    @retval PNR_OK The spool is empty
+    @retval PNR_TIMEOUT There are (still) messages in the spool
+    @retval PNR_REPLY_TOO_BIG Failed to allocate the data to drain
+    with @p n contexts
+ */
+enum pubnub_res pubnub_spool_drain(pubnub_spool_t* spool,
+                                   pubnub_t**      pbs,
+                                   size_t          n,
+                                   int             timeout_ms);
+#endif /* !defined PUBNUB_CALLBACK_API */
+
+
+#endif /* !defined INC_PUBNUB_PUBLISH_SPOOL */
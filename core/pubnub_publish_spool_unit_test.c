@@ -0,0 +1,465 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "cgreen/cgreen.h"
+#include "cgreen/mocks.h"
+
+#include "pubnub_internal.h"
+
+#include "core/pubnub_publish_spool.h"
+#include "core/pbpal_spool.h"
+#include "core/pubnub_pubsubapi.h"
+#include "core/pubnub_ntf_sync.h"
+#include "core/pubnub_helper.h"
+#include "core/pubnub_assert.h"
+
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+
+
+/* This test is built with a small backoff (10 ms, up to 80 ms), so
+   that it doesn't take long to check it.
+*/
+
+
+/* A less chatty cgreen :) */
+
+#define attest assert_that
+#define equals is_equal_to
+#define streqs is_equal_to_string
+#define differs is_not_equal_to
+#define strdifs is_not_equal_to_string
+#define ptreqs(val) is_equal_to_contents_of(&(val), sizeof(val))
+#define ptrdifs(val) is_not_equal_to_contents_of(&(val), sizeof(val))
+#define sets(par, val) will_set_contents_of_parameter(par, &(val), sizeof(val))
+#define sets_ex will_set_contents_of_parameter
+#define returns will_return
+
+
+/** As in pubnub_publish_spool.c, the ring starts after it */
+#define SPOOL_HEADER_SIZE 64
+
+enum { CONTEXTS = 2, MAX_ATTEMPTS = 100 };
+
+static pubnub_t  m_ctx[CONTEXTS];
+static pubnub_t* m_pbs[] = { m_ctx + 0, m_ctx + 1 };
+
+static char            m_path[64];
+static pubnub_spool_t* m_spool;
+
+/** The publish transactions started. Publishing to channel:
+    - "flaky" fails (and should be retried) `m_flaky_failures` times
+    - "flaky2" fails (and should be retried) once
+    - "down" always fails (and should be retried)
+    - "rejected" is rejected by (fake) Pubnub (HTTP 400)
+    - any other succeeds
+*/
+static struct attempt {
+    char          channel[16];
+    char          message[32];
+    unsigned long at;
+} m_attempt[MAX_ATTEMPTS];
+static int m_attempts;
+static int m_flaky_failures;
+static int m_flaky2_failures;
+
+static bool            m_busy[CONTEXTS];
+static enum pubnub_res m_result[CONTEXTS];
+static int             m_http_code[CONTEXTS];
+
+
+static int ctx_index(pubnub_t const* pb)
+{
+    int i = (int)(pb - m_ctx);
+    PUBNUB_ASSERT_OPT((i >= 0) && (i < CONTEXTS));
+    return i;
+}
+
+
+enum pubnub_res pubnub_publish(pubnub_t* pb, const char* channel, const char* message)
+{
+    int             i = ctx_index(pb);
+    struct attempt* a = &m_attempt[m_attempts];
+
+    attest(m_busy[i], equals(false));
+    attest(m_attempts, is_less_than(MAX_ATTEMPTS));
+    snprintf(a->channel, sizeof a->channel, "%s", channel);
+    snprintf(a->message, sizeof a->message, "%s", message);
+    a->at = pbpal_spool_clock_ms();
+    ++m_attempts;
+
+    m_busy[i]      = true;
+    m_result[i]    = PNR_OK;
+    m_http_code[i] = 200;
+    if (((0 == strcmp(channel, "flaky")) && (m_flaky_failures-- > 0))
+        || ((0 == strcmp(channel, "flaky2")) && (m_flaky2_failures-- > 0))
+        || (0 == strcmp(channel, "down"))) {
+        m_result[i] = PNR_IO_ERROR;
+    }
+    else if (0 == strcmp(channel, "rejected")) {
+        m_result[i]    = PNR_PUBLISH_FAILED;
+        m_http_code[i] = 400;
+    }
+
+    return PNR_STARTED;
+}
+
+
+enum pubnub_res pubnub_last_result(pubnub_t* pb)
+{
+    return m_result[ctx_index(pb)];
+}
+
+
+int pubnub_last_http_code(pubnub_t* pb)
+{
+    return m_http_code[ctx_index(pb)];
+}
+
+
+char const* pubnub_last_publish_result(pubnub_t* pb)
+{
+    PUBNUB_UNUSED(pb);
+    return "[0,\"Invalid\"]";
+}
+
+
+void pubnub_cancel(pubnub_t* pb)
+{
+    m_result[ctx_index(pb)] = PNR_CANCELLED;
+}
+
+
+enum pubnub_tribool pubnub_should_retry(enum pubnub_res e)
+{
+    return (PNR_IO_ERROR == e) ? pbccTrue : pbccFalse;
+}
+
+
+char const* pubnub_res_2_string(enum pubnub_res e)
+{
+    PUBNUB_UNUSED(e);
+    return "";
+}
+
+
+/** Finishes the transaction of the first busy context */
+int pubnub_await_any(pubnub_t** pbs, size_t n, int timeout_ms)
+{
+    size_t i;
+    for (i = 0; i < n; ++i) {
+        if (pbs[i] != NULL) {
+            m_busy[ctx_index(pbs[i])] = false;
+            return (int)i;
+        }
+    }
+    if (timeout_ms > 0) {
+        pbpal_spool_sleep_ms(timeout_ms);
+    }
+    return -1;
+}
+
+
+enum pubnub_res pubnub_await_all(pubnub_t** pbs, size_t n, int timeout_ms)
+{
+    size_t i;
+    PUBNUB_UNUSED(timeout_ms);
+    for (i = 0; i < n; ++i) {
+        if (pbs[i] != NULL) {
+            m_busy[ctx_index(pbs[i])] = false;
+        }
+    }
+    return PNR_OK;
+}
+
+
+static char const* msg(int i)
+{
+    static char s[32];
+    snprintf(s, sizeof s, "\"message-%d\"", i);
+    return s;
+}
+
+
+/** Checks that the messages published (successfully) are
+    `msg(from)`..`msg(to - 1)`, in that order, on channel "ch" */
+static void attest_published(int from, int to)
+{
+    int i;
+    int published = 0;
+    for (i = 0; i < m_attempts; ++i) {
+        if (0 == strcmp(m_attempt[i].channel, "ch")) {
+            attest(m_attempt[i].message, streqs(msg(from + published)));
+            ++published;
+        }
+    }
+    attest(published, equals(to - from));
+}
+
+
+/** Returns the times between the attempts to publish to @p channel */
+static int intervals(char const* channel, unsigned long* interval, int max)
+{
+    int           i;
+    int           n = 0;
+    unsigned long prev;
+    bool          first = true;
+    for (i = 0; i < m_attempts; ++i) {
+        if (0 == strcmp(m_attempt[i].channel, channel)) {
+            if (!first && (n < max)) {
+                interval[n++] = m_attempt[i].at - prev;
+            }
+            prev  = m_attempt[i].at;
+            first = false;
+        }
+    }
+    return n;
+}
+
+
+static void write_at(off_t offset, void const* data, size_t len)
+{
+    int fd = open(m_path, O_WRONLY);
+    attest(fd, differs(-1));
+    attest(pwrite(fd, data, len, offset), equals(len));
+    close(fd);
+}
+
+
+Describe(pubnub_publish_spool);
+
+
+BeforeEach(pubnub_publish_spool) {
+    snprintf(m_path, sizeof m_path, "pubnub_spool_unit_test_%d.spool", (int)getpid());
+    unlink(m_path);
+    m_spool           = NULL;
+    m_attempts        = 0;
+    m_flaky_failures  = 0;
+    m_flaky2_failures = 0;
+    memset(m_busy, 0, sizeof m_busy);
+}
+
+
+AfterEach(pubnub_publish_spool) {
+    if (m_spool != NULL) {
+        pubnub_spool_close(m_spool);
+    }
+    unlink(m_path);
+}
+
+
+Ensure(pubnub_publish_spool, drain_publishes_spooled_messages_in_order) {
+    int i;
+
+    m_spool = pubnub_spool_open(m_path, 4096);
+    attest(m_spool, differs(NULL));
+    attest(pubnub_spool_used(m_spool), equals(0));
+    for (i = 0; i < 5; ++i) {
+        attest(pubnub_spool_publish(m_spool, "ch", msg(i)), equals(PNR_OK));
+    }
+    attest(pubnub_spool_used(m_spool), differs(0));
+
+    attest(pubnub_spool_drain(m_spool, m_pbs, 1, -1), equals(PNR_OK));
+    attest_published(0, 5);
+    attest(pubnub_spool_used(m_spool), equals(0));
+
+    /* Nothing is published again */
+    attest(pubnub_spool_drain(m_spool, m_pbs, 1, -1), equals(PNR_OK));
+    attest(m_attempts, equals(5));
+}
+
+
+Ensure(pubnub_publish_spool, invalid_messages_are_not_spooled) {
+    char big[300];
+
+    m_spool = pubnub_spool_open(m_path, SPOOL_HEADER_SIZE + 256);
+    attest(m_spool, differs(NULL));
+    attest(pubnub_spool_publish(m_spool, "", msg(0)), equals(PNR_INVALID_CHANNEL));
+    memset(big, 'x', sizeof big - 1);
+    big[sizeof big - 1] = '\0';
+    attest(pubnub_spool_publish(m_spool, "ch", big), equals(PNR_TX_BUFF_TOO_SMALL));
+    attest(pubnub_spool_used(m_spool), equals(0));
+}
+
+
+Ensure(pubnub_publish_spool, ring_wraps_around_and_keeps_order) {
+    int i;
+
+    /* Each record takes 24 bytes, so they don't fit the 128 byte ring
+       evenly */
+    m_spool = pubnub_spool_open(m_path, SPOOL_HEADER_SIZE + 128);
+    attest(m_spool, differs(NULL));
+    for (i = 0; i < 4; ++i) {
+        attest(pubnub_spool_publish(m_spool, "ch", msg(i)), equals(PNR_OK));
+    }
+    attest(pubnub_spool_drain(m_spool, m_pbs, CONTEXTS, -1), equals(PNR_OK));
+
+    for (i = 4; i < 9; ++i) {
+        attest(pubnub_spool_publish(m_spool, "ch", msg(i)), equals(PNR_OK));
+    }
+    /* The ring is full */
+    attest(pubnub_spool_publish(m_spool, "ch", msg(9)), equals(PNR_TX_BUFF_TOO_SMALL));
+
+    attest(pubnub_spool_drain(m_spool, m_pbs, 1, -1), equals(PNR_OK));
+    attest_published(0, 9);
+    attest(pubnub_spool_used(m_spool), equals(0));
+}
+
+
+Ensure(pubnub_publish_spool, messages_survive_a_crash) {
+    pid_t pid = fork();
+    int   status;
+
+    attest(pid, differs(-1));
+    if (0 == pid) {
+        /* "Crash" with messages in the spool, without closing it */
+        pubnub_spool_t* spool = pubnub_spool_open(m_path, 4096);
+        int             i;
+        if (NULL == spool) {
+            _exit(1);
+        }
+        for (i = 0; i < 3; ++i) {
+            if (pubnub_spool_publish(spool, "ch", msg(i)) != PNR_OK) {
+                _exit(2);
+            }
+        }
+        _exit(0);
+    }
+    attest(waitpid(pid, &status, 0), equals(pid));
+    attest(WIFEXITED(status) && (0 == WEXITSTATUS(status)), equals(true));
+
+    m_spool = pubnub_spool_open(m_path, 0);
+    attest(m_spool, differs(NULL));
+    attest(pubnub_spool_drain(m_spool, m_pbs, CONTEXTS, -1), equals(PNR_OK));
+    attest_published(0, 3);
+}
+
+
+Ensure(pubnub_publish_spool, record_written_partially_before_crash_is_ignored) {
+    static char const partial[] = { 40, 0, 0, 0, 0, 0, 0, 0, 'c', 'h', 0, '"' };
+    size_t            used;
+
+    m_spool = pubnub_spool_open(m_path, 4096);
+    attest(m_spool, differs(NULL));
+    attest(pubnub_spool_publish(m_spool, "ch", msg(0)), equals(PNR_OK));
+    used = pubnub_spool_used(m_spool);
+    pubnub_spool_close(m_spool);
+
+    /* As if the process crashed while putting the next record in */
+    write_at(SPOOL_HEADER_SIZE + used, partial, sizeof partial);
+
+    m_spool = pubnub_spool_open(m_path, 0);
+    attest(m_spool, differs(NULL));
+    attest(pubnub_spool_used(m_spool), equals(used));
+    attest(pubnub_spool_drain(m_spool, m_pbs, 1, -1), equals(PNR_OK));
+    attest_published(0, 1);
+}
+
+
+Ensure(pubnub_publish_spool, corrupt_record_is_dropped_with_the_rest) {
+    static uint32_t const bad_len = 0x7fffffff;
+
+    m_spool = pubnub_spool_open(m_path, 4096);
+    attest(m_spool, differs(NULL));
+    attest(pubnub_spool_publish(m_spool, "ch", msg(0)), equals(PNR_OK));
+    attest(pubnub_spool_publish(m_spool, "ch", msg(1)), equals(PNR_OK));
+    pubnub_spool_close(m_spool);
+
+    write_at(SPOOL_HEADER_SIZE, &bad_len, sizeof bad_len);
+
+    m_spool = pubnub_spool_open(m_path, 0);
+    attest(m_spool, differs(NULL));
+    attest(pubnub_spool_drain(m_spool, m_pbs, 1, -1), equals(PNR_OK));
+    attest(m_attempts, equals(0));
+    attest(pubnub_spool_used(m_spool), equals(0));
+}
+
+
+Ensure(pubnub_publish_spool, truncated_or_foreign_file_is_not_opened) {
+    m_spool = pubnub_spool_open(m_path, 4096);
+    attest(m_spool, differs(NULL));
+    attest(pubnub_spool_publish(m_spool, "ch", msg(0)), equals(PNR_OK));
+    pubnub_spool_close(m_spool);
+
+    attest(truncate(m_path, 2048), equals(0));
+    m_spool = pubnub_spool_open(m_path, 4096);
+    attest(m_spool, equals(NULL));
+
+    write_at(0, "NOTSPOOL", 8);
+    m_spool = pubnub_spool_open(m_path, 4096);
+    attest(m_spool, equals(NULL));
+
+    /* An empty file is a new spool */
+    attest(truncate(m_path, 0), equals(0));
+    m_spool = pubnub_spool_open(m_path, 4096);
+    attest(m_spool, differs(NULL));
+    attest(pubnub_spool_used(m_spool), equals(0));
+}
+
+
+Ensure(pubnub_publish_spool, spool_is_used_by_one_process_at_a_time) {
+    m_spool = pubnub_spool_open(m_path, 4096);
+    attest(m_spool, differs(NULL));
+    attest(pubnub_spool_open(m_path, 4096), equals(NULL));
+}
+
+
+Ensure(pubnub_publish_spool, backoff_is_doubled_for_each_failure_of_a_message) {
+    unsigned long interval[10];
+    int           i;
+
+    m_spool = pubnub_spool_open(m_path, 4096);
+    attest(m_spool, differs(NULL));
+    m_flaky_failures  = 5;
+    m_flaky2_failures = 1;
+    attest(pubnub_spool_publish(m_spool, "flaky", msg(0)), equals(PNR_OK));
+    attest(pubnub_spool_publish(m_spool, "flaky2", msg(1)), equals(PNR_OK));
+    for (i = 0; i < 5; ++i) {
+        attest(pubnub_spool_publish(m_spool, "ch", msg(i)), equals(PNR_OK));
+    }
+
+    attest(pubnub_spool_drain(m_spool, m_pbs, CONTEXTS, -1), equals(PNR_OK));
+    attest_published(0, 5);
+
+    /* Other messages being published (or retried) doesn't reset the
+       backoff of the one that keeps failing */
+    attest(intervals("flaky", interval, 10), equals(5));
+    attest(interval[0], is_greater_than(10 - 1));
+    attest(interval[1], is_greater_than(20 - 1));
+    attest(interval[2], is_greater_than(40 - 1));
+    attest(interval[3], is_greater_than(80 - 1));
+    attest(interval[4], is_greater_than(80 - 1));
+    attest(intervals("flaky2", interval, 10), equals(1));
+    attest(interval[0], is_greater_than(10 - 1));
+}
+
+
+Ensure(pubnub_publish_spool, rejected_message_is_dropped) {
+    m_spool = pubnub_spool_open(m_path, 4096);
+    attest(m_spool, differs(NULL));
+    attest(pubnub_spool_publish(m_spool, "rejected", msg(0)), equals(PNR_OK));
+    attest(pubnub_spool_publish(m_spool, "ch", msg(0)), equals(PNR_OK));
+
+    attest(pubnub_spool_drain(m_spool, m_pbs, 1, -1), equals(PNR_OK));
+    attest(m_attempts, equals(2));
+    attest_published(0, 1);
+    attest(pubnub_spool_used(m_spool), equals(0));
+}
+
+
+Ensure(pubnub_publish_spool, failing_message_is_kept_on_timeout) {
+    m_spool = pubnub_spool_open(m_path, 4096);
+    attest(m_spool, differs(NULL));
+    attest(pubnub_spool_publish(m_spool, "down", msg(0)), equals(PNR_OK));
+    attest(pubnub_spool_publish(m_spool, "ch", msg(0)), equals(PNR_OK));
+
+    attest(pubnub_spool_drain(m_spool, m_pbs, CONTEXTS, 50), equals(PNR_TIMEOUT));
+    attest_published(0, 1);
+    attest(pubnub_spool_used(m_spool), differs(0));
+    attest(m_busy[0], equals(false));
+    attest(m_busy[1], equals(false));
+}
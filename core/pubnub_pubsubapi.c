@@ -28,9 +28,14 @@ pubnub_t* pubnub_init(pubnub_t* p, const char* publish_key, const char* subscrib
 #if defined(PUBNUB_CALLBACK_API)
     p->cb        = NULL;
     p->user_data = NULL;
+#endif
+#if PUBNUB_STREAMING_SUBSCRIBE
+    p->stream_cb        = NULL;
+    p->stream_user_data = NULL;
 #endif
     if (PUBNUB_ORIGIN_SETTABLE) {
-        p->origin = PUBNUB_ORIGIN;
+        p->origin           = PUBNUB_ORIGIN;
+        p->connected_origin = PUBNUB_ORIGIN;
     }
 #if PUBNUB_BLOCKING_IO_SETTABLE
 #if defined(PUBNUB_CALLBACK_API)
@@ -46,6 +51,8 @@ pubnub_t* pubnub_init(pubnub_t* p, const char* publish_key, const char* subscrib
 #if PUBNUB_ADVANCED_KEEP_ALIVE
     p->keep_alive.max     = 1000;
     p->keep_alive.timeout = 50;
+    p->keep_alive.rewarm    = false;
+    p->keep_alive.rewarming = false;
 #endif
     pbpal_init(p);
     pubnub_mutex_unlock(p->monitor);
@@ -54,6 +61,7 @@ pubnub_t* pubnub_init(pubnub_t* p, const char* publish_key, const char* subscrib
     p->proxy_type               = pbproxyNONE;
     p->proxy_hostname[0]        = '\0';
     p->proxy_tunnel_established = false;
+    p->proxy_tunnel_reused      = false;
     p->proxy_port               = 80;
     p->proxy_auth_scheme        = pbhtauNone;
     p->proxy_auth_username      = NULL;
@@ -308,3 +316,25 @@ void pubnub_dont_use_http_keep_alive(pubnub_t* p)
 {
     p->options.use_http_keep_alive = 0;
 }
+
+
+enum pubnub_res pubnub_preconnect(pubnub_t* pb)
+{
+    enum pubnub_res rslt;
+
+    PUBNUB_ASSERT(pb_valid_ctx_ptr(pb));
+
+    pubnub_mutex_lock(pb->monitor);
+    if (!pbnc_can_start_transaction(pb)) {
+        pubnub_mutex_unlock(pb->monitor);
+        return PNR_IN_PROGRESS;
+    }
+
+    pb->trans            = PBTT_PRECONNECT;
+    pb->core.last_result = PNR_STARTED;
+    pbnc_fsm(pb);
+    rslt = pb->core.last_result;
+    pubnub_mutex_unlock(pb->monitor);
+
+    return rslt;
+}
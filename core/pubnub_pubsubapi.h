@@ -226,6 +226,12 @@ char const* pubnub_get_origin(pubnub_t* p);
     detects an invalid origin, but NULL is not an invalid origin - it
     resets the origin to default.
 
+    The @p origin string is not copied, so it has to outlive the use
+    of the context (with it). If the connection to the previous origin
+    was kept alive, it is closed at the start of the next transaction,
+    which connects to the new origin (unless the connection is to a
+    HTTP GET proxy).
+
     @param p Pubnub context to set the origin for
     @param origin The origin to use for context @p p. If NULL,
     the default origin will be set
@@ -269,5 +275,31 @@ void pubnub_use_http_keep_alive(pubnub_t* p);
 */
 void pubnub_dont_use_http_keep_alive(pubnub_t* p);
 
+/** Connects the context @p pb to its origin (or proxy) in advance:
+    resolves the origin, connects and, if using SSL/TLS, does the
+    handshake, but doesn't send a request. The connection is then
+    kept in the "keep-alive" state, and the next transaction on @p pb
+    is sent over it right away. Use it to make the first transaction
+    (say, a publish of an alert) faster.
+
+    This is a transaction in its own right, you have to await its
+    outcome (or get it in the callback), like for any other. Its
+    outcome is #PNR_OK if connected.
+
+    If @p pb is already (kept alive) connected to its origin, this
+    finishes right away, with #PNR_OK. If its origin was changed, the
+    connection is closed and a new one made.
+
+    The connection is used by the next transaction even if HTTP
+    Keep-Alive is off (pubnub_dont_use_http_keep_alive()), just not
+    kept after it. Keep in mind that the server may close it, if the
+    next transaction doesn't come soon enough.
+
+    @param pb The Pubnub context to connect
+    @return #PNR_STARTED on success, #PNR_OK if already connected (or
+    connected synchronously), an error otherwise
+ */
+enum pubnub_res pubnub_preconnect(pubnub_t* pb);
+
 
 #endif /* !defined INC_PUBNUB_PUBSUBAPI */
@@ -54,7 +54,7 @@ void pubnub_ssl_dont_use_system_certificate_store(pubnub_t *p)
 }
 
 
-void pubnub_ssl_set_pem_cert(pubnub_t *p, char const *contents)
+void pubnub_ssl_set_usrdef_pem_cert(pubnub_t *p, char const *contents)
 {
     PUBNUB_ASSERT(pb_valid_ctx_ptr(p));
 
@@ -0,0 +1,28 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "pubnub_streaming_subscribe.h"
+
+#include "pubnub_internal.h"
+#if !PUBNUB_STREAMING_SUBSCRIBE
+#error Must define PUBNUB_STREAMING_SUBSCRIBE to true (!=0) before compiling this file
+#endif
+#include "pubnub_netcore.h"
+#include "pubnub_assert.h"
+
+
+enum pubnub_res pubnub_set_streaming_subscribe(pubnub_t*                           pb,
+                                               pubnub_subscribe_message_callback_t cb,
+                                               void* user_data)
+{
+    PUBNUB_ASSERT(pb_valid_ctx_ptr(pb));
+
+    pubnub_mutex_lock(pb->monitor);
+    if (!pbnc_can_start_transaction(pb)) {
+        pubnub_mutex_unlock(pb->monitor);
+        return PNR_IN_PROGRESS;
+    }
+    pb->stream_cb        = cb;
+    pb->stream_user_data = user_data;
+    pubnub_mutex_unlock(pb->monitor);
+
+    return PNR_OK;
+}
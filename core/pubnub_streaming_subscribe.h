@@ -0,0 +1,77 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PUBNUB_STREAMING_SUBSCRIBE
+#define INC_PUBNUB_STREAMING_SUBSCRIBE
+
+
+#include "pubnub_api_types.h"
+
+#include <stddef.h>
+
+
+/** @file pubnub_streaming_subscribe.h
+    This is the "Streaming subscribe" API of the Pubnub client
+    library. In the "streaming" mode, messages received by subscribe
+    are handed to the user as soon as each of them has fully arrived,
+    while the rest of the response is still being received, instead
+    of all of them being available (via pubnub_get()) only after the
+    whole response has arrived.
+
+    This shortens the time to the first message on large (catch-up)
+    responses and lets the space taken by delivered messages in the
+    reply buffer be reused for the rest of the response.
+
+    Some limitations of the streaming mode:
+
+    - messages that are delivered via the callback will not be
+    available via pubnub_get()
+    - channels of the messages are not known at the time of delivery
+    (they come at the end of the response), so pubnub_get_channel()
+    will not give them either
+    - compression of the response is not requested for subscribe
+    (compressed response can't be parsed until fully received)
+*/
+
+
+/** Type of the function that is called for each message received by
+    subscribe, in the "streaming" mode.
+
+    @param pb The context on which subscribe is being done
+    @param message The message (JSON), NUL-terminated. Valid only
+    during the call
+    @param length The length of @p message
+    @param user_data The user data set by
+    pubnub_set_streaming_subscribe()
+ */
+typedef void (*pubnub_subscribe_message_callback_t)(pubnub_t*   pb,
+                                                    char const* message,
+                                                    size_t      length,
+                                                    void*       user_data);
+
+
+/** Sets the "streaming" mode of subscribe on the context @p pb.
+    Each message received by subscribe will be passed to @p cb as
+    soon as it has arrived.
+
+    The callback is called from the context of the Pubnub C-core
+    processing (for the callback interface, that's the Pubnub
+    thread; for the sync interface, the thread that awaits the
+    outcome), with the context @p pb locked, so don't call any
+    Pubnub functions on @p pb from it. Also, do as little as
+    possible, as the processing of the response is "stopped"
+    during the call.
+
+    @pre Call this after pubnub_init() on the context, and not
+    while a subscribe transaction is in progress
+    @param pb The context to set the streaming mode for
+    @param cb The function to call for each message. Pass NULL
+    to return to the "regular" (non-streaming) mode
+    @param user_data Pointer to pass to @p cb
+    @return PNR_OK: OK, PNR_IN_PROGRESS: a transaction is in
+    progress, try later
+*/
+enum pubnub_res pubnub_set_streaming_subscribe(pubnub_t*                           pb,
+                                               pubnub_subscribe_message_callback_t cb,
+                                               void* user_data);
+
+
+#endif /* !defined INC_PUBNUB_STREAMING_SUBSCRIBE */
@@ -0,0 +1,378 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "pubnub_internal.h"
+
+#include "pubnub_sync_history_range.h"
+
+#include "pubnub_pubsubapi.h"
+#include "pubnub_coreapi_ex.h"
+#include "pubnub_ntf_sync.h"
+#include "pubnub_timers.h"
+#include "pubnub_json_parse.h"
+#include "pubnub_helper.h"
+#include "pubnub_assert.h"
+#include "pubnub_log.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/** Enough for any 64-bit timetoken, with the terminating NUL */
+#define TT_SIZE 21
+
+
+/** One segment of the range to fetch */
+struct hr_segment {
+    /** Timetoken to fetch (the next page of) messages after */
+    uint64_t next;
+    /** Timetoken of the last message of the segment */
+    uint64_t last;
+    /** Whether all pages of the segment were fetched */
+    bool done;
+    /** Messages fetched, but not yet delivered, as a sequence of
+        NUL-terminated timetoken and message pairs */
+    char* buf;
+    /** Number of bytes in @c buf */
+    size_t len;
+    /** Size of @c buf */
+    size_t size;
+};
+
+
+/** A context of the pool */
+struct hr_worker {
+    /** Index of the segment it fetches, -1 if none */
+    int segment;
+    /** Whether it has a transaction in flight */
+    bool busy;
+};
+
+
+static bool parse_tt(char const* s, char const* end, uint64_t* tt)
+{
+    uint64_t v = 0;
+
+    if (s == end) {
+        return false;
+    }
+    for (; s < end; ++s) {
+        if ((*s < '0') || (*s > '9') || (v > (UINT64_MAX - 9) / 10)) {
+            return false;
+        }
+        v = v * 10 + (*s - '0');
+    }
+    *tt = v;
+
+    return true;
+}
+
+
+static void format_tt(uint64_t tt, char s[TT_SIZE])
+{
+    char  digits[TT_SIZE];
+    char* p = digits + TT_SIZE - 1;
+
+    *p = '\0';
+    do {
+        *--p = (char)('0' + tt % 10);
+        tt /= 10;
+    } while (tt != 0);
+    memcpy(s, p, digits + TT_SIZE - p);
+}
+
+
+static bool append(struct hr_segment* seg, char const* s, char const* end)
+{
+    size_t len = end - s;
+
+    if (seg->len + len + 1 > seg->size) {
+        size_t size = (seg->size > 0) ? seg->size : 1024;
+        char*  buf;
+        while (seg->len + len + 1 > size) {
+            size *= 2;
+        }
+        buf = (char*)realloc(seg->buf, size);
+        if (NULL == buf) {
+            PUBNUB_LOG_ERROR("Failed to allocate %lu bytes for history "
+                             "messages\n",
+                             (unsigned long)size);
+            return false;
+        }
+        seg->buf  = buf;
+        seg->size = size;
+    }
+    memcpy(seg->buf + seg->len, s, len);
+    seg->len += len;
+    seg->buf[seg->len++] = '\0';
+
+    return true;
+}
+
+
+/** Moves the messages of the (just finished) history transaction of
+    @p pb to @p seg, and updates where to fetch the next page from.
+    Messages outside of the page's range (like the one at the start
+    timetoken, if the server returns it again) are skipped, so that
+    none is delivered twice.
+ */
+static enum pubnub_res take_page(pubnub_t*          pb,
+                                 struct hr_segment* seg,
+                                 int                count)
+{
+    char const*        reply = pubnub_get(pb);
+    uint64_t const     start = seg->next;
+    struct pbjson_elem page;
+    char const*        s;
+    int                fetched = 0;
+
+    if ((NULL == reply) || (reply[0] != '[')) {
+        return PNR_FORMAT_ERROR;
+    }
+    page.start = reply;
+    page.end   = reply + strlen(reply);
+    if (pbjson_find_end_element(page.start, page.end) != page.end - 1) {
+        return PNR_FORMAT_ERROR;
+    }
+    s = pbjson_skip_whitespace(page.start + 1, page.end - 1);
+    while (s < page.end - 1) {
+        struct pbjson_elem msg;
+        struct pbjson_elem value;
+        struct pbjson_elem tt;
+        uint64_t           tt_value;
+
+        msg.start = s;
+        msg.end   = pbjson_find_end_element(s, page.end - 1) + 1;
+        if ((pbjson_get_object_value(&msg, "message", &value) != jonmpOK)
+            || (pbjson_get_object_value(&msg, "timetoken", &tt) != jonmpOK)) {
+            return PNR_FORMAT_ERROR;
+        }
+        if ('"' == *tt.start) {
+            ++tt.start;
+            --tt.end;
+        }
+        if (!parse_tt(tt.start, tt.end, &tt_value)) {
+            return PNR_FORMAT_ERROR;
+        }
+        if ((tt_value > start) && (tt_value <= seg->last)) {
+            if (!append(seg, tt.start, tt.end)
+                || !append(seg, value.start, value.end)) {
+                return PNR_REPLY_TOO_BIG;
+            }
+            if (tt_value > seg->next) {
+                seg->next = tt_value;
+            }
+        }
+        ++fetched;
+
+        s = pbjson_skip_whitespace(msg.end, page.end - 1);
+        if (',' == *s) {
+            s = pbjson_skip_whitespace(s + 1, page.end - 1);
+        }
+    }
+    /* A page without new messages can't move us forward */
+    seg->done = (fetched < count) || (seg->next >= seg->last)
+                || (seg->next == start);
+
+    /* Skip the start and end timetokens of the page */
+    while (pubnub_get(pb) != NULL) {
+        continue;
+    }
+
+    return PNR_OK;
+}
+
+
+static enum pubnub_res start_page(pubnub_t*                          pb,
+                                  char const*                        channel,
+                                  struct hr_segment const*           seg,
+                                  struct pubnub_history_range_options opt)
+{
+    struct pubnub_history_options hopt = pubnub_history_defopts();
+    char                          start[TT_SIZE];
+    char                          end[TT_SIZE];
+
+    format_tt(seg->next, start);
+    format_tt(seg->last, end);
+    hopt.count         = opt.count;
+    hopt.reverse       = true;
+    hopt.include_token = true;
+    hopt.start         = start;
+    hopt.end           = end;
+
+    return pubnub_history_ex(pb, channel, hopt);
+}
+
+
+struct pubnub_history_range_options pubnub_history_range_defopts(void)
+{
+    struct pubnub_history_range_options rslt;
+
+    rslt.count         = 100;
+    rslt.segments      = 0;
+    rslt.max_in_flight = 0;
+    rslt.max_buffered  = 64 * 1024;
+
+    return rslt;
+}
+
+
+enum pubnub_res pubnub_history_range(pubnub_t**                          pbs,
+                                     size_t                              n,
+                                     char const*                         channel,
+                                     char const*                         from,
+                                     char const*                         to,
+                                     struct pubnub_history_range_options opt,
+                                     pubnub_history_range_cb             cb,
+                                     void*                               user_data)
+{
+    struct hr_segment* segs;
+    struct hr_worker*  workers;
+    pubnub_t**         busy;
+    uint64_t           lo;
+    uint64_t           hi;
+    uint64_t           step;
+    size_t             nsegs;
+    size_t             head     = 0;
+    size_t             assigned = 0;
+    size_t             buffered = 0;
+    size_t             i;
+    int                timeout_ms;
+    enum pubnub_res    rslt = PNR_OK;
+
+    PUBNUB_ASSERT_OPT(NULL != pbs);
+    PUBNUB_ASSERT_OPT(n > 0);
+    PUBNUB_ASSERT_OPT(NULL != channel);
+    PUBNUB_ASSERT_OPT(NULL != from);
+    PUBNUB_ASSERT_OPT(NULL != to);
+    PUBNUB_ASSERT_OPT(NULL != cb);
+    PUBNUB_ASSERT_OPT((opt.count > 0) && (opt.count <= 100));
+
+    if (!parse_tt(from, from + strlen(from), &lo)
+        || !parse_tt(to, to + strlen(to), &hi)) {
+        return PNR_FORMAT_ERROR;
+    }
+    if (lo >= hi) {
+        return PNR_OK;
+    }
+    if ((opt.max_in_flight > 0) && (opt.max_in_flight < n)) {
+        n = opt.max_in_flight;
+    }
+    nsegs = (opt.segments > 0) ? opt.segments : 2 * n;
+    if (hi - lo < nsegs) {
+        nsegs = (size_t)(hi - lo);
+    }
+    step       = (hi - lo) / nsegs;
+    timeout_ms = pubnub_transaction_timeout_get(pbs[0]);
+
+    segs = (struct hr_segment*)calloc(1, nsegs * sizeof *segs + n * (sizeof *workers + sizeof *busy));
+    if (NULL == segs) {
+        PUBNUB_LOG_ERROR("Failed to allocate data to fetch %lu history "
+                         "segments\n",
+                         (unsigned long)nsegs);
+        return PNR_REPLY_TOO_BIG;
+    }
+    workers = (struct hr_worker*)(segs + nsegs);
+    busy    = (pubnub_t**)(workers + n);
+    for (i = 0; i < nsegs; ++i) {
+        segs[i].next = lo + step * i;
+        segs[i].last = (i + 1 < nsegs) ? lo + step * (i + 1) : hi;
+    }
+    for (i = 0; i < n; ++i) {
+        workers[i].segment = -1;
+    }
+
+    for (;;) {
+        int idx;
+
+        /* Deliver what we can, in order */
+        while (head < nsegs) {
+            struct hr_segment* seg = &segs[head];
+            char const*        s   = seg->buf;
+            while (s < seg->buf + seg->len) {
+                char const* message = s + strlen(s) + 1;
+                if (!cb(s, message, user_data)) {
+                    rslt = PNR_CANCELLED;
+                    goto cancel;
+                }
+                s = message + strlen(message) + 1;
+            }
+            seg->len = 0;
+            if (!seg->done) {
+                break;
+            }
+            free(seg->buf);
+            seg->buf  = NULL;
+            seg->size = 0;
+            ++head;
+        }
+        if (head == nsegs) {
+            break;
+        }
+
+        /* Start pages on idle workers, segments ahead of the one
+           being delivered only while there's room to keep them */
+        buffered = 0;
+        for (i = head + 1; i < nsegs; ++i) {
+            buffered += segs[i].len;
+        }
+        for (i = 0; i < n; ++i) {
+            struct hr_worker* w = &workers[i];
+            if (w->busy) {
+                continue;
+            }
+            if ((w->segment < 0) && (assigned < nsegs)) {
+                w->segment = (int)assigned++;
+            }
+            if ((w->segment >= 0)
+                && (((size_t)w->segment == head) || (buffered < opt.max_buffered))) {
+                rslt = start_page(pbs[i], channel, &segs[w->segment], opt);
+                if (rslt != PNR_STARTED) {
+                    goto cancel;
+                }
+                rslt    = PNR_OK;
+                w->busy = true;
+            }
+        }
+
+        for (i = 0; i < n; ++i) {
+            busy[i] = workers[i].busy ? pbs[i] : NULL;
+        }
+        idx = pubnub_await_any(busy, n, timeout_ms);
+        if (idx < 0) {
+            rslt = PNR_TIMEOUT;
+            goto cancel;
+        }
+        workers[idx].busy = false;
+        rslt              = pubnub_last_result(pbs[idx]);
+        if (PNR_OK == rslt) {
+            struct hr_segment* seg = &segs[workers[idx].segment];
+            rslt = take_page(pbs[idx], seg, opt.count);
+            if (seg->done) {
+                workers[idx].segment = -1;
+            }
+        }
+        if (rslt != PNR_OK) {
+            PUBNUB_LOG_ERROR("Fetching history segment %d failed: %d('%s')\n",
+                             workers[idx].segment,
+                             rslt,
+                             pubnub_res_2_string(rslt));
+            goto cancel;
+        }
+    }
+
+cancel:
+    for (i = 0; i < n; ++i) {
+        busy[i] = NULL;
+        if (workers[i].busy) {
+            pubnub_cancel(pbs[i]);
+            busy[i] = pbs[i];
+        }
+    }
+    pubnub_await_all(busy, n, timeout_ms);
+    for (i = 0; i < nsegs; ++i) {
+        free(segs[i].buf);
+    }
+    free(segs);
+
+    return rslt;
+}
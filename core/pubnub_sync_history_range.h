@@ -0,0 +1,120 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PUBNUB_SYNC_HISTORY_RANGE
+#define	INC_PUBNUB_SYNC_HISTORY_RANGE
+
+
+#include "pubnub_api_types.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+
+/** @file pubnub_sync_history_range.h
+
+    This module implements fetching the history of a channel over a
+    range of timetokens for the sync interface. The range is split
+    into segments, which are fetched (page by page) concurrently over
+    a (small) pool of contexts, while messages are delivered in
+    timetoken order, oldest first.
+*/
+
+
+/** Options for fetching a history range */
+struct pubnub_history_range_options {
+    /** The maximum number of messages to fetch per page (history
+        transaction). Has to be between 1 and 100. Default is 100.
+     */
+    int count;
+    /** Number of segments the range is split into. If 0, twice the
+        number of contexts used is taken. Default is 0.
+     */
+    unsigned segments;
+    /** The maximum number of history transactions in flight at any
+        time. If 0, or larger than the number of contexts given, the
+        number of contexts given is taken. Default is 0.
+     */
+    unsigned max_in_flight;
+    /** The maximum number of bytes of messages to keep for segments
+        that are fetched ahead of the one being delivered. Once it is
+        reached, no more pages are fetched for those segments until
+        (some of) the kept messages are delivered. It is not a hard
+        limit, as a whole page is kept once fetched. Default is
+        64 KB.
+     */
+    size_t max_buffered;
+};
+
+
+/** This returns the default options for fetching a history range.
+    It's best to always call it to initialize the
+    #pubnub_history_range_options, since it has several parameters.
+ */
+struct pubnub_history_range_options pubnub_history_range_defopts(void);
+
+
+/** Callback for a message fetched by pubnub_history_range().
+
+    @param timetoken The timetoken of the message
+    @param message The message, as a JSON element
+    @param user_data The pointer passed to pubnub_history_range()
+    @return true to continue, false to stop fetching
+ */
+typedef bool (*pubnub_history_range_cb)(char const* timetoken,
+                                         char const* message,
+                                         void*       user_data);
+
+
+/** Fetches the history of the @p channel from timetoken @p from
+    (exclusive) to timetoken @p to (inclusive), using the contexts
+    @p pbs, calling @p cb for each message, in timetoken order, oldest
+    first.
+
+    The range is split in segments of (about) the same length of time.
+    Each context fetches one segment at a time, with as many
+    pubnub_history_ex() transactions as it takes, and the segments are
+    fetched concurrently, awaited by pubnub_await_any(). Messages of
+    segments after the one being delivered are kept until all the
+    messages before them are delivered.
+
+    The contexts have to be initialized (keys, origin, etc.) and must
+    not be in a transaction. They are not used for anything else
+    until this returns, when they are left idle. While awaited, they
+    use non-blocking I/O (see pubnub_await_any()), but their blocking
+    I/O setting is restored, so it is the same after this returns as
+    it was before.
+
+    @par Basic usage
+
+        pubnub_t *pbs[4];
+        struct pubnub_history_range_options opt = pubnub_history_range_defopts();
+        opt.max_buffered = 1024 * 1024;
+        pbresult = pubnub_history_range(pbs, 4, "my_channel", "15000000000000000", "15600000000000000", opt, print_message, NULL);
+
+    @param pbs The contexts to use. Can't be NULL.
+    @param n Number of contexts in @p pbs. Has to be at least 1.
+    @param channel The channel to fetch the history of. Can't be NULL.
+    @param from Timetoken to fetch messages after. Can't be NULL.
+    @param to Timetoken of the last message to fetch. Can't be NULL.
+    @param opt Options for fetching
+    @param cb Callback to call for each message. Can't be NULL.
+    @param user_data Pointer to pass to @p cb
+
+    @retval PNR_OK All messages in the range were delivered
+    @retval PNR_CANCELLED @p cb returned false
+    @retval PNR_FORMAT_ERROR @p from or @p to is not a timetoken, or a
+    reply could not be parsed
+    @retval PNR_TIMEOUT None of the transactions in flight finished
+    within the transaction timeout of the first context
+    @retval other The result of the history transaction that failed
+ */
+enum pubnub_res pubnub_history_range(pubnub_t**                          pbs,
+                                     size_t                              n,
+                                     char const*                         channel,
+                                     char const*                         from,
+                                     char const*                         to,
+                                     struct pubnub_history_range_options opt,
+                                     pubnub_history_range_cb             cb,
+                                     void*                               user_data);
+
+
+#endif /* !defined INC_PUBNUB_SYNC_HISTORY_RANGE */
@@ -0,0 +1,396 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "cgreen/cgreen.h"
+#include "cgreen/mocks.h"
+
+#include "pubnub_internal.h"
+
+#include "core/pubnub_sync_history_range.h"
+#include "core/pubnub_coreapi_ex.h"
+#include "core/pubnub_pubsubapi.h"
+#include "core/pubnub_ntf_sync.h"
+#include "core/pubnub_timers.h"
+#include "core/pubnub_assert.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+
+
+/* A less chatty cgreen :) */
+
+#define attest assert_that
+#define equals is_equal_to
+#define streqs is_equal_to_string
+#define differs is_not_equal_to
+#define strdifs is_not_equal_to_string
+#define ptreqs(val) is_equal_to_contents_of(&(val), sizeof(val))
+#define ptrdifs(val) is_not_equal_to_contents_of(&(val), sizeof(val))
+#define sets(par, val) will_set_contents_of_parameter(par, &(val), sizeof(val))
+#define sets_ex will_set_contents_of_parameter
+#define returns will_return
+
+
+enum { CONTEXTS = 3, MAX_REQUESTS = 100, MAX_DELIVERED = 100 };
+
+static pubnub_t  m_ctx[CONTEXTS];
+static pubnub_t* m_pbs[] = { m_ctx + 0, m_ctx + 1, m_ctx + 2 };
+
+/** The (fake) channel history: timetokens of the messages, oldest
+    first. The message with timetoken `N` is `"mN"`.
+*/
+static unsigned long m_history[32];
+static size_t        m_history_len;
+
+/** Whether the (fake) server returns the message at the start
+    timetoken, too, as if start was inclusive */
+static bool m_start_inclusive;
+
+/** The history transactions started */
+static struct request {
+    int           ctx;
+    unsigned long start;
+    unsigned long end;
+    int           fetched;
+} m_request[MAX_REQUESTS];
+static int m_requests;
+
+/** The (index of the) history transaction that fails, -1 if none */
+static int m_fail_at;
+
+/** The reply to the history transaction of each context, and the
+    index of the element pubnub_get() returns next */
+static char            m_reply[CONTEXTS][2048];
+static int             m_get[CONTEXTS];
+static bool            m_busy[CONTEXTS];
+static enum pubnub_res m_result[CONTEXTS];
+static int             m_cancelled;
+
+/** Whether pubnub_await_any() finishes the transaction of the first
+    busy context, rather than the last */
+static bool m_await_first;
+
+/** Timetokens of the messages delivered to the callback, and after
+    how many to stop (0 - never) */
+static unsigned long m_delivered[MAX_DELIVERED];
+static int           m_delivered_len;
+static int           m_stop_after;
+
+
+static int ctx_index(pubnub_t const* pb)
+{
+    int i = (int)(pb - m_ctx);
+    PUBNUB_ASSERT_OPT((i >= 0) && (i < CONTEXTS));
+    return i;
+}
+
+
+struct pubnub_history_options pubnub_history_defopts(void)
+{
+    struct pubnub_history_options rslt;
+    memset(&rslt, 0, sizeof rslt);
+    rslt.count = 100;
+    return rslt;
+}
+
+
+/** The (fake) server: replies with the messages after `start` up to
+    (and including) `end`, oldest first, at most `count` of them.
+ */
+enum pubnub_res pubnub_history_ex(pubnub_t*                     pb,
+                                  char const*                   channel,
+                                  struct pubnub_history_options opt)
+{
+    int             i   = ctx_index(pb);
+    struct request* req = &m_request[m_requests];
+    char*           p   = m_reply[i];
+    size_t          j;
+
+    attest(channel, streqs("ch"));
+    attest(opt.reverse, equals(true));
+    attest(opt.include_token, equals(true));
+    attest(m_busy[i], equals(false));
+    attest(m_requests, is_less_than(MAX_REQUESTS));
+
+    req->ctx     = i;
+    req->start   = strtoul(opt.start, NULL, 10);
+    req->end     = strtoul(opt.end, NULL, 10);
+    req->fetched = 0;
+    p += sprintf(p, "[");
+    for (j = 0; (j < m_history_len) && (req->fetched < opt.count); ++j) {
+        unsigned long tt = m_history[j];
+        if (((tt > req->start) || (m_start_inclusive && (tt == req->start)))
+            && (tt <= req->end)) {
+            p += sprintf(p,
+                         "%s{\"message\":\"m%lu\",\"timetoken\":%lu}",
+                         (req->fetched > 0) ? "," : "",
+                         tt,
+                         tt);
+            ++req->fetched;
+        }
+    }
+    sprintf(p, "]");
+
+    m_get[i]    = 0;
+    m_busy[i]   = true;
+    m_result[i] = (m_requests == m_fail_at) ? PNR_IO_ERROR : PNR_OK;
+    ++m_requests;
+
+    return PNR_STARTED;
+}
+
+
+char const* pubnub_get(pubnub_t* pb)
+{
+    int i = ctx_index(pb);
+    switch (m_get[i]++) {
+    case 0:
+        return m_reply[i];
+    case 1:
+    case 2:
+        return "0";
+    default:
+        return NULL;
+    }
+}
+
+
+enum pubnub_res pubnub_last_result(pubnub_t* pb)
+{
+    return m_result[ctx_index(pb)];
+}
+
+
+void pubnub_cancel(pubnub_t* pb)
+{
+    m_result[ctx_index(pb)] = PNR_CANCELLED;
+    ++m_cancelled;
+}
+
+
+int pubnub_transaction_timeout_get(pubnub_t* pb)
+{
+    PUBNUB_UNUSED(pb);
+    return 1000;
+}
+
+
+char const* pubnub_res_2_string(enum pubnub_res e)
+{
+    PUBNUB_UNUSED(e);
+    return "";
+}
+
+
+/** Finishes the transaction of the last busy context (unless
+    `m_await_first`), so that segments are fetched out of order */
+int pubnub_await_any(pubnub_t** pbs, size_t n, int timeout_ms)
+{
+    int i;
+    PUBNUB_UNUSED(timeout_ms);
+    for (i = 0; i < (int)n; ++i) {
+        int k = m_await_first ? i : (int)n - 1 - i;
+        if (pbs[k] != NULL) {
+            attest(m_busy[ctx_index(pbs[k])], equals(true));
+            m_busy[ctx_index(pbs[k])] = false;
+            return k;
+        }
+    }
+    return -1;
+}
+
+
+enum pubnub_res pubnub_await_all(pubnub_t** pbs, size_t n, int timeout_ms)
+{
+    size_t i;
+    PUBNUB_UNUSED(timeout_ms);
+    for (i = 0; i < n; ++i) {
+        if (pbs[i] != NULL) {
+            m_busy[ctx_index(pbs[i])] = false;
+        }
+    }
+    return PNR_OK;
+}
+
+
+static bool deliver(char const* timetoken, char const* message, void* user_data)
+{
+    char expected[32];
+    attest(user_data, equals(m_ctx));
+    attest(m_delivered_len, is_less_than(MAX_DELIVERED));
+    m_delivered[m_delivered_len] = strtoul(timetoken, NULL, 10);
+    snprintf(expected, sizeof expected, "\"m%s\"", timetoken);
+    attest(message, streqs(expected));
+    ++m_delivered_len;
+    return (0 == m_stop_after) || (m_delivered_len < m_stop_after);
+}
+
+
+static void set_history(unsigned long const* tts, size_t n)
+{
+    PUBNUB_ASSERT_OPT(n <= sizeof m_history / sizeof m_history[0]);
+    memcpy(m_history, tts, n * sizeof *tts);
+    m_history_len = n;
+}
+
+
+static void attest_delivered(unsigned long const* tts, int n)
+{
+    int i;
+    attest(m_delivered_len, equals(n));
+    for (i = 0; (i < n) && (i < m_delivered_len); ++i) {
+        attest(m_delivered[i], equals(tts[i]));
+    }
+}
+
+
+static void attest_idle(void)
+{
+    int i;
+    for (i = 0; i < CONTEXTS; ++i) {
+        attest(m_busy[i], equals(false));
+    }
+}
+
+
+Describe(pubnub_sync_history_range);
+
+
+BeforeEach(pubnub_sync_history_range) {
+    m_history_len     = 0;
+    m_start_inclusive = false;
+    m_requests        = 0;
+    m_fail_at         = -1;
+    m_cancelled       = 0;
+    m_await_first     = false;
+    m_delivered_len   = 0;
+    m_stop_after      = 0;
+    memset(m_busy, 0, sizeof m_busy);
+}
+
+
+AfterEach(pubnub_sync_history_range) {}
+
+
+Ensure(pubnub_sync_history_range, delivers_all_pages_of_all_segments_in_order) {
+    static unsigned long const history[] = { 5,  10, 12, 14, 15, 17, 19, 21, 23,
+                                             30, 31, 32, 33, 34, 48, 49, 50, 51 };
+    static unsigned long const expected[] = { 12, 14, 15, 17, 19, 21, 23,
+                                              30, 31, 32, 33, 34, 48, 49, 50 };
+    struct pubnub_history_range_options opt = pubnub_history_range_defopts();
+
+    set_history(history, sizeof history / sizeof history[0]);
+    opt.count    = 3;
+    opt.segments = 4;
+    attest(pubnub_history_range(m_pbs, CONTEXTS, "ch", "10", "50", opt, deliver, m_ctx),
+           equals(PNR_OK));
+    attest_delivered(expected, sizeof expected / sizeof expected[0]);
+    attest(m_cancelled, equals(0));
+    attest_idle();
+}
+
+
+Ensure(pubnub_sync_history_range, full_page_is_followed_by_empty_last_page) {
+    static unsigned long const history[] = { 20, 30 };
+    struct pubnub_history_range_options opt = pubnub_history_range_defopts();
+
+    set_history(history, sizeof history / sizeof history[0]);
+    opt.count    = 2;
+    opt.segments = 1;
+    attest(pubnub_history_range(m_pbs, 1, "ch", "10", "50", opt, deliver, m_ctx),
+           equals(PNR_OK));
+    attest_delivered(history, 2);
+    attest(m_requests, equals(2));
+    attest(m_request[0].start, equals(10));
+    attest(m_request[0].end, equals(50));
+    attest(m_request[0].fetched, equals(2));
+    attest(m_request[1].start, equals(30));
+    attest(m_request[1].end, equals(50));
+    attest(m_request[1].fetched, equals(0));
+}
+
+
+Ensure(pubnub_sync_history_range, message_at_boundary_timetoken_is_delivered_once) {
+    static unsigned long const history[] = { 10, 20, 25, 30, 40, 45, 50 };
+    static unsigned long const expected[] = { 20, 25, 30, 40, 45, 50 };
+    struct pubnub_history_range_options opt = pubnub_history_range_defopts();
+
+    /* Segments are (10, 30] and (30, 50], and each page (but the
+       first) starts with the last message of the previous one */
+    set_history(history, sizeof history / sizeof history[0]);
+    m_start_inclusive = true;
+    opt.count         = 2;
+    opt.segments      = 2;
+    attest(pubnub_history_range(m_pbs, 2, "ch", "10", "50", opt, deliver, m_ctx),
+           equals(PNR_OK));
+    attest_delivered(expected, sizeof expected / sizeof expected[0]);
+}
+
+
+Ensure(pubnub_sync_history_range, page_without_new_messages_does_not_loop) {
+    static unsigned long const history[] = { 20, 30 };
+    struct pubnub_history_range_options opt = pubnub_history_range_defopts();
+
+    /* With one message per page, the second page has only the
+       message we already have, so we can't move forward */
+    set_history(history, sizeof history / sizeof history[0]);
+    m_start_inclusive = true;
+    opt.count         = 1;
+    opt.segments      = 1;
+    attest(pubnub_history_range(m_pbs, 1, "ch", "10", "50", opt, deliver, m_ctx),
+           equals(PNR_OK));
+    attest_delivered(history, 1);
+    attest(m_requests, equals(2));
+}
+
+
+Ensure(pubnub_sync_history_range, stops_and_cancels_when_callback_returns_false) {
+    static unsigned long const history[] = { 11, 12, 13, 21, 22, 23, 31, 32, 33 };
+    struct pubnub_history_range_options opt = pubnub_history_range_defopts();
+
+    set_history(history, sizeof history / sizeof history[0]);
+    m_await_first = true;
+    m_stop_after  = 2;
+    opt.count     = 1;
+    opt.segments  = 3;
+    attest(pubnub_history_range(m_pbs, CONTEXTS, "ch", "10", "40", opt, deliver, m_ctx),
+           equals(PNR_CANCELLED));
+    attest_delivered(history, 2);
+    attest(m_cancelled, equals(2));
+    attest_idle();
+}
+
+
+Ensure(pubnub_sync_history_range, failed_page_is_reported) {
+    static unsigned long const history[] = { 11, 12, 13, 21, 22, 23 };
+    struct pubnub_history_range_options opt = pubnub_history_range_defopts();
+
+    set_history(history, sizeof history / sizeof history[0]);
+    m_fail_at    = 2;
+    opt.count    = 1;
+    opt.segments = 2;
+    attest(pubnub_history_range(m_pbs, 2, "ch", "10", "30", opt, deliver, m_ctx),
+           equals(PNR_IO_ERROR));
+    attest_idle();
+}
+
+
+Ensure(pubnub_sync_history_range, invalid_timetoken_is_format_error) {
+    struct pubnub_history_range_options opt = pubnub_history_range_defopts();
+
+    attest(pubnub_history_range(m_pbs, 1, "ch", "1x0", "50", opt, deliver, m_ctx),
+           equals(PNR_FORMAT_ERROR));
+    attest(pubnub_history_range(m_pbs, 1, "ch", "10", "", opt, deliver, m_ctx),
+           equals(PNR_FORMAT_ERROR));
+    attest(m_requests, equals(0));
+}
+
+
+Ensure(pubnub_sync_history_range, empty_range_fetches_nothing) {
+    struct pubnub_history_range_options opt = pubnub_history_range_defopts();
+
+    attest(pubnub_history_range(m_pbs, 1, "ch", "50", "50", opt, deliver, m_ctx),
+           equals(PNR_OK));
+    attest(m_requests, equals(0));
+    attest(m_delivered_len, equals(0));
+}
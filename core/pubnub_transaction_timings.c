@@ -0,0 +1,101 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "pubnub_transaction_timings.h"
+
+#include "pubnub_internal.h"
+#if !PUBNUB_TRANSACTION_TIMINGS
+#error Must define PUBNUB_TRANSACTION_TIMINGS to true (!=0) before compiling this file
+#endif
+#include "pubnub_netcore.h"
+#include "pubnub_assert.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include "posix/monotonic_clock_get_time.h"
+#endif
+
+#include <string.h>
+
+
+/** Returns the current time of a monotonic clock, in microseconds.
+    Never returns 0, as that is used for "not reached".
+ */
+static uint64_t now_usec(void)
+{
+#if defined(_WIN32)
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER        count;
+    if (0 == freq.QuadPart) {
+        QueryPerformanceFrequency(&freq);
+    }
+    QueryPerformanceCounter(&count);
+    return 1 + (uint64_t)(count.QuadPart / freq.QuadPart) * 1000000
+           + (uint64_t)(count.QuadPart % freq.QuadPart) * 1000000 / freq.QuadPart;
+#else
+    struct timespec ts;
+    monotonic_clock_get_time(&ts);
+    return 1 + (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+
+void pbtimings_start(struct pbtimings* t)
+{
+    memset(t->at, 0, sizeof t->at);
+    t->at[pbtpStart] = now_usec();
+}
+
+
+void pbtimings_mark(struct pbtimings* t, enum pbtimings_point point)
+{
+    PUBNUB_ASSERT_OPT(point < pbtpCount);
+    t->at[point] = now_usec();
+    memset(t->at + point + 1, 0, (pbtpCount - point - 1) * sizeof t->at[0]);
+}
+
+
+void pbtimings_mark_once(struct pbtimings* t, enum pbtimings_point point)
+{
+    PUBNUB_ASSERT_OPT(point < pbtpCount);
+    if (0 == t->at[point]) {
+        pbtimings_mark(t, point);
+    }
+}
+
+
+static long since_start(struct pbtimings const* t, enum pbtimings_point point)
+{
+    if ((0 == t->at[point]) || (0 == t->at[pbtpStart])) {
+        return -1;
+    }
+    return (long)(t->at[point] - t->at[pbtpStart]);
+}
+
+
+enum pubnub_res pubnub_last_transaction_timings(pubnub_t* pb,
+                                                struct pubnub_transaction_timings* timings)
+{
+    struct pbtimings const* t;
+
+    PUBNUB_ASSERT(pb_valid_ctx_ptr(pb));
+    PUBNUB_ASSERT_OPT(timings != NULL);
+
+    pubnub_mutex_lock(pb->monitor);
+    if (!pbnc_can_start_transaction(pb)) {
+        pubnub_mutex_unlock(pb->monitor);
+        return PNR_IN_PROGRESS;
+    }
+    t                      = &pb->timings;
+    timings->dns_start     = since_start(t, pbtpDnsStart);
+    timings->dns_end       = since_start(t, pbtpDnsEnd);
+    timings->connect       = since_start(t, pbtpConnect);
+    timings->tls_handshake = since_start(t, pbtpTlsHandshake);
+    timings->request_sent  = since_start(t, pbtpRequestSent);
+    timings->first_byte    = since_start(t, pbtpFirstByte);
+    timings->body_received = since_start(t, pbtpBodyReceived);
+    timings->parsed        = since_start(t, pbtpParsed);
+    timings->outcome       = since_start(t, pbtpOutcome);
+    pubnub_mutex_unlock(pb->monitor);
+
+    return PNR_OK;
+}
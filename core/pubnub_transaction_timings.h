@@ -0,0 +1,73 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PUBNUB_TRANSACTION_TIMINGS
+#define INC_PUBNUB_TRANSACTION_TIMINGS
+
+
+#include "pubnub_api_types.h"
+
+
+/** @file pubnub_transaction_timings.h
+    This is the "Transaction timings" API of the Pubnub client
+    library. It tells where the time of the last transaction on a
+    context went - resolving the origin's address, connecting,
+    sending the request, waiting for the response, receiving and
+    parsing it.
+
+    The timings are recorded (with a monotonic clock) at the
+    boundaries of the phases of the transaction. If support for
+    them is not compiled in (PUBNUB_TRANSACTION_TIMINGS is 0),
+    nothing is recorded, so there is no cost.
+*/
+
+
+/** Timings of (the phases of) a transaction. Each member is the time
+    at which a phase ended (or started, for `dns_start`), in
+    microseconds since the start of the transaction. If a phase did
+    not happen (say, there was no DNS resolution or TCP connect,
+    because a kept-alive connection was used, or the transaction
+    failed before it got to the phase), its member is -1.
+
+    Some platforms resolve the address of the origin while
+    connecting, in which case the DNS time is reported as part of
+    the connect time.
+*/
+struct pubnub_transaction_timings {
+    /** The start of the DNS resolution (and the connection
+     * establishment) */
+    long dns_start;
+    /** The end of the DNS resolution */
+    long dns_end;
+    /** The TCP connection established */
+    long connect;
+    /** The TLS handshake done. If TLS/SSL is not used, -1 */
+    long tls_handshake;
+    /** The (whole) HTTP request sent */
+    long request_sent;
+    /** The first byte of the HTTP response received */
+    long first_byte;
+    /** The (whole) body of the HTTP response received */
+    long body_received;
+    /** The response parsed (and decompressed, if it was compressed) */
+    long parsed;
+    /** The outcome of the transaction reported - for the callback
+        interface, that's when the callback is called */
+    long outcome;
+};
+
+
+/** Gets the timings of the last transaction on the context @p pb.
+
+    You can call this from the callback for the transaction (for
+    the callback interface) or after pubnub_await() (for the sync
+    interface).
+
+    @param pb The context for which to get the timings
+    @param timings The place to put the timings to
+    @return PNR_OK: got the timings, PNR_IN_PROGRESS: a transaction
+    is in progress, its timings are not known yet
+*/
+enum pubnub_res pubnub_last_transaction_timings(pubnub_t* pb,
+                                                struct pubnub_transaction_timings* timings);
+
+
+#endif /* !defined INC_PUBNUB_TRANSACTION_TIMINGS */
@@ -0,0 +1,352 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "core/pbpal.h"
+
+#include "pubnub_internal.h"
+#include "core/pubnub_assert.h"
+#include "core/pubnub_log.h"
+
+#include <string.h>
+
+
+static void buf_setup(pubnub_t* pb)
+{
+    pb->ptr  = (uint8_t*)pb->core.http_buf;
+    pb->left = sizeof pb->core.http_buf / sizeof pb->core.http_buf[0];
+}
+
+
+/** Returns whether this I/O operation on @p pb should "would block".
+    If so configured, every other one does.
+ */
+static bool would_block(pubnub_t* pb)
+{
+    if (pb->pal.options.would_block) {
+        pb->pal.blocked = !pb->pal.blocked;
+        return pb->pal.blocked;
+    }
+    return false;
+}
+
+
+/** Returns how many of the @p n octets to send or receive at once on
+    @p pb, as configured.
+ */
+static size_t fragment(pubnub_t* pb, size_t n)
+{
+    size_t max = pb->pal.options.max_fragment;
+
+    if (0 == max) {
+        return n;
+    }
+    if (pb->pal.options.random_fragments) {
+        /* xorshift32 - we want the same fragments for the same seed on
+           every platform, not good randomness */
+        uint32_t x = pb->pal.random;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        pb->pal.random = x;
+        max            = 1 + x % max;
+    }
+    return (n < max) ? n : max;
+}
+
+
+static struct pbreplay_exchange const* current(pubnub_t const* pb)
+{
+    PUBNUB_ASSERT_OPT(pb->pal.capture != NULL);
+    return &pb->pal.capture->exchange[pb->pal.exchange];
+}
+
+
+/** Checks the @p n octets at @p data that are being sent against the
+    request from the capture.
+ */
+static void check_request(pubnub_t* pb, uint8_t const* data, size_t n)
+{
+    struct pbreplay_exchange const* ex   = current(pb);
+    size_t                          left = ex->request_len - pb->pal.request_ofs;
+
+    if (0 == left) {
+        return;
+    }
+    if (n > left) {
+        n = left;
+    }
+    if (0 == memcmp(ex->request + pb->pal.request_ofs, data, n)) {
+        pb->pal.request_ofs += n;
+    }
+    else {
+        PUBNUB_LOG_WARNING("pb=%p: request doesn't match exchange %lu of "
+                           "'%s' at offset %lu\n",
+                           pb,
+                           (unsigned long)pb->pal.exchange,
+                           pb->pal.capture->name,
+                           (unsigned long)pb->pal.request_ofs);
+        ++pb->pal.stats.mismatches;
+        /* Don't count the same exchange again */
+        pb->pal.request_ofs = ex->request_len;
+    }
+}
+
+
+void pbpal_init(pubnub_t* pb)
+{
+    memset(&pb->pal, 0, sizeof pb->pal);
+    pb->pal.connection = pbreplayClosed;
+    pb->sock_state     = STATE_NONE;
+    buf_setup(pb);
+}
+
+
+void pbpal_replay_attach(pubnub_t*                      pb,
+                         struct pbreplay_capture const* capture,
+                         struct pbreplay_options const* options)
+{
+    PUBNUB_ASSERT_OPT(capture != NULL);
+    PUBNUB_ASSERT_OPT(capture->count > 0);
+    PUBNUB_ASSERT_OPT(options != NULL);
+
+    pb->pal.capture      = capture;
+    pb->pal.exchange     = 0;
+    pb->pal.request_ofs  = 0;
+    pb->pal.response_ofs = 0;
+    pb->pal.options      = *options;
+    pb->pal.random       = (0 == options->seed) ? 1 : options->seed;
+    pb->pal.blocked      = 0;
+    memset(&pb->pal.stats, 0, sizeof pb->pal.stats);
+}
+
+
+struct pbreplay_exchange const* pbpal_replay_exchange(pubnub_t const* pb)
+{
+    return current(pb);
+}
+
+
+void pbpal_replay_next(pubnub_t* pb)
+{
+    PUBNUB_ASSERT_OPT(pb->pal.capture != NULL);
+
+    if (++pb->pal.exchange == pb->pal.capture->count) {
+        /* The capture was recorded from a fresh context, so start the
+           next pass as one, so that the requests match */
+        pb->pal.exchange      = 0;
+        pb->core.timetoken[0] = '0';
+        pb->core.timetoken[1] = '\0';
+    }
+    pb->pal.request_ofs  = 0;
+    pb->pal.response_ofs = 0;
+}
+
+
+struct pbreplay_stats pbpal_replay_stats(pubnub_t const* pb)
+{
+    return pb->pal.stats;
+}
+
+
+enum pbpal_resolv_n_connect_result pbpal_resolv_and_connect(pubnub_t* pb)
+{
+    if (NULL == pb->pal.capture) {
+        return pbpal_connect_failed;
+    }
+    /* A new connection, the exchange is replayed from the start */
+    pb->pal.request_ofs  = 0;
+    pb->pal.response_ofs = 0;
+    ++pb->pal.stats.connects;
+    if (would_block(pb)) {
+        pb->pal.connection = pbreplayConnecting;
+        return pbpal_connect_wouldblock;
+    }
+    pb->pal.connection = pbreplayConnected;
+
+    return pbpal_connect_success;
+}
+
+
+enum pbpal_resolv_n_connect_result pbpal_check_connect(pubnub_t* pb)
+{
+    switch (pb->pal.connection) {
+    case pbreplayConnecting:
+        pb->pal.connection = pbreplayConnected;
+        /*FALLTHRU*/
+    case pbreplayConnected:
+        return pbpal_connect_success;
+    default:
+        return pbpal_connect_failed;
+    }
+}
+
+
+enum pbpal_resolv_n_connect_result pbpal_check_resolv_and_connect(pubnub_t* pb)
+{
+    return pbpal_check_connect(pb);
+}
+
+
+int pbpal_send(pubnub_t* pb, void const* data, size_t n)
+{
+    PUBNUB_ASSERT_INT_OPT(pb->sock_state, ==, STATE_NONE);
+
+    pb->ptr        = (uint8_t*)data;
+    pb->len        = (uint16_t)n;
+    pb->sock_state = STATE_SENDING_DATA;
+    pb->left       = sizeof pb->core.http_buf / sizeof pb->core.http_buf[0];
+
+    return pbpal_send_status(pb);
+}
+
+
+int pbpal_send_str(pubnub_t* pb, char const* s)
+{
+    return pbpal_send(pb, s, strlen(s));
+}
+
+
+int pbpal_send_status(pubnub_t* pb)
+{
+    int    rslt;
+    size_t n;
+
+    if (0 == pb->len) {
+        return 0;
+    }
+
+    PUBNUB_ASSERT_OPT(pb->sock_state == STATE_SENDING_DATA);
+
+    if (pb->pal.connection != pbreplayConnected) {
+        /* Like sending on a socket that the server has closed */
+        rslt = -1;
+    }
+    else if (would_block(pb)) {
+        return +1;
+    }
+    else {
+        n = fragment(pb, pb->len);
+        check_request(pb, pb->ptr, n);
+        ++pb->pal.stats.sends;
+        pb->pal.stats.bytes_sent += n;
+        pb->ptr += n;
+        pb->len -= (unsigned)n;
+        rslt = (0 == pb->len) ? 0 : +1;
+    }
+
+    if (rslt <= 0) {
+        pb->ptr        = (uint8_t*)pb->core.http_buf;
+        pb->unreadlen  = 0;
+        pb->sock_state = STATE_NONE;
+    }
+
+    return rslt;
+}
+
+
+int pbpal_start_read_response(pubnub_t* pb)
+{
+    PUBNUB_ASSERT_INT_OPT(pb->sock_state, ==, STATE_NONE);
+
+    pbhttp_parser_init(&pb->http_parser);
+    pb->sock_state = STATE_READ_RESPONSE;
+
+    return +1;
+}
+
+
+/** Parses the data received but not yet parsed. Returns whether a
+    parsing event was reached.
+ */
+static bool parse_unread(pubnub_t* pb)
+{
+    size_t parsed =
+        pbhttp_parse(&pb->http_parser, (char const*)pb->ptr, pb->unreadlen);
+
+    PUBNUB_ASSERT_OPT(parsed <= pb->unreadlen);
+    pb->ptr += parsed;
+    pb->unreadlen -= (uint16_t)parsed;
+
+    switch (pb->http_parser.event) {
+    case pbhttpEvNone:
+        return false;
+    case pbhttpEvDone:
+    case pbhttpEvError:
+        pb->sock_state = STATE_NONE;
+        break;
+    default:
+        break;
+    }
+    return true;
+}
+
+
+enum pubnub_res pbpal_read_response_status(pubnub_t* pb)
+{
+    PUBNUB_ASSERT_OPT(STATE_READ_RESPONSE == pb->sock_state);
+
+    while (!parse_unread(pb)) {
+        struct pbreplay_exchange const* ex = current(pb);
+        size_t n = ex->response_len - pb->pal.response_ofs;
+
+        if (would_block(pb)) {
+            return PNR_IN_PROGRESS;
+        }
+        if ((0 == n) || (pb->pal.connection != pbreplayConnected)) {
+            /* Like the server closing the connection */
+            pb->sock_state = STATE_NONE;
+            return PNR_TIMEOUT;
+        }
+
+        pb->ptr  = (uint8_t*)pb->core.http_buf;
+        pb->left = sizeof pb->core.http_buf / sizeof pb->core.http_buf[0];
+        if (n > pb->left) {
+            n = pb->left;
+        }
+        n = fragment(pb, n);
+        memcpy(pb->ptr, ex->response + pb->pal.response_ofs, n);
+        pb->pal.response_ofs += n;
+        if (ex->close && (pb->pal.response_ofs == ex->response_len)) {
+            pb->pal.connection = pbreplayPeerClosed;
+        }
+        ++pb->pal.stats.receives;
+        pb->pal.stats.bytes_received += n;
+        pb->unreadlen = (uint16_t)n;
+        pb->left -= (uint16_t)n;
+    }
+
+    return PNR_OK;
+}
+
+
+bool pbpal_closed(pubnub_t* pb)
+{
+    return pb->pal.connection == pbreplayClosed;
+}
+
+
+void pbpal_forget(pubnub_t* pb)
+{
+    PUBNUB_UNUSED(pb);
+}
+
+
+int pbpal_close(pubnub_t* pb)
+{
+    pb->unreadlen      = 0;
+    pb->pal.connection = pbreplayClosed;
+    pb->sock_state     = STATE_NONE;
+
+    return 0;
+}
+
+
+int pbpal_set_blocking_io(pubnub_t* pb)
+{
+    PUBNUB_UNUSED(pb);
+    return 0;
+}
+
+
+void pbpal_free(pubnub_t* pb)
+{
+    PUBNUB_UNUSED(pb);
+}
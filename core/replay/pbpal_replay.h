@@ -0,0 +1,102 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PBPAL_REPLAY
+#define INC_PBPAL_REPLAY
+
+#include "pbreplay_capture.h"
+
+#include "core/pubnub_api_types.h"
+
+#include <stdint.h>
+
+
+/** @file pbpal_replay.h
+
+    A PAL that doesn't do any I/O, but replays a capture of HTTP
+    exchanges (see pbreplay_capture.h) from memory. It's used to run
+    the real netcore and "ccore" code, deterministically, without the
+    noise of the kernel and the network, for profiling and for stress
+    testing the handling of partial reads and writes.
+
+    The data is exchanged in fragments of configurable (maximum)
+    length, which can be pseudo-random, so that the response can be
+    split at any offset - in the middle of the status line, a header,
+    a chunk length or the body. Also, each I/O operation can first
+    "would block", to exercise the re-entering of the netcore FSM.
+
+    The request that the C-core sends is checked against the start of
+    the request in the capture and mismatches are counted.
+ */
+
+
+/** State of the simulated connection */
+enum pbreplay_connection {
+    /** Not connected */
+    pbreplayClosed,
+    /** Connect started, but not finished */
+    pbreplayConnecting,
+    /** Connected */
+    pbreplayConnected,
+    /** The server closed the connection, but the client didn't yet */
+    pbreplayPeerClosed
+};
+
+
+/** Options for replaying */
+struct pbreplay_options {
+    /** Maximum length of a fragment of data sent or received, 0: no
+        limit (other than the size of the buffer) */
+    unsigned max_fragment;
+    /** If true, fragments are of pseudo-random length, between 1 and
+        `max_fragment` */
+    bool random_fragments;
+    /** Seed of the pseudo-random generator (for the same seed, the
+        fragments are always the same) */
+    uint32_t seed;
+    /** If true, each I/O operation first "would block" */
+    bool would_block;
+};
+
+
+/** What was done while replaying */
+struct pbreplay_stats {
+    /** Number of connects (that is, connections established) */
+    unsigned long connects;
+    /** Number of send operations */
+    unsigned long sends;
+    /** Number of receive operations */
+    unsigned long receives;
+    /** Number of octets sent */
+    unsigned long long bytes_sent;
+    /** Number of octets received */
+    unsigned long long bytes_received;
+    /** Number of exchanges where the request sent didn't match the
+        one from the capture */
+    unsigned long mismatches;
+};
+
+
+/** Sets the @p capture to be replayed on the context @p pb, with the
+    given @p options, starting with its first exchange. The context
+    must not have an outstanding transaction.
+ */
+void pbpal_replay_attach(pubnub_t*                      pb,
+                         struct pbreplay_capture const* capture,
+                         struct pbreplay_options const* options);
+
+/** Returns the exchange of the capture that the next (or the current)
+    transaction on the context @p pb will be replayed from.
+ */
+struct pbreplay_exchange const* pbpal_replay_exchange(pubnub_t const* pb);
+
+/** Moves to the next exchange of the capture (after the last, the
+    first one is the next) on the context @p pb. To be called after a
+    transaction is finished. When starting over, the subscribe
+    timetoken is reset, as the capture starts with a fresh context.
+ */
+void pbpal_replay_next(pubnub_t* pb);
+
+/** Returns the statistics of the replay on the context @p pb */
+struct pbreplay_stats pbpal_replay_stats(pubnub_t const* pb);
+
+
+#endif /* !defined INC_PBPAL_REPLAY */
@@ -0,0 +1,326 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "pbreplay_capture.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/** Maximum length of a line in a capture file */
+#define MAX_LINE 64 * 1024
+
+/** Maximum number of arguments on a line (including the keyword) */
+#define MAX_ARGS 4
+
+
+static struct {
+    char const*     name;
+    enum pubnub_res result;
+} const m_results[] = {
+    { "OK", PNR_OK },
+    { "FORMAT_ERROR", PNR_FORMAT_ERROR },
+    { "IO_ERROR", PNR_IO_ERROR },
+    { "HTTP_ERROR", PNR_HTTP_ERROR },
+    { "PUBLISH_FAILED", PNR_PUBLISH_FAILED },
+    { "TIMEOUT", PNR_TIMEOUT },
+};
+
+
+static int hex_digit(char c)
+{
+    if ((c >= '0') && (c <= '9')) {
+        return c - '0';
+    }
+    if ((c >= 'a') && (c <= 'f')) {
+        return c - 'a' + 10;
+    }
+    if ((c >= 'A') && (c <= 'F')) {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+
+/** Splits the @p line to (at most @p max) arguments, in place.
+    Quoted strings are unescaped and their lengths are put to @p len
+    (as they may contain NULs).
+
+    @return Number of arguments, -1 on error
+ */
+static int split_args(char* line, char* arg[], size_t len[], int max)
+{
+    int   n = 0;
+    char* s = line;
+
+    for (;;) {
+        while (isspace((unsigned char)*s)) {
+            ++s;
+        }
+        if ('\0' == *s) {
+            return n;
+        }
+        if (n == max) {
+            return -1;
+        }
+        if ('"' == *s) {
+            char* d = ++s;
+            arg[n]  = d;
+            while (*s != '"') {
+                if ('\0' == *s) {
+                    return -1;
+                }
+                if ('\\' == *s) {
+                    switch (*++s) {
+                    case 'r':
+                        *d++ = '\r';
+                        break;
+                    case 'n':
+                        *d++ = '\n';
+                        break;
+                    case 't':
+                        *d++ = '\t';
+                        break;
+                    case '\\':
+                    case '"':
+                        *d++ = *s;
+                        break;
+                    case 'x': {
+                        int hi = hex_digit(s[1]);
+                        int lo = (hi < 0) ? -1 : hex_digit(s[2]);
+                        if (lo < 0) {
+                            return -1;
+                        }
+                        *d++ = (char)(hi * 16 + lo);
+                        s += 2;
+                        break;
+                    }
+                    default:
+                        return -1;
+                    }
+                    ++s;
+                }
+                else {
+                    *d++ = *s++;
+                }
+            }
+            len[n] = d - arg[n];
+            *d     = '\0';
+            ++s;
+        }
+        else {
+            arg[n] = s;
+            while ((*s != '\0') && !isspace((unsigned char)*s)) {
+                ++s;
+            }
+            len[n] = s - arg[n];
+            if (*s != '\0') {
+                *s++ = '\0';
+            }
+        }
+        ++n;
+    }
+}
+
+
+static char* dup_mem(char const* s, size_t n)
+{
+    char* rslt = (char*)malloc(n + 1);
+    if (rslt != NULL) {
+        memcpy(rslt, s, n);
+        rslt[n] = '\0';
+    }
+    return rslt;
+}
+
+
+static bool append(char** to, size_t* to_len, char const* s, size_t n)
+{
+    char* grown = (char*)realloc(*to, *to_len + n + 1);
+    if (NULL == grown) {
+        return false;
+    }
+    memcpy(grown + *to_len, s, n);
+    *to_len += n;
+    grown[*to_len] = '\0';
+    *to            = grown;
+    return true;
+}
+
+
+/** Handles the `op` line, with @p argc arguments @p arg (the first
+    being "op"), starting a new exchange in @p capture.
+ */
+static bool start_exchange(struct pbreplay_capture* capture, int argc, char* arg[], size_t len[])
+{
+    struct pbreplay_exchange* ex;
+    struct pbreplay_exchange* grown = (struct pbreplay_exchange*)realloc(
+        capture->exchange, (capture->count + 1) * sizeof *capture->exchange);
+    if (NULL == grown) {
+        return false;
+    }
+    capture->exchange = grown;
+    ex                = &grown[capture->count++];
+    memset(ex, 0, sizeof *ex);
+    ex->expected_result   = PNR_OK;
+    ex->expected_messages = -1;
+
+    if (argc < 2) {
+        return false;
+    }
+    if ((0 == strcmp(arg[1], "time")) && (2 == argc)) {
+        ex->op = pbreplayOpTime;
+        return true;
+    }
+    if ((0 == strcmp(arg[1], "publish")) && (4 == argc)) {
+        ex->op      = pbreplayOpPublish;
+        ex->message = dup_mem(arg[3], len[3]);
+        if (NULL == ex->message) {
+            return false;
+        }
+    }
+    else if ((0 == strcmp(arg[1], "subscribe")) && (3 == argc)) {
+        ex->op = pbreplayOpSubscribe;
+    }
+    else if ((0 == strcmp(arg[1], "history")) && (4 == argc)) {
+        ex->op    = pbreplayOpHistory;
+        ex->count = (unsigned)atoi(arg[3]);
+    }
+    else if ((0 == strcmp(arg[1], "here_now")) && (3 == argc)) {
+        ex->op = pbreplayOpHereNow;
+    }
+    else {
+        return false;
+    }
+    ex->channel = dup_mem(arg[2], len[2]);
+
+    return ex->channel != NULL;
+}
+
+
+static bool set_expected(struct pbreplay_exchange* ex, int argc, char* arg[])
+{
+    size_t i;
+
+    if ((argc < 2) || (argc > 3)) {
+        return false;
+    }
+    for (i = 0; i < sizeof m_results / sizeof m_results[0]; ++i) {
+        if (0 == strcmp(arg[1], m_results[i].name)) {
+            break;
+        }
+    }
+    if (i == sizeof m_results / sizeof m_results[0]) {
+        return false;
+    }
+    ex->expected_result = m_results[i].result;
+    if (3 == argc) {
+        ex->expected_messages = atoi(arg[2]);
+    }
+
+    return true;
+}
+
+
+/** Handles one (non-empty, non-comment) @p line of a capture */
+static bool handle_line(struct pbreplay_capture* capture, char* line)
+{
+    char*                     arg[MAX_ARGS];
+    size_t                    len[MAX_ARGS];
+    struct pbreplay_exchange* ex;
+    int                       argc = split_args(line, arg, len, MAX_ARGS);
+
+    if (argc <= 0) {
+        return false;
+    }
+    if (0 == strcmp(arg[0], "op")) {
+        return start_exchange(capture, argc, arg, len);
+    }
+    if (0 == capture->count) {
+        return false;
+    }
+    ex = &capture->exchange[capture->count - 1];
+    if ((0 == strcmp(arg[0], ">")) && (2 == argc)) {
+        return append(&ex->request, &ex->request_len, arg[1], len[1]);
+    }
+    if ((0 == strcmp(arg[0], "<")) && (2 == argc)) {
+        return append(&ex->response, &ex->response_len, arg[1], len[1]);
+    }
+    if ((0 == strcmp(arg[0], "close")) && (1 == argc)) {
+        ex->close = true;
+        return true;
+    }
+    if (0 == strcmp(arg[0], "expect")) {
+        return set_expected(ex, argc, arg);
+    }
+
+    return false;
+}
+
+
+struct pbreplay_capture* pbreplay_capture_read(char const* path)
+{
+    struct pbreplay_capture* capture;
+    char*                    line;
+    unsigned                 line_no = 0;
+    FILE*                    f       = fopen(path, "r");
+
+    if (NULL == f) {
+        fprintf(stderr, "%s: can't open\n", path);
+        return NULL;
+    }
+    capture = (struct pbreplay_capture*)calloc(1, sizeof *capture);
+    line    = (char*)malloc(MAX_LINE);
+    if ((NULL == capture) || (NULL == line)) {
+        fprintf(stderr, "%s: out of memory\n", path);
+        free(capture);
+        free(line);
+        fclose(f);
+        return NULL;
+    }
+    capture->name = dup_mem(path, strlen(path));
+
+    while (fgets(line, MAX_LINE, f) != NULL) {
+        char* s = line;
+        ++line_no;
+        while (isspace((unsigned char)*s)) {
+            ++s;
+        }
+        if (('\0' == *s) || ('#' == *s)) {
+            continue;
+        }
+        if (!handle_line(capture, s)) {
+            fprintf(stderr, "%s:%u: invalid line\n", path, line_no);
+            pbreplay_capture_free(capture);
+            capture = NULL;
+            break;
+        }
+    }
+    free(line);
+    fclose(f);
+
+    if ((capture != NULL) && (0 == capture->count)) {
+        fprintf(stderr, "%s: no exchanges\n", path);
+        pbreplay_capture_free(capture);
+        capture = NULL;
+    }
+
+    return capture;
+}
+
+
+void pbreplay_capture_free(struct pbreplay_capture* capture)
+{
+    size_t i;
+
+    for (i = 0; i < capture->count; ++i) {
+        struct pbreplay_exchange* ex = &capture->exchange[i];
+        free(ex->channel);
+        free(ex->message);
+        free(ex->request);
+        free(ex->response);
+    }
+    free(capture->exchange);
+    free(capture->name);
+    free(capture);
+}
@@ -0,0 +1,112 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PBREPLAY_CAPTURE
+#define INC_PBREPLAY_CAPTURE
+
+#include "core/pubnub_api_types.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+
+/** @file pbreplay_capture.h
+
+    Captures of HTTP exchanges with Pubnub, to be replayed by the
+    in-memory PAL (pbpal_replay.c) through the real C-core code.
+
+    A capture is a text file, read line by line:
+
+    - empty lines and lines starting with `#` are ignored
+    - `op <operation> [argument...]` starts a new exchange, that is
+      started by the given C-core operation (transaction). The
+      operations and their arguments are:
+      - `time`
+      - `publish <channel> <message>`
+      - `subscribe <channel>`
+      - `history <channel> <count>`
+      - `here_now <channel>`
+    - `> "text"`: the request that the C-core is expected to send for
+      the exchange starts with `text`. Usually just the request line,
+      up to the query. May be given more than once, it's concatenated.
+    - `< "text"`: (a part of) the response, as sent by the server,
+      status line and headers included. Given any number of times,
+      it's concatenated.
+    - `close`: the server closes the connection after the response
+      of the exchange (if the response doesn't say so, the C-core
+      will only find out when it tries to use the connection again)
+    - `expect <result> [messages]`: the outcome of the transaction
+      the C-core should report (`OK`, `FORMAT_ERROR`, `IO_ERROR`,
+      `HTTP_ERROR`, `PUBLISH_FAILED`, `TIMEOUT`) and, optionally, the
+      number of messages that pubnub_get() should yield. If not
+      given, `OK` is expected, with any number of messages.
+
+    Arguments are either words (without whitespace), or quoted
+    strings, with C-like escapes: `\r`, `\n`, `\t`, `\\`, `\"` and
+    `\xHH`, so any (binary) content, like a gzipped body, can be
+    written in a capture.
+
+    Exchanges are replayed on a single connection, as long as it's
+    kept alive. So, a sequence of exchanges without a `close` is a
+    keep-alive sequence.
+ */
+
+
+/** Operations that can start an exchange */
+enum pbreplay_op {
+    pbreplayOpTime,
+    pbreplayOpPublish,
+    pbreplayOpSubscribe,
+    pbreplayOpHistory,
+    pbreplayOpHereNow
+};
+
+
+/** One HTTP exchange (request and response) of a capture */
+struct pbreplay_exchange {
+    /** Operation that starts the exchange */
+    enum pbreplay_op op;
+    /** Channel to use in the operation (NULL for `time`) */
+    char* channel;
+    /** Message to publish, for `publish` */
+    char* message;
+    /** Count of messages, for `history` */
+    unsigned count;
+
+    /** The expected start of the request */
+    char*  request;
+    size_t request_len;
+
+    /** The response */
+    char*  response;
+    size_t response_len;
+
+    /** Server closes the connection after the response */
+    bool close;
+
+    /** Expected outcome */
+    enum pubnub_res expected_result;
+    /** Expected number of messages, -1: any */
+    int expected_messages;
+};
+
+
+/** A capture - a sequence of exchanges */
+struct pbreplay_capture {
+    /** The name of the file it was read from */
+    char* name;
+    struct pbreplay_exchange* exchange;
+    size_t                    count;
+};
+
+
+/** Reads a capture from the file @p path. On error, reports it
+    (with the line number) to the standard error.
+
+    @return The capture read, or NULL on error
+ */
+struct pbreplay_capture* pbreplay_capture_read(char const* path);
+
+/** Frees the @p capture, with all its exchanges */
+void pbreplay_capture_free(struct pbreplay_capture* capture);
+
+
+#endif /* !defined INC_PBREPLAY_CAPTURE */
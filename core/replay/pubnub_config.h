@@ -0,0 +1,49 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PUBNUB_CONFIG
+#define      INC_PUBNUB_CONFIG
+
+
+/* This is the configuration for replaying captures with the
+   in-memory PAL. Mostly the same as for POSIX, to profile the same
+   code, but without the modules that are of no use without a real
+   network (proxy, DNS, timings).
+ */
+
+/** Maximum number of PubNub contexts. Not used, as contexts are
+    allocated dynamically. */
+#define PUBNUB_CTX_MAX 2
+
+/** Maximum length of the HTTP buffer. */
+#define PUBNUB_BUF_MAXLEN 32000
+
+/** Set to 0 to use a static buffer and then set its size via
+    #PUBNUB_REPLY_MAXLEN.
+*/
+#define PUBNUB_DYNAMIC_REPLY_BUFFER 1
+
+#if !PUBNUB_DYNAMIC_REPLY_BUFFER
+/** Maximum length of the HTTP reply when using a static buffer. */
+#define PUBNUB_REPLY_MAXLEN 32000
+#endif
+
+/** This is the URL of the Pubnub server. Captures are replayed
+    regardless of it, it's only used in the `Host` header. */
+#define PUBNUB_ORIGIN  "ps.pndsn.com"
+
+/** The duration of the transaction timeout. Not used, as there are
+    no timeouts in sync mode. */
+#define PUBNUB_DEFAULT_TRANSACTION_TIMER    310000
+
+#define PUBNUB_HAVE_SHA1 0
+
+#if !defined(PUBNUB_RECEIVE_GZIP_RESPONSE)
+/** If true (!=0), gzipped responses are accepted (and replayed) */
+#define PUBNUB_RECEIVE_GZIP_RESPONSE 1
+#endif
+
+#define PUBNUB_CRYPTO_API 0
+
+#define PUBNUB_ONLY_PUBSUB_API 0
+
+
+#endif /* !defined INC_PUBNUB_CONFIG */
@@ -0,0 +1,47 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PUBNUB_INTERNAL
+#define INC_PUBNUB_INTERNAL
+
+
+#include "pbpal_replay.h"
+
+
+/** The Pubnub "replay" context - the state of the simulated
+    connection, on which a capture is replayed.
+ */
+struct pubnub_pal {
+    /** The capture being replayed (NULL: none, connecting fails) */
+    struct pbreplay_capture const* capture;
+    /** Index of the current exchange in the capture */
+    size_t exchange;
+    /** How much of the request of the current exchange has been
+        checked against what was sent */
+    size_t request_ofs;
+    /** How much of the response of the current exchange has been
+        "received" */
+    size_t response_ofs;
+    /** State of the connection */
+    enum pbreplay_connection connection;
+    /** How to replay */
+    struct pbreplay_options options;
+    /** State of the pseudo-random generator of fragment lengths */
+    uint32_t random;
+    /** The last I/O operation "would block" (to alternate) */
+    unsigned blocked : 1;
+    /** What was done so far */
+    struct pbreplay_stats stats;
+};
+
+
+/** Blocking I/O can be "set", but is not used by the replay PAL */
+#define PUBNUB_BLOCKING_IO_SETTABLE 1
+
+#define PUBNUB_ORIGIN_SETTABLE 1
+
+#define PUBNUB_TIMERS_API 1
+
+
+#include "core/pubnub_internal_common.h"
+
+
+#endif /* !defined INC_PUBNUB_INTERNAL */
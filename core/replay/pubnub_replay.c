@@ -0,0 +1,247 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "pubnub_internal.h"
+
+#include "pbpal_replay.h"
+#include "pbreplay_capture.h"
+
+#include "core/pubnub_alloc.h"
+#include "core/pubnub_coreapi.h"
+#include "core/pubnub_pubsubapi.h"
+#include "core/pubnub_ntf_sync.h"
+#include "core/pubnub_helper.h"
+
+#include "posix/monotonic_clock_get_time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/** @file pubnub_replay.c
+
+    Runs transactions through the real netcore and "ccore" code,
+    replaying captures with the in-memory PAL (see pbpal_replay.h),
+    to profile the CPU cost of a transaction and stress test the
+    handling of fragmented I/O.
+
+    For each capture given on the command line, a context is created
+    and the exchanges of the capture are replayed in a loop, until the
+    given number of transactions is done (each pass over the capture
+    is like a new session, starting with timetoken 0). The outcome of each
+    transaction is checked against what the capture expects. Results
+    are printed as JSON, the exit code is not 0 if there were any
+    failed checks.
+ */
+
+
+/** How many failures to report (in detail) per capture */
+#define MAX_FAILURES_REPORTED 10
+
+
+static uint64_t now_nsec(void)
+{
+    struct timespec ts;
+    monotonic_clock_get_time(&ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+
+/** Starts the transaction of the exchange @p ex on @p pb and awaits
+    its outcome.
+ */
+static enum pubnub_res run_transaction(pubnub_t* pb, struct pbreplay_exchange const* ex)
+{
+    enum pubnub_res res;
+
+    switch (ex->op) {
+    case pbreplayOpTime:
+        res = pubnub_time(pb);
+        break;
+    case pbreplayOpPublish:
+        res = pubnub_publish(pb, ex->channel, ex->message);
+        break;
+    case pbreplayOpSubscribe:
+        res = pubnub_subscribe(pb, ex->channel, NULL);
+        break;
+    case pbreplayOpHistory:
+        res = pubnub_history(pb, ex->channel, ex->count, false);
+        break;
+    case pbreplayOpHereNow:
+        res = pubnub_here_now(pb, ex->channel, NULL);
+        break;
+    default:
+        return PNR_INTERNAL_ERROR;
+    }
+    if (PNR_STARTED == res) {
+        res = pubnub_await(pb);
+    }
+
+    return res;
+}
+
+
+/** Replays the @p capture for @p transactions transactions, with the
+    given @p options and prints the results (as an element of a JSON
+    array, @p first or not).
+
+    @return Number of failed checks
+ */
+static unsigned long replay(struct pbreplay_capture const* capture,
+                            unsigned long                  transactions,
+                            struct pbreplay_options const* options,
+                            bool                           first)
+{
+    unsigned long         i;
+    unsigned long         failures = 0;
+    unsigned long         messages = 0;
+    unsigned long         mismatches;
+    uint64_t              start;
+    uint64_t              elapsed;
+    struct pbreplay_stats stats;
+    pubnub_t*             pb = pubnub_alloc();
+
+    if (NULL == pb) {
+        fputs("Failed to allocate a context\n", stderr);
+        return 1;
+    }
+    pubnub_init(pb, "demo", "demo");
+    pbpal_replay_attach(pb, capture, options);
+
+    start = now_nsec();
+    for (i = 0; i < transactions; ++i) {
+        struct pbreplay_exchange const* ex = pbpal_replay_exchange(pb);
+        enum pubnub_res                 res;
+        int                             got = 0;
+
+        mismatches = pbpal_replay_stats(pb).mismatches;
+        res        = run_transaction(pb, ex);
+        while (pubnub_get(pb) != NULL) {
+            ++got;
+        }
+        messages += got;
+
+        if ((res != ex->expected_result)
+            || ((ex->expected_messages >= 0) && (got != ex->expected_messages))
+            || (pbpal_replay_stats(pb).mismatches != mismatches)) {
+            if (++failures <= MAX_FAILURES_REPORTED) {
+                fprintf(stderr,
+                        "%s: transaction %lu (exchange %lu): result %d '%s' "
+                        "(expected %d), %d messages (expected %d)%s\n",
+                        capture->name,
+                        i,
+                        (unsigned long)(ex - capture->exchange),
+                        res,
+                        pubnub_res_2_string(res),
+                        ex->expected_result,
+                        got,
+                        ex->expected_messages,
+                        (pbpal_replay_stats(pb).mismatches != mismatches)
+                            ? ", request mismatch"
+                            : "");
+            }
+        }
+        pbpal_replay_next(pb);
+    }
+    elapsed = now_nsec() - start;
+    stats   = pbpal_replay_stats(pb);
+
+    pubnub_cancel(pb);
+    pubnub_await(pb);
+    if (pubnub_free(pb) != 0) {
+        fputs("Failed to free the context\n", stderr);
+    }
+
+    printf("%s\n    {\"capture\": \"%s\", \"transactions\": %lu, "
+           "\"messages\": %lu, \"seconds\": %.3f, "
+           "\"transactions_per_s\": %.0f, \"ns_per_transaction\": %.1f, "
+           "\"connects\": %lu, \"sends\": %lu, \"receives\": %lu, "
+           "\"bytes_sent\": %llu, \"bytes_received\": %llu, "
+           "\"mismatches\": %lu, \"failures\": %lu}",
+           first ? "" : ",",
+           capture->name,
+           transactions,
+           messages,
+           elapsed / 1e9,
+           transactions * 1e9 / (elapsed ? elapsed : 1),
+           (double)elapsed / (transactions ? transactions : 1),
+           stats.connects,
+           stats.sends,
+           stats.receives,
+           stats.bytes_sent,
+           stats.bytes_received,
+           stats.mismatches,
+           failures);
+
+    return failures;
+}
+
+
+static int usage(char const* prog)
+{
+    printf("Usage: %s [-n transactions] [-f max-fragment] [-r] [-s seed] [-b] "
+           "capture...\n"
+           "  -n  How many transactions to run per capture (default: as many "
+           "as there are exchanges in the capture)\n"
+           "  -f  Maximum length of a fragment of data sent/received, "
+           "0: no limit (default: 0)\n"
+           "  -r  Fragments are of pseudo-random length, from 1 to "
+           "max-fragment\n"
+           "  -s  Seed of the pseudo-random fragment lengths (default: 1)\n"
+           "  -b  Each I/O operation first \"would block\"\n",
+           prog);
+    return EXIT_FAILURE;
+}
+
+
+int main(int argc, char* argv[])
+{
+    struct pbreplay_options options;
+    unsigned long           transactions = 0;
+    unsigned long           failures     = 0;
+    bool                    first        = true;
+    int                     i;
+
+    memset(&options, 0, sizeof options);
+    options.seed = 1;
+    for (i = 1; (i < argc) && ('-' == argv[i][0]); ++i) {
+        if ((0 == strcmp(argv[i], "-n")) && (i + 1 < argc)) {
+            transactions = strtoul(argv[++i], NULL, 10);
+        }
+        else if ((0 == strcmp(argv[i], "-f")) && (i + 1 < argc)) {
+            options.max_fragment = (unsigned)atoi(argv[++i]);
+        }
+        else if (0 == strcmp(argv[i], "-r")) {
+            options.random_fragments = true;
+        }
+        else if ((0 == strcmp(argv[i], "-s")) && (i + 1 < argc)) {
+            options.seed = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else if (0 == strcmp(argv[i], "-b")) {
+            options.would_block = true;
+        }
+        else {
+            return usage(argv[0]);
+        }
+    }
+    if (i == argc) {
+        return usage(argv[0]);
+    }
+
+    fputs("[", stdout);
+    for (; i < argc; ++i) {
+        struct pbreplay_capture* capture = pbreplay_capture_read(argv[i]);
+        if (NULL == capture) {
+            ++failures;
+            continue;
+        }
+        failures += replay(capture,
+                           transactions ? transactions : capture->count,
+                           &options,
+                           first);
+        first = false;
+        pbreplay_capture_free(capture);
+    }
+    puts("\n]");
+
+    return (0 == failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
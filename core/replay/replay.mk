@@ -0,0 +1,38 @@
+SOURCEFILES = ../pubnub_pubsubapi.c ../pubnub_coreapi.c ../pubnub_ccore_pubsub.c ../pubnub_ccore.c ../pubnub_netcore.c ../pbhttp_parser.c ../pubnub_alloc_std.c ../pubnub_assert_std.c ../pubnub_json_parse.c ../pubnub_helper.c ../pubnub_ntf_sync.c ../../lib/miniz/miniz_tinfl.c ../pbgzip_decompress.c pbpal_replay.c pbreplay_capture.c pubnub_version_replay.c
+
+OS := $(shell uname)
+ifeq ($(OS),Darwin)
+SOURCEFILES += ../../posix/monotonic_clock_get_time_darwin.c
+LDLIBS=
+else
+SOURCEFILES += ../../posix/monotonic_clock_get_time_posix.c
+LDLIBS=-lrt
+endif
+
+CFLAGS = -g -O2 -Wall -D PUBNUB_LOG_LEVEL=PUBNUB_LOG_LEVEL_NONE
+
+INCLUDES=-I. -I../..
+
+CAPTURES = captures/keep_alive.pnr captures/chunked.pnr captures/gzip.pnr captures/connection_close.pnr
+
+all: pubnub_replay
+
+pubnub_replay: $(SOURCEFILES) pubnub_replay.c
+	$(CC) -o $@ $(CFLAGS) $(INCLUDES) $(SOURCEFILES) pubnub_replay.c $(LDLIBS)
+
+# Replays the captures with all kinds of fragmentation, failing on
+# any unexpected outcome
+test: pubnub_replay
+	./pubnub_replay $(CAPTURES)
+	./pubnub_replay -f 1 $(CAPTURES)
+	./pubnub_replay -n 10000 -f 7 -r -s 42 $(CAPTURES)
+	./pubnub_replay -n 10000 -f 64 -r -s 4711 -b $(CAPTURES)
+
+# Replays the captures a million times each, to measure the CPU cost
+# of transactions
+bench: pubnub_replay
+	./pubnub_replay -n 1000000 $(CAPTURES)
+
+
+clean:
+	rm pubnub_replay
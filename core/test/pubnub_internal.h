@@ -6,11 +6,13 @@
 #include <winsock2.h>
 #include <ws2tcpip.h>
 typedef SOCKET pb_socket_t;
+#define SOCKET_INVALID INVALID_SOCKET
 #else
 #include <unistd.h>
 #include <sys/socket.h>
 #include <netdb.h>
 typedef int pb_socket_t;
+#define SOCKET_INVALID -1
 #endif
 
 /** The Pubnub POSIX context */
@@ -1,4 +1,4 @@
-SOURCEFILES = ../core/pubnub_pubsubapi.c ../core/pubnub_coreapi.c ../core/pubnub_ccore_pubsub.c ../core/pubnub_ccore.c ../core/pubnub_netcore.c  ../openssl/pbpal_openssl.c ../openssl/pbpal_resolv_and_connect_openssl.c  ../openssl/pbpal_add_system_certs_posix.c ../core/pubnub_alloc_std.c ../core/pubnub_assert_std.c ../core/pubnub_generate_uuid.c ../core/pubnub_blocking_io.c ../posix/posix_socket_blocking_io.c ../core/pubnub_free_with_timeout_std.c ../core/pubnub_timers.c ../core/pubnub_json_parse.c ../lib/md5/md5.c ../lib/base64/pbbase64.c ../core/pubnub_helper.c  ../openssl/pubnub_version_openssl.c ../posix/pubnub_generate_uuid_posix.c ../openssl/pbpal_openssl_blocking_io.c ../core/pubnub_crypto.c ../core/pubnub_coreapi_ex.c ../openssl/pbaes256.c
+SOURCEFILES = ../core/pubnub_pubsubapi.c ../core/pubnub_coreapi.c ../core/pubnub_ccore_pubsub.c ../core/pubnub_ccore.c ../core/pubnub_netcore.c ../core/pbhttp_parser.c  ../openssl/pbpal_openssl.c ../openssl/pbpal_resolv_and_connect_openssl.c ../openssl/pbpal_ssl_session_cache.c  ../openssl/pbpal_add_system_certs_posix.c ../core/pubnub_alloc_std.c ../core/pubnub_assert_std.c ../core/pubnub_generate_uuid.c ../core/pubnub_blocking_io.c ../posix/posix_socket_blocking_io.c ../core/pubnub_free_with_timeout_std.c ../core/pubnub_timers.c ../core/pubnub_json_parse.c ../lib/md5/md5.c ../lib/base64/pbbase64.c ../core/pubnub_helper.c  ../openssl/pubnub_version_openssl.c ../posix/pubnub_generate_uuid_posix.c ../openssl/pbpal_openssl_blocking_io.c ../core/pubnub_crypto.c ../core/pubnub_coreapi_ex.c ../openssl/pbaes256.c
 
 ifndef USE_PROXY
 USE_PROXY = 1
@@ -12,6 +12,22 @@ ifndef RECEIVE_GZIP_RESPONSE
 RECEIVE_GZIP_RESPONSE = 1
 endif
 
+ifndef STREAMING_SUBSCRIBE
+STREAMING_SUBSCRIBE = 1
+endif
+
+ifndef TRANSACTION_TIMINGS
+TRANSACTION_TIMINGS = 1
+endif
+
+ifndef METRICS
+METRICS = 1
+endif
+
+ifndef LOG_ASYNC
+LOG_ASYNC = 0
+endif
+
 ifeq ($(USE_PROXY), 1)
 SOURCEFILES += ../core/pubnub_proxy.c ../core/pubnub_proxy_core.c ../core/pbhttp_digest.c ../core/pbntlm_core.c ../core/pbntlm_packer_std.c
 endif
@@ -26,6 +42,26 @@ SOURCEFILES += ../lib/miniz/miniz_tinfl.c ../core/pbgzip_decompress.c
 OBJFILES += miniz_tinfl.o pbgzip_decompress.o
 endif
 
+ifeq ($(STREAMING_SUBSCRIBE), 1)
+SOURCEFILES += ../core/pubnub_streaming_subscribe.c
+OBJFILES += pubnub_streaming_subscribe.o
+endif
+
+ifeq ($(TRANSACTION_TIMINGS), 1)
+SOURCEFILES += ../core/pubnub_transaction_timings.c
+OBJFILES += pubnub_transaction_timings.o
+endif
+
+ifeq ($(METRICS), 1)
+SOURCEFILES += ../core/pubnub_metrics.c
+OBJFILES += pubnub_metrics.o
+endif
+
+ifeq ($(LOG_ASYNC), 1)
+SOURCEFILES += ../core/pubnub_log_async.c ../posix/pubnub_log_async_posix.c
+OBJFILES += pubnub_log_async.o pubnub_log_async_posix.o
+endif
+
 OS := $(shell uname)
 ifeq ($(OS),Darwin)
 SOURCEFILES += ../posix/monotonic_clock_get_time_darwin.c
@@ -35,7 +71,7 @@ SOURCEFILES += ../posix/monotonic_clock_get_time_posix.c
 LDLIBS=-lrt -lpthread -lssl -lcrypto
 endif
 
-CFLAGS =-g -I .. -I . -I ../openssl -Wall -D PUBNUB_THREADSAFE
+CFLAGS =-g -I .. -I . -I ../openssl -Wall -D PUBNUB_THREADSAFE -D PUBNUB_TRANSACTION_TIMINGS=$(TRANSACTION_TIMINGS) -D PUBNUB_METRICS=$(METRICS) -D PUBNUB_LOG_ASYNC=$(LOG_ASYNC)
 # -g enables debugging, remove to get a smaller executable
 
 all: openssl/pubnub_sync_sample openssl/pubnub_callback_sample openssl/pubnub_callback_cpp11_sample openssl/cancel_subscribe_sync_sample openssl/subscribe_publish_callback_sample openssl/futres_nesting_sync openssl/futres_nesting_callback openssl/futres_nesting_callback_cpp11
@@ -16,12 +16,16 @@ extern "C" {
 #include "core/pubnub_timers.h"
 #include "core/pubnub_helper.h"
 #include "core/pubnub_free_with_timeout.h"
+#include "core/pubnub_channel_set.h"
 #if PUBNUB_PROXY_API
 #include "core/pubnub_proxy.h"
 #endif
 #if PUBNUB_CRYPTO_API
 #include "core/pubnub_crypto.h"
 #endif
+#if PUBNUB_TRANSACTION_TIMINGS
+#include "core/pubnub_transaction_timings.h"
+#endif
 #if PUBNUB_USE_EXTERN_C
 }
 #endif
@@ -29,6 +33,7 @@ extern "C" {
 
 #include <string>
 #include <vector>
+#include <utility>
 
 #if __cplusplus >= 201103L
 #include <chrono>
@@ -191,6 +196,98 @@ public:
 };
 
 
+/** A wrapper class for a channel set, a large set of channels,
+    split in shards, each short enough to subscribe to on one
+    context. Something like:
+
+        channel_set chans;
+        chans.add(names);
+        for (size_t i = 0; i < chans.shards(); ++i) {
+            pn[i].subscribe(chans.shard(i));
+        }
+
+    To use it, build `core/pubnub_channel_set.c` in, it is not in
+    the sample makefiles.
+    @see pubnub_channel_set_create
+*/
+class channel_set {
+    pubnub_channel_set_t* d_cs;
+
+    // channel set is not copyable
+    channel_set(channel_set const&);
+    channel_set& operator=(channel_set const&);
+
+public:
+    /// Creates the set, with shards at most @p max_shard_len long,
+    /// or the default length, if 0
+    explicit channel_set(size_t max_shard_len = 0)
+    {
+        pubnub_channel_set_options opt = pubnub_channel_set_defopts();
+        if (max_shard_len > 0) {
+            opt.max_shard_len = max_shard_len;
+        }
+        d_cs = pubnub_channel_set_create(opt);
+        if (0 == d_cs) {
+            throw std::bad_alloc();
+        }
+    }
+    ~channel_set() { pubnub_channel_set_destroy(d_cs); }
+
+    /// @see pubnub_channel_set_add
+    pubnub_res add(std::string const& channel)
+    {
+        return pubnub_channel_set_add(d_cs, channel.c_str());
+    }
+    /// Adds all the @p channel, stops on the first one that fails
+    pubnub_res add(std::vector<std::string> const& channel)
+    {
+        for (std::vector<std::string>::const_iterator i = channel.begin();
+             i != channel.end();
+             ++i) {
+            pubnub_res rslt = add(*i);
+            if (rslt != PNR_OK) {
+                return rslt;
+            }
+        }
+        return PNR_OK;
+    }
+    /// @see pubnub_channel_set_remove
+    pubnub_res remove(std::string const& channel)
+    {
+        return pubnub_channel_set_remove(d_cs, channel.c_str());
+    }
+    /// Removes all the @p channel, stops on the first one that fails
+    pubnub_res remove(std::vector<std::string> const& channel)
+    {
+        for (std::vector<std::string>::const_iterator i = channel.begin();
+             i != channel.end();
+             ++i) {
+            pubnub_res rslt = remove(*i);
+            if (rslt != PNR_OK) {
+                return rslt;
+            }
+        }
+        return PNR_OK;
+    }
+    /// @see pubnub_channel_set_count
+    size_t count() const { return pubnub_channel_set_count(d_cs); }
+    /// @see pubnub_channel_set_shards
+    size_t shards() const { return pubnub_channel_set_shards(d_cs); }
+    /// Returns the channels of shard @p i, comma-separated and
+    /// URL-encoded, or an empty string if there is no such shard
+    /// @see pubnub_channel_set_shard
+    std::string shard(size_t i)
+    {
+        char const* list = pubnub_channel_set_shard(d_cs, i);
+        return (0 == list) ? "" : list;
+    }
+    /// @see pubnub_channel_set_timetoken
+    std::string timetoken() { return pubnub_channel_set_timetoken(d_cs); }
+    /// The (C) channel set, for pubnub_channel_set_fetch()
+    pubnub_channel_set_t* data() { return d_cs; }
+};
+
+
 /** A wrapper class for publish options, enabling a nicer
     usage. Something like:
 
@@ -467,6 +564,42 @@ public:
         }
         return all;
     }
+    /// Returns the all the remaining messages from the context,
+    /// decrypted with the crypto @p handle, in batches, possibly
+    /// in parallel, on the thread @p pool, with @p parallel_for.
+    /// For each message, the outcome of decrypting it is returned
+    /// in the same place in the vector as the message is in the
+    /// reply, with the decrypted message (empty if not `PNR_OK`).
+    /// @see pubnub_get_all_decrypted
+    std::vector<std::pair<pubnub_res, std::string> > get_all_decrypted(
+        pubnub_crypto_handle_t const* handle,
+        pubnub_parallel_for_t         parallel_for = 0,
+        void*                         pool         = 0) const
+    {
+        std::vector<std::pair<pubnub_res, std::string> > all;
+        std::vector<pubnub_decrypted_msg>                msgs(256);
+        // Big enough for all the messages, so any one fits
+        std::vector<uint8_t> arena(
+            pubnub_get_all_decrypted_arena_size(d_pb) + 1);
+        for (;;) {
+            pubnub_bymebl_t mebl;
+            mebl.ptr  = &arena[0];
+            mebl.size = arena.size();
+            size_t const n = pubnub_get_all_decrypted(
+                d_pb, handle, &msgs[0], msgs.size(), mebl, parallel_for, pool);
+            if (0 == n) {
+                break;
+            }
+            for (size_t i = 0; i < n; ++i) {
+                all.push_back(std::make_pair(
+                    msgs[i].result,
+                    (PNR_OK == msgs[i].result)
+                        ? std::string(msgs[i].ptr, msgs[i].size)
+                        : std::string()));
+            }
+        }
+        return all;
+    }
 #endif
 
     /// Returns the next channel string from the context.
@@ -770,6 +903,16 @@ public:
     /// @see pubnub_last_http_code
     int last_http_code() const { return pubnub_last_http_code(d_pb); }
 
+#if PUBNUB_TRANSACTION_TIMINGS
+    /// Gets the timings of the phases of the last transaction
+    /// into @p timings.
+    /// @see pubnub_last_transaction_timings
+    pubnub_res last_transaction_timings(pubnub_transaction_timings& timings) const
+    {
+        return pubnub_last_transaction_timings(d_pb, &timings);
+    }
+#endif
+
     /// Return the string of the last publish transaction.
     /// @see pubnub_last_publish_result
     std::string last_publish_result() const
@@ -827,6 +970,11 @@ public:
     /// @see pubnub_dont_use_http_keep_alive
     void dont_use_http_keep_alive() { pubnub_dont_use_http_keep_alive(d_pb); }
 
+    /// Starts a transaction to connect to the origin in advance,
+    /// so that the next transaction doesn't have to
+    /// @see pubnub_preconnect
+    futres warm_up() { return doit(pubnub_preconnect(d_pb)); }
+
 #if PUBNUB_PROXY_API
     /// Manually set a proxy to use
     /// @see pubnub_set_proxy_manual
@@ -25,6 +25,10 @@
     */
 #define socket_timed_out() 0
 
+/** FreeRTOS+TCP returns 0 on timeout, too, so we can't tell that the
+    peer closed the connection */
+#define socket_closed_by_peer(result) 0
+
 /** Although the FreeRTOS+TCP requires TCP/IP initialization,
     we expect the user to do it elsewhere, to avoid coupling
     the TCP/IP stack initiliazation to Pubnub, as TCP/IP may
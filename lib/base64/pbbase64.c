@@ -7,6 +7,404 @@
 #include <string.h>
 
 
+/** If SIMD (SSSE3/AVX2) code is to be used for Base64 encoding and
+    decoding, when available on the CPU we're running on (checked at
+    runtime). Set to 0 to always use the plain C code.
+ */
+#if !defined PBBASE64_SIMD
+#if (defined(__GNUC__) && ((__GNUC__ >= 5) || defined(__clang__))          \
+     && (defined(__x86_64__) || defined(__i386__)))                            \
+    || (defined(_MSC_VER) && (_MSC_VER >= 1800)                                \
+        && (defined(_M_X64) || defined(_M_IX86)))
+#define PBBASE64_SIMD 1
+#else
+#define PBBASE64_SIMD 0
+#endif
+#endif /* !defined PBBASE64_SIMD */
+
+
+#if PBBASE64_SIMD
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define PBBASE64_TARGET(isa)
+#else
+#define PBBASE64_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+enum simd_level { simdUnknown, simdNone, simdSSSE3, simdAVX2 };
+
+/** The SIMD level of the CPU, detected on first use. Several threads
+    may detect it at the same time, but they all get the same result,
+    so that's harmless.
+ */
+static enum simd_level m_simd_level;
+
+
+static enum simd_level simd_level(void)
+{
+    if (simdUnknown == m_simd_level) {
+        enum simd_level level = simdNone;
+#if defined(_MSC_VER)
+        int regs[4];
+        __cpuid(regs, 1);
+        if (regs[2] & (1 << 9)) {
+            level = simdSSSE3;
+        }
+        /* AVX2 needs the OS to save the YMM registers, too */
+        if ((regs[2] & (1 << 27)) && (regs[2] & (1 << 28))
+            && (6 == (_xgetbv(0) & 6))) {
+            __cpuidex(regs, 7, 0);
+            if (regs[1] & (1 << 5)) {
+                level = simdAVX2;
+            }
+        }
+#else
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            level = simdAVX2;
+        }
+        else if (__builtin_cpu_supports("ssse3")) {
+            level = simdSSSE3;
+        }
+#endif
+        m_simd_level = level;
+    }
+    return m_simd_level;
+}
+
+
+/** The last two characters of the alphabet have to be other than
+    letters and digits, as they are handled the same way as those
+    (first 62) characters.
+ */
+static bool simd_alphabet(char const* alphabet)
+{
+    return (NULL == strchr(COMMON_BASE64_ABC, alphabet[62]))
+           && (NULL == strchr(COMMON_BASE64_ABC, alphabet[63]));
+}
+
+
+/* Encoding is done as described by Wojciech Muła in "Base64 encoding
+   with SIMD instructions": each 3 octets are spread to 4 bytes, split
+   to 6-bit indices, which are then mapped to characters of the
+   alphabet by adding an offset looked up by the range of the index.
+   Decoding is the reverse, with characters checked to be valid, so
+   that anything else (like the padding) is left to the plain C code.
+ */
+
+/** Returns the offsets to add to an index to get its character, by
+    the index range: 26-51, 52-61, 62, 63, 0-25.
+ */
+PBBASE64_TARGET("ssse3")
+static __m128i enc_offsets_ssse3(char const* alphabet)
+{
+    return _mm_setr_epi8('a' - 26,
+                         '0' - 52,
+                         '0' - 52,
+                         '0' - 52,
+                         '0' - 52,
+                         '0' - 52,
+                         '0' - 52,
+                         '0' - 52,
+                         '0' - 52,
+                         '0' - 52,
+                         '0' - 52,
+                         (char)(alphabet[62] - 62),
+                         (char)(alphabet[63] - 63),
+                         'A',
+                         0,
+                         0);
+}
+
+
+PBBASE64_TARGET("ssse3")
+static __m128i enc_indices_ssse3(__m128i in)
+{
+    __m128i t0, t1, t2, t3;
+
+    in = _mm_shuffle_epi8(
+        in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+
+    return _mm_or_si128(t1, t3);
+}
+
+
+PBBASE64_TARGET("ssse3")
+static __m128i enc_chars_ssse3(__m128i indices, __m128i offsets)
+{
+    __m128i r    = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+
+    r = _mm_or_si128(r, _mm_and_si128(less, _mm_set1_epi8(13)));
+
+    return _mm_add_epi8(_mm_shuffle_epi8(offsets, r), indices);
+}
+
+
+PBBASE64_TARGET("avx2")
+static size_t encode_avx2(uint8_t const* in,
+                          size_t         length,
+                          char*          out,
+                          char const*    alphabet)
+{
+    size_t        i;
+    __m256i const offsets =
+        _mm256_broadcastsi128_si256(enc_offsets_ssse3(alphabet));
+    __m256i const shuffle = _mm256_setr_epi8(
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+
+    /* Reading 16 octets for the 12 in the upper lane */
+    for (i = 0; i + 28 <= length; i += 24) {
+        __m256i v = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((__m128i const*)(in + i))),
+            _mm_loadu_si128((__m128i const*)(in + i + 12)),
+            1);
+        __m256i t0, t1, t2, t3, r, less;
+
+        v  = _mm256_shuffle_epi8(v, shuffle);
+        t0 = _mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00));
+        t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        t2 = _mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0));
+        t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        v  = _mm256_or_si256(t1, t3);
+
+        r    = _mm256_subs_epu8(v, _mm256_set1_epi8(51));
+        less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), v);
+        r = _mm256_or_si256(r, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+        v = _mm256_add_epi8(_mm256_shuffle_epi8(offsets, r), v);
+
+        _mm256_storeu_si256((__m256i*)(out + i / 3 * 4), v);
+    }
+
+    return i;
+}
+
+
+PBBASE64_TARGET("ssse3")
+static size_t encode_ssse3(uint8_t const* in,
+                           size_t         length,
+                           char*          out,
+                           char const*    alphabet)
+{
+    size_t        i;
+    __m128i const offsets = enc_offsets_ssse3(alphabet);
+
+    /* Reading 16 octets for 12 */
+    for (i = 0; i + 16 <= length; i += 12) {
+        __m128i v = _mm_loadu_si128((__m128i const*)(in + i));
+        v         = enc_chars_ssse3(enc_indices_ssse3(v), offsets);
+        _mm_storeu_si128((__m128i*)(out + i / 3 * 4), v);
+    }
+
+    return i;
+}
+
+
+/** Encodes as much of the @p length octets at @p in as it can to
+    @p out, 12 octets at a time (with SSSE3) or 24 (with AVX2). Returns
+    how many octets were encoded, that is, the @p out characters
+    written are 4/3 of that.
+ */
+static size_t encode_simd(uint8_t const* in,
+                          size_t         length,
+                          char*          out,
+                          char const*    alphabet)
+{
+    size_t          done = 0;
+    enum simd_level level;
+
+    if ((length < 16) || !simd_alphabet(alphabet)) {
+        return 0;
+    }
+    level = simd_level();
+    if (simdNone == level) {
+        return 0;
+    }
+    if (simdAVX2 == level) {
+        done = encode_avx2(in, length, out, alphabet);
+    }
+    return done
+           + encode_ssse3(
+               in + done, length - done, out + done / 3 * 4, alphabet);
+}
+
+
+/** Maps the characters @p c to their 6-bit values, in @p v. Returns
+    the mask of the characters that are valid (in the alphabet).
+ */
+PBBASE64_TARGET("ssse3")
+static int dec_values_ssse3(__m128i c, char const* alphabet, __m128i* v)
+{
+    __m128i const upper =
+        _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('A' - 1)),
+                      _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), c));
+    __m128i const lower =
+        _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('a' - 1)),
+                      _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), c));
+    __m128i const digit =
+        _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+                      _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), c));
+    __m128i const c62 = _mm_cmpeq_epi8(c, _mm_set1_epi8(alphabet[62]));
+    __m128i const c63 = _mm_cmpeq_epi8(c, _mm_set1_epi8(alphabet[63]));
+    __m128i       offset;
+    __m128i       valid;
+
+    offset = _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-'A')),
+                          _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+    offset =
+        _mm_or_si128(offset, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+    offset = _mm_or_si128(
+        offset, _mm_and_si128(c62, _mm_set1_epi8((char)(62 - alphabet[62]))));
+    offset = _mm_or_si128(
+        offset, _mm_and_si128(c63, _mm_set1_epi8((char)(63 - alphabet[63]))));
+    *v = _mm_add_epi8(c, offset);
+
+    valid = _mm_or_si128(_mm_or_si128(upper, lower),
+                         _mm_or_si128(digit, _mm_or_si128(c62, c63)));
+
+    return _mm_movemask_epi8(valid);
+}
+
+
+/** Packs the 6-bit values @p v to 12 octets (in the low 12 bytes). */
+PBBASE64_TARGET("ssse3")
+static __m128i dec_pack_ssse3(__m128i v)
+{
+    v = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+    v = _mm_madd_epi16(v, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(
+        v,
+        _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+
+PBBASE64_TARGET("avx2")
+static size_t decode_avx2(char const* s,
+                          size_t      n,
+                          uint8_t*    out,
+                          char const* alphabet)
+{
+    size_t        i;
+    __m256i const pack_shuffle = _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    __m256i const c62_char = _mm256_set1_epi8(alphabet[62]);
+    __m256i const c63_char = _mm256_set1_epi8(alphabet[63]);
+    __m256i const c62_offs = _mm256_set1_epi8((char)(62 - alphabet[62]));
+    __m256i const c63_offs = _mm256_set1_epi8((char)(63 - alphabet[63]));
+
+    for (i = 0; i + 32 <= n; i += 32) {
+        __m256i const c     = _mm256_loadu_si256((__m256i const*)(s + i));
+        __m256i const upper = _mm256_and_si256(
+            _mm256_cmpgt_epi8(c, _mm256_set1_epi8('A' - 1)),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), c));
+        __m256i const lower = _mm256_and_si256(
+            _mm256_cmpgt_epi8(c, _mm256_set1_epi8('a' - 1)),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), c));
+        __m256i const digit = _mm256_and_si256(
+            _mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+        __m256i const c62 = _mm256_cmpeq_epi8(c, c62_char);
+        __m256i const c63 = _mm256_cmpeq_epi8(c, c63_char);
+        __m256i       v;
+        uint8_t       packed[32];
+
+        v = _mm256_or_si256(_mm256_or_si256(upper, lower),
+                            _mm256_or_si256(digit, _mm256_or_si256(c62, c63)));
+        if (-1 != _mm256_movemask_epi8(v)) {
+            break;
+        }
+        v = _mm256_or_si256(_mm256_and_si256(upper, _mm256_set1_epi8(-'A')),
+                            _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a')));
+        v = _mm256_or_si256(
+            v, _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')));
+        v = _mm256_or_si256(v, _mm256_and_si256(c62, c62_offs));
+        v = _mm256_or_si256(v, _mm256_and_si256(c63, c63_offs));
+        v = _mm256_add_epi8(c, v);
+
+        v = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+        v = _mm256_madd_epi16(v, _mm256_set1_epi32(0x00011000));
+        v = _mm256_shuffle_epi8(v, pack_shuffle);
+        v = _mm256_permutevar8x32_epi32(
+            v, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        /* Through a temporary, as the output may not have room for
+           the (unused) last 8 bytes */
+        _mm256_storeu_si256((__m256i*)packed, v);
+        memcpy(out + i / 4 * 3, packed, 24);
+    }
+
+    return i;
+}
+
+
+PBBASE64_TARGET("ssse3")
+static size_t decode_ssse3(char const* s,
+                           size_t      n,
+                           uint8_t*    out,
+                           char const* alphabet)
+{
+    size_t i;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((__m128i const*)(s + i));
+        uint8_t packed[16];
+
+        if (0xFFFF != dec_values_ssse3(v, alphabet, &v)) {
+            break;
+        }
+        _mm_storeu_si128((__m128i*)packed, dec_pack_ssse3(v));
+        memcpy(out + i / 4 * 3, packed, 12);
+    }
+
+    return i;
+}
+
+
+/** Decodes as much of the @p n characters at @p s as it can to
+    @p out, 16 characters at a time (with SSSE3) or 32 (with AVX2),
+    stopping at the first block that has a character not in the
+    alphabet (like padding). Returns how many characters were decoded,
+    the octets written to @p out are 3/4 of that.
+
+    The output is never ahead of the input, so @p out may be the same
+    as @p s (decoding in place).
+ */
+static size_t decode_simd(char const* s,
+                          size_t      n,
+                          uint8_t*    out,
+                          char const* alphabet)
+{
+    size_t          done = 0;
+    enum simd_level level;
+
+    if ((n < 16) || !simd_alphabet(alphabet)) {
+        return 0;
+    }
+    level = simd_level();
+    if (simdNone == level) {
+        return 0;
+    }
+    if (simdAVX2 == level) {
+        done = decode_avx2(s, n, out, alphabet);
+    }
+    return done
+           + decode_ssse3(s + done, n - done, out + done / 4 * 3, alphabet);
+}
+
+#else
+
+#define encode_simd(in, length, out, alphabet) 0
+#define decode_simd(s, n, out, alphabet) 0
+
+#endif /* PBBASE64_SIMD */
+
+
 int pbbase64_encode(pubnub_bymebl_t                data,
                     char*                          s,
                     size_t*                        n,
@@ -27,7 +425,10 @@ int pbbase64_encode(pubnub_bymebl_t                data,
         return -1;
     }
 
-    for (i = 0; i < length; i += 3) {
+    i = encode_simd(in, length, out, options->alphabet);
+    in += i;
+    out += i / 3 * 4;
+    for (; i < length; i += 3) {
         uint8_t b = (in[0] & 0x0FC) >> 2;
         *out++    = options->alphabet[b];
         b         = (in[0] & 0x3) << 4;
@@ -163,23 +564,31 @@ int pbbase64_decode(char const*                    s,
         return -1;
     }
 
+    i = decode_simd(s, n, out, alphabet);
+    if (i == n) {
+        data->size = i / 4 * 3;
+        return 0;
+    }
+    s += i;
+    out += i / 4 * 3;
+
     memcpy(decode_tab, decode_tab_C, sizeof decode_tab);
-    decode_tab[(int)alphabet[62]] = 62;
-    decode_tab[(int)alphabet[63]] = 63;
+    decode_tab[(uint8_t)alphabet[62]] = 62;
+    decode_tab[(uint8_t)alphabet[63]] = 63;
 
-    for (i = 0; i < n; i += 4) {
+    for (; i < n; i += 4) {
         uint8_t word[4];
-        word[0] = decode_tab[(int)*s++];
+        word[0] = decode_tab[(uint8_t)*s++];
         if ((word[0] == 64) && !options->ignore_invalid_char) {
             return -12;
         }
-        word[1] = decode_tab[(int)*s++];
+        word[1] = decode_tab[(uint8_t)*s++];
         if ((word[1] == 64) && !options->ignore_invalid_char) {
             return -13;
         }
         *out++  = (word[0] << 2) | (word[1] >> 4);
-        word[2] = decode_tab[(int)*s++];
-        word[3] = decode_tab[(int)*s++];
+        word[2] = decode_tab[(uint8_t)*s++];
+        word[3] = decode_tab[(uint8_t)*s++];
         if (word[2] < 64) {
             *out++ = (word[1] << 4) | (word[2] >> 2);
             if (word[3] < 64) {
@@ -262,3 +671,30 @@ pubnub_bymebl_t pbbase64_decode_alloc_std_str(char const* s)
 {
     return pbbase64_decode_alloc_std(s, strlen(s));
 }
+
+
+int pbbase64_decode_inplace(char*                          s,
+                            size_t                         n,
+                            pubnub_bymebl_t*               data,
+                            struct pbbase64_options const* options)
+{
+    PUBNUB_ASSERT_OPT(data != NULL);
+
+    /* Decoding never writes ahead of what it has read */
+    data->ptr  = (uint8_t*)s;
+    data->size = pbbase64_decoded_length(n);
+    return pbbase64_decode(s, n, data, options);
+}
+
+
+int pbbase64_decode_inplace_std(char* s, size_t n, pubnub_bymebl_t* data)
+{
+    struct pbbase64_options options = PBBASE64_RFC3548_OPTIONS;
+    return pbbase64_decode_inplace(s, n, data, &options);
+}
+
+
+int pbbase64_decode_inplace_std_str(char* s, pubnub_bymebl_t* data)
+{
+    return pbbase64_decode_inplace_std(s, strlen(s), data);
+}
@@ -20,6 +20,12 @@
     We provide a generic encoder and decoder, which support all known
     uses of Base64.
 
+    On x86, if the CPU supports it (checked at runtime), SSSE3 or AVX2
+    instructions are used to encode/decode many characters at once,
+    otherwise (and for the remainder that doesn't fill a whole SIMD
+    register) plain C code is used. The results are the same either
+    way. Define `PBBASE64_SIMD` to 0 to not use SIMD at all.
+
     Decoded data is arbitrary - it doesn't have to be regular
     characters.
 
@@ -252,5 +258,28 @@ pubnub_bymebl_t pbbase64_decode_alloc_std(char const* s, size_t n);
 /** Has the effect of: ppbase64_decode_alloc_std(s, strlen(s)) */
 pubnub_bymebl_t pbbase64_decode_alloc_std_str(char const* s);
 
+/** Base64 decodes the string @p s with length @p n "in place", that
+    is, to the memory of @p s itself (the decoded data is always shorter
+    than the encoded), using options @p options. This is the way to
+    decode with no memory (allocated or on stack) besides the one the
+    string is already in, which is useful for decoding received
+    messages. On success, @p data will point to @p s and hold the
+    number of bytes decoded. Of course, @p s is no longer a string
+    after this.
+
+    @return 0: OK, -1: error
+*/
+int pbbase64_decode_inplace(char*                          s,
+                            size_t                         n,
+                            pubnub_bymebl_t*               data,
+                            struct pbbase64_options const* options);
+
+/** Similar to pbbase64_decode_inplace(), but uses the the Base64
+    "standard" variant (RFC 3548 or RFC 4648).*/
+int pbbase64_decode_inplace_std(char* s, size_t n, pubnub_bymebl_t* data);
+
+/** Has the effect of: pbbase64_decode_inplace_std(s, strlen(s), data) */
+int pbbase64_decode_inplace_std_str(char* s, pubnub_bymebl_t* data);
+
 
 #endif /* !defined INC_PBBASE64 */
@@ -77,6 +77,59 @@ static void do_decode(void)
 }
 
 
+static void do_decode_inplace(void)
+{
+    int             result;
+    char            encoded[] = ENC_RESULT_MED;
+    pubnub_bymebl_t decoded;
+
+    result = pbbase64_decode_inplace_std_str(encoded, &decoded);
+    assert(0 == result);
+    assert((uint8_t*)encoded == decoded.ptr);
+    assert(decoded.size == sizeof ENC_INPUT_MED - 1);
+    printf("Input `%s`\n"
+           "decoded in place to `%.*s`\n"
+           "expected            `%s`.\n",
+           ENC_RESULT_MED,
+           (int)decoded.size,
+           decoded.ptr,
+           ENC_INPUT_MED);
+    assert(0 == memcmp(decoded.ptr, ENC_INPUT_MED, decoded.size));
+}
+
+
+/* Long enough for the SIMD code (if used) and the plain C code for
+   the remainder to both get exercised, at all possible remainders */
+static void do_round_trip(void)
+{
+    size_t  length;
+    uint8_t data[300];
+
+    for (length = 0; length < sizeof data; ++length) {
+        pubnub_bymebl_t const to_encode = { data, length };
+        char                  encoded[sizeof data * 4 / 3 + 4];
+        size_t                n = sizeof encoded;
+        uint8_t               decoded[sizeof data + 3];
+        pubnub_bymebl_t       decoded_mebl = { decoded, sizeof decoded };
+        pubnub_bymebl_t       inplace;
+        size_t                i;
+
+        for (i = 0; i < length; ++i) {
+            data[i] = (uint8_t)(i * 7 + length);
+        }
+        assert(0 == pbbase64_encode_std(to_encode, encoded, &n));
+        assert(n == pbbase64_encoded_length(length));
+        assert(0 == pbbase64_decode_std(encoded, n, &decoded_mebl));
+        assert(decoded_mebl.size == length);
+        assert(0 == memcmp(decoded, data, length));
+        assert(0 == pbbase64_decode_inplace_std(encoded, n, &inplace));
+        assert(inplace.size == length);
+        assert(0 == memcmp(inplace.ptr, data, length));
+    }
+    printf("Encoded and decoded lengths 0 - %u\n", (unsigned)sizeof data - 1);
+}
+
+
 int main()
 {
     puts("==================");
@@ -86,5 +139,9 @@ int main()
 
     puts("__________________");
     do_decode();
+    puts("------------------");
+    do_decode_inplace();
+    puts("------------------");
+    do_round_trip();
     puts("==================");
 }
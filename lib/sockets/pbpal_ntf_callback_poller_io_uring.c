@@ -0,0 +1,426 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "pubnub_internal.h"
+
+#include "lib/sockets/pbpal_ntf_callback_poller_io_uring.h"
+
+#include "core/pubnub_assert.h"
+#include "core/pubnub_log.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <poll.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+
+#if !defined(INVALID_SOCKET)
+#define INVALID_SOCKET -1
+#endif
+
+/** User data of the operations whose completion we ignore (like
+    removing a poll) */
+#define IGNORED_ID 0
+
+
+static int io_uring_setup(unsigned entries, struct io_uring_params* p)
+{
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+
+static int io_uring_enter(int      fd,
+                          unsigned to_submit,
+                          unsigned min_complete,
+                          unsigned flags,
+                          void*    arg,
+                          size_t   argsz)
+{
+    return (int)syscall(
+        __NR_io_uring_enter, fd, to_submit, min_complete, flags, arg, argsz);
+}
+
+
+static int map_rings(struct pbpal_poll_data* data, struct io_uring_params const* p)
+{
+    data->sq_ring_size = p->sq_off.array + p->sq_entries * sizeof(unsigned);
+    data->cq_ring_size = p->cq_off.cqes + p->cq_entries * sizeof(struct io_uring_cqe);
+    if (p->features & IORING_FEAT_SINGLE_MMAP) {
+        if (data->cq_ring_size > data->sq_ring_size) {
+            data->sq_ring_size = data->cq_ring_size;
+        }
+        data->cq_ring_size = data->sq_ring_size;
+    }
+    data->sq_ring = mmap(NULL,
+                         data->sq_ring_size,
+                         PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE,
+                         data->ring_fd,
+                         IORING_OFF_SQ_RING);
+    if (MAP_FAILED == data->sq_ring) {
+        PUBNUB_LOG_ERROR("io_uring poller: failed to map the SQ ring, errno=%d\n", errno);
+        return -1;
+    }
+    if (p->features & IORING_FEAT_SINGLE_MMAP) {
+        data->cq_ring = data->sq_ring;
+    }
+    else {
+        data->cq_ring = mmap(NULL,
+                             data->cq_ring_size,
+                             PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE,
+                             data->ring_fd,
+                             IORING_OFF_CQ_RING);
+        if (MAP_FAILED == data->cq_ring) {
+            PUBNUB_LOG_ERROR("io_uring poller: failed to map the CQ ring, errno=%d\n",
+                             errno);
+            munmap(data->sq_ring, data->sq_ring_size);
+            return -1;
+        }
+    }
+    data->sqes_size = p->sq_entries * sizeof(struct io_uring_sqe);
+    data->sqes      = (struct io_uring_sqe*)mmap(NULL,
+                                            data->sqes_size,
+                                            PROT_READ | PROT_WRITE,
+                                            MAP_SHARED | MAP_POPULATE,
+                                            data->ring_fd,
+                                            IORING_OFF_SQES);
+    if (MAP_FAILED == (void*)data->sqes) {
+        PUBNUB_LOG_ERROR("io_uring poller: failed to map the SQEs, errno=%d\n", errno);
+        if (data->cq_ring != data->sq_ring) {
+            munmap(data->cq_ring, data->cq_ring_size);
+        }
+        munmap(data->sq_ring, data->sq_ring_size);
+        return -1;
+    }
+
+    data->sq_head  = (unsigned*)((char*)data->sq_ring + p->sq_off.head);
+    data->sq_tail  = (unsigned*)((char*)data->sq_ring + p->sq_off.tail);
+    data->sq_mask  = (unsigned*)((char*)data->sq_ring + p->sq_off.ring_mask);
+    data->sq_array = (unsigned*)((char*)data->sq_ring + p->sq_off.array);
+    data->cq_head  = (unsigned*)((char*)data->cq_ring + p->cq_off.head);
+    data->cq_tail  = (unsigned*)((char*)data->cq_ring + p->cq_off.tail);
+    data->cq_mask  = (unsigned*)((char*)data->cq_ring + p->cq_off.ring_mask);
+    data->cqes = (struct io_uring_cqe*)((char*)data->cq_ring + p->cq_off.cqes);
+
+    return 0;
+}
+
+
+static void unmap_rings(struct pbpal_poll_data* data)
+{
+    munmap(data->sqes, data->sqes_size);
+    if (data->cq_ring != data->sq_ring) {
+        munmap(data->cq_ring, data->cq_ring_size);
+    }
+    munmap(data->sq_ring, data->sq_ring_size);
+}
+
+
+struct pbpal_poll_data* pbpal_ntf_callback_poller_init(void)
+{
+    struct pbpal_poll_data* rslt;
+    struct io_uring_params  params;
+
+    rslt = (struct pbpal_poll_data*)malloc(sizeof *rslt);
+    if (NULL == rslt) {
+        return NULL;
+    }
+    memset(&params, 0, sizeof params);
+    rslt->ring_fd = io_uring_setup(PUBNUB_IO_URING_ENTRIES, &params);
+    if (rslt->ring_fd < 0) {
+        PUBNUB_LOG_ERROR("io_uring poller: io_uring_setup() failed, errno=%d\n", errno);
+        free(rslt);
+        return NULL;
+    }
+    if (!(params.features & IORING_FEAT_EXT_ARG)) {
+        PUBNUB_LOG_ERROR("io_uring poller: waiting with a timeout not supported "
+                         "(need Linux 5.11 or newer), features=%x\n",
+                         params.features);
+        close(rslt->ring_fd);
+        free(rslt);
+        return NULL;
+    }
+    if (0 != map_rings(rslt, &params)) {
+        close(rslt->ring_fd);
+        free(rslt);
+        return NULL;
+    }
+    rslt->to_submit = 0;
+    rslt->last_id   = IGNORED_ID;
+    rslt->size = rslt->cap = 0;
+    rslt->aw               = NULL;
+
+    return rslt;
+}
+
+
+/** Submits the queued operations and, if @p ms >= 0, waits for at
+    least one completion, for at most @p ms milliseconds.
+*/
+static int submit_and_wait(struct pbpal_poll_data* data, int ms)
+{
+    int rslt;
+
+    if (ms >= 0) {
+        struct __kernel_timespec      ts;
+        struct io_uring_getevents_arg arg;
+
+        ts.tv_sec  = ms / 1000;
+        ts.tv_nsec = (ms % 1000) * 1000000L;
+        memset(&arg, 0, sizeof arg);
+        arg.ts = (uint64_t)(uintptr_t)&ts;
+        rslt   = io_uring_enter(data->ring_fd,
+                              data->to_submit,
+                              1,
+                              IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG,
+                              &arg,
+                              sizeof arg);
+    }
+    else {
+        rslt = io_uring_enter(data->ring_fd, data->to_submit, 0, 0, NULL, 0);
+    }
+    data->to_submit =
+        *data->sq_tail - __atomic_load_n(data->sq_head, __ATOMIC_ACQUIRE);
+    if ((rslt < 0) && (errno != ETIME) && (errno != EINTR)) {
+        PUBNUB_LOG_WARNING("io_uring poller: io_uring_enter() failed, errno=%d\n",
+                           errno);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/** Queues an operation to the submission queue. If it's full, submits
+    what's queued first.
+*/
+static int queue_sqe(struct pbpal_poll_data* data,
+                     unsigned                opcode,
+                     pbpal_native_socket_t   sockt,
+                     uint64_t                addr,
+                     unsigned                events,
+                     uint64_t                user_data)
+{
+    unsigned const       entries = *data->sq_mask + 1;
+    unsigned             tail    = *data->sq_tail;
+    unsigned             index;
+    struct io_uring_sqe* sqe;
+
+    if (tail - __atomic_load_n(data->sq_head, __ATOMIC_ACQUIRE) >= entries) {
+        submit_and_wait(data, -1);
+        if (tail - __atomic_load_n(data->sq_head, __ATOMIC_ACQUIRE) >= entries) {
+            PUBNUB_LOG_ERROR("io_uring poller: submission queue full\n");
+            return -1;
+        }
+    }
+    index = tail & *data->sq_mask;
+    sqe   = data->sqes + index;
+    memset(sqe, 0, sizeof *sqe);
+    sqe->opcode = (uint8_t)opcode;
+    sqe->fd     = sockt;
+    sqe->addr   = addr;
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    events = (events << 16) | (events >> 16);
+#endif
+    sqe->poll32_events     = events;
+    sqe->user_data         = user_data;
+    data->sq_array[index] = index;
+    __atomic_store_n(data->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ++data->to_submit;
+
+    return 0;
+}
+
+
+static void disarm(struct pbpal_poll_data* data, struct pbpal_io_uring_watch* w)
+{
+    if (w->armed_events != 0) {
+        queue_sqe(data, IORING_OP_POLL_REMOVE, -1, w->armed_id, 0, IGNORED_ID);
+        w->armed_events = 0;
+    }
+}
+
+
+static void arm(struct pbpal_poll_data* data, struct pbpal_io_uring_watch* w)
+{
+    disarm(data, w);
+    if ((w->events != 0) && (w->socket != INVALID_SOCKET)) {
+        uint64_t const id = ++data->last_id;
+        if (0 == queue_sqe(data, IORING_OP_POLL_ADD, w->socket, 0, w->events, id)) {
+            w->armed_id     = id;
+            w->armed_events = w->events;
+            w->armed_socket = w->socket;
+        }
+    }
+}
+
+
+static struct pbpal_io_uring_watch* find_watch(struct pbpal_poll_data* data,
+                                               pubnub_t const*         pb)
+{
+    size_t i;
+    for (i = 0; i < data->size; ++i) {
+        if (data->aw[i].pb == pb) {
+            return data->aw + i;
+        }
+    }
+    return NULL;
+}
+
+
+void pbpal_ntf_callback_save_socket(struct pbpal_poll_data* data, pubnub_t* pb)
+{
+    struct pbpal_io_uring_watch* w;
+    pbpal_native_socket_t        sockt = pubnub_get_native_socket(pb);
+    if (INVALID_SOCKET == sockt) {
+        return;
+    }
+    PUBNUB_ASSERT_OPT(NULL == find_watch(data, pb));
+    if (data->size == data->cap) {
+        size_t const                 newcap = data->size + 2;
+        struct pbpal_io_uring_watch* npaw   = (struct pbpal_io_uring_watch*)realloc(
+            data->aw, sizeof data->aw[0] * newcap);
+        if (NULL == npaw) {
+            return;
+        }
+        data->aw  = npaw;
+        data->cap = newcap;
+    }
+
+    w               = data->aw + data->size;
+    w->pb           = pb;
+    w->socket       = sockt;
+    w->events       = POLLOUT;
+    w->armed_socket = INVALID_SOCKET;
+    w->armed_events = 0;
+    w->armed_id     = IGNORED_ID;
+    ++data->size;
+    PBMETRICS_GAUGE_SET(pbmgWatchedSockets, data->size);
+}
+
+
+void pbpal_ntf_callback_remove_socket(struct pbpal_poll_data* data, pubnub_t* pb)
+{
+    struct pbpal_io_uring_watch* w = find_watch(data, pb);
+    size_t                       to_move;
+
+    if (NULL == w) {
+        PUBNUB_LOG_DEBUG("pbpal_ntf_callback_remove_socket(pb=%p): Not Found!", pb);
+        return;
+    }
+    if (w->armed_events != 0) {
+        /* The ring holds a reference to the socket while the poll is
+           armed, so submit the removal right away, lest the socket
+           stays open after it is closed.
+        */
+        disarm(data, w);
+        submit_and_wait(data, -1);
+    }
+    to_move = data->size - (w - data->aw) - 1;
+    if (to_move > 0) {
+        memmove(w, w + 1, sizeof data->aw[0] * to_move);
+    }
+    --data->size;
+    PBMETRICS_GAUGE_SET(pbmgWatchedSockets, data->size);
+}
+
+
+void pbpal_ntf_callback_update_socket(struct pbpal_poll_data* data, pubnub_t* pb)
+{
+    struct pbpal_io_uring_watch* w = find_watch(data, pb);
+    if (NULL == w) {
+        PUBNUB_LOG_WARNING("pbpal_ntf_callback_update_socket(pb=%p): Not Found!", pb);
+        return;
+    }
+    /* Will be re-armed on next poll */
+    w->socket = pubnub_get_native_socket(pb);
+}
+
+
+int pbpal_ntf_watch_out_events(struct pbpal_poll_data* data, pubnub_t* pbp)
+{
+    struct pbpal_io_uring_watch* w = find_watch(data, pbp);
+    if (NULL == w) {
+        PUBNUB_LOG_WARNING("pbpal_ntf_watch_out_events(pbp=%p): Not Found!", pbp);
+        return -1;
+    }
+    w->events = POLLOUT;
+    return 0;
+}
+
+
+int pbpal_ntf_watch_in_events(struct pbpal_poll_data* data, pubnub_t* pbp)
+{
+    struct pbpal_io_uring_watch* w = find_watch(data, pbp);
+    if (NULL == w) {
+        PUBNUB_LOG_WARNING("pbpal_ntf_watch_in_events(pbp=%p): Not Found!", pbp);
+        return -1;
+    }
+    w->events = POLLIN;
+    return 0;
+}
+
+
+int pbpal_ntf_poll_away(struct pbpal_poll_data* data, int ms)
+{
+    size_t   i;
+    unsigned head;
+    unsigned tail;
+    int      rslt = 0;
+
+    if (0 == data->size) {
+        return 0;
+    }
+
+    /* Polls are one-shot, so, (re)arm those that fired or changed */
+    for (i = 0; i < data->size; ++i) {
+        struct pbpal_io_uring_watch* w = data->aw + i;
+        if ((w->events != w->armed_events) || (w->socket != w->armed_socket)) {
+            arm(data, w);
+        }
+    }
+
+    if (0 != submit_and_wait(data, ms)) {
+        return -1;
+    }
+
+    head = *data->cq_head;
+    tail = __atomic_load_n(data->cq_tail, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+        struct io_uring_cqe const* cqe = data->cqes + (head & *data->cq_mask);
+        if (cqe->user_data == IGNORED_ID) {
+            continue;
+        }
+        for (i = 0; i < data->size; ++i) {
+            struct pbpal_io_uring_watch* w = data->aw + i;
+            if ((w->armed_events != 0) && (w->armed_id == cqe->user_data)) {
+                w->armed_events = 0;
+                if ((cqe->res > 0)
+                    && (cqe->res & (POLLIN | POLLOUT | POLLERR | POLLHUP))) {
+                    pbntf_requeue_for_processing(w->pb);
+                    ++rslt;
+                }
+                break;
+            }
+        }
+    }
+    __atomic_store_n(data->cq_head, head, __ATOMIC_RELEASE);
+
+    return rslt;
+}
+
+
+void pbpal_ntf_callback_poller_deinit(struct pbpal_poll_data** data)
+{
+    PUBNUB_ASSERT_OPT(data != NULL);
+    PUBNUB_ASSERT_OPT(*data != NULL);
+
+    unmap_rings(*data);
+    close((*data)->ring_fd);
+    free((*data)->aw);
+    free(*data);
+    *data = NULL;
+}
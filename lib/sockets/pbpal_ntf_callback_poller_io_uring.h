@@ -0,0 +1,84 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined(INC_PBPAL_NTF_CALLBACK_POLLER_IO_URING)
+#define INC_PBPAL_NTF_CALLBACK_POLLER_IO_URING
+
+#include "core/pbpal_ntf_callback_poller.h"
+
+#include "pubnub_get_native_socket.h"
+
+#include <linux/io_uring.h>
+
+#include <stdint.h>
+
+
+/** @file pbpal_ntf_callback_poller_io_uring.h
+
+    A poller using the Linux io_uring (Linux 5.11 or newer). Watching a
+    socket is a (one-shot) poll operation submitted to the ring. All
+    the (re)arming and removing of polls is collected in the ring's
+    submission queue and submitted in one system call, the same one
+    that waits for the completions. So, on each "poll away", there is
+    only one system call, regardless of how many sockets have changed
+    what they watch for and how many are ready.
+
+    We don't use liburing, just the system calls, to avoid an external
+    dependency.
+*/
+
+
+/** Number of entries in the submission queue of the ring */
+#if !defined(PUBNUB_IO_URING_ENTRIES)
+#define PUBNUB_IO_URING_ENTRIES 64
+#endif
+
+
+/** A context (its socket) watched by the io_uring poller */
+struct pbpal_io_uring_watch {
+    pubnub_t* pb;
+    /** The socket to watch */
+    pbpal_native_socket_t socket;
+    /** Events to watch for */
+    unsigned events;
+    /** Socket for which the poll is armed */
+    pbpal_native_socket_t armed_socket;
+    /** Events for which the poll is armed, 0 if not armed */
+    unsigned armed_events;
+    /** User data of the armed poll operation */
+    uint64_t armed_id;
+};
+
+
+struct pbpal_poll_data {
+    /** The io_uring file descriptor */
+    int ring_fd;
+
+    /** Submission queue ring, as mapped from the kernel */
+    void*              sq_ring;
+    size_t             sq_ring_size;
+    unsigned*          sq_head;
+    unsigned*          sq_tail;
+    unsigned*          sq_mask;
+    unsigned*          sq_array;
+    struct io_uring_sqe* sqes;
+    size_t             sqes_size;
+    /** Number of SQEs queued, but not yet submitted */
+    unsigned to_submit;
+
+    /** Completion queue ring, as mapped from the kernel */
+    void*                cq_ring;
+    size_t               cq_ring_size;
+    unsigned*            cq_head;
+    unsigned*            cq_tail;
+    unsigned*            cq_mask;
+    struct io_uring_cqe* cqes;
+
+    /** Last user data given to an operation */
+    uint64_t last_id;
+
+    struct pbpal_io_uring_watch* aw;
+    size_t                       size;
+    size_t                       cap;
+};
+
+
+#endif /* !defined(INC_PBPAL_NTF_CALLBACK_POLLER_IO_URING) */
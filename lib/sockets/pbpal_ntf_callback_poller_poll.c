@@ -80,6 +80,7 @@ void pbpal_ntf_callback_save_socket(struct pbpal_poll_data* data, pubnub_t* pb)
     data->apoll[data->size].events = POLLOUT;
     data->apb[data->size]          = pb;
     ++data->size;
+    PBMETRICS_GAUGE_SET(pbmgWatchedSockets, data->size);
 }
 
 
@@ -101,6 +102,7 @@ void pbpal_ntf_callback_remove_socket(struct pbpal_poll_data* data, pubnub_t* pb
                 memmove(data->apb + i, data->apb + i + 1, sizeof data->apb[0] * to_move);
             }
             --data->size;
+            PBMETRICS_GAUGE_SET(pbmgWatchedSockets, data->size);
             return;
         }
     }
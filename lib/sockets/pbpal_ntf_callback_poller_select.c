@@ -60,6 +60,7 @@ void pbpal_ntf_callback_save_socket(struct pbpal_poll_data* data, pubnub_t* pb)
     data->apb[data->size]     = pb;
     data->asocket[data->size] = sockt;
     ++data->size;
+    PBMETRICS_GAUGE_SET(pbmgWatchedSockets, data->size);
 }
 
 
@@ -92,6 +93,7 @@ void pbpal_ntf_callback_remove_socket(struct pbpal_poll_data* data, pubnub_t* pb
                         sizeof data->asocket[0] * to_move);
             }
             --data->size;
+            PBMETRICS_GAUGE_SET(pbmgWatchedSockets, data->size);
             break;
         }
     }
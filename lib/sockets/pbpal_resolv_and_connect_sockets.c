@@ -8,6 +8,7 @@
 #include "core/pubnub_dns_servers.h"
 
 #include <sys/types.h>
+#include <string.h>
 
 
 #define HTTP_PORT 80
@@ -21,6 +22,37 @@
 #endif
 
 
+#ifdef PUBNUB_CALLBACK_API
+/** Starts (non-blocking) connecting of a TCP socket to @p dest
+    (IPv4 address only, the @p port is set here). Closes the
+    (UDP, DNS) socket of @p pb, if it has one.
+ */
+static enum pbpal_resolv_n_connect_result connect_TCP_socket(pubnub_t *pb, struct sockaddr_in dest, uint16_t port)
+{
+    int skt = pb->pal.socket;
+
+    if (SOCKET_INVALID != skt) {
+        socket_close(skt);
+    }
+    skt = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    pb->pal.socket = skt;
+    if (SOCKET_INVALID == skt) {
+        return pbpal_connect_resource_failure;
+    }
+    pb->options.use_blocking_io = false;
+    pbpal_set_blocking_io(pb);
+    socket_disable_SIGPIPE(pb->pal.socket);
+    dest.sin_family = AF_INET;
+    dest.sin_port = htons(port);
+    if (SOCKET_ERROR == connect(skt, (struct sockaddr*)&dest, sizeof dest)) {
+        return socket_would_block() ? pbpal_connect_wouldblock : pbpal_connect_failed;
+    }
+
+    return pbpal_connect_success;
+}
+#endif /* PUBNUB_CALLBACK_API */
+
+
 enum pbpal_resolv_n_connect_result pbpal_resolv_and_connect(pubnub_t *pb)
 {
     int error;
@@ -51,6 +83,11 @@ enum pbpal_resolv_n_connect_result pbpal_resolv_and_connect(pubnub_t *pb)
 #ifdef PUBNUB_CALLBACK_API
         struct sockaddr_in dest;
 
+        memset(&dest, 0, sizeof dest);
+        if (1 == inet_pton(AF_INET, origin, &dest.sin_addr)) {
+            /* Origin is an IPv4 address, nothing to resolve */
+            return connect_TCP_socket(pb, dest, port);
+        }
         if (SOCKET_INVALID == pb->pal.socket) {
             pb->pal.socket  = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
         }
@@ -158,21 +195,7 @@ enum pbpal_resolv_n_connect_result pbpal_check_resolv_and_connect(pubnub_t *pb)
     case 0:
         break;
     }
-    socket_close(skt);
-    skt = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-    if (SOCKET_INVALID == skt) {
-        return pbpal_connect_resource_failure;
-    }
-    pb->pal.socket = skt;
-    pb->options.use_blocking_io = false;
-    pbpal_set_blocking_io(pb);
-    socket_disable_SIGPIPE(pb->pal.socket);
-    dest.sin_port = htons(port);
-    if (SOCKET_ERROR == connect(skt, (struct sockaddr*)&dest, sizeof dest)) {
-        return socket_would_block() ? pbpal_connect_wouldblock : pbpal_connect_failed;
-    }
-
-    return pbpal_connect_success;
+    return connect_TCP_socket(pb, dest, port);
 
 #else
 
@@ -0,0 +1,299 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "pubnub_internal.h"
+
+#include "core/pubnub_ntf_sync.h"
+#include "core/pubnub_blocking_io.h"
+#include "core/pubnub_assert.h"
+#include "core/pubnub_log.h"
+#include "core/pbpal.h"
+
+#include "pubnub_get_native_socket.h"
+
+#include <stdlib.h>
+
+
+#if defined(_WIN32)
+
+#include <winsock2.h>
+#include <windows.h>
+#define PBPAL_POLLFD WSAPOLLFD
+/* See the remark in pbpal_ntf_callback_poller_poll.c */
+#define poll(fdarray, nfds, timeout) WSAPoll(fdarray, nfds, timeout)
+
+static unsigned long now_ms(void)
+{
+    return GetTickCount();
+}
+
+#else
+
+#include "posix/monotonic_clock_get_time.h"
+
+#include <poll.h>
+#include <errno.h>
+#define PBPAL_POLLFD struct pollfd
+
+static unsigned long now_ms(void)
+{
+    struct timespec ts;
+    monotonic_clock_get_time(&ts);
+    return (unsigned long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+#endif
+
+
+/** State of one of the contexts being awaited */
+struct await_item {
+    /** The context, NULL if it is not (any more) awaited */
+    pubnub_t* pb;
+    /** Whether its FSM should be run - on start, if its socket is
+        ready or if it has no socket to wait for */
+    bool ready;
+    /** Index of its socket in the poll set, -1 if none */
+    int poll_index;
+    /** Whether the context used blocking I/O before it was awaited */
+    bool was_blocking;
+};
+
+
+/** Returns whether the context @p pb, in its current state, waits
+    for its socket to be "writable" (rather than "readable"). This
+    mirrors what the netcore tells the "callback" interface to watch
+    for.
+ */
+static bool waits_to_write(pubnub_t const* pb)
+{
+    switch (pb->state) {
+    case PBS_WAIT_DNS_SEND:
+    case PBS_WAIT_CONNECT:
+    case PBS_CONNECTED:
+    case PBS_TX_GET:
+    case PBS_TX_PATH:
+    case PBS_TX_SCHEME:
+    case PBS_TX_HOST:
+    case PBS_TX_PORT_NUM:
+    case PBS_TX_VER:
+    case PBS_TX_PROXY_AUTHORIZATION:
+    case PBS_TX_ORIGIN:
+    case PBS_TX_FIN_HEAD:
+        return true;
+    default:
+        return false;
+    }
+}
+
+
+/** Returns whether the context @p pb, in its current state, has a
+    socket to wait for.
+ */
+static bool has_socket(pubnub_t const* pb)
+{
+    switch (pb->state) {
+    case PBS_NULL:
+    case PBS_IDLE:
+    case PBS_READY:
+    case PBS_RETRY:
+        return false;
+    default:
+        return true;
+    }
+}
+
+
+/** Runs the FSM of the context of @p item if it is ready, and, if
+    its transaction is not done, adds its socket to the poll set
+    @p apoll.
+
+    @return true: the transaction is done, false otherwise
+ */
+static bool process(struct await_item* item, PBPAL_POLLFD* apoll, int* nfds, bool* spin)
+{
+    pubnub_t* pb = item->pb;
+    bool      done;
+
+    pubnub_mutex_lock(pb->monitor);
+    if (item->ready && !pbnc_can_start_transaction(pb)) {
+        pbnc_fsm(pb);
+    }
+    done = pbnc_can_start_transaction(pb);
+    item->poll_index = -1;
+    item->ready      = false;
+    if (!done) {
+        pbpal_native_socket_t sockt =
+            has_socket(pb) ? pubnub_get_native_socket(pb) : SOCKET_INVALID;
+        if (SOCKET_INVALID == sockt) {
+            /* Nothing to wait for, the FSM has to be run again */
+            item->ready = true;
+            *spin       = true;
+        }
+        else {
+            apoll[*nfds].fd      = sockt;
+            apoll[*nfds].events  = waits_to_write(pb) ? POLLOUT : POLLIN;
+            apoll[*nfds].revents = 0;
+            item->poll_index     = (*nfds)++;
+        }
+    }
+    pubnub_mutex_unlock(pb->monitor);
+
+    return done;
+}
+
+
+/** Switches the context @p pb to non-blocking I/O, returning
+    whether it used blocking I/O.
+ */
+static bool set_non_blocking(pubnub_t* pb)
+{
+    bool was_blocking;
+
+    pubnub_mutex_lock(pb->monitor);
+    was_blocking = pb->options.use_blocking_io;
+    pubnub_set_non_blocking_io(pb);
+    if (pubnub_get_native_socket(pb) != SOCKET_INVALID) {
+        /* Not all platforms can switch an open connection */
+        pbpal_set_blocking_io(pb);
+    }
+    pubnub_mutex_unlock(pb->monitor);
+
+    return was_blocking;
+}
+
+
+/** Switches the context @p pb back to blocking I/O, as otherwise a
+    pubnub_await() of its transaction (that is still in progress)
+    would busy-wait. This includes a connection that is kept alive
+    (when its transaction is done), as it is reused as is.
+ */
+static void restore_blocking(pubnub_t* pb)
+{
+    pubnub_mutex_lock(pb->monitor);
+    pubnub_set_blocking_io(pb);
+    if (pubnub_get_native_socket(pb) != SOCKET_INVALID) {
+        pbpal_set_blocking_io(pb);
+    }
+    pubnub_mutex_unlock(pb->monitor);
+}
+
+
+/** Awaits the contexts @p pbs, until one (if not @p all) or all of
+    them are done, or @p timeout_ms expires.
+
+    @return The index of a context that is done, if not @p all, `n` if
+    @p all are done, -1 on timeout or error
+ */
+static int await_many(pubnub_t** pbs, size_t n, int timeout_ms, bool all)
+{
+    struct await_item* items;
+    PBPAL_POLLFD*      apoll;
+    unsigned long      start = now_ms();
+    size_t             left  = 0;
+    size_t             i;
+    int                rslt = -1;
+
+    PUBNUB_ASSERT_OPT((pbs != NULL) || (0 == n));
+
+    items = (struct await_item*)malloc(n * (sizeof *items + sizeof *apoll) + 1);
+    if (NULL == items) {
+        PUBNUB_LOG_ERROR("Failed to allocate data to await %lu contexts\n",
+                         (unsigned long)n);
+        return -1;
+    }
+    apoll = (PBPAL_POLLFD*)(items + n);
+
+    for (i = 0; i < n; ++i) {
+        pubnub_t* pb = pbs[i];
+        items[i].pb           = pb;
+        items[i].ready        = true;
+        items[i].poll_index   = -1;
+        items[i].was_blocking = false;
+        if (NULL == pb) {
+            continue;
+        }
+        PUBNUB_ASSERT(pb_valid_ctx_ptr(pb));
+        ++left;
+        items[i].was_blocking = set_non_blocking(pb);
+    }
+
+    while (left > 0) {
+        int           nfds  = 0;
+        bool          spin  = false;
+        int           wait_ms;
+        unsigned long elapsed;
+
+        for (i = 0; i < n; ++i) {
+            if (NULL == items[i].pb) {
+                continue;
+            }
+            if (process(&items[i], apoll, &nfds, &spin)) {
+                items[i].pb = NULL;
+                --left;
+                if (!all) {
+                    rslt = (int)i;
+                    goto done;
+                }
+            }
+        }
+        if (0 == left) {
+            break;
+        }
+
+        elapsed = now_ms() - start;
+        if ((timeout_ms >= 0) && (elapsed >= (unsigned long)timeout_ms)) {
+            break;
+        }
+        wait_ms = (timeout_ms < 0) ? -1 : (int)(timeout_ms - elapsed);
+        if (spin) {
+            wait_ms = 0;
+        }
+        if (nfds > 0) {
+            int polled = poll(apoll, nfds, wait_ms);
+            if (polled < 0) {
+#if defined(_WIN32)
+                int last_err = WSAGetLastError();
+#else
+                int last_err = errno;
+                if (EINTR == last_err) {
+                    continue;
+                }
+#endif
+                PUBNUB_LOG_ERROR("poll() of %d sockets failed, error = %d\n",
+                                 nfds,
+                                 last_err);
+                goto done;
+            }
+        }
+        for (i = 0; i < n; ++i) {
+            int idx = items[i].poll_index;
+            if ((idx >= 0) && (apoll[idx].revents != 0)) {
+                items[i].ready = true;
+            }
+        }
+    }
+    if (0 == left) {
+        rslt = (int)n;
+    }
+
+done:
+    for (i = 0; i < n; ++i) {
+        if (items[i].was_blocking) {
+            restore_blocking(pbs[i]);
+        }
+    }
+    free(items);
+    return rslt;
+}
+
+
+int pubnub_await_any(pubnub_t** pbs, size_t n, int timeout_ms)
+{
+    int rslt = await_many(pbs, n, timeout_ms, false);
+    return (rslt == (int)n) ? -1 : rslt;
+}
+
+
+enum pubnub_res pubnub_await_all(pubnub_t** pbs, size_t n, int timeout_ms)
+{
+    return (await_many(pbs, n, timeout_ms, true) == (int)n) ? PNR_OK
+                                                            : PNR_TIMEOUT;
+}
@@ -7,8 +7,46 @@
 #include <openssl/evp.h>
 #include <openssl/err.h>
 
+#include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#define TRY_CLAIM(p) (0 == InterlockedCompareExchange((p), 1, 0))
+#define RELEASE(p) InterlockedExchange((p), 0)
+#else
+#define TRY_CLAIM(p) pbaes256_try_claim(p)
+#define RELEASE(p) __atomic_store_n((p), 0, __ATOMIC_RELEASE)
+static bool pbaes256_try_claim(long volatile* p)
+{
+    long expected = 0;
+    return __atomic_compare_exchange_n(p, &expected, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+}
+#endif
+
+
+/** What a cached AES-256 context is set up for (with the key of its
+    cache) */
+enum aes256_mode {
+    /** Nothing, the key has to be (expanded and) set */
+    aes256_none,
+    aes256_encrypting,
+    aes256_decrypting
+};
 
+/** An AES-256 (OpenSSL) context kept in a cache */
+struct aes256_cached_ctx {
+    EVP_CIPHER_CTX*  ctx;
+    enum aes256_mode mode;
+    /** Is some thread using the context */
+    long volatile busy;
+};
+
+struct pbaes256_cache {
+    uint8_t                  key[33];
+    struct aes256_cached_ctx cached[PBAES256_CACHED_CONTEXTS];
+};
 
 
 static int print_to_pubnub_log(const char *s, size_t len, void *p)
@@ -22,11 +60,17 @@ static int print_to_pubnub_log(const char *s, size_t len, void *p)
 }
 
 
-static int do_encrypt(EVP_CIPHER_CTX* aes256, pubnub_bymebl_t msg, uint8_t const* key, uint8_t const* iv, pubnub_bymebl_t *encrypted)
+/** If @p keyed, the @p aes256 context is already set up for
+    encryption with the @p key, so only the IV is (re)set, which also
+    resets the context for a new message.
+*/
+static int do_encrypt(EVP_CIPHER_CTX* aes256, bool keyed, pubnub_bymebl_t msg, uint8_t const* key, uint8_t const* iv, pubnub_bymebl_t *encrypted)
 {
     int len = 0;
+    int init = keyed ? EVP_EncryptInit_ex(aes256, NULL, NULL, NULL, iv)
+                     : EVP_EncryptInit_ex(aes256, EVP_aes_256_cbc(), NULL, key, iv);
 
-    if (!EVP_EncryptInit_ex(aes256, EVP_aes_256_cbc(), NULL, key, iv)) {
+    if (!init) {
         ERR_print_errors_cb(print_to_pubnub_log, NULL);
         PUBNUB_LOG_ERROR("Failed to initialize AES-256 encryption\n");
         return -1;
@@ -58,7 +102,7 @@ int pbaes256_encrypt(pubnub_bymebl_t msg, uint8_t const* key, uint8_t const* iv,
         return -1;
     }
 
-    result = do_encrypt(aes256, msg, key, iv, encrypted);
+    result = do_encrypt(aes256, false, msg, key, iv, encrypted);
 
     EVP_CIPHER_CTX_free(aes256);
 
@@ -84,7 +128,7 @@ pubnub_bymebl_t pbaes256_encrypt_alloc(pubnub_bymebl_t msg, uint8_t const* key,
         return result;
     }
     
-    encrypt_result = do_encrypt(aes256, msg, key, iv, &result);
+    encrypt_result = do_encrypt(aes256, false, msg, key, iv, &result);
     if (-1 == encrypt_result) {
         free(result.ptr);
         result.ptr = NULL;
@@ -95,10 +139,14 @@ pubnub_bymebl_t pbaes256_encrypt_alloc(pubnub_bymebl_t msg, uint8_t const* key,
 }
 
 
-static int do_decrypt(EVP_CIPHER_CTX* aes256, pubnub_bymebl_t data, uint8_t const* key, uint8_t const* iv, pubnub_bymebl_t *msg)
+/** Like do_encrypt(), if @p keyed, only the IV is (re)set */
+static int do_decrypt(EVP_CIPHER_CTX* aes256, bool keyed, pubnub_bymebl_t data, uint8_t const* key, uint8_t const* iv, pubnub_bymebl_t *msg)
 {
     int len = 0;
-    if (!EVP_DecryptInit_ex(aes256, EVP_aes_256_cbc(), NULL, key, iv)) {
+    int init = keyed ? EVP_DecryptInit_ex(aes256, NULL, NULL, NULL, iv)
+                     : EVP_DecryptInit_ex(aes256, EVP_aes_256_cbc(), NULL, key, iv);
+
+    if (!init) {
         ERR_print_errors_cb(print_to_pubnub_log, NULL);
         PUBNUB_LOG_ERROR("Failed to initialize AES-256 decryption\n");
         return -1;
@@ -138,7 +186,7 @@ int pbaes256_decrypt(pubnub_bymebl_t data, uint8_t const* key, uint8_t const* iv
         return -1;
     }
 
-    result = do_decrypt(aes256, data, key, iv, msg);
+    result = do_decrypt(aes256, false, data, key, iv, msg);
 
     EVP_CIPHER_CTX_free(aes256);
 
@@ -166,7 +214,7 @@ pubnub_bymebl_t pbaes256_decrypt_alloc(pubnub_bymebl_t data, uint8_t const* key,
         return result;;
     }
 
-    decrypt_result = do_decrypt(aes256, data, key, iv, &result);
+    decrypt_result = do_decrypt(aes256, false, data, key, iv, &result);
 
     EVP_CIPHER_CTX_free(aes256);
 
@@ -178,3 +226,115 @@ pubnub_bymebl_t pbaes256_decrypt_alloc(pubnub_bymebl_t data, uint8_t const* key,
 
     return result;
 }
+
+
+struct pbaes256_cache* pbaes256_cache_alloc(uint8_t const* key)
+{
+    struct pbaes256_cache* cache = (struct pbaes256_cache*)calloc(1, sizeof *cache);
+
+    if (NULL == cache) {
+        PUBNUB_LOG_ERROR("Failed to allocate AES-256 context cache\n");
+        return NULL;
+    }
+    memcpy(cache->key, key, sizeof cache->key);
+
+    return cache;
+}
+
+
+void pbaes256_cache_free(struct pbaes256_cache* cache)
+{
+    size_t i;
+
+    if (NULL == cache) {
+        return;
+    }
+    for (i = 0; i < PBAES256_CACHED_CONTEXTS; ++i) {
+        PUBNUB_ASSERT_OPT(!cache->cached[i].busy);
+        EVP_CIPHER_CTX_free(cache->cached[i].ctx);
+    }
+    memset(cache->key, 0, sizeof cache->key);
+    free(cache);
+}
+
+
+/** Claims a context of the @p cache that no other thread is using,
+    allocating it if needed. Returns NULL if all are in use (or
+    allocation fails).
+ */
+static struct aes256_cached_ctx* claim_cached(struct pbaes256_cache* cache)
+{
+    size_t i;
+
+    for (i = 0; i < PBAES256_CACHED_CONTEXTS; ++i) {
+        struct aes256_cached_ctx* cached = cache->cached + i;
+        if (!TRY_CLAIM(&cached->busy)) {
+            continue;
+        }
+        if (NULL == cached->ctx) {
+            cached->ctx  = EVP_CIPHER_CTX_new();
+            cached->mode = aes256_none;
+            if (NULL == cached->ctx) {
+                RELEASE(&cached->busy);
+                return NULL;
+            }
+        }
+        return cached;
+    }
+
+    return NULL;
+}
+
+
+/** Releases the @p cached context. If the message was processed OK
+    (@p result is 0), it is now set up for @p mode. If not, we don't
+    rely on its state, so the key will be set again. */
+static void release_cached(struct aes256_cached_ctx* cached, enum aes256_mode mode, int result)
+{
+    cached->mode = (0 == result) ? mode : aes256_none;
+    RELEASE(&cached->busy);
+}
+
+
+int pbaes256_encrypt_cached(struct pbaes256_cache* cache, pubnub_bymebl_t msg, uint8_t const* iv, pubnub_bymebl_t *encrypted)
+{
+    struct aes256_cached_ctx* cached;
+    int result;
+
+    PUBNUB_ASSERT_OPT(cache != NULL);
+
+    if (encrypted->size < msg.size + EVP_CIPHER_block_size(EVP_aes_256_cbc())) {
+        PUBNUB_LOG_ERROR("Not enough room to save AES-256 encrypted data\n");
+        return -1;
+    }
+    cached = claim_cached(cache);
+    if (NULL == cached) {
+        return pbaes256_encrypt(msg, cache->key, iv, encrypted);
+    }
+    result = do_encrypt(cached->ctx, aes256_encrypting == cached->mode, msg, cache->key, iv, encrypted);
+    release_cached(cached, aes256_encrypting, result);
+
+    return result;
+}
+
+
+int pbaes256_decrypt_cached(struct pbaes256_cache* cache, pubnub_bymebl_t data, uint8_t const* iv, pubnub_bymebl_t *msg)
+{
+    struct aes256_cached_ctx* cached;
+    int result;
+
+    PUBNUB_ASSERT_OPT(cache != NULL);
+
+    if (msg->size < data.size + EVP_CIPHER_block_size(EVP_aes_256_cbc()) + 1) {
+        PUBNUB_LOG_ERROR("Not enough room to save AES-256 decrypted data\n");
+        return -1;
+    }
+    cached = claim_cached(cache);
+    if (NULL == cached) {
+        return pbaes256_decrypt(data, cache->key, iv, msg);
+    }
+    result = do_decrypt(cached->ctx, aes256_decrypting == cached->mode, data, cache->key, iv, msg);
+    release_cached(cached, aes256_decrypting, result);
+
+    return result;
+}
@@ -41,4 +41,45 @@ int pbaes256_decrypt(pubnub_bymebl_t data, uint8_t const* key, uint8_t const* iv
 pubnub_bymebl_t pbaes256_decrypt_alloc(pubnub_bymebl_t data, uint8_t const* key, uint8_t const* iv);
 
 
+#if !defined PBAES256_CACHED_CONTEXTS
+/** How many AES-256 contexts an AES-256 context cache keeps, that
+    is, how many threads can use it at the same time without
+    allocating a context for the message.
+*/
+#define PBAES256_CACHED_CONTEXTS 4
+#endif
+
+/** A cache of AES-256 contexts, set up with a key. The contexts are
+    reused for many messages, so they don't have to be allocated for
+    each message and, as long as a context is used in the same
+    direction (encrypting or decrypting), the key is not expanded for
+    each message. It can be used from many threads at the same time,
+    each thread using a context no other thread uses. If all of them
+    are in use, a context is allocated for the message, like
+    pbaes256_encrypt() and pbaes256_decrypt() do.
+*/
+struct pbaes256_cache;
+
+/** Allocates an AES-256 context cache for the @p key. The contexts
+    are allocated on first use.
+    @return The cache, NULL on failure (to allocate)
+*/
+struct pbaes256_cache* pbaes256_cache_alloc(uint8_t const* key);
+
+/** Frees the AES-256 context @p cache, with all its contexts. No
+    thread may be using it. NULL is OK (and does nothing).
+*/
+void pbaes256_cache_free(struct pbaes256_cache* cache);
+
+/** Similar to pbaes256_encrypt(), but uses a context (and the key)
+    from the @p cache. Also checks that @p encrypted has enough room.
+*/
+int pbaes256_encrypt_cached(struct pbaes256_cache* cache, pubnub_bymebl_t msg, uint8_t const* iv, pubnub_bymebl_t *encrypted);
+
+/** Similar to pbaes256_decrypt(), but uses a context (and the key)
+    from the @p cache.
+*/
+int pbaes256_decrypt_cached(struct pbaes256_cache* cache, pubnub_bymebl_t data, uint8_t const* iv, pubnub_bymebl_t *msg);
+
+
 #endif /* !defined INC_PBAES256 */
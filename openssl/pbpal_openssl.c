@@ -162,14 +162,20 @@ static enum pubnub_res handle_socket_error(int result, pubnub_t* pb)
                      retry_BIO,
                      reason);
 #if defined(_WIN32)
-    PUBNUB_LOG_TRACE("pbpal_line_read_status(pb=%p): GetLastErrror()=%lu "
+    PUBNUB_LOG_TRACE("pbpal_read_response_status(pb=%p): GetLastErrror()=%lu "
                      "WSAGetLastError()=%d\n",
                      pb,
                      GetLastError(),
                      WSAGetLastError());
 #endif
     ERR_print_errors_cb(print_to_pubnub_log, pb);
-    return should_retry ? PNR_IN_PROGRESS : PNR_IO_ERROR;
+    if (should_retry) {
+        return PNR_IN_PROGRESS;
+    }
+    if (socket_closed_by_peer(result)) {
+        pb->sock_state = STATE_CLOSED_BY_PEER;
+    }
+    return PNR_IO_ERROR;
 }
 
 
@@ -187,168 +193,92 @@ int pbpal_send_status(pubnub_t* pb)
     }
     else {
         PUBNUB_ASSERT_OPT((unsigned)rslt <= pb->len);
+        PBMETRICS_ADD(pbmcBytesSent, rslt);
         pb->ptr += rslt;
         pb->len -= rslt;
         rslt = (0 == pb->len) ? 0 : +1;
     }
 
     if (rslt <= 0) {
-        pb->ptr        = (uint8_t*)pb->core.http_buf;
-        pb->unreadlen  = 0;
-        pb->sock_state = STATE_NONE;
+        pb->ptr       = (uint8_t*)pb->core.http_buf;
+        pb->unreadlen = 0;
+        if (pb->sock_state != STATE_CLOSED_BY_PEER) {
+            pb->sock_state = STATE_NONE;
+        }
     }
 
     return rslt;
 }
 
 
-int pbpal_start_read_line(pubnub_t* pb)
+int pbpal_start_read_response(pubnub_t* pb)
 {
-    unsigned distance;
-
     PUBNUB_ASSERT_INT_OPT(pb->sock_state, ==, STATE_NONE);
 
-    if (pb->unreadlen > 0) {
-        PUBNUB_ASSERT_OPT((char*)pb->ptr + pb->unreadlen
-                          <= pb->core.http_buf + PUBNUB_BUF_MAXLEN);
-        memmove(pb->core.http_buf, pb->ptr, pb->unreadlen);
-    }
-    distance = pb->ptr - (uint8_t*)pb->core.http_buf;
-    PUBNUB_ASSERT_UINT(distance + pb->left + pb->unreadlen,
-                       ==,
-                       sizeof pb->core.http_buf / sizeof pb->core.http_buf[0]);
-    pb->ptr -= distance;
-    pb->left += distance;
-
-    pb->sock_state = STATE_READ_LINE;
+    pbhttp_parser_init(&pb->http_parser);
+    pb->sock_state = STATE_READ_RESPONSE;
 
     return +1;
 }
 
 
-enum pubnub_res pbpal_line_read_status(pubnub_t* pb)
+/** Parses the data received but not yet parsed. Returns whether a
+    parsing event was reached.
+ */
+static bool parse_unread(pubnub_t* pb)
 {
-    PUBNUB_ASSERT_OPT(STATE_READ_LINE == pb->sock_state);
-
-    /* OpenSSL reads one TLS record at a time,
-       so, we need to call it in a loop to read ll there is
-    */
-    for (;;) {
-        if (pb->unreadlen == 0) {
-            int recvres;
-            PUBNUB_ASSERT_OPT((char*)pb->ptr + pb->left
-                              == pb->core.http_buf + PUBNUB_BUF_MAXLEN);
-            recvres = BIO_read(pb->pal.socket, (char*)pb->ptr, pb->left);
-            if (recvres <= 0) {
-                return handle_socket_error(recvres, pb);
-            }
-
-            PUBNUB_ASSERT_OPT(recvres <= pb->left);
-            PUBNUB_LOG_TRACE("pb=%p have new data of length=%d: %.*s\n",
-                             pb,
-                             recvres,
-                             recvres,
-                             pb->ptr);
-            pb->unreadlen = recvres;
-            pb->left -= recvres;
-        }
-
-        while (pb->unreadlen > 0) {
-            uint8_t c;
-
-            --pb->unreadlen;
-
-            c = *pb->ptr++;
-            if (c == '\n') {
-                WATCH_USHORT(pb->unreadlen);
-                pb->sock_state = STATE_NONE;
-                return PNR_OK;
-            }
-        }
-
-        if (pb->left == 0) {
-            PUBNUB_LOG_ERROR("pbpal_line_read_status(pb=%p): buffer full but "
-                             "newline not found",
-                             pb);
-            pb->sock_state = STATE_NONE;
-            return PNR_TX_BUFF_TOO_SMALL;
-        }
-    }
-}
-
-
-int pbpal_read_len(pubnub_t* pb)
-{
-    return (char*)pb->ptr - pb->core.http_buf;
-}
-
-
-int pbpal_start_read(pubnub_t* pb, size_t n)
-{
-    unsigned distance;
-
-    PUBNUB_ASSERT_UINT_OPT(n, >, 0);
-    PUBNUB_ASSERT_INT_OPT(pb->sock_state, ==, STATE_NONE);
-
-    WATCH_USHORT(pb->unreadlen);
-    WATCH_USHORT(pb->left);
-    if (pb->unreadlen > 0) {
-        PUBNUB_ASSERT_OPT((char*)pb->ptr + pb->unreadlen
-                          <= pb->core.http_buf + PUBNUB_BUF_MAXLEN);
-        memmove(pb->core.http_buf, pb->ptr, pb->unreadlen);
+    size_t parsed =
+        pbhttp_parse(&pb->http_parser, (char const*)pb->ptr, pb->unreadlen);
+
+    PUBNUB_ASSERT_OPT(parsed <= pb->unreadlen);
+    pb->ptr += parsed;
+    pb->unreadlen -= (uint16_t)parsed;
+
+    switch (pb->http_parser.event) {
+    case pbhttpEvNone:
+        return false;
+    case pbhttpEvDone:
+    case pbhttpEvError:
+        pb->sock_state = STATE_NONE;
+        break;
+    default:
+        break;
     }
-    distance = pb->ptr - (uint8_t*)pb->core.http_buf;
-    WATCH_UINT(distance);
-    PUBNUB_ASSERT_UINT(distance + pb->unreadlen + pb->left,
-                       ==,
-                       sizeof pb->core.http_buf / sizeof pb->core.http_buf[0]);
-    pb->ptr -= distance;
-    pb->left += distance;
-
-    pb->sock_state = STATE_READ;
-    pb->len        = n;
-
-    return +1;
+    return true;
 }
 
 
-enum pubnub_res pbpal_read_status(pubnub_t* pb)
+enum pubnub_res pbpal_read_response_status(pubnub_t* pb)
 {
-
-    PUBNUB_ASSERT_OPT(STATE_READ == pb->sock_state);
+    PUBNUB_ASSERT_OPT(STATE_READ_RESPONSE == pb->sock_state);
 
     /* OpenSSL reads one TLS record at a time,
-       so, we need to call it in a loop to read ll there is
+       so, we need to call it in a loop to read all there is
     */
-    for (;;) {
-        int have_read;
-
-        if (0 == pb->unreadlen) {
-            unsigned to_recv = pb->len;
-            if (to_recv > pb->left) {
-                to_recv = pb->left;
-            }
-            PUBNUB_ASSERT_OPT(to_recv > 0);
-            have_read = BIO_read(pb->pal.socket, pb->ptr, to_recv);
-            if (have_read <= 0) {
-                return handle_socket_error(have_read, pb);
-            }
-            PUBNUB_ASSERT_OPT(pb->left >= have_read);
-            pb->left -= have_read;
-        }
-        else {
-            have_read = (pb->unreadlen >= pb->len) ? pb->len : pb->unreadlen;
-            pb->unreadlen -= have_read;
-        }
-
-        pb->len -= have_read;
-        pb->ptr += have_read;
-
-        if ((0 == pb->len) || (0 == pb->left)) {
-            pb->sock_state = STATE_NONE;
-            return PNR_OK;
+    while (!parse_unread(pb)) {
+        int recvres;
+
+        /* All that was received was parsed, so, the whole buffer is
+           available for receiving.
+        */
+        pb->ptr  = (uint8_t*)pb->core.http_buf;
+        pb->left = sizeof pb->core.http_buf / sizeof pb->core.http_buf[0];
+        recvres  = BIO_read(pb->pal.socket, (char*)pb->ptr, pb->left);
+        if (recvres <= 0) {
+            return handle_socket_error(recvres, pb);
         }
+        PUBNUB_ASSERT_OPT(recvres <= pb->left);
+        PBMETRICS_ADD(pbmcBytesReceived, recvres);
+        PUBNUB_LOG_TRACE("pb=%p have new data of length=%d: %.*s\n",
+                         pb,
+                         recvres,
+                         recvres,
+                         pb->ptr);
+        pb->unreadlen = recvres;
+        pb->left -= recvres;
     }
+
+    return PNR_OK;
 }
 
 
@@ -10,6 +10,7 @@
 #endif
 
 #include "pbpal_add_system_certs.h"
+#include "pbpal_ssl_session_cache.h"
 #include "pubnub_internal.h"
 #include "core/pubnub_assert.h"
 #include "core/pubnub_log.h"
@@ -111,6 +112,15 @@ static void get_dns_ip(struct sockaddr_in* addr)
 }
 
 
+/** Returns whether the @p origin is an IPv4 address (in dotted
+    decimal notation), which we don't have to resolve. */
+static bool is_ipv4_address(char const* origin)
+{
+    struct in_addr addr;
+    return 1 == inet_pton(AF_INET, origin, &addr);
+}
+
+
 static enum pbpal_resolv_n_connect_result start_dns_resolution(pubnub_t*   pb,
                                                                char const* origin)
 {
@@ -219,7 +229,9 @@ static enum pbpal_resolv_n_connect_result resolv_and_connect_wout_SSL(pubnub_t*
 #endif /* PUBNUB_PROXY_API */
         pb->pal.socket = BIO_new_connect((char*)origin);
 #ifdef PUBNUB_CALLBACK_API
-        return start_dns_resolution(pb, origin);
+        if (!is_ipv4_address(origin)) {
+            return start_dns_resolution(pb, origin);
+        }
 #endif /* PUBNUB_CALLBACK_API */
     }
     return finish_resolv_and_connect_wout_SSL(pb);
@@ -350,6 +362,38 @@ static void add_certs(pubnub_t* pb)
     }
 }
 
+/** Returns the host name we connect to over SSL */
+static char const* ssl_origin(pubnub_t* pb)
+{
+#if PUBNUB_PROXY_API
+    if (pbproxyHTTP_GET == pb->proxy_type) {
+        return pb->proxy_hostname;
+    }
+#endif
+    return PUBNUB_ORIGIN_SETTABLE ? pb->origin : PUBNUB_ORIGIN;
+}
+
+
+/** For transaction timings, marks the TCP connection as established,
+    if it is, which we learn by driving the connect BIO (the one
+    under the SSL BIO) on its own. Otherwise, the TCP connect and the
+    TLS handshake would be done in one go by BIO_do_connect() on the
+    SSL BIO.
+ */
+static void mark_tcp_connected(pubnub_t* pb)
+{
+#if PUBNUB_TRANSACTION_TIMINGS
+    BIO* conn = BIO_next(pb->pal.socket);
+    if ((0 == pb->timings.at[pbtpConnect]) && (conn != NULL)
+        && (BIO_do_connect(conn) > 0)) {
+        PBTIMINGS_MARK(pb, pbtpConnect);
+    }
+#else
+    PUBNUB_UNUSED(pb);
+#endif
+}
+
+
 static enum pbpal_resolv_n_connect_result finish_resolv_and_connect(pubnub_t* pb)
 {
     int  rslt;
@@ -380,13 +424,19 @@ static enum pbpal_resolv_n_connect_result finish_resolv_and_connect(pubnub_t* pb
 
     BIO_set_nbio(pb->pal.socket, !pb->options.use_blocking_io);
 
-    if (pb->options.reuse_SSL_session && (pb->pal.session != NULL)) {
-        if (!SSL_set_session(ssl, pb->pal.session)) {
-            ERR_print_errors_cb(print_to_pubnub_log, NULL);
+    if (pb->options.reuse_SSL_session) {
+        if (pb->pal.session != NULL) {
+            if (!SSL_set_session(ssl, pb->pal.session)) {
+                ERR_print_errors_cb(print_to_pubnub_log, NULL);
+            }
+        }
+        else {
+            pbpal_ssl_session_cache_resume(ssl, ssl_origin(pb));
         }
     }
 
     WATCH_ENUM(pb->options.use_blocking_io);
+    mark_tcp_connected(pb);
     if (BIO_do_connect(pb->pal.socket) <= 0) {
         if (BIO_should_retry(pb->pal.socket) && PUBNUB_TIMERS_API
             && (pb->pal.connect_timeout > time(NULL))) {
@@ -396,15 +446,20 @@ static enum pbpal_resolv_n_connect_result finish_resolv_and_connect(pubnub_t* pb
         /* Expire the IP for the next connect */
         pb->pal.ip_timeout = 0;
         ERR_print_errors_cb(print_to_pubnub_log, NULL);
-        if ((pb->pal.session != NULL) && pb->options.reuse_SSL_session) {
-            SSL_SESSION_free(pb->pal.session);
-            pb->pal.session = NULL;
+        if (pb->options.reuse_SSL_session) {
+            if (pb->pal.session != NULL) {
+                SSL_SESSION_free(pb->pal.session);
+                pb->pal.session = NULL;
+            }
+            pbpal_ssl_session_cache_drop(ssl_origin(pb));
         }
         PUBNUB_LOG_ERROR("pb=%p: BIO_do_connect failed, errno=%d\n", pb, errno);
         return pbpal_connect_failed;
     }
 
     PUBNUB_LOG_TRACE("pb=%p: BIO connected\n", pb);
+    PBTIMINGS_MARK_ONCE(pb, pbtpConnect);
+    PBTIMINGS_MARK(pb, pbtpTlsHandshake);
     {
         pbpal_native_socket_t fd = BIO_get_fd(pb->pal.socket, NULL);
         socket_set_rcv_timeout(fd, pb->transaction_timeout_ms);
@@ -433,6 +488,7 @@ static enum pbpal_resolv_n_connect_result finish_resolv_and_connect(pubnub_t* pb
             SSL_SESSION_free(pb->pal.session);
         }
         pb->pal.session = SSL_get1_session(ssl);
+        pbpal_ssl_session_cache_store(ssl, ssl_origin(pb));
         if (0 == pb->pal.ip_timeout) {
             pb->pal.ip_timeout = SSL_SESSION_get_time(pb->pal.session)
                                  + SSL_SESSION_get_timeout(pb->pal.session);
@@ -542,10 +598,11 @@ enum pbpal_resolv_n_connect_result pbpal_resolv_and_connect(pubnub_t* pb)
             pb->pal.ip_timeout = 0;
 
 #ifdef PUBNUB_CALLBACK_API
-            return start_dns_resolution(pb, origin);
-#else
-            BIO_set_conn_hostname(pb->pal.socket, origin);
+            if (!is_ipv4_address(origin)) {
+                return start_dns_resolution(pb, origin);
+            }
 #endif /* PUBNUB_CALLBACK_API */
+            BIO_set_conn_hostname(pb->pal.socket, origin);
         }
         else {
             PUBNUB_LOG_TRACE("pb=%p SSL re-connect to: %u.%u.%u.%u\n",
@@ -559,10 +616,11 @@ enum pbpal_resolv_n_connect_result pbpal_resolv_and_connect(pubnub_t* pb)
     }
     else {
 #ifdef PUBNUB_CALLBACK_API
-        return start_dns_resolution(pb, origin);
-#else
-        BIO_set_conn_hostname(pb->pal.socket, origin);
+        if (!is_ipv4_address(origin)) {
+            return start_dns_resolution(pb, origin);
+        }
 #endif /* PUBNUB_CALLBACK_API */
+        BIO_set_conn_hostname(pb->pal.socket, origin);
     }
     return finish_resolv_and_connect(pb);
 }
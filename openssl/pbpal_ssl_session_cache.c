@@ -0,0 +1,116 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "pbpal_ssl_session_cache.h"
+
+#include "pbpal_mutex.h"
+#include "core/pubnub_assert.h"
+#include "core/pubnub_log.h"
+
+#include <openssl/err.h>
+
+#include <string.h>
+
+
+#if PUBNUB_SSL_SESSION_CACHE_SIZE > 0
+
+/** An SSL session shared by all contexts connecting to the same origin */
+struct pbpal_shared_ssl_session {
+    char         origin[PBPAL_SSL_SESSION_ORIGIN_MAXLEN + 1];
+    SSL_SESSION* session;
+};
+
+static struct pbpal_shared_ssl_session m_shared_session[PUBNUB_SSL_SESSION_CACHE_SIZE];
+
+/** Next entry in `m_shared_session` to replace, if the origin is not
+    already there */
+static unsigned m_shared_session_next;
+
+pbpal_mutex_static_decl_and_init(m_shared_session_lock);
+
+
+static int print_to_pubnub_log(const char* s, size_t len, void* p)
+{
+    PUBNUB_UNUSED(len);
+    PUBNUB_UNUSED(p);
+
+    PUBNUB_LOG_ERROR("From OpenSSL: '%s'", s);
+
+    return 0;
+}
+
+
+static struct pbpal_shared_ssl_session* find_shared_session(char const* origin)
+{
+    unsigned i;
+    for (i = 0; i < PUBNUB_SSL_SESSION_CACHE_SIZE; ++i) {
+        if ((m_shared_session[i].session != NULL)
+            && (0 == strcmp(m_shared_session[i].origin, origin))) {
+            return m_shared_session + i;
+        }
+    }
+    return NULL;
+}
+
+
+void pbpal_ssl_session_cache_resume(SSL* ssl, char const* origin)
+{
+    struct pbpal_shared_ssl_session* shared;
+
+    pbpal_mutex_init_static(m_shared_session_lock);
+    pbpal_mutex_lock(m_shared_session_lock);
+    shared = find_shared_session(origin);
+    if (shared != NULL) {
+        PUBNUB_LOG_TRACE("Resuming shared SSL session for origin '%s'\n", origin);
+        if (!SSL_set_session(ssl, shared->session)) {
+            ERR_print_errors_cb(print_to_pubnub_log, NULL);
+        }
+    }
+    pbpal_mutex_unlock(m_shared_session_lock);
+}
+
+
+/** Sets the @p session (which we own) for the @p origin. If it is
+    NULL, drops the one we have for the @p origin.
+*/
+static void set_shared_session(char const* origin, SSL_SESSION* session)
+{
+    struct pbpal_shared_ssl_session* shared;
+
+    if (strlen(origin) > PBPAL_SSL_SESSION_ORIGIN_MAXLEN) {
+        if (session != NULL) {
+            SSL_SESSION_free(session);
+        }
+        return;
+    }
+    pbpal_mutex_init_static(m_shared_session_lock);
+    pbpal_mutex_lock(m_shared_session_lock);
+    shared = find_shared_session(origin);
+    if ((NULL == shared) && (session != NULL)) {
+        shared                = m_shared_session + m_shared_session_next;
+        m_shared_session_next = (m_shared_session_next + 1) % PUBNUB_SSL_SESSION_CACHE_SIZE;
+        strcpy(shared->origin, origin);
+    }
+    if (shared != NULL) {
+        if (shared->session != NULL) {
+            SSL_SESSION_free(shared->session);
+        }
+        shared->session = session;
+    }
+    pbpal_mutex_unlock(m_shared_session_lock);
+}
+
+
+void pbpal_ssl_session_cache_store(SSL* ssl, char const* origin)
+{
+    SSL_SESSION* session = SSL_get1_session(ssl);
+    if (session != NULL) {
+        set_shared_session(origin, session);
+    }
+}
+
+
+void pbpal_ssl_session_cache_drop(char const* origin)
+{
+    set_shared_session(origin, NULL);
+}
+
+#endif /* PUBNUB_SSL_SESSION_CACHE_SIZE > 0 */
@@ -0,0 +1,57 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PBPAL_SSL_SESSION_CACHE
+#define INC_PBPAL_SSL_SESSION_CACHE
+
+
+#include <openssl/ssl.h>
+
+
+/** @file pbpal_ssl_session_cache.h
+    A small process-wide cache of SSL sessions, keyed by origin, so
+    that a context which connects to an origin for the first time can
+    resume a session that some other context already negotiated,
+    instead of doing a full handshake.
+
+    It holds (at most) #PUBNUB_SSL_SESSION_CACHE_SIZE origins; when it
+    is full, the oldest stored origin is replaced. Origins longer than
+    #PBPAL_SSL_SESSION_ORIGIN_MAXLEN are not cached. All functions are
+    thread-safe.
+*/
+
+
+#if !defined PUBNUB_SSL_SESSION_CACHE_SIZE
+#define PUBNUB_SSL_SESSION_CACHE_SIZE 4
+#endif
+
+/** Maximum length of an origin for which we keep a shared SSL session */
+#define PBPAL_SSL_SESSION_ORIGIN_MAXLEN 63
+
+
+#if PUBNUB_SSL_SESSION_CACHE_SIZE > 0
+
+/** Sets the cached session for the @p origin (if there is one) to be
+    resumed on @p ssl, before the handshake.
+ */
+void pbpal_ssl_session_cache_resume(SSL* ssl, char const* origin);
+
+/** Stores the session of @p ssl (after a successful handshake) as
+    the one to resume for the @p origin, replacing the one stored
+    before (if any).
+ */
+void pbpal_ssl_session_cache_store(SSL* ssl, char const* origin);
+
+/** Drops the cached session of the @p origin, if any. Use it when
+    resuming it failed, so that other contexts don't try it again.
+ */
+void pbpal_ssl_session_cache_drop(char const* origin);
+
+#else
+
+#define pbpal_ssl_session_cache_resume(ssl, origin)
+#define pbpal_ssl_session_cache_store(ssl, origin)
+#define pbpal_ssl_session_cache_drop(origin)
+
+#endif /* PUBNUB_SSL_SESSION_CACHE_SIZE > 0 */
+
+
+#endif /* !defined INC_PBPAL_SSL_SESSION_CACHE */
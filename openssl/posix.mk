@@ -1,6 +1,6 @@
-SOURCEFILES = ../core/pubnub_ssl.c ../core/pubnub_pubsubapi.c ../core/pubnub_coreapi.c ../core/pubnub_ccore_pubsub.c ../core/pubnub_ccore.c ../core/pubnub_netcore.c  pbpal_openssl.c pbpal_resolv_and_connect_openssl.c pbpal_add_system_certs_posix.c ../core/pubnub_alloc_std.c ../core/pubnub_assert_std.c ../core/pubnub_generate_uuid.c ../core/pubnub_blocking_io.c ../posix/posix_socket_blocking_io.c ../core/pubnub_timers.c ../core/pubnub_json_parse.c  ../core/pubnub_helper.c pubnub_version_openssl.c ../posix/pubnub_generate_uuid_posix.c pbpal_openssl_blocking_io.c ../lib/base64/pbbase64.c ../core/pubnub_crypto.c ../core/pubnub_coreapi_ex.c ../core/pubnub_free_with_timeout_std.c pbaes256.c
+SOURCEFILES = ../core/pubnub_ssl.c ../core/pubnub_pubsubapi.c ../core/pubnub_coreapi.c ../core/pubnub_ccore_pubsub.c ../core/pubnub_ccore.c ../core/pubnub_netcore.c ../core/pbhttp_parser.c  pbpal_openssl.c pbpal_resolv_and_connect_openssl.c pbpal_ssl_session_cache.c pbpal_add_system_certs_posix.c ../core/pubnub_alloc_std.c ../core/pubnub_assert_std.c ../core/pubnub_generate_uuid.c ../core/pubnub_blocking_io.c ../posix/posix_socket_blocking_io.c ../core/pubnub_timers.c ../core/pubnub_json_parse.c  ../core/pubnub_helper.c pubnub_version_openssl.c ../posix/pubnub_generate_uuid_posix.c pbpal_openssl_blocking_io.c ../lib/base64/pbbase64.c ../core/pubnub_crypto.c ../core/pubnub_coreapi_ex.c ../core/pubnub_free_with_timeout_std.c pbaes256.c
 
-OBJFILES = pubnub_ssl.o pubnub_pubsubapi.o pubnub_coreapi.o pubnub_ccore_pubsub.o pubnub_ccore.o pubnub_netcore.o  pbpal_openssl.o pbpal_resolv_and_connect_openssl.o pbpal_add_system_certs_posix.o pubnub_alloc_std.o pubnub_assert_std.o pubnub_generate_uuid.o pubnub_blocking_io.o posix_socket_blocking_io.o pubnub_timers.o pubnub_json_parse.o pubnub_helper.o pubnub_version_openssl.o pubnub_generate_uuid_posix.o pbpal_openssl_blocking_io.o pbbase64.o pubnub_crypto.o pubnub_coreapi_ex.o pubnub_free_with_timeout_std.o pbaes256.o
+OBJFILES = pubnub_ssl.o pubnub_pubsubapi.o pubnub_coreapi.o pubnub_ccore_pubsub.o pubnub_ccore.o pubnub_netcore.o pbhttp_parser.o  pbpal_openssl.o pbpal_resolv_and_connect_openssl.o pbpal_ssl_session_cache.o pbpal_add_system_certs_posix.o pubnub_alloc_std.o pubnub_assert_std.o pubnub_generate_uuid.o pubnub_blocking_io.o posix_socket_blocking_io.o pubnub_timers.o pubnub_json_parse.o pubnub_helper.o pubnub_version_openssl.o pubnub_generate_uuid_posix.o pbpal_openssl_blocking_io.o pbbase64.o pubnub_crypto.o pubnub_coreapi_ex.o pubnub_free_with_timeout_std.o pbaes256.o
 
 ifndef USE_PROXY
 USE_PROXY = 1
@@ -14,9 +14,33 @@ ifndef RECEIVE_GZIP_RESPONSE
 RECEIVE_GZIP_RESPONSE = 1
 endif
 
+ifndef STREAMING_SUBSCRIBE
+STREAMING_SUBSCRIBE = 1
+endif
+
+ifndef TRANSACTION_TIMINGS
+TRANSACTION_TIMINGS = 1
+endif
+
+ifndef METRICS
+METRICS = 1
+endif
+
+ifndef LOG_ASYNC
+LOG_ASYNC = 0
+endif
+
+ifndef PUBLISH_SPOOL
+PUBLISH_SPOOL = 1
+endif
+
 ifeq ($(USE_PROXY), 1)
 SOURCEFILES += ../core/pubnub_proxy.c ../core/pubnub_proxy_core.c ../core/pbhttp_digest.c ../core/pbntlm_core.c ../core/pbntlm_packer_std.c
 OBJFILES += pubnub_proxy.o pubnub_proxy_core.o pbhttp_digest.o pbntlm_core.o pbntlm_packer_std.o
+# The benchmark uses the mock server as a HTTP GET proxy
+BENCH=pubnub_bench
+else
+BENCH=
 endif
 
 ifeq ($(USE_DNS_SERVERS), 1)
@@ -29,6 +53,34 @@ SOURCEFILES += ../lib/miniz/miniz_tinfl.c ../core/pbgzip_decompress.c
 OBJFILES += miniz_tinfl.o pbgzip_decompress.o
 endif
 
+ifeq ($(STREAMING_SUBSCRIBE), 1)
+SOURCEFILES += ../core/pubnub_streaming_subscribe.c
+OBJFILES += pubnub_streaming_subscribe.o
+endif
+
+ifeq ($(TRANSACTION_TIMINGS), 1)
+SOURCEFILES += ../core/pubnub_transaction_timings.c
+OBJFILES += pubnub_transaction_timings.o
+endif
+
+ifeq ($(METRICS), 1)
+SOURCEFILES += ../core/pubnub_metrics.c
+OBJFILES += pubnub_metrics.o
+endif
+
+ifeq ($(LOG_ASYNC), 1)
+SOURCEFILES += ../core/pubnub_log_async.c ../posix/pubnub_log_async_posix.c
+OBJFILES += pubnub_log_async.o pubnub_log_async_posix.o
+endif
+
+ifeq ($(PUBLISH_SPOOL), 1)
+SOURCEFILES += ../core/pubnub_publish_spool.c ../posix/pubnub_publish_spool_posix.c
+OBJFILES += pubnub_publish_spool.o pubnub_publish_spool_posix.o
+endif
+
+SOURCEFILES += ../core/pubnub_coalesce.c ../core/pubnub_channel_set.c ../core/pubnub_origin_selector.c
+OBJFILES += pubnub_coalesce.o pubnub_channel_set.o pubnub_origin_selector.o
+
 OS := $(shell uname)
 ifeq ($(OS),Darwin)
 SOURCEFILES += ../posix/monotonic_clock_get_time_darwin.c
@@ -40,19 +92,22 @@ OBJFILES += monotonic_clock_get_time_posix.o
 LDLIBS=-lrt -lpthread -lssl -lcrypto
 endif
 
-CFLAGS = -g -D PUBNUB_LOG_LEVEL=PUBNUB_LOG_LEVEL_WARNING  -Wall -D PUBNUB_THREADSAFE -D PUBNUB_PROXY_API=$(USE_PROXY)
+CFLAGS = -g -D PUBNUB_LOG_LEVEL=PUBNUB_LOG_LEVEL_WARNING  -Wall -D PUBNUB_THREADSAFE -D PUBNUB_PROXY_API=$(USE_PROXY) -D PUBNUB_TRANSACTION_TIMINGS=$(TRANSACTION_TIMINGS) -D PUBNUB_METRICS=$(METRICS) -D PUBNUB_LOG_ASYNC=$(LOG_ASYNC)
 # -g enables debugging, remove to get a smaller executable
 # -fsanitize=address Use AddressSanitizer
 # -fsanitize=thread Use ThreadSanitizer
 
 INCLUDES=-I .. -I .
 
-all: pubnub_sync_sample cancel_subscribe_sync_sample pubnub_sync_subloop_sample pubnub_callback_sample subscribe_publish_callback_sample pubnub_callback_subloop_sample pubnub_fntest pubnub_console_sync pubnub_console_callback pubnub_crypto_sync_sample subscribe_publish_from_callback publish_callback_subloop_sample publish_queue_callback_subloop
+all: pubnub_sync_sample cancel_subscribe_sync_sample pubnub_sync_subloop_sample pubnub_callback_sample subscribe_publish_callback_sample pubnub_callback_subloop_sample pubnub_fntest pubnub_console_sync pubnub_console_callback pubnub_crypto_sync_sample subscribe_publish_from_callback publish_callback_subloop_sample publish_queue_callback_subloop $(BENCH) pubnub_microbench
+
 
+SYNC_INTF_SOURCEFILES=../core/pubnub_ntf_sync.c ../core/pubnub_sync_subscribe_loop.c ../core/pubnub_sync_history_range.c ../lib/sockets/pubnub_ntf_sync_await_poll.c pubnub_get_native_socket.c
+SYNC_INTF_OBJFILES=pubnub_ntf_sync.o pubnub_sync_subscribe_loop.o pubnub_sync_history_range.o pubnub_ntf_sync_await_poll.o pubnub_get_native_socket.o
 
-pubnub_sync.a : $(SOURCEFILES) ../core/pubnub_ntf_sync.c ../core/pubnub_sync_subscribe_loop.c
-	$(CC) -c $(CFLAGS) $(INCLUDES) $(SOURCEFILES) ../core/pubnub_ntf_sync.c ../core/pubnub_sync_subscribe_loop.c
-	ar rcs pubnub_sync.a $(OBJFILES) pubnub_ntf_sync.o pubnub_sync_subscribe_loop.o
+pubnub_sync.a : $(SOURCEFILES) $(SYNC_INTF_SOURCEFILES)
+	$(CC) -c $(CFLAGS) $(INCLUDES) $(SOURCEFILES) $(SYNC_INTF_SOURCEFILES)
+	ar rcs pubnub_sync.a $(OBJFILES) $(SYNC_INTF_OBJFILES)
 
 CALLBACK_INTF_SOURCEFILES=pubnub_ntf_callback_posix.c pubnub_get_native_socket.c ../core/pubnub_timer_list.c ../lib/sockets/pbpal_ntf_callback_poller_poll.c ../lib/sockets/pbpal_adns_sockets.c ../core/pbpal_ntf_callback_queue.c ../core/pbpal_ntf_callback_admin.c ../core/pbpal_ntf_callback_handle_timer_list.c  ../core/pubnub_callback_subscribe_loop.c
 CALLBACK_INTF_OBJFILES=pubnub_ntf_callback_posix.o pubnub_get_native_socket.o pubnub_timer_list.o pbpal_ntf_callback_poller_poll.o pbpal_adns_sockets.o pbpal_ntf_callback_queue.o pbpal_ntf_callback_admin.o pbpal_ntf_callback_handle_timer_list.o pubnub_callback_subscribe_loop.o
@@ -104,5 +159,21 @@ pubnub_console_callback: $(CONSOLE_SOURCEFILES) ../core/samples/console/pnc_ops_
 	$(CC) -o $@ $(CFLAGS) -D PUBNUB_CALLBACK_API $(INCLUDES) $(CONSOLE_SOURCEFILES) ../core/samples/console/pnc_ops_callback.c pubnub_callback.a $(LDLIBS)
 
 
+BENCH_SOURCEFILES=../posix/bench/pubnub_bench.c ../posix/bench/pubnub_mock_server.c
+
+pubnub_bench: pubnub_bench_sync pubnub_bench_callback
+
+pubnub_bench_sync: $(BENCH_SOURCEFILES) pubnub_sync.a
+	$(CC) -o $@ $(CFLAGS) $(INCLUDES) $(BENCH_SOURCEFILES) pubnub_sync.a $(LDLIBS)
+
+pubnub_bench_callback: $(BENCH_SOURCEFILES) pubnub_callback.a
+	$(CC) -o $@ -D PUBNUB_CALLBACK_API $(CFLAGS) $(INCLUDES) $(BENCH_SOURCEFILES) pubnub_callback.a $(LDLIBS)
+
+MICROBENCH_SOURCEFILES=../core/bench/pubnub_microbench.c ../core/bench/pubnub_microbench_corpus.c
+
+pubnub_microbench: $(MICROBENCH_SOURCEFILES) pubnub_sync.a
+	$(CC) -o $@ $(CFLAGS) $(INCLUDES) $(MICROBENCH_SOURCEFILES) pubnub_sync.a $(LDLIBS)
+
+
 clean:
-	rm pubnub_sync_sample pubnub_sync_subloop_sample cancel_subscribe_sync_sample pubnub_callback_sample subscribe_publish_callback_sample pubnub_fntest pubnub_console_sync pubnub_console_callback pubnub_crypto_sync_sample pubnub_sync.a pubnub_callback.a pubnub_callback_subloop_sample subscribe_publish_from_callback publish_callback_subloop_sample publish_queue_callback_subloop *.o
+	rm pubnub_sync_sample pubnub_sync_subloop_sample cancel_subscribe_sync_sample pubnub_callback_sample subscribe_publish_callback_sample pubnub_fntest pubnub_console_sync pubnub_console_callback pubnub_crypto_sync_sample pubnub_sync.a pubnub_callback.a pubnub_callback_subloop_sample subscribe_publish_from_callback publish_callback_subloop_sample publish_queue_callback_subloop pubnub_bench_sync pubnub_bench_callback pubnub_microbench *.o
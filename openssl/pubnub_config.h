@@ -111,6 +111,44 @@
 #define PUBNUB_RECEIVE_GZIP_RESPONSE 1
 #endif
 
+#if !defined(PUBNUB_STREAMING_SUBSCRIBE)
+/** If true (!=0), enables support for "streaming" subscribe - giving
+    the received messages to the user while the response is still
+    being received */
+#define PUBNUB_STREAMING_SUBSCRIBE 1
+#endif
+
+#if !defined(PUBNUB_TRANSACTION_TIMINGS)
+/** If true (!=0), enables support for getting the timings of the
+    phases of a transaction (DNS, connect, TLS, sending the request,
+    receiving and parsing the response)
+    @see pubnub_last_transaction_timings() */
+#define PUBNUB_TRANSACTION_TIMINGS 1
+#endif
+
+#if !defined(PUBNUB_METRICS)
+/** If true (!=0), enables support for the runtime metrics of the
+    C-core "engine" (counters, gauges, histograms)
+    @see pubnub_metrics_snapshot() */
+#define PUBNUB_METRICS 1
+#endif
+
+#if !defined(PUBNUB_METRICS_THREADS)
+/** The number of threads that get their own (lock-free) copy of the
+    metrics, including one copy shared by all other threads.
+    Has no effect if PUBNUB_METRICS is 0. */
+#define PUBNUB_METRICS_THREADS 8
+#endif
+
+#if !defined(PUBNUB_SSL_SESSION_CACHE_SIZE)
+/** The number of origins for which the SSL session is shared among
+    all contexts, so that the first connection of a context can
+    resume a session another context negotiated, avoiding a full TLS
+    handshake. Set to 0 to disable the sharing.
+*/
+#define PUBNUB_SSL_SESSION_CACHE_SIZE 4
+#endif
+
 /** The maximum length (in characters) of the host name of the proxy
     that will be saved in the Pubnub context.
 */
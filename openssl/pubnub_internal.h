@@ -47,6 +47,12 @@ typedef BIO* pb_socket_t;
 
 #define socket_timed_out() (errno == ETIMEDOUT)
 
+/** Whether the peer closed (or reset) the connection, given the
+    @p result of a BIO read or write that failed and should not be
+    retried */
+#define socket_closed_by_peer(result)                                          \
+    ((0 == (result)) || (errno == ECONNRESET) || (errno == EPIPE))
+
 /** On Windows, one needs to call WSAStartup(), which is not trivial */
 int socket_platform_init(void);
 
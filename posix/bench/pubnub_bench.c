@@ -0,0 +1,692 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if defined PUBNUB_CALLBACK_API
+#include "pubnub_callback.h"
+#else
+#include "pubnub_sync.h"
+#endif
+
+#include "core/pubnub_proxy.h"
+#include "core/pubnub_free_with_timeout.h"
+#if PUBNUB_USE_SSL
+#include "core/pubnub_ssl.h"
+#endif
+#include "posix/monotonic_clock_get_time.h"
+
+#include "pubnub_mock_server.h"
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/** @file pubnub_bench.c
+
+    End-to-end load test / benchmark of the C-core, against the mock
+    Pubnub server (pubnub_mock_server.h), which is run in a child
+    process, so that the CPU usage and RSS reported are those of the
+    C-core (and this harness) only.
+
+    Built as `pubnub_bench_sync` (each context is driven by its own
+    thread, with pubnub_await()) and `pubnub_bench_callback` (all
+    contexts are driven from the callbacks). Run with `-h` for the
+    options.
+ */
+
+
+#if !PUBNUB_PROXY_API
+#error The benchmark needs the Proxy API (it uses the mock server as a HTTP GET proxy)
+#endif
+
+#if defined PUBNUB_CALLBACK_API
+#define BENCH_MODE "callback"
+#else
+#define BENCH_MODE "sync"
+#endif
+
+/** Maximum size of the padding added to messages */
+#define MAX_PAYLOAD 1024
+
+/** How many messages to put in the history of each channel, before
+    running the "history" scenario */
+#define HISTORY_SEED 10
+
+
+enum bench_scenario {
+    /** Publish, latency is the duration of the transaction */
+    bsPublish,
+    /** Publish and subscribe (to the same channel), latency is from
+        the start of publish to the receipt of the message */
+    bsPubSub,
+    /** History, latency is the duration of the transaction */
+    bsHistory,
+    /** Here-now, latency is the duration of the transaction */
+    bsPresence
+};
+
+
+struct bench_options {
+    unsigned            contexts;
+    unsigned            messages;
+    unsigned            payload;
+    enum bench_scenario scenario;
+    bool                tls;
+    bool                gzip;
+    bool                chunked;
+    uint16_t            port;
+    bool                serve_only;
+};
+
+
+struct bench_context {
+    struct bench_options const* options;
+    /** The context that publishes (or does the other transactions) */
+    pubnub_t* pb;
+    /** The context that subscribes (in the "pubsub" scenario) */
+    pubnub_t* sub;
+    char      channel[32];
+    char      message[MAX_PAYLOAD + 64];
+    /** Latencies of the finished operations, in microseconds */
+    uint32_t* latency;
+    /** Number of finished operations (messages received, for pubsub) */
+    unsigned done;
+    /** Number of messages published (for pubsub) */
+    unsigned sent;
+    unsigned errors;
+    /** Start of the current operation, in microseconds */
+    uint64_t start;
+#if defined PUBNUB_CALLBACK_API
+    bool pb_busy;
+    bool sub_busy;
+    bool finished;
+#endif
+};
+
+
+static char const* m_scenario_name[] = { "publish", "pubsub", "history", "presence" };
+
+static char const* m_cert_pem;
+
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    monotonic_clock_get_time(&ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+
+static pubnub_t* make_context(struct bench_options const* options, char const* uuid)
+{
+    pubnub_t* pb = pubnub_alloc();
+    if (NULL == pb) {
+        return NULL;
+    }
+    pubnub_init(pb, "demo", "demo");
+    pubnub_set_uuid(pb, uuid);
+    pubnub_set_proxy_manual(pb, pbproxyHTTP_GET, "127.0.0.1", options->port);
+#if PUBNUB_USE_SSL
+    if (options->tls) {
+        pubnub_set_ssl_options(pb, true, false, false);
+        pubnub_ssl_set_usrdef_pem_cert(pb, m_cert_pem);
+    }
+    else {
+        pubnub_set_ssl_options(pb, false, false, true);
+    }
+#endif
+
+    return pb;
+}
+
+
+static void free_context(pubnub_t* pb)
+{
+#if defined PUBNUB_CALLBACK_API
+    pubnub_register_callback(pb, NULL, NULL);
+#endif
+    /* To close the kept-alive connection */
+    pubnub_cancel(pb);
+#if !defined PUBNUB_CALLBACK_API
+    pubnub_await(pb);
+#endif
+    pubnub_free_with_timeout(pb, 1000);
+}
+
+
+static void record(struct bench_context* ctx, uint64_t latency)
+{
+    if (ctx->done < ctx->options->messages) {
+        ctx->latency[ctx->done++] = (uint32_t)latency;
+    }
+}
+
+
+/** Starts the next operation of the scenario on the "main" context */
+static enum pubnub_res start_op(struct bench_context* ctx)
+{
+    struct bench_options const* options = ctx->options;
+
+    ctx->start = now_us();
+    switch (options->scenario) {
+    case bsPublish:
+    case bsPubSub: {
+        int n = snprintf(ctx->message,
+                         sizeof ctx->message,
+                         "{\"ts\":%llu,\"p\":\"",
+                         (unsigned long long)ctx->start);
+        memset(ctx->message + n, 'x', options->payload);
+        strcpy(ctx->message + n + options->payload, "\"}");
+        return pubnub_publish(ctx->pb, ctx->channel, ctx->message);
+    }
+    case bsHistory:
+        return pubnub_history(ctx->pb, ctx->channel, HISTORY_SEED, false);
+    case bsPresence:
+        return pubnub_here_now(ctx->pb, ctx->channel, NULL);
+    default:
+        return PNR_INTERNAL_ERROR;
+    }
+}
+
+
+/** Finishes the (successful) operation on the "main" context,
+    reading the reply, as a user would */
+static void finish_op(struct bench_context* ctx)
+{
+    uint64_t now = now_us();
+    while (pubnub_get(ctx->pb) != NULL) {
+        continue;
+    }
+    record(ctx, now - ctx->start);
+}
+
+
+/** Records the latencies of the messages received on the
+    subscriber context */
+static void got_messages(struct bench_context* ctx)
+{
+    char const* msg;
+    uint64_t    now = now_us();
+
+    while ((msg = pubnub_get(ctx->sub)) != NULL) {
+        char const* ts = strstr(msg, "\"ts\":");
+        if (ts != NULL) {
+            record(ctx, now - strtoull(ts + 5, NULL, 10));
+        }
+    }
+}
+
+
+static bool gave_up(struct bench_context const* ctx)
+{
+    return ctx->errors > ctx->options->messages;
+}
+
+
+#if defined PUBNUB_CALLBACK_API
+
+static pthread_mutex_t m_lock     = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  m_finished = PTHREAD_COND_INITIALIZER;
+static unsigned        m_running;
+
+
+/* All the callbacks are called from the one C-core thread, so there
+   is no need to guard the bench_context.
+ */
+
+static void check_finished(struct bench_context* ctx)
+{
+    if (!ctx->finished && !ctx->pb_busy && !ctx->sub_busy
+        && ((ctx->done >= ctx->options->messages) || gave_up(ctx))) {
+        ctx->finished = true;
+        pthread_mutex_lock(&m_lock);
+        if (0 == --m_running) {
+            pthread_cond_signal(&m_finished);
+        }
+        pthread_mutex_unlock(&m_lock);
+    }
+}
+
+
+static void start_next(struct bench_context* ctx)
+{
+    while ((ctx->done < ctx->options->messages) && !gave_up(ctx) && !ctx->pb_busy) {
+        if ((bsPubSub == ctx->options->scenario) && (ctx->sent > ctx->done)) {
+            /* Wait for the message to arrive */
+            break;
+        }
+        if (PNR_STARTED == start_op(ctx)) {
+            ctx->pb_busy = true;
+        }
+        else {
+            ++ctx->errors;
+        }
+    }
+}
+
+
+static void start_subscribe(struct bench_context* ctx)
+{
+    while ((ctx->done < ctx->options->messages) && !gave_up(ctx)) {
+        if (PNR_STARTED == pubnub_subscribe(ctx->sub, ctx->channel, NULL)) {
+            ctx->sub_busy = true;
+            break;
+        }
+        ++ctx->errors;
+    }
+}
+
+
+static void pb_callback(pubnub_t*         pb,
+                        enum pubnub_trans trans,
+                        enum pubnub_res   result,
+                        void*             user_data)
+{
+    struct bench_context* ctx = (struct bench_context*)user_data;
+
+    ctx->pb_busy = false;
+    if (PNR_OK != result) {
+        ++ctx->errors;
+    }
+    else if (bsPubSub == ctx->options->scenario) {
+        ++ctx->sent;
+    }
+    else {
+        finish_op(ctx);
+    }
+    start_next(ctx);
+    check_finished(ctx);
+}
+
+
+static void sub_callback(pubnub_t*         pb,
+                         enum pubnub_trans trans,
+                         enum pubnub_res   result,
+                         void*             user_data)
+{
+    struct bench_context* ctx = (struct bench_context*)user_data;
+
+    ctx->sub_busy = false;
+    if (PNR_OK == result) {
+        got_messages(ctx);
+    }
+    else {
+        ++ctx->errors;
+    }
+    start_subscribe(ctx);
+    start_next(ctx);
+    check_finished(ctx);
+}
+
+
+static void run(struct bench_context* ctx, unsigned n)
+{
+    unsigned i;
+
+    pthread_mutex_lock(&m_lock);
+    m_running = n;
+    pthread_mutex_unlock(&m_lock);
+    for (i = 0; i < n; ++i) {
+        pubnub_register_callback(ctx[i].pb, pb_callback, ctx + i);
+        if (bsPubSub == ctx[i].options->scenario) {
+            /* Publishing starts when the subscribe "connects" */
+            pubnub_register_callback(ctx[i].sub, sub_callback, ctx + i);
+            start_subscribe(ctx + i);
+        }
+        else {
+            start_next(ctx + i);
+        }
+        check_finished(ctx + i);
+    }
+    pthread_mutex_lock(&m_lock);
+    while (m_running > 0) {
+        pthread_cond_wait(&m_finished, &m_lock);
+    }
+    pthread_mutex_unlock(&m_lock);
+}
+
+#else
+
+static void* sync_worker(void* arg)
+{
+    struct bench_context* ctx = (struct bench_context*)arg;
+
+    if (bsPubSub == ctx->options->scenario) {
+        /* "Connect" (get the timetoken) first */
+        if ((PNR_STARTED != pubnub_subscribe(ctx->sub, ctx->channel, NULL))
+            || (PNR_OK != pubnub_await(ctx->sub))) {
+            ctx->errors = ctx->options->messages + 1;
+            return NULL;
+        }
+    }
+    while ((ctx->done < ctx->options->messages) && !gave_up(ctx)) {
+        enum pubnub_res res = start_op(ctx);
+        if (PNR_STARTED == res) {
+            res = pubnub_await(ctx->pb);
+        }
+        if (PNR_OK != res) {
+            ++ctx->errors;
+            continue;
+        }
+        if (bsPubSub != ctx->options->scenario) {
+            finish_op(ctx);
+            continue;
+        }
+        ++ctx->sent;
+        while ((ctx->done < ctx->sent) && !gave_up(ctx)) {
+            res = pubnub_subscribe(ctx->sub, ctx->channel, NULL);
+            if (PNR_STARTED == res) {
+                res = pubnub_await(ctx->sub);
+            }
+            if (PNR_OK == res) {
+                got_messages(ctx);
+            }
+            else {
+                ++ctx->errors;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+
+static void run(struct bench_context* ctx, unsigned n)
+{
+    pthread_t* thread = (pthread_t*)calloc(n, sizeof *thread);
+    unsigned   i;
+
+    if (NULL == thread) {
+        fputs("Out of memory\n", stderr);
+        return;
+    }
+    for (i = 0; i < n; ++i) {
+        if (0 != pthread_create(thread + i, NULL, sync_worker, ctx + i)) {
+            fprintf(stderr, "Failed to create thread %u, running it in the main thread\n", i);
+            sync_worker(ctx + i);
+            thread[i] = pthread_self();
+        }
+    }
+    for (i = 0; i < n; ++i) {
+        if (!pthread_equal(thread[i], pthread_self())) {
+            pthread_join(thread[i], NULL);
+        }
+    }
+    free(thread);
+}
+
+#endif /* defined PUBNUB_CALLBACK_API */
+
+
+static int compare_u32(void const* a, void const* b)
+{
+    uint32_t x = *(uint32_t const*)a;
+    uint32_t y = *(uint32_t const*)b;
+    return (x > y) - (x < y);
+}
+
+
+static uint32_t percentile(uint32_t const* sorted, size_t n, double p)
+{
+    return (0 == n) ? 0 : sorted[(size_t)(p * (n - 1))];
+}
+
+
+static double timeval_us(struct timeval const* tv)
+{
+    return tv->tv_sec * 1e6 + tv->tv_usec;
+}
+
+
+static void report(struct bench_options const* options,
+                   struct bench_context const* ctx,
+                   uint64_t                    duration,
+                   struct rusage const*        before,
+                   struct rusage const*        after)
+{
+    size_t    total  = 0;
+    unsigned  errors = 0;
+    uint32_t* all;
+    unsigned  i;
+    double    user   = timeval_us(&after->ru_utime) - timeval_us(&before->ru_utime);
+    double    system = timeval_us(&after->ru_stime) - timeval_us(&before->ru_stime);
+
+    for (i = 0; i < options->contexts; ++i) {
+        total += ctx[i].done;
+        errors += ctx[i].errors;
+    }
+    all = (uint32_t*)malloc((total + 1) * sizeof *all);
+    if (NULL == all) {
+        fputs("Out of memory\n", stderr);
+        return;
+    }
+    total = 0;
+    for (i = 0; i < options->contexts; ++i) {
+        memcpy(all + total, ctx[i].latency, ctx[i].done * sizeof *all);
+        total += ctx[i].done;
+    }
+    qsort(all, total, sizeof *all, compare_u32);
+
+    printf("scenario: %s, mode: %s, contexts: %u, messages: %u each, payload: %u, "
+           "tls: %s, gzip: %s, chunked: %s\n",
+           m_scenario_name[options->scenario],
+           BENCH_MODE,
+           options->contexts,
+           options->messages,
+           options->payload,
+           options->tls ? "yes" : "no",
+           options->gzip ? "yes" : "no",
+           options->chunked ? "yes" : "no");
+    printf("messages:     %lu (errors: %u)\n", (unsigned long)total, errors);
+    printf("duration:     %.3f s\n", duration / 1e6);
+    printf("throughput:   %.1f msgs/sec\n", (duration > 0) ? total * 1e6 / duration : 0.0);
+    printf("latency (us): p50 %u  p99 %u  p999 %u  max %u\n",
+           percentile(all, total, 0.5),
+           percentile(all, total, 0.99),
+           percentile(all, total, 0.999),
+           percentile(all, total, 1.0));
+    if (total > 0) {
+        printf("CPU per msg:  %.1f us (user %.1f + system %.1f)\n",
+               (user + system) / total,
+               user / total,
+               system / total);
+    }
+    printf("max RSS:      %ld KB\n", after->ru_maxrss);
+
+    free(all);
+}
+
+
+static void usage(char const* name)
+{
+    printf("Usage: %s [options]\n"
+           "  -c N    number of contexts (default 10)\n"
+           "  -n N    number of messages (operations) per context (default 1000)\n"
+           "  -s S    scenario: publish, pubsub, history or presence (default pubsub)\n"
+           "  -b N    payload (padding) of each message, in bytes (default 0, max %d)\n"
+           "  -t      use TLS (only if built with OpenSSL)\n"
+           "  -z      mock server gzips the replies\n"
+           "  -k      mock server uses chunked transfer encoding\n"
+           "  -p N    port for the mock server (default: any free port)\n"
+           "  -S      only run the mock server (in the foreground)\n",
+           name,
+           MAX_PAYLOAD);
+}
+
+
+static int parse_options(int argc, char* argv[], struct bench_options* options)
+{
+    int opt;
+
+    memset(options, 0, sizeof *options);
+    options->contexts = 10;
+    options->messages = 1000;
+    options->scenario = bsPubSub;
+    while ((opt = getopt(argc, argv, "c:n:s:b:tzkp:Sh")) != -1) {
+        switch (opt) {
+        case 'c':
+            options->contexts = (unsigned)strtoul(optarg, NULL, 10);
+            break;
+        case 'n':
+            options->messages = (unsigned)strtoul(optarg, NULL, 10);
+            break;
+        case 's': {
+            unsigned i;
+            for (i = 0; i < sizeof m_scenario_name / sizeof m_scenario_name[0]; ++i) {
+                if (0 == strcmp(optarg, m_scenario_name[i])) {
+                    break;
+                }
+            }
+            if (i == sizeof m_scenario_name / sizeof m_scenario_name[0]) {
+                fprintf(stderr, "Unknown scenario '%s'\n", optarg);
+                return -1;
+            }
+            options->scenario = (enum bench_scenario)i;
+            break;
+        }
+        case 'b':
+            options->payload = (unsigned)strtoul(optarg, NULL, 10);
+            break;
+        case 't':
+            options->tls = true;
+            break;
+        case 'z':
+            options->gzip = true;
+            break;
+        case 'k':
+            options->chunked = true;
+            break;
+        case 'p':
+            options->port = (uint16_t)strtoul(optarg, NULL, 10);
+            break;
+        case 'S':
+            options->serve_only = true;
+            break;
+        default:
+            return -1;
+        }
+    }
+    if ((0 == options->contexts) || (0 == options->messages)
+        || (options->payload > MAX_PAYLOAD)) {
+        return -1;
+    }
+#if !PUBNUB_USE_SSL
+    if (options->tls) {
+        fputs("TLS is not supported in this build\n", stderr);
+        return -1;
+    }
+#endif
+
+    return 0;
+}
+
+
+int main(int argc, char* argv[])
+{
+    struct bench_options              options;
+    struct pubnub_mock_server_options server_options;
+    struct pubnub_mock_server*        server;
+    struct bench_context*             ctx;
+    struct rusage                     before;
+    struct rusage                     after;
+    uint64_t                          start;
+    uint64_t                          duration;
+    pid_t                             pid;
+    unsigned                          i;
+
+    if (0 != parse_options(argc, argv, &options)) {
+        usage(argv[0]);
+        return -1;
+    }
+
+    memset(&server_options, 0, sizeof server_options);
+    server_options.tls     = options.tls;
+    server_options.gzip    = options.gzip;
+    server_options.chunked = options.chunked;
+    server = pubnub_mock_server_create(options.port, &server_options);
+    if (NULL == server) {
+        fputs("Failed to create the mock server\n", stderr);
+        return -1;
+    }
+    options.port = pubnub_mock_server_port(server);
+    m_cert_pem   = pubnub_mock_server_cert_pem(server);
+    if (options.serve_only) {
+        printf("Mock Pubnub server listening on 127.0.0.1:%u\n", options.port);
+        if (m_cert_pem != NULL) {
+            fputs(m_cert_pem, stdout);
+        }
+        fflush(stdout);
+        return pubnub_mock_server_run(server);
+    }
+
+    ctx = (struct bench_context*)calloc(options.contexts, sizeof *ctx);
+    if (NULL == ctx) {
+        fputs("Out of memory\n", stderr);
+        return -1;
+    }
+    for (i = 0; i < options.contexts; ++i) {
+        ctx[i].options = &options;
+        snprintf(ctx[i].channel, sizeof ctx[i].channel, "bench-%u", i);
+        if (bsHistory == options.scenario) {
+            unsigned j;
+            for (j = 0; j < HISTORY_SEED; ++j) {
+                pubnub_mock_server_publish(server, ctx[i].channel, "{\"ts\":0}");
+            }
+        }
+    }
+
+    /* Fork before allocating any contexts, so that the mock server
+       doesn't inherit C-core's threads (or their state) */
+    fflush(stdout);
+    pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return -1;
+    }
+    if (0 == pid) {
+        pubnub_mock_server_run(server);
+        _exit(1);
+    }
+
+    for (i = 0; i < options.contexts; ++i) {
+        char uuid[32];
+        snprintf(uuid, sizeof uuid, "bench-pub-%u", i);
+        ctx[i].pb = make_context(&options, uuid);
+        if (bsPubSub == options.scenario) {
+            snprintf(uuid, sizeof uuid, "bench-sub-%u", i);
+            ctx[i].sub = make_context(&options, uuid);
+        }
+        ctx[i].latency = (uint32_t*)malloc(options.messages * sizeof *ctx[i].latency);
+        if ((NULL == ctx[i].pb) || ((bsPubSub == options.scenario) && (NULL == ctx[i].sub))
+            || (NULL == ctx[i].latency)) {
+            fputs("Failed to allocate a context\n", stderr);
+            kill(pid, SIGTERM);
+            return -1;
+        }
+    }
+
+    getrusage(RUSAGE_SELF, &before);
+    start = now_us();
+    run(ctx, options.contexts);
+    duration = now_us() - start;
+    getrusage(RUSAGE_SELF, &after);
+
+    report(&options, ctx, duration, &before, &after);
+
+    for (i = 0; i < options.contexts; ++i) {
+        free_context(ctx[i].pb);
+        if (ctx[i].sub != NULL) {
+            free_context(ctx[i].sub);
+        }
+        free(ctx[i].latency);
+    }
+    free(ctx);
+    kill(pid, SIGTERM);
+    waitpid(pid, NULL, 0);
+
+    return 0;
+}
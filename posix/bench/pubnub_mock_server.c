@@ -0,0 +1,900 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "pubnub_mock_server.h"
+
+#include "pubnub_config.h"
+
+#if PUBNUB_USE_SSL
+#include <openssl/err.h>
+#include <openssl/pem.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+#endif
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+
+/** How many (last) published messages are kept */
+#define MESSAGE_RING 1024
+
+/** Maximum length of a (URL decoded) message */
+#define MAX_MESSAGE 2048
+
+/** Maximum length of a channel name */
+#define MAX_CHANNEL 92
+
+/** Maximum number of messages in a subscribe or history reply */
+#define MAX_REPLY_MESSAGES 100
+
+/** Maximum length of a request (line and headers) */
+#define MAX_REQUEST 8192
+
+/** Size of the chunks when sending with chunked encoding */
+#define CHUNK_SIZE 512
+
+/** Maximum number of segments in a path we care about */
+#define MAX_SEGMENTS 10
+
+
+struct stored_message {
+    uint64_t timetoken;
+    char     channel[MAX_CHANNEL + 1];
+    char     text[MAX_MESSAGE + 1];
+};
+
+
+struct pubnub_mock_server {
+    int                               listen_fd;
+    uint16_t                          port;
+    struct pubnub_mock_server_options options;
+
+    /** Guards the messages and the timetoken */
+    pthread_mutex_t lock;
+    /** Signalled when a message is published */
+    pthread_cond_t published;
+    /** The last timetoken given out */
+    uint64_t timetoken;
+    /** Number of messages published so far (the last MESSAGE_RING
+        are in the `message` ring) */
+    uint64_t              message_count;
+    struct stored_message message[MESSAGE_RING];
+
+#if PUBNUB_USE_SSL
+    SSL_CTX* ssl_ctx;
+    char*    cert_pem;
+#endif
+};
+
+
+/** A growable byte buffer */
+struct buffer {
+    char*  data;
+    size_t len;
+    size_t cap;
+};
+
+
+struct connection {
+    struct pubnub_mock_server* server;
+    int                        fd;
+#if PUBNUB_USE_SSL
+    SSL* ssl;
+#endif
+    char   request[MAX_REQUEST + 1];
+    size_t len;
+};
+
+
+/** A parsed request */
+struct request {
+    /** URL decoded path segments */
+    char*    segment[MAX_SEGMENTS];
+    unsigned segments;
+    char     uuid[MAX_CHANNEL + 1];
+    bool     accepts_gzip;
+    bool     close;
+};
+
+
+static uint32_t m_crc_table[256];
+
+
+static void init_crc_table(void)
+{
+    uint32_t i;
+    for (i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        int      k;
+        for (k = 0; k < 8; ++k) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        m_crc_table[i] = c;
+    }
+}
+
+
+static uint32_t crc32(uint8_t const* data, size_t n)
+{
+    uint32_t c = 0xFFFFFFFFu;
+    while (n-- > 0) {
+        c = m_crc_table[(c ^ *data++) & 0xFF] ^ (c >> 8);
+    }
+    return c ^ 0xFFFFFFFFu;
+}
+
+
+static void buf_put(struct buffer* b, void const* data, size_t n)
+{
+    if (b->len + n + 1 > b->cap) {
+        size_t cap  = (b->cap == 0) ? 1024 : b->cap;
+        char*  grow;
+        while (b->len + n + 1 > cap) {
+            cap *= 2;
+        }
+        grow = (char*)realloc(b->data, cap);
+        if (NULL == grow) {
+            abort();
+        }
+        b->data = grow;
+        b->cap  = cap;
+    }
+    memcpy(b->data + b->len, data, n);
+    b->len += n;
+    b->data[b->len] = '\0';
+}
+
+
+static void buf_str(struct buffer* b, char const* s)
+{
+    buf_put(b, s, strlen(s));
+}
+
+
+static void buf_printf(struct buffer* b, char const* fmt, ...)
+{
+    char    s[256];
+    int     n;
+    va_list args;
+
+    va_start(args, fmt);
+    n = vsnprintf(s, sizeof s, fmt, args);
+    va_end(args);
+    if (n > 0) {
+        buf_put(b, s, ((size_t)n < sizeof s) ? (size_t)n : sizeof s - 1);
+    }
+}
+
+
+static void put_le(struct buffer* b, uint32_t v, unsigned bytes)
+{
+    uint8_t  le[4];
+    unsigned i;
+    for (i = 0; i < bytes; ++i) {
+        le[i] = (uint8_t)(v >> (8 * i));
+    }
+    buf_put(b, le, bytes);
+}
+
+
+/** Puts the gzip format of @p data into @p out, using "stored"
+    deflate blocks (no compression at all, but that's fine for
+    testing the client side).
+ */
+static void gzip_stored(struct buffer* out, char const* data, size_t n)
+{
+    static uint8_t const header[] = { 0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 3 };
+    size_t               done     = 0;
+
+    buf_put(out, header, sizeof header);
+    do {
+        size_t  block = ((n - done) > 65535) ? 65535 : (n - done);
+        uint8_t final = (done + block == n) ? 1 : 0;
+        buf_put(out, &final, 1);
+        put_le(out, (uint32_t)block, 2);
+        put_le(out, (uint32_t)(~block & 0xFFFF), 2);
+        buf_put(out, data + done, block);
+        done += block;
+    } while (done < n);
+    put_le(out, crc32((uint8_t const*)data, n), 4);
+    put_le(out, (uint32_t)n, 4);
+}
+
+
+static int hex_digit(char c)
+{
+    if ((c >= '0') && (c <= '9')) {
+        return c - '0';
+    }
+    if ((c >= 'a') && (c <= 'f')) {
+        return c - 'a' + 10;
+    }
+    if ((c >= 'A') && (c <= 'F')) {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+
+/** URL decodes @p s in place */
+static void url_decode(char* s)
+{
+    char* to = s;
+    for (; *s != '\0'; ++s) {
+        if ((*s == '%') && (hex_digit(s[1]) >= 0) && (hex_digit(s[2]) >= 0)) {
+            *to++ = (char)(hex_digit(s[1]) * 16 + hex_digit(s[2]));
+            s += 2;
+        }
+        else {
+            *to++ = *s;
+        }
+    }
+    *to = '\0';
+}
+
+
+static bool header_has(char const* headers, char const* name, char const* token)
+{
+    size_t      name_len = strlen(name);
+    char const* line     = headers;
+
+    while ((line = strstr(line, "\r\n")) != NULL) {
+        line += 2;
+        if (0 == strncasecmp(line, name, name_len) && (line[name_len] == ':')) {
+            char const* end = strstr(line, "\r\n");
+            char const* val = line + name_len + 1;
+            size_t      tok = strlen(token);
+            for (; (end != NULL) && (val + tok <= end); ++val) {
+                if (0 == strncasecmp(val, token, tok)) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+
+/** Parses the request line and headers in @p text (which is
+    modified, segments point into it). Returns -1 on error.
+ */
+static int parse_request(char* text, struct request* req)
+{
+    char*    target;
+    char*    end;
+    char*    query;
+    char*    s;
+    unsigned i;
+
+    memset(req, 0, sizeof *req);
+    if (0 != strncmp(text, "GET ", 4)) {
+        return -1;
+    }
+    req->accepts_gzip = header_has(text, "Accept-Encoding", "gzip");
+    req->close        = header_has(text, "Connection", "close");
+
+    target = text + 4;
+    end    = strchr(target, ' ');
+    if (NULL == end) {
+        return -1;
+    }
+    *end = '\0';
+    /* As a HTTP GET proxy, we get absolute URIs */
+    if ((0 == strncmp(target, "http://", 7)) || (0 == strncmp(target, "https://", 8))) {
+        target = strchr(strstr(target, "://") + 3, '/');
+        if (NULL == target) {
+            return -1;
+        }
+    }
+    query = strchr(target, '?');
+    if (query != NULL) {
+        *query++ = '\0';
+        s        = strstr(query, "uuid=");
+        if (s != NULL) {
+            size_t n = strcspn(s + 5, "&");
+            if (n > MAX_CHANNEL) {
+                n = MAX_CHANNEL;
+            }
+            memcpy(req->uuid, s + 5, n);
+            req->uuid[n] = '\0';
+            url_decode(req->uuid);
+        }
+    }
+    for (s = target; (*s == '/') && (req->segments < MAX_SEGMENTS);) {
+        *s++                          = '\0';
+        req->segment[req->segments++] = s;
+        s += strcspn(s, "/");
+    }
+    *s = '\0';
+    for (i = 0; i < req->segments; ++i) {
+        url_decode(req->segment[i]);
+    }
+
+    return 0;
+}
+
+
+static bool segment_is(struct request const* req, unsigned i, char const* s)
+{
+    return (i < req->segments) && (0 == strcmp(req->segment[i], s));
+}
+
+
+static bool channel_in_list(char const* channel, char const* list)
+{
+    size_t n = strlen(channel);
+    while (*list != '\0') {
+        size_t len = strcspn(list, ",");
+        if ((len == n) && (0 == strncmp(list, channel, n))) {
+            return true;
+        }
+        list += len;
+        if (*list == ',') {
+            ++list;
+        }
+    }
+    return false;
+}
+
+
+uint64_t pubnub_mock_server_publish(struct pubnub_mock_server* server,
+                                    char const*                channel,
+                                    char const*                text)
+{
+    struct stored_message* msg;
+    uint64_t               tt;
+
+    pthread_mutex_lock(&server->lock);
+    tt             = ++server->timetoken;
+    msg            = server->message + (server->message_count++ % MESSAGE_RING);
+    msg->timetoken = tt;
+    snprintf(msg->channel, sizeof msg->channel, "%s", channel);
+    snprintf(msg->text, sizeof msg->text, "%s", text);
+    pthread_cond_broadcast(&server->published);
+    pthread_mutex_unlock(&server->lock);
+
+    return tt;
+}
+
+
+/** Puts the messages published after @p since on any of the
+    @p channels (comma separated list) to the @p body, as a JSON
+    array (and their channels, comma separated, to @p channels, if
+    it's not NULL). Sets @p last to the timetoken of the last
+    message put. Has to be called with the server locked.
+    @return Number of messages put
+ */
+static unsigned put_messages(struct pubnub_mock_server* server,
+                             uint64_t                   since,
+                             char const*                list,
+                             struct buffer*             body,
+                             struct buffer*             channels,
+                             uint64_t*                  last)
+{
+    uint64_t i     = (server->message_count > MESSAGE_RING)
+                         ? server->message_count - MESSAGE_RING
+                         : 0;
+    unsigned count = 0;
+
+    buf_str(body, "[");
+    for (; (i < server->message_count) && (count < MAX_REPLY_MESSAGES); ++i) {
+        struct stored_message const* msg = server->message + (i % MESSAGE_RING);
+        if ((msg->timetoken <= since) || !channel_in_list(msg->channel, list)) {
+            continue;
+        }
+        if (count++ > 0) {
+            buf_str(body, ",");
+            if (channels != NULL) {
+                buf_str(channels, ",");
+            }
+        }
+        buf_str(body, msg->text);
+        *last = msg->timetoken;
+        if (channels != NULL) {
+            buf_str(channels, msg->channel);
+        }
+    }
+    buf_str(body, "]");
+
+    return count;
+}
+
+
+static void wait_for_message(struct pubnub_mock_server* server,
+                             uint64_t                   since,
+                             char const*                list)
+{
+    struct timespec deadline;
+    uint64_t        seen = (server->message_count > MESSAGE_RING)
+                               ? server->message_count - MESSAGE_RING
+                               : 0;
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += server->options.long_poll_ms / 1000;
+    deadline.tv_nsec += (server->options.long_poll_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_nsec -= 1000000000L;
+        ++deadline.tv_sec;
+    }
+    for (;;) {
+        uint64_t i;
+        for (i = seen; i < server->message_count; ++i) {
+            struct stored_message const* msg = server->message + (i % MESSAGE_RING);
+            if ((msg->timetoken > since) && channel_in_list(msg->channel, list)) {
+                return;
+            }
+        }
+        seen = server->message_count;
+        if (ETIMEDOUT == pthread_cond_timedwait(&server->published, &server->lock, &deadline)) {
+            return;
+        }
+    }
+}
+
+
+static int subscribe(struct pubnub_mock_server* server,
+                     struct request const*      req,
+                     struct buffer*             body)
+{
+    /* /subscribe/{sub-key}/{channels}/0/{timetoken} */
+    char const*   list;
+    uint64_t      since;
+    uint64_t      last;
+    struct buffer channels = { NULL, 0, 0 };
+
+    if (req->segments < 5) {
+        return 400;
+    }
+    list  = req->segment[2];
+    since = strtoull(req->segment[4], NULL, 10);
+
+    pthread_mutex_lock(&server->lock);
+    if (0 == since) {
+        buf_printf(body, "[[],\"%llu\"]", (unsigned long long)server->timetoken);
+        pthread_mutex_unlock(&server->lock);
+        return 200;
+    }
+    wait_for_message(server, since, list);
+    buf_str(body, "[");
+    if (put_messages(server, since, list, body, &channels, &last) > 0) {
+        buf_printf(body, ",\"%llu\",\"", (unsigned long long)last);
+        buf_put(body, channels.data, channels.len);
+        buf_str(body, "\"]");
+    }
+    else {
+        buf_printf(body, ",\"%llu\"]", (unsigned long long)since);
+    }
+    pthread_mutex_unlock(&server->lock);
+    free(channels.data);
+
+    return 200;
+}
+
+
+static int history(struct pubnub_mock_server* server,
+                   struct request const*      req,
+                   struct buffer*             body)
+{
+    /* /v2/history/sub-key/{sub-key}/channel/{channel} */
+    uint64_t since = 0;
+    uint64_t last  = 0;
+
+    if (req->segments < 6) {
+        return 400;
+    }
+    pthread_mutex_lock(&server->lock);
+    if (server->message_count > MAX_REPLY_MESSAGES) {
+        /* Approximately, the last messages */
+        uint64_t from = server->message_count - MAX_REPLY_MESSAGES;
+        if (server->message_count - from <= MESSAGE_RING) {
+            since = server->message[from % MESSAGE_RING].timetoken - 1;
+        }
+    }
+    buf_str(body, "[");
+    put_messages(server, since, req->segment[5], body, NULL, &last);
+    buf_printf(body,
+               ",%llu,%llu]",
+               (unsigned long long)since,
+               (unsigned long long)last);
+    pthread_mutex_unlock(&server->lock);
+
+    return 200;
+}
+
+
+static int presence(struct request const* req, struct buffer* body)
+{
+    /* /v2/presence/sub-key/{sub-key}/channel/{channel}[/leave|/heartbeat] */
+    if (segment_is(req, 4, "channel") && (req->segments == 6)) {
+        buf_str(body, "{\"status\": 200, \"message\": \"OK\", \"service\": \"Presence\", \"uuids\": [");
+        if (req->uuid[0] != '\0') {
+            buf_printf(body, "\"%s\"", req->uuid);
+        }
+        buf_printf(body, "], \"occupancy\": %d}", (req->uuid[0] != '\0') ? 1 : 0);
+    }
+    else {
+        buf_str(body, "{\"status\": 200, \"message\": \"OK\", \"service\": \"Presence\"}");
+    }
+    return 200;
+}
+
+
+/** Handles the request, putting the reply body to @p body.
+    @return The HTTP status code
+ */
+static int handle(struct pubnub_mock_server* server,
+                  struct request const*      req,
+                  struct buffer*             body)
+{
+    if (segment_is(req, 0, "publish")) {
+        /* /publish/{pub-key}/{sub-key}/0/{channel}/0/{message} */
+        if (req->segments < 7) {
+            return 400;
+        }
+        buf_printf(body,
+                   "[1,\"Sent\",\"%llu\"]",
+                   (unsigned long long)pubnub_mock_server_publish(
+                       server, req->segment[4], req->segment[6]));
+        return 200;
+    }
+    else if (segment_is(req, 0, "subscribe")) {
+        return subscribe(server, req, body);
+    }
+    else if (segment_is(req, 0, "v2") && segment_is(req, 1, "history")) {
+        return history(server, req, body);
+    }
+    else if (segment_is(req, 0, "v2") && segment_is(req, 1, "presence")) {
+        return presence(req, body);
+    }
+    else if (segment_is(req, 0, "time")) {
+        pthread_mutex_lock(&server->lock);
+        buf_printf(body, "[%llu]", (unsigned long long)server->timetoken);
+        pthread_mutex_unlock(&server->lock);
+        return 200;
+    }
+    buf_str(body, "{\"status\": 404, \"error\": true, \"message\": \"Not Found\"}");
+
+    return 404;
+}
+
+
+static int conn_read(struct connection* conn, char* buf, size_t n)
+{
+#if PUBNUB_USE_SSL
+    if (conn->ssl != NULL) {
+        return SSL_read(conn->ssl, buf, (int)n);
+    }
+#endif
+    return (int)recv(conn->fd, buf, n, 0);
+}
+
+
+static int conn_write(struct connection* conn, char const* buf, size_t n)
+{
+    while (n > 0) {
+        int sent;
+#if PUBNUB_USE_SSL
+        if (conn->ssl != NULL) {
+            sent = SSL_write(conn->ssl, buf, (int)n);
+        }
+        else
+#endif
+        {
+            sent = (int)send(conn->fd, buf, n, MSG_NOSIGNAL);
+        }
+        if (sent <= 0) {
+            return -1;
+        }
+        buf += sent;
+        n -= sent;
+    }
+    return 0;
+}
+
+
+static int send_reply(struct connection*    conn,
+                      struct request const* req,
+                      int                   status,
+                      struct buffer const*  body)
+{
+    struct pubnub_mock_server_options const* options = &conn->server->options;
+    struct buffer                            reply   = { NULL, 0, 0 };
+    struct buffer                            gz      = { NULL, 0, 0 };
+    char const*                              content = body->data;
+    size_t                                   length  = body->len;
+    int                                      rslt;
+
+    if (options->gzip && req->accepts_gzip) {
+        gzip_stored(&gz, body->data, body->len);
+        content = gz.data;
+        length  = gz.len;
+    }
+    buf_printf(&reply,
+               "HTTP/1.1 %d %s\r\n"
+               "Content-Type: text/javascript; charset=\"UTF-8\"\r\n"
+               "Connection: %s\r\n",
+               status,
+               (200 == status) ? "OK" : "Error",
+               req->close ? "close" : "keep-alive");
+    if (gz.data != NULL) {
+        buf_str(&reply, "Content-Encoding: gzip\r\n");
+    }
+    if (options->chunked) {
+        size_t done = 0;
+        buf_str(&reply, "Transfer-Encoding: chunked\r\n\r\n");
+        while (done < length) {
+            size_t chunk = ((length - done) > CHUNK_SIZE) ? CHUNK_SIZE : (length - done);
+            buf_printf(&reply, "%x\r\n", (unsigned)chunk);
+            buf_put(&reply, content + done, chunk);
+            buf_str(&reply, "\r\n");
+            done += chunk;
+        }
+        buf_str(&reply, "0\r\n\r\n");
+    }
+    else {
+        buf_printf(&reply, "Content-Length: %lu\r\n\r\n", (unsigned long)length);
+        buf_put(&reply, content, length);
+    }
+    rslt = conn_write(conn, reply.data, reply.len);
+    free(reply.data);
+    free(gz.data);
+
+    return rslt;
+}
+
+
+/** Serves requests on the connection until it is closed */
+static void serve(struct connection* conn)
+{
+    for (;;) {
+        char*          end;
+        struct request req;
+        struct buffer  body = { NULL, 0, 0 };
+        size_t         consumed;
+        int            status;
+
+        while ((end = strstr(conn->request, "\r\n\r\n")) == NULL) {
+            int n;
+            if (conn->len >= MAX_REQUEST) {
+                return;
+            }
+            n = conn_read(conn, conn->request + conn->len, MAX_REQUEST - conn->len);
+            if (n <= 0) {
+                return;
+            }
+#if defined TCP_QUICKACK
+            {
+                /* The C-core sends a request in several small pieces,
+                   so with Nagle's algorithm on its side, our delayed
+                   ACK would stall every request for ~40ms. Linux
+                   turns the "quick ACK" mode off by itself, so it
+                   has to be set after each read. */
+                int on = 1;
+                setsockopt(conn->fd, IPPROTO_TCP, TCP_QUICKACK, &on, sizeof on);
+            }
+#endif
+            conn->len += n;
+            conn->request[conn->len] = '\0';
+        }
+        end[2]   = '\0';
+        consumed = end + 4 - conn->request;
+        if (0 != parse_request(conn->request, &req)) {
+            return;
+        }
+        status = handle(conn->server, &req, &body);
+        if (NULL == body.data) {
+            buf_str(&body, "");
+        }
+        if (0 != send_reply(conn, &req, status, &body) || req.close) {
+            free(body.data);
+            return;
+        }
+        free(body.data);
+        memmove(conn->request, conn->request + consumed, conn->len - consumed + 1);
+        conn->len -= consumed;
+    }
+}
+
+
+static void* connection_thread(void* arg)
+{
+    struct connection* conn = (struct connection*)arg;
+
+#if PUBNUB_USE_SSL
+    if (conn->server->options.tls) {
+        conn->ssl = SSL_new(conn->server->ssl_ctx);
+        if ((conn->ssl != NULL) && (1 == SSL_set_fd(conn->ssl, conn->fd))
+            && (1 == SSL_accept(conn->ssl))) {
+            serve(conn);
+            SSL_shutdown(conn->ssl);
+        }
+        else {
+            ERR_print_errors_fp(stderr);
+        }
+        SSL_free(conn->ssl);
+    }
+    else
+#endif
+    {
+        serve(conn);
+    }
+    close(conn->fd);
+    free(conn);
+
+    return NULL;
+}
+
+
+#if PUBNUB_USE_SSL
+static int setup_tls(struct pubnub_mock_server* server)
+{
+    EVP_PKEY*     pkey = NULL;
+    EVP_PKEY_CTX* kctx;
+    X509*         cert;
+    X509_NAME*    name;
+    BIO*          mem;
+    char*         pem;
+    long          len;
+
+    kctx = EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, NULL);
+    if ((NULL == kctx) || (EVP_PKEY_keygen_init(kctx) <= 0)
+        || (EVP_PKEY_CTX_set_rsa_keygen_bits(kctx, 2048) <= 0)
+        || (EVP_PKEY_keygen(kctx, &pkey) <= 0)) {
+        EVP_PKEY_CTX_free(kctx);
+        return -1;
+    }
+    EVP_PKEY_CTX_free(kctx);
+
+    cert = X509_new();
+    X509_set_version(cert, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), -3600);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 7 * 24 * 3600L);
+    X509_set_pubkey(cert, pkey);
+    name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(
+        name, "CN", MBSTRING_ASC, (unsigned char const*)"127.0.0.1", -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+    if (0 == X509_sign(cert, pkey, EVP_sha256())) {
+        X509_free(cert);
+        EVP_PKEY_free(pkey);
+        return -1;
+    }
+
+    server->ssl_ctx = SSL_CTX_new(TLS_server_method());
+    if ((NULL == server->ssl_ctx) || (1 != SSL_CTX_use_certificate(server->ssl_ctx, cert))
+        || (1 != SSL_CTX_use_PrivateKey(server->ssl_ctx, pkey))) {
+        X509_free(cert);
+        EVP_PKEY_free(pkey);
+        return -1;
+    }
+
+    mem = BIO_new(BIO_s_mem());
+    PEM_write_bio_X509(mem, cert);
+    len              = BIO_get_mem_data(mem, &pem);
+    server->cert_pem = (char*)malloc(len + 1);
+    if (server->cert_pem != NULL) {
+        memcpy(server->cert_pem, pem, len);
+        server->cert_pem[len] = '\0';
+    }
+    BIO_free(mem);
+    X509_free(cert);
+    EVP_PKEY_free(pkey);
+
+    return (NULL == server->cert_pem) ? -1 : 0;
+}
+#endif /* PUBNUB_USE_SSL */
+
+
+struct pubnub_mock_server* pubnub_mock_server_create(
+    uint16_t port, struct pubnub_mock_server_options const* options)
+{
+    struct pubnub_mock_server* server;
+    struct sockaddr_in         addr;
+    socklen_t                  addr_len = sizeof addr;
+    int                        on       = 1;
+
+    server = (struct pubnub_mock_server*)calloc(1, sizeof *server);
+    if (NULL == server) {
+        return NULL;
+    }
+    server->options = *options;
+    if (0 == server->options.long_poll_ms) {
+        server->options.long_poll_ms = 5000;
+    }
+    server->timetoken = (uint64_t)time(NULL) * 10000000ULL;
+    pthread_mutex_init(&server->lock, NULL);
+    pthread_cond_init(&server->published, NULL);
+    init_crc_table();
+
+#if PUBNUB_USE_SSL
+    if (options->tls && (0 != setup_tls(server))) {
+        ERR_print_errors_fp(stderr);
+        free(server);
+        return NULL;
+    }
+#else
+    server->options.tls = false;
+#endif
+
+    server->listen_fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (server->listen_fd < 0) {
+        free(server);
+        return NULL;
+    }
+    setsockopt(server->listen_fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof on);
+    memset(&addr, 0, sizeof addr);
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if ((0 != bind(server->listen_fd, (struct sockaddr*)&addr, sizeof addr))
+        || (0 != listen(server->listen_fd, 1024))
+        || (0 != getsockname(server->listen_fd, (struct sockaddr*)&addr, &addr_len))) {
+        close(server->listen_fd);
+        free(server);
+        return NULL;
+    }
+    server->port = ntohs(addr.sin_port);
+
+    return server;
+}
+
+
+uint16_t pubnub_mock_server_port(struct pubnub_mock_server const* server)
+{
+    return server->port;
+}
+
+
+char const* pubnub_mock_server_cert_pem(struct pubnub_mock_server const* server)
+{
+#if PUBNUB_USE_SSL
+    return server->options.tls ? server->cert_pem : NULL;
+#else
+    (void)server;
+    return NULL;
+#endif
+}
+
+
+int pubnub_mock_server_run(struct pubnub_mock_server* server)
+{
+    for (;;) {
+        pthread_t          thread;
+        struct connection* conn;
+        int                on = 1;
+        int                fd = accept(server->listen_fd, NULL, NULL);
+
+        if (fd < 0) {
+            if ((EINTR == errno) || (ECONNABORTED == errno)) {
+                continue;
+            }
+            return -1;
+        }
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof on);
+        conn = (struct connection*)calloc(1, sizeof *conn);
+        if (NULL == conn) {
+            close(fd);
+            continue;
+        }
+        conn->server = server;
+        conn->fd     = fd;
+        if (0 != pthread_create(&thread, NULL, connection_thread, conn)) {
+            close(fd);
+            free(conn);
+            continue;
+        }
+        pthread_detach(thread);
+    }
+}
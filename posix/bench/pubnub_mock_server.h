@@ -0,0 +1,100 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PUBNUB_MOCK_SERVER
+#define INC_PUBNUB_MOCK_SERVER
+
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/** @file pubnub_mock_server.h
+
+    A minimal, self-contained, mock Pubnub server, for load testing
+    and benchmarking of the C-core on a single machine, without any
+    network (latency) or the Pubnub network itself getting in the way.
+
+    It listens on the loopback interface only and speaks just enough
+    of the Pubnub REST protocol for the C-core:
+
+    - publish (messages are kept in memory, in a fixed size ring)
+    - subscribe, long-polling until a message is published on one of
+      the channels, or the long-poll times out
+    - history (v2)
+    - presence (v2): here-now, heartbeat, leave (and answers all other
+      presence requests with a "success" JSON object)
+    - time
+
+    Each connection is served by its own thread, with HTTP keep-alive.
+    Replies may be sent with chunked transfer encoding and/or gzip
+    content encoding, to exercise those paths of the C-core. Gzip
+    is done with "stored" (uncompressed) deflate blocks, so there is
+    no dependency on a compression library.
+
+    Since the C-core always connects to the port 80 (443 for TLS) of
+    the origin, the mock server is to be used as a HTTP GET proxy:
+    pubnub_set_proxy_manual(pb, pbproxyHTTP_GET, "127.0.0.1", port).
+
+    If built with PUBNUB_USE_SSL (with OpenSSL), it can serve over
+    TLS, with a self-signed certificate generated on creation, which
+    the client should trust via pubnub_ssl_set_usrdef_pem_cert().
+ */
+
+
+/** Options of the mock server */
+struct pubnub_mock_server_options {
+    /** Send replies with "Transfer-Encoding: chunked" */
+    bool chunked;
+    /** Send gzipped replies, to clients that accept them */
+    bool gzip;
+    /** Serve over TLS (ignored if not built with PUBNUB_USE_SSL) */
+    bool tls;
+    /** How long does a subscribe long-poll wait for a message, in
+        milliseconds */
+    unsigned long_poll_ms;
+};
+
+
+struct pubnub_mock_server;
+
+
+/** Creates a mock server listening on the loopback interface, on
+    the given @p port (0 means: any free port), with the given
+    @p options. In TLS mode, also generates the key and the
+    self-signed certificate.
+
+    Connections are not accepted until pubnub_mock_server_run() is
+    called, so one can create the server and then fork() to run it
+    in a child process.
+
+    @return The server, or NULL on failure
+ */
+struct pubnub_mock_server* pubnub_mock_server_create(
+    uint16_t port, struct pubnub_mock_server_options const* options);
+
+/** Returns the port the @p server listens on */
+uint16_t pubnub_mock_server_port(struct pubnub_mock_server const* server);
+
+/** Returns the certificate of the @p server in PEM format, or NULL
+    if it doesn't serve over TLS.
+ */
+char const* pubnub_mock_server_cert_pem(struct pubnub_mock_server const* server);
+
+/** Publishes the message @p text (JSON) on the @p channel, as if a
+    client published it. Can be used to seed the history before
+    running the @p server.
+
+    @return The timetoken of the message
+ */
+uint64_t pubnub_mock_server_publish(struct pubnub_mock_server* server,
+                                    char const*                channel,
+                                    char const*                text);
+
+/** Accepts and serves connections, each in its own thread. Doesn't
+    return unless accepting fails.
+
+    @return -1 (accept failed)
+ */
+int pubnub_mock_server_run(struct pubnub_mock_server* server);
+
+
+#endif /* !defined INC_PUBNUB_MOCK_SERVER */
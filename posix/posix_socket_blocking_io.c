@@ -13,7 +13,7 @@ int pbpal_set_socket_blocking_io(pbpal_native_socket_t socket, int use_blocking_
     if (-1 == flags) {
         flags = 0;
     }
-    fcntl((int)socket, F_SETFL, flags | (use_blocking_io ? 0 : O_NONBLOCK));
+    fcntl((int)socket, F_SETFL, use_blocking_io ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK));
 
     flags = fcntl((int)socket, F_GETFL, 0);
     PUBNUB_LOG_TRACE("pbpal_set_socket_blocking_io(): after - flags = %X, flags&NONBLOCK = %X\n", flags, flags & O_NONBLOCK);
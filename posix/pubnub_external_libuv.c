@@ -0,0 +1,174 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "pubnub_external_libuv.h"
+
+#include "pubnub_internal.h"
+#include "core/pubnub_assert.h"
+#include "core/pubnub_log.h"
+
+#include <stdlib.h>
+
+
+/** The libuv poll handle watching the socket of a context */
+struct UvWatched {
+    uv_poll_t             poll;
+    pubnub_t*             pb;
+    pbpal_native_socket_t socket;
+    struct UvWatched*     next;
+};
+
+
+static uv_loop_t*        m_loop;
+static uv_timer_t        m_timer;
+static struct UvWatched* m_watched;
+
+
+static void on_closed(uv_handle_t* handle)
+{
+    free(handle->data);
+}
+
+
+static void on_poll(uv_poll_t* handle, int status, int events)
+{
+    struct UvWatched* w  = (struct UvWatched*)handle->data;
+    int               ev = pbwatchNONE;
+
+    if (status < 0) {
+        /* Let the FSM find out what's wrong with the socket */
+        ev = pbwatchIN | pbwatchOUT;
+    }
+    else {
+        if (events & UV_READABLE) {
+            ev |= pbwatchIN;
+        }
+        if (events & UV_WRITABLE) {
+            ev |= pbwatchOUT;
+        }
+    }
+    pubnub_process_ready(w->pb, ev);
+    pubnub_external_libuv_rearm();
+}
+
+
+static void on_timer(uv_timer_t* timer)
+{
+    PUBNUB_UNUSED(timer);
+    pubnub_process_pending();
+    pubnub_external_libuv_rearm();
+}
+
+
+static struct UvWatched** find_watched(pubnub_t* pb)
+{
+    struct UvWatched** link = &m_watched;
+    while ((*link != NULL) && ((*link)->pb != pb)) {
+        link = &(*link)->next;
+    }
+    return link;
+}
+
+
+static void unwatch(struct UvWatched** link)
+{
+    struct UvWatched* w = *link;
+    *link               = w->next;
+    uv_close((uv_handle_t*)&w->poll, on_closed);
+}
+
+
+static void watcher(pubnub_t* pb, void* user_data)
+{
+    int                   events = pubnub_watched_events(pb);
+    pbpal_native_socket_t socket = pubnub_get_native_socket(pb);
+    struct UvWatched**    link   = find_watched(pb);
+
+    PUBNUB_UNUSED(user_data);
+
+    if ((*link != NULL)
+        && ((pbwatchNONE == events) || ((*link)->socket != socket))) {
+        /* A poll handle can't be moved to another socket */
+        unwatch(link);
+        link = find_watched(pb);
+    }
+    if (events != pbwatchNONE) {
+        struct UvWatched* w    = *link;
+        int               uvev = 0;
+        int               rslt;
+
+        if (NULL == w) {
+            w = (struct UvWatched*)malloc(sizeof *w);
+            if (NULL == w) {
+                PUBNUB_LOG_ERROR("pb=%p: Failed to allocate a poll handle\n", pb);
+                pubnub_external_libuv_rearm();
+                return;
+            }
+            rslt = uv_poll_init(m_loop, &w->poll, socket);
+            if (rslt != 0) {
+                PUBNUB_LOG_ERROR("pb=%p: uv_poll_init(socket=%d) failed: %s\n",
+                                 pb, socket, uv_strerror(rslt));
+                free(w);
+                pubnub_external_libuv_rearm();
+                return;
+            }
+            w->poll.data = w;
+            w->pb        = pb;
+            w->socket    = socket;
+            w->next      = m_watched;
+            m_watched    = w;
+        }
+        if (events & pbwatchIN) {
+            uvev |= UV_READABLE;
+        }
+        if (events & pbwatchOUT) {
+            uvev |= UV_WRITABLE;
+        }
+        rslt = uv_poll_start(&w->poll, uvev, on_poll);
+        if (rslt != 0) {
+            PUBNUB_LOG_ERROR("pb=%p: uv_poll_start(socket=%d) failed: %s\n",
+                             pb, socket, uv_strerror(rslt));
+        }
+    }
+    pubnub_external_libuv_rearm();
+}
+
+
+int pubnub_external_libuv_start(uv_loop_t* loop)
+{
+    int rslt;
+
+    PUBNUB_ASSERT_OPT(loop != NULL);
+
+    rslt = uv_timer_init(loop, &m_timer);
+    if (rslt != 0) {
+        PUBNUB_LOG_ERROR("uv_timer_init() failed: %s\n", uv_strerror(rslt));
+        return -1;
+    }
+    m_loop    = loop;
+    m_watched = NULL;
+    pubnub_register_watcher(watcher, NULL);
+
+    return 0;
+}
+
+
+void pubnub_external_libuv_stop(void)
+{
+    pubnub_register_watcher(NULL, NULL);
+    while (m_watched != NULL) {
+        unwatch(&m_watched);
+    }
+    uv_timer_stop(&m_timer);
+    uv_close((uv_handle_t*)&m_timer, NULL);
+}
+
+
+void pubnub_external_libuv_rearm(void)
+{
+    int ms = pubnub_next_timeout_ms();
+    if (ms < 0) {
+        uv_timer_stop(&m_timer);
+    }
+    else {
+        uv_timer_start(&m_timer, on_timer, ms, 0);
+    }
+}
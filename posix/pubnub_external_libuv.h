@@ -0,0 +1,45 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PUBNUB_EXTERNAL_LIBUV
+#define INC_PUBNUB_EXTERNAL_LIBUV
+
+
+#include "pubnub_ntf_external.h"
+
+#include <uv.h>
+
+
+/** @file pubnub_external_libuv.h
+    This is an adapter of the "external event loop" interface (see
+    pubnub_ntf_external.h) to libuv. It registers the watcher and
+    drives the contexts from a libuv loop: the socket of each context
+    is watched by a `uv_poll_t` and a `uv_timer_t` calls
+    pubnub_process_pending() when needed. So, callbacks are called
+    from the thread that runs the loop.
+
+    Build it with `make -f posix.mk USE_LIBUV=1`, it is then a part of
+    `pubnub_external.a` (and you need to link with `-luv`).
+*/
+
+
+/** Starts driving the C-core from the libuv @p loop. Call it (once)
+    before starting any transaction, from the thread of the loop.
+    @retval 0 success
+    @retval -1 failed to initialize (libuv error)
+ */
+int pubnub_external_libuv_start(uv_loop_t* loop);
+
+/** Stops driving the C-core from the libuv loop. All contexts should
+    be idle (or freed) by now. The handles are closed, so run the loop
+    once more to let them finish closing.
+ */
+void pubnub_external_libuv_stop(void);
+
+/** Re-arms the timer of the libuv adapter. The adapter does this by
+    itself on any change in the C-core, but, if you start transactions
+    (or cancel them) from some other thread than the one of the loop,
+    call this (via uv_async_send(), for example) afterwards.
+ */
+void pubnub_external_libuv_rearm(void);
+
+
+#endif /* !defined INC_PUBNUB_EXTERNAL_LIBUV */
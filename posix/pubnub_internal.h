@@ -35,6 +35,11 @@ typedef int pb_socket_t;
 
 #define socket_timed_out() (errno == ETIMEDOUT)
 
+/** Whether the peer closed (or reset) the connection, given the
+    @p result of a send or receive that failed */
+#define socket_closed_by_peer(result)                                          \
+    ((0 == (result)) || (errno == ECONNRESET) || (errno == EPIPE))
+
 #define socket_platform_init() 0
 
 #define SOCKET_INVALID -1
@@ -0,0 +1,56 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "core/pubnub_log_async.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <time.h>
+
+
+static pthread_t m_thread;
+
+static bool m_running;
+
+static int m_stop;
+
+
+static void* drain_thread(void* arg)
+{
+    (void)arg;
+    while (!__atomic_load_n(&m_stop, __ATOMIC_ACQUIRE)) {
+        if (0 == pubnub_log_async_drain()) {
+            struct timespec ts;
+            ts.tv_sec  = PUBNUB_LOG_ASYNC_DRAIN_MS / 1000;
+            ts.tv_nsec = (PUBNUB_LOG_ASYNC_DRAIN_MS % 1000) * 1000000L;
+            nanosleep(&ts, NULL);
+        }
+    }
+    pubnub_log_async_drain();
+
+    return NULL;
+}
+
+
+int pubnub_log_async_start(void)
+{
+    if (m_running) {
+        return 0;
+    }
+    __atomic_store_n(&m_stop, 0, __ATOMIC_RELEASE);
+    if (pthread_create(&m_thread, NULL, drain_thread, NULL) != 0) {
+        return -1;
+    }
+    m_running = true;
+
+    return 0;
+}
+
+
+void pubnub_log_async_stop(void)
+{
+    if (!m_running) {
+        return;
+    }
+    __atomic_store_n(&m_stop, 1, __ATOMIC_RELEASE);
+    pthread_join(m_thread, NULL);
+    m_running = false;
+}
@@ -9,7 +9,7 @@
 #include "core/pubnub_timer_list.h"
 #include "core/pbpal.h"
 
-#include "lib/sockets/pbpal_ntf_callback_poller_poll.h"
+#include "core/pbpal_ntf_callback_poller.h"
 #include "core/pbpal_ntf_callback_queue.h"
 #include "core/pbpal_ntf_callback_handle_timer_list.h"
 
@@ -82,6 +82,7 @@ void* socket_watcher_thread(void* arg)
                                      
                         );
                 }
+                PBMETRICS_OBSERVE(pbmhPollLoopLag, elapsed);
                 pthread_mutex_lock(&m_watcher.timerlock);
                 pbntf_handle_timer_list(elapsed, &m_watcher.timer_head);
                 pthread_mutex_unlock(&m_watcher.timerlock);
@@ -0,0 +1,97 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#if !defined INC_PUBNUB_NTF_EXTERNAL
+#define INC_PUBNUB_NTF_EXTERNAL
+
+
+#include "core/pubnub_ntf_callback.h"
+
+#include "pubnub_get_native_socket.h"
+
+
+/** @file pubnub_ntf_external.h
+    This is the "external event loop" variant of the "callback"
+    interface. The "callback" interface has a thread of its own, that
+    waits for the sockets of all the contexts and calls the callbacks.
+    In this variant, there is no such thread. Instead, the C-core is
+    driven by your event loop (epoll, libuv...):
+
+    - it tells you (calls the "watcher" you register with
+      pubnub_register_watcher()) when the socket of a context, or the
+      events to watch it for, change. You get them with
+      pubnub_get_native_socket() and pubnub_watched_events() and
+      (re)arm your loop for them.
+    - when the socket is ready, you call pubnub_process_ready(),
+      which drives the context and calls its callback
+    - you call pubnub_process_pending() when the time returned by
+      pubnub_next_timeout_ms() elapses, to handle transaction
+      timeouts, cancelling, freeing of contexts and such.
+
+    So, callbacks are called from your loop, in its thread, without
+    a thread switch.
+
+    Other than that, use it just like the "callback" interface (see
+    pubnub_ntf_callback.h). Link with `pubnub_external.a` instead of
+    `pubnub_callback.a`.
+
+    Start transactions (and cancel them, free contexts...) from the
+    thread of your loop. If you do it from some other thread, wake up
+    your loop, as pubnub_next_timeout_ms() might have changed.
+*/
+
+
+/** Events to watch a socket for. A combination of these flags */
+enum pubnub_watch_events {
+    /** Not watching the socket (any more) */
+    pbwatchNONE = 0,
+    /** Watch for "can read" */
+    pbwatchIN = 0x01,
+    /** Watch for "can write" */
+    pbwatchOUT = 0x02
+};
+
+/** Pointer to a function to be called when the socket of the
+    context @p pb, or what events it should be watched for, change.
+    Also, when there's something to do for a context in
+    pubnub_process_pending(), so, check pubnub_next_timeout_ms().
+
+    It is called while @p pb is being processed, so don't start or
+    cancel transactions on @p pb from it.
+
+    @param pb The context
+    @param user_data The pointer given to pubnub_register_watcher()
+ */
+typedef void (*pubnub_watcher_t)(pubnub_t* pb, void* user_data);
+
+
+/** Registers the @p watcher function, to be called (with
+    @p user_data) on changes of the sockets of all contexts. Register
+    it before starting any transaction.
+ */
+void pubnub_register_watcher(pubnub_watcher_t watcher, void* user_data);
+
+/** Returns the events to watch the socket of the context @p pb for,
+    a combination of #pubnub_watch_events. If #pbwatchNONE, the
+    socket should not be watched (and it might be closed right after
+    the watcher returns).
+ */
+int pubnub_watched_events(pubnub_t* pb);
+
+/** Drives the context @p pb, as its socket is ready for @p events
+    (a combination of #pubnub_watch_events). If this finishes a
+    transaction, the callback of @p pb is called.
+ */
+void pubnub_process_ready(pubnub_t* pb, int events);
+
+/** Returns the time, in milliseconds, in which pubnub_process_pending()
+    should be called. 0 if it should be called right away, -1 if
+    there is nothing to wait for.
+ */
+int pubnub_next_timeout_ms(void);
+
+/** Processes all the contexts that have something to do: that were
+    cancelled or freed, or whose transaction timed out.
+ */
+void pubnub_process_pending(void);
+
+
+#endif /* !defined INC_PUBNUB_NTF_EXTERNAL */
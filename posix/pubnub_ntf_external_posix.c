@@ -0,0 +1,315 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "pubnub_ntf_external.h"
+
+#include "posix/monotonic_clock_get_time.h"
+
+#include "pubnub_internal.h"
+#include "core/pubnub_assert.h"
+#include "core/pubnub_log.h"
+#include "core/pbpal.h"
+
+#include "core/pbpal_ntf_callback_queue.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+/** A context whose socket is watched (by the external loop) */
+struct WatchedContext {
+    pubnub_t* pb;
+    /** Events to watch the socket for (#pubnub_watch_events) */
+    int events;
+    /** Whether the transaction timer is running */
+    bool timer_on;
+    /** When the transaction times out, in (monotonic) milliseconds */
+    unsigned long deadline_ms;
+};
+
+
+struct ExternalWatcherData {
+    pubnub_mutex_t         monitor;
+    struct WatchedContext* awc pubnub_guarded_by(monitor);
+    size_t                 size pubnub_guarded_by(monitor);
+    size_t                 cap pubnub_guarded_by(monitor);
+    pubnub_watcher_t       watcher pubnub_guarded_by(monitor);
+    void*                  user_data pubnub_guarded_by(monitor);
+    struct pbpal_ntf_callback_queue queue;
+};
+
+
+static struct ExternalWatcherData m_watcher;
+
+
+static unsigned long now_ms(void)
+{
+    struct timespec ts;
+    monotonic_clock_get_time(&ts);
+    return (unsigned long)ts.tv_sec * UNIT_IN_MILLI + ts.tv_nsec / MILLI_IN_NANO;
+}
+
+
+/** Returns the watched context data for @p pb, NULL if not watched.
+    Has to be called with `m_watcher.monitor` locked. */
+static struct WatchedContext* find_watched(pubnub_t* pb)
+{
+    size_t i;
+    for (i = 0; i < m_watcher.size; ++i) {
+        if (m_watcher.awc[i].pb == pb) {
+            return m_watcher.awc + i;
+        }
+    }
+    return NULL;
+}
+
+
+/** Tells the external loop (calls the registered watcher) that
+    something changed for the context @p pb */
+static void notify_watcher(pubnub_t* pb)
+{
+    pubnub_watcher_t watcher;
+    void*            user_data;
+
+    pubnub_mutex_lock(m_watcher.monitor);
+    watcher   = m_watcher.watcher;
+    user_data = m_watcher.user_data;
+    pubnub_mutex_unlock(m_watcher.monitor);
+
+    if (watcher != NULL) {
+        watcher(pb, user_data);
+    }
+}
+
+
+static int watch_events(pubnub_t* pbp, int events)
+{
+    struct WatchedContext* wc;
+
+    pubnub_mutex_lock(m_watcher.monitor);
+    wc = find_watched(pbp);
+    if (wc != NULL) {
+        wc->events = events;
+    }
+    pubnub_mutex_unlock(m_watcher.monitor);
+
+    if (NULL == wc) {
+        PUBNUB_LOG_WARNING("watch_events(pbp=%p, events=%d): Not Found!\n",
+                           pbp, events);
+        return -1;
+    }
+    notify_watcher(pbp);
+
+    return 0;
+}
+
+
+int pbntf_watch_in_events(pubnub_t* pbp)
+{
+    return watch_events(pbp, pbwatchIN);
+}
+
+
+int pbntf_watch_out_events(pubnub_t* pbp)
+{
+    return watch_events(pbp, pbwatchOUT);
+}
+
+
+int pbntf_init(void)
+{
+    pubnub_mutex_init(m_watcher.monitor);
+    m_watcher.awc  = NULL;
+    m_watcher.size = m_watcher.cap = 0;
+    pbpal_ntf_callback_queue_init(&m_watcher.queue);
+
+    return 0;
+}
+
+
+int pbntf_enqueue_for_processing(pubnub_t* pb)
+{
+    /* No thread to hand it over to, process it right away */
+    PUBNUB_UNUSED(pb);
+    return 0;
+}
+
+
+int pbntf_requeue_for_processing(pubnub_t* pb)
+{
+    int rslt = pbpal_ntf_callback_requeue_for_processing(&m_watcher.queue, pb);
+    notify_watcher(pb);
+    return rslt;
+}
+
+
+int pbntf_got_socket(pubnub_t* pb)
+{
+    struct WatchedContext* wc;
+
+    pubnub_mutex_lock(m_watcher.monitor);
+    wc = find_watched(pb);
+    if (NULL == wc) {
+        if (m_watcher.size == m_watcher.cap) {
+            size_t const           newcap = m_watcher.cap + 2;
+            struct WatchedContext* npwc   = (struct WatchedContext*)realloc(
+                m_watcher.awc, sizeof m_watcher.awc[0] * newcap);
+            if (NULL == npwc) {
+                pubnub_mutex_unlock(m_watcher.monitor);
+                return -1;
+            }
+            m_watcher.awc = npwc;
+            m_watcher.cap = newcap;
+        }
+        wc     = m_watcher.awc + m_watcher.size++;
+        wc->pb = pb;
+        PBMETRICS_GAUGE_SET(pbmgWatchedSockets, m_watcher.size);
+    }
+    wc->events = pbwatchOUT;
+#if PUBNUB_TIMERS_API
+    wc->timer_on    = true;
+    wc->deadline_ms = now_ms() + pb->transaction_timeout_ms;
+#else
+    wc->timer_on = false;
+#endif
+    pubnub_mutex_unlock(m_watcher.monitor);
+
+    notify_watcher(pb);
+
+    return +1;
+}
+
+
+void pbntf_lost_socket(pubnub_t* pb)
+{
+    struct WatchedContext* wc;
+
+    pubnub_mutex_lock(m_watcher.monitor);
+    wc = find_watched(pb);
+    if (wc != NULL) {
+        size_t to_move = m_watcher.size - (wc - m_watcher.awc) - 1;
+        if (to_move > 0) {
+            memmove(wc, wc + 1, sizeof *wc * to_move);
+        }
+        --m_watcher.size;
+        PBMETRICS_GAUGE_SET(pbmgWatchedSockets, m_watcher.size);
+    }
+    pubnub_mutex_unlock(m_watcher.monitor);
+
+    pbpal_ntf_callback_remove_from_queue(&m_watcher.queue, pb);
+
+    if (wc != NULL) {
+        notify_watcher(pb);
+    }
+}
+
+
+void pbntf_update_socket(pubnub_t* pb)
+{
+    notify_watcher(pb);
+}
+
+
+void pubnub_register_watcher(pubnub_watcher_t watcher, void* user_data)
+{
+    pubnub_mutex_lock(m_watcher.monitor);
+    m_watcher.watcher   = watcher;
+    m_watcher.user_data = user_data;
+    pubnub_mutex_unlock(m_watcher.monitor);
+}
+
+
+int pubnub_watched_events(pubnub_t* pb)
+{
+    struct WatchedContext* wc;
+    int                    rslt = pbwatchNONE;
+
+    PUBNUB_ASSERT(pb_valid_ctx_ptr(pb));
+
+    pubnub_mutex_lock(m_watcher.monitor);
+    wc = find_watched(pb);
+    if (wc != NULL) {
+        rslt = wc->events;
+    }
+    pubnub_mutex_unlock(m_watcher.monitor);
+
+    return rslt;
+}
+
+
+void pubnub_process_ready(pubnub_t* pb, int events)
+{
+    bool watched;
+
+    PUBNUB_ASSERT(pb_valid_ctx_ptr(pb));
+    PUBNUB_LOG_TRACE("pubnub_process_ready(pb=%p, events=%d)\n", pb, events);
+
+    pubnub_mutex_lock(pb->monitor);
+    pubnub_mutex_lock(m_watcher.monitor);
+    watched = (find_watched(pb) != NULL);
+    pubnub_mutex_unlock(m_watcher.monitor);
+    /* An event that came after the socket was lost is stale - in
+       "idle" states, the FSM would start a transaction */
+    if (watched && (pb->state != PBS_NULL)) {
+        pbnc_fsm(pb);
+    }
+    pubnub_mutex_unlock(pb->monitor);
+}
+
+
+int pubnub_next_timeout_ms(void)
+{
+    unsigned long now;
+    size_t        i;
+    int           rslt = -1;
+
+    if (!pbpal_ntf_callback_queue_empty(&m_watcher.queue)) {
+        return 0;
+    }
+
+    now = now_ms();
+    pubnub_mutex_lock(m_watcher.monitor);
+    for (i = 0; i < m_watcher.size; ++i) {
+        struct WatchedContext const* wc = m_watcher.awc + i;
+        if (wc->timer_on) {
+            long left = (long)(wc->deadline_ms - now);
+            if (left < 0) {
+                left = 0;
+            }
+            if ((rslt < 0) || (left < rslt)) {
+                rslt = (int)left;
+            }
+        }
+    }
+    pubnub_mutex_unlock(m_watcher.monitor);
+
+    return rslt;
+}
+
+
+void pubnub_process_pending(void)
+{
+    for (;;) {
+        pubnub_t*     expired = NULL;
+        unsigned long now     = now_ms();
+        size_t        i;
+
+        pubnub_mutex_lock(m_watcher.monitor);
+        for (i = 0; i < m_watcher.size; ++i) {
+            struct WatchedContext* wc = m_watcher.awc + i;
+            if (wc->timer_on && ((long)(now - wc->deadline_ms) >= 0)) {
+                wc->timer_on = false;
+                expired      = wc->pb;
+                break;
+            }
+        }
+        pubnub_mutex_unlock(m_watcher.monitor);
+
+        if (NULL == expired) {
+            break;
+        }
+        pubnub_mutex_lock(expired->monitor);
+        pbnc_stop(expired, PNR_TIMEOUT);
+        pubnub_mutex_unlock(expired->monitor);
+    }
+
+    pbpal_ntf_callback_process_queue(&m_watcher.queue);
+}
@@ -0,0 +1,99 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "core/pbpal_spool.h"
+
+#include "core/pubnub_log.h"
+#include "posix/monotonic_clock_get_time.h"
+
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+
+int pbpal_spool_map(char const*              path,
+                    size_t                   size,
+                    struct pbpal_spool_file* file,
+                    bool*                    created)
+{
+    struct stat st;
+    void*       addr;
+    int         fd = open(path, O_RDWR | O_CREAT, 0600);
+
+    if (-1 == fd) {
+        PUBNUB_LOG_ERROR("Failed to open spool file '%s', errno=%d\n", path, errno);
+        return -1;
+    }
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        PUBNUB_LOG_ERROR("Spool file '%s' is used by another process\n", path);
+        close(fd);
+        return -1;
+    }
+    if (fstat(fd, &st) != 0) {
+        PUBNUB_LOG_ERROR("Failed to stat spool file '%s', errno=%d\n", path, errno);
+        close(fd);
+        return -1;
+    }
+    *created = (0 == st.st_size);
+    if (*created) {
+        if (ftruncate(fd, (off_t)size) != 0) {
+            PUBNUB_LOG_ERROR("Failed to resize spool file '%s' to %lu bytes, "
+                             "errno=%d\n",
+                             path,
+                             (unsigned long)size,
+                             errno);
+            close(fd);
+            return -1;
+        }
+    }
+    else {
+        size = (size_t)st.st_size;
+    }
+    addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == addr) {
+        PUBNUB_LOG_ERROR("Failed to map spool file '%s', errno=%d\n", path, errno);
+        close(fd);
+        return -1;
+    }
+    file->addr   = (char*)addr;
+    file->size   = size;
+    file->handle = fd;
+
+    return 0;
+}
+
+
+void pbpal_spool_unmap(struct pbpal_spool_file* file)
+{
+    munmap(file->addr, file->size);
+    close((int)file->handle);
+    file->addr   = NULL;
+    file->handle = -1;
+}
+
+
+int pbpal_spool_sync(struct pbpal_spool_file const* file, bool wait)
+{
+    return msync(file->addr, file->size, wait ? MS_SYNC : MS_ASYNC);
+}
+
+
+unsigned long pbpal_spool_clock_ms(void)
+{
+    struct timespec ts;
+    monotonic_clock_get_time(&ts);
+    return (unsigned long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+
+void pbpal_spool_sleep_ms(unsigned long ms)
+{
+    struct timespec ts;
+    ts.tv_sec  = ms / 1000;
+    ts.tv_nsec = (ms % 1000) * 1000000L;
+    while ((nanosleep(&ts, &ts) != 0) && (EINTR == errno)) {
+        continue;
+    }
+}
@@ -0,0 +1,236 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "pubnub_callback.h"
+#include "pubnub_ntf_external.h"
+
+#include "core/pubnub_helper.h"
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <stdio.h>
+#include <string.h>
+
+
+/** A sample of driving the Pubnub "callback" interface from your own
+    `epoll` loop, with no thread of the C-core. Subscribes on one
+    context and publishes a few messages from another, all the
+    callbacks are called from the loop in `main()`.
+*/
+
+
+enum { MESSAGES_TO_PUBLISH = 3 };
+
+static char const* m_chan = "hello_world";
+
+/** The socket (file descriptor) we have registered with epoll, per
+    context, as we need to tell epoll when it changes */
+struct Registered {
+    pubnub_t* pb;
+    int       fd;
+};
+
+static int               m_epoll;
+static struct Registered m_registered[2];
+static pubnub_t*         m_pbp;
+static int               m_published;
+static int               m_received;
+static bool              m_done;
+
+
+static struct Registered* find_registered(pubnub_t* pb)
+{
+    size_t i;
+    for (i = 0; i < sizeof m_registered / sizeof m_registered[0]; ++i) {
+        if (m_registered[i].pb == pb) {
+            return m_registered + i;
+        }
+    }
+    return NULL;
+}
+
+
+/** Called by the C-core when the socket of @p pb, or the events
+    to watch it for, change. Updates the epoll interest list. */
+static void watcher(pubnub_t* pb, void* user_data)
+{
+    int                events = pubnub_watched_events(pb);
+    int                fd     = pubnub_get_native_socket(pb);
+    struct Registered* reg    = find_registered(pb);
+
+    (void)user_data;
+
+    if ((reg != NULL)
+        && ((pbwatchNONE == events) || (reg->fd != fd))) {
+        /* The socket might be closed already, so ignore errors */
+        epoll_ctl(m_epoll, EPOLL_CTL_DEL, reg->fd, NULL);
+        reg->pb = NULL;
+        reg     = NULL;
+    }
+    if (events != pbwatchNONE) {
+        struct epoll_event ev;
+        int                op = EPOLL_CTL_MOD;
+
+        memset(&ev, 0, sizeof ev);
+        ev.events   = ((events & pbwatchIN) ? EPOLLIN : 0)
+                    | ((events & pbwatchOUT) ? EPOLLOUT : 0);
+        ev.data.ptr = pb;
+        if (NULL == reg) {
+            reg = find_registered(NULL);
+            if (NULL == reg) {
+                puts("No room to register another context");
+                return;
+            }
+            reg->pb = pb;
+            reg->fd = fd;
+            op      = EPOLL_CTL_ADD;
+        }
+        if (epoll_ctl(m_epoll, op, fd, &ev) != 0) {
+            perror("epoll_ctl()");
+        }
+    }
+}
+
+
+static void publish_next(void)
+{
+    char msg[64];
+    enum pubnub_res res;
+
+    snprintf(msg, sizeof msg, "\"Hello world from epoll #%d\"", ++m_published);
+    res = pubnub_publish(m_pbp, m_chan, msg);
+    if (res != PNR_STARTED) {
+        printf("pubnub_publish() returned unexpected %d: %s\n",
+               res,
+               pubnub_res_2_string(res));
+        m_done = true;
+    }
+}
+
+
+static void sample_callback(pubnub_t*         pb,
+                            enum pubnub_trans trans,
+                            enum pubnub_res   result,
+                            void*             user_data)
+{
+    (void)user_data;
+
+    switch (trans) {
+    case PBTT_PUBLISH:
+        printf("Published, result: %d('%s')\n", result, pubnub_res_2_string(result));
+        if ((PNR_OK == result) && (m_published < MESSAGES_TO_PUBLISH)) {
+            publish_next();
+        }
+        break;
+    case PBTT_SUBSCRIBE:
+        printf("Subscribed, result: %d('%s')\n", result, pubnub_res_2_string(result));
+        if (result != PNR_OK) {
+            m_done = true;
+            break;
+        }
+        for (;;) {
+            char const* msg = pubnub_get(pb);
+            if (NULL == msg) {
+                break;
+            }
+            printf("Received message: %s\n", msg);
+            ++m_received;
+        }
+        if (m_received >= MESSAGES_TO_PUBLISH) {
+            m_done = true;
+            break;
+        }
+        if (0 == m_published) {
+            /* The first subscribe only "connects", so start publishing */
+            publish_next();
+        }
+        if (pubnub_subscribe(pb, m_chan, NULL) != PNR_STARTED) {
+            puts("Failed to start subscribe");
+            m_done = true;
+        }
+        break;
+    default:
+        printf("Transaction %d done, result: %d('%s')\n",
+               trans,
+               result,
+               pubnub_res_2_string(result));
+        break;
+    }
+}
+
+
+/** One iteration of the event loop: wait for the sockets (or the
+    timeout the C-core asks for), then let the C-core do its work. */
+static void run_once(void)
+{
+    struct epoll_event events[8];
+    int                n = epoll_wait(
+        m_epoll, events, sizeof events / sizeof events[0], pubnub_next_timeout_ms());
+    int i;
+
+    for (i = 0; i < n; ++i) {
+        int ready = pbwatchNONE;
+        if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+            ready |= pbwatchIN;
+        }
+        if (events[i].events & (EPOLLOUT | EPOLLHUP | EPOLLERR)) {
+            ready |= pbwatchOUT;
+        }
+        pubnub_process_ready((pubnub_t*)events[i].data.ptr, ready);
+    }
+    pubnub_process_pending();
+}
+
+
+static void sample_free(pubnub_t* pb)
+{
+    pubnub_cancel(pb);
+    while (pubnub_free(pb) != 0) {
+        run_once();
+    }
+    /* Let the context be released from the processing queue */
+    while (0 == pubnub_next_timeout_ms()) {
+        pubnub_process_pending();
+    }
+}
+
+
+int main()
+{
+    pubnub_t* pbs;
+
+    m_epoll = epoll_create1(0);
+    if (-1 == m_epoll) {
+        perror("epoll_create1()");
+        return -1;
+    }
+    pubnub_register_watcher(watcher, NULL);
+
+    m_pbp = pubnub_alloc();
+    pbs   = pubnub_alloc();
+    if ((NULL == m_pbp) || (NULL == pbs)) {
+        puts("Failed to allocate Pubnub contexts");
+        return -1;
+    }
+    pubnub_init(m_pbp, "demo", "demo");
+    pubnub_init(pbs, "demo", "demo");
+    pubnub_register_callback(m_pbp, sample_callback, NULL);
+    pubnub_register_callback(pbs, sample_callback, NULL);
+
+    puts("Subscribing...");
+    if (pubnub_subscribe(pbs, m_chan, NULL) != PNR_STARTED) {
+        puts("Failed to start subscribe");
+        return -1;
+    }
+    while (!m_done) {
+        run_once();
+    }
+
+    sample_free(pbs);
+    sample_free(m_pbp);
+    pubnub_register_watcher(NULL, NULL);
+    close(m_epoll);
+
+    puts("Pubnub external epoll loop demo over.");
+
+    return 0;
+}
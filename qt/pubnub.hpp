@@ -299,9 +299,11 @@ namespace pubnub {
         /// Returns a vector of all messages from the context.
         std::vector<std::string> get_all() const { 
             std::vector<std::string> result;
-            QStringList qsl = d_pbqt.get_all();
-            for (int i = 0; i < qsl.size(); ++i) {
-                result.push_back(qsl[i].toStdString());
+            pubnub_qt_reply_list all = d_pbqt.get_all_lazy();
+            result.reserve(all.size());
+            for (int i = 0; i < all.size(); ++i) {
+                QByteArray msg = all.raw(i);
+                result.push_back(std::string(msg.constData(), msg.size()));
             }
             return result;
         }
@@ -313,9 +315,11 @@ namespace pubnub {
         /// Returns a vector of all channel strings from the context
         std::vector<std::string> get_all_channels() const { 
             std::vector<std::string> result;
-            QStringList qsl = d_pbqt.get_all_channels();
-            for (int i = 0; i < qsl.size(); ++i) {
-                result.push_back(qsl[i].toStdString());;
+            pubnub_qt_reply_list all = d_pbqt.get_all_channels_lazy();
+            result.reserve(all.size());
+            for (int i = 0; i < all.size(); ++i) {
+                QByteArray chan = all.raw(i);
+                result.push_back(std::string(chan.constData(), chan.size()));
             }
             return result;
         }
@@ -60,6 +60,12 @@
 */
 #define PUBNUB_ORIGIN  "pubsub.pubnub.com"
 
+/** Set to 1 to log (via qDebug()) the body of every reply. This
+    stalls the thread that handles the replies on big replies (of
+    subscribe or history), so it is off by default.
+*/
+#define PUBNUB_QT_LOG_REPLY 0
+
 #define PUBNUB_HAVE_SHA1 0
 
 
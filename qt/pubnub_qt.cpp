@@ -7,12 +7,61 @@ extern "C" {
 }
 
 #include <QtNetwork>
+#include <QThreadPool>
+#include <QRunnable>
+
+
+/** Parses the response of a Qt context on a thread pool and, when
+    done, invokes the parseFinished() slot of the context (on its own
+    thread).
+
+    It doesn't touch the context while parsing: the response is parsed
+    in a copy of the (C-core) context, with its own storage, which the
+    context takes over in parseFinished(). So, the context can be used
+    (say, cancelled) in the meantime.
+ */
+class pubnub_qt_parse_task : public QRunnable {
+public:
+    pubnub_qt_parse_task(pubnub_qt* pb, pubnub_trans trans, pbcc_context const& ctx, QByteArray& data)
+        : d_pb(pb)
+        , d_trans(trans)
+        , d_context(ctx)
+        , d_result(PNR_OK)
+    {
+        d_data.swap(data);
+        /* The context deletes us, when it's done with our results */
+        setAutoDelete(false);
+    }
+    void run()
+    {
+        d_result = pubnub_qt::set_reply(&d_context, d_storage, d_data);
+        if (PNR_OK == d_result) {
+            d_result = pubnub_qt::parse_reply(d_trans, &d_context);
+        }
+        QMetaObject::invokeMethod(d_pb, "parseFinished", Qt::QueuedConnection);
+        /* Once released, the context may be destroyed */
+        d_pb->d_parse_idle.release();
+    }
 
+    /// The context
+    pubnub_qt* d_pb;
+    /// The transaction whose response is parsed
+    pubnub_trans d_trans;
+    /// The copy of the C-core context the response is parsed in
+    pbcc_context d_context;
+    /// The response, as received
+    QByteArray d_data;
+    /// The storage of the response, which is parsed in place
+    QByteArray d_storage;
+    /// The outcome of parsing
+    pubnub_res d_result;
+};
 
 
 pubnub_qt::pubnub_qt(QString pubkey, QString keysub)
     : d_pubkey(pubkey.toLatin1())
     , d_keysub(keysub.toLatin1())
+    , d_own_qnam(0)
     , d_context(new pbcc_context)
     , d_http_code(0)
 #ifdef QT_NO_SSL
@@ -26,16 +75,24 @@ pubnub_qt::pubnub_qt(QString pubkey, QString keysub)
     , d_transaction_timed_out(false)
     , d_transactionTimer(new QTimer(this))
     , d_use_http_keep_alive(true)
+    , d_http2_allowed(true)
+    , d_parse_pool(0)
+    , d_parse_cancelled(false)
+    , d_parse_idle(1)
 {
     pbcc_init(d_context.data(), d_pubkey.data(), d_keysub.data());
-    connect(&d_qnam, SIGNAL(sslErrors(QNetworkReply*,QList<QSslError>)),
-            this, SLOT(sslErrors(QNetworkReply*,QList<QSslError>)));
     connect(d_transactionTimer, SIGNAL(timeout()), this, SLOT(transactionTimeout()));
 }
 
 
 pubnub_qt::~pubnub_qt()
 {
+    /* Wait for the response to be parsed, if it is being parsed */
+    d_parse_idle.acquire();
+#if PUBNUB_DYNAMIC_REPLY_BUFFER
+    /* The response buffer is owned by d_reply_data */
+    d_context->http_reply = NULL;
+#endif
     pbcc_deinit(d_context.data());
 }
 
@@ -55,14 +112,59 @@ pubnub_res pubnub_qt::startRequest(pubnub_res result, pubnub_trans transaction)
         if (!d_use_http_keep_alive) {
             req.setRawHeader("Connection", "Close");
         }
-        d_reply.reset(d_qnam.get(req));
+#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+        req.setAttribute(QNetworkRequest::Http2AllowedAttribute, d_http2_allowed);
+#endif
+        d_reply.reset(qnam()->get(req));
         connect(d_reply.data(), SIGNAL(finished()), this, SLOT(httpFinished()));
+#ifndef QT_NO_SSL
+        connect(d_reply.data(), SIGNAL(sslErrors(QList<QSslError>)),
+                this, SLOT(sslErrors(QList<QSslError>)));
+#endif
         d_transactionTimer->start(d_transaction_timeout_duration_ms);
     }
     return result;
 }
 
 
+QNetworkAccessManager* pubnub_qt::qnam()
+{
+    if (d_qnam) {
+        return d_qnam.data();
+    }
+    if (0 == d_own_qnam) {
+        d_own_qnam = new QNetworkAccessManager(this);
+    }
+    return d_own_qnam;
+}
+
+
+void pubnub_qt::warm_up()
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 2, 0)
+    QUrl url(d_origin);
+#ifndef QT_NO_SSL
+    if (0 == url.scheme().compare("https", Qt::CaseInsensitive)) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 13, 0)
+        /* Offer HTTP/2, so that the connection can be used for it */
+        QSslConfiguration conf = QSslConfiguration::defaultConfiguration();
+        if (d_http2_allowed) {
+            conf.setAllowedNextProtocols(
+                QList<QByteArray>() << QSslConfiguration::ALPNProtocolHTTP2
+                                    << QSslConfiguration::NextProtocolHttp1_1);
+        }
+        qnam()->connectToHostEncrypted(url.host(), url.port(443), conf, QString());
+#else
+        qnam()->connectToHostEncrypted(url.host(), url.port(443));
+#endif
+        return;
+    }
+#endif
+    qnam()->connectToHost(url.host(), url.port(80));
+#endif
+}
+
+
 void pubnub_qt::set_uuid(QString const &uuid)
 {
     d_uuid = uuid.toLatin1();
@@ -95,6 +197,30 @@ QStringList pubnub_qt::get_all() const
 }
 
 
+QByteArray pubnub_qt::reply_storage() const
+{
+#if PUBNUB_DYNAMIC_REPLY_BUFFER
+    return d_reply_data;
+#else
+    return QByteArray(d_context->http_reply, d_context->http_buf_len);
+#endif
+}
+
+
+pubnub_qt_reply_list pubnub_qt::get_all_lazy() const
+{
+    QVector<QPair<int, int> > all;
+    for (;;) {
+        int offset = d_context->msg_ofs;
+        if (0 == pbcc_get_msg(d_context.data())) {
+            break;
+        }
+        all.push_back(qMakePair(offset, (int)d_context->msg_ofs - offset - 1));
+    }
+    return pubnub_qt_reply_list(reply_storage(), all);
+}
+
+
 QString pubnub_qt::get_channel() const
 {
     return pbcc_get_channel(d_context.data());
@@ -114,8 +240,27 @@ QStringList pubnub_qt::get_all_channels() const
 }
 
 
+pubnub_qt_reply_list pubnub_qt::get_all_channels_lazy() const
+{
+    QVector<QPair<int, int> > all;
+    for (;;) {
+        int offset = d_context->chan_ofs;
+        if (0 == pbcc_get_channel(d_context.data())) {
+            break;
+        }
+        all.push_back(qMakePair(offset, (int)d_context->chan_ofs - offset - 1));
+    }
+    return pubnub_qt_reply_list(reply_storage(), all);
+}
+
+
 void pubnub_qt::cancel()
 {
+    if (d_parse_task) {
+        /* The reply is already here, it's just not parsed yet */
+        d_parse_cancelled = true;
+        return;
+    }
     if (d_reply) {
         d_reply->abort();
     }
@@ -144,6 +289,7 @@ pubnub_res pubnub_qt::subscribe(QString const &channel, QString const &channel_g
             d_context.data(),
             channel.isEmpty() ? 0 : channel.toLatin1().data(),
             channel_group.isEmpty() ? 0 : channel_group.toLatin1().data(),
+            0,
             0
             ), PBTT_SUBSCRIBE
         );
@@ -371,42 +517,56 @@ void pubnub_qt::set_origin(QString const& origin)
 }
 
 
-pubnub_res pubnub_qt::finish(QByteArray const &data, int http_code)
+pubnub_res pubnub_qt::set_reply(pbcc_context* ctx, QByteArray& storage, QByteArray& data)
 {
-    pubnub_res pbres = PNR_OK;
-    if (PUBNUB_DYNAMIC_REPLY_BUFFER) {
-        pbcc_realloc_reply_buffer(d_context.data(), data.size());
-        memcpy(d_context->http_reply, data.data(), data.size());
-        d_context->http_buf_len = data.size();
-        d_context->http_reply[data.size()] = '\0';
-    }
-    else {
-        if ((unsigned)data.size() >= sizeof d_context->http_reply) {
-            return PNR_REPLY_TOO_BIG;
-        }
-        d_context->http_buf_len = data.size();
-        memcpy(d_context->http_reply, data.data(), data.size());
-        d_context->http_reply[d_context->http_buf_len] = '\0';
+#if PUBNUB_DYNAMIC_REPLY_BUFFER
+    /* Parsing edits the response in place, so it must not share its
+       storage with anyone else - Qt's buffers or the lists of the
+       previous response (see get_all_lazy()). Usually, we hold the
+       only reference, so this doesn't copy. QByteArray is always NUL
+       terminated. */
+    storage.swap(data);
+    storage.detach();
+    ctx->http_reply = storage.data();
+    ctx->http_buf_len = storage.size();
+#else
+    Q_UNUSED(storage);
+    if ((unsigned)data.size() >= sizeof ctx->http_reply) {
+        return PNR_REPLY_TOO_BIG;
     }
+    ctx->http_buf_len = data.size();
+    memcpy(ctx->http_reply, data.data(), data.size());
+    ctx->http_reply[ctx->http_buf_len] = '\0';
+#endif
 
-    qDebug() << "finish('" << d_context->http_reply << "')";
+#if PUBNUB_QT_LOG_REPLY
+    qDebug() << "finish('" << ctx->http_reply << "')";
+#endif
+
+    return PNR_OK;
+}
+
+
+pubnub_res pubnub_qt::parse_reply(pubnub_trans trans, pbcc_context* ctx)
+{
+    pubnub_res pbres = PNR_OK;
 
-    switch (d_trans) {
+    switch (trans) {
     case PBTT_SUBSCRIBE:
-        if (pbcc_parse_subscribe_response(d_context.data()) != 0) {
+        if (pbcc_parse_subscribe_response(ctx) != 0) {
             pbres = PNR_FORMAT_ERROR;
         }
         break;
     case PBTT_PUBLISH:
-        pbres = pbcc_parse_publish_response(d_context.data());
+        pbres = pbcc_parse_publish_response(ctx);
         break;
     case PBTT_TIME:
-        if (pbcc_parse_time_response(d_context.data()) != 0) {
+        if (pbcc_parse_time_response(ctx) != 0) {
             pbres = PNR_FORMAT_ERROR;
         }
         break;
     case PBTT_HISTORY:
-        if (pbcc_parse_history_response(d_context.data()) != 0) {
+        if (pbcc_parse_history_response(ctx) != 0) {
             pbres = PNR_FORMAT_ERROR;
         }
         break;
@@ -416,7 +576,7 @@ pubnub_res pubnub_qt::finish(QByteArray const &data, int http_code)
     case PBTT_WHERENOW:
     case PBTT_SET_STATE:
     case PBTT_STATE_GET:
-        if (pbcc_parse_presence_response(d_context.data()) != 0) {
+        if (pbcc_parse_presence_response(ctx) != 0) {
             pbres = PNR_FORMAT_ERROR;
         }
         break;
@@ -424,12 +584,18 @@ pubnub_res pubnub_qt::finish(QByteArray const &data, int http_code)
     case PBTT_REMOVE_CHANNEL_FROM_GROUP:
     case PBTT_ADD_CHANNEL_TO_GROUP:
     case PBTT_LIST_CHANNEL_GROUP:
-        pbres = pbcc_parse_channel_registry_response(d_context.data());
+        pbres = pbcc_parse_channel_registry_response(ctx);
         break;
     default:
         break;
     }
 
+    return pbres;
+}
+
+
+pubnub_res pubnub_qt::finish(pubnub_res pbres, int http_code)
+{
     QVariant statusCode = d_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute);
     d_http_code = statusCode.isValid() ? statusCode.toInt() : 0;
 
@@ -458,12 +624,12 @@ void pubnub_qt::httpFinished()
     if (error) {
         qDebug() << "error: " << d_reply->error() << ", string: " << d_reply->errorString();
         d_context->http_buf_len = 0;
-        if (PUBNUB_DYNAMIC_REPLY_BUFFER) {
-            d_context->http_reply = NULL;
-        }
-        else {
-            d_context->http_reply[0] = '\0';
-        }
+#if PUBNUB_DYNAMIC_REPLY_BUFFER
+        d_context->http_reply = NULL;
+        d_reply_data.clear();
+#else
+        d_context->http_reply[0] = '\0';
+#endif
         switch (error) {
         case QNetworkReply::OperationCanceledError:
             if (d_transaction_timed_out) {
@@ -486,12 +652,57 @@ void pubnub_qt::httpFinished()
         }
     }
 
-    emit outcome(finish(d_reply->readAll(), d_reply->error()));
+    QByteArray data = d_reply->readAll();
+    if (d_parse_pool != 0) {
+        d_parse_idle.acquire();
+        d_parse_task.reset(new pubnub_qt_parse_task(this, d_trans, *d_context, data));
+        d_parse_cancelled = false;
+        d_parse_pool->start(d_parse_task.data());
+        return;
+    }
+    pubnub_res pbres = set_reply(d_context.data(), d_reply_data, data);
+    if (pbres != PNR_OK) {
+        emit outcome(pbres);
+    }
+    else {
+        emit outcome(finish(parse_reply(d_trans, d_context.data()), d_reply->error()));
+    }
+}
+
+
+void pubnub_qt::parseFinished()
+{
+    QScopedPointer<pubnub_qt_parse_task> task(d_parse_task.take());
+    if (!task) {
+        return;
+    }
+    if (d_parse_cancelled) {
+        emit outcome(PNR_CANCELLED);
+        return;
+    }
+
+    /* Take over the parsed response, and what parsing it changed */
+    pbcc_context const& parsed = task->d_context;
+#if PUBNUB_DYNAMIC_REPLY_BUFFER
+    d_reply_data.swap(task->d_storage);
+    d_context->http_reply = d_reply_data.data();
+#else
+    memcpy(d_context->http_reply, parsed.http_reply, parsed.http_buf_len + 1);
+#endif
+    d_context->http_buf_len = parsed.http_buf_len;
+    memcpy(d_context->timetoken, parsed.timetoken, sizeof d_context->timetoken);
+    d_context->msg_ofs  = parsed.msg_ofs;
+    d_context->msg_end  = parsed.msg_end;
+    d_context->chan_ofs = parsed.chan_ofs;
+    d_context->chan_end = parsed.chan_end;
+
+    emit outcome(finish(task->d_result, d_reply->error()));
 }
 
 
-void pubnub_qt::sslErrors(QNetworkReply* reply,const QList<QSslError> &errors)
+void pubnub_qt::sslErrors(const QList<QSslError> &errors)
 {
+    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
     QString errorString;
     foreach (const QSslError &error, errors) {
         if (!errorString.isEmpty())
@@ -501,7 +712,7 @@ void pubnub_qt::sslErrors(QNetworkReply* reply,const QList<QSslError> &errors)
 
     qDebug() << "SSL error: " << errorString;
 
-    if (d_ssl_opts & ignoreSecureConnectionRequirement) {
+    if ((d_ssl_opts & ignoreSecureConnectionRequirement) && (reply != 0)) {
         reply->ignoreSslErrors();
     }
 }
@@ -7,8 +7,15 @@
 #include <QNetworkAccessManager>
 #include <QTimer>
 #include <QStringList>
+#include <QByteArray>
+#include <QVector>
+#include <QPair>
+#include <QSemaphore>
+#include <QPointer>
 #include <QDebug>
 
+#include <iterator>
+
 extern "C" {
 #include "pubnub_api_types.h"
 #include "pubnub_helper.h"
@@ -17,10 +24,12 @@ extern "C" {
 QT_BEGIN_NAMESPACE
 class QNetworkReply;
 class QSslError;
+class QThreadPool;
 QT_END_NAMESPACE
 
 
 struct pbcc_context;
+class pubnub_qt_parse_task;
 
 /** @mainpage Pubnub C-core for Qt
 
@@ -31,6 +40,108 @@ struct pbcc_context;
 */
 
 
+/** A list of messages (or channels) from the reply of a transaction,
+ * which are decoded (to QString) only as they are accessed. It shares
+ * the storage of the reply, so it's cheap to copy and stays valid
+ * after other transactions on the context, but it can't be modified.
+ *
+ * It converts to a QStringList, for compatibility.
+ */
+class pubnub_qt_reply_list
+{
+public:
+    /// Iterates over the (decoded) elements of the list
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef QString                   value_type;
+        typedef int                       difference_type;
+        typedef QString const*            pointer;
+        typedef QString                   reference;
+
+        const_iterator(pubnub_qt_reply_list const* list, int i)
+            : d_list(list)
+            , d_i(i)
+        {
+        }
+        QString operator*() const { return d_list->at(d_i); }
+        const_iterator& operator++()
+        {
+            ++d_i;
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            const_iterator rslt(*this);
+            ++d_i;
+            return rslt;
+        }
+        bool operator==(const_iterator const& x) const { return d_i == x.d_i; }
+        bool operator!=(const_iterator const& x) const { return d_i != x.d_i; }
+
+    private:
+        pubnub_qt_reply_list const* d_list;
+        int                         d_i;
+    };
+    typedef QString value_type;
+
+    pubnub_qt_reply_list() {}
+
+    /** Creates a list of the elements in @p storage, each given by its
+     * offset and length.
+     */
+    pubnub_qt_reply_list(QByteArray const&                storage,
+                         QVector<QPair<int, int> > const& elements)
+        : d_storage(storage)
+        , d_elements(elements)
+    {
+    }
+
+    int  size() const { return d_elements.size(); }
+    int  count() const { return d_elements.size(); }
+    bool isEmpty() const { return d_elements.isEmpty(); }
+
+    /** Returns the element at index @p i, decoded from UTF-8 */
+    QString at(int i) const
+    {
+        return QString::fromUtf8(d_storage.constData() + d_elements[i].first,
+                                 d_elements[i].second);
+    }
+    QString operator[](int i) const { return at(i); }
+
+    /** Returns the element at index @p i as is (UTF-8), without
+     * copying it, so it is valid only while this list (or a copy of
+     * it) is.
+     */
+    QByteArray raw(int i) const
+    {
+        return QByteArray::fromRawData(d_storage.constData() + d_elements[i].first,
+                                       d_elements[i].second);
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    /** Decodes all the elements to a string list */
+    operator QStringList() const
+    {
+        QStringList all;
+        all.reserve(size());
+        for (int i = 0; i < size(); ++i) {
+            all.push_back(at(i));
+        }
+        return all;
+    }
+
+private:
+    /// The storage of the reply
+    QByteArray d_storage;
+    /// Offset and length of each element in the storage
+    QVector<QPair<int, int> > d_elements;
+};
+
+
 /** Pubnub client "context" for Qt.
  *
  * Represents a Pubnub "context". One context handles at most
@@ -144,6 +255,11 @@ public:
     /** Returns all (remaining) messages from a context */
     QStringList get_all() const;
 
+    /** Returns all (remaining) messages from a context, like
+        get_all(), but they are decoded only as you access them, which
+        makes a difference for big replies. */
+    pubnub_qt_reply_list get_all_lazy() const;
+
 
     /** Returns a string of a fetched subscribe operation/transaction's
         next channel.  Each transaction may hold a list of channels, and
@@ -157,6 +273,11 @@ public:
 
     /** Returns all (remaining) channels from a context */
     QStringList get_all_channels() const;
+
+    /** Returns all (remaining) channels from a context, like
+        get_all_channels(), but they are decoded only as you access
+        them. */
+    pubnub_qt_reply_list get_all_channels_lazy() const;
     
     /** Cancels an ongoing API transaction. The outcome is not
      * guaranteed to be #PNR_CANCELLED like in other C-core based
@@ -688,12 +809,67 @@ public:
     /** Returns the current transaction duration, in milliseconds. */
     int transaction_timeout_get();
 
+    /** Sets the thread pool on which to parse the replies. By default
+     * (or if you pass 0), replies are parsed on the thread of this
+     * context (the one that runs its event loop), which is usually
+     * the GUI thread, and big replies (of subscribe or history) can
+     * stall it.
+     *
+     * The reply is parsed in a copy of the state of the context,
+     * which is handed back to the context on its thread, just before
+     * the #outcome signal is emitted. Until then, the context is as
+     * it was before the reply arrived. If you cancel() the
+     * transaction while the reply is being parsed, the outcome is
+     * #PNR_CANCELLED and the context is left as it was.
+     *
+     * Either way, the #outcome signal is emitted on the thread of
+     * this context. Until it is, don't start another transaction on
+     * this context.
+     */
+    void set_parse_thread_pool(QThreadPool* pool) { d_parse_pool = pool; }
+
+    /** Sets the network access manager to use for subsequent
+     * transactions. By default (or if you pass 0), the context uses
+     * its own, thus its own connection(s).
+     *
+     * Many contexts can share one manager, and thus its connections
+     * (and TLS sessions). With HTTP/2 (see set_http2_allowed()), all
+     * their transactions are multiplexed over one connection. Keep
+     * in mind that, if HTTP/2 is not negotiated, a manager makes at
+     * most 6 (HTTP/1.1) connections to a host, so subscribes (which
+     * are long lived) of many contexts could hold back the other
+     * transactions.
+     *
+     * The manager is not owned by the context, it has to outlive it
+     * and belong to the same thread.
+     */
+    void set_network_access_manager(QNetworkAccessManager* qnam)
+    {
+        d_qnam = qnam;
+    }
+
+    /** Allows (or not) the use of HTTP/2 for subsequent transactions,
+     * if it is supported by your Qt (5.8 or newer) and the origin.
+     * Allowed by default.
+     */
+    void set_http2_allowed(bool allowed) { d_http2_allowed = allowed; }
+
+    /** Starts connecting to the origin (with TLS, if it is "https"),
+     * without starting a transaction, so that the first transaction
+     * doesn't have to wait for the connection. It is best called
+     * after setting the network access manager, origin and SSL
+     * options, if you change them. Requires Qt 5.2 or newer, does
+     * nothing otherwise.
+     */
+    void warm_up();
+
 private slots:
     void httpFinished();
     void transactionTimeout();
+    void parseFinished();
 
 #ifndef QT_NO_SSL
-    void sslErrors(QNetworkReply* reply, QList<QSslError> const& errors);
+    void sslErrors(QList<QSslError> const& errors);
 #endif
 
 signals:
@@ -707,8 +883,24 @@ private:
     /// Common function that starts any of the requests
     pubnub_res startRequest(pubnub_res result, pubnub_trans transaction);
 
-    /// Common function which processes the data received in response
-    pubnub_res finish(QByteArray const &data, int http_code);
+    friend class pubnub_qt_parse_task;
+
+    /// Takes the @p data received in response into the @p storage,
+    /// to be parsed (in place) in the context @p ctx
+    static pubnub_res set_reply(pbcc_context* ctx, QByteArray& storage, QByteArray& data);
+
+    /// Parses the response of transaction @p trans in the context
+    /// @p ctx (may be called on any thread)
+    static pubnub_res parse_reply(pubnub_trans trans, pbcc_context* ctx);
+
+    /// Common function which processes the outcome of parsing the response
+    pubnub_res finish(pubnub_res pbres, int http_code);
+
+    /// Returns the storage of the response
+    QByteArray reply_storage() const;
+
+    /// Returns the network access manager to use
+    QNetworkAccessManager* qnam();
 
     /// The publish key
     QByteArray d_pubkey;
@@ -722,8 +914,11 @@ private:
     /// Auth key to use (can be empty - none)
     QByteArray d_auth;
 
-    /// Qt's Network Access Manager
-    QNetworkAccessManager d_qnam;
+    /// Qt's Network Access Manager set by the user (0: none)
+    QPointer<QNetworkAccessManager> d_qnam;
+
+    /// Our own Network Access Manager, created when first needed
+    QNetworkAccessManager* d_own_qnam;
 
     /// Qt's Reply (from a HTTP request)
     QScopedPointer<QNetworkReply> d_reply;
@@ -756,6 +951,24 @@ private:
 
     /// To Keep-Alive or not to Keep-Alive
     bool d_use_http_keep_alive;
+
+    /// Is HTTP/2 allowed
+    bool d_http2_allowed;
+
+    /// The (last) response - it is parsed in place
+    QByteArray d_reply_data;
+
+    /// Thread pool to parse the response on (0: on our thread)
+    QThreadPool* d_parse_pool;
+
+    /// The response being parsed on d_parse_pool (0: none)
+    QScopedPointer<pubnub_qt_parse_task> d_parse_task;
+
+    /// Was the transaction cancelled while its response was being parsed
+    bool d_parse_cancelled;
+
+    /// Available (1) when the response is not being parsed on d_parse_pool
+    QSemaphore d_parse_idle;
 };
 
 
@@ -21,6 +21,12 @@ typedef SOCKET pb_socket_t;
 
 #define socket_timed_out() (WSAGetLastError() == WSAETIMEDOUT)
 
+/** Whether the peer closed (or reset) the connection, given the
+    @p result of a send or receive that failed */
+#define socket_closed_by_peer(result)                                          \
+    ((0 == (result)) || (WSAGetLastError() == WSAECONNRESET)                   \
+     || (WSAGetLastError() == WSAECONNABORTED))
+
 /** On Windows, one needs to call WSAStartup(), which is not trivial */
 int socket_platform_init(void);
 
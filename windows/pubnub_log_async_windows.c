@@ -0,0 +1,51 @@
+/* -*- c-file-style:"stroustrup"; indent-tabs-mode: nil -*- */
+#include "core/pubnub_log_async.h"
+
+#include <windows.h>
+#include <process.h>
+
+
+static HANDLE m_thread;
+
+static LONG volatile m_stop;
+
+
+static unsigned __stdcall drain_thread(void* arg)
+{
+    (void)arg;
+    while (!m_stop) {
+        if (0 == pubnub_log_async_drain()) {
+            Sleep(PUBNUB_LOG_ASYNC_DRAIN_MS);
+        }
+    }
+    pubnub_log_async_drain();
+
+    return 0;
+}
+
+
+int pubnub_log_async_start(void)
+{
+    if (m_thread != NULL) {
+        return 0;
+    }
+    m_stop   = 0;
+    m_thread = (HANDLE)_beginthreadex(NULL, 0, drain_thread, NULL, 0, NULL);
+    if (NULL == m_thread) {
+        return -1;
+    }
+
+    return 0;
+}
+
+
+void pubnub_log_async_stop(void)
+{
+    if (NULL == m_thread) {
+        return;
+    }
+    InterlockedExchange(&m_stop, 1);
+    WaitForSingleObject(m_thread, INFINITE);
+    CloseHandle(m_thread);
+    m_thread = NULL;
+}
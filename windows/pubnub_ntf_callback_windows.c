@@ -95,6 +95,7 @@ void socket_watcher_thread(void* arg)
             GetSystemTimeAsFileTime(&current_time);
             elapsed = elapsed_ms(prev_time, current_time);
             if (elapsed > 0) {
+                PBMETRICS_OBSERVE(pbmhPollLoopLag, elapsed);
                 EnterCriticalSection(&m_watcher.timerlock);
                 pbntf_handle_timer_list(elapsed, &m_watcher.timer_head);
                 LeaveCriticalSection(&m_watcher.timerlock);